@@ -32,6 +32,16 @@ inline int LeastSignificantSetBit(u64 val)
 	_BitScanForward64(&index, val);
 	return (int)index;
 }
+#else
+inline int LeastSignificantSetBit(u64 val)
+{
+	// No _BitScanForward64 on 32-bit, so scan the halves.
+	unsigned long index;
+	if (_BitScanForward(&index, (u32)val))
+		return (int)index;
+	_BitScanForward(&index, (u32)(val >> 32));
+	return (int)index + 32;
+}
 #endif
 #else
 inline int CountSetBits(u32 val) { return __builtin_popcount(val); }
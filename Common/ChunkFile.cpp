@@ -15,12 +15,19 @@
 // Official SVN repository and contact information can be found at
 // http://code.google.com/p/dolphin-emu/
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 #include <snappy-c.h>
 
 #include "ChunkFile.h"
 #include "StringUtils.h"
+#include "ThreadPools.h"
+
+// Savestates are compressed in independent slices of this size so the thread
+// pool can work on them in parallel, both when saving and loading.
+static const size_t SAVESTATE_CHUNK_SIZE = 2 * 1024 * 1024;
 
 PointerWrapSection PointerWrap::Section(const char *title, int ver) {
 	return Section(title, ver, ver);
@@ -30,6 +37,18 @@ PointerWrapSection PointerWrap::Section(const char *title, int minVer, int ver)
 	char marker[16] = {0};
 	int foundVersion = ver;
 
+	u8 *sectionStart = *ptr;
+	++sectionDepth;
+	// The root is depth 1, so its direct children - the module states - are
+	// the sections worth indexing.
+	if (sectionIndex && mode == MODE_WRITE && sectionDepth == 2) {
+		SectionOffset s{};
+		truncate_cpy(s.name, title);
+		s.offset = (u32)(sectionStart - sectionIndexBase);
+		s.size = 0;
+		sectionIndex->push_back(s);
+	}
+
 	// This is strncpy because we rely on its weird non-null-terminating truncation behaviour.
 	// Can't replace it with the more sensible truncate_cpy because that would break savestates.
 	strncpy(marker, title, sizeof(marker));
@@ -164,9 +183,14 @@ PointerWrapSection::~PointerWrapSection() {
 	if (ver_ > 0) {
 		p_.DoMarker(title_);
 	}
+	if (p_.sectionIndex && p_.mode == PointerWrap::MODE_WRITE && p_.sectionDepth == 2 && !p_.sectionIndex->empty()) {
+		PointerWrap::SectionOffset &s = p_.sectionIndex->back();
+		s.size = (u32)(*p_.ptr - p_.sectionIndexBase) - s.offset;
+	}
+	--p_.sectionDepth;
 }
 
-CChunkFileReader::Error CChunkFileReader::LoadFileHeader(File::IOFile &pFile, SChunkHeader &header, std::string *title) {
+CChunkFileReader::Error CChunkFileReader::LoadFileHeader(File::IOFile &pFile, SChunkHeader &header, std::string *title, std::vector<PointerWrap::SectionOffset> *sectionIndex) {
 	if (!pFile) {
 		ERROR_LOG(SAVESTATE, "ChunkReader: Can't open file for reading");
 		return ERROR_BAD_FILE;
@@ -205,6 +229,27 @@ CChunkFileReader::Error CChunkFileReader::LoadFileHeader(File::IOFile &pFile, SC
 		title->clear();
 	}
 
+	if (header.Revision >= REVISION_INDEX) {
+		u32 sectionCount = 0;
+		if (!pFile.ReadArray(&sectionCount, 1) || sectionCount > (fileSize - headerSize) / sizeof(PointerWrap::SectionOffset)) {
+			ERROR_LOG(SAVESTATE, "ChunkReader: Unable to read section index");
+			return ERROR_BAD_FILE;
+		}
+		headerSize += sizeof(u32) + sectionCount * sizeof(PointerWrap::SectionOffset);
+		if (sectionIndex) {
+			sectionIndex->resize(sectionCount);
+			if (sectionCount != 0 && !pFile.ReadArray(&(*sectionIndex)[0], sectionCount)) {
+				ERROR_LOG(SAVESTATE, "ChunkReader: Unable to read section index");
+				return ERROR_BAD_FILE;
+			}
+		} else if (sectionCount != 0 && !pFile.Seek(sectionCount * sizeof(PointerWrap::SectionOffset), SEEK_CUR)) {
+			ERROR_LOG(SAVESTATE, "ChunkReader: Unable to skip section index");
+			return ERROR_BAD_FILE;
+		}
+	} else if (sectionIndex) {
+		sectionIndex->clear();
+	}
+
 	u32 sz = (u32)(fileSize - headerSize);
 	if (header.ExpectedSize != sz) {
 		ERROR_LOG(SAVESTATE, "ChunkReader: Bad file size, got %u expected %u", sz, header.ExpectedSize);
@@ -225,6 +270,17 @@ CChunkFileReader::Error CChunkFileReader::GetFileTitle(const std::string &filena
 	return LoadFileHeader(pFile, header, title);
 }
 
+CChunkFileReader::Error CChunkFileReader::GetSectionIndex(const std::string &filename, std::vector<PointerWrap::SectionOffset> &sections) {
+	if (!File::Exists(filename)) {
+		ERROR_LOG(SAVESTATE, "ChunkReader: File doesn't exist");
+		return ERROR_BAD_FILE;
+	}
+
+	File::IOFile pFile(filename, "rb");
+	SChunkHeader header;
+	return LoadFileHeader(pFile, header, nullptr, &sections);
+}
+
 CChunkFileReader::Error CChunkFileReader::LoadFile(const std::string &filename, std::string *gitVersion, u8 *&_buffer, size_t &sz, std::string *failureReason) {
 	if (!File::Exists(filename)) {
 		*failureReason = "LoadStateDoesntExist";
@@ -250,7 +306,45 @@ CChunkFileReader::Error CChunkFileReader::LoadFile(const std::string &filename,
 	}
 
 	_buffer = buffer;
-	if (header.Compress) {
+	if (header.Compress == 2) {
+		// Chunked format, see SaveFile(). Decompress the chunks in parallel.
+		const u32 *table = (const u32 *)buffer;
+		const size_t chunkSize = table[0];
+		const size_t numChunks = chunkSize ? (header.UncompressedSize + chunkSize - 1) / chunkSize : 0;
+		const size_t tableBytes = sizeof(u32) + numChunks * sizeof(u32);
+		std::vector<size_t> offsets(numChunks);
+		size_t pos = tableBytes;
+		bool bad = tableBytes > sz || (header.UncompressedSize != 0 && chunkSize == 0);
+		for (size_t i = 0; !bad && i < numChunks; ++i) {
+			offsets[i] = pos;
+			pos += table[1 + i];
+		}
+		if (bad || pos != sz) {
+			ERROR_LOG(SAVESTATE, "ChunkReader: Bad chunk table");
+			delete [] buffer;
+			return ERROR_BAD_FILE;
+		}
+
+		u8 *uncomp_buffer = new u8[header.UncompressedSize];
+		volatile bool chunkError = false;
+		GlobalThreadPool::Loop([&](int low, int high) {
+			for (int i = low; i < high; ++i) {
+				size_t expected = std::min(chunkSize, (size_t)header.UncompressedSize - (size_t)i * chunkSize);
+				size_t outLen = expected;
+				if (snappy_uncompress((const char *)buffer + offsets[i], table[1 + i], (char *)uncomp_buffer + (size_t)i * chunkSize, &outLen) != SNAPPY_OK || outLen != expected)
+					chunkError = true;
+			}
+		}, 0, (int)numChunks);
+		if (chunkError) {
+			ERROR_LOG(SAVESTATE, "ChunkReader: Failed to decompress chunk");
+			delete [] uncomp_buffer;
+			delete [] buffer;
+			return ERROR_BAD_FILE;
+		}
+		_buffer = uncomp_buffer;
+		sz = header.UncompressedSize;
+		delete [] buffer;
+	} else if (header.Compress) {
 		u8 *uncomp_buffer = new u8[header.UncompressedSize];
 		size_t uncomp_size = header.UncompressedSize;
 		snappy_uncompress((const char *)buffer, sz, (char *)uncomp_buffer, &uncomp_size);
@@ -274,7 +368,7 @@ CChunkFileReader::Error CChunkFileReader::LoadFile(const std::string &filename,
 }
 
 // Takes ownership of buffer.
-CChunkFileReader::Error CChunkFileReader::SaveFile(const std::string &filename, const std::string &title, const char *gitVersion, u8 *buffer, size_t sz) {
+CChunkFileReader::Error CChunkFileReader::SaveFile(const std::string &filename, const std::string &title, const char *gitVersion, u8 *buffer, size_t sz, const std::vector<PointerWrap::SectionOffset> &sectionIndex) {
 	INFO_LOG(SAVESTATE, "ChunkReader: Writing %s", filename.c_str());
 
 	File::IOFile pFile(filename, "wb");
@@ -284,24 +378,45 @@ CChunkFileReader::Error CChunkFileReader::SaveFile(const std::string &filename,
 		return ERROR_BAD_FILE;
 	}
 
-	// Make sure we can allocate a buffer to compress before compressing.
-	size_t write_len = snappy_max_compressed_length(sz);
-	u8 *compressed_buffer = (u8 *)malloc(write_len);
+	// Compress the state in independent chunks on the thread pool - a single
+	// snappy_compress over a 40MB state is a long single-threaded stall.
+	// The payload starts with the uncompressed chunk size and a table of
+	// compressed chunk sizes, then the chunks back to back.
+	const size_t numChunks = (sz + SAVESTATE_CHUNK_SIZE - 1) / SAVESTATE_CHUNK_SIZE;
+	const size_t maxChunkLen = snappy_max_compressed_length(SAVESTATE_CHUNK_SIZE);
+	const size_t tableBytes = sizeof(u32) + numChunks * sizeof(u32);
+	size_t write_len;
+	u8 *compressed_buffer = (u8 *)malloc(tableBytes + numChunks * maxChunkLen);
 	u8 *write_buffer = buffer;
 	if (!compressed_buffer) {
 		ERROR_LOG(SAVESTATE, "ChunkReader: Unable to allocate compressed buffer");
 		// We'll save uncompressed.  Better than not saving...
 		write_len = sz;
 	} else {
-		snappy_compress((const char *)buffer, sz, (char *)compressed_buffer, &write_len);
+		u32 *table = (u32 *)compressed_buffer;
+		table[0] = (u32)SAVESTATE_CHUNK_SIZE;
+		u8 *chunkData = compressed_buffer + tableBytes;
+		// Each chunk compresses into its own maxChunkLen slot, they're packed
+		// together when written out below.
+		GlobalThreadPool::Loop([&](int low, int high) {
+			for (int i = low; i < high; ++i) {
+				size_t chunkLen = std::min(SAVESTATE_CHUNK_SIZE, sz - (size_t)i * SAVESTATE_CHUNK_SIZE);
+				size_t compressedLen = maxChunkLen;
+				snappy_compress((const char *)buffer + (size_t)i * SAVESTATE_CHUNK_SIZE, chunkLen, (char *)chunkData + (size_t)i * maxChunkLen, &compressedLen);
+				table[1 + i] = (u32)compressedLen;
+			}
+		}, 0, (int)numChunks);
 		free(buffer);
 
+		write_len = tableBytes;
+		for (size_t i = 0; i < numChunks; ++i)
+			write_len += table[1 + i];
 		write_buffer = compressed_buffer;
 	}
 
 	// Create header
 	SChunkHeader header{};
-	header.Compress = compressed_buffer ? 1 : 0;
+	header.Compress = compressed_buffer ? 2 : 0;
 	header.Revision = REVISION_CURRENT;
 	header.ExpectedSize = (u32)write_len;
 	header.UncompressedSize = (u32)sz;
@@ -323,7 +438,24 @@ CChunkFileReader::Error CChunkFileReader::SaveFile(const std::string &filename,
 		return ERROR_BAD_FILE;
 	}
 
-	if (!pFile.WriteBytes(write_buffer, write_len)) {
+	u32 sectionCount = (u32)sectionIndex.size();
+	if (!pFile.WriteArray(&sectionCount, 1) || (sectionCount != 0 && !pFile.WriteArray(&sectionIndex[0], sectionCount))) {
+		ERROR_LOG(SAVESTATE, "ChunkReader: Failed writing section index");
+		free(write_buffer);
+		return ERROR_BAD_FILE;
+	}
+
+	bool writeOK;
+	if (compressed_buffer) {
+		const u32 *table = (const u32 *)compressed_buffer;
+		const u8 *chunkData = compressed_buffer + tableBytes;
+		writeOK = pFile.WriteBytes(compressed_buffer, tableBytes);
+		for (size_t i = 0; writeOK && i < numChunks; ++i)
+			writeOK = pFile.WriteBytes(chunkData + i * maxChunkLen, table[1 + i]);
+	} else {
+		writeOK = pFile.WriteBytes(write_buffer, write_len);
+	}
+	if (!writeOK) {
 		ERROR_LOG(SAVESTATE, "ChunkReader: Failed writing compressed data");
 		free(write_buffer);
 		return ERROR_BAD_FILE;
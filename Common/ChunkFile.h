@@ -35,6 +35,7 @@
 #include <deque>
 #include <list>
 #include <set>
+#include <vector>
 #include <type_traits>
 
 #include "Common.h"
@@ -129,6 +130,19 @@ public:
 	Mode mode;
 	Error error;
 
+	// Offset and length of a named section within the serialized state.
+	struct SectionOffset {
+		char name[32];
+		u32 offset;
+		u32 size;
+	};
+
+	// When set in MODE_WRITE, the top-level sections (the direct children of
+	// the root) are recorded here so the file can carry an index of them.
+	std::vector<SectionOffset> *sectionIndex = nullptr;
+	u8 *sectionIndexBase = nullptr;
+	int sectionDepth = 0;
+
 public:
 	PointerWrap(u8 **ptr_, Mode mode_) : ptr(ptr_), mode(mode_), error(ERROR_NONE) {}
 	PointerWrap(unsigned char **ptr_, int mode_) : ptr((u8**)ptr_), mode((Mode)mode_), error(ERROR_NONE) {}
@@ -608,9 +622,13 @@ public:
 
 	// Expects ptr to have at least MeasurePtr bytes at ptr.
 	template<class T>
-	static Error SavePtr(u8 *ptr, T &_class)
+	static Error SavePtr(u8 *ptr, T &_class, std::vector<PointerWrap::SectionOffset> *sectionIndex = nullptr)
 	{
 		PointerWrap p(&ptr, PointerWrap::MODE_WRITE);
+		if (sectionIndex) {
+			p.sectionIndex = sectionIndex;
+			p.sectionIndexBase = ptr;
+		}
 		_class.DoState(p);
 
 		if (p.error != p.ERROR_FAILURE) {
@@ -650,11 +668,12 @@ public:
 		u8 *buffer = (u8 *)malloc(sz);
 		if (!buffer)
 			return ERROR_BAD_ALLOC;
-		Error error = SavePtr(buffer, _class);
+		std::vector<PointerWrap::SectionOffset> sectionIndex;
+		Error error = SavePtr(buffer, _class, &sectionIndex);
 
 		// SaveFile takes ownership of buffer
 		if (error == ERROR_NONE)
-			error = SaveFile(filename, title, gitVersion, buffer, sz);
+			error = SaveFile(filename, title, gitVersion, buffer, sz, sectionIndex);
 		return error;
 	}
 	
@@ -683,6 +702,9 @@ public:
 	}
 
 	static Error GetFileTitle(const std::string &filename, std::string *title);
+	// Lists the top-level sections of a state file and where they live in the
+	// uncompressed data, so tools can inspect one module without loading it all.
+	static Error GetSectionIndex(const std::string &filename, std::vector<PointerWrap::SectionOffset> &sections);
 
 private:
 	struct SChunkHeader
@@ -697,10 +719,12 @@ private:
 	enum {
 		REVISION_MIN = 4,
 		REVISION_TITLE = 5,
-		REVISION_CURRENT = REVISION_TITLE,
+		// Adds the section index between the title and the data.
+		REVISION_INDEX = 6,
+		REVISION_CURRENT = REVISION_INDEX,
 	};
 
 	static Error LoadFile(const std::string &filename, std::string *gitVersion, u8 *&buffer, size_t &sz, std::string *failureReason);
-	static Error SaveFile(const std::string &filename, const std::string &title, const char *gitVersion, u8 *buffer, size_t sz);
-	static Error LoadFileHeader(File::IOFile &pFile, SChunkHeader &header, std::string *title);
+	static Error SaveFile(const std::string &filename, const std::string &title, const char *gitVersion, u8 *buffer, size_t sz, const std::vector<PointerWrap::SectionOffset> &sectionIndex);
+	static Error LoadFileHeader(File::IOFile &pFile, SChunkHeader &header, std::string *title, std::vector<PointerWrap::SectionOffset> *sectionIndex = nullptr);
 };
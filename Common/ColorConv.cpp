@@ -170,7 +170,7 @@ void ConvertBGRA8888ToRGBA8888(u32 *dst, const u32 *src, u32 numPixels) {
 	}
 }
 
-void ConvertRGBA8888ToRGBA5551(u16 *dst, const u32 *src, u32 numPixels) {
+void ConvertRGBA8888ToRGBA5551Basic(u16 *dst, const u32 *src, u32 numPixels) {
 #if _M_SSE >= 0x401
 	const __m128i maskAG = _mm_set1_epi32(0x8000F800);
 	const __m128i maskRB = _mm_set1_epi32(0x00F800F8);
@@ -266,19 +266,19 @@ void ConvertBGRA8888ToRGBA4444(u16 *dst, const u32 *src, u32 numPixels) {
 	}
 }
 
-void ConvertRGBA8888ToRGB565(u16 *dst, const u32 *src, u32 numPixels) {
+void ConvertRGBA8888ToRGB565Basic(u16 *dst, const u32 *src, u32 numPixels) {
 	for (u32 x = 0; x < numPixels; ++x) {
 		dst[x] = RGBA8888toRGB565(src[x]);
 	}
 }
 
-void ConvertRGBA8888ToRGBA4444(u16 *dst, const u32 *src, u32 numPixels) {
+void ConvertRGBA8888ToRGBA4444Basic(u16 *dst, const u32 *src, u32 numPixels) {
 	for (u32 x = 0; x < numPixels; ++x) {
 		dst[x] = RGBA8888toRGBA4444(src[x]);
 	}
 }
 
-void ConvertRGBA565ToRGBA8888(u32 *dst32, const u16 *src, u32 numPixels) {
+void ConvertRGBA565ToRGBA8888Basic(u32 *dst32, const u16 *src, u32 numPixels) {
 #ifdef _M_SSE
 	const __m128i mask5 = _mm_set1_epi16(0x001f);
 	const __m128i mask6 = _mm_set1_epi16(0x003f);
@@ -332,7 +332,7 @@ void ConvertRGBA565ToRGBA8888(u32 *dst32, const u16 *src, u32 numPixels) {
 	}
 }
 
-void ConvertRGBA5551ToRGBA8888(u32 *dst32, const u16 *src, u32 numPixels) {
+void ConvertRGBA5551ToRGBA8888Basic(u32 *dst32, const u16 *src, u32 numPixels) {
 #ifdef _M_SSE
 	const __m128i mask5 = _mm_set1_epi16(0x001f);
 	const __m128i mask8 = _mm_set1_epi16(0x00ff);
@@ -386,7 +386,7 @@ void ConvertRGBA5551ToRGBA8888(u32 *dst32, const u16 *src, u32 numPixels) {
 	}
 }
 
-void ConvertRGBA4444ToRGBA8888(u32 *dst32, const u16 *src, u32 numPixels) {
+void ConvertRGBA4444ToRGBA8888Basic(u32 *dst32, const u16 *src, u32 numPixels) {
 #ifdef _M_SSE
 	const __m128i mask4 = _mm_set1_epi16(0x000f);
 
@@ -641,6 +641,14 @@ Convert16bppTo16bppFunc ConvertRGBA4444ToABGR4444 = &ConvertRGBA4444ToABGR4444Ba
 Convert16bppTo16bppFunc ConvertRGBA5551ToABGR1555 = &ConvertRGBA5551ToABGR1555Basic;
 Convert16bppTo16bppFunc ConvertRGB565ToBGR565 = &ConvertRGB565ToBGR565Basic;
 #endif
+#ifndef ConvertRGBA8888ToRGB565
+Convert32bppTo16bppFunc ConvertRGBA8888ToRGB565 = &ConvertRGBA8888ToRGB565Basic;
+Convert32bppTo16bppFunc ConvertRGBA8888ToRGBA5551 = &ConvertRGBA8888ToRGBA5551Basic;
+Convert32bppTo16bppFunc ConvertRGBA8888ToRGBA4444 = &ConvertRGBA8888ToRGBA4444Basic;
+Convert16bppTo32bppFunc ConvertRGBA565ToRGBA8888 = &ConvertRGBA565ToRGBA8888Basic;
+Convert16bppTo32bppFunc ConvertRGBA5551ToRGBA8888 = &ConvertRGBA5551ToRGBA8888Basic;
+Convert16bppTo32bppFunc ConvertRGBA4444ToRGBA8888 = &ConvertRGBA4444ToRGBA8888Basic;
+#endif
 
 void SetupColorConv() {
 #if PPSSPP_ARCH(ARM_NEON) && !PPSSPP_ARCH(ARM64)
@@ -648,6 +656,12 @@ void SetupColorConv() {
 		ConvertRGBA4444ToABGR4444 = &ConvertRGBA4444ToABGR4444NEON;
 		ConvertRGBA5551ToABGR1555 = &ConvertRGBA5551ToABGR1555NEON;
 		ConvertRGB565ToBGR565 = &ConvertRGB565ToBGR565NEON;
+		ConvertRGBA8888ToRGB565 = &ConvertRGBA8888ToRGB565NEON;
+		ConvertRGBA8888ToRGBA5551 = &ConvertRGBA8888ToRGBA5551NEON;
+		ConvertRGBA8888ToRGBA4444 = &ConvertRGBA8888ToRGBA4444NEON;
+		ConvertRGBA565ToRGBA8888 = &ConvertRGBA565ToRGBA8888NEON;
+		ConvertRGBA5551ToRGBA8888 = &ConvertRGBA5551ToRGBA8888NEON;
+		ConvertRGBA4444ToRGBA8888 = &ConvertRGBA4444ToRGBA8888NEON;
 	}
 #endif
 }
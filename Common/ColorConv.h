@@ -115,17 +115,59 @@ typedef void (*Convert32bppTo32bppFunc)(u32 *dst, const u32 *src, u32 numPixels)
 void ConvertBGRA8888ToRGBA8888(u32 *dst, const u32 *src, u32 numPixels);
 #define ConvertRGBA8888ToBGRA8888 ConvertBGRA8888ToRGBA8888
 
-void ConvertRGBA8888ToRGBA5551(u16 *dst, const u32 *src, u32 numPixels);
-void ConvertRGBA8888ToRGB565(u16 *dst, const u32 *src, u32 numPixels);
-void ConvertRGBA8888ToRGBA4444(u16 *dst, const u32 *src, u32 numPixels);
+void ConvertRGBA8888ToRGBA5551Basic(u16 *dst, const u32 *src, u32 numPixels);
+#if PPSSPP_ARCH(ARM64)
+#define ConvertRGBA8888ToRGBA5551 ConvertRGBA8888ToRGBA5551NEON
+#elif !PPSSPP_ARCH(ARM)
+#define ConvertRGBA8888ToRGBA5551 ConvertRGBA8888ToRGBA5551Basic
+#else
+extern Convert32bppTo16bppFunc ConvertRGBA8888ToRGBA5551;
+#endif
+void ConvertRGBA8888ToRGB565Basic(u16 *dst, const u32 *src, u32 numPixels);
+#if PPSSPP_ARCH(ARM64)
+#define ConvertRGBA8888ToRGB565 ConvertRGBA8888ToRGB565NEON
+#elif !PPSSPP_ARCH(ARM)
+#define ConvertRGBA8888ToRGB565 ConvertRGBA8888ToRGB565Basic
+#else
+extern Convert32bppTo16bppFunc ConvertRGBA8888ToRGB565;
+#endif
+void ConvertRGBA8888ToRGBA4444Basic(u16 *dst, const u32 *src, u32 numPixels);
+#if PPSSPP_ARCH(ARM64)
+#define ConvertRGBA8888ToRGBA4444 ConvertRGBA8888ToRGBA4444NEON
+#elif !PPSSPP_ARCH(ARM)
+#define ConvertRGBA8888ToRGBA4444 ConvertRGBA8888ToRGBA4444Basic
+#else
+extern Convert32bppTo16bppFunc ConvertRGBA8888ToRGBA4444;
+#endif
 
 void ConvertBGRA8888ToRGBA5551(u16 *dst, const u32 *src, u32 numPixels);
 void ConvertBGRA8888ToRGB565(u16 *dst, const u32 *src, u32 numPixels);
 void ConvertBGRA8888ToRGBA4444(u16 *dst, const u32 *src, u32 numPixels);
 
-void ConvertRGBA565ToRGBA8888(u32 *dst, const u16 *src, u32 numPixels);
-void ConvertRGBA5551ToRGBA8888(u32 *dst, const u16 *src, u32 numPixels);
-void ConvertRGBA4444ToRGBA8888(u32 *dst, const u16 *src, u32 numPixels);
+void ConvertRGBA565ToRGBA8888Basic(u32 *dst, const u16 *src, u32 numPixels);
+#if PPSSPP_ARCH(ARM64)
+#define ConvertRGBA565ToRGBA8888 ConvertRGBA565ToRGBA8888NEON
+#elif !PPSSPP_ARCH(ARM)
+#define ConvertRGBA565ToRGBA8888 ConvertRGBA565ToRGBA8888Basic
+#else
+extern Convert16bppTo32bppFunc ConvertRGBA565ToRGBA8888;
+#endif
+void ConvertRGBA5551ToRGBA8888Basic(u32 *dst, const u16 *src, u32 numPixels);
+#if PPSSPP_ARCH(ARM64)
+#define ConvertRGBA5551ToRGBA8888 ConvertRGBA5551ToRGBA8888NEON
+#elif !PPSSPP_ARCH(ARM)
+#define ConvertRGBA5551ToRGBA8888 ConvertRGBA5551ToRGBA8888Basic
+#else
+extern Convert16bppTo32bppFunc ConvertRGBA5551ToRGBA8888;
+#endif
+void ConvertRGBA4444ToRGBA8888Basic(u32 *dst, const u16 *src, u32 numPixels);
+#if PPSSPP_ARCH(ARM64)
+#define ConvertRGBA4444ToRGBA8888 ConvertRGBA4444ToRGBA8888NEON
+#elif !PPSSPP_ARCH(ARM)
+#define ConvertRGBA4444ToRGBA8888 ConvertRGBA4444ToRGBA8888Basic
+#else
+extern Convert16bppTo32bppFunc ConvertRGBA4444ToRGBA8888;
+#endif
 
 void ConvertABGR565ToRGBA8888(u32 *dst, const u16 *src, u32 numPixels);
 void ConvertABGR1555ToRGBA8888(u32 *dst, const u16 *src, u32 numPixels);
@@ -23,8 +23,6 @@
 #include "Common.h"
 #include "CPUDetect.h"
 
-// TODO: More NEON color conversion funcs.
-
 void ConvertRGBA4444ToABGR4444NEON(u16 *dst, const u16 *src, u32 numPixels) {
 	const uint16x8_t mask0040 = vdupq_n_u16(0x00F0);
 
@@ -111,4 +109,188 @@ void ConvertRGB565ToBGR565NEON(u16 *dst, const u16 *src, u32 numPixels) {
 	}
 }
 
+
+void ConvertRGBA8888ToRGB565NEON(u16 *dst, const u32 *src, u32 numPixels) {
+	if (((uintptr_t)dst & 15) == 0 && ((uintptr_t)src & 15) == 0) {
+		u32 simdable = (numPixels / 8) * 8;
+		for (u32 i = 0; i < simdable; i += 8) {
+			// Deinterleaves to r, g, b, a lanes of 8 bytes each.
+			const uint8x8x4_t c = vld4_u8((const u8 *)src);
+
+			const uint16x8_t r = vshrq_n_u16(vmovl_u8(c.val[0]), 3);
+			const uint16x8_t g = vshlq_n_u16(vshrq_n_u16(vmovl_u8(c.val[1]), 2), 5);
+			const uint16x8_t b = vshlq_n_u16(vshrq_n_u16(vmovl_u8(c.val[2]), 3), 11);
+
+			vst1q_u16(dst, vorrq_u16(vorrq_u16(r, g), b));
+
+			src += 8;
+			dst += 8;
+		}
+		numPixels -= simdable;
+	}
+	// Finish off the rest, if there were any outside the simdable range.
+	if (numPixels > 0) {
+		// Note that we've already moved src/dst forward.
+		ConvertRGBA8888ToRGB565Basic(dst, src, numPixels);
+	}
+}
+
+void ConvertRGBA8888ToRGBA5551NEON(u16 *dst, const u32 *src, u32 numPixels) {
+	if (((uintptr_t)dst & 15) == 0 && ((uintptr_t)src & 15) == 0) {
+		u32 simdable = (numPixels / 8) * 8;
+		for (u32 i = 0; i < simdable; i += 8) {
+			const uint8x8x4_t c = vld4_u8((const u8 *)src);
+
+			const uint16x8_t r = vshrq_n_u16(vmovl_u8(c.val[0]), 3);
+			const uint16x8_t g = vshlq_n_u16(vshrq_n_u16(vmovl_u8(c.val[1]), 3), 5);
+			const uint16x8_t b = vshlq_n_u16(vshrq_n_u16(vmovl_u8(c.val[2]), 3), 10);
+			const uint16x8_t a = vshlq_n_u16(vshrq_n_u16(vmovl_u8(c.val[3]), 7), 15);
+
+			vst1q_u16(dst, vorrq_u16(vorrq_u16(r, g), vorrq_u16(b, a)));
+
+			src += 8;
+			dst += 8;
+		}
+		numPixels -= simdable;
+	}
+	// Finish off the rest, if there were any outside the simdable range.
+	if (numPixels > 0) {
+		// Note that we've already moved src/dst forward.
+		ConvertRGBA8888ToRGBA5551Basic(dst, src, numPixels);
+	}
+}
+
+void ConvertRGBA8888ToRGBA4444NEON(u16 *dst, const u32 *src, u32 numPixels) {
+	if (((uintptr_t)dst & 15) == 0 && ((uintptr_t)src & 15) == 0) {
+		u32 simdable = (numPixels / 8) * 8;
+		for (u32 i = 0; i < simdable; i += 8) {
+			const uint8x8x4_t c = vld4_u8((const u8 *)src);
+
+			const uint16x8_t r = vshrq_n_u16(vmovl_u8(c.val[0]), 4);
+			const uint16x8_t g = vshlq_n_u16(vshrq_n_u16(vmovl_u8(c.val[1]), 4), 4);
+			const uint16x8_t b = vshlq_n_u16(vshrq_n_u16(vmovl_u8(c.val[2]), 4), 8);
+			const uint16x8_t a = vshlq_n_u16(vshrq_n_u16(vmovl_u8(c.val[3]), 4), 12);
+
+			vst1q_u16(dst, vorrq_u16(vorrq_u16(r, g), vorrq_u16(b, a)));
+
+			src += 8;
+			dst += 8;
+		}
+		numPixels -= simdable;
+	}
+	// Finish off the rest, if there were any outside the simdable range.
+	if (numPixels > 0) {
+		// Note that we've already moved src/dst forward.
+		ConvertRGBA8888ToRGBA4444Basic(dst, src, numPixels);
+	}
+}
+
+void ConvertRGBA565ToRGBA8888NEON(u32 *dst, const u16 *src, u32 numPixels) {
+	const uint16x8_t mask5 = vdupq_n_u16(0x001F);
+	const uint16x8_t mask6 = vdupq_n_u16(0x003F);
+
+	if (((uintptr_t)dst & 15) == 0 && ((uintptr_t)src & 15) == 0) {
+		u32 simdable = (numPixels / 8) * 8;
+		for (u32 i = 0; i < simdable; i += 8) {
+			const uint16x8_t c = vld1q_u16(src);
+
+			// Expand to 8 bits by replicating the top bits, like Convert5To8/6To8.
+			const uint16x8_t r5 = vandq_u16(c, mask5);
+			const uint16x8_t r = vorrq_u16(vshlq_n_u16(r5, 3), vshrq_n_u16(r5, 2));
+			const uint16x8_t g6 = vandq_u16(vshrq_n_u16(c, 5), mask6);
+			const uint16x8_t g = vorrq_u16(vshlq_n_u16(g6, 2), vshrq_n_u16(g6, 4));
+			const uint16x8_t b5 = vshrq_n_u16(c, 11);
+			const uint16x8_t b = vorrq_u16(vshlq_n_u16(b5, 3), vshrq_n_u16(b5, 2));
+
+			uint8x8x4_t res;
+			res.val[0] = vmovn_u16(r);
+			res.val[1] = vmovn_u16(g);
+			res.val[2] = vmovn_u16(b);
+			res.val[3] = vdup_n_u8(0xFF);
+			vst4_u8((u8 *)dst, res);
+
+			src += 8;
+			dst += 8;
+		}
+		numPixels -= simdable;
+	}
+	// Finish off the rest, if there were any outside the simdable range.
+	if (numPixels > 0) {
+		// Note that we've already moved src/dst forward.
+		ConvertRGBA565ToRGBA8888Basic(dst, src, numPixels);
+	}
+}
+
+void ConvertRGBA5551ToRGBA8888NEON(u32 *dst, const u16 *src, u32 numPixels) {
+	const uint16x8_t mask5 = vdupq_n_u16(0x001F);
+
+	if (((uintptr_t)dst & 15) == 0 && ((uintptr_t)src & 15) == 0) {
+		u32 simdable = (numPixels / 8) * 8;
+		for (u32 i = 0; i < simdable; i += 8) {
+			const uint16x8_t c = vld1q_u16(src);
+
+			const uint16x8_t r5 = vandq_u16(c, mask5);
+			const uint16x8_t r = vorrq_u16(vshlq_n_u16(r5, 3), vshrq_n_u16(r5, 2));
+			const uint16x8_t g5 = vandq_u16(vshrq_n_u16(c, 5), mask5);
+			const uint16x8_t g = vorrq_u16(vshlq_n_u16(g5, 3), vshrq_n_u16(g5, 2));
+			const uint16x8_t b5 = vandq_u16(vshrq_n_u16(c, 10), mask5);
+			const uint16x8_t b = vorrq_u16(vshlq_n_u16(b5, 3), vshrq_n_u16(b5, 2));
+			// Arithmetic shift replicates the alpha bit across the whole lane.
+			const uint16x8_t a = vreinterpretq_u16_s16(vshrq_n_s16(vreinterpretq_s16_u16(c), 15));
+
+			uint8x8x4_t res;
+			res.val[0] = vmovn_u16(r);
+			res.val[1] = vmovn_u16(g);
+			res.val[2] = vmovn_u16(b);
+			res.val[3] = vmovn_u16(a);
+			vst4_u8((u8 *)dst, res);
+
+			src += 8;
+			dst += 8;
+		}
+		numPixels -= simdable;
+	}
+	// Finish off the rest, if there were any outside the simdable range.
+	if (numPixels > 0) {
+		// Note that we've already moved src/dst forward.
+		ConvertRGBA5551ToRGBA8888Basic(dst, src, numPixels);
+	}
+}
+
+void ConvertRGBA4444ToRGBA8888NEON(u32 *dst, const u16 *src, u32 numPixels) {
+	const uint16x8_t mask4 = vdupq_n_u16(0x000F);
+
+	if (((uintptr_t)dst & 15) == 0 && ((uintptr_t)src & 15) == 0) {
+		u32 simdable = (numPixels / 8) * 8;
+		for (u32 i = 0; i < simdable; i += 8) {
+			const uint16x8_t c = vld1q_u16(src);
+
+			const uint16x8_t r4 = vandq_u16(c, mask4);
+			const uint16x8_t r = vorrq_u16(vshlq_n_u16(r4, 4), r4);
+			const uint16x8_t g4 = vandq_u16(vshrq_n_u16(c, 4), mask4);
+			const uint16x8_t g = vorrq_u16(vshlq_n_u16(g4, 4), g4);
+			const uint16x8_t b4 = vandq_u16(vshrq_n_u16(c, 8), mask4);
+			const uint16x8_t b = vorrq_u16(vshlq_n_u16(b4, 4), b4);
+			const uint16x8_t a4 = vshrq_n_u16(c, 12);
+			const uint16x8_t a = vorrq_u16(vshlq_n_u16(a4, 4), a4);
+
+			uint8x8x4_t res;
+			res.val[0] = vmovn_u16(r);
+			res.val[1] = vmovn_u16(g);
+			res.val[2] = vmovn_u16(b);
+			res.val[3] = vmovn_u16(a);
+			vst4_u8((u8 *)dst, res);
+
+			src += 8;
+			dst += 8;
+		}
+		numPixels -= simdable;
+	}
+	// Finish off the rest, if there were any outside the simdable range.
+	if (numPixels > 0) {
+		// Note that we've already moved src/dst forward.
+		ConvertRGBA4444ToRGBA8888Basic(dst, src, numPixels);
+	}
+}
+
 #endif // PPSSPP_ARCH(ARM_NEON)
@@ -22,3 +22,10 @@
 void ConvertRGBA4444ToABGR4444NEON(u16 *dst, const u16 *src, u32 numPixels);
 void ConvertRGBA5551ToABGR1555NEON(u16 *dst, const u16 *src, u32 numPixels);
 void ConvertRGB565ToBGR565NEON(u16 *dst, const u16 *src, u32 numPixels);
+
+void ConvertRGBA8888ToRGB565NEON(u16 *dst, const u32 *src, u32 numPixels);
+void ConvertRGBA8888ToRGBA5551NEON(u16 *dst, const u32 *src, u32 numPixels);
+void ConvertRGBA8888ToRGBA4444NEON(u16 *dst, const u32 *src, u32 numPixels);
+void ConvertRGBA565ToRGBA8888NEON(u32 *dst, const u16 *src, u32 numPixels);
+void ConvertRGBA5551ToRGBA8888NEON(u32 *dst, const u16 *src, u32 numPixels);
+void ConvertRGBA4444ToRGBA8888NEON(u32 *dst, const u16 *src, u32 numPixels);
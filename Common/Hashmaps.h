@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "ext/xxhash.h"
@@ -180,6 +183,185 @@ private:
 	int removedCount_ = 0;
 };
 
+// Concurrent variant of DenseHashMap, optimized for many readers and few writers
+// (shader/pipeline lookup from multiple threads). Get() is lock-free: bucket states
+// are published with release stores after the key/value, so an acquire load of TAKEN
+// guarantees the pair is visible. Writers serialize on a small mutex. Grow() builds
+// a fresh table and publishes it through the shared_ptr - readers that grabbed the
+// old table keep it alive until they're done, so no reader ever sees a half-moved
+// table (poor man's epochs).
+template <class Key, class Value, Value NullValue>
+class ConcurrentDenseHashMap {
+public:
+	ConcurrentDenseHashMap(int initialCapacity) {
+		std::atomic_store(&table_, std::make_shared<Table>(initialCapacity));
+	}
+
+	// Returns NullValue if no entry was found. Safe to call from any thread.
+	Value Get(const Key &key) const {
+		std::shared_ptr<Table> t = std::atomic_load(&table_);
+		uint32_t mask = t->capacity - 1;
+		uint32_t pos = HashKey(key) & mask;
+		uint32_t p = pos;
+		while (true) {
+			BucketState state = t->state[p].load(std::memory_order_acquire);
+			if (state == BucketState::TAKEN && KeyEquals(key, t->pairs[p].key))
+				return t->pairs[p].value;
+			else if (state == BucketState::FREE)
+				return NullValue;
+			p = (p + 1) & mask;  // If the state is REMOVED, we just keep on walking.
+			if (p == pos) {
+				_assert_msg_(SYSTEM, false, "ConcurrentDenseHashMap: Hit full on Get()");
+			}
+		}
+		return NullValue;
+	}
+
+	// Returns false if we already had the key! Which is a bit different.
+	bool Insert(const Key &key, Value value) {
+		std::lock_guard<std::mutex> guard(writeLock_);
+		std::shared_ptr<Table> t = std::atomic_load(&table_);
+		// Check load factor, resize if necessary. We never shrink.
+		if (count_.load(std::memory_order_relaxed) > t->capacity / 2) {
+			t = GrowLocked(t, 2);
+		}
+		uint32_t mask = t->capacity - 1;
+		uint32_t pos = HashKey(key) & mask;
+		uint32_t p = pos;
+		while (true) {
+			BucketState state = t->state[p].load(std::memory_order_relaxed);
+			if (state == BucketState::TAKEN) {
+				if (KeyEquals(key, t->pairs[p].key)) {
+					// Bad! We already got this one. Let's avoid this case.
+					_assert_msg_(SYSTEM, false, "ConcurrentDenseHashMap: Duplicate key inserted");
+					return false;
+				}
+				// continue looking....
+			} else {
+				// Got a place, either removed or FREE.
+				break;
+			}
+			p = (p + 1) & mask;
+			if (p == pos) {
+				// FULL! Error. Should not happen thanks to GrowLocked().
+				_assert_msg_(SYSTEM, false, "ConcurrentDenseHashMap: Hit full on Insert()");
+			}
+		}
+		if (t->state[p].load(std::memory_order_relaxed) == BucketState::REMOVED) {
+			removedCount_--;
+		}
+		// Fill the pair first, then publish the state so readers never see a
+		// TAKEN bucket with a half-written key.
+		t->pairs[p].key = key;
+		t->pairs[p].value = value;
+		t->state[p].store(BucketState::TAKEN, std::memory_order_release);
+		count_.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool Remove(const Key &key) {
+		std::lock_guard<std::mutex> guard(writeLock_);
+		std::shared_ptr<Table> t = std::atomic_load(&table_);
+		uint32_t mask = t->capacity - 1;
+		uint32_t pos = HashKey(key) & mask;
+		uint32_t p = pos;
+		while (t->state[p].load(std::memory_order_relaxed) != BucketState::FREE) {
+			if (t->state[p].load(std::memory_order_relaxed) == BucketState::TAKEN && KeyEquals(key, t->pairs[p].key)) {
+				// Got it! Mark it as removed.
+				t->state[p].store(BucketState::REMOVED, std::memory_order_release);
+				removedCount_++;
+				count_.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+			p = (p + 1) & mask;
+			if (p == pos) {
+				// FULL! Error. Should not happen.
+				_assert_msg_(SYSTEM, false, "ConcurrentDenseHashMap: Hit full on Remove()");
+			}
+		}
+		return false;
+	}
+
+	size_t size() const {
+		return count_.load(std::memory_order_relaxed);
+	}
+
+	// Only safe against concurrent Get(), not against other writers.
+	template<class T>
+	inline void Iterate(T func) const {
+		std::shared_ptr<Table> t = std::atomic_load(&table_);
+		for (int i = 0; i < t->capacity; i++) {
+			if (t->state[i].load(std::memory_order_acquire) == BucketState::TAKEN) {
+				func(t->pairs[i].key, t->pairs[i].value);
+			}
+		}
+	}
+
+	void Clear() {
+		std::lock_guard<std::mutex> guard(writeLock_);
+		std::shared_ptr<Table> t = std::atomic_load(&table_);
+		// Publish a fresh table instead of wiping in place - a concurrent reader
+		// may still be probing the old one.
+		std::atomic_store(&table_, std::make_shared<Table>(t->capacity));
+		count_.store(0, std::memory_order_relaxed);
+		removedCount_ = 0;
+	}
+
+	void Maintain() {
+		std::lock_guard<std::mutex> guard(writeLock_);
+		// Heuristic
+		std::shared_ptr<Table> t = std::atomic_load(&table_);
+		if (removedCount_ >= t->capacity / 4) {
+			GrowLocked(t, 1);
+		}
+	}
+
+private:
+	struct Pair {
+		Key key;
+		Value value;
+	};
+	struct Table {
+		explicit Table(int cap) : capacity(cap), pairs(new Pair[cap]), state(new std::atomic<BucketState>[cap]) {
+			for (int i = 0; i < cap; i++)
+				state[i].store(BucketState::FREE, std::memory_order_relaxed);
+		}
+		~Table() {
+			delete[] pairs;
+			delete[] state;
+		}
+		int capacity;
+		Pair *pairs;
+		std::atomic<BucketState> *state;
+	};
+
+	// Expects writeLock_ to be held. Returns the new table.
+	std::shared_ptr<Table> GrowLocked(const std::shared_ptr<Table> &old, int factor) {
+		std::shared_ptr<Table> next = std::make_shared<Table>(old->capacity * factor);
+		uint32_t mask = next->capacity - 1;
+		for (int i = 0; i < old->capacity; i++) {
+			if (old->state[i].load(std::memory_order_relaxed) != BucketState::TAKEN)
+				continue;
+			uint32_t p = HashKey(old->pairs[i].key) & mask;
+			while (next->state[p].load(std::memory_order_relaxed) == BucketState::TAKEN)
+				p = (p + 1) & mask;
+			next->pairs[p] = old->pairs[i];
+			// Nobody can see this table yet, no ordering needed.
+			next->state[p].store(BucketState::TAKEN, std::memory_order_relaxed);
+		}
+		removedCount_ = 0;
+		// The publish: readers pick up the new table on their next Get(), ones
+		// mid-probe finish against the old (still valid) one.
+		std::atomic_store(&table_, next);
+		return next;
+	}
+
+	std::shared_ptr<Table> table_;
+	std::mutex writeLock_;
+	std::atomic<int> count_{ 0 };
+	int removedCount_ = 0;  // only touched under writeLock_
+};
+
 // Like the above, uses linear probing for cache-friendliness.
 // Does not perform hashing at all so expects well-distributed keys.
 template <class Value, Value NullValue>
@@ -20,6 +20,7 @@
 #include <algorithm>
 
 #include "base/logging.h"
+#include "thread/threadutil.h"
 #include "util/text/utf8.h"
 #include "LogManager.h"
 #include "ConsoleListener.h"
@@ -33,6 +34,10 @@ const char *hleCurrentThreadName = nullptr;
 
 static const char level_to_char[8] = "-NEWIDV";
 
+// How many messages can queue up for the drain thread before we start
+// dropping instead of blocking the logging thread.
+static const size_t MAX_PENDING_MESSAGES = 1024;
+
 #if PPSSPP_PLATFORM(UWP) && defined(_DEBUG)
 #define LOG_MSC_OUTPUTDEBUG true
 #else
@@ -150,9 +155,21 @@ LogManager::LogManager() {
 #endif
 	AddListener(ringLog_);
 #endif
+
+	drainThread_ = std::thread(&LogManager::DrainThreadFunc, this);
 }
 
 LogManager::~LogManager() {
+	{
+		std::lock_guard<std::mutex> lk(pending_lock_);
+		stopDrainThread_ = true;
+	}
+	pending_cond_.notify_one();
+	if (drainThread_.joinable())
+		drainThread_.join();
+	// The drain thread may have exited with messages still queued.
+	FlushPending();
+
 	for (int i = 0; i < LogTypes::NUMBER_OF_LOGS; ++i) {
 #if !defined(MOBILE_DEVICE) || defined(_DEBUG)
 		RemoveListener(fileLog_);
@@ -226,8 +243,12 @@ void LogManager::Log(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const
 			file = fileshort + 1;
 	}
 
-	std::lock_guard<std::mutex> lk(log_lock_);
-	Common::Timer::GetTimeFormatted(message.timestamp);
+	{
+		// localtime() in here isn't thread-safe, everything else in this
+		// function formats into locals and doesn't need the lock.
+		std::lock_guard<std::mutex> lk(log_lock_);
+		Common::Timer::GetTimeFormatted(message.timestamp);
+	}
 
 	if (hleCurrentThreadName) {
 		snprintf(message.header, sizeof(message.header), "%-12.12s %c[%s]: %s:%d",
@@ -255,12 +276,86 @@ void LogManager::Log(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const
 	message.msg[neededBytes] = '\n';
 	va_end(args_copy);
 
+	// Errors and notices are rare, and often the last thing we see before a
+	// crash, so they go straight to the listeners. The chatty levels get
+	// queued for the drain thread so console/file I/O doesn't stall the
+	// calling thread - and dropped (counted) instead of blocking if the
+	// listeners can't keep up.
+	if (level == LogTypes::LERROR || level == LogTypes::LNOTICE) {
+		DispatchToListeners(message);
+		return;
+	}
+
+	bool wake = false;
+	{
+		std::lock_guard<std::mutex> lk(pending_lock_);
+		if (pending_.size() >= MAX_PENDING_MESSAGES) {
+			droppedMessages_++;
+			return;
+		}
+		wake = pending_.empty();
+		pending_.push_back(std::move(message));
+	}
+	if (wake)
+		pending_cond_.notify_one();
+}
+
+void LogManager::DispatchToListeners(const LogMessage &message) {
 	std::lock_guard<std::mutex> listeners_lock(listeners_lock_);
 	for (auto &iter : listeners_) {
 		iter->Log(message);
 	}
 }
 
+void LogManager::DrainThreadFunc() {
+	setCurrentThreadName("LogDrain");
+
+	std::unique_lock<std::mutex> lk(pending_lock_);
+	while (!stopDrainThread_) {
+		if (pending_.empty() && droppedMessages_ == 0) {
+			pending_cond_.wait(lk);
+			continue;
+		}
+		std::vector<LogMessage> batch = std::move(pending_);
+		pending_.clear();
+		int dropped = droppedMessages_;
+		droppedMessages_ = 0;
+		lk.unlock();
+
+		for (const auto &message : batch) {
+			DispatchToListeners(message);
+		}
+		if (dropped > 0) {
+			LogMessage note;
+			note.level = LogTypes::LWARNING;
+			note.log = log_[LogTypes::SYSTEM].m_shortName;
+			{
+				std::lock_guard<std::mutex> timeLock(log_lock_);
+				Common::Timer::GetTimeFormatted(note.timestamp);
+			}
+			snprintf(note.header, sizeof(note.header), "LogManager:0 %c[%s]:",
+				level_to_char[(int)note.level], note.log);
+			note.msg = StringFromFormat("Dropped %d log messages (queue full)\n", dropped);
+			DispatchToListeners(note);
+		}
+
+		lk.lock();
+	}
+}
+
+void LogManager::FlushPending() {
+	std::vector<LogMessage> batch;
+	{
+		std::lock_guard<std::mutex> lk(pending_lock_);
+		batch = std::move(pending_);
+		pending_.clear();
+		droppedMessages_ = 0;
+	}
+	for (const auto &message : batch) {
+		DispatchToListeners(message);
+	}
+}
+
 bool LogManager::IsEnabled(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type) {
 	LogChannel &log = log_[type];
 	if (level > log.level || !log.enabled)
@@ -19,8 +19,10 @@
 
 #include "ppsspp_config.h"
 
-#include <vector>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "file/ini_file.h"
 #include "Log.h"
@@ -113,6 +115,9 @@ private:
 	LogManager(const LogManager &) = delete;
 	void operator=(const LogManager &) = delete;
 
+	void DispatchToListeners(const LogMessage &message);
+	void DrainThreadFunc();
+
 	LogChannel log_[LogTypes::NUMBER_OF_LOGS];
 	FileLogListener *fileLog_ = nullptr;
 	ConsoleListener *consoleLog_ = nullptr;
@@ -123,6 +128,16 @@ private:
 	std::mutex log_lock_;
 	std::mutex listeners_lock_;
 	std::vector<LogListener*> listeners_;
+
+	// Warning-and-below messages get queued here and dispatched to the
+	// listeners on a background thread, so console/file I/O doesn't stall the
+	// emu threads. Bounded and lossy - see Log() in the .cpp.
+	std::thread drainThread_;
+	std::mutex pending_lock_;
+	std::condition_variable pending_cond_;
+	std::vector<LogMessage> pending_;
+	int droppedMessages_ = 0;
+	bool stopDrainThread_ = false;
 public:
 	void AddListener(LogListener *listener);
 	void RemoveListener(LogListener *listener);
@@ -179,6 +194,9 @@ public:
 	static void Init();
 	static void Shutdown();
 
+	// Synchronously dispatches anything still queued for the drain thread.
+	void FlushPending();
+
 	void ChangeFileLog(const char *filename);
 
 	void SaveConfig(IniFile::Section *section);
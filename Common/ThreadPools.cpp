@@ -10,6 +10,11 @@ void GlobalThreadPool::Loop(const std::function<void(int,int)>& loop, int lower,
 	pool->ParallelLoop(loop, lower, upper);
 }
 
+std::shared_ptr<ThreadPool::LoopToken> GlobalThreadPool::LoopAsync(const std::function<void(int,int)>& loop, int lower, int upper) {
+	Inititialize();
+	return pool->ParallelLoopAsync(loop, lower, upper);
+}
+
 void GlobalThreadPool::Inititialize() {
 	if(!initialized) {
 		pool = std::make_shared<ThreadPool>(g_Config.iNumWorkerThreads);
@@ -8,6 +8,10 @@ public:
 	// in parallel on the global thread pool
 	static void Loop(const std::function<void(int,int)>& loop, int lower, int upper);
 
+	// same, but returns immediately - call Wait() on the token before
+	// touching the results
+	static std::shared_ptr<ThreadPool::LoopToken> LoopAsync(const std::function<void(int,int)>& loop, int lower, int upper);
+
 private:
 	static std::shared_ptr<ThreadPool> pool;
 	static bool initialized;
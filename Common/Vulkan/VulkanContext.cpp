@@ -641,6 +641,7 @@ VkResult VulkanContext::CreateDevice() {
 		extensionsLookup_.KHR_depth_stencil_resolve = EnableDeviceExtension(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME);
 	}
 	extensionsLookup_.EXT_shader_stencil_export = EnableDeviceExtension(VK_EXT_SHADER_STENCIL_EXPORT_EXTENSION_NAME);
+	extensionsLookup_.GOOGLE_display_timing = EnableDeviceExtension(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME);
 
 	VkDeviceCreateInfo device_info{ VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
 	device_info.queueCreateInfoCount = 1;
@@ -945,9 +946,15 @@ bool VulkanContext::InitSwapchain() {
 		}
 	}
 #ifdef __ANDROID__
-	// HACK
-	swapchainPresentMode = VK_PRESENT_MODE_FIFO_KHR;
+	// Default to FIFO on Android - other modes have behaved badly on some presentation
+	// engines. A mailbox/immediate flag only gets through when the frontend explicitly
+	// asked for low-latency presentation (VSync off).
+	if ((flags_ & (VULKAN_FLAG_PRESENT_MAILBOX | VULKAN_FLAG_PRESENT_IMMEDIATE)) == 0 ||
+		(swapchainPresentMode != VK_PRESENT_MODE_MAILBOX_KHR && swapchainPresentMode != VK_PRESENT_MODE_IMMEDIATE_KHR)) {
+		swapchainPresentMode = VK_PRESENT_MODE_FIFO_KHR;
+	}
 #endif
+	presentMode_ = swapchainPresentMode;
 	ILOG("Chosen present mode: %d (%s)", swapchainPresentMode, PresentModeString(swapchainPresentMode));
 	delete[] presentModes;
 	// Determine the number of VkImage's to use in the swap chain (we desire to
@@ -253,6 +253,9 @@ public:
 	VkFormat GetSwapchainFormat() const {
 		return swapchainFormat_;
 	}
+	VkPresentModeKHR GetPresentMode() const {
+		return presentMode_;
+	}
 
 	// 1 for no frame overlap and thus minimal latency but worst performance.
 	// 2 is an OK compromise, while 3 performs best but risks slightly higher latency.
@@ -312,6 +315,7 @@ private:
 
 	// Swap chain extent
 	VkExtent2D swapChainExtent_{};
+	VkPresentModeKHR presentMode_ = VK_PRESENT_MODE_FIFO_KHR;
 
 	int flags_ = 0;
 
@@ -355,3 +359,4 @@ void finalize_glslang();
 bool GLSLtoSPV(const VkShaderStageFlagBits shader_type, const char *pshader, std::vector<uint32_t> &spirv, std::string *errorMessage = nullptr);
 
 const char *VulkanResultToString(VkResult res);
+const char *PresentModeString(VkPresentModeKHR presentMode);
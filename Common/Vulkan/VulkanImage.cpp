@@ -179,6 +179,10 @@ void VulkanTexture::UploadMip(VkCommandBuffer cmd, int mip, int mipWidth, int mi
 	vkCmdCopyBufferToImage(cmd, buffer, image_, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy_region);
 }
 
+void VulkanTexture::UploadMips(VkCommandBuffer cmd, VkBuffer buffer, int numRegions, const VkBufferImageCopy *regions) {
+	vkCmdCopyBufferToImage(cmd, buffer, image_, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, numRegions, regions);
+}
+
 void VulkanTexture::GenerateMip(VkCommandBuffer cmd, int mip) {
 	_assert_msg_(G3D, mip != 0, "Cannot generate the first level");
 	_assert_msg_(G3D, mip < numMips_, "Cannot generate mipmaps past the maximum created (%d vs %d)", mip, numMips_);
@@ -20,6 +20,9 @@ public:
 	// When using UploadMip, initialLayout should be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL.
 	bool CreateDirect(VkCommandBuffer cmd, VulkanDeviceAllocator *allocator, int w, int h, int numMips, VkFormat format, VkImageLayout initialLayout, VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, const VkComponentMapping *mapping = nullptr);
 	void UploadMip(VkCommandBuffer cmd, int mip, int mipWidth, int mipHeight, VkBuffer buffer, uint32_t offset, size_t rowLength);  // rowLength is in pixels
+	// Batched version - all the mips in a single copy command. The regions must all
+	// source the same buffer, and the image must be in TRANSFER_DST_OPTIMAL.
+	void UploadMips(VkCommandBuffer cmd, VkBuffer buffer, int numRegions, const VkBufferImageCopy *regions);
 	void GenerateMip(VkCommandBuffer cmd, int mip);
 	void EndCreate(VkCommandBuffer cmd, bool vertexTexture = false);
 
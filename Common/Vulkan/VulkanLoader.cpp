@@ -192,6 +192,9 @@ PFN_vkGetSwapchainImagesKHR vkGetSwapchainImagesKHR;
 PFN_vkAcquireNextImageKHR vkAcquireNextImageKHR;
 PFN_vkQueuePresentKHR vkQueuePresentKHR;
 
+PFN_vkGetRefreshCycleDurationGOOGLE vkGetRefreshCycleDurationGOOGLE;
+PFN_vkGetPastPresentationTimingGOOGLE vkGetPastPresentationTimingGOOGLE;
+
 // And the DEBUG_REPORT extension. We dynamically load this.
 PFN_vkCreateDebugReportCallbackEXT vkCreateDebugReportCallbackEXT;
 PFN_vkDestroyDebugReportCallbackEXT vkDestroyDebugReportCallbackEXT;
@@ -625,6 +628,10 @@ void VulkanLoadDeviceFunctions(VkDevice device, const VulkanDeviceExtensions &en
 		LOAD_DEVICE_FUNC(device, vkGetBufferMemoryRequirements2KHR);
 		LOAD_DEVICE_FUNC(device, vkGetImageMemoryRequirements2KHR);
 	}
+	if (enabledExtensions.GOOGLE_display_timing) {
+		LOAD_DEVICE_FUNC(device, vkGetRefreshCycleDurationGOOGLE);
+		LOAD_DEVICE_FUNC(device, vkGetPastPresentationTimingGOOGLE);
+	}
 }
 
 void VulkanFree() {
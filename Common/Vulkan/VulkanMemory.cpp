@@ -58,7 +58,12 @@ bool VulkanPushBuffer::AddBuffer() {
 	// Okay, that's the buffer. Now let's allocate some memory for it.
 	VkMemoryAllocateInfo alloc{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
 	alloc.allocationSize = reqs.size;
-	vulkan_->MemoryTypeFromProperties(reqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &alloc.memoryTypeIndex);
+	// Prefer coherent memory. If only non-coherent host-visible memory exists, we
+	// fall back to that and do one batched flush per frame in Unmap() instead.
+	if (!vulkan_->MemoryTypeFromProperties(reqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &alloc.memoryTypeIndex)) {
+		coherent_ = false;
+		vulkan_->MemoryTypeFromProperties(reqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &alloc.memoryTypeIndex);
+	}
 
 	res = vkAllocateMemory(device, &alloc, nullptr, &info.deviceMemory);
 	if (VK_SUCCESS != res) {
@@ -74,6 +79,15 @@ bool VulkanPushBuffer::AddBuffer() {
 		return false;
 	}
 
+	// Map the buffer persistently - mapping and unmapping per frame is just overhead.
+	res = vkMapMemory(device, info.deviceMemory, 0, VK_WHOLE_SIZE, 0, (void **)&info.writePtr);
+	if (VK_SUCCESS != res) {
+		ELOG("vkMapMemory failed! result=%d", (int)res);
+		vkFreeMemory(device, info.deviceMemory, nullptr);
+		vkDestroyBuffer(device, info.buffer, nullptr);
+		return false;
+	}
+
 	buffers_.push_back(info);
 	buf_ = buffers_.size() - 1;
 	return true;
@@ -81,6 +95,7 @@ bool VulkanPushBuffer::AddBuffer() {
 
 void VulkanPushBuffer::Destroy(VulkanContext *vulkan) {
 	for (BufInfo &info : buffers_) {
+		vkUnmapMemory(vulkan->GetDevice(), info.deviceMemory);
 		vulkan->Delete().QueueDeleteBuffer(info.buffer);
 		vulkan->Delete().QueueDeleteDeviceMemory(info.deviceMemory);
 	}
@@ -117,9 +132,11 @@ void VulkanPushBuffer::Defragment(VulkanContext *vulkan) {
 	}
 
 	// Okay, we have more than one.  Destroy them all and start over with a larger one.
-	size_t newSize = size_ * buffers_.size();
-	Destroy(vulkan);
+	Grow(vulkan, size_ * buffers_.size());
+}
 
+void VulkanPushBuffer::Grow(VulkanContext *vulkan, size_t newSize) {
+	Destroy(vulkan);
 	size_ = newSize;
 	bool res = AddBuffer();
 	assert(res);
@@ -135,22 +152,26 @@ size_t VulkanPushBuffer::GetTotalSize() const {
 
 void VulkanPushBuffer::Map() {
 	_dbg_assert_(G3D, !writePtr_);
-	VkResult res = vkMapMemory(vulkan_->GetDevice(), buffers_[buf_].deviceMemory, 0, size_, 0, (void **)(&writePtr_));
+	// The buffers are persistently mapped, so this is just a pointer switch.
+	writePtr_ = buffers_[buf_].writePtr;
 	_dbg_assert_(G3D, writePtr_);
-	assert(VK_SUCCESS == res);
 }
 
 void VulkanPushBuffer::Unmap() {
 	_dbg_assert_(G3D, writePtr_ != 0);
-	/*
-	// Should not need this since we use coherent memory.
-	VkMappedMemoryRange range{ VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE };
-	range.offset = 0;
-	range.size = offset_;
-	range.memory = buffers_[buf_].deviceMemory;
-	vkFlushMappedMemoryRanges(device_, 1, &range);
-	*/
-	vkUnmapMemory(vulkan_->GetDevice(), buffers_[buf_].deviceMemory);
+	// Coherent memory needs no flush, and the persistent mapping stays. On non-coherent
+	// memory we batch everything written since Map() into a single flush, rounded up to
+	// the non-coherent atom size.
+	if (!coherent_ && offset_ > 0) {
+		const VkDeviceSize atom = vulkan_->GetPhysicalDeviceProperties().properties.limits.nonCoherentAtomSize;
+		VkMappedMemoryRange range{ VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE };
+		range.memory = buffers_[buf_].deviceMemory;
+		range.offset = 0;
+		range.size = ((VkDeviceSize)offset_ + atom - 1) & ~(atom - 1);
+		if (range.size > (VkDeviceSize)size_)
+			range.size = VK_WHOLE_SIZE;
+		vkFlushMappedMemoryRanges(vulkan_->GetDevice(), 1, &range);
+	}
 	writePtr_ = nullptr;
 }
 
@@ -19,6 +19,9 @@ class VulkanPushBuffer {
 	struct BufInfo {
 		VkBuffer buffer;
 		VkDeviceMemory deviceMemory;
+		// Persistently mapped - Map()/Unmap() just switch the write pointer around
+		// (and flush, on memory types without HOST_COHERENT).
+		uint8_t *writePtr;
 	};
 
 public:
@@ -35,6 +38,10 @@ public:
 		offset_ = 0;
 		// Note: we must defrag because some buffers may be smaller than size_.
 		Defragment(vulkan);
+		// If the last frame came close to filling the buffer, grow it up front -
+		// a mid-frame buffer allocation on overflow is a visible spike.
+		if (lastFrameUsed_ + lastFrameUsed_ / 8 > size_)
+			Grow(vulkan, size_ << 1);
 		Map();
 	}
 
@@ -43,6 +50,9 @@ public:
 	}
 
 	void End() {
+		lastFrameUsed_ = GetTotalSize();
+		if (lastFrameUsed_ > maxUsed_)
+			maxUsed_ = lastFrameUsed_;
 		Unmap();
 	}
 
@@ -103,18 +113,26 @@ public:
 
 	size_t GetTotalSize() const;
 
+	// Telemetry for tuning the initial size.
+	size_t GetUsedLastFrame() const { return lastFrameUsed_; }
+	size_t GetPeakUsed() const { return maxUsed_; }
+
 private:
 	bool AddBuffer();
 	void NextBuffer(size_t minSize);
 	void Defragment(VulkanContext *vulkan);
+	void Grow(VulkanContext *vulkan, size_t newSize);
 
 	VulkanContext *vulkan_;
 	std::vector<BufInfo> buffers_;
 	size_t buf_ = 0;
 	size_t offset_ = 0;
 	size_t size_ = 0;
+	size_t lastFrameUsed_ = 0;
+	size_t maxUsed_ = 0;
 	uint8_t *writePtr_ = nullptr;
 	VkBufferUsageFlags usage_;
+	bool coherent_ = true;
 };
 
 // VulkanDeviceAllocator
@@ -8,9 +8,16 @@
 #define __STDC_CONSTANT_MACROS 1
 #endif
 
-#include <string>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <mutex>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "thread/threadutil.h"
 
 #ifdef USE_FFMPEG
 
@@ -62,6 +69,29 @@ static int s_current_height;
 static int s_file_index = 0;
 static GPUDebugBuffer buf;
 
+// The readback has to happen on the emu thread, but the scale/encode/write
+// doesn't - that part runs on an encoder thread behind a bounded frame queue,
+// so recording doesn't freeze emulation. When the encoder falls behind, new
+// frames are dropped (and counted) rather than stalling the game.
+struct QueuedVideoFrame {
+	std::vector<u8> rgb888;
+	u32 w;
+	u32 h;
+};
+
+static std::thread s_encode_thread;
+static std::mutex s_frames_lock;
+static std::condition_variable s_frames_cond;
+static std::deque<QueuedVideoFrame> s_frames;
+static bool s_stop_encode_thread = false;
+static bool s_encode_thread_running = false;
+static int s_dropped_frames = 0;
+
+enum { MAX_QUEUED_VIDEO_FRAMES = 8 };
+
+static void EncodeFrame(const u8 *buffer, u32 w, u32 h);
+static void EncodeThreadFunc();
+
 static void InitAVCodec() {
 	static bool first_run = true;
 	if (first_run) {
@@ -81,8 +111,14 @@ bool AVIDump::Start(int w, int h)
 
 	InitAVCodec();
 	bool success = CreateAVI();
-	if (!success)
+	if (!success) {
 		CloseFile();
+	} else {
+		s_stop_encode_thread = false;
+		s_dropped_frames = 0;
+		s_encode_thread = std::thread(&EncodeThreadFunc);
+		s_encode_thread_running = true;
+	}
 	return success;
 }
 
@@ -167,6 +203,23 @@ static void PreparePacket(AVPacket* pkt) {
 
 #endif
 
+static void EncodeThreadFunc() {
+	setCurrentThreadName("AVIDump");
+
+	std::unique_lock<std::mutex> lock(s_frames_lock);
+	while (!s_stop_encode_thread || !s_frames.empty()) {
+		if (s_frames.empty()) {
+			s_frames_cond.wait(lock);
+			continue;
+		}
+		QueuedVideoFrame frame = std::move(s_frames.front());
+		s_frames.pop_front();
+		lock.unlock();
+		EncodeFrame(frame.rgb888.data(), frame.w, frame.h);
+		lock.lock();
+	}
+}
+
 void AVIDump::AddFrame()
 {
 	gpuDebug->GetCurrentFramebuffer(buf, GPU_DBG_FRAMEBUF_DISPLAY);
@@ -176,6 +229,26 @@ void AVIDump::AddFrame()
 	u8 *flipbuffer = nullptr;
 	const u8 *buffer = ConvertBufferToScreenshot(buf, false, flipbuffer, w, h);
 
+	if (buffer) {
+		std::lock_guard<std::mutex> lock(s_frames_lock);
+		if (s_frames.size() >= MAX_QUEUED_VIDEO_FRAMES) {
+			// Dropping is better than stalling the game; dropped frames show
+			// up as a slightly fast-forwarded video.
+			s_dropped_frames++;
+		} else {
+			QueuedVideoFrame frame;
+			frame.rgb888.assign(buffer, buffer + w * h * 3);
+			frame.w = w;
+			frame.h = h;
+			s_frames.push_back(std::move(frame));
+			s_frames_cond.notify_one();
+		}
+	}
+	delete[] flipbuffer;
+}
+
+static void EncodeFrame(const u8 *buffer, u32 w, u32 h)
+{
 #ifdef USE_FFMPEG
 
 	s_src_frame->data[0] = const_cast<u8*>(buffer);
@@ -224,10 +297,23 @@ void AVIDump::AddFrame()
 	if (error)
 		ERROR_LOG(G3D, "Error while encoding video: %d", error);
 #endif
-	delete[] flipbuffer;
 }
 
 void AVIDump::Stop() {
+	// Let the encoder finish everything queued before closing the file.
+	if (s_encode_thread_running) {
+		{
+			std::lock_guard<std::mutex> lock(s_frames_lock);
+			s_stop_encode_thread = true;
+		}
+		s_frames_cond.notify_one();
+		s_encode_thread.join();
+		s_encode_thread_running = false;
+	}
+	if (s_dropped_frames > 0) {
+		WARN_LOG(G3D, "Video dump dropped %d frames (encoder couldn't keep up)", s_dropped_frames);
+		s_dropped_frames = 0;
+	}
 #ifdef USE_FFMPEG
 
 	av_write_trailer(s_format_context);
@@ -38,6 +38,16 @@ void Compatibility::Load(const std::string &gameID) {
 			CheckSettings(compat2, gameID);
 		}
 	}
+
+	{
+		IniFile compat3;
+		// Merged last so externally provisioned installs (kiosks and the like)
+		// can override flags per game without a new build or touching the above.
+		std::string path = GetSysDirectory(DIRECTORY_SYSTEM) + "compatoverride.ini";
+		if (compat3.Load(path)) {
+			CheckSettings(compat3, gameID);
+		}
+	}
 }
 
 void Compatibility::Clear() {
@@ -56,6 +66,7 @@ void Compatibility::CheckSettings(IniFile &iniFile, const std::string &gameID) {
 	CheckSetting(iniFile, gameID, "RequireBlockTransfer", &flags_.RequireBlockTransfer);
 	CheckSetting(iniFile, gameID, "RequireDefaultCPUClock", &flags_.RequireDefaultCPUClock);
 	CheckSetting(iniFile, gameID, "DisableReadbacks", &flags_.DisableReadbacks);
+	CheckSetting(iniFile, gameID, "DelayedReadbacks", &flags_.DelayedReadbacks);
 	CheckSetting(iniFile, gameID, "DisableAccurateDepth", &flags_.DisableAccurateDepth);
 	CheckSetting(iniFile, gameID, "MGS2AcidHack", &flags_.MGS2AcidHack);
 	CheckSetting(iniFile, gameID, "SonicRivalsHack", &flags_.SonicRivalsHack);
@@ -64,8 +75,15 @@ void Compatibility::CheckSettings(IniFile &iniFile, const std::string &gameID) {
 	CheckSetting(iniFile, gameID, "ForceUMDDelay", &flags_.ForceUMDDelay);
 	CheckSetting(iniFile, gameID, "ForceMax60FPS", &flags_.ForceMax60FPS);
 	CheckSetting(iniFile, gameID, "JitInvalidationHack", &flags_.JitInvalidationHack);
+	CheckSetting(iniFile, gameID, "MemStickWriteBack", &flags_.MemStickWriteBack);
+	CheckSetting(iniFile, gameID, "DepthReadback", &flags_.DepthReadback);
+	CheckSetting(iniFile, gameID, "AccurateVFPUTranscendentals", &flags_.AccurateVFPUTranscendentals);
 }
 
 void Compatibility::CheckSetting(IniFile &iniFile, const std::string &gameID, const char *option, bool *flag) {
 	iniFile.Get(option, gameID.c_str(), flag, *flag);
 }
+
+void Compatibility::CheckSetting(IniFile &iniFile, const std::string &gameID, const char *option, int *value) {
+	iniFile.Get(option, gameID.c_str(), value, *value);
+}
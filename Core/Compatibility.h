@@ -22,7 +22,9 @@
 
 // Compatibility flags are controlled by assets/compat.ini.
 // Alternatively, if PSP/SYSTEM/compat.ini exists, it is merged on top, to enable editing
-// the file on Android for tests.
+// the file on Android for tests. Finally, PSP/SYSTEM/compatoverride.ini is merged last,
+// so deployments that provision the memstick directory externally can override flags
+// without shipping a new build.
 //
 // This file is not meant to be user-editable, although is kept as a separate ini
 // file instead of compiled into the code for debugging purposes.
@@ -56,6 +58,7 @@ struct CompatFlags {
 	bool RequireBlockTransfer;
 	bool RequireDefaultCPUClock;
 	bool DisableReadbacks;
+	bool DelayedReadbacks;
 	bool DisableAccurateDepth;
 	bool MGS2AcidHack;
 	bool SonicRivalsHack;
@@ -64,6 +67,9 @@ struct CompatFlags {
 	bool ForceUMDDelay;
 	bool ForceMax60FPS;
 	bool JitInvalidationHack;
+	bool MemStickWriteBack;
+	bool DepthReadback;
+	bool AccurateVFPUTranscendentals;
 };
 
 class IniFile;
@@ -83,6 +89,7 @@ private:
 	void Clear();
 	void CheckSettings(IniFile &iniFile, const std::string &gameID);
 	void CheckSetting(IniFile &iniFile, const std::string &gameID, const char *option, bool *flag);
+	void CheckSetting(IniFile &iniFile, const std::string &gameID, const char *option, int *value);
 
 	CompatFlags flags_;
 };
@@ -21,6 +21,8 @@
 #include <functional>
 #include <set>
 
+#include "ppsspp_config.h"
+
 #include "base/display.h"
 #include "base/NativeApp.h"
 #include "file/ini_file.h"
@@ -401,6 +403,7 @@ static ConfigSetting generalSettings[] = {
 
 	ReportedConfigSetting("NumWorkerThreads", &g_Config.iNumWorkerThreads, &DefaultNumWorkers, true, true),
 	ConfigSetting("AutoLoadSaveState", &g_Config.iAutoLoadSaveState, 0, true, true),
+	ConfigSetting("BootSnapshot", &g_Config.bBootSnapshot, false, true, true),
 	ReportedConfigSetting("EnableCheats", &g_Config.bEnableCheats, false, true, true),
 	ConfigSetting("CwCheatRefreshRate", &g_Config.iCwCheatRefreshRate, 77, true, true),
 
@@ -467,7 +470,10 @@ static ConfigSetting cpuSettings[] = {
 	ConfigSetting("HideStateWarnings", &g_Config.bHideStateWarnings, false, true, false),
 	ConfigSetting("PreloadFunctions", &g_Config.bPreloadFunctions, false, true, true),
 	ConfigSetting("JitDisableFlags", &g_Config.uJitDisableFlags, (uint32_t)0, true, true),
+	ConfigSetting("JitCodeCacheMB", &g_Config.iJitCodeCacheMB, 16, true, true),
+	ConfigSetting("JitBlockProfiling", &g_Config.bJitBlockProfiling, false, true, true),
 	ReportedConfigSetting("CPUSpeed", &g_Config.iLockedCPUSpeed, 0, true, true),
+	ReportedConfigSetting("AdaptiveCPUSpeed", &g_Config.bAdaptiveCPUSpeed, false, true, true),
 
 	ConfigSetting(false),
 };
@@ -610,11 +616,13 @@ static ConfigSetting graphicsSettings[] = {
 	ReportedConfigSetting("TextureFiltering", &g_Config.iTexFiltering, 1, true, true),
 	ReportedConfigSetting("BufferFiltering", &g_Config.iBufFilter, SCALE_LINEAR, true, true),
 	ReportedConfigSetting("InternalResolution", &g_Config.iInternalResolution, &DefaultInternalResolution, true, true),
+	ReportedConfigSetting("DynamicResolution", &g_Config.bDynamicResolution, false, true, true),
 	ReportedConfigSetting("AndroidHwScale", &g_Config.iAndroidHwScale, &DefaultAndroidHwScale),
 	ReportedConfigSetting("HighQualityDepth", &g_Config.bHighQualityDepth, true, true, true),
 	ReportedConfigSetting("FrameSkip", &g_Config.iFrameSkip, 0, true, true),
 	ReportedConfigSetting("FrameSkipType", &g_Config.iFrameSkipType, 0, true, true),
 	ReportedConfigSetting("AutoFrameSkip", &g_Config.bAutoFrameSkip, false, true, true),
+	ReportedConfigSetting("StaticFrameSkip", &g_Config.bStaticFrameSkip, false, true, true),
 	ConfigSetting("FrameRate", &g_Config.iFpsLimit1, 0, true, true),
 	ConfigSetting("FrameRate2", &g_Config.iFpsLimit2, -1, true, true),
 	ConfigSetting("FrameSkipUnthrottle", &g_Config.bFrameSkipUnthrottle, &DefaultFrameskipUnthrottle, true, false),
@@ -628,6 +636,8 @@ static ConfigSetting graphicsSettings[] = {
 	ReportedConfigSetting("VertexDecCache", &g_Config.bVertexCache, &DefaultVertexCache, true, true),
 	ReportedConfigSetting("TextureBackoffCache", &g_Config.bTextureBackoffCache, false, true, true),
 	ReportedConfigSetting("TextureSecondaryCache", &g_Config.bTextureSecondaryCache, false, true, true),
+	ConfigSetting("TextureColdCache", &g_Config.bTextureColdCache, true, true, true),
+	ReportedConfigSetting("DeferTextureLoads", &g_Config.bDeferTextureLoads, false, true, true),
 	ReportedConfigSetting("VertexDecJit", &g_Config.bVertexDecoderJit, &DefaultCodeGen, false),
 
 #ifndef MOBILE_DEVICE
@@ -649,7 +659,15 @@ static ConfigSetting graphicsSettings[] = {
 	ReportedConfigSetting("TexScalingLevel", &g_Config.iTexScalingLevel, 1, true, true),
 	ReportedConfigSetting("TexScalingType", &g_Config.iTexScalingType, 0, true, true),
 	ReportedConfigSetting("TexDeposterize", &g_Config.bTexDeposterize, false, true, true),
+	ReportedConfigSetting("GenerateMipmaps", &g_Config.bGenerateMipmaps, false, true, true),
+	ConfigSetting("TexScalingCache", &g_Config.bTexScalingCache, false, true, true),
+#if PPSSPP_PLATFORM(ANDROID)
+	// On Android this only affects the Vulkan backend's present mode - keep
+	// synced (FIFO) presentation as the default there.
+	ConfigSetting("VSyncInterval", &g_Config.bVSync, true, true, true),
+#else
 	ConfigSetting("VSyncInterval", &g_Config.bVSync, false, true, true),
+#endif
 	ReportedConfigSetting("BloomHack", &g_Config.iBloomHack, 0, true, true),
 
 	// Not really a graphics setting...
@@ -675,6 +693,7 @@ static ConfigSetting soundSettings[] = {
 	ConfigSetting("ExtraAudioBuffering", &g_Config.bExtraAudioBuffering, false, true, false),
 	ConfigSetting("SoundSpeedHack", &g_Config.bSoundSpeedHack, false, true, true),
 	ConfigSetting("AudioResampler", &g_Config.bAudioResampler, true, true, true),
+	ConfigSetting("AudioResamplerHQ", &g_Config.bAudioResamplerHQ, false, true, true),
 	ConfigSetting("GlobalVolume", &g_Config.iGlobalVolume, VOLUME_MAX, true, true),
 
 	ConfigSetting(false),
@@ -741,6 +760,7 @@ static ConfigSetting controlSettings[] = {
 
 	ConfigSetting("DisableDpadDiagonals", &g_Config.bDisableDpadDiagonals, false, true, true),
 	ConfigSetting("GamepadOnlyFocused", &g_Config.bGamepadOnlyFocused, false, true, true),
+	ConfigSetting("LowLatencyInput", &g_Config.bLowLatencyInput, false, true, true),
 	ConfigSetting("TouchButtonStyle", &g_Config.iTouchButtonStyle, 1, true, true),
 	ConfigSetting("TouchButtonOpacity", &g_Config.iTouchButtonOpacity, 65, true, true),
 	ConfigSetting("TouchButtonHideSeconds", &g_Config.iTouchButtonHideSeconds, 20, true, true),
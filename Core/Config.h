@@ -94,11 +94,18 @@ public:
 	bool bHideStateWarnings;
 	bool bPreloadFunctions;
 	uint32_t uJitDisableFlags;
+	// Initial jit code space size in MB. The jits grow the arena on overflow
+	// (up to their branch-reach limits), this just sets where they start.
+	int iJitCodeCacheMB;
+	// Counts block entries and periodically re-lays-out hot blocks contiguously.
+	// Costs a few instructions per block entry, so off by default.
+	bool bJitBlockProfiling;
 
 	bool bSeparateSASThread;
 	bool bSeparateIOThread;
 	int iIOTimingMethod;
 	int iLockedCPUSpeed;
+	bool bAdaptiveCPUSpeed;  // Underclock the emulated CPU while the game only waits for vblank.
 	bool bAutoSaveSymbolMap;
 	bool bCacheFullIsoInRam;
 	int iRemoteISOPort;
@@ -147,6 +154,7 @@ public:
 	int iFrameSkip;
 	int iFrameSkipType;
 	bool bAutoFrameSkip;
+	bool bStaticFrameSkip;  // Skip every other frame's draws while the scene is detected as static.
 	bool bFrameSkipUnthrottle;
 
 	bool bEnableCardboard; // Cardboard Master Switch
@@ -162,10 +170,14 @@ public:
 	bool bVertexCache;
 	bool bTextureBackoffCache;
 	bool bTextureSecondaryCache;
+	bool bTextureColdCache;  // Keep evicted decoded textures compressed in host RAM.
+	bool bDeferTextureLoads;  // Budget new texture builds per frame, deferring the rest. Bounded staleness.
+	bool bTexScalingCache;  // Per-game on-disk cache of scaled texture output.
 	bool bVertexDecoderJit;
 	bool bFullScreen;
 	bool bFullScreenMulti;
 	int iInternalResolution;  // 0 = Auto (native), 1 = 1x (480x272), 2 = 2x, 3 = 3x, 4 = 4x and so on.
+	bool bDynamicResolution;  // Scale render resolution down from the above (at most to 1x) to hold full speed.
 	int iAnisotropyLevel;  // 0 - 5, powers of 2: 0 = 1x = no aniso
 	int bHighQualityDepth;
 	bool bReplaceTextures;
@@ -174,6 +186,7 @@ public:
 	int iTexScalingLevel; // 0 = auto, 1 = off, 2 = 2x, ..., 5 = 5x
 	int iTexScalingType; // 0 = xBRZ, 1 = Hybrid
 	bool bTexDeposterize;
+	bool bGenerateMipmaps;  // Autogenerate mips on the GPU for textures that only supply mip 0.
 	int iFpsLimit1;
 	int iFpsLimit2;
 	int iMaxRecent;
@@ -181,6 +194,7 @@ public:
 	int iRewindFlipFrequency;
 	bool bEnableStateUndo;
 	int iAutoLoadSaveState; // 0 = off, 1 = oldest, 2 = newest, >2 = slot number + 3
+	bool bBootSnapshot; // Auto-capture a state shortly after boot, resume from it on launch.
 	bool bEnableCheats;
 	bool bReloadCheats;
 	int iCwCheatRefreshRate;
@@ -242,6 +256,7 @@ public:
 	bool bShowDebugStats;
 	bool bShowAudioDebug;
 	bool bAudioResampler;
+	bool bAudioResamplerHQ;  // Polyphase FIR tier instead of linear interpolation.
 
 	//Analog stick tilting
 	//the base x and y tilt. this inclination is treated as (0,0) and the tilt input
@@ -269,6 +284,9 @@ public:
 	// Disable diagonals
 	bool bDisableDpadDiagonals;
 	bool bGamepadOnlyFocused;
+	// Sample the current input state when games poll, instead of returning the
+	// last vblank sample. Cuts up to a frame of input latency in rhythm games.
+	bool bLowLatencyInput;
 	// Control Style
 	int iTouchButtonStyle;
 	int iTouchButtonOpacity;
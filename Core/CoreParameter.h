@@ -79,6 +79,10 @@ struct CoreParameter {
 	bool unthrottle = false;
 	FPSLimit fpsLimit = FPSLimit::NORMAL;
 
+	// When dynamic resolution is on, the governor in sceDisplay caps the
+	// render zoom factor here. 0 = no cap.
+	int dynamicResZoomCap = 0;
+
 	bool updateRecent = true;
 
 	// Freeze-frame. For nvidia perfhud profiling. Developers only.
@@ -16,6 +16,7 @@
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
 
+#include <algorithm>
 #include <vector>
 #include <cstdio>
 #include <mutex>
@@ -31,6 +32,7 @@
 #include "Core/HLE/sceKernelThread.h"
 #include "Core/HLE/sceDisplay.h"
 #include "Core/MIPS/MIPS.h"
+#include "Core/MIPS/MIPSSampleProfiler.h"
 #include "Core/Reporting.h"
 #include "Common/ChunkFile.h"
 
@@ -67,12 +69,25 @@ struct BaseEvent
 
 typedef LinkedListItem<BaseEvent> Event;
 
-Event *first;
+// The main queue is a 4-ary min-heap in one contiguous slab - scheduling and
+// firing are O(log n) with good locality, instead of the old sorted list's
+// O(n) insertion walk. The sequence number tie-breaks equal times so that
+// same-time events still fire in scheduling order, like the list did.
+struct HeapEvent
+{
+	s64 time;
+	u64 userdata;
+	int type;
+	u64 seq;
+};
+
+static std::vector<HeapEvent> eventHeap;
+static u64 eventSeq;
+
 Event *tsFirst;
 Event *tsLast;
 
-// event pools
-Event *eventPool = 0;
+// event pool for the threadsafe queue
 Event *eventTsPool = 0;
 int allocatedTsEvents = 0;
 // Optimization to skip MoveEvents when possible.
@@ -87,10 +102,81 @@ s64 idledCycles;
 s64 lastGlobalTimeTicks;
 s64 lastGlobalTimeUs;
 
+static void RecalcUsPerTickRecip();
+
 static std::mutex externalEventLock;
 
 std::vector<MHzChangeCallback> mhzChangeCallbacks;
 
+static inline bool EventBefore(const HeapEvent &a, const HeapEvent &b)
+{
+	if (a.time != b.time)
+		return a.time < b.time;
+	return a.seq < b.seq;
+}
+
+static void SiftUp(size_t i)
+{
+	HeapEvent ev = eventHeap[i];
+	while (i > 0)
+	{
+		size_t parent = (i - 1) / 4;
+		if (!EventBefore(ev, eventHeap[parent]))
+			break;
+		eventHeap[i] = eventHeap[parent];
+		i = parent;
+	}
+	eventHeap[i] = ev;
+}
+
+static void SiftDown(size_t i)
+{
+	const size_t n = eventHeap.size();
+	HeapEvent ev = eventHeap[i];
+	for (;;)
+	{
+		size_t child = i * 4 + 1;
+		if (child >= n)
+			break;
+		size_t best = child;
+		size_t last = std::min(child + 4, n);
+		for (size_t c = child + 1; c < last; ++c)
+		{
+			if (EventBefore(eventHeap[c], eventHeap[best]))
+				best = c;
+		}
+		if (!EventBefore(eventHeap[best], ev))
+			break;
+		eventHeap[i] = eventHeap[best];
+		i = best;
+	}
+	eventHeap[i] = ev;
+}
+
+static void PushEvent(s64 time, int type, u64 userdata)
+{
+	HeapEvent ev = { time, userdata, type, eventSeq++ };
+	eventHeap.push_back(ev);
+	SiftUp(eventHeap.size() - 1);
+}
+
+static void PopEvent()
+{
+	eventHeap[0] = eventHeap.back();
+	eventHeap.pop_back();
+	if (!eventHeap.empty())
+		SiftDown(0);
+}
+
+// Restore the heap property after arbitrary removals.
+static void Heapify()
+{
+	if (eventHeap.size() <= 1)
+		return;
+	for (int i = (int)((eventHeap.size() - 2) / 4); i >= 0; --i)
+		SiftDown(i);
+}
+
 void FireMhzChange() {
 	for (auto it = mhzChangeCallbacks.begin(), end = mhzChangeCallbacks.end(); it != end; ++it) {
 		MHzChangeCallback cb = *it;
@@ -106,6 +192,7 @@ void SetClockFrequencyMHz(int cpuMhz)
 	lastGlobalTimeTicks = GetTicks();
 
 	CPU_HZ = cpuMhz * 1000000;
+	RecalcUsPerTickRecip();
 	// TODO: Rescale times of scheduled events?
 
 	FireMhzChange();
@@ -116,30 +203,54 @@ int GetClockFrequencyMHz()
 	return CPU_HZ / 1000000;
 }
 
-u64 GetGlobalTimeUsScaled()
+// Reciprocal of the clock frequency in MHz, so the heavily polled time queries
+// below can replace their 64-bit divide with a multiply-shift. Uses the round-up
+// method, which gives the exact quotient for any tick delta below RECIP_MAX_TICKS
+// as long as the divisor is below 2^(RECIP_SHIFT - 26). The per-slice rebase in
+// Advance() keeps the delta far below the limit in practice.
+static const int RECIP_SHIFT = 36;
+static const u64 RECIP_MAX_TICKS = 1ULL << 26;
+static u64 usPerTickRecip;
+static u64 recipMaxTicks;
+
+static void RecalcUsPerTickRecip()
 {
-	s64 ticksSinceLast = GetTicks() - lastGlobalTimeTicks;
 	int freq = GetClockFrequencyMHz();
-	s64 usSinceLast = ticksSinceLast / freq;
-	return lastGlobalTimeUs + usSinceLast;
+	if (freq > 0 && freq < 1024) {
+		usPerTickRecip = (1ULL << RECIP_SHIFT) / (u64)freq + 1;
+		recipMaxTicks = RECIP_MAX_TICKS;
+	} else {
+		// Outside the range the exactness argument covers - always divide.
+		usPerTickRecip = 0;
+		recipMaxTicks = 0;
+	}
 }
 
-u64 GetGlobalTimeUs()
+// Folds the whole microseconds elapsed since the cached base into the base,
+// leaving only the sub-microsecond tick remainder. One divide per slice instead
+// of one per time syscall.
+static void RebaseGlobalTime()
 {
-	s64 ticksSinceLast = GetTicks() - lastGlobalTimeTicks;
-	int freq = GetClockFrequencyMHz();
-	s64 usSinceLast = ticksSinceLast / freq;
-	return lastGlobalTimeUs + usSinceLast;
+	const int freq = GetClockFrequencyMHz();
+	s64 usSinceLast = (GetTicks() - lastGlobalTimeTicks) / freq;
+	lastGlobalTimeUs += usSinceLast;
+	lastGlobalTimeTicks += usSinceLast * freq;
 }
 
-Event* GetNewEvent()
+u64 GetGlobalTimeUsScaled()
 {
-	if(!eventPool)
-		return new Event;
+	u64 ticksSinceLast = (u64)(GetTicks() - lastGlobalTimeTicks);
+	if (ticksSinceLast < recipMaxTicks)
+		return lastGlobalTimeUs + (ticksSinceLast * usPerTickRecip >> RECIP_SHIFT);
+	return lastGlobalTimeUs + (s64)ticksSinceLast / GetClockFrequencyMHz();
+}
 
-	Event* ev = eventPool;
-	eventPool = ev->next;
-	return ev;
+u64 GetGlobalTimeUs()
+{
+	u64 ticksSinceLast = (u64)(GetTicks() - lastGlobalTimeTicks);
+	if (ticksSinceLast < recipMaxTicks)
+		return lastGlobalTimeUs + (ticksSinceLast * usPerTickRecip >> RECIP_SHIFT);
+	return lastGlobalTimeUs + (s64)ticksSinceLast / GetClockFrequencyMHz();
 }
 
 Event* GetNewTsEvent()
@@ -154,12 +265,6 @@ Event* GetNewTsEvent()
 	return ev;
 }
 
-void FreeEvent(Event* ev)
-{
-	ev->next = eventPool;
-	eventPool = ev;
-}
-
 void FreeTsEvent(Event* ev)
 {
 	ev->next = eventTsPool;
@@ -190,7 +295,7 @@ void RestoreRegisterEvent(int event_type, const char *name, TimedCallback callba
 
 void UnregisterAllEvents()
 {
-	if (first)
+	if (!eventHeap.empty())
 		PanicAlert("Cannot unregister events with events pending");
 	event_types.clear();
 }
@@ -206,6 +311,11 @@ void Init()
 	hasTsEvents = 0;
 	mhzChangeCallbacks.clear();
 	CPU_HZ = initialHz;
+	RecalcUsPerTickRecip();
+
+	eventHeap.clear();
+	eventHeap.reserve(64);
+	eventSeq = 0;
 }
 
 void Shutdown()
@@ -214,13 +324,6 @@ void Shutdown()
 	ClearPendingEvents();
 	UnregisterAllEvents();
 
-	while(eventPool)
-	{
-		Event *ev = eventPool;
-		eventPool = ev->next;
-		delete ev;
-	}
-
 	std::lock_guard<std::mutex> lk(externalEventLock);
 	while(eventTsPool)
 	{
@@ -275,30 +378,7 @@ void ScheduleEvent_Threadsafe_Immediate(int event_type, u64 userdata)
 
 void ClearPendingEvents()
 {
-	while (first)
-	{
-		Event *e = first->next;
-		FreeEvent(first);
-		first = e;
-	}
-}
-
-void AddEventToQueue(Event* ne)
-{
-	Event* prev = NULL;
-	Event** pNext = &first;
-	for(;;)
-	{
-		Event*& next = *pNext;
-		if(!next || ne->time < next->time)
-		{
-			ne->next = next;
-			next = ne;
-			break;
-		}
-		prev = next;
-		pNext = &prev->next;
-	}
+	eventHeap.clear();
 }
 
 // This must be run ONLY from within the cpu thread
@@ -306,53 +386,36 @@ void AddEventToQueue(Event* ne)
 // than Advance
 void ScheduleEvent(s64 cyclesIntoFuture, int event_type, u64 userdata)
 {
-	Event *ne = GetNewEvent();
-	ne->userdata = userdata;
-	ne->type = event_type;
-	ne->time = GetTicks() + cyclesIntoFuture;
-	AddEventToQueue(ne);
+	PushEvent(GetTicks() + cyclesIntoFuture, event_type, userdata);
 }
 
 // Returns cycles left in timer.
 s64 UnscheduleEvent(int event_type, u64 userdata)
 {
 	s64 result = 0;
-	if (!first)
-		return result;
-	while(first)
+	bool removed = false;
+	// Track the latest-firing match, which is what the old sorted list returned.
+	HeapEvent latest = {};
+	size_t i = 0;
+	while (i < eventHeap.size())
 	{
-		if (first->type == event_type && first->userdata == userdata)
+		if (eventHeap[i].type == event_type && eventHeap[i].userdata == userdata)
 		{
-			result = first->time - GetTicks();
-
-			Event *next = first->next;
-			FreeEvent(first);
-			first = next;
+			if (!removed || EventBefore(latest, eventHeap[i]))
+				latest = eventHeap[i];
+			removed = true;
+			eventHeap[i] = eventHeap.back();
+			eventHeap.pop_back();
 		}
 		else
 		{
-			break;
+			++i;
 		}
 	}
-	if (!first)
-		return result;
-	Event *prev = first;
-	Event *ptr = prev->next;
-	while (ptr)
+	if (removed)
 	{
-		if (ptr->type == event_type && ptr->userdata == userdata)
-		{
-			result = ptr->time - GetTicks();
-
-			prev->next = ptr->next;
-			FreeEvent(ptr);
-			ptr = prev->next;
-		}
-		else
-		{
-			prev = ptr;
-			ptr = ptr->next;
-		}
+		Heapify();
+		result = latest.time - GetTicks();
 	}
 
 	return result;
@@ -415,52 +478,33 @@ void RegisterMHzChangeCallback(MHzChangeCallback callback) {
 
 bool IsScheduled(int event_type)
 {
-	if (!first)
-		return false;
-	Event *e = first;
-	while (e) {
-		if (e->type == event_type)
+	for (size_t i = 0; i < eventHeap.size(); ++i)
+	{
+		if (eventHeap[i].type == event_type)
 			return true;
-		e = e->next;
 	}
 	return false;
 }
 
 void RemoveEvent(int event_type)
 {
-	if (!first)
-		return;
-	while(first)
-	{
-		if (first->type == event_type)
-		{
-			Event *next = first->next;
-			FreeEvent(first);
-			first = next;
-		}
-		else
-		{
-			break;
-		}
-	}
-	if (!first)
-		return;
-	Event *prev = first;
-	Event *ptr = prev->next;
-	while (ptr)
+	bool removed = false;
+	size_t i = 0;
+	while (i < eventHeap.size())
 	{
-		if (ptr->type == event_type)
+		if (eventHeap[i].type == event_type)
 		{
-			prev->next = ptr->next;
-			FreeEvent(ptr);
-			ptr = prev->next;
+			eventHeap[i] = eventHeap.back();
+			eventHeap.pop_back();
+			removed = true;
 		}
 		else
 		{
-			prev = ptr;
-			ptr = ptr->next;
+			++i;
 		}
 	}
+	if (removed)
+		Heapify();
 }
 
 void RemoveThreadsafeEvent(int event_type)
@@ -517,16 +561,15 @@ void RemoveAllEvents(int event_type)
 //This raise only the events required while the fifo is processing data
 void ProcessFifoWaitEvents()
 {
-	while (first)
+	while (!eventHeap.empty())
 	{
-		if (first->time <= (s64)GetTicks())
+		if (eventHeap[0].time <= (s64)GetTicks())
 		{
 //			LOG(CPU, "[Scheduler] %s		 (%lld, %lld) ",
 //				first->name ? first->name : "?", (u64)GetTicks(), (u64)first->time);
-			Event* evt = first;
-			first = first->next;
-			event_types[evt->type].callback(evt->userdata, (int)(GetTicks() - evt->time));
-			FreeEvent(evt);
+			HeapEvent evt = eventHeap[0];
+			PopEvent();
+			event_types[evt.type].callback(evt.userdata, (int)(GetTicks() - evt.time));
 		}
 		else
 		{
@@ -544,20 +587,11 @@ void MoveEvents()
 	while (tsFirst)
 	{
 		Event *next = tsFirst->next;
-		AddEventToQueue(tsFirst);
+		PushEvent(tsFirst->time, tsFirst->type, tsFirst->userdata);
+		FreeTsEvent(tsFirst);
 		tsFirst = next;
 	}
 	tsLast = NULL;
-
-	// Move free events to threadsafe pool
-	while(allocatedTsEvents > 0 && eventPool)
-	{
-		Event *ev = eventPool;
-		eventPool = ev->next;
-		ev->next = eventTsPool;
-		eventTsPool = ev;
-		allocatedTsEvents--;
-	}
 }
 
 void ForceCheck()
@@ -581,11 +615,17 @@ void Advance()
 	globalTimer += cyclesExecuted;
 	currentMIPS->downcount = slicelength;
 
+	// Keep the time base fresh so the GetGlobalTimeUs fast path stays exact.
+	RebaseGlobalTime();
+
+	if (MIPSSampleProfiler::IsEnabled())
+		MIPSSampleProfiler::HitSample(currentMIPS->pc, cyclesExecuted);
+
 	if (Common::AtomicLoadAcquire(hasTsEvents))
 		MoveEvents();
 	ProcessFifoWaitEvents();
 
-	if (!first)
+	if (eventHeap.empty())
 	{
 		// This should never happen in PPSSPP.
 		// WARN_LOG_REPORT(TIME, "WARNING - no events in queue. Setting currentMIPS->downcount to 10000");
@@ -597,7 +637,7 @@ void Advance()
 	else
 	{
 		// Note that events can eat cycles as well.
-		int target = (int)(first->time - globalTimer);
+		int target = (int)(eventHeap[0].time - globalTimer);
 		if (target > MAX_SLICE_LENGTH)
 			target = MAX_SLICE_LENGTH;
 
@@ -609,11 +649,9 @@ void Advance()
 
 void LogPendingEvents()
 {
-	Event *ptr = first;
-	while (ptr)
+	for (size_t i = 0; i < eventHeap.size(); ++i)
 	{
-		//INFO_LOG(CPU, "PENDING: Now: %lld Pending: %lld Type: %d", globalTimer, ptr->time, ptr->type);
-		ptr = ptr->next;
+		//INFO_LOG(CPU, "PENDING: Now: %lld Pending: %lld Type: %d", globalTimer, eventHeap[i].time, eventHeap[i].type);
 	}
 }
 
@@ -623,10 +661,10 @@ void Idle(int maxIdle)
 	if (maxIdle != 0 && cyclesDown > maxIdle)
 		cyclesDown = maxIdle;
 
-	if (first && cyclesDown > 0)
+	if (!eventHeap.empty() && cyclesDown > 0)
 	{
 		int cyclesExecuted = slicelength - currentMIPS->downcount;
-		int cyclesNextEvent = (int) (first->time - globalTimer);
+		int cyclesNextEvent = (int) (eventHeap[0].time - globalTimer);
 
 		if (cyclesNextEvent < cyclesExecuted + cyclesDown)
 		{
@@ -647,21 +685,21 @@ void Idle(int maxIdle)
 
 std::string GetScheduledEventsSummary()
 {
-	Event *ptr = first;
 	std::string text = "Scheduled events\n";
 	text.reserve(1000);
-	while (ptr)
+	std::vector<HeapEvent> sorted = eventHeap;
+	std::sort(sorted.begin(), sorted.end(), EventBefore);
+	for (size_t i = 0; i < sorted.size(); ++i)
 	{
-		unsigned int t = ptr->type;
+		unsigned int t = sorted[i].type;
 		if (t >= event_types.size())
 			PanicAlert("Invalid event type"); // %i", t);
-		const char *name = event_types[ptr->type].name;
+		const char *name = event_types[t].name;
 		if (!name)
 			name = "[unknown]";
 		char temp[512];
-		sprintf(temp, "%s : %i %08x%08x\n", name, (int)ptr->time, (u32)(ptr->userdata >> 32), (u32)(ptr->userdata));
+		sprintf(temp, "%s : %i %08x%08x\n", name, (int)sorted[i].time, (u32)(sorted[i].userdata >> 32), (u32)(sorted[i].userdata));
 		text += temp;
-		ptr = ptr->next;
 	}
 	return text;
 }
@@ -679,6 +717,48 @@ void Event_DoStateOld(PointerWrap &p, BaseEvent *ev)
 	p.Do(*ev);
 }
 
+// The main queue used to be a sorted linked list serialized with DoLinkedList -
+// produce and consume exactly that format, in firing order.
+template <void (*TDo)(PointerWrap &, BaseEvent *)>
+static void DoEventHeap(PointerWrap &p)
+{
+	if (p.mode == p.MODE_READ)
+	{
+		eventHeap.clear();
+		for (;;)
+		{
+			u8 shouldExist = 0;
+			p.Do(shouldExist);
+			if (shouldExist != 1)
+			{
+				if (shouldExist != 0)
+				{
+					WARN_LOG(SAVESTATE, "Savestate failure: incorrect item marker %d", shouldExist);
+					p.SetError(p.ERROR_FAILURE);
+				}
+				break;
+			}
+			BaseEvent ev = {};
+			TDo(p, &ev);
+			PushEvent(ev.time, ev.type, ev.userdata);
+		}
+	}
+	else
+	{
+		std::vector<HeapEvent> sorted = eventHeap;
+		std::sort(sorted.begin(), sorted.end(), EventBefore);
+		u8 one = 1;
+		u8 zero = 0;
+		for (size_t i = 0; i < sorted.size(); ++i)
+		{
+			p.Do(one);
+			BaseEvent ev = { sorted[i].time, sorted[i].userdata, sorted[i].type };
+			TDo(p, &ev);
+		}
+		p.Do(zero);
+	}
+}
+
 void DoState(PointerWrap &p)
 {
 	std::lock_guard<std::mutex> lk(externalEventLock);
@@ -693,10 +773,10 @@ void DoState(PointerWrap &p)
 	event_types.resize(n, EventType(AntiCrashCallback, "INVALID EVENT"));
 
 	if (s >= 3) {
-		p.DoLinkedList<BaseEvent, GetNewEvent, FreeEvent, Event_DoState>(first, (Event **) NULL);
+		DoEventHeap<Event_DoState>(p);
 		p.DoLinkedList<BaseEvent, GetNewTsEvent, FreeTsEvent, Event_DoState>(tsFirst, &tsLast);
 	} else {
-		p.DoLinkedList<BaseEvent, GetNewEvent, FreeEvent, Event_DoStateOld>(first, (Event **) NULL);
+		DoEventHeap<Event_DoStateOld>(p);
 		p.DoLinkedList<BaseEvent, GetNewTsEvent, FreeTsEvent, Event_DoStateOld>(tsFirst, &tsLast);
 	}
 
@@ -713,6 +793,7 @@ void DoState(PointerWrap &p)
 		lastGlobalTimeUs = 0;
 	}
 
+	RecalcUsPerTickRecip();
 	FireMhzChange();
 }
 
@@ -353,6 +353,13 @@ void CWCheatEngine::ParseCheats() {
 	// TODO: Report errors.
 
 	cheats_ = parser.GetCheats();
+
+	// Throw out the old decoded ops, the lines may have changed.
+	decodedCheats_.clear();
+	decodedCheats_.resize(cheats_.size());
+	for (size_t i = 0; i < cheats_.size(); i++) {
+		decodedCheats_[i].resize(cheats_[i].lines.size());
+	}
 }
 
 u32 CWCheatEngine::GetAddress(u32 value) {
@@ -398,71 +405,6 @@ void CWCheatEngine::InvalidateICache(u32 addr, int size) {
 	currentMIPS->InvalidateICache(addr & ~3, size);
 }
 
-enum class CheatOp {
-	Invalid,
-	Noop,
-
-	Write,
-	Add,
-	Subtract,
-	Or,
-	And,
-	Xor,
-
-	MultiWrite,
-
-	CopyBytesFrom,
-	Delay,
-
-	Assert,
-
-	IfEqual,
-	IfNotEqual,
-	IfLess,
-	IfGreater,
-
-	IfAddrEqual,
-	IfAddrNotEqual,
-	IfAddrLess,
-	IfAddrGreater,
-
-	IfPressed,
-	IfNotPressed,
-
-	CwCheatPointerCommands,
-};
-
-struct CheatOperation {
-	CheatOp op;
-	uint32_t addr;
-	int sz;
-	uint32_t val;
-
-	union {
-		struct {
-			uint32_t count;
-			uint32_t step;
-			uint32_t add;
-		} multiWrite;
-		struct {
-			uint32_t destAddr;
-		} copyBytesFrom;
-		struct {
-			uint32_t skip;
-		} ifTypes;
-		struct {
-			uint32_t skip;
-			uint32_t compareAddr;
-		} ifAddrTypes;
-		struct {
-			int offset;
-			int baseOffset;
-			int count;
-			int type;
-		} pointerCommands;
-	};
-};
-
 CheatOperation CWCheatEngine::InterpretNextCwCheat(const CheatCode &cheat, size_t &i) {
 	const CheatLine &line1 = cheat.lines[i++];
 	const uint32_t &arg = line1.part2;
@@ -1052,10 +994,22 @@ void CWCheatEngine::ExecuteOp(const CheatOperation &op, const CheatCode &cheat,
 }
 
 void CWCheatEngine::Run() {
-	for (CheatCode cheat : cheats_) {
+	for (size_t c = 0; c < cheats_.size(); c++) {
+		const CheatCode &cheat = cheats_[c];
+		auto &decoded = decodedCheats_[c];
 		// InterpretNextOp and ExecuteOp move i.
 		for (size_t i = 0; i < cheat.lines.size(); ) {
-			CheatOperation op = InterpretNextOp(cheat, i);
+			size_t start = i;
+			CheatOperation op;
+			if (decoded[start].valid) {
+				op = decoded[start].op;
+				i = decoded[start].next;
+			} else {
+				op = InterpretNextOp(cheat, i);
+				decoded[start].op = op;
+				decoded[start].next = i;
+				decoded[start].valid = true;
+			}
 			ExecuteOp(op, cheat, i);
 		}
 	}
@@ -34,7 +34,70 @@ struct CheatCode {
 	std::vector<CheatLine> lines;
 };
 
-struct CheatOperation;
+enum class CheatOp {
+	Invalid,
+	Noop,
+
+	Write,
+	Add,
+	Subtract,
+	Or,
+	And,
+	Xor,
+
+	MultiWrite,
+
+	CopyBytesFrom,
+	Delay,
+
+	Assert,
+
+	IfEqual,
+	IfNotEqual,
+	IfLess,
+	IfGreater,
+
+	IfAddrEqual,
+	IfAddrNotEqual,
+	IfAddrLess,
+	IfAddrGreater,
+
+	IfPressed,
+	IfNotPressed,
+
+	CwCheatPointerCommands,
+};
+
+struct CheatOperation {
+	CheatOp op;
+	uint32_t addr;
+	int sz;
+	uint32_t val;
+
+	union {
+		struct {
+			uint32_t count;
+			uint32_t step;
+			uint32_t add;
+		} multiWrite;
+		struct {
+			uint32_t destAddr;
+		} copyBytesFrom;
+		struct {
+			uint32_t skip;
+		} ifTypes;
+		struct {
+			uint32_t skip;
+			uint32_t compareAddr;
+		} ifAddrTypes;
+		struct {
+			int offset;
+			int baseOffset;
+			int count;
+			int type;
+		} pointerCommands;
+	};
+};
 
 class CWCheatEngine {
 public:
@@ -59,4 +122,15 @@ private:
 	bool TestIfAddr(const CheatOperation &op, bool(*oper)(int a, int b));
 
 	std::vector<CheatCode> cheats_;
+
+	// Decoding a line is a pure function of the line data, so it's done once
+	// the first time a line executes and memoized here. Indexed in parallel
+	// with cheats_, one slot per line (conditionals can jump into the middle
+	// of multi-line ops, so this is keyed by start line rather than op index).
+	struct DecodedOp {
+		bool valid = false;
+		size_t next = 0;
+		CheatOperation op;
+	};
+	std::vector<std::vector<DecodedOp>> decodedCheats_;
 };
@@ -54,7 +54,9 @@
 #include "Core/Debugger/WebSocket/GameSubscriber.h"
 #include "Core/Debugger/WebSocket/GPUBufferSubscriber.h"
 #include "Core/Debugger/WebSocket/GPURecordSubscriber.h"
+#include "Core/Debugger/WebSocket/GPUStateSubscriber.h"
 #include "Core/Debugger/WebSocket/HLESubscriber.h"
+#include "Core/Debugger/WebSocket/MemorySubscriber.h"
 #include "Core/Debugger/WebSocket/SteppingSubscriber.h"
 
 typedef DebuggerSubscriber *(*SubscriberInit)(DebuggerEventHandlerMap &map);
@@ -65,7 +67,9 @@ static const std::vector<SubscriberInit> subscribers({
 	&WebSocketGameInit,
 	&WebSocketGPUBufferInit,
 	&WebSocketGPURecordInit,
+	&WebSocketGPUStateInit,
 	&WebSocketHLEInit,
+	&WebSocketMemoryInit,
 	&WebSocketSteppingInit,
 });
 
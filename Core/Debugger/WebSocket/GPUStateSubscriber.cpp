@@ -0,0 +1,93 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#include "Core/Debugger/WebSocket/GPUStateSubscriber.h"
+#include "Core/Debugger/WebSocket/WebSocketUtils.h"
+#include "GPU/Debugger/GeSnapshot.h"
+
+DebuggerSubscriber *WebSocketGPUStateInit(DebuggerEventHandlerMap &map) {
+	map["gpu.sampling.enable"] = &WebSocketGPUSamplingEnable;
+	map["gpu.sampling.get"] = &WebSocketGPUSamplingGet;
+
+	return nullptr;
+}
+
+// Toggle pause-free GE state sampling (gpu.sampling.enable)
+//
+// Parameters:
+//  - enable: boolean, true to start sampling at flush boundaries.
+//
+// Response (same event name):
+//  - enabled: boolean, the new state.
+//
+// Unlike the stepping debugger, sampling never pauses the GE - it just
+// records snapshots the gpu.sampling.get event can read back.
+void WebSocketGPUSamplingEnable(DebuggerRequest &req) {
+	bool enable;
+	if (!req.ParamBool("enable", &enable))
+		return;
+
+	GeSnapshot::SetEnabled(enable);
+
+	JsonWriter &json = req.Respond();
+	json.writeBool("enabled", GeSnapshot::IsEnabled());
+}
+
+// Get the most recent GE state snapshot (gpu.sampling.get)
+//
+// No parameters.
+//
+// Response (same event name):
+//  - snapshot: null if nothing captured yet, or an object with properties:
+//     - time: number, host time of the capture.
+//     - list: null if no list was active, or an object with properties:
+//        - id: number display list ID.
+//        - state: number display list state.
+//        - startpc: number address the list started at.
+//        - pc: number address the list had reached.
+//        - stall: number stall address.
+//     - cmdmem: array of 256 numbers, the raw GE command state.
+void WebSocketGPUSamplingGet(DebuggerRequest &req) {
+	GeSnapshot::Snapshot snap;
+	const bool hasSnapshot = GeSnapshot::GetLatest(&snap);
+
+	JsonWriter &json = req.Respond();
+	if (!hasSnapshot) {
+		json.writeNull("snapshot");
+		return;
+	}
+
+	json.pushDict("snapshot");
+	json.writeFloat("time", snap.time);
+	if (snap.listID >= 0) {
+		json.pushDict("list");
+		json.writeInt("id", snap.listID);
+		json.writeInt("state", snap.listState);
+		json.writeUint("startpc", snap.listStartPC);
+		json.writeUint("pc", snap.listPC);
+		json.writeUint("stall", snap.listStall);
+		json.pop();
+	} else {
+		json.writeNull("list");
+	}
+	json.pushArray("cmdmem");
+	for (size_t i = 0; i < ARRAY_SIZE(snap.cmdmem); ++i) {
+		json.writeUint(snap.cmdmem[i]);
+	}
+	json.pop();
+	json.pop();
+}
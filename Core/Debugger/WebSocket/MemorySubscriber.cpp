@@ -0,0 +1,230 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#include <cstring>
+#include <snappy-c.h>
+#include <vector>
+
+#include "base/timeutil.h"
+#include "ext/xxhash.h"
+#include "Core/Debugger/WebSocket/MemorySubscriber.h"
+#include "Core/Debugger/WebSocket/WebSocketUtils.h"
+#include "Core/MemMap.h"
+#include "Core/System.h"
+
+struct WebSocketMemoryState : public DebuggerSubscriber {
+	void Read(DebuggerRequest &req);
+	void WatchAdd(DebuggerRequest &req);
+	void WatchRemove(DebuggerRequest &req);
+	void WatchList(DebuggerRequest &req);
+
+	void Broadcast(net::WebSocketServer *ws) override;
+
+protected:
+	struct WatchRegion {
+		int id;
+		u32 address;
+		u32 size;
+		u32 hash;
+	};
+
+	std::vector<WatchRegion> watches_;
+	int nextWatchId_ = 1;
+	double lastWatchCheck_ = 0.0;
+};
+
+DebuggerSubscriber *WebSocketMemoryInit(DebuggerEventHandlerMap &map) {
+	auto p = new WebSocketMemoryState();
+	map["memory.read"] = std::bind(&WebSocketMemoryState::Read, p, std::placeholders::_1);
+	map["memory.watch.add"] = std::bind(&WebSocketMemoryState::WatchAdd, p, std::placeholders::_1);
+	map["memory.watch.remove"] = std::bind(&WebSocketMemoryState::WatchRemove, p, std::placeholders::_1);
+	map["memory.watch.list"] = std::bind(&WebSocketMemoryState::WatchList, p, std::placeholders::_1);
+
+	return p;
+}
+
+// Read a block of memory (memory.read)
+//
+// Parameters:
+//  - address: number, the start address.
+//  - size: number of bytes to read.
+//  - compress: optional boolean, default false. When true, the payload is
+//    snappy compressed (see ext/snappy.)
+//
+// Response (same event name):
+//  - address: echoed back.
+//  - size: uncompressed byte count.
+//  - compressed: whether the payload is snappy compressed.
+//  - payloadSize: byte count of the binary frame that follows.
+//
+// The bytes themselves arrive in a single binary websocket frame sent
+// immediately after this response - frames are ordered on the socket, so the
+// next binary frame after the response is the payload. This avoids the JSON
+// and base64 overhead that makes large dumps crawl.
+void WebSocketMemoryState::Read(DebuggerRequest &req) {
+	if (!PSP_IsInited())
+		return req.Fail("CPU not started");
+
+	u32 address, size;
+	if (!req.ParamU32("address", &address))
+		return;
+	if (!req.ParamU32("size", &size))
+		return;
+	bool compress = false;
+	if (!req.ParamBool("compress", &compress, DebuggerParamType::OPTIONAL))
+		return;
+
+	if (size == 0)
+		return req.Fail("Parameter 'size' must not be 0");
+	if (!Memory::IsValidRange(address, size))
+		return req.Fail("Range outside valid memory");
+
+	const u8 *p = Memory::GetPointer(address);
+	std::vector<uint8_t> payload;
+	if (compress) {
+		size_t compressedSize = snappy_max_compressed_length(size);
+		payload.resize(compressedSize);
+		snappy_compress((const char *)p, size, (char *)payload.data(), &compressedSize);
+		payload.resize(compressedSize);
+	} else {
+		payload.assign(p, p + size);
+	}
+
+	JsonWriter &json = req.Respond();
+	json.writeUint("address", address);
+	json.writeUint("size", size);
+	json.writeBool("compressed", compress);
+	json.writeUint("payloadSize", (uint32_t)payload.size());
+	// Send the response now so the binary frame follows it on the wire.
+	req.Finish();
+
+	req.ws->Send(payload);
+}
+
+// Watch a memory region for changes (memory.watch.add)
+//
+// Parameters:
+//  - address: number, the start address.
+//  - size: number of bytes to watch (max 1 MB per region.)
+//
+// Response (same event name):
+//  - id: number identifying this watch, for memory.watch.remove.
+//
+// While the watch is active, a "memory.watch.change" event is sent whenever
+// the region's contents change, with id, address, size and the new hash.
+// There's no write-watch hook in the memory map, so changes are detected by
+// rehashing the region a few times a second - that's why regions are capped,
+// and why back-to-back writes may coalesce into one event.
+void WebSocketMemoryState::WatchAdd(DebuggerRequest &req) {
+	static const u32 WATCH_MAX_SIZE = 1024 * 1024;
+	static const size_t WATCH_MAX_COUNT = 32;
+
+	if (!PSP_IsInited())
+		return req.Fail("CPU not started");
+
+	u32 address, size;
+	if (!req.ParamU32("address", &address))
+		return;
+	if (!req.ParamU32("size", &size))
+		return;
+
+	if (size == 0 || size > WATCH_MAX_SIZE)
+		return req.Fail("Parameter 'size' must be between 1 and 1048576");
+	if (!Memory::IsValidRange(address, size))
+		return req.Fail("Range outside valid memory");
+	if (watches_.size() >= WATCH_MAX_COUNT)
+		return req.Fail("Too many watches active");
+
+	WatchRegion watch;
+	watch.id = nextWatchId_++;
+	watch.address = address;
+	watch.size = size;
+	watch.hash = XXH32(Memory::GetPointer(address), size, 0);
+	watches_.push_back(watch);
+
+	JsonWriter &json = req.Respond();
+	json.writeInt("id", watch.id);
+}
+
+// Stop watching a memory region (memory.watch.remove)
+//
+// Parameters:
+//  - id: number from memory.watch.add.
+//
+// Response (same event name) with no extra data.
+void WebSocketMemoryState::WatchRemove(DebuggerRequest &req) {
+	u32 id;
+	if (!req.ParamU32("id", &id))
+		return;
+
+	for (size_t i = 0; i < watches_.size(); ++i) {
+		if (watches_[i].id == (int)id) {
+			watches_.erase(watches_.begin() + i);
+			req.Respond();
+			return;
+		}
+	}
+	req.Fail("Watch not found");
+}
+
+// List active memory watches (memory.watch.list)
+//
+// Response (same event name):
+//  - watches: array of objects with id, address and size.
+void WebSocketMemoryState::WatchList(DebuggerRequest &req) {
+	JsonWriter &json = req.Respond();
+	json.pushArray("watches");
+	for (const auto &watch : watches_) {
+		json.pushDict();
+		json.writeInt("id", watch.id);
+		json.writeUint("address", watch.address);
+		json.writeUint("size", watch.size);
+		json.pop();
+	}
+	json.pop();
+}
+
+void WebSocketMemoryState::Broadcast(net::WebSocketServer *ws) {
+	if (watches_.empty() || !PSP_IsInited())
+		return;
+
+	// The broadcast loop normally runs at 60 Hz - rehashing every tick would
+	// burn CPU for nothing, four checks a second is plenty for tooling.
+	double now = time_now_d();
+	if (now < lastWatchCheck_ + 0.25)
+		return;
+	lastWatchCheck_ = now;
+
+	for (auto &watch : watches_) {
+		if (!Memory::IsValidRange(watch.address, watch.size))
+			continue;
+		u32 hash = XXH32(Memory::GetPointer(watch.address), watch.size, 0);
+		if (hash == watch.hash)
+			continue;
+		watch.hash = hash;
+
+		JsonWriter json;
+		json.begin();
+		json.writeString("event", "memory.watch.change");
+		json.writeInt("id", watch.id);
+		json.writeUint("address", watch.address);
+		json.writeUint("size", watch.size);
+		json.writeUint("hash", hash);
+		json.end();
+		ws->Send(json.str());
+	}
+}
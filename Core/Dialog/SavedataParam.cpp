@@ -59,6 +59,13 @@ namespace
 		truncate_cpy(str, strLength, value.c_str());
 	}
 
+	// Can't just memcmp, tm may have padding.
+	bool SameSFOTime(const tm &a, const tm &b)
+	{
+		return a.tm_year == b.tm_year && a.tm_mon == b.tm_mon && a.tm_mday == b.tm_mday
+			&& a.tm_hour == b.tm_hour && a.tm_min == b.tm_min && a.tm_sec == b.tm_sec;
+	}
+
 	bool ReadPSPFile(std::string filename, u8 **data, s64 dataSize, s64 *readSize)
 	{
 		u32 handle = pspFileSystem.OpenFile(filename, FILEACCESS_READ);
@@ -1521,6 +1528,14 @@ void SavedataParam::SetFileInfo(SaveFileInfo &saveInfo, PSPFileInfo &info, std::
 	info2 = pspFileSystem.GetFileInfo(fileDataPath2);
 	if (info2.exists)
 	{
+		auto cached = sfoCache_.find(fileDataPath2);
+		if (cached != sfoCache_.end() && cached->second.size == info2.size && SameSFOTime(cached->second.mtime, info2.mtime)) {
+			memcpy(saveInfo.title, cached->second.title, sizeof(saveInfo.title));
+			memcpy(saveInfo.saveTitle, cached->second.saveTitle, sizeof(saveInfo.saveTitle));
+			memcpy(saveInfo.saveDetail, cached->second.saveDetail, sizeof(saveInfo.saveDetail));
+			return;
+		}
+
 		std::vector<u8> sfoData;
 		pspFileSystem.ReadEntireFile(fileDataPath2, sfoData);
 		ParamSFOData sfoFile;
@@ -1529,6 +1544,15 @@ void SavedataParam::SetFileInfo(SaveFileInfo &saveInfo, PSPFileInfo &info, std::
 			SetStringFromSFO(sfoFile, "TITLE", saveInfo.title, sizeof(saveInfo.title));
 			SetStringFromSFO(sfoFile, "SAVEDATA_TITLE", saveInfo.saveTitle, sizeof(saveInfo.saveTitle));
 			SetStringFromSFO(sfoFile, "SAVEDATA_DETAIL", saveInfo.saveDetail, sizeof(saveInfo.saveDetail));
+
+			// Keep the parsed fields for the next dialog open. The mtime check
+			// above catches new saves written to the same directory.
+			CachedSFO &entry = sfoCache_[fileDataPath2];
+			entry.mtime = info2.mtime;
+			entry.size = info2.size;
+			memcpy(entry.title, saveInfo.title, sizeof(entry.title));
+			memcpy(entry.saveTitle, saveInfo.saveTitle, sizeof(entry.saveTitle));
+			memcpy(entry.saveDetail, saveInfo.saveDetail, sizeof(entry.saveDetail));
 		}
 	}
 }
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <map>
+
 #include "Common/CommonTypes.h"
 #include "Core/MemMap.h"
 #include "Core/HLE/sceRtc.h"
@@ -382,4 +384,16 @@ private:
 	SaveFileInfo *noSaveIcon;
 	int saveDataListCount;
 	int saveNameListDataCount;
+
+	// Display fields parsed out of each save's PARAM.SFO, kept between dialog
+	// opens since list mode re-scans every save directory. Keyed by SFO path,
+	// revalidated against the file's mtime and size.
+	struct CachedSFO {
+		tm mtime;
+		s64 size;
+		char title[128];
+		char saveTitle[128];
+		char saveDetail[1024];
+	};
+	std::map<std::string, CachedSFO> sfoCache_;
 };
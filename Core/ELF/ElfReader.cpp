@@ -15,6 +15,8 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include <vector>
+
 #include "Core/MemMap.h"
 #include "Core/Reporting.h"
 #include "Core/MIPS/MIPSTables.h"
@@ -57,6 +59,21 @@ bool ElfReader::LoadRelocations(const Elf32_Rel *rels, int numRelocs)
 {
 	int numErrors = 0;
 	DEBUG_LOG(LOADER, "Loading %i relocations...", numRelocs);
+
+	// Precompute the next R_MIPS_LO16 after each entry. Each R_MIPS_HI16 has
+	// to read the immediate of its matching LO16 before that one is relocated,
+	// and scanning forward for it per HI16 made big tables quadratic - the
+	// multi-MB PRX overlays some games load at level transitions spent most of
+	// their relocation time in that scan.
+	std::vector<int> nextLo16(numRelocs);
+	int lastLo16 = -1;
+	for (int r = numRelocs - 1; r >= 0; r--)
+	{
+		nextLo16[r] = lastLo16;
+		if ((rels[r].r_info & 0xF) == R_MIPS_LO16)
+			lastLo16 = r;
+	}
+
 	for (int r = 0; r < numRelocs; r++)
 	{
 		// INFO_LOG(LOADER, "Loading reloc %i  (%p)...", r, rels + r);
@@ -127,24 +144,21 @@ bool ElfReader::LoadRelocations(const Elf32_Rel *rels, int numRelocs)
 				u32 cur = (op & 0xFFFF) << 16;
 				u16 hi = 0;
 				bool found = false;
-				for (int t = r + 1; t<numRelocs; t++)
+				for (int t = nextLo16[r]; t != -1; t = nextLo16[t])
 				{
-					if ((rels[t].r_info & 0xF) == R_MIPS_LO16) 
-					{
-						u32 corrLoAddr = rels[t].r_offset + segmentVAddr[readwrite];
-						if (log) {
-							DEBUG_LOG(LOADER,"Corresponding lo found at %08x", corrLoAddr);
-						}
-						if (Memory::IsValidAddress(corrLoAddr)) {
-							s16 lo = (s32)(s16)(u16)(Memory::ReadUnchecked_U32(corrLoAddr) & 0xFFFF); //signed??
-							cur += lo;
-							cur += relocateTo;
-							addrToHiLo(cur, hi, lo);
-							found = true;
-							break;
-						} else {
-							ERROR_LOG(LOADER, "Bad corrLoAddr %08x", corrLoAddr);
-						}
+					u32 corrLoAddr = rels[t].r_offset + segmentVAddr[readwrite];
+					if (log) {
+						DEBUG_LOG(LOADER,"Corresponding lo found at %08x", corrLoAddr);
+					}
+					if (Memory::IsValidAddress(corrLoAddr)) {
+						s16 lo = (s32)(s16)(u16)(Memory::ReadUnchecked_U32(corrLoAddr) & 0xFFFF); //signed??
+						cur += lo;
+						cur += relocateTo;
+						addrToHiLo(cur, hi, lo);
+						found = true;
+						break;
+					} else {
+						ERROR_LOG(LOADER, "Bad corrLoAddr %08x", corrLoAddr);
 					}
 				}
 				if (!found) {
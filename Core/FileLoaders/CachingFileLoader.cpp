@@ -93,6 +93,17 @@ size_t CachingFileLoader::ReadAt(s64 absolutePos, size_t bytes, void *data, Flag
 			}
 		}
 
+		// Games usually stream sequentially (FMVs, audio) - while the pattern
+		// holds, grow the read-ahead window so completions stop waiting on the
+		// backend, and shrink it back on a seek.  Short forward skips within
+		// the window still count as sequential, that covers strided access.
+		if (absolutePos >= lastReadEnd_ && absolutePos < lastReadEnd_ + ((s64)readAheadBlocks_ << BLOCK_SHIFT)) {
+			readAheadBlocks_ = std::min(readAheadBlocks_ * 2, (u32)BLOCK_READAHEAD_MAX);
+		} else {
+			readAheadBlocks_ = BLOCK_READAHEAD;
+		}
+		lastReadEnd_ = absolutePos + readSize;
+
 		StartReadAhead(absolutePos + readSize);
 	}
 
@@ -256,24 +267,25 @@ void CachingFileLoader::StartReadAhead(s64 pos) {
 		// Already going.
 		return;
 	}
-	if (cacheSize_ + BLOCK_READAHEAD > MAX_BLOCKS_CACHED) {
+	const u32 aheadBlocks = readAheadBlocks_;
+	if (cacheSize_ + aheadBlocks > MAX_BLOCKS_CACHED) {
 		// Not enough space to readahead.
 		return;
 	}
 
 	aheadThread_ = true;
-	std::thread th([this, pos] {
+	std::thread th([this, pos, aheadBlocks] {
 		setCurrentThreadName("FileLoaderReadAhead");
 
 		std::unique_lock<std::recursive_mutex> guard(blocksMutex_);
 		s64 cacheStartPos = pos >> BLOCK_SHIFT;
-		s64 cacheEndPos = cacheStartPos + BLOCK_READAHEAD - 1;
+		s64 cacheEndPos = cacheStartPos + aheadBlocks - 1;
 
 		for (s64 i = cacheStartPos; i <= cacheEndPos; ++i) {
 			auto block = blocks_.find(i);
 			if (block == blocks_.end()) {
 				guard.unlock();
-				SaveIntoCache(i << BLOCK_SHIFT, BLOCK_SIZE * BLOCK_READAHEAD, Flags::NONE, true);
+				SaveIntoCache(i << BLOCK_SHIFT, (size_t)BLOCK_SIZE * aheadBlocks, Flags::NONE, true);
 				break;
 			}
 		}
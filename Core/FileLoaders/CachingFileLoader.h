@@ -54,6 +54,8 @@ private:
 		MAX_BLOCKS_PER_READ = 16,
 		MAX_BLOCKS_CACHED = 4096, // 256 MB
 		BLOCK_READAHEAD = 4,
+		// Grown up to this while reads stay sequential, see ReadAt().
+		BLOCK_READAHEAD_MAX = MAX_BLOCKS_PER_READ,
 	};
 
 	s64 filesize_ = 0;
@@ -76,5 +78,7 @@ private:
 	std::map<s64, BlockInfo> blocks_;
 	std::recursive_mutex blocksMutex_;
 	bool aheadThread_ = false;
+	s64 lastReadEnd_ = 0;
+	u32 readAheadBlocks_ = BLOCK_READAHEAD;
 	std::once_flag preparedFlag_;
 };
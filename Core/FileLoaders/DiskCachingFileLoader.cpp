@@ -23,6 +23,7 @@
 
 #include "file/file_util.h"
 #include "file/free.h"
+#include "thread/threadutil.h"
 #include "util/text/utf8.h"
 #include "Common/FileUtil.h"
 #include "Common/CommonWindows.h"
@@ -180,9 +181,15 @@ void DiskCachingFileLoaderCache::InitCache(const std::string &path) {
 			CloseFileHandle();
 		}
 	}
+
+	if (f_) {
+		StartWriteBackThread();
+	}
 }
 
 void DiskCachingFileLoaderCache::ShutdownCache() {
+	StopWriteBackThread();
+
 	if (f_) {
 		bool failed = false;
 		if (fseek(f_, sizeof(FileHeader), SEEK_SET) != 0) {
@@ -280,8 +287,7 @@ size_t DiskCachingFileLoaderCache::SaveIntoCache(FileLoader *backend, s64 pos, s
 		// Check if it was written while we were busy.  Might happen if we thread.
 		if (info.block == INVALID_BLOCK && readBytes != 0) {
 			info.block = AllocateBlock((u32)cacheStartPos);
-			WriteBlockData(info, buf);
-			WriteIndexData((u32)cacheStartPos, info);
+			QueueBlockWrite((u32)cacheStartPos, info, buf);
 		}
 
 		size_t toRead = std::min(bytes - readSize, (size_t)blockSize_ - offset);
@@ -298,9 +304,7 @@ size_t DiskCachingFileLoaderCache::SaveIntoCache(FileLoader *backend, s64 pos, s
 			// Check if it was written while we were busy.  Might happen if we thread.
 			if (info.block == INVALID_BLOCK && readBytes != 0) {
 				info.block = AllocateBlock((u32)cacheStartPos + (u32)i);
-				WriteBlockData(info, wholeRead + (i * blockSize_));
-				// TODO: Doing each index together would probably be better.
-				WriteIndexData((u32)cacheStartPos + (u32)i, info);
+				QueueBlockWrite((u32)cacheStartPos + (u32)i, info, wholeRead + (i * blockSize_));
 			}
 
 			size_t toRead = std::min(bytes - readSize, (size_t)blockSize_ - offset);
@@ -341,6 +345,8 @@ bool DiskCachingFileLoaderCache::MakeCacheSpaceFor(size_t blocks) {
 
 			// 0 means it was never used yet or was the first read (e.g. block descriptor.)
 			if (info.generation == oldestGeneration_ || info.generation == 0) {
+				// If it hasn't even hit the disk yet, don't let it.
+				DropPendingWrite(info.block);
 				info.block = INVALID_BLOCK;
 				info.generation = 0;
 				info.hits = 0;
@@ -433,6 +439,15 @@ bool DiskCachingFileLoaderCache::ReadBlockData(u8 *dest, BlockInfo &info, size_t
 	if (!f_) {
 		return false;
 	}
+
+	// If the block hasn't been written back yet, serve it straight from memory.
+	for (const auto &w : pendingWrites_) {
+		if (w.info.block == info.block) {
+			memcpy(dest + offset, w.data, size);
+			return true;
+		}
+	}
+
 	s64 blockOffset = GetBlockOffset(info.block);
 
 	// Before we read, make sure the buffers are flushed.
@@ -508,6 +523,72 @@ void DiskCachingFileLoaderCache::WriteIndexData(u32 indexPos, BlockInfo &info) {
 	}
 }
 
+void DiskCachingFileLoaderCache::QueueBlockWrite(u32 indexPos, const BlockInfo &info, const u8 *src) {
+	PendingWrite w;
+	w.indexPos = indexPos;
+	w.info = info;
+	w.data = new u8[blockSize_];
+	memcpy(w.data, src, blockSize_);
+
+	// Already under lock_, our caller is SaveIntoCache.
+	pendingWrites_.push_back(w);
+	writeBackCond_.notify_one();
+}
+
+void DiskCachingFileLoaderCache::DropPendingWrite(u32 block) {
+	for (size_t i = 0; i < pendingWrites_.size(); ++i) {
+		if (pendingWrites_[i].info.block == block) {
+			delete [] pendingWrites_[i].data;
+			pendingWrites_.erase(pendingWrites_.begin() + i);
+			break;
+		}
+	}
+}
+
+void DiskCachingFileLoaderCache::StartWriteBackThread() {
+	writeBackExit_ = false;
+	writeBackRunning_ = true;
+	writeBackThread_ = std::thread([this] {
+		WriteBackThread();
+	});
+}
+
+void DiskCachingFileLoaderCache::StopWriteBackThread() {
+	if (!writeBackRunning_) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		writeBackExit_ = true;
+	}
+	writeBackCond_.notify_one();
+	writeBackThread_.join();
+	writeBackRunning_ = false;
+}
+
+void DiskCachingFileLoaderCache::WriteBackThread() {
+	setCurrentThreadName("DiskCacheWrite");
+	setCurrentThreadAffinityClass(THREAD_AFFINITY_EFFICIENCY);
+
+	std::unique_lock<std::mutex> guard(lock_);
+	while (!writeBackExit_ || !pendingWrites_.empty()) {
+		if (pendingWrites_.empty()) {
+			writeBackCond_.wait(guard);
+			continue;
+		}
+
+		// We hold the lock while writing, but each block is small - and any read
+		// of a still-pending block is served from memory, see ReadBlockData().
+		PendingWrite w = pendingWrites_.front();
+		WriteBlockData(w.info, w.data);
+		WriteIndexData(w.indexPos, w.info);
+
+		// Only now that it's on disk, drop it from the queue.
+		pendingWrites_.erase(pendingWrites_.begin());
+		delete [] w.data;
+	}
+}
+
 bool DiskCachingFileLoaderCache::LoadCacheFile(const std::string &path) {
 	FILE *fp = File::OpenCFile(path, "rb+");
 	if (!fp) {
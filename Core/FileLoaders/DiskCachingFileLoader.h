@@ -17,9 +17,11 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <vector>
 #include <map>
 #include <mutex>
+#include <thread>
 
 #include "Common/Common.h"
 #include "Common/Swap.h"
@@ -98,6 +100,12 @@ private:
 	void WriteIndexData(u32 indexPos, BlockInfo &info);
 	s64 GetBlockOffset(u32 block);
 
+	void QueueBlockWrite(u32 indexPos, const BlockInfo &info, const u8 *src);
+	void DropPendingWrite(u32 block);
+	void StartWriteBackThread();
+	void StopWriteBackThread();
+	void WriteBackThread();
+
 	std::string MakeCacheFilePath(const std::string &path);
 	std::string MakeCacheFilename(const std::string &path);
 	bool LoadCacheFile(const std::string &path);
@@ -173,6 +181,19 @@ private:
 	std::vector<BlockInfo> index_;
 	std::vector<u32> blockIndexLookup_;
 
+	// Blocks queued for write-back, so a cache miss doesn't pay for the disk
+	// write on the read path. Guarded by lock_, drained by writeBackThread_.
+	struct PendingWrite {
+		u32 indexPos;
+		BlockInfo info;
+		u8 *data;
+	};
+	std::vector<PendingWrite> pendingWrites_;
+	std::thread writeBackThread_;
+	std::condition_variable writeBackCond_;
+	bool writeBackRunning_ = false;
+	bool writeBackExit_ = false;
+
 	FILE *f_ = nullptr;
 	int fd_ = 0;
 
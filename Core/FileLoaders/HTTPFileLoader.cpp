@@ -25,6 +25,19 @@ HTTPFileLoader::HTTPFileLoader(const std::string &filename)
 	: url_(filename), filename_(filename) {
 }
 
+static bool ResponseRequestsClose(const std::vector<std::string> &responseHeaders) {
+	for (std::string header : responseHeaders) {
+		if (startsWithNoCase(header, "Connection:")) {
+			std::string lowerHeader = header;
+			std::transform(lowerHeader.begin(), lowerHeader.end(), lowerHeader.begin(), tolower);
+			if (lowerHeader.find("close") != lowerHeader.npos) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
 void HTTPFileLoader::Prepare() {
 	std::call_once(preparedFlag_, [this](){
 		if (!client_.Resolve(url_.Host().c_str(), url_.Port())) {
@@ -34,6 +47,8 @@ void HTTPFileLoader::Prepare() {
 		}
 
 		client_.SetDataTimeout(20.0);
+		// We expect to do many small range reads, so reuse the connection.
+		client_.SetKeepAlive(true);
 		Connect();
 		if (!connected_) {
 			ERROR_LOG(LOADER, "HTTP request failed, failed to connect: %s port %d", url_.Host().c_str(), url_.Port());
@@ -82,8 +97,11 @@ void HTTPFileLoader::Prepare() {
 			}
 		}
 
-		// TODO: Keepalive instead.
-		Disconnect();
+		// A HEAD response has no entity, so unless the server is closing on us,
+		// the connection is ready for the first range request as-is.
+		if (ResponseRequestsClose(responseHeaders)) {
+			Disconnect();
+		}
 
 		if (!acceptsRange) {
 			WARN_LOG(LOADER, "HTTP server did not advertise support for range requests.");
@@ -133,26 +151,40 @@ size_t HTTPFileLoader::ReadAt(s64 absolutePos, size_t bytes, void *data, Flags f
 		return 0;
 	}
 
-	Connect();
-	if (!connected_) {
-		return 0;
-	}
-
 	char requestHeaders[4096];
 	// Note that the Range header is *inclusive*.
 	snprintf(requestHeaders, sizeof(requestHeaders),
 		"Range: bytes=%lld-%lld\r\n", absolutePos, absoluteEnd - 1);
 
-	int err = client_.SendRequest("GET", url_.Resource().c_str(), requestHeaders, nullptr);
-	if (err < 0) {
+	Buffer readbuf;
+	std::vector<std::string> responseHeaders;
+	int code = -1;
+	// If we're reusing a kept-alive connection, the server may have dropped it
+	// since the last read - then the request fails and we retry on a fresh one.
+	for (int tries = 2; code < 0 && tries > 0; --tries) {
+		Connect();
+		if (!connected_) {
+			return 0;
+		}
+
+		int err = client_.SendRequest("GET", url_.Resource().c_str(), requestHeaders, nullptr);
+		if (err < 0) {
+			Disconnect();
+			continue;
+		}
+
+		readbuf.clear();
+		responseHeaders.clear();
+		code = client_.ReadResponseHeaders(&readbuf, responseHeaders);
+		if (code < 0) {
+			Disconnect();
+		}
+	}
+	if (code < 0) {
 		latestError_ = "Invalid response reading data";
-		Disconnect();
 		return 0;
 	}
 
-	Buffer readbuf;
-	std::vector<std::string> responseHeaders;
-	int code = client_.ReadResponseHeaders(&readbuf, responseHeaders);
 	if (code != 206) {
 		ERROR_LOG(LOADER, "HTTP server did not respond with range, received code=%03d", code);
 		latestError_ = "Invalid response reading data";
@@ -187,11 +219,13 @@ size_t HTTPFileLoader::ReadAt(s64 absolutePos, size_t bytes, void *data, Flags f
 	if (res != 0) {
 		ERROR_LOG(LOADER, "Unable to read HTTP response entity: %d", res);
 		// Let's take anything we got anyway.  Not worse than returning nothing?
+		// We may have left part of the entity on the socket, though, so it's no
+		// longer usable for the next request.
+		Disconnect();
+	} else if (ResponseRequestsClose(responseHeaders)) {
+		Disconnect();
 	}
 
-	// TODO: Keepalive instead.
-	Disconnect();
-
 	if (!supportedResponse) {
 		ERROR_LOG(LOADER, "HTTP server did not respond with the range we wanted.");
 		latestError_ = "Invalid response reading data";
@@ -16,6 +16,7 @@
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
 #include <cstdio>
+#include <cstring>
 
 #include "ppsspp_config.h"
 #include "util/text/utf8.h"
@@ -27,6 +28,7 @@
 #include "Common/CommonWindows.h"
 #else
 #include <fcntl.h>
+#include <sys/mman.h>
 #endif
 
 LocalFileLoader::LocalFileLoader(const std::string &filename)
@@ -51,6 +53,18 @@ LocalFileLoader::LocalFileLoader(const std::string &filename)
 	lseek(fd_, 0, SEEK_SET);
 #endif
 
+#if PPSSPP_ARCH(64BIT)
+	// With address space to spare, map the file as well - sector-sized reads then
+	// become memcpy from the page cache, and the kernel does readahead for us.
+	// We keep the fd open to fall back on if the mapping fails.
+	if (filesize_ > 0) {
+		void *map = mmap(nullptr, filesize_, PROT_READ, MAP_SHARED, fd_, 0);
+		if (map != MAP_FAILED) {
+			mappedData_ = (const u8 *)map;
+		}
+	}
+#endif
+
 #else // _WIN32
 
 	const DWORD access = GENERIC_READ, share = FILE_SHARE_READ, mode = OPEN_EXISTING, flags = FILE_ATTRIBUTE_NORMAL;
@@ -72,15 +86,38 @@ LocalFileLoader::LocalFileLoader(const std::string &filename)
 	}
 	filesize_ = end_offset.QuadPart;
 	SetFilePointerEx(handle_, zero, nullptr, FILE_BEGIN);
+
+#if PPSSPP_ARCH(64BIT) && !PPSSPP_PLATFORM(UWP)
+	// See the POSIX side above - reads from the mapping are memcpy from the page cache.
+	if (filesize_ > 0) {
+		mapping_ = CreateFileMapping(handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping_ != nullptr) {
+			mappedData_ = (const u8 *)MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+			if (mappedData_ == nullptr) {
+				CloseHandle(mapping_);
+				mapping_ = nullptr;
+			}
+		}
+	}
+#endif
 #endif // _WIN32
 }
 
 LocalFileLoader::~LocalFileLoader() {
 #ifndef _WIN32
+	if (mappedData_ != nullptr) {
+		munmap((void *)mappedData_, filesize_);
+	}
 	if (fd_ != -1) {
 		close(fd_);
 	}
 #else
+	if (mappedData_ != nullptr) {
+		UnmapViewOfFile(mappedData_);
+	}
+	if (mapping_ != nullptr) {
+		CloseHandle(mapping_);
+	}
 	if (handle_ != INVALID_HANDLE_VALUE) {
 		CloseHandle(handle_);
 	}
@@ -117,6 +154,17 @@ std::string LocalFileLoader::Path() const {
 }
 
 size_t LocalFileLoader::ReadAt(s64 absolutePos, size_t bytes, size_t count, void *data, Flags flags) {
+	if (mappedData_ != nullptr) {
+		if (absolutePos < 0 || (u64)absolutePos >= filesize_) {
+			return 0;
+		}
+		size_t toRead = bytes * count;
+		if (toRead > filesize_ - absolutePos) {
+			toRead = (size_t)(filesize_ - absolutePos);
+		}
+		memcpy(data, mappedData_ + absolutePos, toRead);
+		return toRead / bytes;
+	}
 #if PPSSPP_PLATFORM(ANDROID)
 	// pread64 doesn't appear to actually be 64-bit safe, though such ISOs are uncommon.  See #10862.
 	if (absolutePos <= 0x7FFFFFFF) {
@@ -40,7 +40,11 @@ private:
 	int fd_;
 #else
 	HANDLE handle_;
+	HANDLE mapping_ = nullptr;
 #endif
+	// On 64-bit hosts, the file is also mapped read-only, so reads become plain
+	// memcpy from the page cache. Stays null if mapping wasn't possible.
+	const u8 *mappedData_ = nullptr;
 	u64 filesize_;
 	std::string filename_;
 	std::mutex readLock_;
@@ -71,7 +71,13 @@ size_t RamCachingFileLoader::ReadAt(s64 absolutePos, size_t bytes, void *data, F
 	if (cache_ == nullptr || (flags & Flags::HINT_UNCACHED) != 0) {
 		readSize = backend_->ReadAt(absolutePos, bytes, data, flags);
 	} else {
+		lastReadTime_ = real_time_now();
 		readSize = ReadFromCache(absolutePos, bytes, data);
+		if (readSize >= bytes) {
+			cacheHits_++;
+		} else {
+			cacheMisses_++;
+		}
 		// While in case the cache size is too small for the entire read.
 		while (readSize < bytes) {
 			SaveIntoCache(absolutePos + readSize, bytes - readSize, flags);
@@ -222,8 +228,18 @@ void RamCachingFileLoader::StartReadAhead(s64 pos) {
 	aheadCancel_ = false;
 	std::thread th([this] {
 		setCurrentThreadName("FileLoaderReadAhead");
+		setCurrentThreadAffinityClass(THREAD_AFFINITY_EFFICIENCY);
 
 		while (aheadRemaining_ != 0 && !aheadCancel_) {
+			// With no fresh hint from the game's read cursor, this is just the
+			// low-priority whole-file sweep. Stay out of the way while the game
+			// is actively reading so the backend's bandwidth goes to the blocks
+			// it's waiting on - the rest gets swept up once it goes quiet.
+			if (aheadPos_ == 0 && real_time_now() - lastReadTime_ < READAHEAD_BACKOFF_SECONDS) {
+				sleep_ms(10);
+				continue;
+			}
+
 			// Where should we look?
 			const u32 cacheStartPos = NextAheadBlock();
 			if (cacheStartPos == 0xFFFFFFFF) {
@@ -243,6 +259,10 @@ void RamCachingFileLoader::StartReadAhead(s64 pos) {
 			}
 		}
 
+		if (aheadRemaining_ == 0) {
+			INFO_LOG(LOADER, "RAM cache fully populated (%u hits, %u misses so far)", cacheHits_, cacheMisses_);
+		}
+
 		aheadThread_ = false;
 	});
 	th.detach();
@@ -56,6 +56,10 @@ private:
 		BLOCK_READAHEAD = 4,
 	};
 
+	// How long after the game's last read the background sweep waits before
+	// using the backend again. Reads ahead of the cursor aren't delayed.
+	static constexpr double READAHEAD_BACKOFF_SECONDS = 0.1;
+
 	s64 filesize_ = 0;
 	u8 *cache_ = nullptr;
 	int exists_ = -1;
@@ -67,4 +71,11 @@ private:
 	s64 aheadPos_;
 	bool aheadThread_ = false;
 	bool aheadCancel_ = false;
+
+	// When the game last performed a read, so the background sweep can back off
+	// while it's busy. Written without the lock, only read for the heuristic.
+	volatile double lastReadTime_ = 0.0;
+	// Hit rate bookkeeping, logged when the sweep finishes.
+	u32 cacheHits_ = 0;
+	u32 cacheMisses_ = 0;
 };
@@ -18,8 +18,11 @@
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
+#include <vector>
+#include "base/timeutil.h"
 #include "i18n/i18n.h"
 #include "Common/FileUtil.h"
+#include "Common/ThreadPools.h"
 #include "Common/Swap.h"
 #include "Core/Loaders.h"
 #include "Core/Host.h"
@@ -34,6 +37,51 @@ extern "C"
 
 std::mutex NPDRMDemoBlockDevice::mutex_;
 
+FILE *BlockDevice::traceFile_ = nullptr;
+std::mutex BlockDevice::traceMutex_;
+double BlockDevice::traceStartTime_ = 0.0;
+
+static const char BLOCK_TRACE_MAGIC[8] = { 'P', 'P', 'I', 'O', 'T', 'R', 'C', '1' };
+
+bool BlockDevice::StartIOTrace(const std::string &path) {
+	std::lock_guard<std::mutex> guard(traceMutex_);
+	if (traceFile_) {
+		return false;
+	}
+	traceFile_ = File::OpenCFile(path, "wb");
+	if (!traceFile_) {
+		ERROR_LOG(FILESYS, "Could not create I/O trace file %s", path.c_str());
+		return false;
+	}
+	fwrite(BLOCK_TRACE_MAGIC, sizeof(BLOCK_TRACE_MAGIC), 1, traceFile_);
+	traceStartTime_ = real_time_now();
+	return true;
+}
+
+void BlockDevice::StopIOTrace() {
+	std::lock_guard<std::mutex> guard(traceMutex_);
+	if (traceFile_) {
+		fclose(traceFile_);
+		traceFile_ = nullptr;
+	}
+}
+
+void BlockDevice::TraceRead(u32 blockNumber, int count) {
+	// Unlocked pre-check so the common tracing-off case costs nothing.
+	if (!traceFile_) {
+		return;
+	}
+	std::lock_guard<std::mutex> guard(traceMutex_);
+	if (!traceFile_) {
+		return;
+	}
+	BlockDeviceTraceEntry entry;
+	entry.timeUs = (u64)((real_time_now() - traceStartTime_) * 1000000.0);
+	entry.block = blockNumber;
+	entry.count = count;
+	fwrite(&entry, sizeof(entry), 1, traceFile_);
+}
+
 BlockDevice *constructBlockDevice(FileLoader *fileLoader) {
 	// Check for CISO
 	if (!fileLoader->Exists())
@@ -48,16 +96,52 @@ BlockDevice *constructBlockDevice(FileLoader *fileLoader) {
 		return new FileBlockDevice(fileLoader);
 }
 
-u32 BlockDevice::CalculateCRC() {
+u32 BlockDevice::CalculateCRC(volatile bool *eager) {
 	u32 crc = crc32(0, Z_NULL, 0);
 
-	u8 block[2048];
-	for (u32 i = 0; i < GetNumBlocks(); ++i) {
-		if (!ReadBlock(i, block, true)) {
-			ERROR_LOG(FILESYS, "Failed to read block for CRC");
+	// Read in large sequential chunks rather than one 2048-byte block per
+	// virtual call - much better throughput, especially on slow or networked
+	// storage. Within each chunk, the CRC is split across the thread pool and
+	// stitched back together with crc32_combine. Same division of labor as
+	// the CISO batch read path: serial I/O, parallel CPU work.
+	const u32 blockSize = (u32)GetBlockSize();
+	const u32 blocksPerChunk = 1024;
+	const u32 blocksPerSpan = 128;
+	std::vector<u8> buffer(blocksPerChunk * blockSize);
+
+	const u32 numBlocks = GetNumBlocks();
+	for (u32 i = 0; i < numBlocks; i += blocksPerChunk) {
+		const u32 chunkBlocks = std::min(blocksPerChunk, numBlocks - i);
+		if (!ReadBlocks(i, (int)chunkBlocks, &buffer[0])) {
+			ERROR_LOG(FILESYS, "Failed to read blocks for CRC");
 			return 0;
 		}
-		crc = crc32(crc, block, 2048);
+
+		const int numSpans = (int)((chunkBlocks + blocksPerSpan - 1) / blocksPerSpan);
+		std::vector<u32> spanCRC(numSpans);
+		auto crcSpans = [&](int l, int h) {
+			for (int s = l; s < h; ++s) {
+				const u32 first = s * blocksPerSpan;
+				const u32 blocks = std::min(blocksPerSpan, chunkBlocks - first);
+				spanCRC[s] = crc32(crc32(0, Z_NULL, 0), &buffer[first * blockSize], blocks * blockSize);
+			}
+		};
+		// Not worth waking the pool for a tail chunk.
+		if (numSpans >= 4) {
+			GlobalThreadPool::Loop(crcSpans, 0, numSpans);
+		} else {
+			crcSpans(0, numSpans);
+		}
+		for (int s = 0; s < numSpans; ++s) {
+			const u32 first = s * blocksPerSpan;
+			const u32 blocks = std::min(blocksPerSpan, chunkBlocks - first);
+			crc = crc32_combine(crc, spanCRC[s], blocks * blockSize);
+		}
+
+		// Breathe between chunks while nothing needs the result yet, so the
+		// background hash doesn't compete with the game for I/O and cores.
+		if (eager && !*eager)
+			sleep_ms(1);
 	}
 
 	return crc;
@@ -80,6 +164,8 @@ FileBlockDevice::~FileBlockDevice() {
 }
 
 bool FileBlockDevice::ReadBlock(int blockNumber, u8 *outPtr, bool uncached) {
+	if (!uncached)
+		TraceRead(blockNumber, 1);
 	FileLoader::Flags flags = uncached ? FileLoader::Flags::HINT_UNCACHED : FileLoader::Flags::NONE;
 	if (fileLoader_->ReadAt((u64)blockNumber * (u64)GetBlockSize(), 1, 2048, outPtr, flags) != 2048) {
 		DEBUG_LOG(FILESYS, "Could not read 2048 bytes from block");
@@ -90,6 +176,7 @@ bool FileBlockDevice::ReadBlock(int blockNumber, u8 *outPtr, bool uncached) {
 }
 
 bool FileBlockDevice::ReadBlocks(u32 minBlock, int count, u8 *outPtr) {
+	TraceRead(minBlock, count);
 	if (fileLoader_->ReadAt((u64)minBlock * (u64)GetBlockSize(), 2048, count, outPtr) != (size_t)count) {
 		ERROR_LOG(FILESYS, "Could not read %d bytes from block", 2048 * count);
 		return false;
@@ -170,8 +257,23 @@ CISOFileBlockDevice::CISOFileBlockDevice(FileLoader *fileLoader)
 		readBuffer = new u8[CSO_READ_BUFFER_SIZE];
 	else
 		readBuffer = new u8[frameSize + (1 << indexShift)];
-	zlibBuffer = new u8[frameSize + (1 << indexShift)];
-	zlibBufferFrame = numFrames;
+	for (int i = 0; i < FRAME_CACHE_SIZE; ++i) {
+		frameCache[i] = new u8[frameSize + (1 << indexShift)];
+		frameCacheFrame[i] = numFrames;
+		frameCacheAge[i] = 0;
+	}
+	frameCacheCounter = 0;
+
+	// One stream for all single-threaded inflates, reset between frames.
+	zStream = new z_stream();
+	zStream->zalloc = Z_NULL;
+	zStream->zfree = Z_NULL;
+	zStream->opaque = Z_NULL;
+	if (inflateInit2(zStream, -15) != Z_OK) {
+		ERROR_LOG(LOADER, "Unable to initialize inflate: %s\n", (zStream->msg) ? zStream->msg : "?");
+		delete zStream;
+		zStream = nullptr;
+	}
 
 	const u32 indexSize = numFrames + 1;
 
@@ -210,11 +312,46 @@ CISOFileBlockDevice::~CISOFileBlockDevice()
 {
 	delete [] index;
 	delete [] readBuffer;
-	delete [] zlibBuffer;
+	for (int i = 0; i < FRAME_CACHE_SIZE; ++i)
+		delete [] frameCache[i];
+	if (zStream) {
+		inflateEnd(zStream);
+		delete zStream;
+	}
+}
+
+u8 *CISOFileBlockDevice::GetCachedFrame(u32 frameNumber) {
+	for (int i = 0; i < FRAME_CACHE_SIZE; ++i) {
+		if (frameCacheFrame[i] == frameNumber) {
+			frameCacheAge[i] = ++frameCacheCounter;
+			return frameCache[i];
+		}
+	}
+	return nullptr;
+}
+
+u8 *CISOFileBlockDevice::AllocFrameCacheSlot(u32 frameNumber) {
+	int victim = 0;
+	for (int i = 1; i < FRAME_CACHE_SIZE; ++i) {
+		if (frameCacheAge[i] < frameCacheAge[victim])
+			victim = i;
+	}
+	frameCacheFrame[victim] = frameNumber;
+	frameCacheAge[victim] = ++frameCacheCounter;
+	return frameCache[victim];
+}
+
+void CISOFileBlockDevice::InvalidateCachedFrame(u32 frameNumber) {
+	for (int i = 0; i < FRAME_CACHE_SIZE; ++i) {
+		if (frameCacheFrame[i] == frameNumber)
+			frameCacheFrame[i] = numFrames;
+	}
 }
 
 bool CISOFileBlockDevice::ReadBlock(int blockNumber, u8 *outPtr, bool uncached)
 {
+	if (!uncached)
+		TraceRead(blockNumber, 1);
 	FileLoader::Flags flags = uncached ? FileLoader::Flags::HINT_UNCACHED : FileLoader::Flags::NONE;
 	if ((u32)blockNumber >= numBlocks)
 	{
@@ -226,7 +363,6 @@ bool CISOFileBlockDevice::ReadBlock(int blockNumber, u8 *outPtr, bool uncached)
 	const u32 idx = index[frameNumber];
 	const u32 indexPos = idx & 0x7FFFFFFF;
 	const u32 nextIndexPos = index[frameNumber + 1] & 0x7FFFFFFF;
-	z_stream z;
 
 	const u64 compressedReadPos = (u64)indexPos << indexShift;
 	const u64 compressedReadEnd = (u64)nextIndexPos << indexShift;
@@ -240,54 +376,63 @@ bool CISOFileBlockDevice::ReadBlock(int blockNumber, u8 *outPtr, bool uncached)
 		if (readSize < GetBlockSize())
 			memset(outPtr + readSize, 0, GetBlockSize() - readSize);
 	}
-	else if (zlibBufferFrame == frameNumber)
-	{
-		// We already have it.  Just apply the offset and copy.
-		memcpy(outPtr, zlibBuffer + compressedOffset, GetBlockSize());
-	}
 	else
 	{
-		const u32 readSize = (u32)fileLoader_->ReadAt(compressedReadPos, 1, compressedReadSize, readBuffer, flags);
-
-		z.zalloc = Z_NULL;
-		z.zfree = Z_NULL;
-		z.opaque = Z_NULL;
-		if (inflateInit2(&z, -15) != Z_OK) {
-			ERROR_LOG(LOADER, "GetBlockSize() ERROR: %s\n", (z.msg) ? z.msg : "?");
+		const u8 *cached = GetCachedFrame(frameNumber);
+		if (cached) {
+			// We already have it.  Just apply the offset and copy.
+			memcpy(outPtr, cached + compressedOffset, GetBlockSize());
+			return true;
+		}
+		if (!zStream) {
 			NotifyReadError();
+			memset(outPtr, 0, GetBlockSize());
 			return false;
 		}
-		z.avail_in = readSize;
-		z.next_out = frameSize == (u32)GetBlockSize() ? outPtr : zlibBuffer;
-		z.avail_out = frameSize;
-		z.next_in = readBuffer;
 
-		int status = inflate(&z, Z_FINISH);
+		const u32 readSize = (u32)fileLoader_->ReadAt(compressedReadPos, 1, compressedReadSize, readBuffer, flags);
+
+		u8 *cacheSlot = nullptr;
+		u8 *dest = outPtr;
+		if (frameSize != (u32)GetBlockSize()) {
+			cacheSlot = AllocFrameCacheSlot(frameNumber);
+			dest = cacheSlot;
+		}
+
+		zStream->avail_in = readSize;
+		zStream->next_out = dest;
+		zStream->avail_out = frameSize;
+		zStream->next_in = readBuffer;
+
+		int status = inflate(zStream, Z_FINISH);
 		if (status != Z_STREAM_END) {
-			ERROR_LOG(LOADER, "block %d: inflate : %s[%d]\n", blockNumber, (z.msg) ? z.msg : "error", status);
+			ERROR_LOG(LOADER, "block %d: inflate : %s[%d]\n", blockNumber, (zStream->msg) ? zStream->msg : "error", status);
 			NotifyReadError();
-			inflateEnd(&z);
+			inflateReset(zStream);
+			InvalidateCachedFrame(frameNumber);
 			memset(outPtr, 0, GetBlockSize());
 			return false;
 		}
-		if (z.total_out != frameSize) {
-			ERROR_LOG(LOADER, "block %d: block size error %d != %d\n", blockNumber, (u32)z.total_out, frameSize);
+		if (zStream->total_out != frameSize) {
+			ERROR_LOG(LOADER, "block %d: block size error %d != %d\n", blockNumber, (u32)zStream->total_out, frameSize);
 			NotifyReadError();
-			inflateEnd(&z);
+			inflateReset(zStream);
+			InvalidateCachedFrame(frameNumber);
 			memset(outPtr, 0, GetBlockSize());
 			return false;
 		}
-		inflateEnd(&z);
+		inflateReset(zStream);
 
-		if (frameSize != (u32)GetBlockSize()) {
-			zlibBufferFrame = frameNumber;
-			memcpy(outPtr, zlibBuffer + compressedOffset, GetBlockSize());
+		if (cacheSlot) {
+			memcpy(outPtr, cacheSlot + compressedOffset, GetBlockSize());
 		}
 	}
 	return true;
 }
 
 bool CISOFileBlockDevice::ReadBlocks(u32 minBlock, int count, u8 *outPtr) {
+	if (count != 1)
+		TraceRead(minBlock, count);
 	if (count == 1) {
 		return ReadBlock(minBlock, outPtr);
 	}
@@ -307,15 +452,60 @@ bool CISOFileBlockDevice::ReadBlocks(u32 minBlock, int count, u8 *outPtr) {
 	const u32 afterLastIndexPos = index[lastFrameNumber + 1] & 0x7FFFFFFF;
 	const u64 totalReadEnd = (u64)afterLastIndexPos << indexShift;
 
-	z_stream z;
-	z.zalloc = Z_NULL;
-	z.zfree = Z_NULL;
-	z.opaque = Z_NULL;
-	if (inflateInit2(&z, -15) != Z_OK) {
-		ERROR_LOG(LOADER, "Unable to initialize inflate: %s\n", (z.msg) ? z.msg : "?");
+	if (!zStream) {
 		return false;
 	}
 
+	// Full frames that land directly in the output buffer are independent of
+	// each other, so we batch them up and inflate the batch on the thread pool.
+	struct FrameInflateTask {
+		const u8 *src;
+		u32 srcSize;
+		u8 *dst;
+	};
+	std::vector<FrameInflateTask> tasks;
+	bool inflateError = false;
+
+	auto flushTasks = [&]() {
+		if (tasks.empty())
+			return;
+		auto inflateRange = [&](int l, int h) {
+			z_stream z;
+			z.zalloc = Z_NULL;
+			z.zfree = Z_NULL;
+			z.opaque = Z_NULL;
+			if (inflateInit2(&z, -15) != Z_OK) {
+				for (int i = l; i < h; ++i)
+					memset(tasks[i].dst, 0, frameSize);
+				inflateError = true;
+				return;
+			}
+			for (int i = l; i < h; ++i) {
+				const FrameInflateTask &t = tasks[i];
+				z.avail_in = t.srcSize;
+				z.next_in = (Bytef *)t.src;
+				z.avail_out = frameSize;
+				z.next_out = t.dst;
+
+				int status = inflate(&z, Z_FINISH);
+				if (status != Z_STREAM_END || z.total_out != frameSize) {
+					ERROR_LOG(LOADER, "Inflate frame failed - %s[%d]\n", (z.msg) ? z.msg : "error", status);
+					memset(t.dst, 0, frameSize);
+					inflateError = true;
+				}
+				inflateReset(&z);
+			}
+			inflateEnd(&z);
+		};
+		// Not worth waking the pool for just a few frames.
+		if (tasks.size() >= 16) {
+			GlobalThreadPool::Loop(inflateRange, 0, (int)tasks.size());
+		} else {
+			inflateRange(0, (int)tasks.size());
+		}
+		tasks.clear();
+	};
+
 	u64 readBufferStart = 0;
 	u64 readBufferEnd = 0;
 	u32 block = minBlock;
@@ -332,6 +522,9 @@ bool CISOFileBlockDevice::ReadBlocks(u32 minBlock, int count, u8 *outPtr) {
 		const u32 frameBlocks = std::min(lastBlock - block + 1, blocksPerFrame - frameBlockOffset);
 
 		if (frameReadEnd > readBufferEnd) {
+			// Pending tasks point into readBuffer, so finish them before refilling it.
+			flushTasks();
+
 			const s64 maxNeeded = totalReadEnd - frameReadPos;
 			const size_t chunkSize = (size_t)std::min(maxNeeded, (s64)std::max(frameReadSize, CSO_READ_BUFFER_SIZE));
 
@@ -348,35 +541,47 @@ bool CISOFileBlockDevice::ReadBlocks(u32 minBlock, int count, u8 *outPtr) {
 		const int plain = idx & 0x80000000;
 		if (plain) {
 			memcpy(outPtr, rawBuffer + frameBlockOffset * GetBlockSize(), frameBlocks * GetBlockSize());
+		} else if (frameBlocks == blocksPerFrame) {
+			tasks.push_back({ rawBuffer, frameReadSize, outPtr });
 		} else {
-			z.avail_in = frameReadSize;
-			z.next_out = frameBlocks == blocksPerFrame ? outPtr : zlibBuffer;
-			z.avail_out = frameSize;
-			z.next_in = rawBuffer;
-
-			int status = inflate(&z, Z_FINISH);
-			if (status != Z_STREAM_END) {
-				ERROR_LOG(LOADER, "Inflate frame %d: failed - %s[%d]\n", frame, (z.msg) ? z.msg : "error", status);
-				NotifyReadError();
-				memset(outPtr, 0, frameBlocks * GetBlockSize());
-			} else if (z.total_out != frameSize) {
-				ERROR_LOG(LOADER, "Inflate frame %d: block size error %d != %d\n", frame, (u32)z.total_out, frameSize);
-				NotifyReadError();
-				memset(outPtr, 0, frameBlocks * GetBlockSize());
-			} else if (frameBlocks != blocksPerFrame) {
-				memcpy(outPtr, zlibBuffer + frameBlockOffset * GetBlockSize(), frameBlocks * GetBlockSize());
-				// In case we end up reusing it in a single read later.
-				zlibBufferFrame = frame;
+			// Partial frame at the edge of the range. Inflate it into the frame
+			// cache so an adjacent single-block read can pick it up later.
+			const u8 *cached = GetCachedFrame(frame);
+			if (cached) {
+				memcpy(outPtr, cached + frameBlockOffset * GetBlockSize(), frameBlocks * GetBlockSize());
+			} else {
+				u8 *cacheSlot = AllocFrameCacheSlot(frame);
+				zStream->avail_in = frameReadSize;
+				zStream->next_out = cacheSlot;
+				zStream->avail_out = frameSize;
+				zStream->next_in = rawBuffer;
+
+				int status = inflate(zStream, Z_FINISH);
+				if (status != Z_STREAM_END) {
+					ERROR_LOG(LOADER, "Inflate frame %d: failed - %s[%d]\n", frame, (zStream->msg) ? zStream->msg : "error", status);
+					NotifyReadError();
+					InvalidateCachedFrame(frame);
+					memset(outPtr, 0, frameBlocks * GetBlockSize());
+				} else if (zStream->total_out != frameSize) {
+					ERROR_LOG(LOADER, "Inflate frame %d: block size error %d != %d\n", frame, (u32)zStream->total_out, frameSize);
+					NotifyReadError();
+					InvalidateCachedFrame(frame);
+					memset(outPtr, 0, frameBlocks * GetBlockSize());
+				} else {
+					memcpy(outPtr, cacheSlot + frameBlockOffset * GetBlockSize(), frameBlocks * GetBlockSize());
+				}
+				inflateReset(zStream);
 			}
-
-			inflateReset(&z);
 		}
 
 		block += frameBlocks;
 		outPtr += frameBlocks * GetBlockSize();
 	}
 
-	inflateEnd(&z);
+	flushTasks();
+	if (inflateError) {
+		NotifyReadError();
+	}
 	return true;
 }
 
@@ -459,6 +664,8 @@ int lzrc_decompress(void *out, int out_len, void *in, int in_len);
 
 bool NPDRMDemoBlockDevice::ReadBlock(int blockNumber, u8 *outPtr, bool uncached)
 {
+	if (!uncached)
+		TraceRead(blockNumber, 1);
 	FileLoader::Flags flags = uncached ? FileLoader::Flags::HINT_UNCACHED : FileLoader::Flags::NONE;
 	std::lock_guard<std::mutex> guard(mutex_);
 	CIPHER_KEY ckey;
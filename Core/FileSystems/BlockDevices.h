@@ -23,13 +23,26 @@
 // The ISOFileSystemReader reads from a BlockDevice, so it automatically works
 // with CISO images.
 
+#include <cstdio>
 #include <mutex>
+#include <string>
 
 #include "Common/CommonTypes.h"
+#include "Common/Swap.h"
 #include "Core/ELF/PBPReader.h"
 
 class FileLoader;
 
+// One record per read in an I/O trace file, see BlockDevice::StartIOTrace().
+// The file starts with the 8-byte magic "PPIOTRC1", then packed records.
+#pragma pack(push, 1)
+struct BlockDeviceTraceEntry {
+	u64_le timeUs;  // Microseconds since the trace started.
+	u32_le block;
+	u32_le count;
+};
+#pragma pack(pop)
+
 class BlockDevice {
 public:
 	virtual ~BlockDevice() {}
@@ -46,11 +59,27 @@ public:
 	int GetBlockSize() const { return 2048;}  // forced, it cannot be changed by subclasses
 	virtual u32 GetNumBlocks() = 0;
 
-	u32 CalculateCRC();
+	// If eager is provided, hashing trickles along with small sleeps while
+	// *eager is false, instead of reading the whole disc in one burst. Flip
+	// it to true to finish at full speed once something waits on the result.
+	u32 CalculateCRC(volatile bool *eager = nullptr);
 	void NotifyReadError();
 
+	// Appends (timestamp, block, count) for every cached read on any block
+	// device to a compact binary log, so real access patterns can be replayed
+	// against loader changes - see headless/TraceReplay.cpp.
+	static bool StartIOTrace(const std::string &path);
+	static void StopIOTrace();
+
 protected:
+	void TraceRead(u32 blockNumber, int count);
+
 	bool reportedError_ = false;
+
+private:
+	static FILE *traceFile_;
+	static std::mutex traceMutex_;
+	static double traceStartTime_;
 };
 
 class CISOFileBlockDevice : public BlockDevice {
@@ -62,11 +91,24 @@ public:
 	u32 GetNumBlocks() override { return numBlocks; }
 
 private:
+	u8 *GetCachedFrame(u32 frameNumber);
+	u8 *AllocFrameCacheSlot(u32 frameNumber);
+	void InvalidateCachedFrame(u32 frameNumber);
+
+	enum {
+		// A few recently decompressed frames. Mostly helps metadata reads, which
+		// bounce between the same few sectors with single-block reads.
+		FRAME_CACHE_SIZE = 4,
+	};
+
 	FileLoader *fileLoader_;
 	u32 *index;
 	u8 *readBuffer;
-	u8 *zlibBuffer;
-	u32 zlibBufferFrame;
+	u8 *frameCache[FRAME_CACHE_SIZE];
+	u32 frameCacheFrame[FRAME_CACHE_SIZE];
+	u32 frameCacheAge[FRAME_CACHE_SIZE];
+	u32 frameCacheCounter;
+	struct z_stream_s *zStream;
 	u8 indexShift;
 	u8 blockShift;
 	u32 frameSize;
@@ -18,10 +18,15 @@
 #include "ppsspp_config.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include "file/free.h"
 #include "file/zip_read.h"
 #include "i18n/i18n.h"
+#include "thread/threadutil.h"
 #include "util/text/utf8.h"
 #include "Common/ChunkFile.h"
 #include "Common/FileUtil.h"
@@ -33,6 +38,7 @@
 #include "Core/Host.h"
 #include "Core/Replay.h"
 #include "Core/Reporting.h"
+#include "Core/System.h"
 
 #ifdef _WIN32
 #include "Common/CommonWindows.h"
@@ -327,6 +333,9 @@ bool DirectoryFileHandle::Open(std::string &basePath, std::string &fileName, Fil
 
 size_t DirectoryFileHandle::Read(u8* pointer, s64 size)
 {
+	if (writeBackActive_)
+		FlushWriteBack();
+
 	size_t bytesRead = 0;
 	if (needsTrunc_ != -1) {
 		// If the file was marked to be truncated, pretend there's nothing.
@@ -347,8 +356,142 @@ size_t DirectoryFileHandle::Read(u8* pointer, s64 size)
 	return replay_ ? ReplayApplyDiskRead(pointer, (uint32_t)bytesRead, (uint32_t)size, CoreTiming::GetGlobalTimeUs()) : bytesRead;
 }
 
+// When the MemStickWriteBack compat flag is set, memstick writes are
+// acknowledged immediately and queued here; a background thread performs the
+// host writes, in submission order. Reads, seeks and closes on a handle with
+// pending writes drain them first, so the guest can never observe stale data -
+// read-back verification still works, just without the win. A synchronous
+// journal would reintroduce the very stall this exists to remove; instead the
+// flusher starts on the data right away, so the crash window is milliseconds,
+// comparable to the OS's own write-back caching.
+namespace {
+
+class WriteBackQueue {
+public:
+	~WriteBackQueue() {
+		if (thread_.joinable()) {
+			{
+				std::lock_guard<std::mutex> guard(lock_);
+				exit_ = true;
+				wake_.notify_one();
+			}
+			thread_.join();
+		}
+	}
+
+	void Push(DirectoryFileHandle *handle, s64 offset, const u8 *data, size_t size) {
+		std::lock_guard<std::mutex> guard(lock_);
+		if (!thread_.joinable()) {
+			thread_ = std::thread(&WriteBackQueue::ThreadFunc, this);
+		}
+		queue_.push_back(Pending{ handle, offset, std::vector<u8>(data, data + size) });
+		wake_.notify_one();
+	}
+
+	// Blocks until nothing queued on this handle remains unwritten.
+	void Drain(DirectoryFileHandle *handle) {
+		std::unique_lock<std::mutex> guard(lock_);
+		while (busy_ == handle || QueuedLocked(handle)) {
+			drained_.wait(guard);
+		}
+	}
+
+private:
+	struct Pending {
+		DirectoryFileHandle *handle;
+		s64 offset;
+		std::vector<u8> data;
+	};
+
+	bool QueuedLocked(DirectoryFileHandle *handle) const {
+		for (const auto &p : queue_) {
+			if (p.handle == handle)
+				return true;
+		}
+		return false;
+	}
+
+	void ThreadFunc() {
+		setCurrentThreadName("MemStickWrite");
+		// Flushing happens behind the emulation, don't steal a fast core for it.
+		setCurrentThreadAffinityClass(THREAD_AFFINITY_EFFICIENCY);
+		std::unique_lock<std::mutex> guard(lock_);
+		while (!exit_) {
+			if (queue_.empty()) {
+				wake_.wait(guard);
+				continue;
+			}
+			Pending item = std::move(queue_.front());
+			queue_.pop_front();
+			busy_ = item.handle;
+			guard.unlock();
+
+			size_t written = item.handle->WriteAt(item.offset, item.data.data(), (s64)item.data.size());
+			if (written != item.data.size()) {
+				// Same user feedback as a synchronous short write. The guest
+				// already saw success - that's the tradeoff the flag opts into.
+				ERROR_LOG(FILESYS, "Write-back flush wrote %d of %d bytes", (int)written, (int)item.data.size());
+				I18NCategory *err = GetI18NCategory("Error");
+				host->NotifyUserMessage(err->T("Disk full while writing data"));
+			}
+
+			guard.lock();
+			busy_ = nullptr;
+			drained_.notify_all();
+		}
+	}
+
+	std::thread thread_;
+	std::mutex lock_;
+	std::condition_variable wake_;
+	std::condition_variable drained_;
+	std::deque<Pending> queue_;
+	DirectoryFileHandle *busy_ = nullptr;
+	bool exit_ = false;
+};
+
+}  // namespace
+
+static WriteBackQueue g_memStickWriteBack;
+
+void DirectoryFileHandle::FlushWriteBack() {
+	g_memStickWriteBack.Drain(this);
+	writeBackActive_ = false;
+	// The flusher may have moved the host file pointer (it does on Windows),
+	// restore the guest's view of it.
+	Seek((s32)writeBackPos_, FILEMOVE_BEGIN);
+}
+
+size_t DirectoryFileHandle::WriteAt(s64 offset, const u8 *pointer, s64 size)
+{
+	size_t bytesWritten = 0;
+#ifdef _WIN32
+	OVERLAPPED offsetParam = {};
+	offsetParam.Offset = (DWORD)(offset & 0xFFFFFFFF);
+	offsetParam.OffsetHigh = (DWORD)(offset >> 32);
+	::WriteFile(hFile, (LPVOID)pointer, (DWORD)size, (LPDWORD)&bytesWritten, &offsetParam);
+#else
+	ssize_t result = pwrite(hFile, pointer, size, (off_t)offset);
+	bytesWritten = result < 0 ? 0 : (size_t)result;
+#endif
+	return bytesWritten;
+}
+
 size_t DirectoryFileHandle::Write(const u8* pointer, s64 size)
 {
+	if (PSP_CoreParameter().compat.flags().MemStickWriteBack && size > 0) {
+		if (!writeBackActive_) {
+			writeBackPos_ = Seek(0, FILEMOVE_CURRENT);
+			writeBackActive_ = true;
+		}
+		g_memStickWriteBack.Push(this, writeBackPos_, pointer, (size_t)size);
+		writeBackPos_ += size;
+		if (needsTrunc_ != -1 && needsTrunc_ < writeBackPos_) {
+			needsTrunc_ = writeBackPos_;
+		}
+		return (size_t)size;
+	}
+
 	size_t bytesWritten = 0;
 	bool diskFull = false;
 
@@ -388,6 +531,9 @@ size_t DirectoryFileHandle::Write(const u8* pointer, s64 size)
 
 size_t DirectoryFileHandle::Seek(s32 position, FileMove type)
 {
+	if (writeBackActive_)
+		FlushWriteBack();
+
 	if (needsTrunc_ != -1) {
 		// If the file is "currently truncated" move to the end based on that position.
 		// The actual, underlying file hasn't been truncated (yet.)
@@ -426,6 +572,9 @@ size_t DirectoryFileHandle::Seek(s32 position, FileMove type)
 
 void DirectoryFileHandle::Close()
 {
+	if (writeBackActive_)
+		FlushWriteBack();
+
 	if (needsTrunc_ != -1) {
 #ifdef _WIN32
 		Seek((s32)needsTrunc_, FILEMOVE_BEGIN);
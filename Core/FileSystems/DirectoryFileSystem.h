@@ -70,6 +70,11 @@ struct DirectoryFileHandle {
 #endif
 	s64 needsTrunc_ = -1;
 	bool replay_ = true;
+	// Write-back cache state (MemStickWriteBack compat flag.) While writes are
+	// pending on the background flusher, the guest's file position lives in
+	// writeBackPos_ and the host fd belongs to the flush thread alone.
+	bool writeBackActive_ = false;
+	s64 writeBackPos_ = 0;
 
 	DirectoryFileHandle(Flags flags) : replay_(flags != SKIP_REPLAY) {
 	}
@@ -78,8 +83,16 @@ struct DirectoryFileHandle {
 	bool Open(std::string& basePath, std::string& fileName, FileAccess access, u32 &err);
 	size_t Read(u8* pointer, s64 size);
 	size_t Write(const u8* pointer, s64 size);
+	// Positional write that doesn't go through the write-back cache, used by
+	// the flush thread.
+	size_t WriteAt(s64 offset, const u8 *pointer, s64 size);
 	size_t Seek(s32 position, FileMove type);
 	void Close();
+
+private:
+	// Blocks until the flusher has written everything queued on this handle,
+	// then hands the fd (and its position) back to the caller.
+	void FlushWriteBack();
 };
 
 class DirectoryFileSystem : public IFileSystem {
@@ -300,13 +300,40 @@ ISOFileSystem::TreeEntry *ISOFileSystem::GetFromPath(const std::string &path, bo
 				nextSlashIndex = pathLength;
 
 			const std::string firstPathComponent = path.substr(pathIndex, nextSlashIndex - pathIndex);
-			for (size_t i = 0; i < entry->children.size(); i++) {
-				const std::string &n = entry->children[i]->name;
-				if (firstPathComponent == n) {
-					//yay we got it
-					nextEntry = entry->children[i];
-					name = n;
-					break;
+
+			// Large directories are common in sound banks and movie folders, where
+			// games open hundreds of small files in a row. Index those by name hash
+			// so each open doesn't pay a linear scan.
+			if (!entry->childIndex && entry->children.size() >= CHILD_INDEX_THRESHOLD) {
+				int capacity = 16;
+				while (capacity < (int)entry->children.size() * 2)
+					capacity *= 2;
+				entry->childIndex = new PrehashMap<TreeEntry *, nullptr>(capacity);
+				for (size_t i = 0; i < entry->children.size(); i++) {
+					const std::string &n = entry->children[i]->name;
+					// On hash collision, only the first entry goes in - the scan
+					// below still finds the others.
+					entry->childIndex->Insert(XXH32(n.data(), n.size(), hashmapSeed), entry->children[i]);
+				}
+			}
+
+			if (entry->childIndex) {
+				TreeEntry *candidate = entry->childIndex->Get(XXH32(firstPathComponent.data(), firstPathComponent.size(), hashmapSeed));
+				// Verify the name in case of a hash collision.
+				if (candidate && candidate->name == firstPathComponent) {
+					nextEntry = candidate;
+					name = candidate->name;
+				}
+			}
+			if (!nextEntry) {
+				for (size_t i = 0; i < entry->children.size(); i++) {
+					const std::string &n = entry->children[i]->name;
+					if (firstPathComponent == n) {
+						//yay we got it
+						nextEntry = entry->children[i];
+						name = n;
+						break;
+					}
 				}
 			}
 		}
@@ -694,6 +721,7 @@ ISOFileSystem::TreeEntry::~TreeEntry() {
 	for (size_t i = 0; i < children.size(); ++i)
 		delete children[i];
 	children.clear();
+	delete childIndex;
 }
 
 void ISOFileSystem::DoState(PointerWrap &p) {
@@ -20,6 +20,8 @@
 #include <map>
 #include <list>
 
+#include "Common/Hashmaps.h"
+
 #include "FileSystem.h"
 
 #include "BlockDevices.h"
@@ -72,6 +74,14 @@ private:
 
 		bool valid;
 		std::vector<TreeEntry *> children;
+		// Index of children by name hash, built lazily for large directories.
+		// See GetFromPath().
+		PrehashMap<TreeEntry *, nullptr> *childIndex = nullptr;
+	};
+
+	enum {
+		// Below this, a linear scan through children is as fast as the hash lookup.
+		CHILD_INDEX_THRESHOLD = 8,
 	};
 
 	struct OpenFileEntry {
@@ -17,6 +17,8 @@
 
 #include "ppsspp_config.h"
 
+#include <algorithm>
+
 #include "Common/FileUtil.h"
 #include "Common/StringUtils.h"
 #include "Common/ChunkFile.h"
@@ -56,6 +58,7 @@ VirtualDiscFileSystem::VirtualDiscFileSystem(IHandleAllocator *_hAlloc, std::str
 }
 
 VirtualDiscFileSystem::~VirtualDiscFileSystem() {
+	CloseCachedIsoFile();
 	for (auto iter = entries.begin(), end = entries.end(); iter != end; ++iter) {
 		if (iter->second.type != VFILETYPE_ISO) {
 			iter->second.Close();
@@ -154,6 +157,18 @@ void VirtualDiscFileSystem::LoadFileListIndex() {
 	}
 
 	in.close();
+
+	RebuildBlockMap();
+}
+
+void VirtualDiscFileSystem::RebuildBlockMap() {
+	blockMap_.resize(fileList.size());
+	for (u32 i = 0; i < (u32)fileList.size(); i++) {
+		blockMap_[i] = i;
+	}
+	std::sort(blockMap_.begin(), blockMap_.end(), [this](u32 a, u32 b) {
+		return fileList[a].firstBlock < fileList[b].firstBlock;
+	});
 }
 
 void VirtualDiscFileSystem::DoState(PointerWrap &p)
@@ -182,6 +197,8 @@ void VirtualDiscFileSystem::DoState(PointerWrap &p)
 	if (p.mode == p.MODE_READ)
 	{
 		entries.clear();
+		CloseCachedIsoFile();
+		RebuildBlockMap();
 
 		for (int i = 0; i < entryCount; i++)
 		{
@@ -295,30 +312,64 @@ int VirtualDiscFileSystem::getFileListIndex(std::string &fileName)
 	currentBlockIndex += (entry.totalSize+2047)/2048;
 
 	fileList.push_back(entry);
+	RebuildBlockMap();
 
 	return (int)fileList.size()-1;
 }
 
 int VirtualDiscFileSystem::getFileListIndex(u32 accessBlock, u32 accessSize, bool blockMode)
 {
-	for (size_t i = 0; i < fileList.size(); i++)
+	// Find the last file starting at or before accessBlock, then walk back in
+	// case earlier (larger) files also cover it.
+	auto candidate = std::upper_bound(blockMap_.begin(), blockMap_.end(), accessBlock, [this](u32 block, u32 idx) {
+		return block < fileList[idx].firstBlock;
+	});
+
+	while (candidate != blockMap_.begin())
 	{
-		if (fileList[i].firstBlock <= accessBlock)
-		{
-			u32 sectorOffset = (accessBlock-fileList[i].firstBlock)*2048;
-			u32 totalFileSize = blockMode ? (fileList[i].totalSize+2047) & ~2047 : fileList[i].totalSize;
+		--candidate;
+		const size_t i = *candidate;
 
-			u32 endOffset = sectorOffset+accessSize;
-			if (endOffset <= totalFileSize)
-			{
-				return (int)i;
-			}
+		u32 sectorOffset = (accessBlock-fileList[i].firstBlock)*2048;
+		u32 totalFileSize = blockMode ? (fileList[i].totalSize+2047) & ~2047 : fileList[i].totalSize;
+
+		u32 endOffset = sectorOffset+accessSize;
+		if (endOffset <= totalFileSize)
+		{
+			return (int)i;
 		}
 	}
 
 	return -1;
 }
 
+bool VirtualDiscFileSystem::OpenCachedIsoFile(int fileIndex)
+{
+	if (isoReadIndex_ == fileIndex) {
+		return true;
+	}
+	CloseCachedIsoFile();
+
+	// Reset it completely, the old handler must not linger.
+	isoReadEntry_ = OpenFileEntry();
+	if (fileList[fileIndex].handler != NULL) {
+		isoReadEntry_.handler = fileList[fileIndex].handler;
+	}
+	if (!isoReadEntry_.Open(basePath, fileList[fileIndex].fileName, FILEACCESS_READ)) {
+		return false;
+	}
+	isoReadIndex_ = fileIndex;
+	return true;
+}
+
+void VirtualDiscFileSystem::CloseCachedIsoFile()
+{
+	if (isoReadIndex_ != -1) {
+		isoReadEntry_.Close();
+		isoReadIndex_ = -1;
+	}
+}
+
 u32 VirtualDiscFileSystem::OpenFile(std::string filename, FileAccess access, const char *devicename)
 {
 	OpenFileEntry entry;
@@ -460,47 +511,59 @@ size_t VirtualDiscFileSystem::ReadFile(u32 handle, u8 *pointer, s64 size, int &u
 		}
 
 		// it's the whole iso... it could reference any of the files on the disc.
-		// For now let's just open and close the files on demand. Can certainly be done
-		// better though
+		// The file the last read came from stays open, which is nearly always the
+		// next one up, and a read crossing into the next file keeps going there.
 		if (iter->second.type == VFILETYPE_ISO)
 		{
-			int fileIndex = getFileListIndex(iter->second.curOffset,size*2048,true);
-			if (fileIndex == -1)
+			s64 sectorsLeft = size;
+			u32 block = (u32)iter->second.curOffset;
+			u8 *dest = pointer;
+
+			while (sectorsLeft > 0)
 			{
-				ERROR_LOG(FILESYS,"VirtualDiscFileSystem: Reading from unknown address in %08x at %08llx", handle, iter->second.curOffset);
-				return 0;
-			}
+				int fileIndex = getFileListIndex(block, 2048, true);
+				if (fileIndex == -1)
+				{
+					if (dest == pointer)
+					{
+						ERROR_LOG(FILESYS,"VirtualDiscFileSystem: Reading from unknown address in %08x at %08llx", handle, iter->second.curOffset);
+						return 0;
+					}
+					// Sectors between indexed files read as zeroes, like on a real disc.
+					memset(dest, 0, sectorsLeft * 2048);
+					break;
+				}
 
-			OpenFileEntry temp;
-			if (fileList[fileIndex].handler != NULL) {
-				temp.handler = fileList[fileIndex].handler;
-			}
-			bool success = temp.Open(basePath, fileList[fileIndex].fileName, FILEACCESS_READ);
+				const FileListEntry &file = fileList[fileIndex];
+				u32 startOffset = (block - file.firstBlock) * 2048;
+				u32 fileSectorsLeft = (file.totalSize + 2047) / 2048 - (block - file.firstBlock);
+				u32 readSectors = (u32)std::min(sectorsLeft, (s64)fileSectorsLeft);
 
-			if (!success)
-			{
-				ERROR_LOG(FILESYS,"VirtualDiscFileSystem: Error opening file %s", fileList[fileIndex].fileName.c_str());
-				return 0;
-			}
+				if (!OpenCachedIsoFile(fileIndex))
+				{
+					ERROR_LOG(FILESYS,"VirtualDiscFileSystem: Error opening file %s", file.fileName.c_str());
+					return 0;
+				}
 
-			u32 startOffset = (iter->second.curOffset-fileList[fileIndex].firstBlock)*2048;
-			size_t bytesRead;
+				size_t bytesRead;
+				isoReadEntry_.Seek(startOffset, FILEMOVE_BEGIN);
 
-			temp.Seek(startOffset, FILEMOVE_BEGIN);
+				u32 remainingSize = file.totalSize - startOffset;
+				if (remainingSize < readSectors * 2048)
+				{
+					// the file doesn't fill the whole last sector
+					// read what's there and zero fill the rest like on a real disc
+					bytesRead = isoReadEntry_.Read(dest, remainingSize);
+					memset(&dest[bytesRead], 0, readSectors * 2048 - bytesRead);
+				} else {
+					bytesRead = isoReadEntry_.Read(dest, readSectors * 2048);
+				}
 
-			u32 remainingSize = fileList[fileIndex].totalSize-startOffset;
-			if (remainingSize < size * 2048)
-			{
-				// the file doesn't fill the whole last sector
-				// read what's there and zero fill the rest like on a real disc
-				bytesRead = temp.Read(pointer, remainingSize);
-				memset(&pointer[bytesRead], 0, size * 2048 - bytesRead);
-			} else {
-				bytesRead = temp.Read(pointer, size * 2048);
+				dest += readSectors * 2048;
+				block += readSectors;
+				sectorsLeft -= readSectors;
 			}
 
-			temp.Close();
-
 			iter->second.curOffset += size;
 			// TODO: This probably isn't enough...
 			if (abs((int)lastReadBlock_ - (int)iter->second.curOffset) > 100) {
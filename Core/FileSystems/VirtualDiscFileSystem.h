@@ -183,5 +183,17 @@ private:
 	u32 currentBlockIndex;
 	u32 lastReadBlock_;
 
+	void RebuildBlockMap();
+	bool OpenCachedIsoFile(int fileIndex);
+	void CloseCachedIsoFile();
+
+	// fileList indexes ordered by firstBlock, so block->file lookup can binary
+	// search instead of scanning the whole list per read.
+	std::vector<u32> blockMap_;
+	// The file the last whole-iso read came from, kept open since streaming
+	// reads usually hit the same file over and over. Not saved in states.
+	OpenFileEntry isoReadEntry_;
+	int isoReadIndex_ = -1;
+
 	std::map<std::string, Handler *> handlers;
 };
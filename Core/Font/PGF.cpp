@@ -74,7 +74,7 @@ static std::vector<int> getTable(const u8 *buf, int bpe, size_t length) {
 }
 
 PGF::PGF()
-	: fontData(0) {
+	: fontData(0), decodedGlyphBytes_(0) {
 
 }
 
@@ -139,6 +139,8 @@ void PGF::DoState(PointerWrap &p) {
 		if (fontData) {
 			delete [] fontData;
 		}
+		decodedGlyphs_.clear();
+		decodedGlyphBytes_ = 0;
 		if (fontDataSize) {
 			fontData = new u8[fontDataSize];
 			p.DoArray(fontData, (int)fontDataSize);
@@ -272,6 +274,8 @@ bool PGF::ReadPtr(const u8 *ptr, size_t dataSize) {
 	fontDataSize = dataSize - fontDataOffset;
 	fontData = new u8[fontDataSize];
 	memcpy(fontData, uptr, fontDataSize);
+	decodedGlyphs_.clear();
+	decodedGlyphBytes_ = 0;
 
 	// charmap.resize();
 	charmap.resize(header.charMapLength);
@@ -552,6 +556,54 @@ bool PGF::GetCharGlyph(int charCode, int glyphType, Glyph &glyph) const {
 	return true;
 }
 
+const std::vector<u8> &PGF::GetDecodedGlyphPixels(const Glyph &glyph) const {
+	auto iter = decodedGlyphs_.find(glyph.ptr);
+	if (iter != decodedGlyphs_.end()) {
+		return iter->second;
+	}
+
+	int numberPixels = glyph.w * glyph.h;
+
+	// A font's entire glyph set normally decodes to well under a megabyte, but
+	// bound the cache anyway. Dropping it wholesale is fine, it just refills.
+	static const size_t MAX_DECODED_BYTES = 4 * 1024 * 1024;
+	if (decodedGlyphBytes_ + numberPixels > MAX_DECODED_BYTES) {
+		decodedGlyphs_.clear();
+		decodedGlyphBytes_ = 0;
+	}
+
+	std::vector<u8> &decodedPixels = decodedGlyphs_[glyph.ptr];
+	decodedPixels.resize(numberPixels);
+	decodedGlyphBytes_ += numberPixels;
+
+	size_t bitPtr = glyph.ptr * 8;
+	int pixelIndex = 0;
+
+	while (pixelIndex < numberPixels && bitPtr + 8 < fontDataSize * 8) {
+		// This is some kind of nibble based RLE compression.
+		int nibble = consumeBits(4, fontData, bitPtr);
+
+		int count;
+		int value = 0;
+		if (nibble < 8) {
+			value = consumeBits(4, fontData, bitPtr);
+			count = nibble + 1;
+		} else {
+			count = 16 - nibble;
+		}
+
+		for (int i = 0; i < count && pixelIndex < numberPixels; i++) {
+			if (nibble >= 8) {
+				value = consumeBits(4, fontData, bitPtr);
+			}
+
+			decodedPixels[pixelIndex++] = value | (value << 4);
+		}
+	}
+
+	return decodedPixels;
+}
+
 void PGF::DrawCharacter(const GlyphImage *image, int clipX, int clipY, int clipWidth, int clipHeight, int charCode, int altCharCode, int glyphType) const {
 	Glyph glyph;
 	if (!GetCharGlyph(charCode, glyphType, glyph)) {
@@ -577,10 +629,6 @@ void PGF::DrawCharacter(const GlyphImage *image, int clipX, int clipY, int clipW
 		return;
 	}
 
-	size_t bitPtr = glyph.ptr * 8;
-	int numberPixels = glyph.w * glyph.h;
-	int pixelIndex = 0;
-
 	int x = image->xPos64 >> 6;
 	int y = image->yPos64 >> 6;
 	u8 xFrac = image->xPos64 & 0x3F;
@@ -596,32 +644,9 @@ void PGF::DrawCharacter(const GlyphImage *image, int clipX, int clipY, int clipW
 	if (clipHeight < 0)
 		clipHeight = 8192;
 
-	// Use a buffer so we can apply subpixel rendering.
-	// TODO: Cache this buffer per glyph?  Maybe even transpose it first?
-	std::vector<u8> decodedPixels;
-	decodedPixels.resize(numberPixels);
-
-	while (pixelIndex < numberPixels && bitPtr + 8 < fontDataSize * 8) {
-		// This is some kind of nibble based RLE compression.
-		int nibble = consumeBits(4, fontData, bitPtr);
-
-		int count;
-		int value = 0;
-		if (nibble < 8) {
-			value = consumeBits(4, fontData, bitPtr);
-			count = nibble + 1;
-		} else {
-			count = 16 - nibble;
-		}
-
-		for (int i = 0; i < count && pixelIndex < numberPixels; i++) {
-			if (nibble >= 8) {
-				value = consumeBits(4, fontData, bitPtr);
-			}
-
-			decodedPixels[pixelIndex++] = value | (value << 4);
-		}
-	}
+	// The decode is the expensive part of repeat draws, so it's cached. The blit
+	// below can't be - it depends on the target format, position and fracs.
+	const std::vector<u8> &decodedPixels = GetDecodedGlyphPixels(glyph);
 
 	auto samplePixel = [&](int xx, int yy) -> u8 {
 		if (xx < 0 || yy < 0 || xx >= glyph.w || yy >= glyph.h) {
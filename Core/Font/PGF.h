@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -283,6 +284,8 @@ private:
 
 	void SetFontPixel(u32 base, int bpl, int bufWidth, int bufHeight, int x, int y, u8 pixelColor, FontPixelFormat pixelformat) const;
 
+	const std::vector<u8> &GetDecodedGlyphPixels(const Glyph &glyph) const;
+
 	PGFHeaderRev3Extra rev3extra;
 
 	// Font character image data
@@ -306,4 +309,10 @@ private:
 	std::vector<Glyph> glyphs;
 	std::vector<Glyph> shadowGlyphs;
 	int firstGlyph;
+
+	// Decoded glyph bitmaps, so repeat draws only pay for the RLE decode once.
+	// Keyed by the glyph's bitmap offset, which also dedupes glyphs sharing
+	// bitmap data. Derived from fontData, so not included in savestates.
+	mutable std::map<u32, std::vector<u8>> decodedGlyphs_;
+	mutable size_t decodedGlyphBytes_;
 };
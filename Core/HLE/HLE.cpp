@@ -506,11 +506,26 @@ void *GetQuickSyscallFunc(MIPSOpcode op) {
 	// TODO: Do this with a flag?
 	if (op == idleOp)
 		return (void *)info->func;
-	if (info->flags != 0)
+	if ((info->flags & ~HLE_SPECIAL_JIT_MASK) != 0)
 		return (void *)&CallSyscallWithFlags;
 	return (void *)&CallSyscallWithoutFlags;
 }
 
+HLEFunc GetSimpleSyscallFunc(MIPSOpcode op) {
+	if (coreCollectDebugStats)
+		return nullptr;
+
+	const HLEFunction *info = GetSyscallFuncPointer(op);
+	if (!info || !info->func)
+		return nullptr;
+	if ((info->flags & HLE_SPECIAL_JIT_MASK) != HLE_SPECIAL_JIT_SIMPLE)
+		return nullptr;
+	// Any other flag (e.g. HLE_NOT_IN_INTERRUPT) needs the checks in the full call path.
+	if ((info->flags & ~HLE_SPECIAL_JIT_MASK) != 0)
+		return nullptr;
+	return info->func;
+}
+
 static double hleSteppingTime = 0.0;
 void hleSetSteppingTime(double t)
 {
@@ -535,7 +550,7 @@ void CallSyscall(MIPSOpcode op)
 	if (info->func) {
 		if (op == idleOp)
 			info->func();
-		else if (info->flags != 0)
+		else if ((info->flags & ~HLE_SPECIAL_JIT_MASK) != 0)
 			CallSyscallWithFlags(info);
 		else
 			CallSyscallWithoutFlags(info);
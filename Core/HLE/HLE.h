@@ -28,7 +28,13 @@ typedef void (* HLEFunc)();
 
 enum {
 	// The low 8 bits are a value, indicating special jit handling.
-	// Currently there are none.
+	// The handler's only effects are its return value, eating cycles, and
+	// possibly writing results to guest memory - no waits, reschedules, or
+	// other kernel state changes. The jit can call it in the middle of a
+	// block without a full syscall exit.
+	HLE_SPECIAL_JIT_SIMPLE = 1,
+	// Mask to extract the special jit handling value.
+	HLE_SPECIAL_JIT_MASK = 0xFF,
 
 	// The remaining 24 bits are flags.
 	// Don't allow the call within an interrupt.  Not yet implemented.
@@ -147,6 +153,8 @@ void WriteFuncMissingStub(u32 stubAddr, u32 nid);
 const HLEFunction *GetSyscallFuncPointer(MIPSOpcode op);
 // For jit, takes arg: const HLEFunction *
 void *GetQuickSyscallFunc(MIPSOpcode op);
+// For jit, the handler itself if marked HLE_SPECIAL_JIT_SIMPLE, else nullptr.
+HLEFunc GetSimpleSyscallFunc(MIPSOpcode op);
 
 void hleDoLogInternal(LogTypes::LOG_TYPE t, LogTypes::LOG_LEVELS level, u64 res, const char *file, int line, const char *reportTag, char retmask, const char *reason, const char *formatted_reason);
 
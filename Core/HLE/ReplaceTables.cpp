@@ -37,9 +37,13 @@
 #include "GPU/GPUInterface.h"
 #include "GPU/GPUState.h"
 
+#include "ppsspp_config.h"
 #if defined(_M_IX86) || defined(_M_X64)
 #include <emmintrin.h>
 #endif
+#if PPSSPP_ARCH(ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 enum class GPUReplacementSkip {
 	MEMSET = 1,
@@ -113,6 +117,19 @@ static int Replace_ceilf() {
 	return 30;  // guess number of cycles
 }
 
+// The overlap and swizzle paths below copy in open-coded 16-byte blocks, so
+// libc never gets a chance to vectorize them - do it with vector registers
+// where we have them.
+static inline void Copy16(u8 *dst, const u8 *src) {
+#if defined(_M_IX86) || defined(_M_X64)
+	_mm_storeu_si128((__m128i *)dst, _mm_loadu_si128((const __m128i *)src));
+#elif PPSSPP_ARCH(ARM_NEON)
+	vst1q_u8(dst, vld1q_u8(src));
+#else
+	memcpy(dst, src, 16);
+#endif
+}
+
 // Should probably do JIT versions of this, possibly ones that only delegate
 // large copies to a C function.
 static int Replace_memcpy() {
@@ -142,7 +159,7 @@ static int Replace_memcpy() {
 			// Overlap.  Star Ocean breaks if it's not handled in 16 bytes blocks.
 			const u32 blocks = bytes & ~0x0f;
 			for (u32 offset = 0; offset < blocks; offset += 0x10) {
-				memcpy(dst + offset, src + offset, 0x10);
+				Copy16(dst + offset, src + offset);
 			}
 			for (u32 offset = blocks; offset < bytes; ++offset) {
 				dst[offset] = src[offset];
@@ -179,8 +196,12 @@ static int Replace_memcpy_jak() {
 		const u8 *src = Memory::GetPointer(srcPtr);
 
 		if (!dst || !src) {
+		} else if (destPtr <= srcPtr || destPtr >= srcPtr + bytes) {
+			// No forward overlap - the byte loop degenerates to a plain copy,
+			// so let libc do it with full-width accesses.
+			memmove(dst, src, bytes);
 		} else {
-			// Jak style overlap.
+			// Jak style overlap - the game relies on the byte-at-a-time smear.
 			for (u32 i = 0; i < bytes; i++) {
 				dst[i] = src[i];
 			}
@@ -249,7 +270,7 @@ static int Replace_memcpy_swizzled() {
 			for (u32 x = 0; x < pitch; x += 16) {
 				const u8 *src = xsrcp;
 				for (int n = 0; n < 8; ++n) {
-					memcpy(dstp, src, 16);
+					Copy16(dstp, src);
 					src += pitch;
 					dstp += 16;
 				}
@@ -401,6 +422,46 @@ static int Replace_strncmp() {
 	return 10 + bytes / 4;  // approximation
 }
 
+// PSP wchar_t is 16-bit, so we can't lean on the host's wide string functions.
+static int Replace_wcslen() {
+	u32 srcPtr = PARAM(0);
+	const u16 *src = (const u16 *)Memory::GetPointer(srcPtr);
+	u32 len = 0;
+	if (src) {
+		while (src[len] != 0)
+			len++;
+	}
+	RETURN(len);
+	return 7 + len * 4;  // approximation
+}
+
+static int Replace_wcscpy() {
+	u32 destPtr = PARAM(0);
+	u16 *dst = (u16 *)Memory::GetPointer(destPtr);
+	const u16 *src = (const u16 *)Memory::GetPointer(PARAM(1));
+	if (dst && src) {
+		while ((*dst++ = *src++) != 0)
+			;
+	}
+	RETURN(destPtr);
+	return 10;  // approximation
+}
+
+static int Replace_wcscmp() {
+	const u16 *a = (const u16 *)Memory::GetPointer(PARAM(0));
+	const u16 *b = (const u16 *)Memory::GetPointer(PARAM(1));
+	if (a && b) {
+		while (*a != 0 && *a == *b) {
+			a++;
+			b++;
+		}
+		RETURN((s32)*a - (s32)*b);
+	} else {
+		RETURN(0);
+	}
+	return 10;  // approximation
+}
+
 static int Replace_fabsf() {
 	RETURNF(fabsf(PARAMF(0)));
 	return 4;
@@ -1264,6 +1325,9 @@ static const ReplacementTableEntry entries[] = {
 	{ "strncpy", &Replace_strncpy, 0, REPFLAG_DISABLED },
 	{ "strcmp", &Replace_strcmp, 0, REPFLAG_DISABLED },
 	{ "strncmp", &Replace_strncmp, 0, REPFLAG_DISABLED },
+	{ "wcslen", &Replace_wcslen, 0, REPFLAG_DISABLED },
+	{ "wcscpy", &Replace_wcscpy, 0, REPFLAG_DISABLED },
+	{ "wcscmp", &Replace_wcscmp, 0, REPFLAG_DISABLED },
 	{ "fabsf", &Replace_fabsf, JITFUNC(Replace_fabsf), REPFLAG_ALLOWINLINE | REPFLAG_DISABLED },
 	{ "dl_write_matrix", &Replace_dl_write_matrix, 0, REPFLAG_DISABLED }, // &MIPSComp::Jit::Replace_dl_write_matrix, REPFLAG_DISABLED },
 	{ "dl_write_matrix_2", &Replace_dl_write_matrix, 0, REPFLAG_DISABLED },
@@ -15,9 +15,6 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
-#include <atomic>
-#include <mutex>
-
 #include "Common/CommonTypes.h"
 #include "Common/ChunkFile.h"
 #include "Common/FixedSizeQueue.h"
@@ -49,10 +46,6 @@
 StereoResampler resampler;
 AudioDebugStats g_AudioDebugStats;
 
-// Should be used to lock anything related to the outAudioQueue.
-// atomic locks are used on the lock. TODO: make this lock-free
-std::atomic_flag atomicLock_;
-
 enum latency {
 	LOW_LATENCY = 0,
 	MEDIUM_LATENCY = 1,
@@ -358,22 +351,14 @@ void __AudioUpdate(bool resetRecording) {
 		chans[i].sampleQueue.popPointers(hwBlockSize * 2, &buf1, &sz1, &buf2, &sz2);
 
 		if (firstChannel) {
-			for (size_t s = 0; s < sz1; s++)
-				mixBuffer[s] = buf1[s];
-			if (buf2) {
-				for (size_t s = 0; s < sz2; s++)
-					mixBuffer[s + sz1] = buf2[s];
-			}
+			ConvertS16ToS32(mixBuffer, buf1, sz1);
+			if (buf2)
+				ConvertS16ToS32(mixBuffer + sz1, buf2, sz2);
 			firstChannel = false;
 		} else {
-			// Surprisingly hard to SIMD efficiently on SSE2 due to lack of 16-to-32-bit sign extension. NEON should be straight-forward though, and SSE4.1 can do it nicely.
-			// Actually, the cmple/pack trick should work fine...
-			for (size_t s = 0; s < sz1; s++)
-				mixBuffer[s] += buf1[s];
-			if (buf2) {
-				for (size_t s = 0; s < sz2; s++)
-					mixBuffer[s + sz1] += buf2[s];
-			}
+			AccumulateS16ToS32(mixBuffer, buf1, sz1);
+			if (buf2)
+				AccumulateS16ToS32(mixBuffer + sz1, buf2, sz2);
 		}
 	}
 
@@ -409,9 +394,7 @@ void __AudioUpdate(bool resetRecording) {
 			}
 		} else {
 			if (g_Config.bDumpAudio) {
-				for (int i = 0; i < hwBlockSize * 2; i++) {
-					clampedMixBuffer[i] = clamp_s16(mixBuffer[i]);
-				}
+				ClampS32ToS16(clampedMixBuffer, mixBuffer, hwBlockSize * 2);
 				g_wave_writer.AddStereoSamples(clampedMixBuffer, hwBlockSize);
 			} else {
 				__StopLogAudio();
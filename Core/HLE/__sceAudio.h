@@ -27,6 +27,7 @@ struct AudioDebugStats {
 	int overrunCount;
 	int instantSampleRate;
 	int lastPushSize;
+	int latencyMs;
 };
 
 // Easy interface for sceAudio to write to, to keep the complexity in check.
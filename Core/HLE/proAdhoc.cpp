@@ -1033,6 +1033,7 @@ int friendFinder(){
 
 		// Wait for Incoming Data
 		int received = recv(metasocket, (char *)(rx + rxpos), sizeof(rx) - rxpos, 0);
+		int rxposBeforeHandling = rxpos;
 
 		// Free Network Lock
 		//_freeNetworkLock();
@@ -1242,8 +1243,20 @@ int friendFinder(){
 				rxpos -= 1;
 			}
 		}
-		// Original value was 10 ms, I think 100 is just fine
-		sleep_ms(1); // Using 1ms for faster response just like AdhocServer
+		// Only sleep when out of work: nothing new arrived and no packet was
+		// consumed above (a consumed packet can leave another one in the
+		// buffer.) Blocking in select() instead of a fixed 1ms poll wakes us
+		// the moment the server sends and costs nothing while idle - with many
+		// instances on one host the polling loops were real CPU.
+		if (received <= 0 && rxpos == rxposBeforeHandling) {
+			fd_set readfds;
+			FD_ZERO(&readfds);
+			FD_SET(metasocket, &readfds);
+			timeval timeout;
+			timeout.tv_sec = 0;
+			timeout.tv_usec = 10000;  // Short cap so pings and shutdown stay timely.
+			select(metasocket + 1, &readfds, NULL, NULL, &timeout);
+		}
 
 		// Don't do anything if it's paused, otherwise the log will be flooded
 		while (Core_IsStepping() && friendFinderRunning) sleep_ms(1);
@@ -1404,6 +1417,10 @@ int initNetwork(SceNetAdhocctlAdhocId *adhoc_id){
 		ERROR_LOG(SCENET, "Invalid socket");
 		return -1;
 	}
+	// The adhocctl control channel is all tiny packets - disable Nagle so they
+	// aren't held back in the kernel, which matters most against the built-in
+	// server on loopback.
+	setsockopt(metasocket, IPPROTO_TCP, TCP_NODELAY, (const char *)&one, sizeof(one));
 	struct sockaddr_in server_addr;
 	server_addr.sin_family = AF_INET;
 	server_addr.sin_port = htons(SERVER_PORT); //27312 // Maybe read this from config too
@@ -36,7 +36,9 @@
 #include <WS2tcpip.h>
 #else
 #include <sys/socket.h>
+#include <sys/select.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #endif
 
 #include <fcntl.h>
@@ -472,6 +474,7 @@ const char * strcpyxml(char * out, const char * in, uint32_t size);
 // Function Prototypes
 void interrupt(int sig);
 void enable_address_reuse(int fd);
+void enable_no_delay(int fd);
 void change_blocking_mode(int fd, int nonblocking);
 int create_listen_socket(uint16_t port);
 int server_loop(int server);
@@ -1726,6 +1729,20 @@ void enable_address_reuse(int fd)
 	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, (const char*)&on, sizeof(on));
 }
 
+/**
+ * Disable Nagle Algorithm on Socket
+ * @param fd Socket
+ */
+void enable_no_delay(int fd)
+{
+	// Enable Value
+	int on = 1;
+
+	// Disable Send Coalescing - everything on this Stream is tiny Control
+	// Packets, delaying them only hurts
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (const char*)&on, sizeof(on));
+}
+
 /**
  * Change Socket Blocking Mode
  * @param fd Socket
@@ -1852,6 +1869,9 @@ int server_loop(int server)
 				{
 					// Switch Socket into Non-Blocking Mode
 					change_blocking_mode(loginresult, 1);
+
+					// Disable Nagle Algorithm
+					enable_no_delay(loginresult);
 				}
 
 				// Login User (Stream)
@@ -2021,8 +2041,24 @@ int server_loop(int server)
 			user = next;
 		}
 
-		// Prevent needless CPU Overload (1ms Sleep)
-		sleep_ms(1);
+		// Wait for Activity instead of a fixed 1ms Poll - wakes instantly on
+		// new Connections or Data and idles quietly otherwise, which matters
+		// when several Instances run their own built-in Server Threads
+		{
+			fd_set readfds;
+			FD_ZERO(&readfds);
+			FD_SET(server, &readfds);
+			int maxfd = server;
+			for (SceNetAdhocctlUserNode * waituser = _db_user; waituser != NULL; waituser = waituser->next)
+			{
+				FD_SET(waituser->stream, &readfds);
+				if (waituser->stream > maxfd) maxfd = waituser->stream;
+			}
+			timeval timeout;
+			timeout.tv_sec = 0;
+			timeout.tv_usec = 10000; // Short Cap so Timeout and Shutdown Checks stay timely
+			select(maxfd + 1, &readfds, NULL, NULL, &timeout);
+		}
 
 		// Don't do anything if it's paused, otherwise the log will be flooded
 		while (adhocServerRunning && Core_IsStepping()) sleep_ms(1);
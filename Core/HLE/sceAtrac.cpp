@@ -1137,6 +1137,13 @@ static u32 sceAtracAddStreamData(int atracID, u32 bytesToAdd) {
 	return hleLogSuccessI(ME, 0);
 }
 
+// Note: decoding happens synchronously in the syscall on purpose, even though it shows
+// up in profiles. The codec state is part of the emulated state: games may seek, loop,
+// or add stream data between any two decode calls, and savestates serialize mid-stream.
+// Decoding ahead on a worker would require joining and discarding the speculative frame
+// on every context-mutating syscall, and FFmpeg can't snapshot/restore codec state to
+// make the discard cheap. If this ever becomes a real problem, the whole context would
+// need the sceSas treatment (a dedicated thread owning all of its state).
 u32 _AtracDecodeData(int atracID, u8 *outbuf, u32 outbufPtr, u32 *SamplesNum, u32 *finish, int *remains) {
 	Atrac *atrac = getAtrac(atracID);
 
@@ -20,6 +20,7 @@
 
 #include "Core/HLE/HLE.h"
 #include "Core/HLE/FunctionWrappers.h"
+#include "Core/Config.h"
 #include "Core/MIPS/MIPS.h"
 #include "Core/CoreTiming.h"
 #include "Core/MemMapHelpers.h"
@@ -218,6 +219,44 @@ static int __CtrlReadSingleBuffer(PSPPointer<CtrlData> data, bool negative)
 	return 0;
 }
 
+// Like __CtrlUpdateLatch(), but only produces a sample from the current input
+// state without touching the buffers or the latch - those stay on the normal
+// per-vblank cadence.
+static void __CtrlSampleLatest(CtrlData *sample)
+{
+	std::lock_guard<std::mutex> guard(ctrlMutex);
+	u64 t = CoreTiming::GetGlobalTimeUs();
+
+	u32 buttons = ctrlCurrent.buttons;
+	if (emuRapidFire && (emuRapidFireFrames % 10) < 5)
+		buttons &= CTRL_EMU_RAPIDFIRE_MASK;
+
+	ReplayApplyCtrl(buttons, ctrlCurrent.analog, t);
+
+	*sample = ctrlCurrent;
+	sample->buttons = buttons;
+	sample->frame = (u32)t;
+	if (!analogEnabled)
+		memset(sample->analog, CTRL_ANALOG_CENTER, sizeof(sample->analog));
+}
+
+static int __CtrlReadLatestBuffer(PSPPointer<CtrlData> data, bool negative)
+{
+	if (data.IsValid())
+	{
+		__CtrlSampleLatest(&*data);
+		ctrlBufRead = (ctrlBufRead + 1) % NUM_CTRL_BUFFERS;
+
+		data->buttons &= CTRL_MASK_USER;
+		if (negative)
+			data->buttons = ~data->buttons;
+
+		return 1;
+	}
+
+	return 0;
+}
+
 static int __CtrlReadBuffer(u32 ctrlDataPtr, u32 nBufs, bool negative, bool peek)
 {
 	if (nBufs > NUM_CTRL_BUFFERS)
@@ -242,10 +281,19 @@ static int __CtrlReadBuffer(u32 ctrlDataPtr, u32 nBufs, bool negative, bool peek
 	}
 	ctrlBufRead = (ctrlBuf - availBufs + NUM_CTRL_BUFFERS) % NUM_CTRL_BUFFERS;
 
+	// In low latency mode, the newest sample returned reflects the input state
+	// right now rather than at the last vblank, so mid-frame polls see fresh
+	// input. Wait and latch behavior is unchanged.
+	const bool sampleLatest = g_Config.bLowLatencyInput;
+
 	int done = 0;
 	auto data = PSPPointer<CtrlData>::Create(ctrlDataPtr);
-	for (u32 i = 0; i < availBufs; ++i)
-		done += __CtrlReadSingleBuffer(data++, negative);
+	for (u32 i = 0; i < availBufs; ++i) {
+		if (sampleLatest && i == availBufs - 1)
+			done += __CtrlReadLatestBuffer(data++, negative);
+		else
+			done += __CtrlReadSingleBuffer(data++, negative);
+	}
 
 	if (peek)
 		ctrlBufRead = resetRead;
@@ -19,6 +19,7 @@
 #include <map>
 #include <cmath>
 #include <algorithm>
+#include <thread>
 
 // TODO: Move this somewhere else, cleanup.
 #ifndef _WIN32
@@ -49,6 +50,8 @@
 #include "Core/HLE/sceKernel.h"
 #include "Core/HLE/sceKernelThread.h"
 #include "Core/HLE/sceKernelInterrupt.h"
+#include "Core/HLE/scePower.h"
+#include "Core/MIPS/JitCommon/JitCompileQueue.h"
 
 #include "GPU/GPU.h"
 #include "GPU/GPUState.h"
@@ -520,6 +523,96 @@ static int CalculateFrameSkip() {
 	return frameSkipNum;
 }
 
+// Dynamic resolution: watch how much of the frame budget the frame actually
+// used and cap the render zoom factor to hold full speed. We don't have GPU
+// timestamp queries in the backends, but on the platforms this matters for
+// (GLES phones) submission blocks on the same thread the limiter runs on, so
+// the slack before the frame wait is an honest fullness signal. Backing off
+// is quick, climbing back is slow, and changes are followed by a cooldown -
+// resolution flicker looks worse than a moment of blur.
+static int dynResOverBudget = 0;
+static int dynResUnderBudget = 0;
+static int dynResCooldown = 0;
+
+static void UpdateDynamicResolution(double budget, double slack) {
+	int maxZoom = g_Config.iInternalResolution;
+	if (maxZoom == 0) {
+		// Auto mode - same derivation as FramebufferManagerCommon::Resized().
+		if (!g_Config.IsPortrait()) {
+			maxZoom = (PSP_CoreParameter().pixelWidth + 479) / 480;
+		} else {
+			maxZoom = (PSP_CoreParameter().pixelHeight + 479) / 480;
+		}
+	}
+	if (maxZoom <= 1) {
+		return;
+	}
+
+	if (dynResCooldown > 0) {
+		dynResCooldown--;
+		return;
+	}
+
+	int cap = PSP_CoreParameter().dynamicResZoomCap;
+	int curZoom = (cap > 0 && cap < maxZoom) ? cap : maxZoom;
+
+	if (slack < budget * 0.05) {
+		dynResOverBudget++;
+		dynResUnderBudget = 0;
+	} else if (slack > budget * 0.5) {
+		dynResUnderBudget++;
+		dynResOverBudget = 0;
+	} else {
+		dynResOverBudget = 0;
+		dynResUnderBudget = 0;
+	}
+
+	int newZoom = curZoom;
+	if (dynResOverBudget >= 15 && curZoom > 1) {
+		newZoom = curZoom - 1;
+	} else if (dynResUnderBudget >= 180 && curZoom < maxZoom) {
+		newZoom = curZoom + 1;
+	}
+	if (newZoom != curZoom) {
+		NOTICE_LOG(SCEDISPLAY, "Dynamic resolution: render zoom now %dx (max %dx)", newZoom, maxZoom);
+		PSP_CoreParameter().dynamicResZoomCap = newZoom == maxZoom ? 0 : newZoom;
+		dynResOverBudget = 0;
+		dynResUnderBudget = 0;
+		dynResCooldown = 60;
+		if (gpu) {
+			gpu->Resized();
+		}
+	}
+}
+
+// Waits precisely until the given time (in time_now_d() terms.)
+// Sleeps in coarse chunks while there's slack, then finishes the last couple
+// of milliseconds with yields. A plain sleep_ms(1) loop can overshoot by a
+// whole timer tick, which reads as judder on hosts where the per-frame margin
+// is small (90/120Hz phones especially.)
+static void WaitUntil(double goal) {
+	time_update();
+	double now = time_now_d();
+	while (now < goal) {
+		const double left = goal - now;
+		if (left > 0.002) {
+			// Leave the last 2ms to the precise part below - coarse timers
+			// can overshoot a sleep by a tick.
+#ifdef _WIN32
+			sleep_ms(1);
+#else
+			usleep((long)((left - 0.002) * 1000000));
+#endif
+		} else {
+			// Near the deadline, burn the remainder in yields. Precise, and
+			// only ever pegs the core for a moment.
+			std::this_thread::yield();
+		}
+		time_update();
+		now = time_now_d();
+	}
+}
+
 // Let's collect all the throttling and frameskipping logic here.
 static void DoFrameTiming(bool &throttle, bool &skipFrame, float timestep) {
 	PROFILE_THIS_SCOPE("timing");
@@ -585,21 +678,25 @@ static void DoFrameTiming(bool &throttle, bool &skipFrame, float timestep) {
 			skipFrame = true;
 	}
 
+	if (throttle && !wasPaused) {
+		if (g_Config.bDynamicResolution) {
+			UpdateDynamicResolution(scaledTimestep, nextFrameTime - curFrameTime);
+		} else if (PSP_CoreParameter().dynamicResZoomCap != 0) {
+			// Turned off mid-game, put the resolution back.
+			PSP_CoreParameter().dynamicResZoomCap = 0;
+			if (gpu) {
+				gpu->Resized();
+			}
+		}
+	}
+
 	if (curFrameTime < nextFrameTime && throttle) {
 		// If time gap is huge just jump (somebody unthrottled)
 		if (nextFrameTime - curFrameTime > 2*scaledTimestep) {
 			nextFrameTime = curFrameTime;
 		} else {
 			// Wait until we've caught up.
-			while (time_now_d() < nextFrameTime) {
-#ifdef _WIN32
-				sleep_ms(1); // Sleep for 1ms on this thread
-#else
-				const double left = nextFrameTime - curFrameTime;
-				usleep((long)(left * 1000000));
-#endif
-				time_update();
-			}
+			WaitUntil(nextFrameTime);
 		}
 		curFrameTime = time_now_d();
 	}
@@ -635,15 +732,7 @@ static void DoFrameIdleTiming() {
 	// Give a little extra wiggle room in case the next vblank does more work.
 	const double goal = lastFrameTime + (numVBlanksSinceFlip - 1) * scaledVblank - 0.001;
 	if (numVBlanksSinceFlip >= 2 && time_now_d() < goal) {
-		while (time_now_d() < goal) {
-#ifdef _WIN32
-			sleep_ms(1);
-#else
-			const double left = goal - time_now_d();
-			usleep((long)(left * 1000000));
-#endif
-			time_update();
-		}
+		WaitUntil(goal);
 	}
 }
 
@@ -687,6 +776,14 @@ void hleEnterVblank(u64 userdata, int cyclesLate) {
 	numVBlanks++;
 	numVBlanksSinceFlip++;
 
+	// Let scePower underclock adaptively based on how much of the last vblank
+	// was spent idling.
+	__PowerVblankIdleUpdate();
+
+	// Good spot to compile a few speculatively queued blocks - we're between
+	// frames and the jit is idle.
+	MIPSComp::DrainPrecompileQueue();
+
 	// TODO: Should this be done here or in hleLeaveVblank?
 	if (framebufIsLatched) {
 		DEBUG_LOG(SCEDISPLAY, "Setting latched framebuffer %08x (prev: %08x)", latchedFramebuf.topaddr, framebuf.topaddr);
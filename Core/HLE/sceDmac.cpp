@@ -49,8 +49,15 @@ static int __DmacMemcpy(u32 dst, u32 src, u32 size) {
 		skip = gpu->PerformMemoryCopy(dst, src, size);
 	}
 	if (!skip) {
-		Memory::Memcpy(dst, Memory::GetPointer(src), size);
-		currentMIPS->InvalidateICache(dst, size);
+		// The caller already validated both ranges, so skip the per-pointer checks
+		// Memory::Memcpy would redo and go straight to one big copy - games
+		// commonly stream large aligned buffers through here.
+		memcpy(Memory::GetPointerUnchecked(dst), Memory::GetPointerUnchecked(src), size);
+		CBreakPoints::ExecMemCheck(src, false, size, currentMIPS->pc);
+		CBreakPoints::ExecMemCheck(dst, true, size, currentMIPS->pc);
+		// VRAM can't hold code, no point walking the jit block map for it.
+		if (!Memory::IsVRAMAddress(dst))
+			currentMIPS->InvalidateICache(dst, size);
 	}
 
 	// This number seems strangely reproducible.
@@ -357,6 +357,13 @@ static void __IoAsyncNotify(u64 userdata, int cyclesLate) {
 		}
 		__IoCompleteAsyncIO(f);
 	} else if (ioTimingMethod == IOTIMING_REALISTIC) {
+		if (!ioManager.HasResult(f->handle) && ioManager.HasOperation(f->handle)) {
+			// The host hasn't delivered the data yet - keep emulating rather
+			// than blocking the emulated clock on it.  Normally the realistic
+			// finish time below is still in the future when the result lands.
+			CoreTiming::ScheduleEvent(usToCycles(500) - cyclesLate, asyncNotifyEvent, userdata);
+			return;
+		}
 		u64 finishTicks = __IoCompleteAsyncIO(f);
 		if (finishTicks > CoreTiming::GetTicks()) {
 			// Reschedule for later, since we now know how long it ought to take.
@@ -413,6 +420,13 @@ static void __IoSyncNotify(u64 userdata, int cyclesLate) {
 			return;
 		}
 	} else if (ioTimingMethod == IOTIMING_REALISTIC) {
+		if (!ioManager.HasResult(f->handle) && ioManager.HasOperation(f->handle)) {
+			// The host hasn't delivered the data yet - keep emulating rather
+			// than blocking the emulated clock on it.  Normally the realistic
+			// finish time below is still in the future when the result lands.
+			CoreTiming::ScheduleEvent(usToCycles(500) - cyclesLate, syncNotifyEvent, userdata);
+			return;
+		}
 		u64 finishTicks = ioManager.ResultFinishTicks(f->handle);
 		if (finishTicks > CoreTiming::GetTicks()) {
 			// Reschedule for later when the result should finish.
@@ -906,16 +920,22 @@ static bool __IoRead(int &result, int id, u32 data_addr, int size, int &us) {
 		} else if (size < 0) {
 			result = SCE_KERNEL_ERROR_ILLEGAL_ADDR;
 			return true;
-		} else if (Memory::IsValidAddress(data_addr)) {
+		}
+
+		// Validate the buffer once - we read directly into game memory, so the
+		// clamped size makes sure we can't overrun it.
+		const Memory::ValidRange dataRange = Memory::GetValidRange(data_addr, size);
+		if (dataRange.IsValid()) {
 			CBreakPoints::ExecMemCheck(data_addr, true, size, currentMIPS->pc);
-			u8 *data = (u8*) Memory::GetPointer(data_addr);
+			const u32 validSize = dataRange.size;
+			u8 *data = dataRange.ptr;
 			if (f->npdrm) {
-				result = npdrmRead(f, data, size);
-				currentMIPS->InvalidateICache(data_addr, size);
+				result = npdrmRead(f, data, validSize);
+				currentMIPS->InvalidateICache(data_addr, validSize);
 				return true;
 			}
 
-			bool useThread = __KernelIsDispatchEnabled() && ioManagerThreadEnabled && size > IO_THREAD_MIN_DATA_SIZE;
+			bool useThread = __KernelIsDispatchEnabled() && ioManagerThreadEnabled && validSize > IO_THREAD_MIN_DATA_SIZE;
 			if (useThread) {
 				// If there's a pending operation on this file, wait for it to finish and don't overwrite it.
 				useThread = !ioManager.HasOperation(f->handle);
@@ -927,17 +947,17 @@ static bool __IoRead(int &result, int id, u32 data_addr, int size, int &us) {
 				AsyncIOEvent ev = IO_EVENT_READ;
 				ev.handle = f->handle;
 				ev.buf = data;
-				ev.bytes = size;
+				ev.bytes = validSize;
 				ev.invalidateAddr = data_addr;
 				ioManager.ScheduleOperation(ev);
 				return false;
 			} else {
 				if (GetIOTimingMethod() != IOTIMING_REALISTIC) {
-					result = (int) pspFileSystem.ReadFile(f->handle, data, size);
+					result = (int) pspFileSystem.ReadFile(f->handle, data, validSize);
 				} else {
-					result = (int) pspFileSystem.ReadFile(f->handle, data, size, us);
+					result = (int) pspFileSystem.ReadFile(f->handle, data, validSize, us);
 				}
-				currentMIPS->InvalidateICache(data_addr, size);
+				currentMIPS->InvalidateICache(data_addr, validSize);
 				return true;
 			}
 		} else {
@@ -1023,7 +1043,11 @@ static bool __IoWrite(int &result, int id, u32 data_addr, int size, int &us) {
 		us = 100;
 	}
 
-	const void *data_ptr = Memory::GetPointer(data_addr);
+	// Validate the buffer once - the stdout shortcut and the real write path
+	// below both reuse the host pointer, and the clamped size makes sure we
+	// can't read past the end of game memory.
+	const Memory::ValidRange dataRange = Memory::GetValidRange(data_addr, size);
+	const void *data_ptr = dataRange.ptr;
 	// Let's handle stdout/stderr specially.
 	if (id == PSP_STDOUT || id == PSP_STDERR) {
 		const char *str = (const char *) data_ptr;
@@ -1049,8 +1073,9 @@ static bool __IoWrite(int &result, int id, u32 data_addr, int size, int &us) {
 		}
 
 		CBreakPoints::ExecMemCheck(data_addr, false, size, currentMIPS->pc);
+		const u32 validSize = dataRange.size;
 
-		bool useThread = __KernelIsDispatchEnabled() && ioManagerThreadEnabled && size > IO_THREAD_MIN_DATA_SIZE;
+		bool useThread = __KernelIsDispatchEnabled() && ioManagerThreadEnabled && validSize > IO_THREAD_MIN_DATA_SIZE;
 		if (useThread) {
 			// If there's a pending operation on this file, wait for it to finish and don't overwrite it.
 			useThread = !ioManager.HasOperation(f->handle);
@@ -1062,15 +1087,15 @@ static bool __IoWrite(int &result, int id, u32 data_addr, int size, int &us) {
 			AsyncIOEvent ev = IO_EVENT_WRITE;
 			ev.handle = f->handle;
 			ev.buf = (u8 *) data_ptr;
-			ev.bytes = size;
+			ev.bytes = validSize;
 			ev.invalidateAddr = 0;
 			ioManager.ScheduleOperation(ev);
 			return false;
 		} else {
 			if (GetIOTimingMethod() != IOTIMING_REALISTIC) {
-				result = (int) pspFileSystem.WriteFile(f->handle, (u8 *) data_ptr, size);
+				result = (int) pspFileSystem.WriteFile(f->handle, (u8 *) data_ptr, validSize);
 			} else {
-				result = (int) pspFileSystem.WriteFile(f->handle, (u8 *) data_ptr, size, us);
+				result = (int) pspFileSystem.WriteFile(f->handle, (u8 *) data_ptr, validSize, us);
 			}
 		}
 		return true;
@@ -28,17 +28,33 @@
 
 //Uncomment if you want to dump JPEGs loaded through sceJpeg to a file
 //#define JPEG_DEBUG
-#ifdef JPEG_DEBUG
 #include "ext/xxhash.h"
-#endif
 
 #include <algorithm>
+#include <vector>
 
 static int mjpegWidth, mjpegHeight;
 
+// Games typically call sceJpegGetOutputInfo and then one of the decode
+// functions on the same data, which would decompress every image twice, and
+// photo viewers re-decode a static image each frame.  Cache the last few
+// decoded images by source hash so each unique JPEG is only decompressed once.
+struct DecodedJpegImage {
+	u32 hash;
+	int jpegSize;
+	int width;
+	int height;
+	int components;
+	std::vector<u8> data;
+};
+
+static const size_t JPEG_CACHE_MAX_IMAGES = 4;
+static std::vector<DecodedJpegImage> jpegCache;
+
 void __JpegInit() {
 	mjpegWidth = 0;
 	mjpegHeight = 0;
+	jpegCache.clear();
 }
 
 void __JpegDoState(PointerWrap &p) {
@@ -48,6 +64,51 @@ void __JpegDoState(PointerWrap &p) {
 
 	p.Do(mjpegWidth);
 	p.Do(mjpegHeight);
+	// The decode cache is purely derived data, just drop it on load.
+	if (p.mode == p.MODE_READ)
+		jpegCache.clear();
+}
+
+static const u8 *__JpegDecodeCached(u32 jpegAddr, int jpegSize, int &width, int &height, int &actual_components) {
+	const u8 *buf = Memory::GetPointer(jpegAddr);
+	u32 hash = XXH32(buf, jpegSize, 0xC0108888);
+
+	for (size_t i = 0; i < jpegCache.size(); ++i) {
+		if (jpegCache[i].hash == hash && jpegCache[i].jpegSize == jpegSize) {
+			// Move to the back so the least recently used image is evicted first.
+			if (i != jpegCache.size() - 1)
+				std::rotate(jpegCache.begin() + i, jpegCache.begin() + i + 1, jpegCache.end());
+			const DecodedJpegImage &image = jpegCache.back();
+			width = image.width;
+			height = image.height;
+			actual_components = image.components;
+			return image.data.data();
+		}
+	}
+
+	unsigned char *jpegBuf = jpgd::decompress_jpeg_image_from_memory(buf, jpegSize, &width, &height, &actual_components, 3);
+	if (actual_components != 3) {
+		// The assumption that the image was RGB was wrong...
+		// Try again.
+		int components = actual_components;
+		jpegBuf = jpgd::decompress_jpeg_image_from_memory(buf, jpegSize, &width, &height, &actual_components, components);
+	}
+	if (jpegBuf == NULL) {
+		return NULL;
+	}
+
+	if (jpegCache.size() >= JPEG_CACHE_MAX_IMAGES)
+		jpegCache.erase(jpegCache.begin());
+	jpegCache.push_back(DecodedJpegImage());
+	DecodedJpegImage &image = jpegCache.back();
+	image.hash = hash;
+	image.jpegSize = jpegSize;
+	image.width = width;
+	image.height = height;
+	image.components = actual_components;
+	image.data.assign(jpegBuf, jpegBuf + width * height * actual_components);
+	free(jpegBuf);
+	return image.data.data();
 }
 
 static int getWidthHeight(int width, int height) {
@@ -121,16 +182,8 @@ static u32 convertARGBtoABGR(u32 argb) {
 }
 
 static int __DecodeJpeg(u32 jpegAddr, int jpegSize, u32 imageAddr) {
-	u8 *buf = Memory::GetPointer(jpegAddr);
 	int width, height, actual_components;
-	unsigned char *jpegBuf = jpgd::decompress_jpeg_image_from_memory(buf, jpegSize, &width, &height, &actual_components, 3);
-
-	if (actual_components != 3) {
-		// The assumption that the image was RGB was wrong...
-		// Try again.
-		int components = actual_components;
-		jpegBuf = jpgd::decompress_jpeg_image_from_memory(buf, jpegSize, &width, &height, &actual_components, components);
-	}
+	const u8 *jpegBuf = __JpegDecodeCached(jpegAddr, jpegSize, width, height, actual_components);
 
 	if (jpegBuf == NULL) {
 		return getWidthHeight(0, 0);
@@ -155,7 +208,6 @@ static int __DecodeJpeg(u32 jpegAddr, int jpegSize, u32 imageAddr) {
 			}
 	}
 
-	free(jpegBuf);
 	return getWidthHeight(width, height);
 }
 
@@ -207,24 +259,15 @@ static int getYCbCrBufferSize(int w, int h) {
 }
 
 static int __JpegGetOutputInfo(u32 jpegAddr, int jpegSize, u32 colourInfoAddr) {
-	u8 *buf = Memory::GetPointer(jpegAddr);
 	int width, height, actual_components;
-	unsigned char *jpegBuf = jpgd::decompress_jpeg_image_from_memory(buf, jpegSize, &width, &height, &actual_components, 3);
-
-	if (actual_components != 3) {
-	// The assumption that the image was RGB was wrong...
-	// Try again.
-		int components = actual_components;
-		jpegBuf = jpgd::decompress_jpeg_image_from_memory(buf, jpegSize, &width, &height, &actual_components, components);
-	}
+	const u8 *jpegBuf = __JpegDecodeCached(jpegAddr, jpegSize, width, height, actual_components);
 
 	if (jpegBuf == NULL) {
 		ERROR_LOG(ME, "sceJpegGetOutputInfo: Bad JPEG data");
 		return getYCbCrBufferSize(0, 0);
 	}
 
-	free(jpegBuf);
-	
+
 	// Buffer to store info about the color space in use.
 	// - Bits 24 to 32 (Always empty): 0x00
 	// - Bits 16 to 24 (Color mode): 0x00 (Unknown), 0x01 (Greyscale) or 0x02 (YCbCr) 
@@ -313,16 +356,8 @@ static int __JpegConvertRGBToYCbCr (const void *data, u32 bufferOutputAddr, int
 }
 
 static int __JpegDecodeMJpegYCbCr(u32 jpegAddr, int jpegSize, u32 yCbCrAddr) {
-	u8 *buf = Memory::GetPointer(jpegAddr);
 	int width, height, actual_components;
-	unsigned char *jpegBuf = jpgd::decompress_jpeg_image_from_memory(buf, jpegSize, &width, &height, &actual_components, 3);
-
-	if (actual_components != 3) {
-		// The assumption that the image was RGB was wrong...
-		// Try again.
-		int components = actual_components;
-		jpegBuf = jpgd::decompress_jpeg_image_from_memory(buf, jpegSize, &width, &height, &actual_components, components);
-	}
+	const u8 *jpegBuf = __JpegDecodeCached(jpegAddr, jpegSize, width, height, actual_components);
 
 	if (jpegBuf == NULL) {
 		return getWidthHeight(0, 0);
@@ -332,8 +367,6 @@ static int __JpegDecodeMJpegYCbCr(u32 jpegAddr, int jpegSize, u32 yCbCrAddr) {
 		__JpegConvertRGBToYCbCr(jpegBuf, yCbCrAddr, width, height);
 	}
 
-	free(jpegBuf);
-
 	// TODO: There's more...
 
 	return getWidthHeight(width, height);
@@ -15,6 +15,9 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include <cstdlib>
+#include <vector>
+
 #include "Core/Core.h"
 #include "Core/Config.h"
 #include "Core/CwCheat.h"
@@ -454,8 +457,77 @@ void KernelObject::GetQuickInfo(char *ptr, int size)
 	strcpy(ptr, "-");
 }
 
+// Kernel objects churn hard during loading screens (thousands of short-lived
+// threads), and taking each one through the process heap both scatters them
+// across memory and contends with allocations on the GPU thread. So they come
+// from size-segregated slabs instead: objects of the same size - which in
+// practice means the same type - pack together in pages, and create/delete is
+// a freelist push/pop. Pages are retained for reuse once allocated, bounded by
+// the peak number of live objects (the pool caps out at 4096 anyway). Like the
+// rest of the kernel, this all runs on the CPU thread only, so no locking.
+
+static const size_t SLAB_GRANULARITY_SHIFT = 6;  // smallest class is 64 bytes
+static const int NUM_SLAB_CLASSES = 7;           // 64 .. 4096 bytes
+static const size_t SLAB_PAGE_SIZE = 65536;
+
+struct SlabBlockHeader {
+	u32 sizeClass;  // NUM_SLAB_CLASSES means it came from the heap
+	u32 pad[3];     // keep the payload 16-byte aligned
+};
+
+static void *slabFreeLists[NUM_SLAB_CLASSES];
+static std::vector<char *> slabPages;
+
+static void *SlabAlloc(size_t size) {
+	size_t need = size + sizeof(SlabBlockHeader);
+	int c = 0;
+	while (c < NUM_SLAB_CLASSES && ((size_t)1 << (SLAB_GRANULARITY_SHIFT + c)) < need)
+		c++;
+	if (c == NUM_SLAB_CLASSES) {
+		// Oversized - shouldn't happen with the current object types, but
+		// let's not crash if someone adds a huge one.
+		SlabBlockHeader *block = (SlabBlockHeader *)malloc(need);
+		block->sizeClass = NUM_SLAB_CLASSES;
+		return block + 1;
+	}
+	if (!slabFreeLists[c]) {
+		// Carve a fresh page into blocks of this class.
+		const size_t blockSize = (size_t)1 << (SLAB_GRANULARITY_SHIFT + c);
+		char *page = new char[SLAB_PAGE_SIZE];
+		slabPages.push_back(page);
+		for (size_t off = 0; off + blockSize <= SLAB_PAGE_SIZE; off += blockSize) {
+			void *payload = page + off + sizeof(SlabBlockHeader);
+			*(void **)payload = slabFreeLists[c];
+			slabFreeLists[c] = payload;
+		}
+	}
+	void *payload = slabFreeLists[c];
+	slabFreeLists[c] = *(void **)payload;
+	((SlabBlockHeader *)payload - 1)->sizeClass = (u32)c;
+	return payload;
+}
+
+static void SlabFree(void *ptr) {
+	SlabBlockHeader *block = (SlabBlockHeader *)ptr - 1;
+	if (block->sizeClass == (u32)NUM_SLAB_CLASSES) {
+		free(block);
+		return;
+	}
+	*(void **)ptr = slabFreeLists[block->sizeClass];
+	slabFreeLists[block->sizeClass] = ptr;
+}
+
+void *KernelObject::operator new(size_t size) {
+	return SlabAlloc(size);
+}
+
+void KernelObject::operator delete(void *ptr) {
+	if (ptr)
+		SlabFree(ptr);
+}
+
 KernelObjectPool::KernelObjectPool() {
-	memset(occupied, 0, sizeof(bool)*maxCount);
+	memset(slots, 0, sizeof(slots));
 	nextID = initialNextID;
 }
 
@@ -466,10 +538,10 @@ SceUID KernelObjectPool::Create(KernelObject *obj, int rangeBottom, int rangeTop
 		rangeBottom = nextID++;
 
 	for (int i = rangeBottom; i < rangeTop; i++) {
-		if (!occupied[i]) {
-			occupied[i] = true;
-			pool[i] = obj;
-			pool[i]->uid = i + handleOffset;
+		if (!slots[i].obj) {
+			slots[i].obj = obj;
+			slots[i].type = obj->GetIDType();
+			obj->uid = i + handleOffset;
 			return i + handleOffset;
 		}
 	}
@@ -483,30 +555,25 @@ bool KernelObjectPool::IsValid(SceUID handle) const {
 	if (index < 0 || index >= maxCount)
 		return false;
 	else
-		return occupied[index];
+		return slots[index].obj != nullptr;
 }
 
 void KernelObjectPool::Clear() {
 	for (int i = 0; i < maxCount; i++) {
 		// brutally clear everything, no validation
-		if (occupied[i])
-			delete pool[i];
-		pool[i] = nullptr;
-		occupied[i] = false;
+		delete slots[i].obj;
+		slots[i].obj = nullptr;
+		slots[i].type = 0;
 	}
 	nextID = initialNextID;
 }
 
 void KernelObjectPool::List() {
 	for (int i = 0; i < maxCount; i++) {
-		if (occupied[i]) {
+		if (slots[i].obj) {
 			char buffer[256];
-			if (pool[i]) {
-				pool[i]->GetQuickInfo(buffer, 256);
-				INFO_LOG(SCEKERNEL, "KO %i: %s \"%s\": %s", i + handleOffset, pool[i]->GetTypeName(), pool[i]->GetName(), buffer);
-			} else {
-				strcpy(buffer, "WTF? Zero Pointer");
-			}
+			slots[i].obj->GetQuickInfo(buffer, 256);
+			INFO_LOG(SCEKERNEL, "KO %i: %s \"%s\": %s", i + handleOffset, slots[i].obj->GetTypeName(), slots[i].obj->GetName(), buffer);
 		}
 	}
 }
@@ -514,7 +581,7 @@ void KernelObjectPool::List() {
 int KernelObjectPool::GetCount() const {
 	int count = 0;
 	for (int i = 0; i < maxCount; i++) {
-		if (occupied[i])
+		if (slots[i].obj)
 			count++;
 	}
 	return count;
@@ -540,6 +607,11 @@ void KernelObjectPool::DoState(PointerWrap &p) {
 	}
 
 	p.Do(nextID);
+	// Kept as a separate bool array in the state format, from before the slots
+	// carried their own free/used marker.
+	bool occupied[maxCount];
+	for (int i = 0; i < maxCount; ++i)
+		occupied[i] = slots[i].obj != nullptr;
 	p.DoArray(occupied, maxCount);
 	for (int i = 0; i < maxCount; ++i) {
 		if (!occupied[i])
@@ -548,18 +620,20 @@ void KernelObjectPool::DoState(PointerWrap &p) {
 		int type;
 		if (p.mode == p.MODE_READ) {
 			p.Do(type);
-			pool[i] = CreateByIDType(type);
+			KernelObject *obj = CreateByIDType(type);
 
 			// Already logged an error.
-			if (pool[i] == nullptr)
+			if (obj == nullptr)
 				return;
 
-			pool[i]->uid = i + handleOffset;
+			obj->uid = i + handleOffset;
+			slots[i].obj = obj;
+			slots[i].type = type;
 		} else {
-			type = pool[i]->GetIDType();
+			type = slots[i].type;
 			p.Do(type);
 		}
-		pool[i]->DoState(p);
+		slots[i].obj->DoState(p);
 		if (p.error >= p.ERROR_FAILURE)
 			break;
 	}
@@ -729,7 +803,7 @@ const HLEFunction ThreadManForUser[] =
 	{0X68DA9E36, &WrapI_U<sceKernelDelayThreadCB>,                   "sceKernelDelayThreadCB",                    'i', "x",      HLE_NOT_IN_INTERRUPT | HLE_NOT_DISPATCH_SUSPENDED },
 	{0XAA73C935, &WrapV_I<sceKernelExitThread>,                      "sceKernelExitThread",                       'v', "i"       },
 	{0X809CE29B, &WrapV_I<sceKernelExitDeleteThread>,                "sceKernelExitDeleteThread",                 'v', "i"       },
-	{0x94aa61ee, &WrapI_V<sceKernelGetThreadCurrentPriority>,        "sceKernelGetThreadCurrentPriority",         'i', ""        },
+	{0x94aa61ee, &WrapI_V<sceKernelGetThreadCurrentPriority>,        "sceKernelGetThreadCurrentPriority",         'i', "",       HLE_SPECIAL_JIT_SIMPLE },
 	{0X293B45B8, &WrapI_V<sceKernelGetThreadId>,                     "sceKernelGetThreadId",                      'i', "",       HLE_NOT_IN_INTERRUPT },
 	{0X3B183E26, &WrapI_I<sceKernelGetThreadExitStatus>,             "sceKernelGetThreadExitStatus",              'i', "i"       },
 	{0X52089CA1, &WrapI_I<sceKernelGetThreadStackFreeSize>,          "sceKernelGetThreadStackFreeSize",           'i', "i"       },
@@ -769,10 +843,10 @@ const HLEFunction ThreadManForUser[] =
 	{0X7E65B999, &WrapI_I<sceKernelCancelAlarm>,                     "sceKernelCancelAlarm",                      'i', "i"       },
 	{0XDAA3F564, &WrapI_IU<sceKernelReferAlarmStatus>,               "sceKernelReferAlarmStatus",                 'i', "ix"      },
 
-	{0XBA6B92E2, &WrapI_UUU<sceKernelSysClock2USec>,                 "sceKernelSysClock2USec",                    'i', "xxx"     },
-	{0X110DEC9A, &WrapI_UU<sceKernelUSec2SysClock>,                  "sceKernelUSec2SysClock",                    'i', "xx"      },
-	{0XC8CD158C, &WrapU64_U<sceKernelUSec2SysClockWide>,             "sceKernelUSec2SysClockWide",                'X', "x"       },
-	{0XE1619D7C, &WrapI_UUUU<sceKernelSysClock2USecWide>,            "sceKernelSysClock2USecWide",                'i', "xxxx"    },
+	{0XBA6B92E2, &WrapI_UUU<sceKernelSysClock2USec>,                 "sceKernelSysClock2USec",                    'i', "xxx",    HLE_SPECIAL_JIT_SIMPLE },
+	{0X110DEC9A, &WrapI_UU<sceKernelUSec2SysClock>,                  "sceKernelUSec2SysClock",                    'i', "xx",     HLE_SPECIAL_JIT_SIMPLE },
+	{0XC8CD158C, &WrapU64_U<sceKernelUSec2SysClockWide>,             "sceKernelUSec2SysClockWide",                'X', "x",      HLE_SPECIAL_JIT_SIMPLE },
+	{0XE1619D7C, &WrapI_UUUU<sceKernelSysClock2USecWide>,            "sceKernelSysClock2USecWide",                'i', "xxxx",   HLE_SPECIAL_JIT_SIMPLE },
 
 	{0X278C0DF5, &WrapI_IU<sceKernelWaitThreadEnd>,                  "sceKernelWaitThreadEnd",                    'i', "ix"      },
 	{0XD59EAD2F, &WrapI_I<sceKernelWakeupThread>,                    "sceKernelWakeupThread",                     'i', "i"       }, //AI Go, audio?
@@ -417,13 +417,17 @@ public:
 	// static u32 GetMissingErrorCode()
 	// static int GetStaticIDType()
 
+	// Kernel objects come from size-segregated slabs, not the process heap -
+	// create/delete happens constantly during loading screens. See sceKernel.cpp.
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr);
+
 	virtual void DoState(PointerWrap &p)
 	{
 		_dbg_assert_msg_(SCEKERNEL, false, "Unable to save state: bad kernel object.");
 	}
 };
 
-// TODO: Delete the "occupied" array, rely on non-zero pool entries?
 class KernelObjectPool {
 public:
 	KernelObjectPool();
@@ -439,10 +443,8 @@ public:
 	u32 Destroy(SceUID handle) {
 		u32 error;
 		if (Get<T>(handle, error)) {
-			occupied[handle-handleOffset] = false;
-			delete pool[handle-handleOffset];
-			// Why weren't we zeroing before?
-			pool[handle-handleOffset] = nullptr;
+			delete slots[handle - handleOffset].obj;
+			slots[handle - handleOffset].obj = nullptr;
 		}
 		return error;
 	};
@@ -451,7 +453,9 @@ public:
 
 	template <class T>
 	T* Get(SceUID handle, u32 &outError) {
-		if (handle < handleOffset || handle >= handleOffset+maxCount || !occupied[handle-handleOffset]) {
+		// The subtraction makes negative and out-of-range handles both wrap above
+		// maxCount, so validation is a single compare plus two loads from the slot.
+		if ((u32)(handle - handleOffset) >= (u32)maxCount) {
 			// Tekken 6 spams 0x80020001 gets wrong with no ill effects, also on the real PSP
 			if (handle != 0 && (u32)handle != 0x80020001) {
 				WARN_LOG(SCEKERNEL, "Kernel: Bad object handle %i (%08x)", handle, handle);
@@ -459,17 +463,17 @@ public:
 			outError = T::GetMissingErrorCode();
 			return 0;
 		} else {
-			// Previously we had a dynamic_cast here, but since RTTI was disabled traditionally,
-			// it just acted as a static case and everything worked. This means that we will never
-			// see the Wrong type object error below, but we'll just have to live with that danger.
-			T* t = static_cast<T*>(pool[handle - handleOffset]);
-			if (t == 0 || t->GetIDType() != T::GetStaticIDType()) {
+			// The slot caches the ID type, so the type check doesn't need a virtual
+			// call. Previously we had a dynamic_cast here, but since RTTI was disabled
+			// traditionally, it just acted as a static cast and everything worked.
+			const PoolSlot &slot = slots[handle - handleOffset];
+			if (slot.obj == nullptr || slot.type != T::GetStaticIDType()) {
 				WARN_LOG(SCEKERNEL, "Kernel: Wrong object type for %i (%08x)", handle, handle);
 				outError = T::GetMissingErrorCode();
 				return 0;
 			}
 			outError = SCE_KERNEL_ERROR_OK;
-			return t;
+			return static_cast<T *>(slot.obj);
 		}
 	}
 
@@ -477,47 +481,42 @@ public:
 	template <class T>
 	T *GetFast(SceUID handle) {
 		const SceUID realHandle = handle - handleOffset;
-		_dbg_assert_(SCEKERNEL, realHandle >= 0 && realHandle < maxCount && occupied[realHandle]);
-		return static_cast<T *>(pool[realHandle]);
+		_dbg_assert_(SCEKERNEL, realHandle >= 0 && realHandle < maxCount && slots[realHandle].obj != nullptr);
+		return static_cast<T *>(slots[realHandle].obj);
 	}
 
 	template <class T, typename ArgT>
 	void Iterate(bool func(T *, ArgT), ArgT arg) {
 		int type = T::GetStaticIDType();
 		for (int i = 0; i < maxCount; i++) {
-			if (!occupied[i])
+			if (slots[i].obj == nullptr || slots[i].type != type)
 				continue;
-			T *t = static_cast<T *>(pool[i]);
-			if (t->GetIDType() == type) {
-				if (!func(t, arg))
-					break;
-			}
+			T *t = static_cast<T *>(slots[i].obj);
+			if (!func(t, arg))
+				break;
 		}
 	}
 
 	int ListIDType(int type, SceUID *uids, int count) const {
 		int total = 0;
 		for (int i = 0; i < maxCount; i++) {
-			if (!occupied[i]) {
+			if (slots[i].obj == nullptr || slots[i].type != type) {
 				continue;
 			}
-			if (pool[i]->GetIDType() == type) {
-				if (total < count) {
-					*uids++ = pool[i]->GetUID();
-				}
-				++total;
+			if (total < count) {
+				*uids++ = slots[i].obj->GetUID();
 			}
+			++total;
 		}
 		return total;
 	}
 
 	bool GetIDType(SceUID handle, int *type) const {
-		if (handle < handleOffset || handle >= handleOffset+maxCount || !occupied[handle-handleOffset]) {
+		if ((u32)(handle - handleOffset) >= (u32)maxCount || slots[handle - handleOffset].obj == nullptr) {
 			ERROR_LOG(SCEKERNEL, "Kernel: Bad object handle %i (%08x)", handle, handle);
 			return false;
 		}
-		KernelObject *t = pool[handle - handleOffset];
-		*type = t->GetIDType();
+		*type = slots[handle - handleOffset].type;
 		return true;
 	}
 
@@ -531,8 +530,16 @@ private:
 		handleOffset = 0x100,
 		initialNextID = 0x10
 	};
-	KernelObject *pool[maxCount];
-	bool occupied[maxCount];
+	// UIDs index this flat table directly (offset by handleOffset). Each slot
+	// holds the pointer together with a cached copy of the object's ID type so
+	// lookup validation touches a single slot - a null obj means the slot is
+	// free. Kernel object lookup happens on nearly every syscall, so Get needs
+	// to stay this tight.
+	struct PoolSlot {
+		KernelObject *obj;
+		int type;
+	};
+	PoolSlot slots[maxCount];
 	int nextID;
 };
 
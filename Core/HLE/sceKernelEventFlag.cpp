@@ -292,14 +292,18 @@ u32 sceKernelSetEventFlag(SceUID id, u32 bitsToSet) {
 
 		e->nef.currentPattern |= bitsToSet;
 
+		// Wake all matching waiters in one pass, compacting the remaining ones
+		// in place instead of erasing from the middle of the vector per thread.
+		size_t remaining = 0;
 		for (size_t i = 0; i < e->waitingThreads.size(); ++i) {
 			EventFlagTh *t = &e->waitingThreads[i];
-			if (__KernelUnlockEventFlagForThread(e, *t, error, 0, wokeThreads)) {
-				e->waitingThreads.erase(e->waitingThreads.begin() + i);
-				// Try the one that used to be in this place next.
-				--i;
+			if (!__KernelUnlockEventFlagForThread(e, *t, error, 0, wokeThreads)) {
+				if (remaining != i)
+					e->waitingThreads[remaining] = *t;
+				++remaining;
 			}
 		}
+		e->waitingThreads.resize(remaining);
 
 		if (wokeThreads)
 			hleReSchedule("event flag set");
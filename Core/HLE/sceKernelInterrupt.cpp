@@ -162,6 +162,7 @@ void IntrHandler::handleResult(PendingInterrupt& pend)
 
 SubIntrHandler* IntrHandler::add(int subIntrNum)
 {
+	invalidateDispatch();
 	return &subIntrHandlers[subIntrNum];
 }
 void IntrHandler::remove(int subIntrNum)
@@ -169,6 +170,7 @@ void IntrHandler::remove(int subIntrNum)
 	if (has(subIntrNum))
 	{
 		subIntrHandlers.erase(subIntrNum);
+		invalidateDispatch();
 	}
 }
 bool IntrHandler::has(int subIntrNum) const
@@ -178,10 +180,12 @@ bool IntrHandler::has(int subIntrNum) const
 void IntrHandler::enable(int subIntrNum)
 {
 	subIntrHandlers[subIntrNum].enabled = true;
+	invalidateDispatch();
 }
 void IntrHandler::disable(int subIntrNum)
 {
 	subIntrHandlers[subIntrNum].enabled = false;
+	invalidateDispatch();
 }
 SubIntrHandler* IntrHandler::get(int subIntrNum)
 {
@@ -193,17 +197,36 @@ SubIntrHandler* IntrHandler::get(int subIntrNum)
 void IntrHandler::clear()
 {
 	subIntrHandlers.clear();
+	invalidateDispatch();
+}
+
+void IntrHandler::invalidateDispatch()
+{
+	dispatchDirty = true;
+}
+
+void IntrHandler::compileDispatch()
+{
+	enabledSubIntrs.clear();
+	for (auto iter = subIntrHandlers.begin(); iter != subIntrHandlers.end(); ++iter) {
+		if (iter->second.enabled && iter->second.handlerAddress != 0) {
+			enabledSubIntrs.push_back(iter->first);
+		}
+	}
+	dispatchDirty = false;
 }
 
 void IntrHandler::queueUp(int subintr) {
 	if (subintr == PSP_INTR_SUB_NONE) {
 		pendingInterrupts.push_back(PendingInterrupt(intrNumber, subintr));
 	} else {
-		// Just call execute on all the subintr handlers for this interrupt.
-		// They will get queued up.
-		for (auto iter = subIntrHandlers.begin(); iter != subIntrHandlers.end(); ++iter) {
-			if ((subintr == PSP_INTR_SUB_ALL || iter->first == subintr) && iter->second.enabled && iter->second.handlerAddress != 0) {
-				pendingInterrupts.push_back(PendingInterrupt(intrNumber, iter->first));
+		// Queue from the compiled list of enabled handlers - registration
+		// changes are rare, triggers happen every frame.
+		if (dispatchDirty)
+			compileDispatch();
+		for (int sub : enabledSubIntrs) {
+			if (subintr == PSP_INTR_SUB_ALL || sub == subintr) {
+				pendingInterrupts.push_back(PendingInterrupt(intrNumber, sub));
 			}
 		}
 	}
@@ -217,6 +240,7 @@ void IntrHandler::DoState(PointerWrap &p)
 
 	p.Do(intrNumber);
 	p.Do<int, SubIntrHandler>(subIntrHandlers);
+	invalidateDispatch();
 }
 
 void PendingInterrupt::DoState(PointerWrap &p)
@@ -454,6 +478,7 @@ SubIntrHandler *__RegisterSubIntrHandler(u32 intrNumber, u32 subIntrNumber, u32
 			SubIntrHandler *subIntrHandler = intr->get(subIntrNumber);
 			subIntrHandler->handlerAddress = handler;
 			subIntrHandler->handlerArg = handlerArg;
+			intr->invalidateDispatch();
 
 			error = SCE_KERNEL_ERROR_OK;
 			return subIntrHandler;
@@ -676,7 +701,7 @@ const HLEFunction Kernel_Library[] =
 	{0X1FC64E09, &WrapI_UIU<sceKernelLockLwMutexCB>,           "sceKernelLockLwMutexCB",              'i', "xix", HLE_NOT_IN_INTERRUPT | HLE_NOT_DISPATCH_SUSPENDED },
 	{0X15B6446B, &WrapI_UI<sceKernelUnlockLwMutex>,            "sceKernelUnlockLwMutex",              'i', "xi"   },
 	{0XC1734599, &WrapI_UU<sceKernelReferLwMutexStatus>,       "sceKernelReferLwMutexStatus",         'i', "xx"   },
-	{0X293B45B8, &WrapI_V<sceKernelGetThreadId>,               "sceKernelGetThreadId",                'i', ""     },
+	{0X293B45B8, &WrapI_V<sceKernelGetThreadId>,               "sceKernelGetThreadId",                'i', "",    HLE_SPECIAL_JIT_SIMPLE },
 	{0XD13BDE95, &WrapI_V<sceKernelCheckThreadStack>,          "sceKernelCheckThreadStack",           'i', ""     },
 	{0X1839852A, &WrapU_UUU<sceKernelMemcpy>,                  "sceKernelMemcpy",                     'x', "xxx"  },
 	{0XFA835CDE, &WrapI_I<sceKernelGetTlsAddr>,                "sceKernelGetTlsAddr",                 'i', "i"    },
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <map>
+#include <vector>
 
 class PointerWrap;
 
@@ -120,12 +121,22 @@ public:
 	SubIntrHandler *get(int subIntrNum);
 	void clear();
 
+	// Call after changing a SubIntrHandler out-of-band (e.g. its handlerAddress.)
+	// add/remove/enable/disable already handle this.
+	void invalidateDispatch();
 
 	void DoState(PointerWrap &p);
 
 private:
+	void compileDispatch();
+
 	int intrNumber;
 	std::map<int, SubIntrHandler> subIntrHandlers;
+	// The subintr numbers with an enabled, registered handler, so queueUp
+	// doesn't walk the map on every trigger (vblank fires this 60 times a
+	// second.) Rebuilt lazily after registration changes.
+	std::vector<int> enabledSubIntrs;
+	bool dispatchDirty = true;
 };
 
 bool __InterruptsEnabled();
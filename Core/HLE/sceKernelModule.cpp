@@ -35,6 +35,7 @@
 #include "Core/MIPS/MIPS.h"
 #include "Core/MIPS/MIPSAnalyst.h"
 #include "Core/MIPS/MIPSCodeUtils.h"
+#include "Core/MIPS/JitCommon/JitDiskCache.h"
 #include "Core/ELF/ElfReader.h"
 #include "Core/ELF/PBPReader.h"
 #include "Core/ELF/PrxDecrypter.h"
@@ -1462,6 +1463,10 @@ static Module *__KernelLoadELFFromPtr(const u8 *ptr, size_t elfSize, u32 loadAdd
 			module->nm.entry_addr = module->nm.module_start_func;
 
 		MIPSAnalyst::PrecompileFunctions();
+		if (g_Config.bPreloadFunctions) {
+			// Also warm up any blocks we compiled in a previous run.
+			MIPSComp::LoadBlockListCache();
+		}
 
 	} else {
 		module->nm.entry_addr = -1;
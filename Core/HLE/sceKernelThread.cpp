@@ -632,6 +632,10 @@ int g_inCbCount = 0;
 // Normally, the same as currentThread.  In an interrupt, remembers the callback's thread id.
 SceUID currentCallbackThreadID = 0;
 int readyCallbacksCount = 0;
+// Threads that might have a ready callback - a conservative superset, pruned as
+// we check them. Keeps __KernelCheckCallbacks() from scanning every thread.
+std::vector<SceUID> readyCallbackThreads;
+bool readyCallbackThreadsDirty = false;
 SceUID currentThread;
 Thread *currentThreadPtr;
 u32 idleThreadHackAddr;
@@ -930,6 +934,8 @@ void __KernelThreadingInit()
 	g_inCbCount = 0;
 	currentCallbackThreadID = 0;
 	readyCallbacksCount = 0;
+	readyCallbackThreads.clear();
+	readyCallbackThreadsDirty = false;
 	lastSwitchCycles = 0;
 	idleThreadHackAddr = kernelMemory.Alloc(blockSize, false, "threadrethack");
 
@@ -968,6 +974,11 @@ void __KernelThreadingDoState(PointerWrap &p)
 	p.Do(g_inCbCount);
 	p.Do(currentCallbackThreadID);
 	p.Do(readyCallbacksCount);
+	if (p.mode == p.MODE_READ) {
+		// Not saved in the state - rebuilt on the next check.
+		readyCallbackThreads.clear();
+		readyCallbackThreadsDirty = true;
+	}
 	p.Do(idleThreadHackAddr);
 	p.Do(threadReturnHackAddr);
 	p.Do(cbReturnHackAddr);
@@ -1162,6 +1173,7 @@ void __KernelThreadingShutdown() {
 
 	kernelMemory.Free(threadReturnHackAddr);
 	threadqueue.clear();
+	readyCallbackThreads.clear();
 	threadReadyQueue.clear();
 	threadEndListeners.clear();
 	mipsCalls.clear();
@@ -3383,12 +3395,11 @@ void ActionAfterCallback::run(MipsCall &call) {
 	}
 }
 
-bool __KernelCurHasReadyCallbacks() {
-	if (readyCallbacksCount == 0) {
+static bool __KernelHasReadyCallbacks(Thread *thread) {
+	if (!thread) {
 		return false;
 	}
 
-	Thread *thread = __GetCurrentThread();
 	u32 error;
 	for (auto it = thread->callbacks.begin(), end = thread->callbacks.end(); it != end; ++it) {
 		Callback *callback = kernelObjects.Get<Callback>(*it, error);
@@ -3399,6 +3410,14 @@ bool __KernelCurHasReadyCallbacks() {
 	return false;
 }
 
+bool __KernelCurHasReadyCallbacks() {
+	if (readyCallbacksCount == 0) {
+		return false;
+	}
+
+	return __KernelHasReadyCallbacks(__GetCurrentThread());
+}
+
 // Check callbacks on the current thread only.
 // Returns true if any callbacks were processed on the current thread.
 bool __KernelCheckThreadCallbacks(Thread *thread, bool force) {
@@ -3436,14 +3455,36 @@ bool __KernelCheckCallbacks() {
 		return false;
 	}
 
+	if (readyCallbackThreadsDirty) {
+		// After a savestate load we don't know which threads have ready
+		// callbacks, so rebuild the list with a one-time scan.
+		readyCallbackThreads.clear();
+		u32 e;
+		for (auto iter = threadqueue.begin(); iter != threadqueue.end(); ++iter) {
+			Thread *thread = kernelObjects.Get<Thread>(*iter, e);
+			if (__KernelHasReadyCallbacks(thread)) {
+				readyCallbackThreads.push_back(*iter);
+			}
+		}
+		readyCallbackThreadsDirty = false;
+	}
+
 	bool processed = false;
 
 	u32 error;
-	for (auto iter = threadqueue.begin(); iter != threadqueue.end(); ++iter) {
-		Thread *thread = kernelObjects.Get<Thread>(*iter, error);
+	// The list is a superset of the threads that have ready callbacks, so we
+	// prune entries that turn out to have none (left over after a run or after
+	// the thread/callback was deleted.)
+	for (size_t i = 0; i < readyCallbackThreads.size(); ) {
+		Thread *thread = kernelObjects.Get<Thread>(readyCallbackThreads[i], error);
 		if (thread && __KernelCheckThreadCallbacks(thread, false)) {
 			processed = true;
 		}
+		if (__KernelHasReadyCallbacks(thread)) {
+			++i;
+		} else {
+			readyCallbackThreads.erase(readyCallbackThreads.begin() + i);
+		}
 	}
 
 	if (processed) {
@@ -3505,6 +3546,9 @@ void __KernelNotifyCallback(SceUID cbId, int notifyArg)
 	}
 	if (cb->nc.notifyCount == 0) {
 		readyCallbacksCount++;
+		if (std::find(readyCallbackThreads.begin(), readyCallbackThreads.end(), cb->nc.threadId) == readyCallbackThreads.end()) {
+			readyCallbackThreads.push_back(cb->nc.threadId);
+		}
 	}
 	cb->nc.notifyCount++;
 	cb->nc.notifyArg = notifyArg;
@@ -1433,7 +1433,6 @@ void PostPutAction::run(MipsCall &call) {
 
 	MpegContext *ctx = getMpegCtx(ringbuffer->mpeg);
 	int writeOffset = ringbuffer->packetsWritePos % (s32)ringbuffer->packets;
-	const u8 *data = Memory::GetPointer(ringbuffer->data + writeOffset * 2048);
 
 	int packetsAdded = currentMIPS->r[MIPS_REG_V0];
 
@@ -1442,11 +1441,11 @@ void PostPutAction::run(MipsCall &call) {
 		// TODO: Faster / less wasteful validation.
 		std::unique_ptr<MpegDemux> demuxer(new MpegDemux(packetsAdded * 2048, 0));
 		int readOffset = ringbuffer->packetsRead % (s32)ringbuffer->packets;
-		const u8 *buf = Memory::GetPointer(ringbuffer->data + readOffset * 2048);
 		bool invalid = false;
 		for (int i = 0; i < packetsAdded; ++i) {
+			// Per packet, since the span can wrap around the end of the ring.
+			const u8 *buf = Memory::GetPointer(ringbuffer->data + ((readOffset + i) % (s32)ringbuffer->packets) * 2048);
 			demuxer->addStreamData(buf, 2048);
-			buf += 2048;
 
 			if (!demuxer->demux(0xFFFF)) {
 				invalid = true;
@@ -1476,7 +1475,20 @@ void PostPutAction::run(MipsCall &call) {
 			WARN_LOG(ME, "sceMpegRingbufferPut clamping packetsAdded old=%i new=%i", packetsAdded, ringbuffer->packets - ringbuffer->packetsAvail);
 			packetsAdded = ringbuffer->packets - ringbuffer->packetsAvail;
 		}
-		int actuallyAdded = ctx->mediaengine == NULL ? 8 : ctx->mediaengine->addStreamData(data, packetsAdded * 2048) / 2048;
+		// Feed the media engine directly out of the ringbuffer in PSP memory.
+		// The new packets can wrap around the end of the ring, in which case we
+		// hand over the two pieces separately rather than staging a contiguous
+		// copy - FMV-heavy games push tens of MB/s through here.
+		int actuallyAdded = 8;
+		if (ctx->mediaengine != NULL) {
+			int firstPackets = std::min(packetsAdded, (int)ringbuffer->packets - writeOffset);
+			const u8 *data = Memory::GetPointer(ringbuffer->data + writeOffset * 2048);
+			actuallyAdded = ctx->mediaengine->addStreamData(data, firstPackets * 2048) / 2048;
+			if (actuallyAdded == firstPackets && packetsAdded > firstPackets) {
+				const u8 *data2 = Memory::GetPointer(ringbuffer->data);
+				actuallyAdded += ctx->mediaengine->addStreamData(data2, (packetsAdded - firstPackets) * 2048) / 2048;
+			}
+		}
 		if (actuallyAdded != packetsAdded) {
 			WARN_LOG_REPORT(ME, "sceMpegRingbufferPut(): unable to enqueue all added packets, going to overwrite some frames.");
 		}
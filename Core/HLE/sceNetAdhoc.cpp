@@ -483,6 +483,11 @@ static int sceNetAdhocPdpSend(int id, const char *mac, u32 port, void *data, int
 								// Acquire Peer Lock
 								peerlock.lock();
 
+								// Switch blocking mode once for the whole batch - it's the same
+								// socket and the same flag for every peer, and the syscall pair
+								// per datagram adds up with a full room.
+								changeBlockingMode(socket->id, flag);
+
 								// Iterate Peers
 								SceNetAdhocctlPeerInfo * peer = friends;
 								for (; peer != NULL; peer = peer->next) {
@@ -496,19 +501,19 @@ static int sceNetAdhocPdpSend(int id, const char *mac, u32 port, void *data, int
 									target.sin_port = htons(dport + portOffset);
 
 									// Send Data
-									changeBlockingMode(socket->id, flag);
 									int sent = sendto(socket->id, (const char *)data, len, 0, (sockaddr *)&target, sizeof(target));
 									int error = errno;
 									if (sent == SOCKET_ERROR) {
 										DEBUG_LOG(SCENET, "Socket Error (%i) on sceNetAdhocPdpSend[%i:%u->%u](BC) [size=%i]", error, id, getLocalPort(socket->id), ntohs(target.sin_port), len);
 									}
-									changeBlockingMode(socket->id, 0);
 									if (sent >= 0) {
 										uint8_t * sip = (uint8_t *)&target.sin_addr.s_addr;
 										DEBUG_LOG(SCENET, "sceNetAdhocPdpSend[%i:%u](BC): Sent %u bytes to %u.%u.%u.%u:%u\n", id, getLocalPort(socket->id), sent, sip[0], sip[1], sip[2], sip[3], ntohs(target.sin_port));
 									}
 								}
 
+								changeBlockingMode(socket->id, 0);
+
 								// Free Peer Lock
 								peerlock.unlock();
 
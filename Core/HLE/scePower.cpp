@@ -62,10 +62,67 @@ static int RealbusFreq = 111;
 static int pllFreq = 222;
 static int busFreq = 111;
 
+// Adaptive underclock (AdaptiveCPUSpeed): while nearly the whole cycle budget
+// is being idle-skipped (the game just waits for vblank), run the emulated CPU
+// at 111 MHz so the host cycles spent spinning through the rest of each slice
+// go to the GPU instead. Restored the moment real work resumes. The frequency
+// the game sees through scePowerGetCpuClockFrequency* stays at the value it
+// expects.
+static const int adaptiveIdleMhz = 111;
+static int adaptiveBaseMhz = 0;  // 0 = not currently underclocked.
+static int adaptiveIdleStreak = 0;
+static u64 adaptiveLastTicks = 0;
+static u64 adaptiveLastIdleTicks = 0;
+
+// The cpu frequency the game believes it's running at.
+static int PowerCpuMhz() {
+	return adaptiveBaseMhz != 0 ? adaptiveBaseMhz : CoreTiming::GetClockFrequencyMHz();
+}
+
+static void __PowerRestoreAdaptiveClock() {
+	if (adaptiveBaseMhz != 0) {
+		CoreTiming::SetClockFrequencyMHz(adaptiveBaseMhz);
+		adaptiveBaseMhz = 0;
+	}
+	adaptiveIdleStreak = 0;
+}
+
+void __PowerVblankIdleUpdate() {
+	const u64 ticks = CoreTiming::GetTicks();
+	const u64 idleTicks = CoreTiming::GetIdleTicks();
+	const u64 elapsed = ticks - adaptiveLastTicks;
+	const u64 idled = idleTicks - adaptiveLastIdleTicks;
+	adaptiveLastTicks = ticks;
+	adaptiveLastIdleTicks = idleTicks;
+
+	if (!g_Config.bAdaptiveCPUSpeed) {
+		__PowerRestoreAdaptiveClock();
+		return;
+	}
+	if (elapsed == 0)
+		return;
+
+	if (idled * 4 >= elapsed * 3) {
+		// At least 75% of the vblank was idle-skipped. Wait for a sustained
+		// streak before touching the clock so short hitches don't flap it.
+		if (adaptiveBaseMhz == 0 && ++adaptiveIdleStreak >= 15 && PowerCpuMhz() > adaptiveIdleMhz) {
+			adaptiveBaseMhz = CoreTiming::GetClockFrequencyMHz();
+			CoreTiming::SetClockFrequencyMHz(adaptiveIdleMhz);
+		}
+	} else if (idled * 2 < elapsed) {
+		// Real work resumed - give the full budget back immediately.
+		__PowerRestoreAdaptiveClock();
+	}
+}
+
 void __PowerInit() {
 	memset(powerCbSlots, 0, sizeof(powerCbSlots));
 	volatileMemLocked = false;
 	volatileWaitingThreads.clear();
+	adaptiveBaseMhz = 0;
+	adaptiveIdleStreak = 0;
+	adaptiveLastTicks = 0;
+	adaptiveLastIdleTicks = 0;
 
 	if (g_Config.iLockedCPUSpeed > 0) {
 		CoreTiming::SetClockFrequencyMHz(g_Config.iLockedCPUSpeed);
@@ -80,7 +137,7 @@ void __PowerInit() {
 }
 
 void __PowerDoState(PointerWrap &p) {
-	auto s = p.Section("scePower",1,2);
+	auto s = p.Section("scePower",1,3);
 	if (!s)
 		return;
 
@@ -92,7 +149,21 @@ void __PowerDoState(PointerWrap &p) {
 		RealpllFreq = 222;
 		RealbusFreq = 111;
 	}
+	if (s >= 3) {
+		// CoreTiming saves the possibly-underclocked CPU_HZ, so the base has
+		// to ride along for the restore to work after load.
+		p.Do(adaptiveBaseMhz);
+	} else if (p.mode == p.MODE_READ) {
+		adaptiveBaseMhz = 0;
+	}
+	if (p.mode == p.MODE_READ) {
+		adaptiveIdleStreak = 0;
+		adaptiveLastTicks = CoreTiming::GetTicks();
+		adaptiveLastIdleTicks = CoreTiming::GetIdleTicks();
+	}
 	if (g_Config.iLockedCPUSpeed > 0) {
+		// This just forced the clock, so any adaptive underclock is gone.
+		adaptiveBaseMhz = 0;
 		CoreTiming::SetClockFrequencyMHz(g_Config.iLockedCPUSpeed);
 		pllFreq = g_Config.iLockedCPUSpeed;
 		busFreq = g_Config.iLockedCPUSpeed / 2;
@@ -372,6 +443,8 @@ static int sceKernelVolatileMemLock(int type, u32 paddr, u32 psize) {
 
 
 static u32 scePowerSetClockFrequency(u32 pllfreq, u32 cpufreq, u32 busfreq) {
+	// Start over from the explicitly requested clock.
+	__PowerRestoreAdaptiveClock();
 	if (cpufreq == 0 || cpufreq > 333) {
 		WARN_LOG(HLE,"scePowerSetClockFrequency(%i,%i,%i): invalid frequency", pllfreq, cpufreq, busfreq);
 		return SCE_KERNEL_ERROR_INVALID_VALUE;
@@ -399,6 +472,8 @@ static u32 scePowerSetClockFrequency(u32 pllfreq, u32 cpufreq, u32 busfreq) {
 }
 
 static u32 scePowerSetCpuClockFrequency(u32 cpufreq) {
+	// Start over from the explicitly requested clock.
+	__PowerRestoreAdaptiveClock();
 	if(g_Config.iLockedCPUSpeed > 0) {
 		DEBUG_LOG(HLE,"scePowerSetCpuClockFrequency(%i): locked by user config at %i", cpufreq, g_Config.iLockedCPUSpeed);
 	}
@@ -430,7 +505,7 @@ static u32 scePowerSetBusClockFrequency(u32 busfreq) {
 }
 
 static u32 scePowerGetCpuClockFrequencyInt() {
-	int cpuFreq = CoreTiming::GetClockFrequencyMHz();
+	int cpuFreq = PowerCpuMhz();
 	DEBUG_LOG(HLE,"%i=scePowerGetCpuClockFrequencyInt()", cpuFreq);
 	return cpuFreq;
 }
@@ -446,7 +521,7 @@ static u32 scePowerGetBusClockFrequencyInt() {
 }
 
 static float scePowerGetCpuClockFrequencyFloat() {
-	int cpuFreq = CoreTiming::GetClockFrequencyMHz(); 
+	int cpuFreq = PowerCpuMhz();
 	DEBUG_LOG(HLE, "%f=scePowerGetCpuClockFrequencyFloat()", (float)cpuFreq);
 	return (float) cpuFreq;
 }
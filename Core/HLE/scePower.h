@@ -21,6 +21,8 @@ class PointerWrap;
 
 void __PowerInit();
 void __PowerDoState(PointerWrap &p);
+// Called once per vblank to drive the adaptive underclock (AdaptiveCPUSpeed).
+void __PowerVblankIdleUpdate();
 
 void Register_scePower();
 void Register_sceSuspendForUser();
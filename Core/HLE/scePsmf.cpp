@@ -299,6 +299,8 @@ public:
 
 		const u32 EP_MAP_STRIDE = 1 + 1 + 4 + 4;
 		psmf->EPMap.clear();
+		// A full-length movie has one entry per GOP, easily thousands - grow once.
+		psmf->EPMap.reserve(psmf->EPMapEntriesNum);
 		for (u32 i = 0; i < psmf->EPMapEntriesNum; i++) {
 			const u8 *const entryAddr = data + psmf->EPMapOffset + EP_MAP_STRIDE * i;
 			PsmfEntry entry;
@@ -28,6 +28,10 @@
 
 #include <algorithm>
 
+#ifdef _M_SSE
+#include <emmintrin.h>
+#endif
+
 #ifdef USE_FFMPEG
 
 extern "C" {
@@ -656,12 +660,20 @@ bool MediaEngine::stepVideo(int videoPixelMode, bool skipFrame) {
 // Helpers that null out alpha (which seems to be the case on the PSP.)
 // Some games depend on this, for example Sword Art Online (doesn't clear A's from buffer.)
 inline void writeVideoLineRGBA(void *destp, const void *srcp, int width) {
-	// TODO: Use SSE/NEON, investigate why AV_PIX_FMT_RGB0 does not work.
+	// TODO: Investigate why AV_PIX_FMT_RGB0 does not work.
 	u32_le *dest = (u32_le *)destp;
 	const u32_le *src = (u32_le *)srcp;
 
 	const u32 mask = 0x00FFFFFF;
-	for (int i = 0; i < width; ++i) {
+	int i = 0;
+#ifdef _M_SSE
+	__m128i vmask = _mm_set1_epi32(mask);
+	for (; i + 4 <= width; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *)&src[i]);
+		_mm_storeu_si128((__m128i *)&dest[i], _mm_and_si128(v, vmask));
+	}
+#endif
+	for (; i < width; ++i) {
 		dest[i] = src[i] & mask;
 	}
 }
@@ -671,23 +683,37 @@ inline void writeVideoLineABGR5650(void *destp, const void *srcp, int width) {
 }
 
 inline void writeVideoLineABGR5551(void *destp, const void *srcp, int width) {
-	// TODO: Use SSE/NEON.
 	u16_le *dest = (u16_le *)destp;
 	const u16_le *src = (u16_le *)srcp;
 
 	const u16 mask = 0x7FFF;
-	for (int i = 0; i < width; ++i) {
+	int i = 0;
+#ifdef _M_SSE
+	__m128i vmask = _mm_set1_epi16((short)mask);
+	for (; i + 8 <= width; i += 8) {
+		__m128i v = _mm_loadu_si128((const __m128i *)&src[i]);
+		_mm_storeu_si128((__m128i *)&dest[i], _mm_and_si128(v, vmask));
+	}
+#endif
+	for (; i < width; ++i) {
 		dest[i] = src[i] & mask;
 	}
 }
 
 inline void writeVideoLineABGR4444(void *destp, const void *srcp, int width) {
-	// TODO: Use SSE/NEON.
 	u16_le *dest = (u16_le *)destp;
 	const u16_le *src = (u16_le *)srcp;
 
 	const u16 mask = 0x0FFF;
-	for (int i = 0; i < width; ++i) {
+	int i = 0;
+#ifdef _M_SSE
+	__m128i vmask = _mm_set1_epi16((short)mask);
+	for (; i + 8 <= width; i += 8) {
+		__m128i v = _mm_loadu_si128((const __m128i *)&src[i]);
+		_mm_storeu_si128((__m128i *)&dest[i], _mm_and_si128(v, vmask));
+	}
+#endif
+	for (; i < width; ++i) {
 		dest[i] = src[i] & mask;
 	}
 }
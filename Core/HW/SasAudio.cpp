@@ -20,6 +20,11 @@
 #include "base/basictypes.h"
 #include "profiler/profiler.h"
 
+#include "Common/Common.h"
+#ifdef _M_SSE
+#include <emmintrin.h>
+#endif
+
 #include "Core/MemMapHelpers.h"
 #include "Core/HLE/sceAtrac.h"
 #include "Core/Config.h"
@@ -635,14 +640,36 @@ void SasInstance::WriteMixedOutput(s16 *outp, const s16 *inp, int leftVol, int r
 	} else {
 		// These are the optimal cases.
 		if (dry && wet) {
-			for (int i = 0; i < grainSize * 2; i += 2) {
-				*outp++ = clamp_s16(mixBuffer[i + 0] + sendBufferProcessed[i + 0]);
-				*outp++ = clamp_s16(mixBuffer[i + 1] + sendBufferProcessed[i + 1]);
+			int i = 0;
+#ifdef _M_SSE
+			// PACKS does the clamping for us.
+			for (; i + 8 <= grainSize * 2; i += 8) {
+				__m128i mix1 = _mm_loadu_si128((__m128i *)&mixBuffer[i]);
+				__m128i mix2 = _mm_loadu_si128((__m128i *)&mixBuffer[i + 4]);
+				__m128i send = _mm_loadu_si128((__m128i *)&sendBufferProcessed[i]);
+				// Widen the send samples to 32 bits so the addition can't wrap before clamping.
+				__m128i sendSign = _mm_cmpgt_epi16(_mm_setzero_si128(), send);
+				mix1 = _mm_add_epi32(mix1, _mm_unpacklo_epi16(send, sendSign));
+				mix2 = _mm_add_epi32(mix2, _mm_unpackhi_epi16(send, sendSign));
+				_mm_storeu_si128((__m128i *)&outp[i], _mm_packs_epi32(mix1, mix2));
+			}
+#endif
+			for (; i < grainSize * 2; i += 2) {
+				outp[i + 0] = clamp_s16(mixBuffer[i + 0] + sendBufferProcessed[i + 0]);
+				outp[i + 1] = clamp_s16(mixBuffer[i + 1] + sendBufferProcessed[i + 1]);
 			}
 		} else if (dry) {
-			for (int i = 0; i < grainSize * 2; i += 2) {
-				*outp++ = clamp_s16(mixBuffer[i + 0]);
-				*outp++ = clamp_s16(mixBuffer[i + 1]);
+			int i = 0;
+#ifdef _M_SSE
+			for (; i + 8 <= grainSize * 2; i += 8) {
+				__m128i mix1 = _mm_loadu_si128((__m128i *)&mixBuffer[i]);
+				__m128i mix2 = _mm_loadu_si128((__m128i *)&mixBuffer[i + 4]);
+				_mm_storeu_si128((__m128i *)&outp[i], _mm_packs_epi32(mix1, mix2));
+			}
+#endif
+			for (; i < grainSize * 2; i += 2) {
+				outp[i + 0] = clamp_s16(mixBuffer[i + 0]);
+				outp[i + 1] = clamp_s16(mixBuffer[i + 1]);
 			}
 		} else {
 			// This is another uncommon case, dry must be off but let's keep it for clarity.
@@ -15,6 +15,7 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 
@@ -178,34 +179,6 @@ void SasReverb::SetPreset(int preset) {
 	}
 }
 
-// Wraps around the upper part of a buffer.
-template<int bufsize>
-class BufferWrapper {
-public:
-	BufferWrapper(int16_t *buffer, int position, int usedSize) : buf_(buffer), pos_(position), end_(bufsize), base_(bufsize - usedSize), size_(usedSize) {}
-	int16_t &operator [](int index) {
-		int addr = pos_ + index;
-		if (addr >= end_) { addr -= size_; }
-		if (addr < base_) { addr += size_; }
-		return buf_[addr];
-	}
-
-	int GetPosition() { return pos_; }
-	void Next() {
-		pos_++;
-		if (pos_ >= end_) {
-			pos_ -= size_;
-		}
-	}
-
-private:
-	int16_t *buf_;
-	int pos_;
-	int end_;
-	int base_;
-	int size_;
-};
-
 void SasReverb::ProcessReverb(int16_t *output, const int16_t *input, size_t inputSize, uint16_t volLeft, uint16_t volRight) {
 	// This means replicate the input signal in the processed buffer.
 	// Can also be used to verify that the error is in here...
@@ -222,49 +195,97 @@ void SasReverb::ProcessReverb(int16_t *output, const int16_t *input, size_t inpu
 
 	const SasReverbData &d = presets[preset_];
 
-	// We put this on the stack instead of in the object to let the compiler optimize better (avoid mem r/w).
-	BufferWrapper<BUFSIZE> b(workspace_, pos_, d.size);
-
 	// This runs at 22khz.
-	// Very unoptimized, straight from the description. Can probably be reformulated into something way more efficient.
-	// Or we could actually template the whole thing with the parameters as template arguments, as the presets are fixed.
-	for (size_t i = 0; i < inputSize; i++) {
-		// Dividing by two here is an incorrect hack. Some multiplication factor is needed to prevent the reverb from getting too loud, though.
-		int16_t LeftInput = input[i * 2] >> 1;
-		int16_t RightInput = input[i * 2 + 1] >> 1;
-
-		int16_t Lin = LeftInput; //  (d.vLIN * LeftInput) >> 15;
-		int16_t Rin = RightInput; // (d.vRIN * RightInput) >> 15;
-
-		// ____Same Side Reflection(left - to - left and right - to - right)___________________
-		b[d.mLSAME] = clamp_s16(Lin + (b[d.dLSAME] * d.vWALL >> 15) - (b[d.mLSAME - 1]*d.vIIR >> 15) + b[d.mLSAME - 1]); // L - to - L
-		b[d.mRSAME] = clamp_s16(Rin + (b[d.dRSAME] * d.vWALL >> 15) - (b[d.mRSAME - 1]*d.vIIR >> 15) + b[d.mRSAME - 1]); // R - to - R
-		// ___Different Side Reflection(left - to - right and right - to - left)_______________
-		b[d.mLDIFF] = clamp_s16(Lin + (b[d.dRDIFF] * d.vWALL >> 15) - (b[d.mLDIFF - 1]*d.vIIR >> 15) + b[d.mLDIFF - 1]); // R - to - L
-		b[d.mRDIFF] = clamp_s16(Rin + (b[d.dLDIFF] * d.vWALL >> 15) - (b[d.mRDIFF - 1]*d.vIIR >> 15) + b[d.mRDIFF - 1]); // L - to - R
-		// ___Early Echo(Comb Filter, with input from buffer)__________________________
-		int32_t Lout = ((d.vCOMB1*b[d.mLCOMB1] + d.vCOMB2*b[d.mLCOMB2] + d.vCOMB3*b[d.mLCOMB3] + d.vCOMB4*b[d.mLCOMB4]) >> 15);
-		int32_t Rout = ((d.vCOMB1*b[d.mRCOMB1] + d.vCOMB2*b[d.mRCOMB2] + d.vCOMB3*b[d.mRCOMB3] + d.vCOMB4*b[d.mRCOMB4]) >> 15);
-		// ___Late Reverb APF1(All Pass Filter 1, with input from COMB)________________
-		b[d.mLAPF1] = clamp_s16(Lout - (d.vAPF1*b[(d.mLAPF1 - d.dAPF1)] >> 15));
-		Lout = b[(d.mLAPF1 - d.dAPF1)] + (b[d.mLAPF1] * d.vAPF1 >> 15);
-		b[d.mRAPF1] = clamp_s16(Rout - (d.vAPF1*b[(d.mRAPF1 - d.dAPF1)] >> 15));
-		Rout = b[(d.mRAPF1 - d.dAPF1)] + (b[d.mRAPF1] * d.vAPF1 >> 15);
-		// ___Late Reverb APF2(All Pass Filter 2, with input from APF1)________________
-		b[d.mLAPF2] = clamp_s16(Lout - (d.vAPF2*b[(d.mLAPF2 - d.dAPF2)] >> 15));
-		Lout = b[(d.mLAPF2 - d.dAPF2)] + (b[d.mLAPF2] * d.vAPF2 >> 15);
-		b[d.mRAPF2] = clamp_s16(Rout - (d.vAPF2*b[(d.mRAPF2 - d.dAPF2)] >> 15));
-		Rout = b[(d.mRAPF2 - d.dAPF2)] + (b[d.mRAPF2] * d.vAPF2 >> 15);
-		// ___Output to Mixer(Output volume multiplied with input from APF2)___________
-		output[i * 4 + 0] = clamp_s16(Lout * volLeft >> 15);
-		output[i * 4 + 1] = clamp_s16(Rout * volRight >> 15);
-		output[i * 4 + 2] = 0;
-		output[i * 4 + 3] = 0;
-
-		b.Next();
+	// The reverb is a network of delay taps into a single circular buffer, straight
+	// from the description. The 1-sample feedback in the reflection stage rules out
+	// processing multiple samples at once, but we don't have to bounds-check every
+	// tap access either: each tap address just advances by one per sample, so until
+	// the first tap reaches the end of the buffer, plain pointers stream through.
+	// We process in runs of that length, with all the wrap handling hoisted out.
+	const int end = BUFSIZE;
+	int pos = pos_;
+
+	// All effective tap offsets are non-negative, so only the upper wrap can happen.
+	auto tap = [&](int offset) {
+		int addr = pos + offset;
+		if (addr >= end)
+			addr -= d.size;
+		return workspace_ + addr;
+	};
+
+	size_t i = 0;
+	while (i < inputSize) {
+		static const int16_t SasReverbData::*offsets[] = {
+			&SasReverbData::mLSAME, &SasReverbData::dLSAME, &SasReverbData::mRSAME, &SasReverbData::dRSAME,
+			&SasReverbData::mLDIFF, &SasReverbData::dLDIFF, &SasReverbData::mRDIFF, &SasReverbData::dRDIFF,
+			&SasReverbData::mLCOMB1, &SasReverbData::mLCOMB2, &SasReverbData::mLCOMB3, &SasReverbData::mLCOMB4,
+			&SasReverbData::mRCOMB1, &SasReverbData::mRCOMB2, &SasReverbData::mRCOMB3, &SasReverbData::mRCOMB4,
+		};
+
+		// The run ends when the first tap (or the cursor itself) would wrap.
+		int run = (int)(inputSize - i);
+		run = std::min(run, end - (int)(tap(0) - workspace_));
+		for (auto offset : offsets) {
+			run = std::min(run, end - (int)(tap(d.*offset) - workspace_));
+			run = std::min(run, end - (int)(tap(d.*offset - 1) - workspace_));
+		}
+		run = std::min(run, end - (int)(tap(d.mLAPF1) - workspace_));
+		run = std::min(run, end - (int)(tap(d.mLAPF1 - d.dAPF1) - workspace_));
+		run = std::min(run, end - (int)(tap(d.mRAPF1) - workspace_));
+		run = std::min(run, end - (int)(tap(d.mRAPF1 - d.dAPF1) - workspace_));
+		run = std::min(run, end - (int)(tap(d.mLAPF2) - workspace_));
+		run = std::min(run, end - (int)(tap(d.mLAPF2 - d.dAPF2) - workspace_));
+		run = std::min(run, end - (int)(tap(d.mRAPF2) - workspace_));
+		run = std::min(run, end - (int)(tap(d.mRAPF2 - d.dAPF2) - workspace_));
+
+		int16_t *mLSAME = tap(d.mLSAME), *mLSAMEp = tap(d.mLSAME - 1), *dLSAME = tap(d.dLSAME);
+		int16_t *mRSAME = tap(d.mRSAME), *mRSAMEp = tap(d.mRSAME - 1), *dRSAME = tap(d.dRSAME);
+		int16_t *mLDIFF = tap(d.mLDIFF), *mLDIFFp = tap(d.mLDIFF - 1), *dLDIFF = tap(d.dLDIFF);
+		int16_t *mRDIFF = tap(d.mRDIFF), *mRDIFFp = tap(d.mRDIFF - 1), *dRDIFF = tap(d.dRDIFF);
+		int16_t *mLCOMB1 = tap(d.mLCOMB1), *mLCOMB2 = tap(d.mLCOMB2), *mLCOMB3 = tap(d.mLCOMB3), *mLCOMB4 = tap(d.mLCOMB4);
+		int16_t *mRCOMB1 = tap(d.mRCOMB1), *mRCOMB2 = tap(d.mRCOMB2), *mRCOMB3 = tap(d.mRCOMB3), *mRCOMB4 = tap(d.mRCOMB4);
+		int16_t *mLAPF1 = tap(d.mLAPF1), *mLAPF1d = tap(d.mLAPF1 - d.dAPF1);
+		int16_t *mRAPF1 = tap(d.mRAPF1), *mRAPF1d = tap(d.mRAPF1 - d.dAPF1);
+		int16_t *mLAPF2 = tap(d.mLAPF2), *mLAPF2d = tap(d.mLAPF2 - d.dAPF2);
+		int16_t *mRAPF2 = tap(d.mRAPF2), *mRAPF2d = tap(d.mRAPF2 - d.dAPF2);
+
+		for (int j = 0; j < run; j++, i++) {
+			// Dividing by two here is an incorrect hack. Some multiplication factor is needed to prevent the reverb from getting too loud, though.
+			int16_t Lin = input[i * 2] >> 1;
+			int16_t Rin = input[i * 2 + 1] >> 1;
+
+			// ____Same Side Reflection(left - to - left and right - to - right)___________________
+			mLSAME[j] = clamp_s16(Lin + (dLSAME[j] * d.vWALL >> 15) - (mLSAMEp[j] * d.vIIR >> 15) + mLSAMEp[j]); // L - to - L
+			mRSAME[j] = clamp_s16(Rin + (dRSAME[j] * d.vWALL >> 15) - (mRSAMEp[j] * d.vIIR >> 15) + mRSAMEp[j]); // R - to - R
+			// ___Different Side Reflection(left - to - right and right - to - left)_______________
+			mLDIFF[j] = clamp_s16(Lin + (dRDIFF[j] * d.vWALL >> 15) - (mLDIFFp[j] * d.vIIR >> 15) + mLDIFFp[j]); // R - to - L
+			mRDIFF[j] = clamp_s16(Rin + (dLDIFF[j] * d.vWALL >> 15) - (mRDIFFp[j] * d.vIIR >> 15) + mRDIFFp[j]); // L - to - R
+			// ___Early Echo(Comb Filter, with input from buffer)__________________________
+			int32_t Lout = ((d.vCOMB1 * mLCOMB1[j] + d.vCOMB2 * mLCOMB2[j] + d.vCOMB3 * mLCOMB3[j] + d.vCOMB4 * mLCOMB4[j]) >> 15);
+			int32_t Rout = ((d.vCOMB1 * mRCOMB1[j] + d.vCOMB2 * mRCOMB2[j] + d.vCOMB3 * mRCOMB3[j] + d.vCOMB4 * mRCOMB4[j]) >> 15);
+			// ___Late Reverb APF1(All Pass Filter 1, with input from COMB)________________
+			mLAPF1[j] = clamp_s16(Lout - (d.vAPF1 * mLAPF1d[j] >> 15));
+			Lout = mLAPF1d[j] + (mLAPF1[j] * d.vAPF1 >> 15);
+			mRAPF1[j] = clamp_s16(Rout - (d.vAPF1 * mRAPF1d[j] >> 15));
+			Rout = mRAPF1d[j] + (mRAPF1[j] * d.vAPF1 >> 15);
+			// ___Late Reverb APF2(All Pass Filter 2, with input from APF1)________________
+			mLAPF2[j] = clamp_s16(Lout - (d.vAPF2 * mLAPF2d[j] >> 15));
+			Lout = mLAPF2d[j] + (mLAPF2[j] * d.vAPF2 >> 15);
+			mRAPF2[j] = clamp_s16(Rout - (d.vAPF2 * mRAPF2d[j] >> 15));
+			Rout = mRAPF2d[j] + (mRAPF2[j] * d.vAPF2 >> 15);
+			// ___Output to Mixer(Output volume multiplied with input from APF2)___________
+			output[i * 4 + 0] = clamp_s16(Lout * volLeft >> 15);
+			output[i * 4 + 1] = clamp_s16(Rout * volRight >> 15);
+			output[i * 4 + 2] = 0;
+			output[i * 4 + 3] = 0;
+		}
+
+		pos += run;
+		if (pos >= end)
+			pos -= d.size;
 	}
 
 	// Save the state in the object.
-	pos_ = b.GetPosition();
+	pos_ = pos;
 }
 
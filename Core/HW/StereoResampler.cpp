@@ -29,10 +29,13 @@
 #define CONTROL_FACTOR  0.2f // in freq_shift per fifo size offset
 #define CONTROL_AVG     32
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 #include "base/logging.h"
 #include "base/NativeApp.h"
+#include "base/timeutil.h"
 #include "Common/ChunkFile.h"
 #include "Common/MathUtil.h"
 #include "Common/Atomics.h"
@@ -55,13 +58,19 @@ StereoResampler::StereoResampler()
 	  , m_lowwatermark(LOW_WATERMARK_DEFAULT)
 		, m_input_sample_rate(44100)
 		, m_indexW(0)
+		, lastPushSize_(0)
+		, overrunCount_(0)
 		, m_indexR(0)
 		, m_numLeftI(0.0f)
 		, m_frac(0)
 		, underrunCount_(0)
-		, overrunCount_(0)
 		, sample_rate_(0.0f)
-		, lastBufSize_(0) {
+		, lastBufSize_(0)
+		, lastMixTime_(0.0)
+		, lastPushTime_(0.0)
+		, mixGapPeakS_(0.0f)
+		, pushGapPeakS_(0.0f)
+		, adaptiveWatermark_((float)LOW_WATERMARK_DEFAULT) {
 	// Need to have space for the worst case in case it changes.
 	m_buffer = new int16_t[MAX_SAMPLES_EXTRA * 2]();
 
@@ -75,6 +84,7 @@ StereoResampler::StereoResampler()
 	}
 
 	UpdateBufferSize();
+	adaptiveWatermark_ = (float)m_lowwatermark;
 }
 
 StereoResampler::~StereoResampler() {
@@ -144,6 +154,142 @@ inline void ClampBufferToS16WithVolume(s16 *out, const s32 *in, size_t size) {
 
 void StereoResampler::Clear() {
 	memset(m_buffer, 0, m_bufsize * 2 * sizeof(int16_t));
+	// Forget the cadence history - the gap across a reset isn't jitter.
+	lastMixTime_ = 0.0;
+	lastPushTime_ = 0.0;
+}
+
+// Coefficients for the higher-quality resampler tier: a 4-tap polyphase FIR
+// built from a Hann-windowed sinc, in Q15. Generated once on first use.
+#define FIR_TAPS 4
+#define FIR_PHASES_BITS 5
+#define FIR_PHASES (1 << FIR_PHASES_BITS)
+
+static s16 firTable[FIR_PHASES][FIR_TAPS];
+static bool firTableInited = false;
+
+static void InitFIRTable() {
+	const float pi = 3.14159265358979f;
+	for (int phase = 0; phase < FIR_PHASES; phase++) {
+		float t = (float)phase / FIR_PHASES;
+		float coef[FIR_TAPS];
+		float sum = 0.0f;
+		for (int tap = 0; tap < FIR_TAPS; tap++) {
+			// Tap offsets from the interpolation point, which sits between the
+			// second and third tap: -1-t, -t, 1-t, 2-t.
+			float x = (float)(tap - 1) - t;
+			float sinc = x == 0.0f ? 1.0f : sinf(pi * x) / (pi * x);
+			float window = 0.5f + 0.5f * cosf(pi * x / 2.0f);  // Hann over [-2, 2]
+			coef[tap] = sinc * window;
+			sum += coef[tap];
+		}
+		// Normalize so DC passes through at unity gain.
+		for (int tap = 0; tap < FIR_TAPS; tap++) {
+			firTable[phase][tap] = (s16)(coef[tap] / sum * 32767.0f);
+		}
+	}
+	firTableInited = true;
+}
+
+// 1:1 fast path - no per-sample arithmetic, just block copies of the (at most
+// two) contiguous ring segments. Like the interpolating tiers, leaves the last
+// frame in the buffer for the anti-click padding in Mix.
+unsigned int StereoResampler::MixFastCopy(short *samples, unsigned int numSamples, u32 &indexR, u32 indexW) {
+	const int INDEX_MASK = (m_bufsize * 2 - 1);
+	u32 remaining = (indexW - indexR) & INDEX_MASK;
+	if (remaining <= 2)
+		return 0;
+	u32 count = std::min(numSamples * 2, remaining - 2);
+	u32 first = std::min(count, (u32)(m_bufsize * 2) - (indexR & INDEX_MASK));
+	memcpy(samples, &m_buffer[indexR & INDEX_MASK], first * sizeof(s16));
+	if (count > first)
+		memcpy(samples + first, &m_buffer[0], (count - first) * sizeof(s16));
+	indexR += count;
+	return count;
+}
+
+unsigned int StereoResampler::MixLinear(short *samples, unsigned int numSamples, u32 &indexR, u32 indexW, u32 ratio) {
+	const int INDEX_MASK = (m_bufsize * 2 - 1);
+	unsigned int currentSample = 0;
+	for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2) {
+		u32 indexR2 = indexR + 2; //next sample
+		s16 l1 = m_buffer[indexR & INDEX_MASK]; //current
+		s16 r1 = m_buffer[(indexR + 1) & INDEX_MASK]; //current
+		s16 l2 = m_buffer[indexR2 & INDEX_MASK]; //next
+		s16 r2 = m_buffer[(indexR2 + 1) & INDEX_MASK]; //next
+		int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
+		int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
+		samples[currentSample] = sampleL;
+		samples[currentSample + 1] = sampleR;
+		m_frac += ratio;
+		indexR += 2 * (u16)(m_frac >> 16);
+		m_frac &= 0xffff;
+	}
+	return currentSample;
+}
+
+// Higher-quality tier: the 4-tap polyphase FIR above, evaluated with a SIMD
+// multiply-accumulate where available. Roughly twice the cost of the linear
+// tier, meant for desktop-class hardware.
+unsigned int StereoResampler::MixFIR(short *samples, unsigned int numSamples, u32 &indexR, u32 indexW, u32 ratio) {
+	if (!firTableInited)
+		InitFIRTable();
+	const int INDEX_MASK = (m_bufsize * 2 - 1);
+	unsigned int currentSample = 0;
+	// Needs one frame of history and two of lookahead around the interpolation
+	// point, so requires more buffered samples than the linear tier's 2.
+	for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 8; currentSample += 2) {
+		int phase = (m_frac >> (16 - FIR_PHASES_BITS)) & (FIR_PHASES - 1);
+		const s16 *coef = firTable[phase];
+		// The taps are the four frames starting one before the current one.
+		s16 frames[FIR_TAPS * 2];
+		u32 base = (indexR - 2) & INDEX_MASK;
+		if (base + FIR_TAPS * 2 <= (u32)(m_bufsize * 2)) {
+			memcpy(frames, &m_buffer[base], sizeof(frames));
+		} else {
+			for (u32 i = 0; i < FIR_TAPS * 2; i++)
+				frames[i] = m_buffer[(base + i) & INDEX_MASK];
+		}
+		int sampleL, sampleR;
+#ifdef _M_SSE
+		__m128i c = _mm_loadl_epi64((const __m128i *)coef);
+		c = _mm_unpacklo_epi64(c, c);  // c0 c1 c2 c3 c0 c1 c2 c3
+		__m128i d = _mm_loadu_si128((const __m128i *)frames);  // L0 R0 L1 R1 L2 R2 L3 R3
+		// Deinterleave to L0 L1 L2 L3 R0 R1 R2 R3 so madd keeps the channels apart.
+		d = _mm_shufflelo_epi16(d, _MM_SHUFFLE(3, 1, 2, 0));
+		d = _mm_shufflehi_epi16(d, _MM_SHUFFLE(3, 1, 2, 0));
+		d = _mm_shuffle_epi32(d, _MM_SHUFFLE(3, 1, 2, 0));
+		__m128i acc = _mm_madd_epi16(d, c);
+		s32 sums[4];
+		_mm_storeu_si128((__m128i *)sums, acc);
+		sampleL = (sums[0] + sums[1]) >> 15;
+		sampleR = (sums[2] + sums[3]) >> 15;
+#elif PPSSPP_ARCH(ARM_NEON)
+		int16x4_t c = vld1_s16(coef);
+		int16x4x2_t lr = vld2_s16(frames);  // deinterleaves into L and R taps
+		int32x4_t ml = vmull_s16(lr.val[0], c);
+		int32x4_t mr = vmull_s16(lr.val[1], c);
+		int32x2_t sl = vpadd_s32(vget_low_s32(ml), vget_high_s32(ml));
+		int32x2_t sr = vpadd_s32(vget_low_s32(mr), vget_high_s32(mr));
+		int32x2_t s = vpadd_s32(sl, sr);
+		sampleL = vget_lane_s32(s, 0) >> 15;
+		sampleR = vget_lane_s32(s, 1) >> 15;
+#else
+		int sl = 0, sr = 0;
+		for (int i = 0; i < FIR_TAPS; i++) {
+			sl += coef[i] * frames[i * 2];
+			sr += coef[i] * frames[i * 2 + 1];
+		}
+		sampleL = sl >> 15;
+		sampleR = sr >> 15;
+#endif
+		samples[currentSample] = clamp_s16(sampleL);
+		samples[currentSample + 1] = clamp_s16(sampleR);
+		m_frac += ratio;
+		indexR += 2 * (u16)(m_frac >> 16);
+		m_frac &= 0xffff;
+	}
+	return currentSample;
 }
 
 // Executed from sound stream thread
@@ -165,48 +311,59 @@ unsigned int StereoResampler::Mix(short* samples, unsigned int numSamples, bool
 
 	const int INDEX_MASK = (m_bufsize * 2 - 1);
 
+	// Adaptive buffer sizing. We need enough buffered audio to ride out the
+	// worst recent gap between audio callbacks plus the worst recent gap
+	// between emu-thread pushes, with one push of margin - no more. Steer the
+	// drift control's target toward that instead of a fixed 40ms, so devices
+	// with steady cadence get lower latency and throttling-prone ones get a
+	// buffer that actually covers their stalls.
+	double now = time_now_d();
+	if (lastMixTime_ != 0.0) {
+		float gap = (float)(now - lastMixTime_);
+		if (gap > mixGapPeakS_)
+			mixGapPeakS_ = gap;
+	}
+	lastMixTime_ = now;
+	// The peaks decay so one early hiccup doesn't pin latency high forever.
+	mixGapPeakS_ *= 0.9995f;
+	pushGapPeakS_ *= 0.9995f;
+
+	float targetFrames = (mixGapPeakS_ + pushGapPeakS_) * m_input_sample_rate + lastPushSize_;
+	const float minFrames = (float)(m_lowwatermark / 4);
+	const float maxFrames = (float)(m_bufsize / 2);
+	if (targetFrames < minFrames) targetFrames = minFrames;
+	if (targetFrames > maxFrames) targetFrames = maxFrames;
+	// Grow quickly toward a higher prediction, shrink back slowly.
+	adaptiveWatermark_ += (targetFrames - adaptiveWatermark_) * (targetFrames > adaptiveWatermark_ ? 0.05f : 0.002f);
+
 	// We force on the audio resampler if the output sample rate doesn't match the input.
 	if (!g_Config.bAudioResampler && sample_rate == (int)m_input_sample_rate) {
-		for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2) {
-			s16 l1 = m_buffer[indexR & INDEX_MASK]; //current
-			s16 r1 = m_buffer[(indexR + 1) & INDEX_MASK]; //current
-			samples[currentSample] = l1;
-			samples[currentSample + 1] = r1;
-			indexR += 2;
-		}
+		currentSample = MixFastCopy(samples, numSamples, indexR, indexW);
 		sample_rate_ = (float)sample_rate;
 	} else {
 		// Drift prevention mechanism
 		float numLeft = (float)(((indexW - indexR) & INDEX_MASK) / 2);
 		m_numLeftI = (numLeft + m_numLeftI*(CONTROL_AVG - 1)) / CONTROL_AVG;
-		float offset = (m_numLeftI - m_lowwatermark) * CONTROL_FACTOR;
+		float offset = (m_numLeftI - adaptiveWatermark_) * CONTROL_FACTOR;
 		if (offset > MAX_FREQ_SHIFT) offset = MAX_FREQ_SHIFT;
 		if (offset < -MAX_FREQ_SHIFT) offset = -MAX_FREQ_SHIFT;
 
 		sample_rate_ = (float)(m_input_sample_rate + offset);
 		const u32 ratio = (u32)(65536.0 * sample_rate_ / (double)sample_rate);
 
-		// TODO: consider a higher-quality resampling algorithm.
-		// TODO: Add a fast path for 1:1.
-		for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2) {
-			u32 indexR2 = indexR + 2; //next sample
-			s16 l1 = m_buffer[indexR & INDEX_MASK]; //current
-			s16 r1 = m_buffer[(indexR + 1) & INDEX_MASK]; //current
-			s16 l2 = m_buffer[indexR2 & INDEX_MASK]; //next
-			s16 r2 = m_buffer[(indexR2 + 1) & INDEX_MASK]; //next
-			int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-			int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-			samples[currentSample] = sampleL;
-			samples[currentSample + 1] = sampleR;
-			m_frac += ratio;
-			indexR += 2 * (u16)(m_frac >> 16);
-			m_frac &= 0xffff;
-		}
+		if (g_Config.bAudioResamplerHQ)
+			currentSample = MixFIR(samples, numSamples, indexR, indexW, ratio);
+		else
+			currentSample = MixLinear(samples, numSamples, indexR, indexW, ratio);
 	}
 
 	int realSamples = currentSample;
-	if (currentSample < numSamples * 2)
+	if (currentSample < numSamples * 2) {
 		underrunCount_++;
+		// The prediction was wrong - grow the target immediately rather than
+		// waiting for the jitter peaks to catch up.
+		adaptiveWatermark_ = std::min(adaptiveWatermark_ * 1.5f, maxFrames);
+	}
 
 	// Padding with the last value to reduce clicking
 	short s[2];
@@ -230,6 +387,15 @@ unsigned int StereoResampler::Mix(short* samples, unsigned int numSamples, bool
 
 void StereoResampler::PushSamples(const s32 *samples, unsigned int num_samples) {
 	UpdateBufferSize();
+
+	// Track the supply cadence for the adaptive watermark in Mix.
+	double now = time_now_d();
+	if (lastPushTime_ != 0.0) {
+		float gap = (float)(now - lastPushTime_);
+		if (gap > pushGapPeakS_)
+			pushGapPeakS_ = gap;
+	}
+	lastPushTime_ = now;
 	const int INDEX_MASK = (m_bufsize * 2 - 1);
 	// Cache access in non-volatile variable
 	// indexR isn't allowed to cache in the audio throttling loop as it
@@ -268,7 +434,8 @@ void StereoResampler::GetAudioDebugStats(AudioDebugStats *stats) {
 	underrunCount_ = 0;
 	stats->overrunCount += overrunCount_;
 	overrunCount_ = 0;
-	stats->watermark = m_lowwatermark;
+	stats->watermark = (int)adaptiveWatermark_;
+	stats->latencyMs = sample_rate_ > 0.0f ? (int)((lastBufSize_ / 2) * 1000.0f / sample_rate_) : 0;
 	stats->bufsize = m_bufsize * 2;
 	stats->instantSampleRate = (int)sample_rate_;
 	stats->lastPushSize = lastPushSize_;
@@ -48,17 +48,43 @@ protected:
 	void UpdateBufferSize();
 	void SetInputSampleRate(unsigned int rate);
 
+	// The inner loops of Mix. The tier is picked once per buffer instead of
+	// branching per sample. Each returns the number of output samples written
+	// (2 per frame) and advances indexR.
+	unsigned int MixFastCopy(short *samples, unsigned int numSamples, u32 &indexR, u32 indexW);
+	unsigned int MixLinear(short *samples, unsigned int numSamples, u32 &indexR, u32 indexW, u32 ratio);
+	unsigned int MixFIR(short *samples, unsigned int numSamples, u32 &indexR, u32 indexW, u32 ratio);
+
 	int m_bufsize;
 	int m_lowwatermark;
 	unsigned int m_input_sample_rate;
 	int16_t *m_buffer;
+
+	// The ring indices are written by different threads - PushSamples on the emu
+	// thread advances m_indexW, Mix on the host audio thread advances m_indexR.
+	// Keep each on its own cache line so the writes don't bounce the other
+	// thread's line back and forth (false sharing).
+	char m_padW[64];
 	volatile u32 m_indexW;
+	int lastPushSize_;
+	int overrunCount_;
+	char m_padR[64 - sizeof(u32) - 2 * sizeof(int)];
 	volatile u32 m_indexR;
 	float m_numLeftI;
 	u32 m_frac;
 	int underrunCount_;
-	int overrunCount_;
 	float sample_rate_;
 	int lastBufSize_;
-	int lastPushSize_;
+	char m_padEnd[64 - sizeof(u32) * 2 - sizeof(int) * 2 - sizeof(float) * 2];
+
+	// Adaptive latency control (see Mix): the drift control's target buffer
+	// level is sized from the worst recent gap between audio callbacks plus
+	// the worst recent gap between emu-thread pushes, instead of a fixed
+	// 40ms. Heuristic state, plain fields - a torn read just skews the
+	// estimate for one callback.
+	double lastMixTime_;
+	double lastPushTime_;
+	float mixGapPeakS_;
+	float pushGapPeakS_;
+	float adaptiveWatermark_;
 };
@@ -18,6 +18,8 @@
 #include "ppsspp_config.h"
 #if PPSSPP_ARCH(ARM)
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "profiler/profiler.h"
 #include "Common/ChunkFile.h"
@@ -102,13 +104,25 @@ namespace MIPSComp
 using namespace ArmGen;
 using namespace ArmJitConstants;
 
-ArmJit::ArmJit(MIPSState *mips) : blocks(mips, this), gpr(mips, &js, &jo), fpr(mips, &js, &jo), mips_(mips) { 
+// 32MB is the absolute max because that's what an ARM branch instruction can reach, backwards and forwards.
+static const int MAX_CODE_SPACE_MB = 32;
+
+static int InitialCodeSpaceSize() {
+	int mb = g_Config.iJitCodeCacheMB;
+	if (mb < 4)
+		mb = 4;
+	if (mb > MAX_CODE_SPACE_MB)
+		mb = MAX_CODE_SPACE_MB;
+	return mb * 1024 * 1024;
+}
+
+ArmJit::ArmJit(MIPSState *mips) : blocks(mips, this), gpr(mips, &js, &jo), fpr(mips, &js, &jo), mips_(mips) {
 	logBlocks = 0;
 	dontLogBlocks = 0;
 	blocks.Init();
 	gpr.SetEmitter(this);
 	fpr.SetEmitter(this);
-	AllocCodeSpace(1024 * 1024 * 16);  // 32MB is the absolute max because that's what an ARM branch instruction can reach, backwards and forwards.
+	AllocCodeSpace(InitialCodeSpaceSize());
 	GenerateFixedCode();
 
 	INFO_LOG(JIT, "ARM JIT initialized: %d MB of code space", GetSpaceLeft() / (1024 * 1024));
@@ -180,6 +194,19 @@ void ArmJit::ClearCache()
 	GenerateFixedCode();
 }
 
+// Overflowing the code space throws all blocks away anyway, so take the chance
+// to double the arena (up to branch reach) - long sessions converge on a size
+// where the recompile storms stop instead of recurring every refill.
+void ArmJit::GrowCodeSpace()
+{
+	size_t newSize = std::min(region_size * 2, (size_t)MAX_CODE_SPACE_MB * 1024 * 1024);
+	WARN_LOG(JIT, "JIT code space full, growing %d MB -> %d MB", (int)(region_size >> 20), (int)(newSize >> 20));
+	blocks.Clear();
+	FreeCodeSpace();
+	AllocCodeSpace((int)newSize);
+	GenerateFixedCode();
+}
+
 void ArmJit::InvalidateCacheAt(u32 em_address, int length)
 {
 	blocks.InvalidateICache(em_address, length);
@@ -227,6 +254,12 @@ void ArmJit::Compile(u32 em_address) {
 	// INFO_LOG(JIT, "Compiling at %08x", em_address);
 
 	if (GetSpaceLeft() < 0x10000 || blocks.IsFull()) {
+		if (!blocks.IsFull() && region_size < (size_t)MAX_CODE_SPACE_MB * 1024 * 1024) {
+			// We were called from the dispatcher, which executes from this region -
+			// remapping it here would free the code we return into. Clear in place
+			// for now and grow once no generated code is left on the stack.
+			growPending_ = true;
+		}
 		ClearCache();
 	}
 
@@ -267,6 +300,10 @@ void ArmJit::Compile(u32 em_address) {
 
 void ArmJit::RunLoopUntil(u64 globalticks) {
 	PROFILE_THIS_SCOPE("jit");
+	if (growPending_) {
+		growPending_ = false;
+		GrowCodeSpace();
+	}
 	((void (*)())enterDispatcher)();
 }
 
@@ -190,6 +190,9 @@ private:
 	const u8 *DoJit(u32 em_address, JitBlock *b);
 
 	void GenerateFixedCode();
+	void GrowCodeSpace();
+	// Set when the code space should be regrown at the next safe point (see Compile()).
+	bool growPending_ = false;
 	void FlushAll();
 	void FlushPrefixV();
 
@@ -247,6 +247,22 @@ void Arm64Jit::GenerateFixedCode(const JitOptions &jo) {
 			}
 
 			LDR(INDEX_UNSIGNED, SCRATCH1, CTXREG, offsetof(MIPSState, pc));
+
+			// Fast path: probe the block lookup table before loading the opcode
+			// from game memory. On a hit we never leave JIT code, a miss falls
+			// through to the emuhack check below. X2 holds no live value here,
+			// statics all live in W19+.
+			UBFX(SCRATCH2, SCRATCH1, 2, JITBLOCK_LOOKUP_BITS);
+			LSL(SCRATCH2, SCRATCH2, 3);
+			MOVP2R(X2, blocks.GetFastBlockLookup());
+			LDR(SCRATCH2_64, X2, SCRATCH2_64);
+			CMP(SCRATCH2, SCRATCH1);
+			FixupBranch lookupMiss = B(CC_NEQ);
+				LSR(SCRATCH2_64, SCRATCH2_64, 32);
+				ADD(SCRATCH2_64, JITBASEREG, SCRATCH2_64);
+				BR(SCRATCH2_64);
+			SetJumpTarget(lookupMiss);
+
 			LDR(SCRATCH1, MEMBASEREG, SCRATCH1_64);
 			LSR(SCRATCH2, SCRATCH1, 24);   // or UBFX(SCRATCH2, SCRATCH1, 24, 8)
 			ANDI2R(SCRATCH1, SCRATCH1, 0x00FFFFFF);
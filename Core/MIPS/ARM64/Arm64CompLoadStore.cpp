@@ -304,12 +304,18 @@ namespace MIPSComp {
 		case 41: //sh
 		case 43: //sw
 			if (jo.cachePointers && g_Config.bFastMemory) {
-				// ARM has smaller load/store immediate displacements than MIPS, 12 bits - and some memory ops only have 8 bits.
-				int offsetRange = 0x3ff;
-				if (o == 41 || o == 33 || o == 37 || o == 32)
-					offsetRange = 0xff;  // 8 bit offset only
-				if (!gpr.IsImm(rs) && rs != rt && (offset <= offsetRange) && offset >= 0 &&
-					  (dataSize == 1 || (offset & (dataSize - 1)) == 0)) {  // Check that the offset is aligned to the access size as that's required for INDEX_UNSIGNED encodings. we can get here through fallback from lwl/lwr
+				// The INDEX_UNSIGNED encodings take a 12-bit immediate scaled by the access size,
+				// as long as the offset is aligned to that size (we can arrive here unaligned
+				// through the fallback from lwl/lwr.) Small negative offsets fit the unscaled
+				// (LDUR/STUR) forms instead, which reach -256..255.
+				int offsetRange = 16380;
+				if (o == 41 || o == 33 || o == 37)
+					offsetRange = 8190;
+				else if (o == 40 || o == 36 || o == 32)
+					offsetRange = 4095;
+				bool useUnscaled = offset < 0 && offset >= -256;
+				bool offsetOK = useUnscaled || (offset >= 0 && offset <= offsetRange && (dataSize == 1 || (offset & (dataSize - 1)) == 0));
+				if (!gpr.IsImm(rs) && rs != rt && offsetOK) {
 					gpr.SpillLock(rs, rt);
 					gpr.MapRegAsPointer(rs);
 
@@ -319,16 +325,30 @@ namespace MIPSComp {
 						gpr.MapReg(rt, load ? MAP_NOINIT : 0);
 						targetReg = gpr.R(rt);
 					}
-					switch (o) {
-					case 35: LDR(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
-					case 37: LDRH(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
-					case 33: LDRSH(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
-					case 36: LDRB(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
-					case 32: LDRSB(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
-						// Store
-					case 43: STR(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
-					case 41: STRH(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
-					case 40: STRB(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
+					if (useUnscaled) {
+						switch (o) {
+						case 35: LDUR(targetReg, gpr.RPtr(rs), offset); break;
+						case 37: LDURH(targetReg, gpr.RPtr(rs), offset); break;
+						case 33: LDURSH(targetReg, gpr.RPtr(rs), offset); break;
+						case 36: LDURB(targetReg, gpr.RPtr(rs), offset); break;
+						case 32: LDURSB(targetReg, gpr.RPtr(rs), offset); break;
+							// Store
+						case 43: STUR(targetReg, gpr.RPtr(rs), offset); break;
+						case 41: STURH(targetReg, gpr.RPtr(rs), offset); break;
+						case 40: STURB(targetReg, gpr.RPtr(rs), offset); break;
+						}
+					} else {
+						switch (o) {
+						case 35: LDR(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
+						case 37: LDRH(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
+						case 33: LDRSH(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
+						case 36: LDRB(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
+						case 32: LDRSB(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
+							// Store
+						case 43: STR(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
+						case 41: STRH(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
+						case 40: STRB(INDEX_UNSIGNED, targetReg, gpr.RPtr(rs), offset); break;
+						}
 					}
 					gpr.ReleaseSpillLocksAndDiscardTemps();
 					break;
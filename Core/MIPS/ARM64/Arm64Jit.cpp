@@ -18,6 +18,8 @@
 #include "ppsspp_config.h"
 #if PPSSPP_ARCH(ARM64)
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "profiler/profiler.h"
 #include "Common/ChunkFile.h"
@@ -93,7 +95,19 @@ namespace MIPSComp
 using namespace Arm64Gen;
 using namespace Arm64JitConstants;
 
-Arm64Jit::Arm64Jit(MIPSState *mips) : blocks(mips, this), gpr(mips, &js, &jo), fpr(mips, &js, &jo), mips_(mips), fp(this) { 
+// 32MB is the absolute max because that's what an ARM branch instruction can reach, backwards and forwards.
+static const int MAX_CODE_SPACE_MB = 32;
+
+static int InitialCodeSpaceSize() {
+	int mb = g_Config.iJitCodeCacheMB;
+	if (mb < 4)
+		mb = 4;
+	if (mb > MAX_CODE_SPACE_MB)
+		mb = MAX_CODE_SPACE_MB;
+	return mb * 1024 * 1024;
+}
+
+Arm64Jit::Arm64Jit(MIPSState *mips) : blocks(mips, this), gpr(mips, &js, &jo), fpr(mips, &js, &jo), mips_(mips), fp(this) {
 	// Automatically disable incompatible options.
 	if (((intptr_t)Memory::base & 0x00000000FFFFFFFFUL) != 0) {
 		jo.enablePointerify = false;
@@ -104,7 +118,7 @@ Arm64Jit::Arm64Jit(MIPSState *mips) : blocks(mips, this), gpr(mips, &js, &jo), f
 	blocks.Init();
 	gpr.SetEmitter(this);
 	fpr.SetEmitter(this, &fp);
-	AllocCodeSpace(1024 * 1024 * 16);  // 32MB is the absolute max because that's what an ARM branch instruction can reach, backwards and forwards.
+	AllocCodeSpace(InitialCodeSpaceSize());
 	GenerateFixedCode(jo);
 	js.startDefaultPrefix = mips_->HasDefaultPrefix();
 	js.currentRoundingFunc = convertS0ToSCRATCH1[mips_->fcr31 & 3];
@@ -174,6 +188,19 @@ void Arm64Jit::ClearCache() {
 	FlushIcacheSection(region + jitStartOffset, region + region_size - jitStartOffset);
 }
 
+// Overflowing the code space throws all blocks away anyway, so take the chance
+// to double the arena (up to branch reach) - long sessions converge on a size
+// where the recompile storms stop instead of recurring every refill.
+void Arm64Jit::GrowCodeSpace() {
+	size_t newSize = std::min(region_size * 2, (size_t)MAX_CODE_SPACE_MB * 1024 * 1024);
+	WARN_LOG(JIT, "JIT code space full, growing %d MB -> %d MB", (int)(region_size >> 20), (int)(newSize >> 20));
+	blocks.Clear();
+	FreeCodeSpace();
+	AllocCodeSpace((int)newSize);
+	GenerateFixedCode(jo);
+	FlushIcacheSection(region, region + region_size);
+}
+
 void Arm64Jit::InvalidateCacheAt(u32 em_address, int length) {
 	blocks.InvalidateICache(em_address, length);
 }
@@ -219,6 +246,12 @@ void Arm64Jit::Compile(u32 em_address) {
 	PROFILE_THIS_SCOPE("jitc");
 	if (GetSpaceLeft() < 0x10000 || blocks.IsFull()) {
 		INFO_LOG(JIT, "Space left: %d", (int)GetSpaceLeft());
+		if (!blocks.IsFull() && region_size < (size_t)MAX_CODE_SPACE_MB * 1024 * 1024) {
+			// We were called from the dispatcher, which executes from this region -
+			// remapping it here would free the code we return into. Clear in place
+			// for now and grow once no generated code is left on the stack.
+			growPending_ = true;
+		}
 		ClearCache();
 	}
 
@@ -263,6 +296,10 @@ void Arm64Jit::Compile(u32 em_address) {
 
 void Arm64Jit::RunLoopUntil(u64 globalticks) {
 	PROFILE_THIS_SCOPE("jit");
+	if (growPending_) {
+		growPending_ = false;
+		GrowCodeSpace();
+	}
 	((void (*)())enterDispatcher)();
 }
 
@@ -316,6 +353,15 @@ const u8 *Arm64Jit::DoJit(u32 em_address, JitBlock *b) {
 	}
 
 	b->normalEntry = GetCodePtr();
+
+	if (g_Config.bJitBlockProfiling) {
+		// SCRATCH1/SCRATCH2 are dead on block entry - the dispatcher uses them.
+		MOVP2R(SCRATCH1_64, blocks.GetExecCounter(b->blockNum));
+		LDR(INDEX_UNSIGNED, SCRATCH2, SCRATCH1_64, 0);
+		ADDI2R(SCRATCH2, SCRATCH2, 1);
+		STR(INDEX_UNSIGNED, SCRATCH2, SCRATCH1_64, 0);
+	}
+
 	// TODO: this needs work
 	MIPSAnalyst::AnalysisResults analysis; // = MIPSAnalyst::Analyze(em_address);
 
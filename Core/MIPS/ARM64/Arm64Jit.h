@@ -189,6 +189,9 @@ public:
 
 private:
 	void GenerateFixedCode(const JitOptions &jo);
+	void GrowCodeSpace();
+	// Set when the code space should be regrown at the next safe point (see Compile()).
+	bool growPending_ = false;
 	void FlushAll();
 	void FlushPrefixV();
 
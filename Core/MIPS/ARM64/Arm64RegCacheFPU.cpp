@@ -49,12 +49,14 @@ void Arm64RegCacheFPU::Start(MIPSAnalyst::AnalysisResults &stats) {
 	memcpy(ar, arInitial, sizeof(ar));
 	memcpy(mr, mrInitial, sizeof(mr));
 	pendingFlush = false;
+	useTick_ = 0;
 }
 
 void Arm64RegCacheFPU::SetupInitialRegs() {
 	for (int i = 0; i < numARMFpuReg_; i++) {
 		arInitial[i].mipsReg = -1;
 		arInitial[i].isDirty = false;
+		arInitial[i].lastUsedTick = 0;
 	}
 	for (int i = 0; i < NUM_MIPSFPUREG; i++) {
 		mrInitial[i].loc = ML_MEM;
@@ -127,6 +129,7 @@ ARM64Reg Arm64RegCacheFPU::MapReg(MIPSReg mipsReg, int mapFlags) {
 		if (mapFlags & MAP_DIRTY) {
 			ar[mr[mipsReg].reg].isDirty = true;
 		}
+		ar[mr[mipsReg].reg].lastUsedTick = ++useTick_;
 		//INFO_LOG(JIT, "Already mapped %i to %i", mipsReg, mr[mipsReg].reg);
 		return (ARM64Reg)(mr[mipsReg].reg + S0);
 	}
@@ -149,6 +152,7 @@ allocate:
 				}
 			}
 			ar[reg].mipsReg = mipsReg;
+			ar[reg].lastUsedTick = ++useTick_;
 			mr[mipsReg].loc = ML_ARMREG;
 			mr[mipsReg].reg = reg;
 			//INFO_LOG(JIT, "Mapped %i to %i", mipsReg, mr[mipsReg].reg);
@@ -157,16 +161,17 @@ allocate:
 	}
 
 
-	// Still nothing. Let's spill a reg and goto 10.
-	// TODO: Use age or something to choose which register to spill?
-	// TODO: Spill dirty regs first? or opposite?
+	// Still nothing. Let's spill the least recently used register and goto 10.
+	// Always picking the first allocatable register here was really bad for VFPU-heavy
+	// blocks - the hottest vectors live at the front of the allocation order, so they
+	// kept getting evicted and reloaded every few instructions.
 	int bestToSpill = -1;
 	for (int i = 0; i < allocCount; i++) {
 		int reg = allocOrder[i] - S0;
 		if (ar[reg].mipsReg != -1 && (mr[ar[reg].mipsReg].spillLock || mr[ar[reg].mipsReg].tempLock))
 			continue;
-		bestToSpill = reg;
-		break;
+		if (bestToSpill == -1 || ar[reg].lastUsedTick < ar[bestToSpill].lastUsedTick)
+			bestToSpill = reg;
 	}
 
 	if (bestToSpill != -1) {
@@ -49,6 +49,7 @@ enum {
 struct FPURegARM64 {
 	int mipsReg;  // if -1, no mipsreg attached.
 	bool isDirty;  // Should the register be written back?
+	int lastUsedTick;  // For LRU spill selection. Bumped every MapReg.
 };
 
 struct FPURegQuad64 {
@@ -163,6 +164,7 @@ private:
 
 	int numARMFpuReg_;
 	int qTime_;
+	int useTick_;
 
 	enum {
 		// On ARM64, each of the 32 registers are full 128-bit. No sharing of components!
@@ -305,9 +305,25 @@ void IRFrontend::Comp_Jump(MIPSOpcode op) {
 		return;
 	}
 
+	// Superblock formation: follow short forward jumps instead of exiting, so
+	// loop bodies with internal skips (compiled else-branches etc.) become one
+	// block and the interpreter pays dispatch once instead of per fragment.
+	// Forward-only guarantees termination, and since the block's original size
+	// is measured from blockStart to the last compiled pc, the gap is covered
+	// and invalidation stays correct.
+	const u32 MAX_SUPERBLOCK_FOLLOW_BYTES = 2048;
+	const int MAX_SUPERBLOCK_INSTRUCTIONS = 1024;
+
 	switch (op >> 26) {
 	case 2: //j
 		CompileDelaySlot();
+		if (targetAddr > GetCompilerPC() + 4 &&
+			targetAddr < js.blockStart + MAX_SUPERBLOCK_FOLLOW_BYTES &&
+			js.numInstructions < MAX_SUPERBLOCK_INSTRUCTIONS) {
+			// The outer loop adds 4 after each op, so position just before the target.
+			js.compilerPC = targetAddr - 4;
+			return;
+		}
 		break;
 
 	case 3: //jal
@@ -27,6 +27,25 @@
 #include "Core/MIPS/IR/IRInterpreter.h"
 #include "Core/System.h"
 
+// On compilers that support the GCC labels-as-values extension, ops are dispatched
+// with computed gotos instead of through the switch statement below. The switch
+// stays as-is - each case just grows a label so the dispatch table can jump
+// straight to it, skipping the range check a switch has to do. Op pairs that
+// would be worth fusing are already single IR ops (ExitToConstIf* for
+// compare+branch, Load8Ext/Load16Ext for load+extend), so the table maps ops
+// one to one.
+#if defined(__GNUC__)
+#define IR_COMPUTED_GOTO 1
+#endif
+
+#if IR_COMPUTED_GOTO
+#define IR_CASE(op) op_##op: case IROp::op
+#define IR_DEFAULT op_Bad: default
+#else
+#define IR_CASE(op) case IROp::op
+#define IR_DEFAULT default
+#endif
+
 alignas(16) static const float vec4InitValues[8][4] = {
 	{ 0.0f, 0.0f, 0.0f, 0.0f },
 	{ 1.0f, 1.0f, 1.0f, 1.0f },
@@ -70,82 +89,239 @@ u32 RunMemCheck(u32 pc, u32 addr) {
 // We cannot use NEON on ARM32 here until we make it a hard dependency. We can, however, on ARM64.
 u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 	const IRInst *end = inst + count;
+#if IR_COMPUTED_GOTO
+	// Dispatch table indexed by the opcode byte. Ops we don't handle jump to the
+	// same place the switch's default would. Filled in lazily on the first run -
+	// label addresses can only be taken inside the function.
+	static const void *dispatchTable[256];
+	if (!dispatchTable[0]) {
+		for (auto &entry : dispatchTable)
+			entry = &&op_Bad;
+		dispatchTable[(u8)IROp::Nop] = &&op_Nop;
+		dispatchTable[(u8)IROp::SetConst] = &&op_SetConst;
+		dispatchTable[(u8)IROp::SetConstF] = &&op_SetConstF;
+		dispatchTable[(u8)IROp::Add] = &&op_Add;
+		dispatchTable[(u8)IROp::Sub] = &&op_Sub;
+		dispatchTable[(u8)IROp::And] = &&op_And;
+		dispatchTable[(u8)IROp::Or] = &&op_Or;
+		dispatchTable[(u8)IROp::Xor] = &&op_Xor;
+		dispatchTable[(u8)IROp::Mov] = &&op_Mov;
+		dispatchTable[(u8)IROp::AddConst] = &&op_AddConst;
+		dispatchTable[(u8)IROp::SubConst] = &&op_SubConst;
+		dispatchTable[(u8)IROp::AndConst] = &&op_AndConst;
+		dispatchTable[(u8)IROp::OrConst] = &&op_OrConst;
+		dispatchTable[(u8)IROp::XorConst] = &&op_XorConst;
+		dispatchTable[(u8)IROp::Neg] = &&op_Neg;
+		dispatchTable[(u8)IROp::Not] = &&op_Not;
+		dispatchTable[(u8)IROp::Ext8to32] = &&op_Ext8to32;
+		dispatchTable[(u8)IROp::Ext16to32] = &&op_Ext16to32;
+		dispatchTable[(u8)IROp::ReverseBits] = &&op_ReverseBits;
+		dispatchTable[(u8)IROp::Load8] = &&op_Load8;
+		dispatchTable[(u8)IROp::Load8Ext] = &&op_Load8Ext;
+		dispatchTable[(u8)IROp::Load16] = &&op_Load16;
+		dispatchTable[(u8)IROp::Load16Ext] = &&op_Load16Ext;
+		dispatchTable[(u8)IROp::Load32] = &&op_Load32;
+		dispatchTable[(u8)IROp::Load32Left] = &&op_Load32Left;
+		dispatchTable[(u8)IROp::Load32Right] = &&op_Load32Right;
+		dispatchTable[(u8)IROp::LoadFloat] = &&op_LoadFloat;
+		dispatchTable[(u8)IROp::Store8] = &&op_Store8;
+		dispatchTable[(u8)IROp::Store16] = &&op_Store16;
+		dispatchTable[(u8)IROp::Store32] = &&op_Store32;
+		dispatchTable[(u8)IROp::Store32Left] = &&op_Store32Left;
+		dispatchTable[(u8)IROp::Store32Right] = &&op_Store32Right;
+		dispatchTable[(u8)IROp::StoreFloat] = &&op_StoreFloat;
+		dispatchTable[(u8)IROp::LoadVec4] = &&op_LoadVec4;
+		dispatchTable[(u8)IROp::StoreVec4] = &&op_StoreVec4;
+		dispatchTable[(u8)IROp::Vec4Init] = &&op_Vec4Init;
+		dispatchTable[(u8)IROp::Vec4Shuffle] = &&op_Vec4Shuffle;
+		dispatchTable[(u8)IROp::Vec4Mov] = &&op_Vec4Mov;
+		dispatchTable[(u8)IROp::Vec4Add] = &&op_Vec4Add;
+		dispatchTable[(u8)IROp::Vec4Sub] = &&op_Vec4Sub;
+		dispatchTable[(u8)IROp::Vec4Mul] = &&op_Vec4Mul;
+		dispatchTable[(u8)IROp::Vec4Div] = &&op_Vec4Div;
+		dispatchTable[(u8)IROp::Vec4Scale] = &&op_Vec4Scale;
+		dispatchTable[(u8)IROp::Vec4Neg] = &&op_Vec4Neg;
+		dispatchTable[(u8)IROp::Vec4Abs] = &&op_Vec4Abs;
+		dispatchTable[(u8)IROp::Vec2Unpack16To31] = &&op_Vec2Unpack16To31;
+		dispatchTable[(u8)IROp::Vec2Unpack16To32] = &&op_Vec2Unpack16To32;
+		dispatchTable[(u8)IROp::Vec4Unpack8To32] = &&op_Vec4Unpack8To32;
+		dispatchTable[(u8)IROp::Vec2Pack32To16] = &&op_Vec2Pack32To16;
+		dispatchTable[(u8)IROp::Vec2Pack31To16] = &&op_Vec2Pack31To16;
+		dispatchTable[(u8)IROp::Vec4Pack32To8] = &&op_Vec4Pack32To8;
+		dispatchTable[(u8)IROp::Vec4Pack31To8] = &&op_Vec4Pack31To8;
+		dispatchTable[(u8)IROp::Vec2ClampToZero] = &&op_Vec2ClampToZero;
+		dispatchTable[(u8)IROp::Vec4ClampToZero] = &&op_Vec4ClampToZero;
+		dispatchTable[(u8)IROp::Vec4DuplicateUpperBitsAndShift1] = &&op_Vec4DuplicateUpperBitsAndShift1;
+		dispatchTable[(u8)IROp::FCmpVfpuBit] = &&op_FCmpVfpuBit;
+		dispatchTable[(u8)IROp::FCmpVfpuAggregate] = &&op_FCmpVfpuAggregate;
+		dispatchTable[(u8)IROp::FCmovVfpuCC] = &&op_FCmovVfpuCC;
+		dispatchTable[(u8)IROp::Vec4Dot] = &&op_Vec4Dot;
+		dispatchTable[(u8)IROp::FSin] = &&op_FSin;
+		dispatchTable[(u8)IROp::FCos] = &&op_FCos;
+		dispatchTable[(u8)IROp::FRSqrt] = &&op_FRSqrt;
+		dispatchTable[(u8)IROp::FRecip] = &&op_FRecip;
+		dispatchTable[(u8)IROp::FAsin] = &&op_FAsin;
+		dispatchTable[(u8)IROp::ShlImm] = &&op_ShlImm;
+		dispatchTable[(u8)IROp::ShrImm] = &&op_ShrImm;
+		dispatchTable[(u8)IROp::SarImm] = &&op_SarImm;
+		dispatchTable[(u8)IROp::RorImm] = &&op_RorImm;
+		dispatchTable[(u8)IROp::Shl] = &&op_Shl;
+		dispatchTable[(u8)IROp::Shr] = &&op_Shr;
+		dispatchTable[(u8)IROp::Sar] = &&op_Sar;
+		dispatchTable[(u8)IROp::Ror] = &&op_Ror;
+		dispatchTable[(u8)IROp::Clz] = &&op_Clz;
+		dispatchTable[(u8)IROp::Slt] = &&op_Slt;
+		dispatchTable[(u8)IROp::SltU] = &&op_SltU;
+		dispatchTable[(u8)IROp::SltConst] = &&op_SltConst;
+		dispatchTable[(u8)IROp::SltUConst] = &&op_SltUConst;
+		dispatchTable[(u8)IROp::MovZ] = &&op_MovZ;
+		dispatchTable[(u8)IROp::MovNZ] = &&op_MovNZ;
+		dispatchTable[(u8)IROp::Max] = &&op_Max;
+		dispatchTable[(u8)IROp::Min] = &&op_Min;
+		dispatchTable[(u8)IROp::MtLo] = &&op_MtLo;
+		dispatchTable[(u8)IROp::MtHi] = &&op_MtHi;
+		dispatchTable[(u8)IROp::MfLo] = &&op_MfLo;
+		dispatchTable[(u8)IROp::MfHi] = &&op_MfHi;
+		dispatchTable[(u8)IROp::Mult] = &&op_Mult;
+		dispatchTable[(u8)IROp::MultU] = &&op_MultU;
+		dispatchTable[(u8)IROp::Madd] = &&op_Madd;
+		dispatchTable[(u8)IROp::MaddU] = &&op_MaddU;
+		dispatchTable[(u8)IROp::Msub] = &&op_Msub;
+		dispatchTable[(u8)IROp::MsubU] = &&op_MsubU;
+		dispatchTable[(u8)IROp::Div] = &&op_Div;
+		dispatchTable[(u8)IROp::DivU] = &&op_DivU;
+		dispatchTable[(u8)IROp::BSwap16] = &&op_BSwap16;
+		dispatchTable[(u8)IROp::BSwap32] = &&op_BSwap32;
+		dispatchTable[(u8)IROp::FAdd] = &&op_FAdd;
+		dispatchTable[(u8)IROp::FSub] = &&op_FSub;
+		dispatchTable[(u8)IROp::FMul] = &&op_FMul;
+		dispatchTable[(u8)IROp::FDiv] = &&op_FDiv;
+		dispatchTable[(u8)IROp::FMin] = &&op_FMin;
+		dispatchTable[(u8)IROp::FMax] = &&op_FMax;
+		dispatchTable[(u8)IROp::FMov] = &&op_FMov;
+		dispatchTable[(u8)IROp::FAbs] = &&op_FAbs;
+		dispatchTable[(u8)IROp::FSqrt] = &&op_FSqrt;
+		dispatchTable[(u8)IROp::FNeg] = &&op_FNeg;
+		dispatchTable[(u8)IROp::FSat0_1] = &&op_FSat0_1;
+		dispatchTable[(u8)IROp::FSatMinus1_1] = &&op_FSatMinus1_1;
+		dispatchTable[(u8)IROp::FSign] = &&op_FSign;
+		dispatchTable[(u8)IROp::FpCondToReg] = &&op_FpCondToReg;
+		dispatchTable[(u8)IROp::VfpuCtrlToReg] = &&op_VfpuCtrlToReg;
+		dispatchTable[(u8)IROp::FRound] = &&op_FRound;
+		dispatchTable[(u8)IROp::FTrunc] = &&op_FTrunc;
+		dispatchTable[(u8)IROp::FCeil] = &&op_FCeil;
+		dispatchTable[(u8)IROp::FFloor] = &&op_FFloor;
+		dispatchTable[(u8)IROp::FCmp] = &&op_FCmp;
+		dispatchTable[(u8)IROp::FCvtSW] = &&op_FCvtSW;
+		dispatchTable[(u8)IROp::FCvtWS] = &&op_FCvtWS;
+		dispatchTable[(u8)IROp::ZeroFpCond] = &&op_ZeroFpCond;
+		dispatchTable[(u8)IROp::FMovFromGPR] = &&op_FMovFromGPR;
+		dispatchTable[(u8)IROp::FMovToGPR] = &&op_FMovToGPR;
+		dispatchTable[(u8)IROp::ExitToConst] = &&op_ExitToConst;
+		dispatchTable[(u8)IROp::ExitToReg] = &&op_ExitToReg;
+		dispatchTable[(u8)IROp::ExitToConstIfEq] = &&op_ExitToConstIfEq;
+		dispatchTable[(u8)IROp::ExitToConstIfNeq] = &&op_ExitToConstIfNeq;
+		dispatchTable[(u8)IROp::ExitToConstIfGtZ] = &&op_ExitToConstIfGtZ;
+		dispatchTable[(u8)IROp::ExitToConstIfGeZ] = &&op_ExitToConstIfGeZ;
+		dispatchTable[(u8)IROp::ExitToConstIfLtZ] = &&op_ExitToConstIfLtZ;
+		dispatchTable[(u8)IROp::ExitToConstIfLeZ] = &&op_ExitToConstIfLeZ;
+		dispatchTable[(u8)IROp::Downcount] = &&op_Downcount;
+		dispatchTable[(u8)IROp::SetPC] = &&op_SetPC;
+		dispatchTable[(u8)IROp::SetPCConst] = &&op_SetPCConst;
+		dispatchTable[(u8)IROp::Syscall] = &&op_Syscall;
+		dispatchTable[(u8)IROp::ExitToPC] = &&op_ExitToPC;
+		dispatchTable[(u8)IROp::Interpret] = &&op_Interpret;
+		dispatchTable[(u8)IROp::CallReplacement] = &&op_CallReplacement;
+		dispatchTable[(u8)IROp::Break] = &&op_Break;
+		dispatchTable[(u8)IROp::SetCtrlVFPU] = &&op_SetCtrlVFPU;
+		dispatchTable[(u8)IROp::SetCtrlVFPUReg] = &&op_SetCtrlVFPUReg;
+		dispatchTable[(u8)IROp::SetCtrlVFPUFReg] = &&op_SetCtrlVFPUFReg;
+		dispatchTable[(u8)IROp::Breakpoint] = &&op_Breakpoint;
+		dispatchTable[(u8)IROp::MemoryCheck] = &&op_MemoryCheck;
+		dispatchTable[(u8)IROp::ApplyRoundingMode] = &&op_ApplyRoundingMode;
+		dispatchTable[(u8)IROp::RestoreRoundingMode] = &&op_RestoreRoundingMode;
+		dispatchTable[(u8)IROp::UpdateRoundingMode] = &&op_UpdateRoundingMode;
+	}
+#endif
 	while (inst != end) {
+#if IR_COMPUTED_GOTO
+		goto *dispatchTable[(u8)inst->op];
+#endif
 		switch (inst->op) {
-		case IROp::Nop:
+		IR_CASE(Nop):
 			_assert_(false);
 			break;
-		case IROp::SetConst:
+		IR_CASE(SetConst):
 			mips->r[inst->dest] = inst->constant;
 			break;
-		case IROp::SetConstF:
+		IR_CASE(SetConstF):
 			memcpy(&mips->f[inst->dest], &inst->constant, 4);
 			break;
-		case IROp::Add:
+		IR_CASE(Add):
 			mips->r[inst->dest] = mips->r[inst->src1] + mips->r[inst->src2];
 			break;
-		case IROp::Sub:
+		IR_CASE(Sub):
 			mips->r[inst->dest] = mips->r[inst->src1] - mips->r[inst->src2];
 			break;
-		case IROp::And:
+		IR_CASE(And):
 			mips->r[inst->dest] = mips->r[inst->src1] & mips->r[inst->src2];
 			break;
-		case IROp::Or:
+		IR_CASE(Or):
 			mips->r[inst->dest] = mips->r[inst->src1] | mips->r[inst->src2];
 			break;
-		case IROp::Xor:
+		IR_CASE(Xor):
 			mips->r[inst->dest] = mips->r[inst->src1] ^ mips->r[inst->src2];
 			break;
-		case IROp::Mov:
+		IR_CASE(Mov):
 			mips->r[inst->dest] = mips->r[inst->src1];
 			break;
-		case IROp::AddConst:
+		IR_CASE(AddConst):
 			mips->r[inst->dest] = mips->r[inst->src1] + inst->constant;
 			break;
-		case IROp::SubConst:
+		IR_CASE(SubConst):
 			mips->r[inst->dest] = mips->r[inst->src1] - inst->constant;
 			break;
-		case IROp::AndConst:
+		IR_CASE(AndConst):
 			mips->r[inst->dest] = mips->r[inst->src1] & inst->constant;
 			break;
-		case IROp::OrConst:
+		IR_CASE(OrConst):
 			mips->r[inst->dest] = mips->r[inst->src1] | inst->constant;
 			break;
-		case IROp::XorConst:
+		IR_CASE(XorConst):
 			mips->r[inst->dest] = mips->r[inst->src1] ^ inst->constant;
 			break;
-		case IROp::Neg:
+		IR_CASE(Neg):
 			mips->r[inst->dest] = -(s32)mips->r[inst->src1];
 			break;
-		case IROp::Not:
+		IR_CASE(Not):
 			mips->r[inst->dest] = ~mips->r[inst->src1];
 			break;
-		case IROp::Ext8to32:
+		IR_CASE(Ext8to32):
 			mips->r[inst->dest] = (s32)(s8)mips->r[inst->src1];
 			break;
-		case IROp::Ext16to32:
+		IR_CASE(Ext16to32):
 			mips->r[inst->dest] = (s32)(s16)mips->r[inst->src1];
 			break;
-		case IROp::ReverseBits:
+		IR_CASE(ReverseBits):
 			mips->r[inst->dest] = ReverseBits32(mips->r[inst->src1]);
 			break;
 
-		case IROp::Load8:
+		IR_CASE(Load8):
 			mips->r[inst->dest] = Memory::ReadUnchecked_U8(mips->r[inst->src1] + inst->constant);
 			break;
-		case IROp::Load8Ext:
+		IR_CASE(Load8Ext):
 			mips->r[inst->dest] = (s32)(s8)Memory::ReadUnchecked_U8(mips->r[inst->src1] + inst->constant);
 			break;
-		case IROp::Load16:
+		IR_CASE(Load16):
 			mips->r[inst->dest] = Memory::ReadUnchecked_U16(mips->r[inst->src1] + inst->constant);
 			break;
-		case IROp::Load16Ext:
+		IR_CASE(Load16Ext):
 			mips->r[inst->dest] = (s32)(s16)Memory::ReadUnchecked_U16(mips->r[inst->src1] + inst->constant);
 			break;
-		case IROp::Load32:
+		IR_CASE(Load32):
 			mips->r[inst->dest] = Memory::ReadUnchecked_U32(mips->r[inst->src1] + inst->constant);
 			break;
-		case IROp::Load32Left:
+		IR_CASE(Load32Left):
 		{
 			u32 addr = mips->r[inst->src1] + inst->constant;
 			u32 shift = (addr & 3) * 8;
@@ -154,7 +330,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			mips->r[inst->dest] = (mips->r[inst->dest] & destMask) | (mem << (24 - shift));
 			break;
 		}
-		case IROp::Load32Right:
+		IR_CASE(Load32Right):
 		{
 			u32 addr = mips->r[inst->src1] + inst->constant;
 			u32 shift = (addr & 3) * 8;
@@ -163,20 +339,20 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			mips->r[inst->dest] = (mips->r[inst->dest] & destMask) | (mem >> shift);
 			break;
 		}
-		case IROp::LoadFloat:
+		IR_CASE(LoadFloat):
 			mips->f[inst->dest] = Memory::ReadUnchecked_Float(mips->r[inst->src1] + inst->constant);
 			break;
 
-		case IROp::Store8:
+		IR_CASE(Store8):
 			Memory::WriteUnchecked_U8(mips->r[inst->src3], mips->r[inst->src1] + inst->constant);
 			break;
-		case IROp::Store16:
+		IR_CASE(Store16):
 			Memory::WriteUnchecked_U16(mips->r[inst->src3], mips->r[inst->src1] + inst->constant);
 			break;
-		case IROp::Store32:
+		IR_CASE(Store32):
 			Memory::WriteUnchecked_U32(mips->r[inst->src3], mips->r[inst->src1] + inst->constant);
 			break;
-		case IROp::Store32Left:
+		IR_CASE(Store32Left):
 		{
 			u32 addr = mips->r[inst->src1] + inst->constant;
 			u32 shift = (addr & 3) * 8;
@@ -186,7 +362,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			Memory::WriteUnchecked_U32(result, addr & 0xfffffffc);
 			break;
 		}
-		case IROp::Store32Right:
+		IR_CASE(Store32Right):
 		{
 			u32 addr = mips->r[inst->src1] + inst->constant;
 			u32 shift = (addr & 3) * 8;
@@ -196,11 +372,11 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			Memory::WriteUnchecked_U32(result, addr & 0xfffffffc);
 			break;
 		}
-		case IROp::StoreFloat:
+		IR_CASE(StoreFloat):
 			Memory::WriteUnchecked_Float(mips->f[inst->src3], mips->r[inst->src1] + inst->constant);
 			break;
 
-		case IROp::LoadVec4:
+		IR_CASE(LoadVec4):
 		{
 			u32 base = mips->r[inst->src1] + inst->constant;
 #if defined(_M_SSE)
@@ -211,7 +387,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 #endif
 			break;
 		}
-		case IROp::StoreVec4:
+		IR_CASE(StoreVec4):
 		{
 			u32 base = mips->r[inst->src1] + inst->constant;
 #if defined(_M_SSE)
@@ -223,7 +399,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4Init:
+		IR_CASE(Vec4Init):
 		{
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_load_ps(vec4InitValues[inst->src1]));
@@ -233,7 +409,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4Shuffle:
+		IR_CASE(Vec4Shuffle):
 		{
 			// Can't use the SSE shuffle here because it takes an immediate. pshufb with a table would work though,
 			// or a big switch - there are only 256 shuffles possible (4^4)
@@ -242,7 +418,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4Mov:
+		IR_CASE(Vec4Mov):
 		{
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_load_ps(&mips->f[inst->src1]));
@@ -254,7 +430,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4Add:
+		IR_CASE(Vec4Add):
 		{
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_add_ps(_mm_load_ps(&mips->f[inst->src1]), _mm_load_ps(&mips->f[inst->src2])));
@@ -267,7 +443,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4Sub:
+		IR_CASE(Vec4Sub):
 		{
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_sub_ps(_mm_load_ps(&mips->f[inst->src1]), _mm_load_ps(&mips->f[inst->src2])));
@@ -280,7 +456,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4Mul:
+		IR_CASE(Vec4Mul):
 		{
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_mul_ps(_mm_load_ps(&mips->f[inst->src1]), _mm_load_ps(&mips->f[inst->src2])));
@@ -293,10 +469,12 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4Div:
+		IR_CASE(Vec4Div):
 		{
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_div_ps(_mm_load_ps(&mips->f[inst->src1]), _mm_load_ps(&mips->f[inst->src2])));
+#elif PPSSPP_ARCH(ARM64)
+			vst1q_f32(&mips->f[inst->dest], vdivq_f32(vld1q_f32(&mips->f[inst->src1]), vld1q_f32(&mips->f[inst->src2])));
 #else
 			for (int i = 0; i < 4; i++)
 				mips->f[inst->dest + i] = mips->f[inst->src1 + i] / mips->f[inst->src2 + i];
@@ -304,10 +482,12 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4Scale:
+		IR_CASE(Vec4Scale):
 		{
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_mul_ps(_mm_load_ps(&mips->f[inst->src1]), _mm_set1_ps(mips->f[inst->src2])));
+#elif PPSSPP_ARCH(ARM64)
+			vst1q_f32(&mips->f[inst->dest], vmulq_n_f32(vld1q_f32(&mips->f[inst->src1]), mips->f[inst->src2]));
 #else
 			for (int i = 0; i < 4; i++)
 				mips->f[inst->dest + i] = mips->f[inst->src1 + i] * mips->f[inst->src2];
@@ -315,7 +495,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4Neg:
+		IR_CASE(Vec4Neg):
 		{
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_xor_ps(_mm_load_ps(&mips->f[inst->src1]), _mm_load_ps((const float *)signBits)));
@@ -328,7 +508,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4Abs:
+		IR_CASE(Vec4Abs):
 		{
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_and_ps(_mm_load_ps(&mips->f[inst->src1]), _mm_load_ps((const float *)noSignMask)));
@@ -341,21 +521,21 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec2Unpack16To31:
+		IR_CASE(Vec2Unpack16To31):
 		{
 			mips->fi[inst->dest] = (mips->fi[inst->src1] << 16) >> 1;
 			mips->fi[inst->dest + 1] = (mips->fi[inst->src1] & 0xFFFF0000) >> 1;
 			break;
 		}
 
-		case IROp::Vec2Unpack16To32:
+		IR_CASE(Vec2Unpack16To32):
 		{
 			mips->fi[inst->dest] = (mips->fi[inst->src1] << 16);
 			mips->fi[inst->dest + 1] = (mips->fi[inst->src1] & 0xFFFF0000);
 			break;
 		}
 
-		case IROp::Vec4Unpack8To32:
+		IR_CASE(Vec4Unpack8To32):
 		{
 #if defined(_M_SSE)
 			__m128i src = _mm_cvtsi32_si128(mips->fi[inst->src1]);
@@ -371,14 +551,14 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec2Pack32To16:
+		IR_CASE(Vec2Pack32To16):
 		{
 			u32 val = mips->fi[inst->src1] >> 16;
 			mips->fi[inst->dest] = (mips->fi[inst->src1 + 1] & 0xFFFF0000) | val;
 			break;
 		}
 
-		case IROp::Vec2Pack31To16:
+		IR_CASE(Vec2Pack31To16):
 		{
 			u32 val = (mips->fi[inst->src1] >> 15) & 0xFFFF;
 			val |= (mips->fi[inst->src1 + 1] << 1) & 0xFFFF0000;
@@ -386,7 +566,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4Pack32To8:
+		IR_CASE(Vec4Pack32To8):
 		{
 			// Removed previous SSE code due to the need for unsigned 16-bit pack, which I'm too lazy to work around the lack of in SSE2.
 			// pshufb or SSE4 instructions can be used instead.
@@ -398,7 +578,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4Pack31To8:
+		IR_CASE(Vec4Pack31To8):
 		{
 			// Removed previous SSE code due to the need for unsigned 16-bit pack, which I'm too lazy to work around the lack of in SSE2.
 			// pshufb or SSE4 instructions can be used instead.
@@ -410,7 +590,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec2ClampToZero:
+		IR_CASE(Vec2ClampToZero):
 		{
 			for (int i = 0; i < 2; i++) {
 				u32 val = mips->fi[inst->src1 + i];
@@ -419,7 +599,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4ClampToZero:
+		IR_CASE(Vec4ClampToZero):
 		{
 #if defined(_M_SSE)
 			// Trickery: Expand the sign bit, and use andnot to zero negative values.
@@ -436,7 +616,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Vec4DuplicateUpperBitsAndShift1:  // For vuc2i, the weird one.
+		IR_CASE(Vec4DuplicateUpperBitsAndShift1):  // For vuc2i, the weird one.
 		{
 			for (int i = 0; i < 4; i++) {
 				u32 val = mips->fi[inst->src1 + i];
@@ -448,7 +628,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::FCmpVfpuBit:
+		IR_CASE(FCmpVfpuBit):
 		{
 			int op = inst->dest & 0xF;
 			int bit = inst->dest >> 4;
@@ -481,7 +661,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::FCmpVfpuAggregate:
+		IR_CASE(FCmpVfpuAggregate):
 		{
 			u32 mask = inst->dest;
 			u32 cc = mips->vfpuCtrl[VFPU_CTRL_CC];
@@ -491,48 +671,60 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::FCmovVfpuCC:
+		IR_CASE(FCmovVfpuCC):
 			if (((mips->vfpuCtrl[VFPU_CTRL_CC] >> (inst->src2 & 0xf)) & 1) == ((u32)inst->src2 >> 7)) {
 				mips->f[inst->dest] = mips->f[inst->src1];
 			}
 			break;
 
-		// Not quickly implementable on all platforms, unfortunately.
-		case IROp::Vec4Dot:
+		IR_CASE(Vec4Dot):
 		{
+			// Pairwise reduction, like the hardware's adder tree. Differs from a
+			// strict sequential sum in the last bit now and then, but so does the VFPU.
+#if defined(_M_SSE)
+			__m128 a = _mm_mul_ps(_mm_load_ps(&mips->f[inst->src1]), _mm_load_ps(&mips->f[inst->src2]));
+			__m128 b = _mm_add_ps(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)));
+			__m128 c = _mm_add_ps(b, _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)));
+			_mm_store_ss(&mips->f[inst->dest], c);
+#elif PPSSPP_ARCH(ARM64)
+			float32x4_t a = vmulq_f32(vld1q_f32(&mips->f[inst->src1]), vld1q_f32(&mips->f[inst->src2]));
+			float32x2_t b = vadd_f32(vget_low_f32(a), vget_high_f32(a));
+			mips->f[inst->dest] = vget_lane_f32(vpadd_f32(b, b), 0);
+#else
 			float dot = mips->f[inst->src1] * mips->f[inst->src2];
 			for (int i = 1; i < 4; i++)
 				dot += mips->f[inst->src1 + i] * mips->f[inst->src2 + i];
 			mips->f[inst->dest] = dot;
+#endif
 			break;
 		}
 
-		case IROp::FSin:
+		IR_CASE(FSin):
 			mips->f[inst->dest] = vfpu_sin(mips->f[inst->src1]);
 			break;
-		case IROp::FCos:
+		IR_CASE(FCos):
 			mips->f[inst->dest] = vfpu_cos(mips->f[inst->src1]);
 			break;
-		case IROp::FRSqrt:
+		IR_CASE(FRSqrt):
 			mips->f[inst->dest] = 1.0f / sqrtf(mips->f[inst->src1]);
 			break;
-		case IROp::FRecip:
+		IR_CASE(FRecip):
 			mips->f[inst->dest] = 1.0f / mips->f[inst->src1];
 			break;
-		case IROp::FAsin:
+		IR_CASE(FAsin):
 			mips->f[inst->dest] = vfpu_asin(mips->f[inst->src1]);
 			break;
 
-		case IROp::ShlImm:
+		IR_CASE(ShlImm):
 			mips->r[inst->dest] = mips->r[inst->src1] << (int)inst->src2;
 			break;
-		case IROp::ShrImm:
+		IR_CASE(ShrImm):
 			mips->r[inst->dest] = mips->r[inst->src1] >> (int)inst->src2;
 			break;
-		case IROp::SarImm:
+		IR_CASE(SarImm):
 			mips->r[inst->dest] = (s32)mips->r[inst->src1] >> (int)inst->src2;
 			break;
-		case IROp::RorImm:
+		IR_CASE(RorImm):
 		{
 			u32 x = mips->r[inst->src1];
 			int sa = inst->src2;
@@ -540,16 +732,16 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 		}
 		break;
 
-		case IROp::Shl:
+		IR_CASE(Shl):
 			mips->r[inst->dest] = mips->r[inst->src1] << (mips->r[inst->src2] & 31);
 			break;
-		case IROp::Shr:
+		IR_CASE(Shr):
 			mips->r[inst->dest] = mips->r[inst->src1] >> (mips->r[inst->src2] & 31);
 			break;
-		case IROp::Sar:
+		IR_CASE(Sar):
 			mips->r[inst->dest] = (s32)mips->r[inst->src1] >> (mips->r[inst->src2] & 31);
 			break;
-		case IROp::Ror:
+		IR_CASE(Ror):
 		{
 			u32 x = mips->r[inst->src1];
 			int sa = mips->r[inst->src2] & 31;
@@ -557,7 +749,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Clz:
+		IR_CASE(Clz):
 		{
 			int x = 31;
 			int count = 0;
@@ -570,64 +762,64 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Slt:
+		IR_CASE(Slt):
 			mips->r[inst->dest] = (s32)mips->r[inst->src1] < (s32)mips->r[inst->src2];
 			break;
 
-		case IROp::SltU:
+		IR_CASE(SltU):
 			mips->r[inst->dest] = mips->r[inst->src1] < mips->r[inst->src2];
 			break;
 
-		case IROp::SltConst:
+		IR_CASE(SltConst):
 			mips->r[inst->dest] = (s32)mips->r[inst->src1] < (s32)inst->constant;
 			break;
 
-		case IROp::SltUConst:
+		IR_CASE(SltUConst):
 			mips->r[inst->dest] = mips->r[inst->src1] < inst->constant;
 			break;
 
-		case IROp::MovZ:
+		IR_CASE(MovZ):
 			if (mips->r[inst->src1] == 0)
 				mips->r[inst->dest] = mips->r[inst->src2];
 			break;
-		case IROp::MovNZ:
+		IR_CASE(MovNZ):
 			if (mips->r[inst->src1] != 0)
 				mips->r[inst->dest] = mips->r[inst->src2];
 			break;
 
-		case IROp::Max:
+		IR_CASE(Max):
 			mips->r[inst->dest] = (s32)mips->r[inst->src1] > (s32)mips->r[inst->src2] ? mips->r[inst->src1] : mips->r[inst->src2];
 			break;
-		case IROp::Min:
+		IR_CASE(Min):
 			mips->r[inst->dest] = (s32)mips->r[inst->src1] < (s32)mips->r[inst->src2] ? mips->r[inst->src1] : mips->r[inst->src2];
 			break;
 
-		case IROp::MtLo:
+		IR_CASE(MtLo):
 			mips->lo = mips->r[inst->src1];
 			break;
-		case IROp::MtHi:
+		IR_CASE(MtHi):
 			mips->hi = mips->r[inst->src1];
 			break;
-		case IROp::MfLo:
+		IR_CASE(MfLo):
 			mips->r[inst->dest] = mips->lo;
 			break;
-		case IROp::MfHi:
+		IR_CASE(MfHi):
 			mips->r[inst->dest] = mips->hi;
 			break;
 
-		case IROp::Mult:
+		IR_CASE(Mult):
 		{
 			s64 result = (s64)(s32)mips->r[inst->src1] * (s64)(s32)mips->r[inst->src2];
 			memcpy(&mips->lo, &result, 8);
 			break;
 		}
-		case IROp::MultU:
+		IR_CASE(MultU):
 		{
 			u64 result = (u64)mips->r[inst->src1] * (u64)mips->r[inst->src2];
 			memcpy(&mips->lo, &result, 8);
 			break;
 		}
-		case IROp::Madd:
+		IR_CASE(Madd):
 		{
 			s64 result;
 			memcpy(&result, &mips->lo, 8);
@@ -635,7 +827,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			memcpy(&mips->lo, &result, 8);
 			break;
 		}
-		case IROp::MaddU:
+		IR_CASE(MaddU):
 		{
 			s64 result;
 			memcpy(&result, &mips->lo, 8);
@@ -643,7 +835,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			memcpy(&mips->lo, &result, 8);
 			break;
 		}
-		case IROp::Msub:
+		IR_CASE(Msub):
 		{
 			s64 result;
 			memcpy(&result, &mips->lo, 8);
@@ -651,7 +843,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			memcpy(&mips->lo, &result, 8);
 			break;
 		}
-		case IROp::MsubU:
+		IR_CASE(MsubU):
 		{
 			s64 result;
 			memcpy(&result, &mips->lo, 8);
@@ -660,7 +852,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Div:
+		IR_CASE(Div):
 		{
 			s32 numerator = (s32)mips->r[inst->src1];
 			s32 denominator = (s32)mips->r[inst->src2];
@@ -676,7 +868,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			}
 			break;
 		}
-		case IROp::DivU:
+		IR_CASE(DivU):
 		{
 			u32 numerator = mips->r[inst->src1];
 			u32 denominator = mips->r[inst->src2];
@@ -690,60 +882,60 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::BSwap16:
+		IR_CASE(BSwap16):
 		{
 			u32 x = mips->r[inst->src1];
 			mips->r[inst->dest] = ((x & 0xFF00FF00) >> 8) | ((x & 0x00FF00FF) << 8);
 			break;
 		}
-		case IROp::BSwap32:
+		IR_CASE(BSwap32):
 		{
 			u32 x = mips->r[inst->src1];
 			mips->r[inst->dest] = ((x & 0xFF000000) >> 24) | ((x & 0x00FF0000) >> 8) | ((x & 0x0000FF00) << 8) | ((x & 0x000000FF) << 24);
 			break;
 		}
 
-		case IROp::FAdd:
+		IR_CASE(FAdd):
 			mips->f[inst->dest] = mips->f[inst->src1] + mips->f[inst->src2];
 			break;
-		case IROp::FSub:
+		IR_CASE(FSub):
 			mips->f[inst->dest] = mips->f[inst->src1] - mips->f[inst->src2];
 			break;
-		case IROp::FMul:
+		IR_CASE(FMul):
 			mips->f[inst->dest] = mips->f[inst->src1] * mips->f[inst->src2];
 			break;
-		case IROp::FDiv:
+		IR_CASE(FDiv):
 			mips->f[inst->dest] = mips->f[inst->src1] / mips->f[inst->src2];
 			break;
-		case IROp::FMin:
+		IR_CASE(FMin):
 			mips->f[inst->dest] = std::min(mips->f[inst->src1], mips->f[inst->src2]);
 			break;
-		case IROp::FMax:
+		IR_CASE(FMax):
 			mips->f[inst->dest] = std::max(mips->f[inst->src1], mips->f[inst->src2]);
 			break;
 
-		case IROp::FMov:
+		IR_CASE(FMov):
 			mips->f[inst->dest] = mips->f[inst->src1];
 			break;
-		case IROp::FAbs:
+		IR_CASE(FAbs):
 			mips->f[inst->dest] = fabsf(mips->f[inst->src1]);
 			break;
-		case IROp::FSqrt:
+		IR_CASE(FSqrt):
 			mips->f[inst->dest] = sqrtf(mips->f[inst->src1]);
 			break;
-		case IROp::FNeg:
+		IR_CASE(FNeg):
 			mips->f[inst->dest] = -mips->f[inst->src1];
 			break;
-		case IROp::FSat0_1:
+		IR_CASE(FSat0_1):
 			// We have to do this carefully to handle NAN and -0.0f.
 			mips->f[inst->dest] = vfpu_clamp(mips->f[inst->src1], 0.0f, 1.0f);
 			break;
-		case IROp::FSatMinus1_1:
+		IR_CASE(FSatMinus1_1):
 			mips->f[inst->dest] = vfpu_clamp(mips->f[inst->src1], -1.0f, 1.0f);
 			break;
 
 		// Bitwise trickery
-		case IROp::FSign:
+		IR_CASE(FSign):
 		{
 			u32 val;
 			memcpy(&val, &mips->f[inst->src1], sizeof(u32));
@@ -756,13 +948,13 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::FpCondToReg:
+		IR_CASE(FpCondToReg):
 			mips->r[inst->dest] = mips->fpcond;
 			break;
-		case IROp::VfpuCtrlToReg:
+		IR_CASE(VfpuCtrlToReg):
 			mips->r[inst->dest] = mips->vfpuCtrl[inst->src1];
 			break;
-		case IROp::FRound:
+		IR_CASE(FRound):
 		{
 			float value = mips->f[inst->src1];
 			if (my_isnanorinf(value)) {
@@ -773,7 +965,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			}
 			break;
 		}
-		case IROp::FTrunc:
+		IR_CASE(FTrunc):
 		{
 			float value = mips->f[inst->src1];
 			if (my_isnanorinf(value)) {
@@ -793,7 +985,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 				break;
 			}
 		}
-		case IROp::FCeil:
+		IR_CASE(FCeil):
 		{
 			float value = mips->f[inst->src1];
 			if (my_isnanorinf(value)) {
@@ -804,7 +996,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			}
 			break;
 		}
-		case IROp::FFloor:
+		IR_CASE(FFloor):
 		{
 			float value = mips->f[inst->src1];
 			if (my_isnanorinf(value)) {
@@ -815,7 +1007,7 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			}
 			break;
 		}
-		case IROp::FCmp:
+		IR_CASE(FCmp):
 			switch (inst->dest) {
 			case IRFpCompareMode::False:
 				mips->fpcond = 0;
@@ -842,10 +1034,10 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			}
 			break;
 
-		case IROp::FCvtSW:
+		IR_CASE(FCvtSW):
 			mips->f[inst->dest] = (float)mips->fs[inst->src1];
 			break;
-		case IROp::FCvtWS:
+		IR_CASE(FCvtWS):
 		{
 			float src = mips->f[inst->src1];
 			if (my_isnanorinf(src)) {
@@ -861,61 +1053,61 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break; //cvt.w.s
 		}
 
-		case IROp::ZeroFpCond:
+		IR_CASE(ZeroFpCond):
 			mips->fpcond = 0;
 			break;
 
-		case IROp::FMovFromGPR:
+		IR_CASE(FMovFromGPR):
 			memcpy(&mips->f[inst->dest], &mips->r[inst->src1], 4);
 			break;
-		case IROp::FMovToGPR:
+		IR_CASE(FMovToGPR):
 			memcpy(&mips->r[inst->dest], &mips->f[inst->src1], 4);
 			break;
 
-		case IROp::ExitToConst:
+		IR_CASE(ExitToConst):
 			return inst->constant;
 
-		case IROp::ExitToReg:
+		IR_CASE(ExitToReg):
 			return mips->r[inst->src1];
 
-		case IROp::ExitToConstIfEq:
+		IR_CASE(ExitToConstIfEq):
 			if (mips->r[inst->src1] == mips->r[inst->src2])
 				return inst->constant;
 			break;
-		case IROp::ExitToConstIfNeq:
+		IR_CASE(ExitToConstIfNeq):
 			if (mips->r[inst->src1] != mips->r[inst->src2])
 				return inst->constant;
 			break;
-		case IROp::ExitToConstIfGtZ:
+		IR_CASE(ExitToConstIfGtZ):
 			if ((s32)mips->r[inst->src1] > 0)
 				return inst->constant;
 			break;
-		case IROp::ExitToConstIfGeZ:
+		IR_CASE(ExitToConstIfGeZ):
 			if ((s32)mips->r[inst->src1] >= 0)
 				return inst->constant;
 			break;
-		case IROp::ExitToConstIfLtZ:
+		IR_CASE(ExitToConstIfLtZ):
 			if ((s32)mips->r[inst->src1] < 0)
 				return inst->constant;
 			break;
-		case IROp::ExitToConstIfLeZ:
+		IR_CASE(ExitToConstIfLeZ):
 			if ((s32)mips->r[inst->src1] <= 0)
 				return inst->constant;
 			break;
 
-		case IROp::Downcount:
+		IR_CASE(Downcount):
 			mips->downcount -= inst->constant;
 			break;
 
-		case IROp::SetPC:
+		IR_CASE(SetPC):
 			mips->pc = mips->r[inst->src1];
 			break;
 
-		case IROp::SetPCConst:
+		IR_CASE(SetPCConst):
 			mips->pc = inst->constant;
 			break;
 
-		case IROp::Syscall:
+		IR_CASE(Syscall):
 			// IROp::SetPC was (hopefully) executed before.
 		{
 			MIPSOpcode op(inst->constant);
@@ -925,17 +1117,17 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::ExitToPC:
+		IR_CASE(ExitToPC):
 			return mips->pc;
 
-		case IROp::Interpret:  // SLOW fallback. Can be made faster. Ideally should be removed but may be useful for debugging.
+		IR_CASE(Interpret):  // SLOW fallback. Can be made faster. Ideally should be removed but may be useful for debugging.
 		{
 			MIPSOpcode op(inst->constant);
 			MIPSInterpret(op);
 			break;
 		}
 
-		case IROp::CallReplacement:
+		IR_CASE(CallReplacement):
 		{
 			int funcIndex = inst->constant;
 			const ReplacementTableEntry *f = GetReplacementFunc(funcIndex);
@@ -944,50 +1136,50 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			break;
 		}
 
-		case IROp::Break:
+		IR_CASE(Break):
 			if (!g_Config.bIgnoreBadMemAccess) {
 				Core_EnableStepping(true);
 				host->SetDebugMode(true);
 			}
 			return mips->pc + 4;
 
-		case IROp::SetCtrlVFPU:
+		IR_CASE(SetCtrlVFPU):
 			mips->vfpuCtrl[inst->dest] = inst->constant;
 			break;
 
-		case IROp::SetCtrlVFPUReg:
+		IR_CASE(SetCtrlVFPUReg):
 			mips->vfpuCtrl[inst->dest] = mips->r[inst->src1];
 			break;
 
-		case IROp::SetCtrlVFPUFReg:
+		IR_CASE(SetCtrlVFPUFReg):
 			memcpy(&mips->vfpuCtrl[inst->dest], &mips->f[inst->src1], 4);
 			break;
 
-		case IROp::Breakpoint:
+		IR_CASE(Breakpoint):
 			if (RunBreakpoint(mips->pc)) {
 				CoreTiming::ForceCheck();
 				return mips->pc;
 			}
 			break;
 
-		case IROp::MemoryCheck:
+		IR_CASE(MemoryCheck):
 			if (RunMemCheck(mips->pc, mips->r[inst->src1] + inst->constant)) {
 				CoreTiming::ForceCheck();
 				return mips->pc;
 			}
 			break;
 
-		case IROp::ApplyRoundingMode:
+		IR_CASE(ApplyRoundingMode):
 			// TODO: Implement
 			break;
-		case IROp::RestoreRoundingMode:
+		IR_CASE(RestoreRoundingMode):
 			// TODO: Implement
 			break;
-		case IROp::UpdateRoundingMode:
+		IR_CASE(UpdateRoundingMode):
 			// TODO: Implement
 			break;
 
-		default:
+		IR_DEFAULT:
 			// Unimplemented IR op. Bad.
 			Crash();
 		}
@@ -901,6 +901,137 @@ bool PurgeTemps(const IRWriter &in, IRWriter &out, const IROptions &opts) {
 	return logBlocks;
 }
 
+// Width of an FPR-space operand (all of these index into mips->f).
+static int IRFPRWidth(char type) {
+	switch (type) {
+	case 'F': return 1;
+	case '2': return 2;
+	case 'V': return 4;
+	default: return 0;
+	}
+}
+
+// PurgeTemps handles dead GPR writes; this handles the float register file
+// (scalar FPU and VFPU share mips->f) and also sinks Downcount updates to the
+// next exit, merging them and dropping the zero-amount ones the frontend
+// emits for back-to-back branches.
+bool RemoveDeadStores(const IRWriter &in, IRWriter &out, const IROptions &opts) {
+	std::vector<IRInst> insts;
+	insts.reserve(in.GetInstructions().size());
+
+	struct FPRWrite {
+		int reg;
+		int width;
+		int index;
+	};
+	std::vector<FPRWrite> writes;
+
+	u32 pendingDowncount = 0;
+	bool hasPendingDowncount = false;
+
+	auto overlaps = [](int reg, int width, const FPRWrite &w) {
+		return reg < w.reg + w.width && w.reg < reg + width;
+	};
+
+	for (int i = 0, n = (int)in.GetInstructions().size(); i < n; i++) {
+		IRInst inst = in.GetInstructions()[i];
+		const IRMeta *m = GetIRMeta(inst.op);
+
+		if (inst.op == IROp::Downcount) {
+			pendingDowncount += inst.constant;
+			hasPendingDowncount = true;
+			continue;
+		}
+
+		// Anything that can leave the block (or run arbitrary code) observes
+		// both the downcount and the register file.
+		bool barrier = (m->flags & IRFLAG_EXIT) != 0 ||
+			inst.op == IROp::Interpret || inst.op == IROp::CallReplacement ||
+			inst.op == IROp::Syscall || inst.op == IROp::Break || inst.op == IROp::Breakpoint;
+		if (barrier) {
+			if (hasPendingDowncount) {
+				if (pendingDowncount != 0) {
+					IRInst dc{};
+					dc.op = IROp::Downcount;
+					dc.constant = pendingDowncount;
+					insts.push_back(dc);
+				}
+				pendingDowncount = 0;
+				hasPendingDowncount = false;
+			}
+			writes.clear();
+			insts.push_back(inst);
+			continue;
+		}
+
+		// Collect this instruction's FPR reads.
+		int readReg[3], readWidth[3], numReads = 0;
+		if (int w = IRFPRWidth(m->types[1])) {
+			readReg[numReads] = inst.src1;
+			readWidth[numReads++] = w;
+		}
+		if (int w = IRFPRWidth(m->types[2])) {
+			readReg[numReads] = inst.src2;
+			readWidth[numReads++] = w;
+		}
+		bool src3Mode = (m->flags & (IRFLAG_SRC3 | IRFLAG_SRC3DST)) != 0;
+		if (src3Mode) {
+			if (int w = IRFPRWidth(m->types[0])) {
+				readReg[numReads] = inst.src3;
+				readWidth[numReads++] = w;
+			}
+		}
+
+		for (size_t j = 0; j < writes.size(); ) {
+			bool read = false;
+			for (int r = 0; r < numReads; r++)
+				read = read || overlaps(readReg[r], readWidth[r], writes[j]);
+			if (read) {
+				// Legitimately read, not a candidate anymore.
+				writes.erase(writes.begin() + j);
+			} else {
+				j++;
+			}
+		}
+
+		int destWidth = !src3Mode ? IRFPRWidth(m->types[0]) : 0;
+		if (destWidth) {
+			for (size_t j = 0; j < writes.size(); ) {
+				if (writes[j].reg >= inst.dest && writes[j].reg + writes[j].width <= inst.dest + destWidth) {
+					// Fully overwritten before any read or exit - dead, purge it.
+					insts[writes[j].index].op = IROp::Mov;
+					insts[writes[j].index].dest = 0;
+					insts[writes[j].index].src1 = 0;
+					writes.erase(writes.begin() + j);
+				} else if (overlaps(inst.dest, destWidth, writes[j])) {
+					// Partially overwritten, too messy to track.
+					writes.erase(writes.begin() + j);
+				} else {
+					j++;
+				}
+			}
+			writes.push_back(FPRWrite{ inst.dest, destWidth, (int)insts.size() });
+		}
+
+		insts.push_back(inst);
+	}
+
+	if (hasPendingDowncount && pendingDowncount != 0) {
+		IRInst dc{};
+		dc.op = IROp::Downcount;
+		dc.constant = pendingDowncount;
+		insts.push_back(dc);
+	}
+
+	for (const IRInst &inst : insts) {
+		if (inst.op != IROp::Mov || inst.dest != 0 || inst.src1 != 0) {
+			out.Write(inst);
+		}
+	}
+
+	return false;
+}
+
 bool ReduceLoads(const IRWriter &in, IRWriter &out, const IROptions &opts) {
 	// This tells us to skip an AND op that has been optimized out.
 	// Maybe we could skip multiple, but that'd slow things down and is pretty uncommon.
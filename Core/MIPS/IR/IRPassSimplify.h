@@ -9,6 +9,7 @@ bool IRApplyPasses(const IRPassFunc *passes, size_t c, const IRWriter &in, IRWri
 bool RemoveLoadStoreLeftRight(const IRWriter &in, IRWriter &out, const IROptions &opts);
 bool PropagateConstants(const IRWriter &in, IRWriter &out, const IROptions &opts);
 bool PurgeTemps(const IRWriter &in, IRWriter &out, const IROptions &opts);
+bool RemoveDeadStores(const IRWriter &in, IRWriter &out, const IROptions &opts);
 bool ReduceLoads(const IRWriter &in, IRWriter &out, const IROptions &opts);
 bool ThreeOpToTwoOp(const IRWriter &in, IRWriter &out, const IROptions &opts);
 bool OptimizeFPMoves(const IRWriter &in, IRWriter &out, const IROptions &opts);
@@ -61,10 +61,23 @@ const u32 INVALID_EXIT = 0xFFFFFFFF;
 
 JitBlockCache::JitBlockCache(MIPSState *mips, CodeBlockCommon *codeBlock) :
 	codeBlock_(codeBlock), blocks_(nullptr), num_blocks_(0) {
+	// Allocated here rather than in Init() so the pointer stays stable across
+	// Reset() - the emitted dispatcher bakes it into generated code.
+	fastBlockLookup_ = new JitBlockLookupEntry[JITBLOCK_LOOKUP_ENTRIES];
+	memset(fastBlockLookup_, 0, sizeof(JitBlockLookupEntry) * JITBLOCK_LOOKUP_ENTRIES);
+	execCounters_ = new u32[MAX_NUM_BLOCKS];
+	memset(execCounters_, 0, sizeof(u32) * MAX_NUM_BLOCKS);
+	codePageCounts_ = new u16[CODE_PAGE_COUNT];
+	memset(codePageCounts_, 0, sizeof(u16) * CODE_PAGE_COUNT);
 }
 
 JitBlockCache::~JitBlockCache() {
 	Shutdown();
+	delete [] fastBlockLookup_;
+	fastBlockLookup_ = nullptr;
+	delete [] execCounters_;
+	delete [] codePageCounts_;
+	execCounters_ = nullptr;
 }
 
 bool JitBlock::ContainsAddress(u32 em_address) {
@@ -108,6 +121,9 @@ void JitBlockCache::Clear() {
 		DestroyBlock(i, DestroyType::CLEAR);
 	links_to_.clear();
 	num_blocks_ = 0;
+	memset(fastBlockLookup_, 0, sizeof(JitBlockLookupEntry) * JITBLOCK_LOOKUP_ENTRIES);
+	memset(execCounters_, 0, sizeof(u32) * MAX_NUM_BLOCKS);
+	memset(codePageCounts_, 0, sizeof(u16) * CODE_PAGE_COUNT);
 
 	blockMemRanges_[JITBLOCK_RANGE_SCRATCH] = std::make_pair(0xFFFFFFFF, 0x00000000);
 	blockMemRanges_[JITBLOCK_RANGE_RAMBOTTOM] = std::make_pair(0xFFFFFFFF, 0x00000000);
@@ -154,6 +170,7 @@ int JitBlockCache::AllocateBlock(u32 startAddress) {
 		b.linkStatus[i] = false;
 	}
 	b.blockNum = num_blocks_;
+	execCounters_[num_blocks_] = 0;
 	num_blocks_++; //commit the current block
 	return num_blocks_ - 1;
 }
@@ -199,6 +216,23 @@ void JitBlockCache::AddBlockMap(int block_num) {
 	// Yeah, this'll work fine for PSP too I think.
 	u32 pAddr = b.originalAddress & 0x1FFFFFFF;
 	block_map_[std::make_pair(pAddr + 4 * b.originalSize, pAddr)] = block_num;
+	AddCodePages(pAddr, pAddr + 4 * b.originalSize);
+}
+
+void JitBlockCache::AddCodePages(u32 pAddr, u32 pEnd) {
+	if (pEnd <= pAddr)
+		return;
+	for (u32 page = pAddr >> CODE_PAGE_SHIFT; page <= (pEnd - 1) >> CODE_PAGE_SHIFT; ++page)
+		codePageCounts_[page]++;
+}
+
+void JitBlockCache::RemoveCodePages(u32 pAddr, u32 pEnd) {
+	if (pEnd <= pAddr)
+		return;
+	for (u32 page = pAddr >> CODE_PAGE_SHIFT; page <= (pEnd - 1) >> CODE_PAGE_SHIFT; ++page) {
+		if (codePageCounts_[page] > 0)
+			codePageCounts_[page]--;
+	}
 }
 
 void JitBlockCache::RemoveBlockMap(int block_num) {
@@ -220,6 +254,25 @@ void JitBlockCache::RemoveBlockMap(int block_num) {
 			}
 		}
 	}
+	RemoveCodePages(pAddr, pAddr + 4 * b.originalSize);
+}
+
+void JitBlockCache::AddFastBlockLookup(int block_num) {
+	const JitBlock &b = blocks_[block_num];
+	JitBlockLookupEntry &entry = fastBlockLookup_[(b.originalAddress >> 2) & (JITBLOCK_LOOKUP_ENTRIES - 1)];
+	// Direct-mapped, so on a collision the newer block simply takes the slot.
+	// The dispatcher verifies addr before jumping, a miss just falls back to
+	// the regular lookup path.
+	entry.addr = b.originalAddress;
+	entry.codeOffset = (u32)(b.normalEntry - codeBlock_->GetBasePtr());
+}
+
+void JitBlockCache::RemoveFastBlockLookup(u32 addr) {
+	JitBlockLookupEntry &entry = fastBlockLookup_[(addr >> 2) & (JITBLOCK_LOOKUP_ENTRIES - 1)];
+	if (entry.addr == addr) {
+		entry.addr = 0;
+		entry.codeOffset = 0;
+	}
 }
 
 static void ExpandRange(std::pair<u32, u32> &range, u32 newStart, u32 newEnd) {
@@ -235,6 +288,7 @@ void JitBlockCache::FinalizeBlock(int block_num, bool block_link) {
 	Memory::Write_Opcode_JIT(b.originalAddress, opcode);
 
 	AddBlockMap(block_num);
+	AddFastBlockLookup(block_num);
 
 	if (block_link) {
 		for (int i = 0; i < MAX_JIT_BLOCK_EXITS; i++) {
@@ -486,6 +540,7 @@ void JitBlockCache::DestroyBlock(int block_num, DestroyType type) {
 	JitBlock *b = &blocks_[block_num];
 	// No point it being in there anymore.
 	RemoveBlockMap(block_num);
+	RemoveFastBlockLookup(b->originalAddress);
 
 	// Pure proxy blocks always point directly to a real block, there should be no chains of
 	// proxy-only blocks pointing to proxy-only blocks.
@@ -563,6 +618,21 @@ void JitBlockCache::InvalidateICache(u32 address, const u32 length) {
 		return;
 	}
 
+	// Quick out when the write lands nowhere near jitted code, which is the
+	// common case for streamed data (audio, textures, overlay assets). For
+	// large ranges walking the block map is cheaper than scanning pages.
+	if (length > 0 && length <= 0x10000) {
+		bool hasCode = false;
+		for (u32 page = pAddr >> CODE_PAGE_SHIFT; page <= (pEnd - 1) >> CODE_PAGE_SHIFT; ++page) {
+			if (codePageCounts_[page] != 0) {
+				hasCode = true;
+				break;
+			}
+		}
+		if (!hasCode)
+			return;
+	}
+
 	// Blocks may start and end in overlapping ways, and destroying one invalidates iterators.
 	// So after destroying one, we start over.
 	do {
@@ -614,6 +684,26 @@ int JitBlockCache::GetBlockExitSize() {
 #endif
 }
 
+void JitBlockCache::GetBlocksByHotness(std::vector<u32> &addresses, int maxCount) const {
+	std::vector<std::pair<u32, u32>> hot;  // (count, address)
+	hot.reserve(num_blocks_);
+	for (int i = 0; i < num_blocks_; i++) {
+		const JitBlock &b = blocks_[i];
+		if (b.invalid || b.IsPureProxy() || execCounters_[i] == 0)
+			continue;
+		hot.push_back(std::make_pair(execCounters_[i], b.originalAddress));
+	}
+	std::sort(hot.begin(), hot.end(), [](const std::pair<u32, u32> &a, const std::pair<u32, u32> &b) {
+		return a.first > b.first;
+	});
+	if ((int)hot.size() > maxCount)
+		hot.resize(maxCount);
+	addresses.clear();
+	addresses.reserve(hot.size());
+	for (const auto &iter : hot)
+		addresses.push_back(iter.second);
+}
+
 void JitBlockCache::ComputeStats(BlockCacheStats &bcStats) const {
 	double totalBloat = 0.0;
 	double maxBloat = 0.0;
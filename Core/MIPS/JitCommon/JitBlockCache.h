@@ -91,6 +91,20 @@ struct JitBlock {
 	}
 };
 
+// Fast lookup table so the emitted dispatcher can resolve indirect branches
+// without having to call back into C++ code. Direct-mapped by block start
+// address and kept in sync by FinalizeBlock/DestroyBlock. An empty slot has
+// addr == 0, which can never be a block start address.
+struct JitBlockLookupEntry {
+	u32 addr;
+	u32 codeOffset;  // Relative to the code blob's base pointer.
+};
+
+enum {
+	JITBLOCK_LOOKUP_BITS = 15,
+	JITBLOCK_LOOKUP_ENTRIES = 1 << JITBLOCK_LOOKUP_BITS,
+};
+
 typedef void (*CompiledCode)();
 
 struct JitBlockDebugInfo {
@@ -160,6 +174,17 @@ public:
 
 	int GetNumBlocks() const override { return num_blocks_; }
 
+	// For the emitted dispatcher's inline fast path. The table is allocated for
+	// the lifetime of the cache so the pointer can be baked into generated code.
+	const JitBlockLookupEntry *GetFastBlockLookup() const { return fastBlockLookup_; }
+
+	// Per-block entry counters for the optional block profiling mode. Allocated for
+	// the lifetime of the cache like the lookup table above, so the jits can bake
+	// each block's counter address into its prologue.
+	u32 *GetExecCounter(int block_num) { return &execCounters_[block_num]; }
+	// Returns the addresses of profiled blocks, hottest first.
+	void GetBlocksByHotness(std::vector<u32> &addresses, int maxCount) const;
+
 	static int GetBlockExitSize();
 
 	JitBlockDebugInfo GetBlockDebugInfo(int blockNum) const override;
@@ -176,10 +201,28 @@ private:
 	void AddBlockMap(int block_num);
 	void RemoveBlockMap(int block_num);
 
+	void AddCodePages(u32 pAddr, u32 pEnd);
+	void RemoveCodePages(u32 pAddr, u32 pEnd);
+
+	void AddFastBlockLookup(int block_num);
+	void RemoveFastBlockLookup(u32 addr);
+
 	MIPSOpcode GetEmuHackOpForBlock(int block_num) const;
 
+	enum {
+		// One counter per page of the physical address space, counting how many
+		// blocks were compiled from code in that page. Lets InvalidateICache
+		// skip writes that land nowhere near jitted code without touching the
+		// block map at all.
+		CODE_PAGE_SHIFT = 12,
+		CODE_PAGE_COUNT = 0x20000000 >> CODE_PAGE_SHIFT,
+	};
+
 	CodeBlockCommon *codeBlock_;
 	JitBlock *blocks_;
+	JitBlockLookupEntry *fastBlockLookup_;
+	u32 *execCounters_;
+	u16 *codePageCounts_;
 	std::unordered_multimap<u32, int> proxyBlockMap_;
 
 	int num_blocks_;
@@ -27,6 +27,7 @@
 #include "Core/Config.h"
 
 #include "Core/MIPS/JitCommon/JitCommon.h"
+#include "Core/MIPS/JitCommon/JitCompileQueue.h"
 #include "Core/MIPS/JitCommon/JitState.h"
 #include "Core/MIPS/IR/IRJit.h"
 
@@ -45,7 +46,10 @@
 namespace MIPSComp {
 	JitInterface *jit;
 	void JitAt() {
-		jit->Compile(currentMIPS->pc);
+		u32 pc = currentMIPS->pc;
+		jit->Compile(pc);
+		// Let the precompile worker look for calls out of the new code.
+		PrecompileNotifyBlock(pc);
 	}
 
 	void DoDummyJitState(PointerWrap &p) {
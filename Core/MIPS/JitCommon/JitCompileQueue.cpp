@@ -0,0 +1,206 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "thread/threadutil.h"
+#include "Common/Log.h"
+#include "Core/Config.h"
+#include "Core/MemMap.h"
+#include "Core/MIPS/MIPS.h"
+#include "Core/MIPS/MIPSAnalyst.h"
+#include "Core/MIPS/JitCommon/JitCommon.h"
+#include "Core/MIPS/JitCommon/JitBlockCache.h"
+#include "Core/MIPS/JitCommon/JitCompileQueue.h"
+
+namespace MIPSComp {
+
+struct PrecompileCandidate {
+	u32 start;
+	u32 size;
+};
+
+static std::thread precompileThread;
+static std::mutex queueLock;
+static std::condition_variable queueWake;
+// Blocks the CPU thread compiled, waiting for the worker to scan them.
+static std::vector<u32> notifiedBlocks;
+// Call targets the worker found, waiting for the CPU thread to compile them.
+static std::vector<PrecompileCandidate> readyQueue;
+// Everything ever queued, so we don't queue a function twice.
+static std::unordered_set<u32> queuedFuncs;
+static bool threadRunning = false;
+
+// Bounds the CPU thread's share of the work per drain.
+static const int DRAIN_BUDGET = 4;
+static const size_t MAX_READY_QUEUE = 256;
+
+// Block profiling: re-layout every 30 seconds or so of vblanks, and only
+// once the profile has something worth sorting.
+static const int COMPACT_INTERVAL_VBLANKS = 1800;
+static const int MAX_COMPACT_BLOCKS = 1024;
+static const int MIN_COMPACT_BLOCKS = 16;
+static int vblanksUntilCompact = COMPACT_INTERVAL_VBLANKS;
+
+static void ScanForCallTargets(u32 addr) {
+	u32 funcStart, funcSize;
+	if (!MIPSAnalyst::GetFunctionBounds(addr, &funcStart, &funcSize))
+		return;
+	if (!Memory::IsValidAddress(funcStart) || !Memory::IsValidAddress(funcStart + funcSize - 4))
+		return;
+
+	for (u32 pc = funcStart; pc < funcStart + funcSize; pc += 4) {
+		// Raw read on purpose - an emuhack word can't look like a JAL, so this
+		// is safe even while the CPU thread is rewriting opcodes under us.
+		const u32 op = Memory::ReadUnchecked_U32(pc);
+		if ((op >> 26) != 3)  // JAL
+			continue;
+		const u32 target = (pc & 0xF0000000) | ((op & 0x03FFFFFF) << 2);
+
+		u32 targetStart, targetSize;
+		if (!MIPSAnalyst::GetFunctionBounds(target, &targetStart, &targetSize))
+			continue;
+		// Mid-function calls confuse more than they help, skip them.
+		if (targetStart != target)
+			continue;
+
+		std::lock_guard<std::mutex> guard(queueLock);
+		if (readyQueue.size() >= MAX_READY_QUEUE)
+			break;
+		if (queuedFuncs.insert(target).second)
+			readyQueue.push_back(PrecompileCandidate{ target, targetSize });
+	}
+}
+
+static void PrecompileThreadFunc() {
+	setCurrentThreadName("JitPrecompile");
+	while (true) {
+		std::vector<u32> work;
+		{
+			std::unique_lock<std::mutex> guard(queueLock);
+			queueWake.wait(guard, [] { return !notifiedBlocks.empty() || !threadRunning; });
+			if (!threadRunning)
+				break;
+			work.swap(notifiedBlocks);
+		}
+		for (u32 addr : work)
+			ScanForCallTargets(addr);
+	}
+}
+
+void StartPrecompileThread() {
+	if (threadRunning)
+		return;
+	notifiedBlocks.clear();
+	readyQueue.clear();
+	queuedFuncs.clear();
+	threadRunning = true;
+	precompileThread = std::thread(&PrecompileThreadFunc);
+}
+
+void StopPrecompileThread() {
+	if (!threadRunning)
+		return;
+	{
+		std::lock_guard<std::mutex> guard(queueLock);
+		threadRunning = false;
+	}
+	queueWake.notify_one();
+	precompileThread.join();
+}
+
+void PrecompileNotifyBlock(u32 addr) {
+	if (!threadRunning)
+		return;
+	{
+		std::lock_guard<std::mutex> guard(queueLock);
+		// If the worker is this far behind, dropping notifications is fine.
+		if (notifiedBlocks.size() >= MAX_READY_QUEUE)
+			return;
+		notifiedBlocks.push_back(addr);
+	}
+	queueWake.notify_one();
+}
+
+void DrainPrecompileQueue() {
+	if (g_Config.bJitBlockProfiling && MIPSComp::jit && --vblanksUntilCompact <= 0) {
+		vblanksUntilCompact = COMPACT_INTERVAL_VBLANKS;
+		CompactJitCacheByHotness();
+	}
+
+	if (!threadRunning || !MIPSComp::jit)
+		return;
+
+	PrecompileCandidate work[DRAIN_BUDGET];
+	int count = 0;
+	{
+		std::lock_guard<std::mutex> guard(queueLock);
+		while (count < DRAIN_BUDGET && !readyQueue.empty()) {
+			work[count++] = readyQueue.back();
+			readyQueue.pop_back();
+		}
+	}
+	if (count == 0)
+		return;
+
+	JitBlockCache *cache = MIPSComp::jit->GetBlockCache();
+	for (int i = 0; i < count; i++) {
+		if (cache && cache->IsFull())
+			break;
+		if (cache && cache->GetBlockNumberFromStartAddress(work[i].start) >= 0)
+			continue;
+		PrecompileBlockAt(work[i].start);
+	}
+}
+
+// Recompiling in hotness order is the layout pass: emitted blocks are full of
+// absolute addresses and carry no relocation info, so the code bytes can't be
+// moved. A clear plus hot-first recompile packs the hot set at the bottom of
+// the code space instead, and FinalizeBlock relinks each block as it reappears.
+void CompactJitCacheByHotness() {
+	JitBlockCache *cache = MIPSComp::jit->GetBlockCache();
+	if (!cache)
+		return;
+	std::vector<u32> hot;
+	cache->GetBlocksByHotness(hot, MAX_COMPACT_BLOCKS);
+	if ((int)hot.size() < MIN_COMPACT_BLOCKS)
+		return;
+	NOTICE_LOG(JIT, "Re-laying out jit cache around %d hot blocks", (int)hot.size());
+	MIPSComp::jit->ClearCache();
+	for (u32 addr : hot) {
+		if (cache->IsFull())
+			break;
+		PrecompileBlockAt(addr);
+	}
+}
+
+void PrecompileBlockAt(u32 addr) {
+	if (!MIPSComp::jit)
+		return;
+	// The native jits compile at mips->pc (see DoJit), so point it at the
+	// block temporarily. We're at a jit-safe point, nothing observes this.
+	const u32 oldPC = currentMIPS->pc;
+	currentMIPS->pc = addr;
+	MIPSComp::jit->Compile(addr);
+	currentMIPS->pc = oldPC;
+}
+
+}  // namespace MIPSComp
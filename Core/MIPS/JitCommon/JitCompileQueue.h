@@ -0,0 +1,51 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace MIPSComp {
+
+// Speculative background block pre-compilation.
+//
+// The worker thread never touches the jit itself - the block cache and code
+// space are CPU-thread-only. Instead it walks freshly compiled code for direct
+// calls using MIPSAnalyst's function database and queues the call targets.
+// DrainPrecompileQueue() then compiles a bounded number of them per vblank on
+// the CPU thread, at a point where the jit is not in the middle of a block.
+
+void StartPrecompileThread();
+void StopPrecompileThread();
+
+// CPU thread: a block was just compiled at addr. Cheap, just queues a note.
+void PrecompileNotifyBlock(u32 addr);
+
+// CPU thread, at a jit-safe point: compile a few queued functions.
+void DrainPrecompileQueue();
+
+// CPU thread, at a jit-safe point: compile one block, working around the
+// native jits compiling at mips->pc rather than the passed address.
+void PrecompileBlockAt(u32 addr);
+
+// CPU thread, at a jit-safe point: throw the block cache away and recompile
+// the hottest profiled blocks first, packing them contiguously in the code
+// space. Runs periodically from DrainPrecompileQueue when JitBlockProfiling
+// is enabled.
+void CompactJitCacheByHotness();
+
+}  // namespace MIPSComp
@@ -0,0 +1,160 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#include <cstdio>
+#include <vector>
+
+#include "base/timeutil.h"
+#include "ext/cityhash/city.h"
+#include "Common/FileUtil.h"
+#include "Common/Log.h"
+#include "Core/ELF/ParamSFO.h"
+#include "Core/MemMap.h"
+#include "Core/System.h"
+#include "Core/MIPS/MIPS.h"
+#include "Core/MIPS/JitCommon/JitCommon.h"
+#include "Core/MIPS/JitCommon/JitBlockCache.h"
+#include "Core/MIPS/JitCommon/JitCompileQueue.h"
+#include "Core/MIPS/JitCommon/JitDiskCache.h"
+
+namespace MIPSComp {
+
+static const u32 BLOCK_LIST_CACHE_MAGIC = 0x434A4250;  // 'PBJC'
+static const u32 BLOCK_LIST_CACHE_VERSION = 1;
+// Bounds both file size and time spent compiling at load.
+static const u32 MAX_SAVED_BLOCKS = 16384;
+
+struct BlockListCacheHeader {
+	u32 magic;
+	u32 version;
+	u32 numBlocks;
+	u32 reserved;
+};
+
+struct BlockListCacheEntry {
+	u32 addr;
+	u32 sizeInWords;
+	u64 hash;
+};
+
+static std::string BlockListCachePath() {
+	std::string discID = g_paramSFO.GetDiscID();
+	if (discID.empty())
+		return "";
+	File::CreateFullPath(GetSysDirectory(DIRECTORY_APP_CACHE));
+	return GetSysDirectory(DIRECTORY_APP_CACHE) + "/" + discID + ".jitblocks";
+}
+
+// Hashes the block's original MIPS words. Read_Instruction resolves both
+// emuhacks and replacement ops, so the hash is stable across runs no matter
+// what's currently installed in memory.
+static u64 HashOriginalWords(u32 addr, u32 sizeInWords) {
+	std::vector<u32> buffer;
+	buffer.reserve(sizeInWords);
+	for (u32 i = 0; i < sizeInWords; i++)
+		buffer.push_back(Memory::Read_Instruction(addr + i * 4, true).encoding);
+	return CityHash64((const char *)&buffer[0], buffer.size() * sizeof(u32));
+}
+
+void SaveBlockListCache() {
+	if (!MIPSComp::jit)
+		return;
+	JitBlockCache *cache = MIPSComp::jit->GetBlockCache();
+	if (!cache || cache->GetNumBlocks() == 0)
+		return;
+	const std::string filename = BlockListCachePath();
+	if (filename.empty())
+		return;
+
+	std::vector<BlockListCacheEntry> entries;
+	for (int i = 0; i < cache->GetNumBlocks() && entries.size() < MAX_SAVED_BLOCKS; i++) {
+		const JitBlock *b = cache->GetBlock(i);
+		if (b->invalid || b->IsPureProxy())
+			continue;
+		if (!Memory::IsValidAddress(b->originalAddress) || !Memory::IsValidAddress(b->originalAddress + 4 * b->originalSize - 4))
+			continue;
+		BlockListCacheEntry entry;
+		entry.addr = b->originalAddress;
+		entry.sizeInWords = b->originalSize;
+		entry.hash = HashOriginalWords(b->originalAddress, b->originalSize);
+		entries.push_back(entry);
+	}
+	if (entries.empty())
+		return;
+
+	FILE *f = File::OpenCFile(filename, "wb");
+	if (!f) {
+		WARN_LOG(JIT, "Could not open jit block list cache for writing: %s", filename.c_str());
+		return;
+	}
+	BlockListCacheHeader header{};
+	header.magic = BLOCK_LIST_CACHE_MAGIC;
+	header.version = BLOCK_LIST_CACHE_VERSION;
+	header.numBlocks = (u32)entries.size();
+	fwrite(&header, sizeof(header), 1, f);
+	fwrite(&entries[0], sizeof(BlockListCacheEntry), entries.size(), f);
+	fclose(f);
+	NOTICE_LOG(JIT, "Saved %d jit blocks to %s", (int)entries.size(), filename.c_str());
+}
+
+void LoadBlockListCache() {
+	if (!MIPSComp::jit)
+		return;
+	const std::string filename = BlockListCachePath();
+	if (filename.empty())
+		return;
+	FILE *f = File::OpenCFile(filename, "rb");
+	if (!f)
+		return;
+
+	BlockListCacheHeader header{};
+	bool valid = fread(&header, sizeof(header), 1, f) == 1;
+	if (!valid || header.magic != BLOCK_LIST_CACHE_MAGIC || header.version != BLOCK_LIST_CACHE_VERSION || header.numBlocks > MAX_SAVED_BLOCKS) {
+		WARN_LOG(JIT, "Ignoring bad jit block list cache: %s", filename.c_str());
+		fclose(f);
+		return;
+	}
+	std::vector<BlockListCacheEntry> entries(header.numBlocks);
+	if (fread(&entries[0], sizeof(BlockListCacheEntry), entries.size(), f) != entries.size()) {
+		fclose(f);
+		return;
+	}
+	fclose(f);
+
+	JitBlockCache *cache = MIPSComp::jit->GetBlockCache();
+	double st = real_time_now();
+	int compiled = 0;
+	for (const BlockListCacheEntry &entry : entries) {
+		if (entry.sizeInWords == 0 || entry.sizeInWords > JitBlockCache::MAX_BLOCK_INSTRUCTIONS)
+			continue;
+		if (!Memory::IsValidAddress(entry.addr) || !Memory::IsValidAddress(entry.addr + 4 * entry.sizeInWords - 4))
+			continue;
+		// Stale entries (patched game, different module layout) just get skipped.
+		if (HashOriginalWords(entry.addr, entry.sizeInWords) != entry.hash)
+			continue;
+		if (cache && cache->IsFull())
+			break;
+		if (cache && cache->GetBlockNumberFromStartAddress(entry.addr) >= 0)
+			continue;
+		PrecompileBlockAt(entry.addr);
+		compiled++;
+	}
+	double et = real_time_now();
+	NOTICE_LOG(JIT, "Precompiled %d cached jit blocks in %0.2f milliseconds", compiled, (et - st) * 1000.0);
+}
+
+}  // namespace MIPSComp
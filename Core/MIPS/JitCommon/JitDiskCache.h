@@ -0,0 +1,37 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace MIPSComp {
+
+// Per-game on-disk list of previously compiled jit blocks, so the jit starts
+// warm on the next boot instead of hitching through the first minutes of
+// gameplay. Follows the shader cache precedent: we persist identification and
+// validation data only and recompile on load - generated code is full of
+// absolute pointers and link targets, so a raw code image would not survive a
+// relaunch anyway.
+
+// Writes the current block cache's block list for the running game, if any.
+void SaveBlockListCache();
+// Loads the list for the running game and compiles all blocks whose original
+// MIPS words still hash the same.
+void LoadBlockListCache();
+
+}  // namespace MIPSComp
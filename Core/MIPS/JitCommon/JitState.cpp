@@ -28,6 +28,7 @@ namespace MIPSComp {
 		enableVFPUSIMD = !Disabled(JitDisable::SIMD);
 		// Set by Asm if needed.
 		reserveR15ForAsm = false;
+		fuseCompareBranches = !Disabled(JitDisable::FUSION);
 
 		// ARM/ARM64
 		useBackJump = false;
@@ -198,8 +198,9 @@ namespace MIPSComp {
 		POINTERIFY = 0x00400000,
 		STATIC_ALLOC = 0x00800000,
 		CACHE_POINTERS = 0x01000000,
+		FUSION = 0x02000000,
 
-		ALL_FLAGS = 0x01FFFFFF,
+		ALL_FLAGS = 0x03FFFFFF,
 	};
 
 	struct JitOptions {
@@ -212,6 +213,7 @@ namespace MIPSComp {
 		// x86
 		bool enableVFPUSIMD;
 		bool reserveR15ForAsm;
+		bool fuseCompareBranches;
 
 		// ARM/ARM64
 		bool useBackJump;
@@ -33,6 +33,7 @@
 #include "Core/System.h"
 #include "Core/HLE/sceDisplay.h"
 #include "Core/MIPS/JitCommon/JitCommon.h"
+#include "Core/MIPS/JitCommon/JitCompileQueue.h"
 #include "Core/CoreTiming.h"
 
 MIPSState mipsr4k;
@@ -162,6 +163,7 @@ MIPSState::~MIPSState() {
 }
 
 void MIPSState::Shutdown() {
+	MIPSComp::StopPrecompileThread();
 	if (MIPSComp::jit) {
 		delete MIPSComp::jit;
 		MIPSComp::jit = 0;
@@ -210,6 +212,7 @@ void MIPSState::Init() {
 
 	if (PSP_CoreParameter().cpuCore == CPUCore::JIT) {
 		MIPSComp::jit = MIPSComp::CreateNativeJit(this);
+		MIPSComp::StartPrecompileThread();
 	} else if (PSP_CoreParameter().cpuCore == CPUCore::IR_JIT) {
 		MIPSComp::jit = new MIPSComp::IRJit(this);
 	} else {
@@ -44,10 +44,24 @@ typedef std::vector<MIPSAnalyst::AnalyzedFunction> FunctionsVector;
 static FunctionsVector functions;
 std::recursive_mutex functions_lock;
 
-// One function can appear in multiple copies in memory, and they will all have 
+// One function can appear in multiple copies in memory, and they will all have
 // the same hash and should all be replaced if possible.
 static std::unordered_multimap<u64, MIPSAnalyst::AnalyzedFunction *> hashToFunction;
 
+// Per-game cache of ScanForFunctions results. Scanning is already range-based
+// (modules get scanned as they load), but the sweep itself is linear in module
+// size and runs on every boot and overlay load. When the bytes of a range are
+// identical to what we scanned last time, we reuse the previous boundaries.
+struct FuncScanCacheEntry {
+	u64 memHash;
+	std::vector<MIPSAnalyst::AnalyzedFunction> functions;
+};
+static std::map<std::pair<u32, u32>, FuncScanCacheEntry> funcScanCache;
+static std::string funcScanCacheFilename;
+
+static const u32 FUNC_SCAN_CACHE_MAGIC = 0x434E5546;  // 'FUNC'
+static const u32 FUNC_SCAN_CACHE_VERSION = 1;
+
 struct HashMapFunc {
 	char name[64];
 	u64 hash;
@@ -908,6 +922,18 @@ skip:
 		}
 	}
 
+	bool GetFunctionBounds(u32 addr, u32 *start, u32 *size) {
+		std::lock_guard<std::recursive_mutex> guard(functions_lock);
+		for (const AnalyzedFunction &f : functions) {
+			if (addr >= f.start && addr <= f.end) {
+				*start = f.start;
+				*size = f.end - f.start + 4;
+				return true;
+			}
+		}
+		return false;
+	}
+
 	void PrecompileFunction(u32 startAddr, u32 length) {
 		// Direct calls to this ignore the bPreloadFunctions flag, since it's just for stubs.
 		if (MIPSComp::jit) {
@@ -1018,9 +1044,122 @@ skip:
 		return furthestJumpbackAddr;
 	}
 
+	void OpenFunctionScanCache(const std::string &discID) {
+		std::lock_guard<std::recursive_mutex> guard(functions_lock);
+		funcScanCache.clear();
+		funcScanCacheFilename.clear();
+		// Homebrew tends to have an empty disc ID - don't mix those up in one file.
+		if (discID.empty())
+			return;
+		funcScanCacheFilename = GetSysDirectory(DIRECTORY_CACHE) + discID + ".funcscan";
+		FILE *f = File::OpenCFile(funcScanCacheFilename, "rb");
+		if (!f)
+			return;
+		u32 header[2];
+		if (fread(header, sizeof(header), 1, f) != 1 || header[0] != FUNC_SCAN_CACHE_MAGIC || header[1] != FUNC_SCAN_CACHE_VERSION) {
+			fclose(f);
+			return;
+		}
+		size_t totalFuncs = 0;
+		for (;;) {
+			u32 range[2];
+			u64 memHash;
+			u32 numFuncs;
+			if (fread(range, sizeof(range), 1, f) != 1 || fread(&memHash, sizeof(memHash), 1, f) != 1 || fread(&numFuncs, sizeof(numFuncs), 1, f) != 1)
+				break;
+			if (range[1] <= range[0] || numFuncs > (range[1] - range[0]) / 4 + 1) {
+				// Corrupt - stop reading, whatever we got so far is still usable.
+				break;
+			}
+			FuncScanCacheEntry entry;
+			entry.memHash = memHash;
+			entry.functions.reserve(numFuncs);
+			bool ok = true;
+			for (u32 i = 0; i < numFuncs; i++) {
+				u32 rec[3];
+				if (fread(rec, sizeof(rec), 1, f) != 1) {
+					ok = false;
+					break;
+				}
+				AnalyzedFunction fun;
+				memset(&fun, 0, sizeof(fun));
+				fun.start = rec[0];
+				fun.end = rec[1];
+				fun.size = fun.end - fun.start + 4;
+				fun.isStraightLeaf = (rec[2] & 1) != 0;
+				entry.functions.push_back(fun);
+			}
+			if (!ok)
+				break;
+			totalFuncs += entry.functions.size();
+			funcScanCache[std::make_pair(range[0], range[1])] = std::move(entry);
+		}
+		fclose(f);
+		if (!funcScanCache.empty()) {
+			INFO_LOG(CPU, "Loaded function scan cache for %s: %d ranges, %d functions", discID.c_str(), (int)funcScanCache.size(), (int)totalFuncs);
+		}
+	}
+
+	static void SaveFunctionScanCache() {
+		// Caller must hold functions_lock.
+		FILE *f = File::OpenCFile(funcScanCacheFilename, "wb");
+		if (!f)
+			return;
+		u32 header[2] = { FUNC_SCAN_CACHE_MAGIC, FUNC_SCAN_CACHE_VERSION };
+		fwrite(header, sizeof(header), 1, f);
+		for (auto iter = funcScanCache.begin(); iter != funcScanCache.end(); ++iter) {
+			u32 range[2] = { iter->first.first, iter->first.second };
+			u32 numFuncs = (u32)iter->second.functions.size();
+			fwrite(range, sizeof(range), 1, f);
+			fwrite(&iter->second.memHash, sizeof(iter->second.memHash), 1, f);
+			fwrite(&numFuncs, sizeof(numFuncs), 1, f);
+			for (auto fun = iter->second.functions.begin(); fun != iter->second.functions.end(); ++fun) {
+				u32 rec[3] = { fun->start, fun->end, fun->isStraightLeaf ? 1u : 0u };
+				fwrite(rec, sizeof(rec), 1, f);
+			}
+		}
+		fclose(f);
+	}
+
+	void CloseFunctionScanCache() {
+		std::lock_guard<std::recursive_mutex> guard(functions_lock);
+		funcScanCache.clear();
+		funcScanCacheFilename.clear();
+	}
+
 	bool ScanForFunctions(u32 startAddr, u32 endAddr, bool insertSymbols) {
 		std::lock_guard<std::recursive_mutex> guard(functions_lock);
 
+		// See if we scanned this exact range last boot and the code is unchanged.
+		u64 memHash = 0;
+		const bool canCache = !funcScanCacheFilename.empty() && endAddr > startAddr &&
+			Memory::IsValidAddress(startAddr) && Memory::IsValidAddress(endAddr);
+		if (canCache) {
+			memHash = XXH64(Memory::GetPointer(startAddr), endAddr - startAddr + 4, 0xA11A1152);
+			auto cached = funcScanCache.find(std::make_pair(startAddr, endAddr));
+			if (cached != funcScanCache.end() && cached->second.memHash == memHash) {
+				for (auto iter = cached->second.functions.begin(); iter != cached->second.functions.end(); ++iter) {
+					AnalyzedFunction fun = *iter;
+					u32 existingSize = g_symbolMap->GetFunctionSize(fun.start);
+					if (existingSize != SymbolMap::INVALID_ADDRESS) {
+						fun.foundInSymbolMap = true;
+						if (existingSize != fun.size) {
+							insertSymbols = false;
+						}
+					}
+					functions.push_back(fun);
+				}
+				for (auto iter = cached->second.functions.begin(); iter != cached->second.functions.end(); ++iter) {
+					if (insertSymbols && !iter->foundInSymbolMap && g_symbolMap->GetFunctionSize(iter->start) == SymbolMap::INVALID_ADDRESS) {
+						char temp[256];
+						g_symbolMap->AddFunction(DefaultFunctionName(temp, iter->start), iter->start, iter->size);
+					}
+				}
+				return insertSymbols;
+			}
+		}
+		const size_t firstNewFunction = functions.size();
+
 		AnalyzedFunction currentFunction = {startAddr};
 
 		u32 furthestBranch = 0;
@@ -1167,6 +1306,13 @@ skip:
 			}
 		}
 
+		if (canCache) {
+			FuncScanCacheEntry &entry = funcScanCache[std::make_pair(startAddr, endAddr)];
+			entry.memHash = memHash;
+			entry.functions.assign(functions.begin() + firstNewFunction, functions.end());
+			SaveFunctionScanCache();
+		}
+
 		return insertSymbols;
 	}
 
@@ -108,10 +108,19 @@ namespace MIPSAnalyst
 	// Returns new insertSymbols value for FinalizeScan().
 	bool ScanForFunctions(u32 startAddr, u32 endAddr, bool insertSymbols);
 	void FinalizeScan(bool insertSymbols);
+
+	// Per-game cache of scan results, so repeat boots and overlay reloads skip the
+	// full sweep when the module bytes haven't changed. Open after the game is
+	// identified, close at CPU shutdown.
+	void OpenFunctionScanCache(const std::string &discID);
+	void CloseFunctionScanCache();
 	void ForgetFunctions(u32 startAddr, u32 endAddr);
 	void PrecompileFunctions();
 	void PrecompileFunction(u32 startAddr, u32 length);
 
+	// Looks up the function containing addr in the database. Thread-safe.
+	bool GetFunctionBounds(u32 addr, u32 *start, u32 *size);
+
 	void SetHashMapFilename(const std::string& filename = "");
 	void LoadBuiltinHashMap();
 	void LoadHashMap(const std::string& filename);
@@ -0,0 +1,90 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "Core/Debugger/SymbolMap.h"
+#include "Core/MIPS/MIPSSampleProfiler.h"
+
+namespace MIPSSampleProfiler {
+
+static std::atomic<bool> g_enabled(false);
+
+static std::mutex samplesLock;
+// Keyed by function start address (or raw PC if no symbol covers it.)
+static std::unordered_map<u32, u64> samples;
+static u64 totalCycles = 0;
+
+void SetEnabled(bool enabled) {
+	g_enabled = enabled;
+}
+
+bool IsEnabled() {
+	return g_enabled;
+}
+
+void HitSample(u32 pc, int cycles) {
+	if (cycles <= 0)
+		return;
+
+	u32 funcStart = g_symbolMap ? g_symbolMap->GetFunctionStart(pc) : SymbolMap::INVALID_ADDRESS;
+	if (funcStart == SymbolMap::INVALID_ADDRESS)
+		funcStart = pc;
+
+	std::lock_guard<std::mutex> guard(samplesLock);
+	samples[funcStart] += cycles;
+	totalCycles += cycles;
+}
+
+void Reset() {
+	std::lock_guard<std::mutex> guard(samplesLock);
+	samples.clear();
+	totalCycles = 0;
+}
+
+std::vector<FuncSample> GetTopFunctions(size_t count) {
+	std::vector<std::pair<u32, u64>> sorted;
+	u64 total;
+	{
+		std::lock_guard<std::mutex> guard(samplesLock);
+		sorted.assign(samples.begin(), samples.end());
+		total = totalCycles;
+	}
+
+	std::sort(sorted.begin(), sorted.end(), [](const std::pair<u32, u64> &a, const std::pair<u32, u64> &b) {
+		return a.second > b.second;
+	});
+	if (sorted.size() > count)
+		sorted.resize(count);
+
+	std::vector<FuncSample> result;
+	result.reserve(sorted.size());
+	for (const auto &entry : sorted) {
+		FuncSample sample;
+		sample.address = entry.first;
+		sample.name = g_symbolMap ? g_symbolMap->GetLabelString(entry.first) : "";
+		sample.cycles = entry.second;
+		sample.percent = total > 0 ? 100.0 * entry.second / total : 0.0;
+		result.push_back(sample);
+	}
+	return result;
+}
+
+}  // namespace MIPSSampleProfiler
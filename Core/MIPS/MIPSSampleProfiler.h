@@ -0,0 +1,53 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Cycle-weighted sampling profiler for guest MIPS code. Every time CoreTiming
+// finishes a timeslice, the cycles of that slice are attributed to the
+// function containing the PC where it ended (via SymbolMap). That's interrupt
+// style sampling - biased toward where slices end, but over a few seconds it
+// ranks hot functions well, with MIPS symbol names external profilers can't
+// see. Works with any CPU core, no jit changes needed.
+
+namespace MIPSSampleProfiler {
+
+struct FuncSample {
+	u32 address;
+	std::string name;
+	u64 cycles;
+	double percent;
+};
+
+// Cheap to check; sampling costs nothing while disabled.
+void SetEnabled(bool enabled);
+bool IsEnabled();
+
+// Called from CoreTiming on the CPU thread at the end of each timeslice.
+void HitSample(u32 pc, int cycles);
+
+void Reset();
+
+// Ranked by cycles, descending. Safe to call from the UI thread.
+std::vector<FuncSample> GetTopFunctions(size_t count);
+
+}  // namespace MIPSSampleProfiler
@@ -18,6 +18,11 @@
 #include <limits>
 #include <stdio.h>
 
+#include "ppsspp_config.h"
+#if PPSSPP_ARCH(X86) || PPSSPP_ARCH(AMD64)
+#include <emmintrin.h>
+#endif
+
 #include "Common/CommonFuncs.h"
 #include "Core/Reporting.h"
 #include "Core/MIPS/MIPS.h"
@@ -26,6 +31,128 @@
 #define V(i)   (currentMIPS->v[voffset[i]])
 #define VI(i)  (currentMIPS->vi[voffset[i]])
 
+bool g_vfpuFastTranscendentals = true;
+
+// sin(pi/2 * x) and cos(pi/2 * x) on x in [-0.5, 0.5], evaluated as Taylor
+// series in powers of pi/2, which converge below float precision on this
+// interval. Both hit 0.0/1.0 exactly at x == 0, so the quadrant-exact results
+// games depend on (see the checks in vfpu_sin) fall out without special cases.
+static const float SINCOS_COEFS[8] = {
+	1.5707963268f, -0.6459640975f, 0.0796926262f, -0.0046817541f,  // sin: x, x^3, x^5, x^7
+	-1.2337005501f, 0.2536695079f, -0.0208634808f, 0.0009192603f,  // cos: x^2, x^4, x^6, x^8
+};
+
+// Reduces the PSP angle (in quarter turns) to a quadrant index and an offset
+// x in [-0.5, 0.5] from that quadrant's boundary.
+static inline void SinCosReduce(float angle, int &quadrant, float &x) {
+	angle -= floorf(angle * 0.25f) * 4.0f;
+	// angle is now in [0, 4) - round to the nearest boundary.
+	int n = (int)(angle + 0.5f);
+	x = angle - (float)n;
+	quadrant = n & 3;
+}
+
+static inline float SinPoly(float x) {
+	float p = x * x;
+	return x * (SINCOS_COEFS[0] + p * (SINCOS_COEFS[1] + p * (SINCOS_COEFS[2] + p * SINCOS_COEFS[3])));
+}
+
+static inline float CosPoly(float x) {
+	float p = x * x;
+	return 1.0f + p * (SINCOS_COEFS[4] + p * (SINCOS_COEFS[5] + p * (SINCOS_COEFS[6] + p * SINCOS_COEFS[7])));
+}
+
+float vfpu_sin_approx(float angle) {
+	int quadrant;
+	float x;
+	SinCosReduce(angle, quadrant, x);
+	switch (quadrant) {
+	case 0: return SinPoly(x);
+	case 1: return CosPoly(x);
+	case 2: return -SinPoly(x);
+	default: return -CosPoly(x);
+	}
+}
+
+float vfpu_cos_approx(float angle) {
+	int quadrant;
+	float x;
+	SinCosReduce(angle, quadrant, x);
+	switch (quadrant) {
+	case 0: return CosPoly(x);
+	case 1: return -SinPoly(x);
+	case 2: return -CosPoly(x);
+	default: return SinPoly(x);
+	}
+}
+
+void vfpu_sincos_approx(float angle, float &sine, float &cosine) {
+	int quadrant;
+	float x;
+	SinCosReduce(angle, quadrant, x);
+
+	float s, c;
+#if PPSSPP_ARCH(X86) || PPSSPP_ARCH(AMD64)
+	// Evaluate both polynomials at once, sin in lane 0 and cos in lane 1.
+	__m128 p = _mm_set1_ps(x * x);
+	__m128 inner = _mm_set_ps(0.0f, 0.0f, SINCOS_COEFS[7], SINCOS_COEFS[3]);
+	inner = _mm_add_ps(_mm_mul_ps(inner, p), _mm_set_ps(0.0f, 0.0f, SINCOS_COEFS[6], SINCOS_COEFS[2]));
+	inner = _mm_add_ps(_mm_mul_ps(inner, p), _mm_set_ps(0.0f, 0.0f, SINCOS_COEFS[5], SINCOS_COEFS[1]));
+	inner = _mm_add_ps(_mm_mul_ps(inner, p), _mm_set_ps(0.0f, 0.0f, SINCOS_COEFS[4], SINCOS_COEFS[0]));
+	// sin = x * inner, cos = 1 + x^2 * inner.
+	__m128 outer = _mm_mul_ps(inner, _mm_unpacklo_ps(_mm_set_ss(x), p));
+	outer = _mm_add_ps(outer, _mm_set_ps(0.0f, 0.0f, 1.0f, 0.0f));
+	float temp[4];
+	_mm_storeu_ps(temp, outer);
+	s = temp[0];
+	c = temp[1];
+#else
+	s = SinPoly(x);
+	c = CosPoly(x);
+#endif
+
+	switch (quadrant) {
+	case 0: sine = s; cosine = c; break;
+	case 1: sine = c; cosine = -s; break;
+	case 2: sine = -s; cosine = -c; break;
+	default: sine = -c; cosine = s; break;
+	}
+}
+
+float vfpu_exp2(float x) {
+	if (!g_vfpuFastTranscendentals)
+		return powf(2.0f, x);
+	if (!(x > -126.0f))  // Also catches NANs.
+		return x == x ? 0.0f : x;
+	if (x >= 128.0f)
+		return std::numeric_limits<float>::infinity();
+
+	// Split off the nearest integer so the fraction is in [-0.5, 0.5], where the
+	// Taylor series in ln(2) converges below float precision. Exact at integers.
+	int n = (int)floorf(x + 0.5f);
+	float f = x - (float)n;
+	float r = 1.0f + f * (0.6931471806f + f * (0.2402265070f + f * (0.0555041087f +
+		f * (0.0096181291f + f * (0.0013333558f + f * 0.0001540353f)))));
+
+	// Scale by 2^n through the exponent field, in two steps since n can
+	// slightly exceed the single-scale range at either end.
+	int n1 = n / 2;
+	int n2 = n - n1;
+	union {
+		u32 u;
+		float f;
+	} scale1, scale2;
+	scale1.u = (u32)(n1 + 127) << 23;
+	scale2.u = (u32)(n2 + 127) << 23;
+	return r * scale1.f * scale2.f;
+}
+
+float vfpu_rexp2(float x) {
+	if (!g_vfpuFastTranscendentals)
+		return 1.0f / powf(2.0f, x);
+	return vfpu_exp2(-x);
+}
+
 void GetVectorRegs(u8 regs[4], VectorSize N, int vectorReg) {
 	int mtx = (vectorReg >> 2) & 7;
 	int col = vectorReg & 3;
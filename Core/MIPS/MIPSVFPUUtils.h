@@ -33,10 +33,27 @@ inline int Xpose(int v) {
 #define M_PI_2     1.57079632679489661923
 #endif
 
+// When set (the default), vsin/vcos/vexp2 and friends use fast polynomial
+// approximations instead of calling into libm. The PSP's own results are
+// approximate too, so games are fine with this - the few that need bit-close
+// libm results can set AccurateVFPUTranscendentals in compat.ini.
+extern bool g_vfpuFastTranscendentals;
+
+// Polynomial fast paths, defined in MIPSVFPUUtils.cpp. These return the exact
+// 0.0/1.0/-1.0 values at quadrant boundaries just like the checks below.
+float vfpu_sin_approx(float angle);
+float vfpu_cos_approx(float angle);
+void vfpu_sincos_approx(float angle, float &sine, float &cosine);
+// 2^x and 1/2^x, dispatching on g_vfpuFastTranscendentals internally.
+float vfpu_exp2(float x);
+float vfpu_rexp2(float x);
+
 // Some games depend on exact values, but sinf() and cosf() aren't always precise.
 // Stepping down to [0, 2pi) helps, but we also check common exact-result values.
 
 inline float vfpu_sin(float angle) {
+	if (g_vfpuFastTranscendentals)
+		return vfpu_sin_approx(angle);
 	angle -= floorf(angle * 0.25f) * 4.f;
 	if (angle == 0.0f || angle == 2.0f) {
 		return 0.0f;
@@ -50,6 +67,8 @@ inline float vfpu_sin(float angle) {
 }
 
 inline float vfpu_cos(float angle) {
+	if (g_vfpuFastTranscendentals)
+		return vfpu_cos_approx(angle);
 	angle -= floorf(angle * 0.25f) * 4.f;
 	if (angle == 1.0f || angle == 3.0f) {
 		return 0.0f;
@@ -67,6 +86,10 @@ inline float vfpu_asin(float angle) {
 }
 
 inline void vfpu_sincos(float angle, float &sine, float &cosine) {
+	if (g_vfpuFastTranscendentals) {
+		vfpu_sincos_approx(angle, sine, cosine);
+		return;
+	}
 	angle -= floorf(angle * 0.25f) * 4.f;
 	if (angle == 0.0f) {
 		sine = 0.0f;
@@ -158,6 +158,30 @@ void Jit::GenerateFixedCode(JitOptions &jo) {
 			MOV(32, R(EAX), MIPSSTATE_VAR(pc));
 			dispatcherInEAXNoCheck = GetCodePtr();
 
+			// Fast path: probe the block lookup table before touching game memory.
+			// On a hit we never leave JIT code, on a miss we fall through to the
+			// regular emuhack check below. RCX/RDX are free here.
+			MOV(32, R(ECX), R(EAX));
+			SHR(32, R(ECX), Imm8(2));
+			AND(32, R(ECX), Imm32(JITBLOCK_LOOKUP_ENTRIES - 1));
+			MOV(PTRBITS, R(EDX), ImmPtr(blocks.GetFastBlockLookup()));
+			CMP(32, MComplex(RDX, RCX, SCALE_8, 0), R(EAX));
+			FixupBranch lookupMiss = J_CC(CC_NE);
+				if (enableDebug) {
+					ADD(32, MIPSSTATE_VAR(debugCount), Imm8(1));
+				}
+				MOV(32, R(EAX), MComplex(RDX, RCX, SCALE_8, 4));
+#ifdef _M_IX86
+				ADD(32, R(EAX), ImmPtr(GetBasePtr()));
+#elif _M_X64
+				if (jo.reserveR15ForAsm)
+					ADD(64, R(RAX), R(JITBASEREG));
+				else
+					ADD(64, R(EAX), Imm32(jitbase));
+#endif
+				JMPptr(R(EAX));
+			SetJumpTarget(lookupMiss);
+
 #ifdef MASKED_PSP_MEMORY
 			AND(32, R(EAX), Imm32(Memory::MEMVIEW32_MASK));
 #endif
@@ -22,6 +22,7 @@
 
 #include "Core/Reporting.h"
 #include "Core/Config.h"
+#include "Core/Debugger/Breakpoints.h"
 #include "Core/HLE/HLE.h"
 #include "Core/HLE/HLETables.h"
 #include "Core/Host.h"
@@ -460,6 +461,136 @@ void Jit::BranchRSZeroComp(MIPSOpcode op, Gen::CCFlags cc, bool andLink, bool li
 	}
 }
 
+static bool HasLowSubregister(Gen::OpArg arg) {
+#ifndef _M_X64
+	// Can't use ESI or EDI (which we use), no 8-bit versions.  Only these.
+	if (!arg.IsSimpleReg(EAX) && !arg.IsSimpleReg(EBX) && !arg.IsSimpleReg(ECX) && !arg.IsSimpleReg(EDX)) {
+		return false;
+	}
+#endif
+	return arg.IsSimpleReg();
+}
+
+// Fuses slt/sltu/slti/sltiu with an immediately following beq/bne (or likely variant)
+// against zero into a single host compare.  We still SETcc the architectural result
+// register, but the branch reuses the live flags instead of reloading and re-testing it.
+// This is one of the most common compare-branch idioms gcc emits for PSP code.
+bool Jit::CompileFusedCompBranch(MIPSOpcode op) {
+	if (!jo.fuseCompareBranches || js.inDelaySlot)
+		return false;
+
+	MIPSGPReg rs = _RS;
+	MIPSGPReg rt = _RT;
+	MIPSGPReg resultReg;
+	bool immForm;
+	CCFlags cc;
+	switch (op >> 26) {
+	case 0: // special
+		if ((op & 63) == 42) // slt
+			cc = CC_L;
+		else if ((op & 63) == 43) // sltu
+			cc = CC_B;
+		else
+			return false;
+		// Constant result, the regular path folds this to an imm.
+		if (rs == rt)
+			return false;
+		resultReg = _RD;
+		immForm = false;
+		break;
+	case 10: cc = CC_L; resultReg = rt; immForm = true; break; // slti
+	case 11: cc = CC_B; resultReg = rt; immForm = true; break; // sltiu
+	default:
+		return false;
+	}
+	if (resultReg == MIPS_REG_ZERO)
+		return false;
+	// If the set op itself can't be jitted, it can't be fused either.
+	if (jo.Disabled(immForm ? JitDisable::ALU_IMM : JitDisable::ALU))
+		return false;
+
+	// The next op must branch on the comparison result against zero.
+	MIPSOpcode branchOp = GetOffsetInstruction(1);
+	u32 branchFunc = branchOp >> 26;
+	bool likely = branchFunc == 20 || branchFunc == 21;
+	if (branchFunc != 4 && branchFunc != 5 && !likely)
+		return false;
+	MIPSGPReg brs = MIPS_GET_RS(branchOp);
+	MIPSGPReg brt = MIPS_GET_RT(branchOp);
+	if (!(brs == resultReg && brt == MIPS_REG_ZERO) && !(brt == resultReg && brs == MIPS_REG_ZERO))
+		return false;
+
+	// If the operands are imms, the regular compilers fold both ops away entirely.
+	if (gpr.IsImm(rs) && (immForm || gpr.IsImm(rt)))
+		return false;
+
+	// A breakpoint on the branch needs the un-fused path so it can stop between the ops.
+	if (CBreakPoints::IsAddressBreakPoint(GetCompilerPC() + 4))
+		return false;
+
+	// Emit the comparison once.  The XOR trick below must come before the CMP since it
+	// clobbers flags, same as in the standalone slt compilers.
+	if (immForm) {
+		u32 suimm = (u32)(s32)_IMM16;
+		gpr.Lock(resultReg, rs);
+		gpr.MapReg(resultReg, resultReg == rs, true);
+		bool needsTemp = !HasLowSubregister(gpr.R(resultReg)) || resultReg == rs;
+		if (needsTemp) {
+			CMP(32, gpr.R(rs), Imm32(suimm));
+			SETcc(cc, R(X64JitConstants::TEMPREG));
+			MOVZX(32, 8, gpr.RX(resultReg), R(X64JitConstants::TEMPREG));
+		} else {
+			XOR(32, gpr.R(resultReg), gpr.R(resultReg));
+			CMP(32, gpr.R(rs), Imm32(suimm));
+			SETcc(cc, gpr.R(resultReg));
+		}
+		gpr.UnlockAll();
+	} else {
+		gpr.Lock(resultReg, rs, rt);
+		gpr.MapReg(resultReg, resultReg == rs || resultReg == rt, true);
+
+		// Avoid flushing an imm operand, like the standalone slt does.
+		MIPSGPReg lhs = rs;
+		MIPSGPReg rhs = rt;
+		if (gpr.IsImm(lhs)) {
+			// rhs is guaranteed not to be an imm (checked above.)
+			std::swap(lhs, rhs);
+			cc = SwapCCFlag(cc);
+		} else if (!gpr.R(lhs).CanDoOpWith(gpr.R(rhs))) {
+			gpr.MapReg(lhs, true, false);
+		}
+
+		bool needsTemp = !HasLowSubregister(gpr.R(resultReg)) || resultReg == rs || resultReg == rt;
+		if (needsTemp) {
+			CMP(32, gpr.R(lhs), gpr.R(rhs));
+			SETcc(cc, R(X64JitConstants::TEMPREG));
+			MOVZX(32, 8, gpr.RX(resultReg), R(X64JitConstants::TEMPREG));
+		} else {
+			XOR(32, gpr.R(resultReg), gpr.R(resultReg));
+			CMP(32, gpr.R(lhs), gpr.R(rhs));
+			SETcc(cc, gpr.R(resultReg));
+		}
+		gpr.UnlockAll();
+	}
+
+	// Advance onto the branch, which compiles as part of this op.
+	js.compilerPC += 4;
+	js.numInstructions++;
+	js.downcountAmount += MIPSGetInstructionCycleEstimate(branchOp);
+
+	int offset = (signed short)(branchOp & 0xFFFF) << 2;
+	u32 targetAddr = GetCompilerPC() + offset + 4;
+
+	// CompBranchExits takes the not-taken condition.  beq result, zero is taken when
+	// the comparison was false, so the set condition itself skips the branch.
+	bool isBeq = branchFunc == 4 || branchFunc == 20;
+	CCFlags notTakenCC = isBeq ? cc : FlipCCFlag(cc);
+
+	// The flags carry the comparison across the delay slot, so force the not-nice
+	// paths - DELAYSLOT_SAFE preserves host flags.
+	CompBranchExits(notTakenCC, targetAddr, GetCompilerPC() + 8, false, likely, false);
+	return true;
+}
 
 void Jit::Comp_RelBranch(MIPSOpcode op)
 {
@@ -680,6 +811,29 @@ void Jit::Comp_JumpReg(MIPSOpcode op)
 	X64Reg destReg = EAX;
 	if (IsSyscall(delaySlotOp))
 	{
+#ifndef USE_PROFILER
+		// Simple syscalls (see HLE_SPECIAL_JIT_SIMPLE) can't switch threads, so we can
+		// call the handler in place and take the ordinary jump exit instead of the
+		// syscall exit, skipping the dispatch wrapper and the core state check.
+		HLEFunc simpleFunc = GetSimpleSyscallFunc(delaySlotOp);
+		if (simpleFunc != nullptr) {
+			// Still check for breakpoints on the delay slot, like CompileDelaySlot.
+			CheckJitBreakpoint(GetCompilerPC() + 4, -2);
+			gpr.MapReg(rs, true, false);
+			MOV(32, MIPSSTATE_VAR(savedPC), gpr.R(rs));
+			if (andLink)
+				gpr.SetImm(rd, GetCompilerPC() + 8);
+			FlushAll();
+			RestoreRoundingMode();
+			ABI_CallFunction((const void *)simpleFunc);
+			ApplyRoundingMode();
+			MOV(32, R(EAX), MIPSSTATE_VAR(savedPC));
+			WriteExitDestInReg(EAX);
+			js.compiling = false;
+			return;
+		}
+#endif
+
 		// If this is a syscall, write the pc (for thread switching and other good reasons.)
 		gpr.MapReg(rs, true, false);
 		MOV(32, MIPSSTATE_VAR(pc), gpr.R(rs));
@@ -757,6 +911,23 @@ void Jit::Comp_Syscall(MIPSOpcode op)
 		WARN_LOG(JIT, "Encountered bad syscall instruction at %08x (%08x)", js.compilerPC, op.encoding);
 	}
 
+#ifndef USE_PROFILER
+	// Simple syscalls (see HLE_SPECIAL_JIT_SIMPLE) only write a result and eat
+	// cycles, so we can call them in place and keep compiling the block - no
+	// need to exit and check for a thread switch.
+	HLEFunc simpleFunc = GetSimpleSyscallFunc(op);
+	if (simpleFunc != nullptr && !js.inDelaySlot) {
+		FlushAll();
+		// The handler may eat cycles, so the downcount needs to be current.
+		WriteDowncount();
+		js.downcountAmount = 0;
+		RestoreRoundingMode();
+		ABI_CallFunction((const void *)simpleFunc);
+		ApplyRoundingMode();
+		return;
+	}
+#endif
+
 	if (!g_Config.bSkipDeadbeefFilling)
 	{
 		// All of these will be overwritten with DEADBEEF anyway.
@@ -2198,6 +2198,14 @@ void SinCosNegSin(SinCosArg angle, float *output) {
 	output[0] = -output[0];
 }
 
+void Exp2(SinCosArg arg, float *output) {
+	output[0] = vfpu_exp2(arg);
+}
+
+void RExp2(SinCosArg arg, float *output) {
+	output[0] = vfpu_rexp2(arg);
+}
+
 void Jit::Comp_VV2Op(MIPSOpcode op) {
 	CONDITIONAL_DISABLE(VFPU_VEC);
 
@@ -2395,7 +2403,8 @@ void Jit::Comp_VV2Op(MIPSOpcode op) {
 			MOVSS(tempxregs[i], MIPSSTATE_VAR(sincostemp[1]));
 			break;
 		case 20: // d[i] = powf(2.0f, s[i]); break; //vexp2
-			DISABLE;
+			trigCallHelper(&Exp2, sregs[i]);
+			MOVSS(tempxregs[i], MIPSSTATE_VAR(sincostemp[0]));
 			break;
 		case 21: // d[i] = logf(s[i])/log(2.0f); break; //vlog2
 			DISABLE;
@@ -2421,7 +2430,8 @@ void Jit::Comp_VV2Op(MIPSOpcode op) {
 			MOVSS(tempxregs[i], MIPSSTATE_VAR(sincostemp[0]));
 			break;
 		case 28: // d[i] = 1.0f / expf(s[i] * (float)M_LOG2E); break; // vrexp2
-			DISABLE;
+			trigCallHelper(&RExp2, sregs[i]);
+			MOVSS(tempxregs[i], MIPSSTATE_VAR(sincostemp[0]));
 			break;
 		}
 	}
@@ -3590,65 +3600,61 @@ void Jit::Comp_ColorConv(MIPSOpcode op) {
 	CONDITIONAL_DISABLE(VFPU_VEC);
 	if (js.HasUnknownPrefix())
 		DISABLE;
+	if (!js.HasNoPrefix())
+		DISABLE;
 
-	int vd = _VD;
-	int vs = _VS;
-
-	DISABLE;
-#if 0
-	VectorSize sz = V_Quad;
-	int n = GetNumVectorElements(sz);
+	// Each of these packs just keeps the top bits of selected 8-bit channels, which
+	// is exactly a parallel bit extract with a constant mask. Without BMI2 we stay
+	// on the interpreter.
+	if (!cpu_info.bBMI2)
+		DISABLE;
 
+	u32 mask;
 	switch ((op >> 16) & 3) {
-	case 1:
+	case 1:  // 4444
+		mask = 0xF0F0F0F0;
+		break;
+	case 2:  // 5551
+		mask = 0x80F8F8F8;
+		break;
+	case 3:  // 565
+		mask = 0x00F8FCF8;
 		break;
 	default:
 		DISABLE;
 	}
 
 	u8 sregs[4];
-	u8 dregs[1];
-	// WARNING: Prefixes.
-	GetVectorRegs(sregs, sz, vs);
-	GetVectorRegs(dregs, V_Pair, vd);
+	u8 dregs[2];
+	GetVectorRegs(sregs, V_Quad, _VS);
+	GetVectorRegs(dregs, V_Pair, _VD);
 
-	if (fpr.TryMapDirtyInVS(dregs, V_Single, sregs, sz)) {
-		switch ((op >> 16) & 3) {
-		case 1:  // 4444
-		{
-			//int a = ((in >> 24) & 0xFF) >> 4;
-			//int b = ((in >> 16) & 0xFF) >> 4;
-			//int g = ((in >> 8) & 0xFF) >> 4;
-			//int r = ((in)& 0xFF) >> 4;
-			//col = (a << 12) | (b << 8) | (g << 4) | (r);
-			//PACKUSW
-			break;
-		}
-		case 2:  // 5551
-		{
-			//int a = ((in >> 24) & 0xFF) >> 7;
-			//int b = ((in >> 16) & 0xFF) >> 3;
-			//int g = ((in >> 8) & 0xFF) >> 3;
-			//int r = ((in)& 0xFF) >> 3;
-			//col = (a << 15) | (b << 10) | (g << 5) | (r);
-			break;
-		}
-		case 3:  // 565
-		{
-			//int b = ((in >> 16) & 0xFF) >> 3;
-			//int g = ((in >> 8) & 0xFF) >> 2;
-			//int r = ((in)& 0xFF) >> 3;
-			//col = (b << 11) | (g << 5) | (r);
-			break;
+	// Flush SIMD.
+	fpr.SimpleRegsV(sregs, V_Quad, 0);
+
+	X64Reg maskReg = gpr.GetFreeXReg();
+	MOV(32, R(maskReg), Imm32(mask));
+
+	// Extract the four 16-bit colors into XMM0's lanes, then write out both pairs.
+	// Doing all the reads before mapping the destination keeps overlapping source
+	// and destination rows safe.
+	for (int i = 0; i < 4; i++) {
+		if (fpr.V(sregs[i]).IsSimpleReg()) {
+			MOVD_xmm(R(TEMPREG), fpr.VX(sregs[i]));
+		} else {
+			MOV(32, R(TEMPREG), fpr.V(sregs[i]));
 		}
+		PEXT(32, TEMPREG, TEMPREG, R(maskReg));
+		PINSRW(XMM0, R(TEMPREG), i);
 	}
-		DISABLE;
 
-	// Flush SIMD.
-	fpr.SimpleRegsV(&sreg, V_Pair, MAP_NOINIT | MAP_DIRTY);
-	fpr.SimpleRegsV(&dreg, V_Pair, MAP_NOINIT | MAP_DIRTY);
-#endif
+	fpr.MapRegsV(dregs, V_Pair, MAP_NOINIT | MAP_DIRTY);
+	MOVSS(fpr.V(dregs[0]), XMM0);
+	SHUFPS(XMM0, R(XMM0), _MM_SHUFFLE(3, 3, 2, 1));
+	MOVSS(fpr.V(dregs[1]), XMM0);
 
+	gpr.UnlockAllX();
+	fpr.ReleaseSpillLocks();
 }
 }
 
@@ -91,6 +91,18 @@ u32 JitBreakpoint()
 
 extern void JitMemCheckCleanup();
 
+// x86-64 near jumps reach much further, but there's little point going beyond this.
+static const int MAX_CODE_SPACE_MB = 64;
+
+static int InitialCodeSpaceSize() {
+	int mb = g_Config.iJitCodeCacheMB;
+	if (mb < 4)
+		mb = 4;
+	if (mb > MAX_CODE_SPACE_MB)
+		mb = MAX_CODE_SPACE_MB;
+	return mb * 1024 * 1024;
+}
+
 static void JitLogMiss(MIPSOpcode op)
 {
 	if (USE_JIT_MISSMAP)
@@ -109,7 +121,7 @@ Jit::Jit(MIPSState *mips)
 	blocks.Init();
 	gpr.SetEmitter(this);
 	fpr.SetEmitter(this);
-	AllocCodeSpace(1024 * 1024 * 16);
+	AllocCodeSpace(InitialCodeSpaceSize());
 	GenerateFixedCode(jo);
 
 	safeMemFuncs.Init(&thunks);
@@ -213,6 +225,18 @@ void Jit::ClearCache()
 	GenerateFixedCode(jo);
 }
 
+// Overflowing the code space throws all blocks away anyway, so take the chance
+// to double the arena - long sessions converge on a size where the recompile
+// storms stop instead of recurring every time the cache refills.
+void Jit::GrowCodeSpace() {
+	size_t newSize = std::min(region_size * 2, (size_t)MAX_CODE_SPACE_MB * 1024 * 1024);
+	WARN_LOG(JIT, "JIT code space full, growing %d MB -> %d MB", (int)(region_size >> 20), (int)(newSize >> 20));
+	blocks.Clear();
+	FreeCodeSpace();
+	AllocCodeSpace((int)newSize);
+	GenerateFixedCode(jo);
+}
+
 void Jit::SaveFlags() {
 	PUSHF();
 #if defined(_M_X64)
@@ -270,6 +294,12 @@ void Jit::EatInstruction(MIPSOpcode op) {
 void Jit::Compile(u32 em_address) {
 	PROFILE_THIS_SCOPE("jitc");
 	if (GetSpaceLeft() < 0x10000 || blocks.IsFull()) {
+		if (!blocks.IsFull() && region_size < (size_t)MAX_CODE_SPACE_MB * 1024 * 1024) {
+			// We were called from the dispatcher, which executes from this region -
+			// remapping it here would free the code we return into. Clear in place
+			// for now and grow once no generated code is left on the stack.
+			growPending_ = true;
+		}
 		ClearCache();
 	}
 
@@ -310,6 +340,10 @@ void Jit::Compile(u32 em_address) {
 
 void Jit::RunLoopUntil(u64 globalticks) {
 	PROFILE_THIS_SCOPE("jit");
+	if (growPending_) {
+		growPending_ = false;
+		GrowCodeSpace();
+	}
 	((void (*)())enterDispatcher)();
 }
 
@@ -344,6 +378,12 @@ const u8 *Jit::DoJit(u32 em_address, JitBlock *b) {
 
 	b->normalEntry = GetCodePtr();
 
+	if (g_Config.bJitBlockProfiling) {
+		// RAX is dead on block entry - the dispatcher uses it as a scratch.
+		MOV(PTRBITS, R(RAX), ImmPtr(blocks.GetExecCounter(b->blockNum)));
+		ADD(32, MatR(RAX), Imm8(1));
+	}
+
 	MIPSAnalyst::AnalysisResults analysis = MIPSAnalyst::Analyze(em_address);
 
 	gpr.Start(mips_, &js, &jo, analysis);
@@ -357,7 +397,9 @@ const u8 *Jit::DoJit(u32 em_address, JitBlock *b) {
 		MIPSOpcode inst = Memory::Read_Opcode_JIT(GetCompilerPC());
 		js.downcountAmount += MIPSGetInstructionCycleEstimate(inst);
 
-		MIPSCompileOp(inst, this);
+		// Peephole: compare-branch pairs fuse into a single host compare.
+		if (!CompileFusedCompBranch(inst))
+			MIPSCompileOp(inst, this);
 
 		if (js.afterOp & JitState::AFTER_CORE_STATE) {
 			// TODO: Save/restore?
@@ -182,6 +182,9 @@ public:
 
 private:
 	void GenerateFixedCode(JitOptions &jo);
+	void GrowCodeSpace();
+	// Set when the code space should be regrown at the next safe point (see Compile()).
+	bool growPending_ = false;
 	void GetStateAndFlushAll(RegCacheState &state);
 	void RestoreState(const RegCacheState& state);
 	void FlushAll();
@@ -211,6 +214,7 @@ private:
 	void BranchVFPUFlag(MIPSOpcode op, Gen::CCFlags cc, bool likely);
 	void BranchRSZeroComp(MIPSOpcode op, Gen::CCFlags cc, bool andLink, bool likely);
 	void BranchRSRTComp(MIPSOpcode op, Gen::CCFlags cc, bool likely);
+	bool CompileFusedCompBranch(MIPSOpcode op);
 	void BranchLog(MIPSOpcode op);
 	void BranchLogExit(MIPSOpcode op, u32 dest, bool useEAX);
 
@@ -225,6 +225,14 @@ void JitSafeMem::PrepareSlowAccess()
 	jit_->CMP(32, R(xaddr_), Imm32(PSP_GetScratchpadMemoryEnd() - offset_ - (size_ - 1)));
 	jit_->J_CC(CC_B, safe_);
 	jit_->SetJumpTarget(tooLow);
+
+	// Or VRAM - the full mirrored range is mapped, so direct access is fine
+	// there too (same ranges JitSafeMemFuncs::CheckDirectEAX accepts).
+	jit_->CMP(32, R(xaddr_), Imm32(PSP_GetVidMemBase() - offset_));
+	FixupBranch tooLowVid = jit_->J_CC(CC_B);
+	jit_->CMP(32, R(xaddr_), Imm32(PSP_GetVidMemEnd() - offset_ - (size_ - 1)));
+	jit_->J_CC(CC_B, safe_);
+	jit_->SetJumpTarget(tooLowVid);
 }
 
 bool JitSafeMem::PrepareSlowWrite()
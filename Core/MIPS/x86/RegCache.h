@@ -119,10 +119,11 @@ public:
 	void GetState(GPRRegCacheState &state) const;
 	void RestoreState(const GPRRegCacheState& state);
 
+	Gen::X64Reg GetFreeXReg();
+
 	MIPSState *mips;
 
 private:
-	Gen::X64Reg GetFreeXReg();
 	Gen::X64Reg FindBestToSpill(bool unusedOnly, bool *clobbered);
 	const Gen::X64Reg *GetAllocationOrder(int &count);
 
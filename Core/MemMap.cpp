@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <mutex>
+#include <vector>
 
 #include "Common/Common.h"
 #include "Common/MemoryUtil.h"
@@ -116,6 +117,79 @@ static MemoryView views[] =
 
 static const int num_views = sizeof(views) / sizeof(MemoryView);
 
+// Write watch bookkeeping. The bitmap has one bit per 4KB page of the
+// physical address space (masked to 0x3FFFFFFF, so mirrors alias correctly),
+// checked by Write_* before anything else happens. The watch list itself is
+// only scanned after a bitmap hit.
+struct WriteWatch {
+	int handle;
+	u32 start;
+	u32 size;
+	WriteWatchCallback callback;
+	void *context;
+};
+
+enum {
+	// Enough for scratchpad, VRAM and the largest remaster RAM layouts.
+	WRITE_WATCH_PAGE_COUNT = 0x0C000000 >> 12,
+};
+
+bool writeWatchActive = false;
+static std::vector<WriteWatch> writeWatches;
+static int nextWriteWatchHandle = 1;
+static u8 writeWatchPages[WRITE_WATCH_PAGE_COUNT >> 3];
+static std::mutex writeWatchLock;
+
+static void RebuildWriteWatchPages() {
+	memset(writeWatchPages, 0, sizeof(writeWatchPages));
+	for (const auto &w : writeWatches) {
+		u32 firstPage = (w.start & 0x3FFFFFFF) >> 12;
+		u32 lastPage = ((w.start & 0x3FFFFFFF) + w.size - 1) >> 12;
+		for (u32 page = firstPage; page <= lastPage && page < WRITE_WATCH_PAGE_COUNT; ++page) {
+			writeWatchPages[page >> 3] |= 1 << (page & 7);
+		}
+	}
+	writeWatchActive = !writeWatches.empty();
+}
+
+int RegisterWriteWatch(u32 start, u32 size, WriteWatchCallback callback, void *context) {
+	std::lock_guard<std::mutex> guard(writeWatchLock);
+	WriteWatch w{};
+	w.handle = nextWriteWatchHandle++;
+	w.start = start;
+	w.size = size;
+	w.callback = callback;
+	w.context = context;
+	writeWatches.push_back(w);
+	RebuildWriteWatchPages();
+	return w.handle;
+}
+
+void UnregisterWriteWatch(int handle) {
+	std::lock_guard<std::mutex> guard(writeWatchLock);
+	for (size_t i = 0; i < writeWatches.size(); ++i) {
+		if (writeWatches[i].handle == handle) {
+			writeWatches.erase(writeWatches.begin() + i);
+			break;
+		}
+	}
+	RebuildWriteWatchPages();
+}
+
+void NotifyWriteWatch(u32 address, int size) {
+	u32 page = (address & 0x3FFFFFFF) >> 12;
+	if (page >= WRITE_WATCH_PAGE_COUNT || (writeWatchPages[page >> 3] & (1 << (page & 7))) == 0)
+		return;
+
+	std::lock_guard<std::mutex> guard(writeWatchLock);
+	u32 masked = address & 0x3FFFFFFF;
+	for (const auto &w : writeWatches) {
+		if (masked + size > (w.start & 0x3FFFFFFF) && masked < (w.start & 0x3FFFFFFF) + w.size) {
+			w.callback(address, size, w.context);
+		}
+	}
+}
+
 inline static bool CanIgnoreView(const MemoryView &view) {
 #if PPSSPP_ARCH(32BIT)
 	// Basically, 32-bit platforms can ignore views that are masked out anyway.
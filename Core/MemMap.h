@@ -274,6 +274,19 @@ bool IsRAMAddress(const u32 address);
 bool IsVRAMAddress(const u32 address);
 bool IsScratchpadAddress(const u32 address);
 
+// Write watch: register a callback that fires when the CPU writes inside a
+// range. Pages covering the range are flagged in a bitmap that Write_* checks,
+// so the per-write cost is one branch plus a bit test - no range list scans.
+// Only writes that go through Write_* are seen; the jit fastmem path stores
+// straight to host memory, so consumers needing full coverage must also hook
+// the bulk-transfer HLE paths they care about.
+typedef void (*WriteWatchCallback)(u32 address, int size, void *context);
+int RegisterWriteWatch(u32 start, u32 size, WriteWatchCallback callback, void *context);
+void UnregisterWriteWatch(int handle);
+// Called by Write_* after the bitmap hits - don't call directly.
+void NotifyWriteWatch(u32 address, int size);
+extern bool writeWatchActive;
+
 inline const char* GetCharPointer(const u32 address) {
 	return (const char *)GetPointer(address);
 }
@@ -334,6 +347,32 @@ inline bool IsValidRange(const u32 address, const u32 size) {
 	return IsValidAddress(address) && ValidSize(address, size) == size;
 }
 
+// The result of classifying a guest buffer argument once: the host pointer and
+// how many bytes of the request are actually backed by PSP memory. For syscall
+// arguments that get checked, clamped and then dereferenced, prefer this over
+// separate IsValidAddress/ValidSize/GetPointer calls - each of those redoes
+// the same range compares.
+struct ValidRange {
+	u8 *ptr;   // Host pointer, nullptr when the address is invalid.
+	u32 size;  // Bytes backed by PSP memory, clamped to the request.
+
+	bool IsValid() const {
+		return ptr != nullptr;
+	}
+};
+
+inline ValidRange GetValidRange(const u32 address, const u32 requested_size) {
+	ValidRange range;
+	if (IsValidAddress(address)) {
+		range.ptr = GetPointerUnchecked(address);
+		range.size = ValidSize(address, requested_size);
+	} else {
+		range.ptr = nullptr;
+		range.size = 0;
+	}
+	return range;
+}
+
 };
 
 template <typename T>
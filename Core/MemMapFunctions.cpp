@@ -110,6 +110,9 @@ template <typename T>
 inline void WriteToHardware(u32 address, const T data) {
 	// Could just do a base-relative write, too.... TODO
 
+	if (writeWatchActive)
+		NotifyWriteWatch(address, sizeof(T));
+
 	if ((address & 0x3E000000) == 0x08000000) {
 		// RAM
 		*(T*)GetPointerUnchecked(address) = data;
@@ -22,6 +22,7 @@
 #include "Core/Reporting.h"
 
 #include "Common/CPUDetect.h"
+#include "Common/FileUtil.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/Config.h"
@@ -36,6 +37,8 @@
 #include "Core/ELF/ParamSFO.h"
 #include "GPU/GPUInterface.h"
 #include "GPU/GPUState.h"
+#include "ext/xxhash.h"
+#include "file/ini_file.h"
 #include "net/http_client.h"
 #include "net/resolve.h"
 #include "net/url.h"
@@ -93,58 +96,158 @@ namespace Reporting
 	static std::condition_variable crcCond;
 	static std::string crcFilename;
 	static std::map<std::string, u32> crcResults;
+	// Flipped on once something blocks on the CRC, to stop throttling the hash.
+	static volatile bool crcWanted = false;
+
+	// All deferred reporting work (sending reports and the disc CRC) runs on
+	// a single persistent service thread instead of one detached thread per
+	// request. It parks on pendingCond when idle and drains the whole queue
+	// per wakeup, so a burst of reports costs one wakeup rather than one
+	// thread each.
+	static std::mutex pendingLock;
+	static std::condition_variable pendingCond;
+	static std::vector<int> pendingPayloads;
+	static bool pendingCRC = false;
+	static bool serviceRunning = false;
+	static std::thread::id serviceThreadId;
+
+	static void ServiceThread();
+
+	// Must be called with pendingLock held.
+	static void StartServiceLocked() {
+		if (!serviceRunning) {
+			serviceRunning = true;
+			std::thread th(ServiceThread);
+			th.detach();
+		}
+	}
 
-	static int CalculateCRCThread() {
-		setCurrentThreadName("ReportCRC");
+	// Disc CRCs are also cached on disk, so each disc only has to be hashed
+	// once ever rather than once per app run. Entries are keyed by a hash of
+	// the path (paths don't survive as ini keys) and validated against the
+	// file's size and mtime - if the file changed, we rehash.
+	static std::string CRCCacheFilename() {
+		return GetSysDirectory(DIRECTORY_CACHE) + "DISCCRC.ini";
+	}
 
-		// TODO: Use the blockDevice from pspFileSystem?
-		FileLoader *fileLoader = ConstructFileLoader(crcFilename);
-		BlockDevice *blockDevice = constructBlockDevice(fileLoader);
+	static std::string CRCCacheKey(const std::string &filename) {
+		char key[17];
+		snprintf(key, sizeof(key), "%016llx", (unsigned long long)XXH64(filename.data(), filename.size(), 0));
+		return key;
+	}
 
-		u32 crc = 0;
-		if (blockDevice) {
-			crc = blockDevice->CalculateCRC();
+	static bool LookupCRCCache(const std::string &filename, u32 *crc) {
+		File::FileDetails details;
+		if (!File::GetFileDetails(filename, &details))
+			return false;
+
+		IniFile ini;
+		if (!ini.Load(CRCCacheFilename()))
+			return false;
+
+		std::string entry;
+		ini.GetOrCreateSection("CRC")->Get(CRCCacheKey(filename).c_str(), &entry, "");
+		unsigned int value = 0;
+		unsigned long long size = 0, mtime = 0;
+		if (sscanf(entry.c_str(), "%x/%llu/%llu", &value, &size, &mtime) != 3)
+			return false;
+		if (size != details.size || mtime != details.mtime)
+			return false;
+
+		*crc = value;
+		return true;
+	}
+
+	static void StoreCRCCache(const std::string &filename, u32 crc) {
+		File::FileDetails details;
+		if (!File::GetFileDetails(filename, &details))
+			return;
+
+		char entry[64];
+		snprintf(entry, sizeof(entry), "%08x/%llu/%llu", crc, (unsigned long long)details.size, (unsigned long long)details.mtime);
+
+		File::CreateFullPath(GetSysDirectory(DIRECTORY_CACHE));
+		IniFile ini;
+		// Fine if it doesn't exist yet.
+		ini.Load(CRCCacheFilename());
+		ini.GetOrCreateSection("CRC")->Set(CRCCacheKey(filename).c_str(), entry);
+		ini.Save(CRCCacheFilename());
+	}
+
+	static void ProcessCRC() {
+		std::string filename;
+		{
+			std::lock_guard<std::mutex> guard(crcLock);
+			filename = crcFilename;
 		}
 
-		delete blockDevice;
-		delete fileLoader;
+		u32 crc = 0;
+		if (!LookupCRCCache(filename, &crc)) {
+			// TODO: Use the blockDevice from pspFileSystem?
+			FileLoader *fileLoader = ConstructFileLoader(filename);
+			BlockDevice *blockDevice = constructBlockDevice(fileLoader);
+
+			if (blockDevice) {
+				crc = blockDevice->CalculateCRC(&crcWanted);
+			}
+
+			delete blockDevice;
+			delete fileLoader;
+
+			if (crc != 0) {
+				StoreCRCCache(filename, crc);
+			}
+		}
 
 		std::lock_guard<std::mutex> guard(crcLock);
-		crcResults[crcFilename] = crc;
+		crcResults[filename] = crc;
 		crcCond.notify_one();
-
-		return 0;
 	}
 
 	void QueueCRC() {
-		std::lock_guard<std::mutex> guard(crcLock);
+		{
+			std::lock_guard<std::mutex> guard(crcLock);
+
+			const std::string &gamePath = PSP_CoreParameter().fileToStart;
+			auto it = crcResults.find(gamePath);
+			if (it != crcResults.end()) {
+				// Nothing to do, we've already calculated it.
+				// Note: we assume it stays static until the app is closed.
+				return;
+			}
 
-		const std::string &gamePath = PSP_CoreParameter().fileToStart;
-		auto it = crcResults.find(gamePath);
-		if (it != crcResults.end()) {
-			// Nothing to do, we've already calculated it.
-			// Note: we assume it stays static until the app is closed.
-			return;
-		}
+			if (crcFilename == gamePath) {
+				// Already in process.
+				return;
+			}
 
-		if (crcFilename == gamePath) {
-			// Already in process.
-			return;
+			crcFilename = gamePath;
+			crcWanted = false;
 		}
 
-		crcFilename = gamePath;
-		std::thread th(CalculateCRCThread);
-		th.detach();
+		std::lock_guard<std::mutex> guard(pendingLock);
+		StartServiceLocked();
+		pendingCRC = true;
+		pendingCond.notify_one();
 	}
 
 	u32 RetrieveCRC() {
 		const std::string &gamePath = PSP_CoreParameter().fileToStart;
 		QueueCRC();
+		crcWanted = true;
 
 		std::unique_lock<std::mutex> guard(crcLock);
 		auto it = crcResults.find(gamePath);
 		while (it == crcResults.end()) {
-			crcCond.wait(guard);
+			if (std::this_thread::get_id() == serviceThreadId) {
+				// A report being processed on the service thread can't wait
+				// for the same thread to hash - do it inline.
+				guard.unlock();
+				ProcessCRC();
+				guard.lock();
+			} else {
+				crcCond.wait(guard);
+			}
 			it = crcResults.find(gamePath);
 		}
 
@@ -389,8 +492,6 @@ namespace Reporting
 
 	int Process(int pos)
 	{
-		setCurrentThreadName("Report");
-
 		Payload &payload = payloadBuffer[pos];
 		Buffer output;
 
@@ -455,6 +556,41 @@ namespace Reporting
 		return 0;
 	}
 
+	static void ServiceThread()
+	{
+		setCurrentThreadName("Report");
+
+		std::unique_lock<std::mutex> guard(pendingLock);
+		serviceThreadId = std::this_thread::get_id();
+		while (true) {
+			while (pendingPayloads.empty() && !pendingCRC)
+				pendingCond.wait(guard);
+
+			// Take everything queued so far in one go.
+			bool doCRC = pendingCRC;
+			pendingCRC = false;
+			std::vector<int> work = std::move(pendingPayloads);
+			pendingPayloads.clear();
+
+			guard.unlock();
+			// The CRC goes first - a compat report in the batch may block on it.
+			if (doCRC)
+				ProcessCRC();
+			for (int pos : work)
+				Process(pos);
+			guard.lock();
+		}
+	}
+
+	// Hands a filled-in payload to the service thread, starting it on first use.
+	static void QueuePayload(int pos)
+	{
+		std::lock_guard<std::mutex> guard(pendingLock);
+		StartServiceLocked();
+		pendingPayloads.push_back(pos);
+		pendingCond.notify_one();
+	}
+
 	bool IsSupported()
 	{
 		// Disabled when using certain hacks, because they make for poor reports.
@@ -559,8 +695,7 @@ namespace Reporting
 		payload.string1 = message;
 		payload.string2 = temp;
 
-		std::thread th(Process, pos);
-		th.detach();
+		QueuePayload(pos);
 	}
 
 	void ReportMessageFormatted(const char *message, const char *formatted)
@@ -576,8 +711,7 @@ namespace Reporting
 		payload.string1 = message;
 		payload.string2 = formatted;
 
-		std::thread th(Process, pos);
-		th.detach();
+		QueuePayload(pos);
 	}
 
 	void ReportCompatibility(const char *compat, int graphics, int speed, int gameplay, const std::string &screenshotFilename)
@@ -596,8 +730,11 @@ namespace Reporting
 		payload.int2 = speed;
 		payload.int3 = gameplay;
 
-		std::thread th(Process, pos);
-		th.detach();
+		// Get the CRC hashing (which this report will wait on) while the
+		// payload is still queued, so the batch processes it first.
+		if (!Core_GetPowerSaving())
+			QueueCRC();
+		QueuePayload(pos);
 	}
 
 	std::vector<std::string> CompatibilitySuggestions() {
@@ -96,7 +96,7 @@ namespace SaveState
 
 	struct StateRingbuffer
 	{
-		StateRingbuffer(int size) : first_(0), next_(0), size_(size), base_(-1)
+		StateRingbuffer(int size) : first_(0), next_(0), size_(size), base_(-1), lastCompressedSize_(0)
 		{
 			states_.resize(size);
 			baseMapping_.resize(size);
@@ -114,10 +114,14 @@ namespace SaveState
 			std::vector<u8> *compressBuffer = &buffer;
 			CChunkFileReader::Error err;
 
-			if (base_ == -1 || ++baseUsage_ > BASE_USAGE_INTERVAL)
+			// Also rebase when deltas have grown too large to be worth diffing against
+			// a stale base - the game has rewritten too much memory since.
+			bool deltaTooBig = base_ != -1 && lastCompressedSize_ > bases_[base_].size() / 4;
+			if (base_ == -1 || ++baseUsage_ > BASE_USAGE_INTERVAL || deltaTooBig)
 			{
 				base_ = (base_ + 1) % ARRAY_SIZE(bases_);
 				baseUsage_ = 0;
+				lastCompressedSize_ = 0;
 				err = SaveToRam(bases_[base_]);
 				// Let's not bother savestating twice.
 				compressBuffer = &bases_[base_];
@@ -126,7 +130,25 @@ namespace SaveState
 				err = SaveToRam(buffer);
 
 			if (err == CChunkFileReader::ERROR_NONE)
-				ScheduleCompress(&states_[n], compressBuffer, &bases_[base_]);
+			{
+				if (compressBuffer == &bases_[base_])
+				{
+					// The base is its own delta - every block matches, so just emit
+					// the unchanged-run markers without comparing anything.
+					StateBuffer &flags = states_[n];
+					flags.clear();
+					size_t blocks = (bases_[base_].size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+					while (blocks > 0)
+					{
+						u8 run = (u8)std::min(blocks, (size_t)255);
+						flags.push_back(0);
+						flags.push_back(run);
+						blocks -= run;
+					}
+				}
+				else
+					ScheduleCompress(&states_[n], compressBuffer, &bases_[base_]);
+			}
 			else
 				states_[n].clear();
 			baseMapping_[n] = base_;
@@ -154,6 +176,7 @@ namespace SaveState
 		{
 			auto th = new std::thread([=]{
 				setCurrentThreadName("SaveStateCompress");
+				setCurrentThreadAffinityClass(THREAD_AFFINITY_EFFICIENCY);
 				Compress(*result, *state, *base);
 			});
 			th->detach();
@@ -167,6 +190,8 @@ namespace SaveState
 				return;
 
 			result.clear();
+			result.reserve(state.size() / BLOCK_SIZE);
+			ptrdiff_t lastRun = -1;
 			for (size_t i = 0; i < state.size(); i += BLOCK_SIZE)
 			{
 				int blockSize = std::min(BLOCK_SIZE, (int)(state.size() - i));
@@ -174,10 +199,22 @@ namespace SaveState
 				{
 					result.push_back(1);
 					result.insert(result.end(), state.begin() + i, state.begin() +i + blockSize);
+					lastRun = -1;
 				}
 				else
-					result.push_back(0);
+				{
+					// Unchanged blocks are run-length encoded: a 0 marker, then a count.
+					if (lastRun >= 0 && result[lastRun + 1] < 255)
+						++result[lastRun + 1];
+					else
+					{
+						lastRun = (ptrdiff_t)result.size();
+						result.push_back(0);
+						result.push_back(1);
+					}
+				}
 			}
+			lastCompressedSize_ = result.size();
 		}
 
 		void LockedDecompress(std::vector<u8> &result, const std::vector<u8> &compressed, const std::vector<u8> &base)
@@ -189,10 +226,14 @@ namespace SaveState
 			{
 				if (compressed[i] == 0)
 				{
-					++i;
-					int blockSize = std::min(BLOCK_SIZE, (int)(base.size() - result.size()));
-					result.insert(result.end(), basePos, basePos + blockSize);
-					basePos += blockSize;
+					int run = compressed[i + 1];
+					i += 2;
+					for (int j = 0; j < run; ++j)
+					{
+						int blockSize = std::min(BLOCK_SIZE, (int)(base.size() - result.size()));
+						result.insert(result.end(), basePos, basePos + blockSize);
+						basePos += blockSize;
+					}
 				}
 				else
 				{
@@ -219,7 +260,7 @@ namespace SaveState
 		}
 
 		static const int BLOCK_SIZE;
-		// TODO: Instead, based on size of compressed state?
+		// Upper bound - we rebase sooner if the deltas grow too large.
 		static const int BASE_USAGE_INTERVAL;
 
 		typedef std::vector<u8> StateBuffer;
@@ -235,6 +276,8 @@ namespace SaveState
 
 		int base_;
 		int baseUsage_;
+		// Updated by the compress thread under lock_, read by Save().
+		size_t lastCompressedSize_;
 	};
 
 	static bool needsProcess = false;
@@ -531,6 +574,50 @@ namespace SaveState
 		return File::Exists(fn);
 	}
 
+	static std::string GenerateBootSnapshotFilename(const std::string &gameFilename)
+	{
+		// The slot number is meaningless for the boot snapshot, there's only one.
+		return GenerateSaveSlotFilename(gameFilename, 0, BOOT_STATE_EXTENSION);
+	}
+
+	bool HasBootSnapshot(const std::string &gameFilename)
+	{
+		return File::Exists(GenerateBootSnapshotFilename(gameFilename));
+	}
+
+	void SaveBootSnapshot(const std::string &gameFilename, Callback callback, void *cbUserData)
+	{
+		std::string fn = GenerateBootSnapshotFilename(gameFilename);
+		if (!fn.empty()) {
+			auto renameCallback = [=](Status status, const std::string &message, void *data) {
+				if (status != Status::FAILURE) {
+					DeleteIfExists(fn);
+					File::Rename(fn + ".tmp", fn);
+				}
+				if (callback) {
+					callback(status, message, data);
+				}
+			};
+			Save(fn + ".tmp", renameCallback, cbUserData);
+		} else {
+			I18NCategory *sy = GetI18NCategory("System");
+			if (callback)
+				callback(Status::FAILURE, sy->T("Failed to save state. Error in the file system."), cbUserData);
+		}
+	}
+
+	void LoadBootSnapshot(const std::string &gameFilename, Callback callback, void *cbUserData)
+	{
+		std::string fn = GenerateBootSnapshotFilename(gameFilename);
+		if (!fn.empty()) {
+			Load(fn, callback, cbUserData);
+		} else {
+			I18NCategory *sy = GetI18NCategory("System");
+			if (callback)
+				callback(Status::FAILURE, sy->T("Failed to load state. Error in the file system."), cbUserData);
+		}
+	}
+
 	bool operator < (const tm &t1, const tm &t2) {
 		if (t1.tm_year < t2.tm_year) return true;
 		if (t1.tm_year > t2.tm_year) return false;
@@ -35,6 +35,7 @@ namespace SaveState
 	static const char *SCREENSHOT_EXTENSION = "jpg";
 	static const char *UNDO_STATE_EXTENSION = "undo.ppst";
 	static const char *UNDO_SCREENSHOT_EXTENSION = "undo.jpg";
+	static const char *BOOT_STATE_EXTENSION = "boot.ppst";
 
 	void Init();
 	void Shutdown();
@@ -49,6 +50,12 @@ namespace SaveState
 	bool HasUndoSaveInSlot(const std::string &gameFilename, int slot);
 	bool HasScreenshotInSlot(const std::string &gameFilename, int slot);
 
+	// Boot snapshot - a state captured automatically shortly after boot, used for
+	// instant resume on the next launch. Kept separate from the regular slots.
+	bool HasBootSnapshot(const std::string &gameFilename);
+	void SaveBootSnapshot(const std::string &gameFilename, Callback callback = Callback(), void *cbUserData = 0);
+	void LoadBootSnapshot(const std::string &gameFilename, Callback callback = Callback(), void *cbUserData = 0);
+
 	int GetCurrentSlot();
 
 	// Returns -1 if there's no oldest/newest slot.
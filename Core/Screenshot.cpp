@@ -18,6 +18,10 @@
 #include "ppsspp_config.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 #ifdef USING_QT_UI
 #include <QtGui/QImage>
 #else
@@ -25,6 +29,7 @@
 #include "ext/jpge/jpge.h"
 #endif
 
+#include "thread/threadutil.h"
 #include "Common/ColorConv.h"
 #include "Common/FileUtil.h"
 #include "Core/Config.h"
@@ -307,7 +312,87 @@ const u8 *ConvertBufferToScreenshot(const GPUDebugBuffer &buf, bool alpha, u8 *&
 	return temp ? temp : buffer;
 }
 
-bool TakeGameScreenshot(const char *filename, ScreenshotFormat fmt, ScreenshotType type, int *width, int *height, int maxRes) {
+// Deferred encoding. The framebuffer readback and pixel conversion have to
+// happen on the calling thread (they need the GPU), but the PNG/JPEG
+// compression and file write don't - those are what actually drop frames when
+// taking a screenshot mid-game, so they run on a lazily started worker.
+struct PendingScreenshot {
+	std::string filename;
+	ScreenshotFormat fmt;
+	std::vector<u8> rgb888;
+	int w;
+	int h;
+};
+
+static std::mutex g_screenshotLock;
+static std::condition_variable g_screenshotCond;
+static std::vector<PendingScreenshot> g_screenshotQueue;
+static std::thread g_screenshotThread;
+static bool g_screenshotThreadRunning = false;
+static bool g_screenshotThreadStop = false;
+
+// More than this queued means the encoder can't keep up - refuse instead of
+// buffering screenshots without bound.
+enum { MAX_PENDING_SCREENSHOTS = 4 };
+
+static void ScreenshotThreadFunc() {
+	setCurrentThreadName("Screenshot");
+
+	std::unique_lock<std::mutex> lock(g_screenshotLock);
+	while (!g_screenshotThreadStop || !g_screenshotQueue.empty()) {
+		if (g_screenshotQueue.empty()) {
+			g_screenshotCond.wait(lock);
+			continue;
+		}
+		PendingScreenshot shot = std::move(g_screenshotQueue.front());
+		g_screenshotQueue.erase(g_screenshotQueue.begin());
+		lock.unlock();
+		if (!Save888RGBScreenshot(shot.filename.c_str(), shot.fmt, shot.rgb888.data(), shot.w, shot.h)) {
+			ERROR_LOG(SYSTEM, "Failed to write screenshot: %s", shot.filename.c_str());
+		}
+		lock.lock();
+	}
+}
+
+// Joins the worker at process exit so queued shots still hit the disk.
+struct ScreenshotThreadJanitor {
+	~ScreenshotThreadJanitor() {
+		{
+			std::lock_guard<std::mutex> lock(g_screenshotLock);
+			if (!g_screenshotThreadRunning)
+				return;
+			g_screenshotThreadStop = true;
+		}
+		g_screenshotCond.notify_one();
+		g_screenshotThread.join();
+	}
+};
+static ScreenshotThreadJanitor g_screenshotThreadJanitor;
+
+static bool QueueScreenshot(const char *filename, ScreenshotFormat fmt, const u8 *bufferRGB888, int w, int h) {
+	std::lock_guard<std::mutex> lock(g_screenshotLock);
+	if (g_screenshotThreadStop)
+		return false;
+	if (g_screenshotQueue.size() >= MAX_PENDING_SCREENSHOTS) {
+		WARN_LOG(SYSTEM, "Screenshot encode queue full, not saving %s", filename);
+		return false;
+	}
+	if (!g_screenshotThreadRunning) {
+		g_screenshotThread = std::thread(&ScreenshotThreadFunc);
+		g_screenshotThreadRunning = true;
+	}
+	PendingScreenshot shot;
+	shot.filename = filename;
+	shot.fmt = fmt;
+	shot.rgb888.assign(bufferRGB888, bufferRGB888 + w * h * 3);
+	shot.w = w;
+	shot.h = h;
+	g_screenshotQueue.push_back(std::move(shot));
+	g_screenshotCond.notify_one();
+	return true;
+}
+
+bool TakeGameScreenshot(const char *filename, ScreenshotFormat fmt, ScreenshotType type, int *width, int *height, int maxRes, bool async) {
 	if (!gpuDebug) {
 		ERROR_LOG(SYSTEM, "Can't take screenshots when GPU not running");
 		return false;
@@ -342,7 +427,12 @@ bool TakeGameScreenshot(const char *filename, ScreenshotFormat fmt, ScreenshotTy
 			if (height)
 				*height = h;
 
-			success = Save888RGBScreenshot(filename, fmt, buffer, w, h);
+			if (async) {
+				// Success here means queued; the file appears shortly after.
+				success = QueueScreenshot(filename, fmt, buffer, w, h);
+			} else {
+				success = Save888RGBScreenshot(filename, fmt, buffer, w, h);
+			}
 		}
 	}
 	delete [] flipbuffer;
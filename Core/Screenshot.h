@@ -35,7 +35,10 @@ enum ScreenshotType {
 
 const u8 *ConvertBufferToScreenshot(const GPUDebugBuffer &buf, bool alpha, u8 *&temp, u32 &w, u32 &h);
 
-// Can only be used while in game.
-bool TakeGameScreenshot(const char *filename, ScreenshotFormat fmt, ScreenshotType type, int *width = nullptr, int *height = nullptr, int maxRes = -1);
+// Can only be used while in game. With async set, the readback still happens
+// now but the PNG/JPEG encode and file write are handed to a worker thread;
+// success then means the screenshot was queued, and width/height are still
+// returned immediately.
+bool TakeGameScreenshot(const char *filename, ScreenshotFormat fmt, ScreenshotType type, int *width = nullptr, int *height = nullptr, int maxRes = -1, bool async = false);
 bool Save888RGBScreenshot(const char *filename, ScreenshotFormat fmt, const u8 *bufferRGB888, int w, int h);
 bool Save8888RGBAScreenshot(const char *filename, const u8 *bufferRGBA8888, int w, int h);
@@ -40,6 +40,8 @@
 
 #include "Core/MIPS/MIPS.h"
 #include "Core/MIPS/MIPSAnalyst.h"
+#include "Core/MIPS/MIPSVFPUUtils.h"
+#include "Core/MIPS/JitCommon/JitDiskCache.h"
 
 #include "Debugger/SymbolMap.h"
 #include "Core/Host.h"
@@ -228,6 +230,10 @@ void CPU_Init() {
 	std::string discID = g_paramSFO.GetDiscID();
 	coreParameter.compat.Load(discID);
 
+	g_vfpuFastTranscendentals = !coreParameter.compat.flags().AccurateVFPUTranscendentals;
+
+	MIPSAnalyst::OpenFunctionScanCache(discID);
+
 	Memory::Init();
 	mipsr4k.Reset();
 
@@ -275,6 +281,7 @@ void CPU_Shutdown() {
 	}
 
 	Replacement_Shutdown();
+	MIPSAnalyst::CloseFunctionScanCache();
 
 	CoreTiming::Shutdown();
 	__KernelShutdown();
@@ -310,12 +317,14 @@ void Core_UpdateState(CoreState newState) {
 }
 
 void Core_UpdateDebugStats(bool collectStats) {
+	collectStats = collectStats || coreCollectDebugStatsForced;
 	if (coreCollectDebugStats != collectStats) {
 		coreCollectDebugStats = collectStats;
 		mipsr4k.ClearJitCache();
 	}
 
 	kernelStats.ResetFrame();
+	gpuStatsLastFrame = gpuStats;
 	gpuStats.ResetFrame();
 }
 
@@ -426,6 +435,10 @@ void PSP_Shutdown() {
 	}
 #endif
 
+	if (g_Config.bPreloadFunctions) {
+		MIPSComp::SaveBlockListCache();
+	}
+
 	if (pspIsIniting)
 		Core_NotifyLifecycle(CoreLifecycle::START_COMPLETE);
 	Core_NotifyLifecycle(CoreLifecycle::STOPPING);
@@ -110,6 +110,9 @@ enum CoreState {
 };
 
 extern bool coreCollectDebugStats;
+// Set when an external consumer (like the web server's stats endpoint) wants stats
+// collected even though no on-screen overlay is up.
+extern bool coreCollectDebugStatsForced;
 
 extern volatile CoreState coreState;
 extern volatile bool coreStatePending;
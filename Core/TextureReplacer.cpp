@@ -22,9 +22,13 @@
 #endif
 
 #include <algorithm>
+#include "base/timeutil.h"
 #include "i18n/i18n.h"
 #include "ext/xxhash.h"
 #include "file/ini_file.h"
+#include "image/zim_load.h"
+#include "image/zim_save.h"
+#include "thread/prioritizedworkqueue.h"
 #include "Common/ColorConv.h"
 #include "Common/FileUtil.h"
 #include "Core/Config.h"
@@ -36,14 +40,25 @@
 
 static const std::string INI_FILENAME = "textures.ini";
 static const std::string NEW_TEXTURE_DIR = "new/";
+static const std::string CACHE_DIR = "cache/";
 static const int VERSION = 1;
 static const int MAX_MIP_LEVELS = 12;  // 12 should be plenty, 8 is the max mip levels supported by the PSP.
 
+// Bound on decoded replacement data kept resident. Past this, the least recently
+// used textures are purged and decoded again on demand.
+static const size_t MAX_DECODED_POOL_BYTES = 64 * 1024 * 1024;
+
 TextureReplacer::TextureReplacer() {
 	none_.alphaStatus_ = ReplacedTextureAlpha::UNKNOWN;
 }
 
 TextureReplacer::~TextureReplacer() {
+	if (loadQueue_) {
+		loadQueue_->Stop();
+		loadThread_.join();
+		loadQueue_->Flush();
+		delete loadQueue_;
+	}
 }
 
 void TextureReplacer::Init() {
@@ -69,6 +84,25 @@ void TextureReplacer::NotifyConfigChanged() {
 	if (enabled_) {
 		enabled_ = LoadIni();
 	}
+
+	if (enabled_ && !loadQueue_) {
+		// Can't use ProcessWorkQueueOnThreadWhile() here - it tracks a single global
+		// thread, which the game info cache already owns. Run our own worker.
+		loadQueue_ = new PrioritizedWorkQueue();
+		loadThread_ = std::thread([this]() {
+			setCurrentThreadName("TexReplace");
+			while (true) {
+				PrioritizedWorkQueueItem *item = loadQueue_->Pop();
+				if (!item) {
+					if (loadQueue_->Done())
+						break;
+				} else {
+					item->run();
+					delete item;
+				}
+			}
+		});
+	}
 }
 
 bool TextureReplacer::LoadIni() {
@@ -99,6 +133,7 @@ bool TextureReplacer::LoadIni() {
 		options->Get("video", &allowVideo_, false);
 		options->Get("ignoreAddress", &ignoreAddress_, false);
 		options->Get("reduceHash", &reduceHash_, false); // Multiplies sizeInRAM/bytesPerLine in XXHASH by 0.5
+		options->Get("cacheDecoded", &cacheDecoded_, false); // Writes decoded PNGs back as zlib ZIMs under cache/, skipping PNG decode on repeat loads.
 		if (reduceHash_ && hash_ == ReplacedTextureHash::QUICK) {
 			reduceHash_ = false;
 			ERROR_LOG(G3D, "Texture Replacement: reduceHash option requires safer hash, use xxh32 or xxh64 instead.");
@@ -259,6 +294,145 @@ u32 TextureReplacer::ComputeHash(u32 addr, int bufw, int w, int h, GETextureForm
 	}
 }
 
+// Decodes one replacement level into out as RGBA8888, checking for alpha while at it.
+static bool DecodeReplacementFile(const ReplacedTextureLevel &info, void *out, int rowPitch, CheckAlphaResult *alphaResult) {
+#ifdef USING_QT_UI
+	QImage image(info.file.c_str(), "PNG");
+	if (image.isNull()) {
+		ERROR_LOG(G3D, "Could not load texture replacement info: %s", info.file.c_str());
+		return false;
+	}
+
+	image = image.convertToFormat(QImage::Format_ARGB32);
+	bool alphaFull = true;
+	for (int y = 0; y < image.height(); ++y) {
+		const QRgb *src = (const QRgb *)image.constScanLine(y);
+		uint8_t *outLine = (uint8_t *)out + y * rowPitch;
+		for (int x = 0; x < image.width(); ++x) {
+			outLine[x * 4 + 0] = qRed(src[x]);
+			outLine[x * 4 + 1] = qGreen(src[x]);
+			outLine[x * 4 + 2] = qBlue(src[x]);
+			outLine[x * 4 + 3] = qAlpha(src[x]);
+			// We're already scanning each pixel...
+			if (qAlpha(src[x]) != 255) {
+				alphaFull = false;
+			}
+		}
+	}
+
+	*alphaResult = alphaFull ? CHECKALPHA_FULL : CHECKALPHA_ANY;
+	return true;
+#else
+	png_image png = {};
+	png.version = PNG_IMAGE_VERSION;
+
+	FILE *fp = File::OpenCFile(info.file, "rb");
+	if (!png_image_begin_read_from_stdio(&png, fp)) {
+		ERROR_LOG(G3D, "Could not load texture replacement info: %s - %s", info.file.c_str(), png.message);
+		fclose(fp);
+		return false;
+	}
+
+	bool checkedAlpha = false;
+	if ((png.format & PNG_FORMAT_FLAG_ALPHA) == 0) {
+		// Well, we know for sure it doesn't have alpha.
+		*alphaResult = CHECKALPHA_FULL;
+		checkedAlpha = true;
+	}
+	png.format = PNG_FORMAT_RGBA;
+
+	if (!png_image_finish_read(&png, nullptr, out, rowPitch, nullptr)) {
+		ERROR_LOG(G3D, "Could not load texture replacement: %s - %s", info.file.c_str(), png.message);
+		fclose(fp);
+		png_image_free(&png);
+		return false;
+	}
+
+	if (!checkedAlpha) {
+		// This will only check the hashed bits.
+		*alphaResult = CheckAlphaRGBA8888Basic((u32 *)out, rowPitch / sizeof(u32), png.width, png.height);
+	}
+
+	fclose(fp);
+	png_image_free(&png);
+	return true;
+#endif
+}
+
+static bool LoadFromZIMCache(const ReplacedTextureLevel &info, void *out, int rowPitch) {
+	if (info.zimFile.empty() || !File::Exists(info.zimFile))
+		return false;
+
+	// A stale cache is worse than no cache - drop it if the source PNG is newer.
+	File::FileDetails zimDetails, pngDetails;
+	if (!File::GetFileDetails(info.zimFile, &zimDetails) || !File::GetFileDetails(info.file, &pngDetails) || pngDetails.mtime > zimDetails.mtime) {
+		File::Delete(info.zimFile);
+		return false;
+	}
+
+	int w[ZIM_MAX_MIP_LEVELS]{};
+	int h[ZIM_MAX_MIP_LEVELS]{};
+	int flags = 0;
+	uint8_t *image[ZIM_MAX_MIP_LEVELS]{};
+	int levels = LoadZIM(info.zimFile.c_str(), w, h, &flags, image);
+	if (levels == 0)
+		return false;
+
+	// We only ever write single-level RGBA8888 at the padded level size.
+	if (levels != 1 || w[0] != info.w || h[0] != info.h || (flags & ZIM_FORMAT_MASK) != ZIM_RGBA8888) {
+		free(image[0]);
+		File::Delete(info.zimFile);
+		return false;
+	}
+
+	for (int y = 0; y < h[0]; ++y) {
+		memcpy((u8 *)out + y * rowPitch, image[0] + y * w[0] * 4, w[0] * 4);
+	}
+	free(image[0]);
+	return true;
+}
+
+static void SaveToZIMCache(const ReplacedTextureLevel &info, const void *data, int rowPitch) {
+	if (info.zimFile.empty())
+		return;
+
+#ifdef _WIN32
+	size_t slash = info.zimFile.find_last_of("/\\");
+#else
+	size_t slash = info.zimFile.find_last_of("/");
+#endif
+	if (slash != info.zimFile.npos) {
+		// Create any directory structure as needed.
+		const std::string cacheDirectory = info.zimFile.substr(0, slash);
+		if (!File::Exists(cacheDirectory)) {
+			File::CreateFullPath(cacheDirectory);
+			File::CreateEmptyFile(cacheDirectory + "/.nomedia");
+		}
+	}
+
+	SaveZIM(info.zimFile.c_str(), info.w, info.h, rowPitch, ZIM_RGBA8888 | ZIM_ZLIB_COMPRESSED, (const uint8_t *)data);
+}
+
+class ReplacedTextureLoadItem : public PrioritizedWorkQueueItem {
+public:
+	ReplacedTextureLoadItem(TextureReplacer *replacer, ReplacedTexture *tex, float priority)
+		: replacer_(replacer), tex_(tex), priority_(priority) {
+	}
+
+	void run() override {
+		replacer_->DecodeReplacement(tex_);
+	}
+
+	float priority() override {
+		return priority_;
+	}
+
+private:
+	TextureReplacer *replacer_;
+	ReplacedTexture *tex_;
+	float priority_;
+};
+
 ReplacedTexture &TextureReplacer::FindReplacement(u64 cachekey, u32 hash, int w, int h) {
 	// Only actually replace if we're replacing.  We might just be saving.
 	if (!Enabled() || !g_Config.bReplaceTextures) {
@@ -268,16 +442,102 @@ ReplacedTexture &TextureReplacer::FindReplacement(u64 cachekey, u32 hash, int w,
 	ReplacementCacheKey replacementKey(cachekey, hash);
 	auto it = cache_.find(replacementKey);
 	if (it != cache_.end()) {
-		return it->second;
+		ReplacedTexture &result = it->second;
+		result.lastUsed_ = time_now_d();
+		if (!result.levels_.empty() && result.state_ == ReplacedTextureState::UNLOADED) {
+			// Was purged from the pool, decode it again.
+			QueueDecode(&result);
+		}
+		return result;
 	}
 
 	// Okay, let's construct the result.
 	ReplacedTexture &result = cache_[replacementKey];
 	result.alphaStatus_ = ReplacedTextureAlpha::UNKNOWN;
+	result.lastUsed_ = time_now_d();
 	PopulateReplacement(&result, cachekey, hash, w, h);
+	if (!result.levels_.empty()) {
+		DecimatePool();
+		QueueDecode(&result);
+	}
 	return result;
 }
 
+void TextureReplacer::QueueDecode(ReplacedTexture *tex) {
+	// Small textures decode quickly and unblock the most draws per unit of worker
+	// time, so give them a head start. Low priority value = high priority.
+	const float priority = (float)(tex->levels_[0].w * tex->levels_[0].h);
+	tex->state_ = ReplacedTextureState::PENDING;
+	loadQueue_->Add(new ReplacedTextureLoadItem(this, tex, priority));
+}
+
+void TextureReplacer::DecodeReplacement(ReplacedTexture *tex) {
+	// Runs on the background loader. Decode the smallest mips first - they're the
+	// cheapest, and the most likely to matter for distant geometry right away.
+	std::vector<std::vector<u8>> data;
+	data.resize(tex->levels_.size());
+	ReplacedTextureAlpha alpha = ReplacedTextureAlpha::FULL;
+	for (int i = (int)tex->levels_.size() - 1; i >= 0; --i) {
+		const ReplacedTextureLevel &info = tex->levels_[i];
+		const int rowPitch = info.w * 4;
+		// The zero init doubles as padding for hashrange'd files smaller than the level.
+		data[i].resize(rowPitch * info.h);
+
+		CheckAlphaResult res;
+		if (LoadFromZIMCache(info, data[i].data(), rowPitch)) {
+			// This will only check the hashed bits.
+			res = CheckAlphaRGBA8888Basic((u32 *)data[i].data(), info.w, info.w, info.h);
+		} else if (DecodeReplacementFile(info, data[i].data(), rowPitch, &res)) {
+			SaveToZIMCache(info, data[i].data(), rowPitch);
+		} else {
+			// Already logged. Leave the level black, Load() will retry synchronously.
+			data[i].clear();
+			continue;
+		}
+		if (res == CHECKALPHA_ANY) {
+			alpha = ReplacedTextureAlpha::UNKNOWN;
+		}
+	}
+
+	size_t totalBytes = 0;
+	for (const auto &level : data) {
+		totalBytes += level.size();
+	}
+
+	std::lock_guard<std::mutex> guard(poolMutex_);
+	tex->levelData_ = std::move(data);
+	tex->alphaStatus_ = alpha;
+	tex->decodedBytes_ = totalBytes;
+	decodedPoolBytes_ += totalBytes;
+	// Publish last - Valid() flips true once this is visible.
+	tex->state_ = ReplacedTextureState::ACTIVE;
+}
+
+void TextureReplacer::DecimatePool() {
+	std::lock_guard<std::mutex> guard(poolMutex_);
+	if (decodedPoolBytes_ <= MAX_DECODED_POOL_BYTES)
+		return;
+
+	std::vector<ReplacedTexture *> active;
+	for (auto &item : cache_) {
+		if (item.second.state_ == ReplacedTextureState::ACTIVE)
+			active.push_back(&item.second);
+	}
+	std::sort(active.begin(), active.end(), [](const ReplacedTexture *a, const ReplacedTexture *b) {
+		return a->lastUsed_ < b->lastUsed_;
+	});
+
+	for (ReplacedTexture *tex : active) {
+		if (decodedPoolBytes_ <= MAX_DECODED_POOL_BYTES)
+			break;
+		decodedPoolBytes_ -= tex->decodedBytes_;
+		tex->decodedBytes_ = 0;
+		tex->levelData_.clear();
+		// Will be decoded again if the texture cache ever rebuilds from it.
+		tex->state_ = ReplacedTextureState::UNLOADED;
+	}
+}
+
 void TextureReplacer::PopulateReplacement(ReplacedTexture *result, u64 cachekey, u32 hash, int w, int h) {
 	int newW = w;
 	int newH = h;
@@ -299,6 +559,9 @@ void TextureReplacer::PopulateReplacement(ReplacedTexture *result, u64 cachekey,
 		ReplacedTextureLevel level;
 		level.fmt = ReplacedTextureFormat::F_8888;
 		level.file = filename;
+		if (cacheDecoded_) {
+			level.zimFile = basePath_ + CACHE_DIR + hashfile + ".zim";
+		}
 
 #ifdef USING_QT_UI
 		QImage image(filename.c_str(), "PNG");
@@ -567,69 +830,22 @@ void ReplacedTexture::Load(int level, void *out, int rowPitch) {
 
 	const ReplacedTextureLevel &info = levels_[level];
 
-#ifdef USING_QT_UI
-	QImage image(info.file.c_str(), "PNG");
-	if (image.isNull()) {
-		ERROR_LOG(G3D, "Could not load texture replacement info: %s", info.file.c_str());
-		return;
-	}
-
-	image = image.convertToFormat(QImage::Format_ARGB32);
-	bool alphaFull = true;
-	for (int y = 0; y < image.height(); ++y) {
-		const QRgb *src = (const QRgb *)image.constScanLine(y);
-		uint8_t *outLine = (uint8_t *)out + y * rowPitch;
-		for (int x = 0; x < image.width(); ++x) {
-			outLine[x * 4 + 0] = qRed(src[x]);
-			outLine[x * 4 + 1] = qGreen(src[x]);
-			outLine[x * 4 + 2] = qBlue(src[x]);
-			outLine[x * 4 + 3] = qAlpha(src[x]);
-			// We're already scanning each pixel...
-			if (qAlpha(src[x]) != 255) {
-				alphaFull = false;
-			}
+	if ((size_t)level < levelData_.size() && !levelData_[level].empty()) {
+		// Already decoded by the background loader - just copy the rows out.
+		const u8 *src = levelData_[level].data();
+		for (int y = 0; y < info.h; ++y) {
+			memcpy((u8 *)out + y * rowPitch, src + y * info.w * 4, info.w * 4);
 		}
-	}
-
-	if (level == 0 || !alphaFull) {
-		alphaStatus_ = alphaFull ? ReplacedTextureAlpha::FULL : ReplacedTextureAlpha::UNKNOWN;
-	}
-#else
-	png_image png = {};
-	png.version = PNG_IMAGE_VERSION;
-
-	FILE *fp = File::OpenCFile(info.file, "rb");
-	if (!png_image_begin_read_from_stdio(&png, fp)) {
-		ERROR_LOG(G3D, "Could not load texture replacement info: %s - %s", info.file.c_str(), png.message);
 		return;
 	}
 
-	bool checkedAlpha = false;
-	if ((png.format & PNG_FORMAT_FLAG_ALPHA) == 0) {
-		// Well, we know for sure it doesn't have alpha.
-		if (level == 0) {
-			alphaStatus_ = ReplacedTextureAlpha::FULL;
-		}
-		checkedAlpha = true;
-	}
-	png.format = PNG_FORMAT_RGBA;
-
-	if (!png_image_finish_read(&png, nullptr, out, rowPitch, nullptr)) {
-		ERROR_LOG(G3D, "Could not load texture replacement: %s - %s", info.file.c_str(), png.message);
-		return;
-	}
-
-	if (!checkedAlpha) {
-		// This will only check the hashed bits.
-		CheckAlphaResult res = CheckAlphaRGBA8888Basic((u32 *)out, rowPitch / sizeof(u32), png.width, png.height);
+	// Purged from the pool (or the decode failed) - decode synchronously as a last resort.
+	CheckAlphaResult res;
+	if (DecodeReplacementFile(info, out, rowPitch, &res)) {
 		if (res == CHECKALPHA_ANY || level == 0) {
 			alphaStatus_ = ReplacedTextureAlpha(res);
 		}
 	}
-
-	fclose(fp);
-	png_image_free(&png);
-#endif
 }
 
 bool TextureReplacer::GenerateIni(const std::string &gameID, std::string *generatedFilename) {
@@ -17,8 +17,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include "Common/Common.h"
@@ -27,6 +30,7 @@
 
 class TextureCacheCommon;
 class TextureReplacer;
+class PrioritizedWorkQueue;
 
 enum class ReplacedTextureFormat {
 	F_5650,
@@ -58,6 +62,8 @@ struct ReplacedTextureLevel {
 	int h;
 	ReplacedTextureFormat fmt;
 	std::string file;
+	// Precompiled decode cache next to the PNG, empty if disabled.
+	std::string zimFile;
 };
 
 struct ReplacementCacheKey {
@@ -120,12 +126,27 @@ namespace std {
 	};
 }
 
+// Whether the decoded pixel data is resident. Levels are scanned up front on the GPU
+// thread, the actual decode happens on the background loader.
+enum class ReplacedTextureState {
+	UNLOADED,  // Levels known, pixel data not decoded (or purged from the pool.)
+	PENDING,   // Queued for decode on the background loader.
+	ACTIVE,    // Decoded pixel data resident.
+};
+
 struct ReplacedTexture {
 	inline bool Valid() {
-		return !levels_.empty();
+		return !levels_.empty() && state_ == ReplacedTextureState::ACTIVE;
+	}
+
+	// True if a replacement exists but the background decode hasn't finished yet.
+	inline bool IsPending() {
+		return !levels_.empty() && state_ != ReplacedTextureState::ACTIVE;
 	}
 
 	bool GetSize(int level, int &w, int &h) {
+		if (state_ != ReplacedTextureState::ACTIVE)
+			return false;
 		if ((size_t)level < levels_.size()) {
 			w = levels_[level].w;
 			h = levels_[level].h;
@@ -153,7 +174,12 @@ struct ReplacedTexture {
 
 protected:
 	std::vector<ReplacedTextureLevel> levels_;
+	// Decoded RGBA8888 data per level, pitch levels_[i].w * 4. Filled by the loader.
+	std::vector<std::vector<u8>> levelData_;
 	ReplacedTextureAlpha alphaStatus_;
+	std::atomic<ReplacedTextureState> state_{ ReplacedTextureState::UNLOADED };
+	double lastUsed_ = 0.0;
+	size_t decodedBytes_ = 0;
 
 	friend TextureReplacer;
 };
@@ -195,12 +221,16 @@ protected:
 	std::string LookupHashFile(u64 cachekey, u32 hash, int level);
 	std::string HashName(u64 cachekey, u32 hash, int level);
 	void PopulateReplacement(ReplacedTexture *result, u64 cachekey, u32 hash, int w, int h);
+	void QueueDecode(ReplacedTexture *tex);
+	void DecodeReplacement(ReplacedTexture *tex);
+	void DecimatePool();
 
 	SimpleBuf<u32> saveBuf;
 	bool enabled_ = false;
 	bool allowVideo_ = false;
 	bool ignoreAddress_ = false;
 	bool reduceHash_ = false;
+	bool cacheDecoded_ = false;
 	std::string gameID_;
 	std::string basePath_;
 	ReplacedTextureHash hash_ = ReplacedTextureHash::QUICK;
@@ -211,4 +241,13 @@ protected:
 	ReplacedTexture none_;
 	std::unordered_map<ReplacementCacheKey, ReplacedTexture> cache_;
 	std::unordered_map<ReplacementCacheKey, ReplacedTextureLevel> savedCache_;
+
+	// Background PNG decoding, so FindReplacement() doesn't hitch the GPU thread.
+	PrioritizedWorkQueue *loadQueue_ = nullptr;
+	std::thread loadThread_;
+	// Guards decodedPoolBytes_ and the transition of entries in and out of ACTIVE.
+	std::mutex poolMutex_;
+	size_t decodedPoolBytes_ = 0;
+
+	friend class ReplacedTextureLoadItem;
 };
@@ -80,7 +80,7 @@ void AdjustVolumeBlockStandard(s16 *out, s16 *in, size_t size, int leftVol, int
 	}
 }
 
-void ConvertS16ToF32(float *out, const s16 *in, size_t size) {
+void ConvertS16ToF32Standard(float *out, const s16 *in, size_t size) {
 #ifdef _M_SSE
 	const __m128i zero = _mm_setzero_si128();
 	const __m128 scale = _mm_set_ps1(1.0f / 32767.0f);
@@ -110,14 +110,77 @@ void ConvertS16ToF32(float *out, const s16 *in, size_t size) {
 	}
 }
 
+void ConvertS16ToS32Standard(s32 *out, const s16 *in, size_t size) {
+#ifdef _M_SSE
+	const __m128i zero = _mm_setzero_si128();
+	while (size >= 8) {
+		__m128i indata = _mm_loadu_si128((const __m128i *)in);
+		// Sign extend by unpacking with 0xFFFF where zero is greater.
+		__m128i insign = _mm_cmpgt_epi16(zero, indata);
+		_mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi16(indata, insign));
+		_mm_storeu_si128((__m128i *)(out + 4), _mm_unpackhi_epi16(indata, insign));
+		in += 8;
+		out += 8;
+		size -= 8;
+	}
+#endif
+	for (size_t i = 0; i < size; i++) {
+		out[i] = in[i];
+	}
+}
+
+void AccumulateS16ToS32Standard(s32 *out, const s16 *in, size_t size) {
+#ifdef _M_SSE
+	const __m128i zero = _mm_setzero_si128();
+	while (size >= 8) {
+		__m128i indata = _mm_loadu_si128((const __m128i *)in);
+		__m128i insign = _mm_cmpgt_epi16(zero, indata);
+		__m128i lo = _mm_unpacklo_epi16(indata, insign);
+		__m128i hi = _mm_unpackhi_epi16(indata, insign);
+		_mm_storeu_si128((__m128i *)out, _mm_add_epi32(_mm_loadu_si128((const __m128i *)out), lo));
+		_mm_storeu_si128((__m128i *)(out + 4), _mm_add_epi32(_mm_loadu_si128((const __m128i *)(out + 4)), hi));
+		in += 8;
+		out += 8;
+		size -= 8;
+	}
+#endif
+	for (size_t i = 0; i < size; i++) {
+		out[i] += in[i];
+	}
+}
+
+void ClampS32ToS16Standard(s16 *out, const s32 *in, size_t size) {
+#ifdef _M_SSE
+	while (size >= 8) {
+		__m128i in1 = _mm_loadu_si128((const __m128i *)in);
+		__m128i in2 = _mm_loadu_si128((const __m128i *)(in + 4));
+		_mm_storeu_si128((__m128i *)out, _mm_packs_epi32(in1, in2));
+		in += 8;
+		out += 8;
+		size -= 8;
+	}
+#endif
+	for (size_t i = 0; i < size; i++) {
+		out[i] = clamp_s16(in[i]);
+	}
+}
+
 #if !defined(_M_SSE) && !PPSSPP_ARCH(ARM64)
 AdjustVolumeBlockFunc AdjustVolumeBlock = &AdjustVolumeBlockStandard;
+ConvertS16ToF32Func ConvertS16ToF32 = &ConvertS16ToF32Standard;
+ConvertS16ToS32Func ConvertS16ToS32 = &ConvertS16ToS32Standard;
+AccumulateS16ToS32Func AccumulateS16ToS32 = &AccumulateS16ToS32Standard;
+ClampS32ToS16Func ClampS32ToS16 = &ClampS32ToS16Standard;
 
 // This has to be done after CPUDetect has done its magic.
 void SetupAudioFormats() {
 #if PPSSPP_ARCH(ARM_NEON) && !PPSSPP_ARCH(ARM64)
 	if (cpu_info.bNEON) {
 		AdjustVolumeBlock = &AdjustVolumeBlockNEON;
+		ConvertS16ToF32 = &ConvertS16ToF32NEON;
+		ConvertS16ToS32 = &ConvertS16ToS32NEON;
+		AccumulateS16ToS32 = &AccumulateS16ToS32NEON;
+		ClampS32ToS16 = &ClampS32ToS16NEON;
 	}
 #endif
 }
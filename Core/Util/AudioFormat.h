@@ -68,13 +68,35 @@ static inline s16 ApplySampleVolume20Bit(s16 sample, int vol20) {
 
 void SetupAudioFormats();
 void AdjustVolumeBlockStandard(s16 *out, s16 *in, size_t size, int leftVol, int rightVol);
-void ConvertS16ToF32(float *ou, const s16 *in, size_t size);
+void ConvertS16ToF32Standard(float *out, const s16 *in, size_t size);
+// Widens 16-bit samples into the 32-bit mix buffer.
+void ConvertS16ToS32Standard(s32 *out, const s16 *in, size_t size);
+// Adds 16-bit samples onto the 32-bit mix buffer.
+void AccumulateS16ToS32Standard(s32 *out, const s16 *in, size_t size);
+// Saturating narrow of the 32-bit mix buffer back to 16-bit.
+void ClampS32ToS16Standard(s16 *out, const s32 *in, size_t size);
 
 #ifdef _M_SSE
 #define AdjustVolumeBlock AdjustVolumeBlockStandard
+#define ConvertS16ToF32 ConvertS16ToF32Standard
+#define ConvertS16ToS32 ConvertS16ToS32Standard
+#define AccumulateS16ToS32 AccumulateS16ToS32Standard
+#define ClampS32ToS16 ClampS32ToS16Standard
 #elif PPSSPP_ARCH(ARM64)
 #define AdjustVolumeBlock AdjustVolumeBlockNEON
+#define ConvertS16ToF32 ConvertS16ToF32NEON
+#define ConvertS16ToS32 ConvertS16ToS32NEON
+#define AccumulateS16ToS32 AccumulateS16ToS32NEON
+#define ClampS32ToS16 ClampS32ToS16NEON
 #else
 typedef void (*AdjustVolumeBlockFunc)(s16 *out, s16 *in, size_t size, int leftVol, int rightVol);
 extern AdjustVolumeBlockFunc AdjustVolumeBlock;
+typedef void (*ConvertS16ToF32Func)(float *out, const s16 *in, size_t size);
+extern ConvertS16ToF32Func ConvertS16ToF32;
+typedef void (*ConvertS16ToS32Func)(s32 *out, const s16 *in, size_t size);
+extern ConvertS16ToS32Func ConvertS16ToS32;
+typedef void (*AccumulateS16ToS32Func)(s32 *out, const s16 *in, size_t size);
+extern AccumulateS16ToS32Func AccumulateS16ToS32;
+typedef void (*ClampS32ToS16Func)(s16 *out, const s32 *in, size_t size);
+extern ClampS32ToS16Func ClampS32ToS16;
 #endif
@@ -71,4 +71,64 @@ void AdjustVolumeBlockNEON(s16 *out, s16 *in, size_t size, int leftVol, int righ
 	}
 }
 
+void ConvertS16ToF32NEON(float *out, const s16 *in, size_t size) {
+	while (size >= 8) {
+		int16x8_t indata = vld1q_s16(in);
+		int32x4_t lo = vmovl_s16(vget_low_s16(indata));
+		int32x4_t hi = vmovl_s16(vget_high_s16(indata));
+		vst1q_f32(out, vmulq_n_f32(vcvtq_f32_s32(lo), 1.0f / 32767.0f));
+		vst1q_f32(out + 4, vmulq_n_f32(vcvtq_f32_s32(hi), 1.0f / 32767.0f));
+		in += 8;
+		out += 8;
+		size -= 8;
+	}
+	for (size_t i = 0; i < size; i++) {
+		out[i] = in[i] * (1.0f / 32767.0f);
+	}
+}
+
+void ConvertS16ToS32NEON(s32 *out, const s16 *in, size_t size) {
+	while (size >= 8) {
+		int16x8_t indata = vld1q_s16(in);
+		vst1q_s32(out, vmovl_s16(vget_low_s16(indata)));
+		vst1q_s32(out + 4, vmovl_s16(vget_high_s16(indata)));
+		in += 8;
+		out += 8;
+		size -= 8;
+	}
+	for (size_t i = 0; i < size; i++) {
+		out[i] = in[i];
+	}
+}
+
+void AccumulateS16ToS32NEON(s32 *out, const s16 *in, size_t size) {
+	while (size >= 8) {
+		int16x8_t indata = vld1q_s16(in);
+		int32x4_t acc1 = vaddw_s16(vld1q_s32(out), vget_low_s16(indata));
+		int32x4_t acc2 = vaddw_s16(vld1q_s32(out + 4), vget_high_s16(indata));
+		vst1q_s32(out, acc1);
+		vst1q_s32(out + 4, acc2);
+		in += 8;
+		out += 8;
+		size -= 8;
+	}
+	for (size_t i = 0; i < size; i++) {
+		out[i] += in[i];
+	}
+}
+
+void ClampS32ToS16NEON(s16 *out, const s32 *in, size_t size) {
+	while (size >= 8) {
+		int32x4_t in1 = vld1q_s32(in);
+		int32x4_t in2 = vld1q_s32(in + 4);
+		vst1q_s16(out, vcombine_s16(vqmovn_s32(in1), vqmovn_s32(in2)));
+		in += 8;
+		out += 8;
+		size -= 8;
+	}
+	for (size_t i = 0; i < size; i++) {
+		out[i] = clamp_s16(in[i]);
+	}
+}
+
 #endif // PPSSPP_ARCH(ARM_NEON)
@@ -20,3 +20,7 @@
 #include "Common/CommonTypes.h"
 
 void AdjustVolumeBlockNEON(s16 *out, s16 *in, size_t size, int leftVol, int rightVol);
+void ConvertS16ToF32NEON(float *out, const s16 *in, size_t size);
+void ConvertS16ToS32NEON(s32 *out, const s16 *in, size_t size);
+void AccumulateS16ToS32NEON(s32 *out, const s16 *in, size_t size);
+void ClampS32ToS16NEON(s16 *out, const s32 *in, size_t size);
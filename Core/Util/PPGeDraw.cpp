@@ -73,6 +73,14 @@ static u32 paletteSize = sizeof(u16) * 16;
 static u32 vertexStart;
 static u32 vertexCount;
 
+// Merge state for consecutive draws, so the whole OSD doesn't dissolve into
+// two-vertex rectangle draws. Reset in PPGeBegin, not saved in savestates since
+// it only lives while a list is being built.
+static u32 lastPrimPtr;  // Address of the last GE_CMD_PRIM written, 0 = none.
+static int lastPrimType;
+static u32 lastPrimVertexCount;
+static bool texturingEnabled;
+
 // Used for formating text
 struct AtlasCharVertex
 {
@@ -145,8 +153,32 @@ static void Vertex(float x, float y, float u, float v, int tw, int th, u32 color
 }
 
 static void EndVertexDataAndDraw(int prim) {
+	if (vertexCount == 0)
+		return;
+	// If no commands were written since the last draw, the new vertices continue
+	// right where the previous run ended (the data buffer is written contiguously),
+	// so we can extend the previous PRIM instead of issuing another draw. Dialogs
+	// emit lots of small quads back to back, which mostly collapse into one draw
+	// this way.
+	if (lastPrimPtr == dlWritePtr - 4 && lastPrimType == prim && lastPrimVertexCount + vertexCount <= 0xFFFF) {
+		lastPrimVertexCount += vertexCount;
+		Memory::Write_U32((GE_CMD_PRIM << 24) | (prim << 16) | lastPrimVertexCount, lastPrimPtr);
+		return;
+	}
 	WriteCmdAddrWithBase(GE_CMD_VADDR, vertexStart);
 	WriteCmd(GE_CMD_PRIM, (prim << 16) | vertexCount);
+	lastPrimPtr = dlWritePtr - 4;
+	lastPrimType = prim;
+	lastPrimVertexCount = vertexCount;
+}
+
+// Toggling texturing between every rect and image breaks draw merging and pads
+// the list with redundant state, so filter out the no-op changes.
+static void SetTexturingEnabled(bool enabled) {
+	if (enabled != texturingEnabled) {
+		WriteCmd(GE_CMD_TEXTUREMAPENABLE, enabled ? 1 : 0);
+		texturingEnabled = enabled;
+	}
 }
 
 static u32 __PPGeDoAlloc(u32 &size, bool fromTop, const char *name) {
@@ -290,6 +322,8 @@ void PPGeBegin()
 	// Reset write pointers to start of command and data buffers.
 	dlWritePtr = dlPtr;
 	dataWritePtr = dataPtr;
+	lastPrimPtr = 0;
+	texturingEnabled = false;
 
 	// Set up the correct states for UI drawing
 	WriteCmd(GE_CMD_OFFSETADDR, 0);
@@ -653,6 +687,7 @@ void PPGeDrawCurrentText(u32 color)
 	if (dlPtr)
 	{
 		float scale = char_lines_metrics.scale;
+		SetTexturingEnabled(true);
 		BeginVertexData();
 		for (auto i = char_lines.begin(); i != char_lines.end(); ++i)
 		{
@@ -746,6 +781,7 @@ void PPGeDraw4Patch(int atlasImage, float x, float y, float w, float h, u32 colo
 	float ymid2 = y + h - bordery;
 	float x2 = x + w;
 	float y2 = y + h;
+	SetTexturingEnabled(true);
 	BeginVertexData();
 	// Top row
 	Vertex(x, y, u1, v1, atlasWidth, atlasHeight, color);
@@ -776,14 +812,12 @@ void PPGeDrawRect(float x1, float y1, float x2, float y2, u32 color)
 	if (!dlPtr)
 		return;
 
-	WriteCmd(GE_CMD_TEXTUREMAPENABLE, 0);
+	SetTexturingEnabled(false);
 
 	BeginVertexData();
 	Vertex(x1, y1, 0, 0, 0, 0, color);
 	Vertex(x2, y2, 0, 0, 0, 0, color);
 	EndVertexDataAndDraw(GE_PRIM_RECTANGLES);
-
-	WriteCmd(GE_CMD_TEXTUREMAPENABLE, 1);
 }
 
 // Just blits an image to the screen, multiplied with the color.
@@ -795,6 +829,7 @@ void PPGeDrawImage(int atlasImage, float x, float y, int align, u32 color)
 	const AtlasImage &img = ppge_atlas.images[atlasImage];
 	float w = img.w;
 	float h = img.h;
+	SetTexturingEnabled(true);
 	BeginVertexData();
 	Vertex(x, y, img.u1, img.v1, atlasWidth, atlasHeight, color);
 	Vertex(x + w, y + h, img.u2, img.v2, atlasWidth, atlasHeight, color);
@@ -807,6 +842,7 @@ void PPGeDrawImage(int atlasImage, float x, float y, float w, float h, int align
 		return;
 
 	const AtlasImage &img = ppge_atlas.images[atlasImage];
+	SetTexturingEnabled(true);
 	BeginVertexData();
 	Vertex(x, y, img.u1, img.v1, atlasWidth, atlasHeight, color);
 	Vertex(x + w, y + h, img.u2, img.v2, atlasWidth, atlasHeight, color);
@@ -817,6 +853,7 @@ void PPGeDrawImage(float x, float y, float w, float h, float u1, float v1, float
 {
 	if (!dlPtr)
 		return;
+	SetTexturingEnabled(true);
 	BeginVertexData();
 	Vertex(x, y, u1, v1, tw, th, color);
 	Vertex(x + w, y + h, u2, v2, tw, th, color);
@@ -840,6 +877,7 @@ int GetPow2(int x)
 void PPGeSetDefaultTexture()
 {
 	WriteCmd(GE_CMD_TEXTUREMAPENABLE, 1);
+	texturingEnabled = true;
 	int wp2 = GetPow2(atlasWidth);
 	int hp2 = GetPow2(atlasHeight);
 	WriteCmd(GE_CMD_CLUTADDR, palette.ptr & 0xFFFFF0);
@@ -861,6 +899,7 @@ void PPGeSetDefaultTexture()
 void PPGeSetTexture(u32 dataAddr, int width, int height)
 {
 	WriteCmd(GE_CMD_TEXTUREMAPENABLE, 1);
+	texturingEnabled = true;
 	int wp2 = GetPow2(width);
 	int hp2 = GetPow2(height);
 	WriteCmd(GE_CMD_TEXSIZE0, wp2 | (hp2 << 8));
@@ -877,7 +916,7 @@ void PPGeSetTexture(u32 dataAddr, int width, int height)
 
 void PPGeDisableTexture()
 {
-	WriteCmd(GE_CMD_TEXTUREMAPENABLE, 0);
+	SetTexturingEnabled(false);
 }
 
 std::vector<PPGeImage *> PPGeImage::loadedTextures_;
@@ -22,15 +22,19 @@
 #include "base/stringutil.h"
 #include "base/timeutil.h"
 #include "file/fd_util.h"
+#include "json/json_writer.h"
 #include "net/http_client.h"
 #include "net/http_server.h"
 #include "net/sinks.h"
+#include "profiler/profiler.h"
 #include "thread/threadutil.h"
 #include "Common/FileUtil.h"
 #include "Common/Log.h"
 #include "Core/Config.h"
 #include "Core/Debugger/WebSocket.h"
+#include "Core/System.h"
 #include "Core/WebServer.h"
+#include "GPU/GPU.h"
 
 enum class ServerStatus {
 	STOPPED,
@@ -198,6 +202,88 @@ static void RegisterDiscHandlers(http::Server *http, std::unordered_map<std::str
 	}
 }
 
+// Stats collection is normally driven by the on-screen overlay. The stats endpoint keeps a
+// "forced" flag alive for as long as it's being polled, and the server loop expires it.
+// Plain doubles - a torn read here just mistimes the expiry by a slice.
+static double lastStatsRequest = 0.0;
+
+static void HandleGPUStatsRequest(const http::Request &request) {
+	coreCollectDebugStatsForced = true;
+	lastStatsRequest = real_time_now();
+
+	// Copy the snapshot - the emu thread overwrites it every frame.
+	GPUStatistics stats = gpuStatsLastFrame;
+
+	json::JsonWriter json;
+	json.begin();
+	// False on the first poll - collection starts with the next frame.
+	json.writeBool("collecting", coreCollectDebugStats);
+	json.writeFloat("msProcessingDisplayLists", stats.msProcessingDisplayLists * 1000.0);
+	json.writeFloat("msVertexDecode", stats.msVertexDecode * 1000.0);
+	json.writeFloat("msTextureDecode", stats.msTextureDecode * 1000.0);
+	json.writeFloat("msReadbacks", stats.msReadbacks * 1000.0);
+	json.writeInt("drawCalls", stats.numDrawCalls);
+	json.writeInt("cachedDrawCalls", stats.numCachedDrawCalls);
+	json.writeInt("flushes", stats.numFlushes);
+	json.writeInt("clears", stats.numClears);
+	json.writeInt("vertsSubmitted", stats.numVertsSubmitted);
+	json.writeInt("cachedVertsDrawn", stats.numCachedVertsDrawn);
+	json.writeInt("uncachedVertsDrawn", stats.numUncachedVertsDrawn);
+	json.writeInt("trackedVertexArrays", stats.numTrackedVertexArrays);
+	json.writeInt("textureInvalidations", stats.numTextureInvalidations);
+	json.writeInt("textureSwitches", stats.numTextureSwitches);
+	json.writeInt("texturesDecoded", stats.numTexturesDecoded);
+	json.writeInt("shaderSwitches", stats.numShaderSwitches);
+	json.writeInt("shaderCompiles", stats.numShaderCompiles);
+	json.writeInt("pipelineCompiles", stats.numPipelineCompiles);
+	json.writeInt("readbacks", stats.numReadbacks);
+	json.writeInt("uploads", stats.numUploads);
+	json.writeInt("vertexGPUCycles", stats.vertexGPUCycles);
+	json.writeInt("otherGPUCycles", stats.otherGPUCycles);
+	json.writeInt("flips", stats.numFlips);
+	json.end();
+
+	const std::string body = json.str();
+	request.WriteHttpResponseHeader(200, (s64)body.size(), "application/json");
+	request.Out()->Push(body);
+}
+
+// Dumps the frame profiler's history ring: per category, the slowest thread's
+// time per frame in ms, oldest frame first. Only available in builds with
+// USE_PROFILER defined (see profiler/profiler.h) - the profiler build also
+// disables the jit's quick-syscall paths, so it stays a diagnostic option.
+static void HandleProfilerRequest(const http::Request &request) {
+	json::JsonWriter json;
+	json.begin();
+#ifdef USE_PROFILER
+	const int historyLength = Profiler_GetHistoryLength();
+	const int numCategories = Profiler_GetNumCategories();
+	std::vector<int> slowestThreads(historyLength);
+	std::vector<float> historyData(historyLength);
+	Profiler_GetSlowestThreads(slowestThreads.data(), historyLength);
+
+	json.writeInt("historyLength", historyLength);
+	json.writeInt("threads", Profiler_GetNumThreads());
+	json.pushDict("categories");
+	for (int i = 0; i < numCategories; ++i) {
+		Profiler_GetSlowestHistory(i, slowestThreads.data(), historyData.data(), historyLength);
+		json.pushArray(Profiler_GetCategoryName(i));
+		for (int j = 0; j < historyLength; ++j) {
+			json.writeFloat(historyData[j] * 1000.0);
+		}
+		json.pop();
+	}
+	json.pop();
+#else
+	json.writeString("error", "profiler not compiled in, build with USE_PROFILER");
+#endif
+	json.end();
+
+	const std::string body = json.str();
+	request.WriteHttpResponseHeader(200, (s64)body.size(), "application/json");
+	request.Out()->Push(body);
+}
+
 static void ExecuteWebServer() {
 	setCurrentThreadName("HTTPServer");
 
@@ -209,6 +295,8 @@ static void ExecuteWebServer() {
 	}
 	if (serverFlags & (int)WebServerFlags::DEBUGGER) {
 		http->RegisterHandler("/debugger", &HandleDebuggerRequest);
+		http->RegisterHandler("/debug/gpustats", &HandleGPUStatsRequest);
+		http->RegisterHandler("/debug/profiler", &HandleProfilerRequest);
 	}
 
 	if (!http->Listen(g_Config.iRemoteISOPort)) {
@@ -231,6 +319,10 @@ static void ExecuteWebServer() {
 			RegisterServer(http->Port());
 			lastRegister = now;
 		}
+		if (coreCollectDebugStatsForced && now > lastStatsRequest + 10.0) {
+			// Nobody's polled the stats endpoint in a while, stop forcing collection.
+			coreCollectDebugStatsForced = false;
+		}
 	}
 
 	http->Stop();
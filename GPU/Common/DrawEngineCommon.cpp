@@ -17,9 +17,12 @@
 
 #include <algorithm>
 
+#include "base/timeutil.h"
 #include "profiler/profiler.h"
 #include "Common/ColorConv.h"
+#include "Common/ThreadPools.h"
 #include "Core/Config.h"
+#include "Core/System.h"
 #include "GPU/Common/DrawEngineCommon.h"
 #include "GPU/Common/SplineCommon.h"
 #include "GPU/Common/VertexDecoderCommon.h"
@@ -89,11 +92,46 @@ int DrawEngineCommon::ComputeNumVertsToDecode() const {
 	return vertsToDecode;
 }
 
+// Don't bother sharding tiny flushes, the wakeup costs more than the decode.
+static const int MIN_PARALLEL_DECODE_CALLS = 8;
+
 void DrawEngineCommon::DecodeVerts(u8 *dest) {
+	double decodeStart = 0.0;
+	if (coreCollectDebugStats) {
+		decodeStart = time_now_d();
+	}
+
 	const UVScale origUV = gstate_c.uv;
-	for (; decodeCounter_ < numDrawCalls; decodeCounter_++) {
+
+	// Parallel mode. The decoder's jitted code reads gstate_c.uv, so this is only
+	// possible when every remaining call shares one UV scale, and the interpreted
+	// decoder steps walk the decoder's mutable cursors, so only when jitted.
+	bool parallel = dec_->jitted_ != nullptr && numDrawCalls - decodeCounter_ >= MIN_PARALLEL_DECODE_CALLS;
+	for (int i = decodeCounter_ + 1; parallel && i < numDrawCalls; i++) {
+		if (memcmp(&drawCalls[i].uvScale, &drawCalls[decodeCounter_].uvScale, sizeof(UVScale)) != 0)
+			parallel = false;
+	}
+
+	if (parallel) {
+		// Index translation has to stay in draw order, so walk the calls serially
+		// collecting the decode ranges, then shard the actual vertex decoding -
+		// each range writes its own slice of dest.
 		gstate_c.uv = drawCalls[decodeCounter_].uvScale;
-		DecodeVertsStep(dest, decodeCounter_, decodedVerts_);  // NOTE! DecodeVertsStep can modify decodeCounter_!
+		pendingDecodes_.clear();
+		for (; decodeCounter_ < numDrawCalls; decodeCounter_++) {
+			DecodeVertsStep(dest, decodeCounter_, decodedVerts_, &pendingDecodes_);
+		}
+		GlobalThreadPool::Loop([this](int low, int high) {
+			for (int i = low; i < high; i++) {
+				const PendingVertexDecode &p = pendingDecodes_[i];
+				dec_->DecodeVertsJitted(p.dest, p.verts, p.indexLowerBound, p.indexUpperBound);
+			}
+		}, 0, (int)pendingDecodes_.size());
+	} else {
+		for (; decodeCounter_ < numDrawCalls; decodeCounter_++) {
+			gstate_c.uv = drawCalls[decodeCounter_].uvScale;
+			DecodeVertsStep(dest, decodeCounter_, decodedVerts_);  // NOTE! DecodeVertsStep can modify decodeCounter_!
+		}
 	}
 	gstate_c.uv = origUV;
 
@@ -103,6 +141,10 @@ void DrawEngineCommon::DecodeVerts(u8 *dest) {
 		// Force to points (0)
 		indexGen.AddPrim(GE_PRIM_POINTS, 0);
 	}
+
+	if (coreCollectDebugStats) {
+		gpuStats.msVertexDecode += time_now_d() - decodeStart;
+	}
 }
 
 std::vector<std::string> DrawEngineCommon::DebugGetVertexLoaderIDs() {
@@ -504,7 +546,7 @@ bool DrawEngineCommon::ApplyShaderBlending() {
 	return true;
 }
 
-void DrawEngineCommon::DecodeVertsStep(u8 *dest, int &i, int &decodedVerts) {
+void DrawEngineCommon::DecodeVertsStep(u8 *dest, int &i, int &decodedVerts, std::vector<PendingVertexDecode> *deferredDecode) {
 	PROFILE_THIS_SCOPE("vertdec");
 
 	const DeferredDrawCall &dc = drawCalls[i];
@@ -516,15 +558,44 @@ void DrawEngineCommon::DecodeVertsStep(u8 *dest, int &i, int &decodedVerts) {
 	void *inds = dc.inds;
 	if (dc.indexType == GE_VTYPE_IDX_NONE >> GE_VTYPE_IDX_SHIFT) {
 		// Decode the verts and apply morphing. Simple.
-		dec_->DecodeVerts(dest + decodedVerts * (int)dec_->GetDecVtxFmt().stride,
-			dc.verts, indexLowerBound, indexUpperBound);
-		decodedVerts += indexUpperBound - indexLowerBound + 1;
-		
-		bool clockwise = true;
-		if (gstate.isCullEnabled() && gstate.getCullMode() != dc.cullMode) {
-			clockwise = false;
+		// Also merge in directly following non-indexed calls whose vertex data continues
+		// our block - games issue long runs of tiny draws with advancing pointers, and
+		// one big decode is much cheaper than many small ones.
+		const int vertexSize = dec_->VertexSize();
+		int lastMatch = i;
+		int vertexCount = indexUpperBound - indexLowerBound + 1;
+		for (int j = i + 1; j < numDrawCalls; ++j) {
+			const DeferredDrawCall &dcj = drawCalls[j];
+			if (dcj.indexType != dc.indexType)
+				break;
+			if (dcj.verts != (const u8 *)dc.verts + (indexLowerBound + vertexCount) * vertexSize)
+				break;
+			// The whole merged range decodes with one UV scale, so it has to match.
+			if (memcmp(&dcj.uvScale, &dc.uvScale, sizeof(UVScale)) != 0)
+				break;
+			if (decodedVerts + vertexCount + (int)dcj.vertexCount > VERTEX_BUFFER_MAX)
+				break;
+
+			vertexCount += dcj.vertexCount;
+			lastMatch = j;
 		}
-		indexGen.AddPrim(dc.prim, dc.vertexCount, clockwise);
+
+		u8 *decodeDest = dest + decodedVerts * (int)dec_->GetDecVtxFmt().stride;
+		if (deferredDecode) {
+			deferredDecode->push_back(PendingVertexDecode{ decodeDest, dc.verts, indexLowerBound, indexLowerBound + vertexCount - 1 });
+		} else {
+			dec_->DecodeVerts(decodeDest, dc.verts, indexLowerBound, indexLowerBound + vertexCount - 1);
+		}
+		decodedVerts += vertexCount;
+
+		for (int j = i; j <= lastMatch; j++) {
+			bool clockwise = true;
+			if (gstate.isCullEnabled() && gstate.getCullMode() != drawCalls[j].cullMode) {
+				clockwise = false;
+			}
+			indexGen.AddPrim(drawCalls[j].prim, drawCalls[j].vertexCount, clockwise);
+		}
+		i = lastMatch;
 	} else {
 		// It's fairly common that games issue long sequences of PRIM calls, with differing
 		// inds pointer but the same base vertex pointer. We'd like to reuse vertices between
@@ -532,15 +603,39 @@ void DrawEngineCommon::DecodeVertsStep(u8 *dest, int &i, int &decodedVerts) {
 		// into one nice big drawcall, sharing data.
 
 		// 1. Look ahead to find the max index, only looking as "matching" drawcalls.
-		//    Expand the lower and upper bounds as we go.
+		//    Expand the lower and upper bounds as we go. Besides calls reusing the same
+		//    base pointer, we also merge calls whose vertex data sits further into the
+		//    same contiguous block (common for runs of small indexed quads), rebasing
+		//    their indices by the vertex offset.
 		int lastMatch = i;
 		const int total = numDrawCalls;
+		const int vertexSize = dec_->VertexSize();
+		int vertexBias[MAX_DEFERRED_DRAW_CALLS];
+		vertexBias[0] = 0;
 		for (int j = i + 1; j < total; ++j) {
-			if (drawCalls[j].verts != dc.verts)
-				break;
+			int bias = 0;
+			if (drawCalls[j].verts != dc.verts) {
+				const intptr_t byteOffset = (const u8 *)drawCalls[j].verts - (const u8 *)dc.verts;
+				if (byteOffset <= 0 || byteOffset % vertexSize != 0)
+					break;
+				bias = (int)(byteOffset / vertexSize);
+				// The rebased range has to start inside (or right after) the range so
+				// far: a gap above would decode garbage in between, and extending
+				// downward could overrun the estimate in ComputeNumVertsToDecode().
+				if (bias + drawCalls[j].indexLowerBound > indexUpperBound + 1)
+					break;
+				if (bias + drawCalls[j].indexLowerBound < indexLowerBound)
+					break;
+				if (bias + drawCalls[j].indexUpperBound >= VERTEX_BUFFER_MAX)
+					break;
+				// The whole merged range decodes with one UV scale, so it has to match.
+				if (memcmp(&drawCalls[j].uvScale, &dc.uvScale, sizeof(UVScale)) != 0)
+					break;
+			}
 
-			indexLowerBound = std::min(indexLowerBound, (int)drawCalls[j].indexLowerBound);
-			indexUpperBound = std::max(indexUpperBound, (int)drawCalls[j].indexUpperBound);
+			indexLowerBound = std::min(indexLowerBound, bias + (int)drawCalls[j].indexLowerBound);
+			indexUpperBound = std::max(indexUpperBound, bias + (int)drawCalls[j].indexUpperBound);
+			vertexBias[j - i] = bias;
 			lastMatch = j;
 		}
 
@@ -552,7 +647,7 @@ void DrawEngineCommon::DecodeVertsStep(u8 *dest, int &i, int &decodedVerts) {
 				if (gstate.isCullEnabled() && gstate.getCullMode() != drawCalls[j].cullMode) {
 					clockwise = false;
 				}
-				indexGen.TranslatePrim(drawCalls[j].prim, drawCalls[j].vertexCount, (const u8 *)drawCalls[j].inds, indexLowerBound, clockwise);
+				indexGen.TranslatePrim(drawCalls[j].prim, drawCalls[j].vertexCount, (const u8 *)drawCalls[j].inds, indexLowerBound - vertexBias[j - i], clockwise);
 			}
 			break;
 		case GE_VTYPE_IDX_16BIT >> GE_VTYPE_IDX_SHIFT:
@@ -561,7 +656,7 @@ void DrawEngineCommon::DecodeVertsStep(u8 *dest, int &i, int &decodedVerts) {
 				if (gstate.isCullEnabled() && gstate.getCullMode() != drawCalls[j].cullMode) {
 					clockwise = false;
 				}
-				indexGen.TranslatePrim(drawCalls[j].prim, drawCalls[j].vertexCount, (const u16_le *)drawCalls[j].inds, indexLowerBound, clockwise);
+				indexGen.TranslatePrim(drawCalls[j].prim, drawCalls[j].vertexCount, (const u16_le *)drawCalls[j].inds, indexLowerBound - vertexBias[j - i], clockwise);
 			}
 			break;
 		case GE_VTYPE_IDX_32BIT >> GE_VTYPE_IDX_SHIFT:
@@ -570,7 +665,7 @@ void DrawEngineCommon::DecodeVertsStep(u8 *dest, int &i, int &decodedVerts) {
 				if (gstate.isCullEnabled() && gstate.getCullMode() != drawCalls[j].cullMode) {
 					clockwise = false;
 				}
-				indexGen.TranslatePrim(drawCalls[j].prim, drawCalls[j].vertexCount, (const u32_le *)drawCalls[j].inds, indexLowerBound, clockwise);
+				indexGen.TranslatePrim(drawCalls[j].prim, drawCalls[j].vertexCount, (const u32_le *)drawCalls[j].inds, indexLowerBound - vertexBias[j - i], clockwise);
 			}
 			break;
 		}
@@ -583,8 +678,12 @@ void DrawEngineCommon::DecodeVertsStep(u8 *dest, int &i, int &decodedVerts) {
 		}
 
 		// 3. Decode that range of vertex data.
-		dec_->DecodeVerts(dest + decodedVerts * (int)dec_->GetDecVtxFmt().stride,
-			dc.verts, indexLowerBound, indexUpperBound);
+		u8 *decodeDest = dest + decodedVerts * (int)dec_->GetDecVtxFmt().stride;
+		if (deferredDecode) {
+			deferredDecode->push_back(PendingVertexDecode{ decodeDest, dc.verts, indexLowerBound, indexUpperBound });
+		} else {
+			dec_->DecodeVerts(decodeDest, dc.verts, indexLowerBound, indexUpperBound);
+		}
 		decodedVerts += vertexCount;
 
 		// 4. Advance indexgen vertex counter.
@@ -676,7 +775,11 @@ ReliableHashType DrawEngineCommon::ComputeHash() {
 
 // vertTypeID is the vertex type but with the UVGen mode smashed into the top bits.
 void DrawEngineCommon::SubmitPrim(void *verts, void *inds, GEPrimitiveType prim, int vertexCount, u32 vertTypeID, int cullMode, int *bytesRead) {
-	if (!indexGen.PrimCompatible(prevPrim_, prim) || numDrawCalls >= MAX_DEFERRED_DRAW_CALLS || vertexCountInDrawCalls_ + vertexCount > VERTEX_BUFFER_MAX) {
+	if (!indexGen.PrimCompatible(prevPrim_, prim)) {
+		SetFlushReason(FLUSH_REASON_PRIM_TYPE_CHANGE);
+		DispatchFlush();
+	} else if (numDrawCalls >= MAX_DEFERRED_DRAW_CALLS || vertexCountInDrawCalls_ + vertexCount > VERTEX_BUFFER_MAX) {
+		SetFlushReason(FLUSH_REASON_BUFFER_FULL);
 		DispatchFlush();
 	}
 
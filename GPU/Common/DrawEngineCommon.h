@@ -36,6 +36,14 @@ enum {
 	DECODED_INDEX_BUFFER_SIZE = VERTEX_BUFFER_MAX * 16,
 };
 
+// After this many frames of identical hashes, a cached vertex range gets promoted to
+// reliable and we stop full-hashing it. Only the cheap sampled hash keeps running after
+// that, at the given draw interval, so a mesh that does eventually change still recovers.
+enum {
+	VAI_RELIABLE_AFTER_FRAMES = 500,
+	VAI_RELIABLE_MINIHASH_INTERVAL = 32,
+};
+
 // Avoiding the full include of TextureDecoder.h.
 #if (defined(_M_SSE) && defined(_M_X64)) || defined(ARM64)
 typedef u64 ReliableHashType;
@@ -49,8 +57,28 @@ inline uint32_t GetVertTypeID(uint32_t vertType, int uvGenMode) {
 	return (vertType & 0xFFFFFF) | (uvGenMode << 24);
 }
 
+// Draw-path variant: additionally marks attributes whose contents nothing in the
+// current state will read, so the decoder can skip those steps. Keep the plain
+// GetVertTypeID for debug readback and tessellation, which want full decodes.
+inline uint32_t GetVertTypeIDForDraw(uint32_t vertType, int uvGenMode) {
+	uint32_t id = GetVertTypeID(vertType, uvGenMode);
+	// Normal contents only feed lighting, shade mapping and texture-matrix UV gen.
+	if (!gstate.isLightingEnabled() && uvGenMode == GE_TEXMAP_TEXTURE_COORDS && !gstate_c.bezier && !gstate_c.spline)
+		id |= VERTTYPE_ID_NRM_UNUSED;
+	return id;
+}
+
 struct SimpleVertex;
-namespace Spline { struct Weight2D; }
+namespace Spline { struct Weight; struct Weight2D; }
+
+// A decode range collected during the serial index-translation walk, to be
+// executed on a worker thread. See DrawEngineCommon::DecodeVerts.
+struct PendingVertexDecode {
+	u8 *dest;
+	const void *verts;
+	int indexLowerBound;
+	int indexUpperBound;
+};
 
 class TessellationDataTransfer {
 public:
@@ -98,6 +126,12 @@ public:
 		return numDrawCalls;
 	}
 
+	// Tags the next flush with why the batch was broken, for the flush histogram
+	// in gpuStats. Cleared back to FLUSH_REASON_OTHER when the flush is accounted.
+	void SetFlushReason(FlushReason reason) {
+		flushReason_ = reason;
+	}
+
 	VertexDecoder *GetVertexDecoder(u32 vtype);
 
 protected:
@@ -113,8 +147,9 @@ protected:
 	u32 ComputeMiniHash();
 	ReliableHashType ComputeHash();
 
-	// Vertex decoding
-	void DecodeVertsStep(u8 *dest, int &i, int &decodedVerts);
+	// Vertex decoding. When deferredDecode is non-null, the actual vertex decoding
+	// is queued there instead of running inline, for sharding across worker threads.
+	void DecodeVertsStep(u8 *dest, int &i, int &decodedVerts, std::vector<PendingVertexDecode> *deferredDecode = nullptr);
 
 	bool ApplyShaderBlending();
 
@@ -164,9 +199,18 @@ protected:
 	int decodeCounter_ = 0;
 	u32 dcid_ = 0;
 
+	// Accounts the pending flush reason into gpuStats and resets it. Called by the
+	// backends' DoFlush next to the numFlushes bump.
+	void AccountFlushReason() {
+		gpuStats.numFlushesByReason[flushReason_]++;
+		flushReason_ = FLUSH_REASON_OTHER;
+	}
+	FlushReason flushReason_ = FLUSH_REASON_OTHER;
+
 	// Vertex collector state
 	IndexGenerator indexGen;
 	int decodedVerts_ = 0;
+	std::vector<PendingVertexDecode> pendingDecodes_;
 	GEPrimitiveType prevPrim_ = GE_PRIM_INVALID;
 
 	// Shader blending state
@@ -191,6 +191,33 @@ u32 FramebufferManagerCommon::FramebufferByteSize(const VirtualFramebuffer *vfb)
 	return vfb->fb_stride * vfb->height * (vfb->format == GE_FORMAT_8888 ? 4 : 2);
 }
 
+// Above this estimate of total render target memory, DecimateFBOs starts dropping
+// VRAM-aliased targets after FBO_ALIASED_AGE frames instead of FBO_OLD_AGE.
+// At 5x render scale in games that relayout VRAM a lot, we've seen well over
+// 512MB of targets accumulate otherwise, which is fatal on 3GB phones.
+static const u64 FBO_MEMORY_PRESSURE_BYTES = 256 * 1024 * 1024;
+
+// True if another framebuffer overlaps this one's VRAM range and has been used more
+// recently. The PSP can't meaningfully use two layouts of the same VRAM at once, so
+// the older target's contents are almost certainly dead - it's the safest thing to
+// drop when device memory gets tight.
+bool FramebufferManagerCommon::AliasedByNewerFramebuffer(const VirtualFramebuffer *vfb) const {
+	const u32 addr = vfb->fb_address & 0x3FFFFFFF;
+	const u32 size = FramebufferByteSize(vfb);
+	const int lastUsed = std::max(vfb->last_frame_render, vfb->last_frame_used);
+	for (const VirtualFramebuffer *v : vfbs_) {
+		if (v == vfb)
+			continue;
+		const u32 v_addr = v->fb_address & 0x3FFFFFFF;
+		const u32 v_size = FramebufferByteSize(v);
+		if (addr < v_addr + v_size && v_addr < addr + size) {
+			if (std::max(v->last_frame_render, v->last_frame_used) > lastUsed)
+				return true;
+		}
+	}
+	return false;
+}
+
 bool FramebufferManagerCommon::ShouldDownloadFramebuffer(const VirtualFramebuffer *vfb) const {
 	return PSP_CoreParameter().compat.flags().Force04154000Download && vfb->fb_address == 0x00154000;
 }
@@ -527,6 +554,8 @@ void FramebufferManagerCommon::DestroyFramebuf(VirtualFramebuffer *v) {
 	}
 
 	// Wipe some pointers
+	if (colorCopyCache_.src == v)
+		colorCopyCache_ = ColorCopyCache{};
 	if (currentRenderVfb_ == v)
 		currentRenderVfb_ = 0;
 	if (displayFramebuf_ == v)
@@ -719,6 +748,10 @@ void FramebufferManagerCommon::UpdateFromMemory(u32 addr, int size, bool safe) {
 }
 
 void FramebufferManagerCommon::DrawPixels(VirtualFramebuffer *vfb, int dstX, int dstY, const u8 *srcPixels, GEBufferFormat srcPixelFormat, int srcStride, int width, int height) {
+	if (vfb) {
+		// This writes the color buffer without going through SetColorUpdated.
+		vfb->colorWriteSeq = ++colorWriteSequence_;
+	}
 	textureCache_->ForgetLastTexture();
 	shaderManager_->DirtyLastShader();  // On GL, important that this is BEFORE drawing
 	float u0 = 0.0f, u1 = 1.0f;
@@ -768,7 +801,29 @@ void FramebufferManagerCommon::CopyFramebufferForColorTexture(VirtualFramebuffer
 	}
 
 	if (x < src->drawnWidth && y < src->drawnHeight && w > 0 && h > 0) {
+		// Only copy when there's a true read-after-write hazard: if the source hasn't been
+		// written to since the last copy into this temp buffer, and that copy already covers
+		// the requested region, the old copy is still current. Games that bind their render
+		// target as a texture over and over (mirrors, shadow buffers) hit this a lot.
+		const bool cacheMatch = colorCopyCache_.src == src && colorCopyCache_.fbo == dst->fbo &&
+			colorCopyCache_.writeSeq == src->colorWriteSeq;
+		if (cacheMatch &&
+			x >= colorCopyCache_.x && y >= colorCopyCache_.y &&
+			x + w <= colorCopyCache_.x + colorCopyCache_.w && y + h <= colorCopyCache_.y + colorCopyCache_.h) {
+			return;
+		}
 		BlitFramebuffer(dst, x, y, src, x, y, w, h, 0);
+		if (cacheMatch) {
+			// The temp buffer now holds both the old region and the new one.
+			int x2 = std::max(colorCopyCache_.x + colorCopyCache_.w, x + w);
+			int y2 = std::max(colorCopyCache_.y + colorCopyCache_.h, y + h);
+			colorCopyCache_.x = std::min(colorCopyCache_.x, x);
+			colorCopyCache_.y = std::min(colorCopyCache_.y, y);
+			colorCopyCache_.w = x2 - colorCopyCache_.x;
+			colorCopyCache_.h = y2 - colorCopyCache_.y;
+		} else {
+			colorCopyCache_ = ColorCopyCache{ src, dst->fbo, src->colorWriteSeq, x, y, w, h };
+		}
 	}
 }
 
@@ -1076,13 +1131,33 @@ void FramebufferManagerCommon::CopyDisplayToOutput() {
 }
 
 void FramebufferManagerCommon::DecimateFBOs() {
+	FlushDeferredReadbacks();
+
 	currentRenderVfb_ = 0;
+	// Temp FBOs may get aged out below, so don't trust the cached copy across frames.
+	colorCopyCache_ = ColorCopyCache{};
 
 	for (auto iter : fbosToDelete_) {
 		iter->Release();
 	}
 	fbosToDelete_.clear();
 
+	// Estimate how much device memory the render targets hold. Games that reuse
+	// VRAM ranges for many different buffer layouts can accumulate dozens of big
+	// FBOs at high render scale, so past a threshold we retire aliased targets
+	// much faster than the normal aging below.
+	u64 totalFBOBytes = 0;
+	for (const VirtualFramebuffer *vfb : vfbs_) {
+		if (vfb->fbo)
+			totalFBOBytes += (u64)vfb->renderWidth * vfb->renderHeight * 8;  // color + depth
+	}
+	gpuMemoryBudget.framebufferBytes = totalFBOBytes;
+	gpuStats.framebufferBytes = totalFBOBytes;
+	// React both to our own occupancy and to combined pressure from the shared
+	// budget - but the floor in FramebufferPressure() means a texture flood alone
+	// can't make us drop targets early.
+	const bool memoryPressure = totalFBOBytes > FBO_MEMORY_PRESSURE_BYTES || gpuMemoryBudget.FramebufferPressure();
+
 	for (size_t i = 0; i < vfbs_.size(); ++i) {
 		VirtualFramebuffer *vfb = vfbs_[i];
 		int age = frameLastFramebufUsed_ - std::max(vfb->last_frame_render, vfb->last_frame_used);
@@ -1097,7 +1172,10 @@ void FramebufferManagerCommon::DecimateFBOs() {
 		UpdateFramebufUsage(vfb);
 
 		if (vfb != displayFramebuf_ && vfb != prevDisplayFramebuf_ && vfb != prevPrevDisplayFramebuf_) {
-			if (age > FBO_OLD_AGE) {
+			int maxAge = FBO_OLD_AGE;
+			if (memoryPressure && AliasedByNewerFramebuffer(vfb))
+				maxAge = FBO_ALIASED_AGE;
+			if (age > maxAge) {
 				INFO_LOG(FRAMEBUF, "Decimating FBO for %08x (%i x %i x %i), age %i", vfb->fb_address, vfb->width, vfb->height, vfb->format, age);
 				DestroyFramebuf(vfb);
 				vfbs_.erase(vfbs_.begin() + i--);
@@ -1308,10 +1386,45 @@ bool FramebufferManagerCommon::NotifyFramebufferCopy(u32 src, u32 dst, int size,
 		}
 		return false;
 	} else {
+		if (PSP_CoreParameter().compat.flags().DepthReadback) {
+			// Might be the game reading the depth buffer back instead.
+			NotifyDepthbufferCopy(src, size);
+		}
 		return false;
 	}
 }
 
+void FramebufferManagerCommon::NotifyDepthbufferCopy(u32 src, int size) {
+	for (size_t i = 0; i < vfbs_.size(); ++i) {
+		VirtualFramebuffer *vfb = vfbs_[i];
+		if (vfb->z_stride == 0) {
+			continue;
+		}
+
+		const u32 z_address = vfb->z_address & 0x3FFFFFFF;
+		const u32 z_byteStride = vfb->z_stride * sizeof(u16);
+		const u32 z_size = z_byteStride * vfb->height;
+		if (src < z_address || src + size > z_address + z_size) {
+			continue;
+		}
+		const u32 offset = src - z_address;
+		if ((offset % z_byteStride) != 0) {
+			continue;
+		}
+
+		// Only pack the rows the copy actually covers, rather than the whole buffer -
+		// games typically sample small strips of Z, and the sync readback cost scales
+		// with the region.
+		const u32 y = offset / z_byteStride;
+		const u32 h = size <= (int)z_byteStride ? 1 : std::min((u32)size / z_byteStride, (u32)vfb->height - y);
+		WARN_LOG_ONCE(btdcpyz, G3D, "Memcpy depthbuffer download %08x, %d bytes", src, size);
+		FlushBeforeCopy();
+		PackDepthbuffer(vfb, 0, y, vfb->width, h);
+		RebindFramebuffer();
+		break;
+	}
+}
+
 // Can't be const, in case it has to create a vfb unfortunately.
 void FramebufferManagerCommon::FindTransferFramebuffers(VirtualFramebuffer *&dstBuffer, VirtualFramebuffer *&srcBuffer, u32 dstBasePtr, int dstStride, int &dstX, int &dstY, u32 srcBasePtr, int srcStride, int &srcX, int &srcY, int &srcWidth, int &srcHeight, int &dstWidth, int &dstHeight, int bpp) {
 	u32 dstYOffset = -1;
@@ -1792,6 +1905,11 @@ void FramebufferManagerCommon::Resized() {
 	if (zoom <= 1 || postShaderIsUpscalingFilter_)
 		zoom = 1;
 
+	// The dynamic resolution governor (sceDisplay) may cap the zoom to hold speed.
+	const int dynamicCap = PSP_CoreParameter().dynamicResZoomCap;
+	if (dynamicCap > 0 && zoom > dynamicCap)
+		zoom = dynamicCap;
+
 	if (g_Config.IsPortrait()) {
 		PSP_CoreParameter().renderWidth = 272 * zoom;
 		PSP_CoreParameter().renderHeight = 480 * zoom;
@@ -1961,7 +2079,14 @@ bool FramebufferManagerCommon::GetFramebuffer(u32 fb_address, int fb_stride, GEB
 	// TODO: Maybe should handle flipY inside CopyFramebufferToMemorySync somehow?
 	bool flipY = (GetGPUBackend() == GPUBackend::OPENGL && !useBufferedRendering_) ? true : false;
 	buffer.Allocate(w, h, GE_FORMAT_8888, flipY);
+	double readbackStart = 0.0;
+	if (coreCollectDebugStats) {
+		readbackStart = time_now_d();
+	}
 	bool retval = draw_->CopyFramebufferToMemorySync(bound, Draw::FB_COLOR_BIT, 0, 0, w, h, Draw::DataFormat::R8G8B8A8_UNORM, buffer.GetData(), w);
+	if (coreCollectDebugStats) {
+		gpuStats.msReadbacks += time_now_d() - readbackStart;
+	}
 	gpuStats.numReadbacks++;
 	// After a readback we'll have flushed and started over, need to dirty a bunch of things to be safe.
 	gstate_c.Dirty(DIRTY_VIEWPORTSCISSOR_STATE | DIRTY_BLEND_STATE | DIRTY_DEPTHSTENCIL_STATE | DIRTY_RASTER_STATE | DIRTY_TEXTURE_IMAGE | DIRTY_TEXTURE_PARAMS);
@@ -2085,7 +2210,14 @@ void FramebufferManagerCommon::PackFramebufferSync_(VirtualFramebuffer *vfb, int
 	DEBUG_LOG(G3D, "Reading framebuffer to mem, fb_address = %08x, ptr=%p", fb_address, destPtr);
 
 	if (destPtr) {
+		double readbackStart = 0.0;
+		if (coreCollectDebugStats) {
+			readbackStart = time_now_d();
+		}
 		draw_->CopyFramebufferToMemorySync(vfb->fbo, Draw::FB_COLOR_BIT, x, y, w, h, destFormat, destPtr, vfb->fb_stride);
+		if (coreCollectDebugStats) {
+			gpuStats.msReadbacks += time_now_d() - readbackStart;
+		}
 	} else {
 		ERROR_LOG(G3D, "PackFramebufferSync_: Tried to readback to bad address %08x (stride = %d)", fb_address + dstByteOffset, vfb->fb_stride);
 	}
@@ -2102,6 +2234,13 @@ void FramebufferManagerCommon::ReadFramebufferToMemory(VirtualFramebuffer *vfb,
 		w = vfb->bufferWidth - x;
 	}
 	if (vfb && vfb->fbo) {
+		if (PSP_CoreParameter().compat.flags().DelayedReadbacks) {
+			// The game has been whitelisted as tolerating RAM lagging the render by one
+			// frame, so queue the pack for the next BeginFrame instead of stalling now.
+			QueueDeferredReadback(vfb, x, y, w, h);
+			return;
+		}
+
 		// We'll pseudo-blit framebuffers here to get a resized version of vfb.
 		OptimizeDownloadRange(vfb, x, y, w, h);
 		if (vfb->renderWidth == vfb->width && vfb->renderHeight == vfb->height) {
@@ -2118,6 +2257,57 @@ void FramebufferManagerCommon::ReadFramebufferToMemory(VirtualFramebuffer *vfb,
 	}
 }
 
+void FramebufferManagerCommon::QueueDeferredReadback(VirtualFramebuffer *vfb, int x, int y, int w, int h) {
+	// Merge with any readback already queued for the same framebuffer, so each one
+	// gets packed at most once per frame.
+	for (auto &r : deferredReadbacks_) {
+		if (r.fb_address == vfb->fb_address) {
+			int x2 = std::max(r.x + r.w, x + w);
+			int y2 = std::max(r.y + r.h, y + h);
+			r.x = std::min(r.x, x);
+			r.y = std::min(r.y, y);
+			r.w = x2 - r.x;
+			r.h = y2 - r.y;
+			return;
+		}
+	}
+	deferredReadbacks_.push_back(DeferredReadback{ vfb->fb_address, x, y, w, h });
+}
+
+void FramebufferManagerCommon::FlushDeferredReadbacks() {
+	if (deferredReadbacks_.empty())
+		return;
+
+	for (const auto &r : deferredReadbacks_) {
+		// Look the framebuffer up by address again - it may have been resized or
+		// destroyed since the readback was queued.
+		VirtualFramebuffer *vfb = GetVFBAt(r.fb_address);
+		if (!vfb || !vfb->fbo)
+			continue;
+		int x = r.x, y = r.y, w = r.w, h = r.h;
+		if (x + w > vfb->bufferWidth)
+			w = vfb->bufferWidth - x;
+		if (y + h > vfb->bufferHeight)
+			h = vfb->bufferHeight - y;
+		if (w <= 0 || h <= 0)
+			continue;
+		// The GPU finished rendering this frames ago, so the sync copy below no longer
+		// drains the pipeline, it just maps the result.
+		if (vfb->renderWidth == vfb->width && vfb->renderHeight == vfb->height) {
+			PackFramebufferSync_(vfb, x, y, w, h);
+		} else {
+			VirtualFramebuffer *nvfb = FindDownloadTempBuffer(vfb);
+			BlitFramebuffer(nvfb, x, y, vfb, x, y, w, h, 0);
+			PackFramebufferSync_(nvfb, x, y, w, h);
+		}
+	}
+	deferredReadbacks_.clear();
+
+	if (textureCache_)
+		textureCache_->ForgetLastTexture();
+	RebindFramebuffer();
+}
+
 void FramebufferManagerCommon::FlushBeforeCopy() {
 	// Flush anything not yet drawn before blitting, downloading, or uploading.
 	// This might be a stalled list, or unflushed before a block transfer, etc.
@@ -116,6 +116,10 @@ struct VirtualFramebuffer {
 
 	bool dirtyAfterDisplay;
 	bool reallyDirtyAfterDisplay;  // takes frame skipping into account
+
+	// Monotonic mark of the last write to the color buffer. Used to detect true
+	// read-after-write hazards when self-texturing - see CopyFramebufferForColorTexture().
+	int colorWriteSeq;
 };
 
 struct FramebufferHeuristicParams {
@@ -159,6 +163,8 @@ enum DrawTextureFlags {
 
 enum class TempFBO {
 	DEPAL,
+	// GPU-side copy of a CLUT that a game rendered into a framebuffer.
+	CLUT,
 	BLIT,
 	// For copies of framebuffers (e.g. shader blending.)
 	COPY,
@@ -313,6 +319,11 @@ public:
 
 protected:
 	virtual void PackFramebufferSync_(VirtualFramebuffer *vfb, int x, int y, int w, int h);
+	// Packs the depth buffer to RAM at vfb->z_address, rows y through y + h. Backends
+	// without a depth pack path just leave the old RAM contents alone.
+	// Only used with the DepthReadback compat flag, see NotifyDepthbufferCopy.
+	virtual void PackDepthbuffer(VirtualFramebuffer *vfb, int x, int y, int w, int h) {}
+	void NotifyDepthbufferCopy(u32 src, int size);
 	virtual void SetViewport2D(int x, int y, int w, int h);
 	void CalculatePostShaderUniforms(int bufferWidth, int bufferHeight, int renderWidth, int renderHeight, PostShaderUniforms *uniforms);
 	virtual void MakePixelTexture(const u8 *srcPixels, GEBufferFormat srcPixelFormat, int srcStride, int width, int height, float &u1, float &v1) = 0;
@@ -335,6 +346,7 @@ protected:
 
 	void EstimateDrawingSize(u32 fb_address, GEBufferFormat fb_format, int viewport_width, int viewport_height, int region_width, int region_height, int scissor_width, int scissor_height, int fb_stride, int &drawing_width, int &drawing_height);
 	u32 FramebufferByteSize(const VirtualFramebuffer *vfb) const;
+	bool AliasedByNewerFramebuffer(const VirtualFramebuffer *vfb) const;
 
 	void NotifyRenderFramebufferCreated(VirtualFramebuffer *vfb);
 	void NotifyRenderFramebufferUpdated(VirtualFramebuffer *vfb, bool vfbFormatChanged);
@@ -348,6 +360,8 @@ protected:
 
 	bool ShouldDownloadFramebuffer(const VirtualFramebuffer *vfb) const;
 	void DownloadFramebufferOnSwitch(VirtualFramebuffer *vfb);
+	void QueueDeferredReadback(VirtualFramebuffer *vfb, int x, int y, int w, int h);
+	void FlushDeferredReadbacks();
 	void FindTransferFramebuffers(VirtualFramebuffer *&dstBuffer, VirtualFramebuffer *&srcBuffer, u32 dstBasePtr, int dstStride, int &dstX, int &dstY, u32 srcBasePtr, int srcStride, int &srcX, int &srcY, int &srcWidth, int &srcHeight, int &dstWidth, int &dstHeight, int bpp);
 	VirtualFramebuffer *FindDownloadTempBuffer(VirtualFramebuffer *vfb);
 	virtual bool CreateDownloadTempBuffer(VirtualFramebuffer *nvfb) = 0;
@@ -359,6 +373,7 @@ protected:
 	void UpdateFramebufUsage(VirtualFramebuffer *vfb);
 
 	void SetColorUpdated(VirtualFramebuffer *dstBuffer, int skipDrawReason) {
+		dstBuffer->colorWriteSeq = ++colorWriteSequence_;
 		dstBuffer->memoryUpdated = false;
 		dstBuffer->clutUpdatedBytes = 0;
 		dstBuffer->dirtyAfterDisplay = true;
@@ -400,6 +415,25 @@ protected:
 
 	bool gameUsesSequentialCopies_ = false;
 
+	// Readbacks postponed until the next frame (compat flag DelayedReadbacks), when the
+	// GPU has caught up and the copy won't stall. RAM then lags the render by one frame.
+	struct DeferredReadback {
+		u32 fb_address;
+		int x, y, w, h;
+	};
+	std::vector<DeferredReadback> deferredReadbacks_;
+
+	// Tracks the last copy made for self-texturing, so that repeated binds without any
+	// intervening writes to the source can reuse it instead of blitting again.
+	struct ColorCopyCache {
+		VirtualFramebuffer *src;
+		Draw::Framebuffer *fbo;
+		int writeSeq;
+		int x, y, w, h;
+	};
+	ColorCopyCache colorCopyCache_{};
+	int colorWriteSequence_ = 0;
+
 	// Sampled in BeginFrame for safety.
 	float renderWidth_ = 0.0f;
 	float renderHeight_ = 0.0f;
@@ -424,6 +458,9 @@ protected:
 	// Aggressively delete unused FBOs to save gpu memory.
 	enum {
 		FBO_OLD_AGE = 5,
+		// Used instead of FBO_OLD_AGE for VRAM-aliased targets when the total
+		// render target memory estimate crosses FBO_MEMORY_PRESSURE_BYTES.
+		FBO_ALIASED_AGE = 1,
 		FBO_OLD_USAGE_FLAG = 15,
 	};
 };
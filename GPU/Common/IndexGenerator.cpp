@@ -18,8 +18,103 @@
 #include <cstring>
 #include "IndexGenerator.h"
 
+#include "ppsspp_config.h"
 #include "Common/Common.h"
 
+#ifdef _M_SSE
+#include <emmintrin.h>
+#endif
+#if PPSSPP_ARCH(ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Emits the ascending sequence start, start+1, ... - non-indexed points,
+// rectangles, line lists and clockwise triangle lists all expand to this.
+static inline u16 *WriteAscending(u16 *dst, int start, int count) {
+	int i = 0;
+#ifdef _M_SSE
+	__m128i cur = _mm_add_epi16(_mm_set1_epi16((short)start), _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7));
+	const __m128i eight = _mm_set1_epi16(8);
+	for (; i + 8 <= count; i += 8) {
+		_mm_storeu_si128((__m128i *)(dst + i), cur);
+		cur = _mm_add_epi16(cur, eight);
+	}
+#elif PPSSPP_ARCH(ARM_NEON)
+	static const u16 initial[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+	uint16x8_t cur = vaddq_u16(vdupq_n_u16((u16)start), vld1q_u16(initial));
+	const uint16x8_t eight = vdupq_n_u16(8);
+	for (; i + 8 <= count; i += 8) {
+		vst1q_u16(dst + i, cur);
+		cur = vaddq_u16(cur, eight);
+	}
+#endif
+	for (; i < count; i++)
+		dst[i] = start + i;
+	return dst + count;
+}
+
+// Adds a constant offset to raw u16 index data, eight lanes at a time.
+static inline void TranslateU16Add(u16 *dst, const u16 *src, int count, u16 offset) {
+	int i = 0;
+#ifdef _M_SSE
+	const __m128i off = _mm_set1_epi16((short)offset);
+	for (; i + 8 <= count; i += 8) {
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_add_epi16(_mm_loadu_si128((const __m128i *)(src + i)), off));
+	}
+#elif PPSSPP_ARCH(ARM_NEON)
+	const uint16x8_t off = vdupq_n_u16(offset);
+	for (; i + 8 <= count; i += 8) {
+		vst1q_u16(dst + i, vaddq_u16(vld1q_u16(src + i), off));
+	}
+#endif
+	for (; i < count; i++)
+		dst[i] = src[i] + offset;
+}
+
+#if defined(_M_SSE) || PPSSPP_ARCH(ARM_NEON)
+
+// Non-indexed strips and counterclockwise lists expand to a fixed index
+// pattern that repeats with a constant base step, so eight triangles
+// (24 indices) can be emitted per iteration. Returns the number of
+// triangles emitted, always a multiple of 8 - the caller finishes the rest.
+static int WriteTrianglePattern(u16 *dst, const u16 *pattern, int base, int baseStep, int numTris) {
+	int blocks = numTris / 8;
+#ifdef _M_SSE
+	const __m128i p0 = _mm_loadu_si128((const __m128i *)pattern);
+	const __m128i p1 = _mm_loadu_si128((const __m128i *)(pattern + 8));
+	const __m128i p2 = _mm_loadu_si128((const __m128i *)(pattern + 16));
+	__m128i b = _mm_set1_epi16((short)base);
+	const __m128i step = _mm_set1_epi16((short)baseStep);
+	for (int i = 0; i < blocks; i++) {
+		_mm_storeu_si128((__m128i *)dst, _mm_add_epi16(p0, b));
+		_mm_storeu_si128((__m128i *)(dst + 8), _mm_add_epi16(p1, b));
+		_mm_storeu_si128((__m128i *)(dst + 16), _mm_add_epi16(p2, b));
+		b = _mm_add_epi16(b, step);
+		dst += 24;
+	}
+#else
+	const uint16x8_t p0 = vld1q_u16(pattern);
+	const uint16x8_t p1 = vld1q_u16(pattern + 8);
+	const uint16x8_t p2 = vld1q_u16(pattern + 16);
+	uint16x8_t b = vdupq_n_u16((u16)base);
+	const uint16x8_t step = vdupq_n_u16((u16)baseStep);
+	for (int i = 0; i < blocks; i++) {
+		vst1q_u16(dst, vaddq_u16(p0, b));
+		vst1q_u16(dst + 8, vaddq_u16(p1, b));
+		vst1q_u16(dst + 16, vaddq_u16(p2, b));
+		b = vaddq_u16(b, step);
+		dst += 24;
+	}
+#endif
+	return blocks * 8;
+}
+
+static const u16 stripPatternCW[24] = { 0, 1, 2, 1, 3, 2, 2, 3, 4, 3, 5, 4, 4, 5, 6, 5, 7, 6, 6, 7, 8, 7, 9, 8 };
+static const u16 stripPatternCCW[24] = { 0, 2, 1, 1, 2, 3, 2, 4, 3, 3, 4, 5, 4, 6, 5, 5, 6, 7, 6, 8, 7, 7, 8, 9 };
+static const u16 listPatternCCW[24] = { 0, 2, 1, 3, 5, 4, 6, 8, 7, 9, 11, 10, 12, 14, 13, 15, 17, 16, 18, 20, 19, 21, 23, 22 };
+
+#endif
+
 // Points don't need indexing...
 const u8 IndexGenerator::indexedPrimitiveType[7] = {
 	GE_PRIM_POINTS,
@@ -49,11 +144,7 @@ void IndexGenerator::AddPrim(int prim, int vertexCount, bool clockwise) {
 }
 
 void IndexGenerator::AddPoints(int numVerts) {
-	u16 *outInds = inds_;
-	const int startIndex = index_;
-	for (int i = 0; i < numVerts; i++)
-		*outInds++ = startIndex + i;
-	inds_ = outInds;
+	inds_ = WriteAscending(inds_, index_, numVerts);
 	// ignore overflow verts
 	index_ += numVerts;
 	count_ += numVerts;
@@ -66,7 +157,21 @@ void IndexGenerator::AddList(int numVerts, bool clockwise) {
 	const int startIndex = index_;
 	const int v1 = clockwise ? 1 : 2;
 	const int v2 = clockwise ? 2 : 1;
-	for (int i = 0; i < numVerts; i += 3) {
+	int i = 0;
+	if (clockwise) {
+		// A clockwise list is just the ascending sequence.
+		const int rounded = ((numVerts + 2) / 3) * 3;
+		outInds = WriteAscending(outInds, startIndex, rounded);
+		i = numVerts;
+	}
+#if defined(_M_SSE) || PPSSPP_ARCH(ARM_NEON)
+	else {
+		int tris = WriteTrianglePattern(outInds, listPatternCCW, startIndex, 24, numVerts / 3);
+		outInds += tris * 3;
+		i = tris * 3;
+	}
+#endif
+	for (; i < numVerts; i += 3) {
 		*outInds++ = startIndex + i;
 		*outInds++ = startIndex + i + v1;
 		*outInds++ = startIndex + i + v2;
@@ -88,7 +193,14 @@ void IndexGenerator::AddStrip(int numVerts, bool clockwise) {
 	const int numTris = numVerts - 2;
 	u16 *outInds = inds_;
 	int ibase = index_;
-	for (int i = 0; i < numTris; i++) {
+	int i = 0;
+#if defined(_M_SSE) || PPSSPP_ARCH(ARM_NEON)
+	// Blocks of 8 triangles keep the winding toggle in its initial state.
+	i = WriteTrianglePattern(outInds, clockwise ? stripPatternCW : stripPatternCCW, ibase, 8, numTris);
+	outInds += i * 3;
+	ibase += i;
+#endif
+	for (; i < numTris; i++) {
 		*outInds++ = ibase;
 		*outInds++ = ibase + wind;
 		wind ^= 3;  // toggle between 1 and 2
@@ -135,13 +247,8 @@ void IndexGenerator::AddFan(int numVerts, bool clockwise) {
 
 //Lines
 void IndexGenerator::AddLineList(int numVerts) {
-	u16 *outInds = inds_;
-	const int startIndex = index_;
-	for (int i = 0; i < numVerts; i += 2) {
-		*outInds++ = startIndex + i;
-		*outInds++ = startIndex + i + 1;
-	}
-	inds_ = outInds;
+	// Round up to even like the old pairwise loop did.
+	inds_ = WriteAscending(inds_, index_, (numVerts + 1) & ~1);
 	index_ += numVerts;
 	count_ += numVerts;
 	prim_ = GE_PRIM_LINES;
@@ -164,15 +271,9 @@ void IndexGenerator::AddLineStrip(int numVerts) {
 }
 
 void IndexGenerator::AddRectangles(int numVerts) {
-	u16 *outInds = inds_;
-	const int startIndex = index_;
 	//rectangles always need 2 vertices, disregard the last one if there's an odd number
 	numVerts = numVerts & ~1;
-	for (int i = 0; i < numVerts; i += 2) {
-		*outInds++ = startIndex + i;
-		*outInds++ = startIndex + i + 1;
-	}
-	inds_ = outInds;
+	inds_ = WriteAscending(inds_, index_, numVerts);
 	index_ += numVerts;
 	count_ += numVerts;
 	prim_ = GE_PRIM_RECTANGLES;
@@ -183,8 +284,16 @@ template <class ITypeLE, int flag>
 void IndexGenerator::TranslatePoints(int numInds, const ITypeLE *inds, int indexOffset) {
 	indexOffset = index_ - indexOffset;
 	u16 *outInds = inds_;
-	for (int i = 0; i < numInds; i++)
-		*outInds++ = indexOffset + inds[i];
+	if (sizeof(ITypeLE) == sizeof(u16)) {
+		if (indexOffset == 0)
+			memcpy(outInds, inds, numInds * sizeof(u16));
+		else
+			TranslateU16Add(outInds, (const u16 *)(const void *)inds, numInds, (u16)indexOffset);
+		outInds += numInds;
+	} else {
+		for (int i = 0; i < numInds; i++)
+			*outInds++ = indexOffset + inds[i];
+	}
 	inds_ = outInds;
 	count_ += numInds;
 	prim_ = GE_PRIM_POINTS;
@@ -196,9 +305,17 @@ void IndexGenerator::TranslateLineList(int numInds, const ITypeLE *inds, int ind
 	indexOffset = index_ - indexOffset;
 	u16 *outInds = inds_;
 	numInds = numInds & ~1;
-	for (int i = 0; i < numInds; i += 2) {
-		*outInds++ = indexOffset + inds[i];
-		*outInds++ = indexOffset + inds[i + 1];
+	if (sizeof(ITypeLE) == sizeof(u16)) {
+		if (indexOffset == 0)
+			memcpy(outInds, inds, numInds * sizeof(u16));
+		else
+			TranslateU16Add(outInds, (const u16 *)(const void *)inds, numInds, (u16)indexOffset);
+		outInds += numInds;
+	} else {
+		for (int i = 0; i < numInds; i += 2) {
+			*outInds++ = indexOffset + inds[i];
+			*outInds++ = indexOffset + inds[i + 1];
+		}
 	}
 	inds_ = outInds;
 	count_ += numInds;
@@ -226,8 +343,11 @@ void IndexGenerator::TranslateList(int numInds, const ITypeLE *inds, int indexOf
 	indexOffset = index_ - indexOffset;
 	// We only bother doing this minor optimization in triangle list, since it's by far the most
 	// common operation that can benefit.
-	if (sizeof(ITypeLE) == sizeof(inds_[0]) && indexOffset == 0 && clockwise) {
-		memcpy(inds_, inds, numInds * sizeof(ITypeLE));
+	if (sizeof(ITypeLE) == sizeof(inds_[0]) && clockwise) {
+		if (indexOffset == 0)
+			memcpy(inds_, inds, numInds * sizeof(ITypeLE));
+		else
+			TranslateU16Add(inds_, (const u16 *)(const void *)inds, numInds, (u16)indexOffset);
 		inds_ += numInds;
 		count_ += numInds;
 	} else {
@@ -291,9 +411,18 @@ inline void IndexGenerator::TranslateRectangles(int numInds, const ITypeLE *inds
 	u16 *outInds = inds_;
 	//rectangles always need 2 vertices, disregard the last one if there's an odd number
 	numInds = numInds & ~1;
-	for (int i = 0; i < numInds; i += 2) {
-		*outInds++ = indexOffset + inds[i];
-		*outInds++ = indexOffset + inds[i+1];
+	if (sizeof(ITypeLE) == sizeof(u16)) {
+		// 2D games throw a lot of indexed rectangles at us, make this one quick.
+		if (indexOffset == 0)
+			memcpy(outInds, inds, numInds * sizeof(u16));
+		else
+			TranslateU16Add(outInds, (const u16 *)(const void *)inds, numInds, (u16)indexOffset);
+		outInds += numInds;
+	} else {
+		for (int i = 0; i < numInds; i += 2) {
+			*outInds++ = indexOffset + inds[i];
+			*outInds++ = indexOffset + inds[i+1];
+		}
 	}
 	inds_ = outInds;
 	count_ += numInds;
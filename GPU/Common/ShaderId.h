@@ -91,7 +91,12 @@ enum FShaderBit : uint8_t {
 	FS_BIT_BGRA_TEXTURE = 47,
 	FS_BIT_TEST_DISCARD_TO_ZERO = 48,
 	FS_BIT_NO_DEPTH_CANNOT_DISCARD_STENCIL = 49,
-	// 50+ are free.
+	// The alpha test function is read from the u_alphaTestFunc uniform instead of
+	// FS_BIT_ALPHA_TEST_FUNC, collapsing all those variants into one shader. Only
+	// set by the GLES backend, for stand-in shaders used while the specialized
+	// variant hasn't been compiled yet.
+	FS_BIT_UBER_ALPHA_TEST = 50,
+	// 51+ are free.
 };
 
 static inline FShaderBit operator +(FShaderBit bit, int i) {
@@ -198,37 +198,68 @@ void SoftwareTransform(
 
 	VertexReader reader(decoded, decVtxFormat, vertType);
 	if (throughmode) {
-		for (int index = 0; index < maxIndex; index++) {
-			// Do not touch the coordinates or the colors. No lighting.
-			reader.Goto(index);
-			// TODO: Write to a flexible buffer, we don't always need all four components.
-			TransformedVertex &vert = transformed[index];
-			reader.ReadPos(vert.pos);
-
-			if (reader.hasColor0()) {
-				if (provokeIndOffset != 0 && index + provokeIndOffset < maxIndex) {
-					reader.Goto(index + provokeIndOffset);
-					reader.ReadColor0_8888(vert.color0);
-					reader.Goto(index);
+		// The dominant layout for 2D draws (rectangles and through-mode sprites): float
+		// positions and UVs, 8888 colors, no flat-shading provoking offset. Read it with a
+		// tight loop instead of the per-component format dispatch in VertexReader - this
+		// is one of the hottest loops in 2D-heavy games.
+		if (provokeIndOffset == 0 && decVtxFormat.posfmt == DEC_FLOAT_3 &&
+			(decVtxFormat.uvfmt == DEC_FLOAT_2 || decVtxFormat.uvfmt == DEC_NONE) &&
+			(decVtxFormat.c0fmt == DEC_U8_4 || decVtxFormat.c0fmt == DEC_NONE)) {
+			const bool hasUV = decVtxFormat.uvfmt != DEC_NONE;
+			const bool hasColor = decVtxFormat.c0fmt != DEC_NONE;
+			const u32 materialAmbientRGBA = gstate.getMaterialAmbientRGBA();
+			const u8 *ptr = decoded;
+			for (int index = 0; index < maxIndex; index++, ptr += decVtxFormat.stride) {
+				TransformedVertex &vert = transformed[index];
+				const float *posdata = (const float *)(ptr + decVtxFormat.posoff);
+				vert.x = posdata[0];
+				vert.y = posdata[1];
+				// Integer value passed in a float. Clamped to 0, 65535 - same as ReadPos.
+				const float z = (float)(int)posdata[2] * (1.0f / 65535.0f);
+				vert.z = z > 1.0f ? 1.0f : (z < 0.0f ? 0.0f : z);
+				vert.color0_32 = hasColor ? *(const u32 *)(ptr + decVtxFormat.c0off) : materialAmbientRGBA;
+				if (hasUV) {
+					const float *uvdata = (const float *)(ptr + decVtxFormat.uvoff);
+					vert.u = uvdata[0] * uscale;
+					vert.v = uvdata[1] * vscale;
 				} else {
-					reader.ReadColor0_8888(vert.color0);
+					vert.u = 0.0f;
+					vert.v = 0.0f;
 				}
-			} else {
-				vert.color0_32 = gstate.getMaterialAmbientRGBA();
 			}
+		} else {
+			for (int index = 0; index < maxIndex; index++) {
+				// Do not touch the coordinates or the colors. No lighting.
+				reader.Goto(index);
+				// TODO: Write to a flexible buffer, we don't always need all four components.
+				TransformedVertex &vert = transformed[index];
+				reader.ReadPos(vert.pos);
+
+				if (reader.hasColor0()) {
+					if (provokeIndOffset != 0 && index + provokeIndOffset < maxIndex) {
+						reader.Goto(index + provokeIndOffset);
+						reader.ReadColor0_8888(vert.color0);
+						reader.Goto(index);
+					} else {
+						reader.ReadColor0_8888(vert.color0);
+					}
+				} else {
+					vert.color0_32 = gstate.getMaterialAmbientRGBA();
+				}
 
-			if (reader.hasUV()) {
-				reader.ReadUV(vert.uv);
+				if (reader.hasUV()) {
+					reader.ReadUV(vert.uv);
 
-				vert.u *= uscale;
-				vert.v *= vscale;
-			} else {
-				vert.u = 0.0f;
-				vert.v = 0.0f;
-			}
+					vert.u *= uscale;
+					vert.v *= vscale;
+				} else {
+					vert.u = 0.0f;
+					vert.v = 0.0f;
+				}
 
-			// Ignore color1 and fog, never used in throughmode anyway.
-			// The w of uv is also never used (hardcoded to 1.0.)
+				// Ignore color1 and fog, never used in throughmode anyway.
+				// The w of uv is also never used (hardcoded to 1.0.)
+			}
 		}
 	} else {
 		// Okay, need to actually perform the full transform.
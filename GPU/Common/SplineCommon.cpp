@@ -17,9 +17,13 @@
 
 #include <string.h>
 #include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 #include "profiler/profiler.h"
 
+#include "ext/xxhash.h"
+
 #include "Common/CPUDetect.h"
 
 #include "GPU/Common/GPUStateUtils.h"
@@ -90,6 +94,23 @@ void BuildIndex(u16 *indices, int &count, int num_u, int num_v, GEPatchPrimType
 class Bezier3DWeight {
 private:
 	void CalcWeights(float t, Weight &w) {
+#ifdef _M_SSE
+		const __m128 t4 = _mm_set_ps1(t);
+		const __m128 s4 = _mm_sub_ps(_mm_set_ps1(1.0f), t4); // s = 1 - t
+		const __m128 ss_tt = _mm_shuffle_ps(s4, t4, _MM_SHUFFLE(0, 0, 0, 0));   // s s t t
+		const __m128 sttt = _mm_move_ss(t4, s4);                                // s t t t
+		const __m128 ssst = _mm_shuffle_ps(s4, ss_tt, _MM_SHUFFLE(2, 1, 0, 0)); // s s s t
+
+		// Bernstein 3D basis polynomial { s^3, 3ts^2, 3t^2s, t^3 }
+		const __m128 c1_3_3_1 = { 1, 3, 3, 1 };
+		_mm_storeu_ps(w.basis, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(sttt, ss_tt), ssst), c1_3_3_1));
+
+		// Derivative via the quadratic basis: d/dt basis[i] = 3 * (quad[i-1] - quad[i])
+		const __m128 c1_2_1_0 = { 1, 2, 1, 0 };
+		const __m128 quad = _mm_mul_ps(_mm_mul_ps(ss_tt, sttt), c1_2_1_0); // s^2, 2ts, t^2, 0
+		const __m128 quadShifted = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(quad), 4)); // 0, s^2, 2ts, t^2
+		_mm_storeu_ps(w.deriv, _mm_mul_ps(_mm_sub_ps(quadShifted, quad), _mm_set_ps1(3.0f)));
+#else
 		// Bernstein 3D basis polynomial
 		w.basis[0] = (1 - t) * (1 - t) * (1 - t);
 		w.basis[1] = 3 * t * (1 - t) * (1 - t);
@@ -101,6 +122,7 @@ private:
 		w.deriv[1] = 9 * t * t - 12 * t + 3;
 		w.deriv[2] = 3 * (2 - 3 * t) * t;
 		w.deriv[3] = 3 * t * t;
+#endif
 	}
 public:
 	Weight *CalcWeightsAll(u32 key) {
@@ -430,14 +452,65 @@ public:
 	}
 };
 
+// Caches the vertex output of software tessellation. Spline-heavy games tend to
+// resubmit identical patches every frame, so re-running the full tessellation is
+// wasted work. Indices are deterministic from the surface parameters, so only the
+// vertices need to be stored. Simply dropped wholesale when it grows too large.
+static std::unordered_map<u64, std::vector<SimpleVertex>> tessCache;
+static size_t tessCacheBytes;
+
+#define TESS_CACHE_MAX_BYTES (8 * 1024 * 1024)
+
+template<class Surface>
+static u64 TessCacheKey(const Surface &surface, u32 origVertType, const ControlPoints &points) {
+	u64 hash = (u64)surface.tess_u | ((u64)surface.tess_v << 7) |
+		((u64)surface.type_u << 14) | ((u64)surface.type_v << 16) |
+		((u64)surface.num_points_u << 18) | ((u64)surface.num_points_v << 25) |
+		((u64)surface.primType << 32) | ((u64)surface.patchFacing << 34) |
+		((u64)(origVertType & (GE_VTYPE_NRM_MASK | GE_VTYPE_COL_MASK | GE_VTYPE_TC_MASK)) << 36);
+	// The Vec types have a SIMD padding lane with undefined contents, so hash the
+	// meaningful components only.
+	const int size = surface.num_points_u * surface.num_points_v;
+	for (int i = 0; i < size; ++i)
+		hash = XXH64(&points.pos[i], sizeof(float) * 3, hash);
+	if (origVertType & GE_VTYPE_TC_MASK) {
+		for (int i = 0; i < size; ++i)
+			hash = XXH64(&points.tex[i], sizeof(float) * 2, hash);
+	}
+	if (origVertType & GE_VTYPE_COL_MASK) {
+		for (int i = 0; i < size; ++i)
+			hash = XXH64(&points.col[i], sizeof(float) * 4, hash);
+	} else {
+		u32 defcolor = points.defcolor;
+		hash = XXH64(&defcolor, sizeof(defcolor), hash);
+	}
+	return hash;
+}
+
 template<class Surface>
 void SoftwareTessellation(OutputBuffers &output, const Surface &surface, u32 origVertType, const ControlPoints &points) {
+	const u64 cacheKey = TessCacheKey(surface, origVertType, points);
+	auto cached = tessCache.find(cacheKey);
+	if (cached != tessCache.end()) {
+		memcpy(output.vertices, cached->second.data(), cached->second.size() * sizeof(SimpleVertex));
+		surface.BuildIndex(output.indices, output.count);
+		return;
+	}
+
 	using WeightType = typename Surface::WeightType;
 	u32 key_u = WeightType::ToKey(surface.tess_u, surface.num_points_u, surface.type_u);
 	u32 key_v = WeightType::ToKey(surface.tess_v, surface.num_points_v, surface.type_v);
 	Weight2D weights(WeightType::weightsCache, key_u, key_v);
 
 	SubdivisionSurface<Surface>::Tessellate(output, surface, points, weights, origVertType);
+
+	const size_t vertexBytes = surface.GetVertexCount() * sizeof(SimpleVertex);
+	if (tessCacheBytes + vertexBytes > TESS_CACHE_MAX_BYTES) {
+		tessCache.clear();
+		tessCacheBytes = 0;
+	}
+	tessCache[cacheKey].assign(output.vertices, output.vertices + surface.GetVertexCount());
+	tessCacheBytes += vertexBytes;
 }
 
 template<class Surface>
@@ -486,6 +559,8 @@ using namespace Spline;
 void DrawEngineCommon::ClearSplineBezierWeights() {
 	Bezier3DWeight::weightsCache.Clear();
 	Spline3DWeight::weightsCache.Clear();
+	tessCache.clear();
+	tessCacheBytes = 0;
 }
 
 // Specialize to make instance (to avoid link error).
@@ -97,6 +97,8 @@ struct BezierSurface : public SurfaceInfo {
 		num_verts_per_patch = (tess_u + 1) * (tess_v + 1);
 	}
 
+	int GetVertexCount() const { return num_verts_per_patch * num_patches_u * num_patches_v; }
+
 	int GetTessStart(int patch) const { return 0; }
 
 	int GetPointIndex(int patch_u, int patch_v) const { return patch_v * 3 * num_points_u + patch_u * 3; }
@@ -135,6 +137,8 @@ struct SplineSurface : public SurfaceInfo {
 		num_vertices_u = num_patches_u * tess_u + 1;
 	}
 
+	int GetVertexCount() const { return num_vertices_u * (num_patches_v * tess_v + 1); }
+
 	int GetTessStart(int patch) const { return (patch == 0) ? 0 : 1; }
 
 	int GetPointIndex(int patch_u, int patch_v) const { return patch_v * num_points_u + patch_u; }
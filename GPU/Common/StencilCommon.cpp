@@ -49,3 +49,61 @@ u8 StencilBits8888(const u8 *ptr8, u32 numPixels) {
 
 	return bits >> 24;
 }
+
+static bool StencilConstant5551(const u8 *ptr8, u32 numPixels, u8 *value) {
+	const u32 *ptr = (const u32 *)ptr8;
+	const u32 expected = ptr[0] & 0x80008000;
+	// Both pixels of the first word must agree too.
+	if (expected != 0 && expected != 0x80008000) {
+		return false;
+	}
+	for (u32 i = 1; i < numPixels / 2; ++i) {
+		if ((ptr[i] & 0x80008000) != expected) {
+			return false;
+		}
+	}
+	*value = expected ? 0xFF : 0x00;
+	return true;
+}
+
+static bool StencilConstant4444(const u8 *ptr8, u32 numPixels, u8 *value) {
+	const u32 *ptr = (const u32 *)ptr8;
+	const u32 expected = ptr[0] & 0xF000F000;
+	if ((expected >> 16) != (expected & 0xFFFF)) {
+		return false;
+	}
+	for (u32 i = 1; i < numPixels / 2; ++i) {
+		if ((ptr[i] & 0xF000F000) != expected) {
+			return false;
+		}
+	}
+	const u8 nibble = (expected >> 12) & 0xF;
+	*value = (nibble << 4) | nibble;
+	return true;
+}
+
+static bool StencilConstant8888(const u8 *ptr8, u32 numPixels, u8 *value) {
+	const u32 *ptr = (const u32 *)ptr8;
+	const u32 expected = ptr[0] & 0xFF000000;
+	for (u32 i = 1; i < numPixels; ++i) {
+		if ((ptr[i] & 0xFF000000) != expected) {
+			return false;
+		}
+	}
+	*value = expected >> 24;
+	return true;
+}
+
+bool StencilConstantValue(const u8 *ptr8, GEBufferFormat format, u32 numPixels, u8 *value) {
+	switch (format) {
+	case GE_FORMAT_5551:
+		return StencilConstant5551(ptr8, numPixels, value);
+	case GE_FORMAT_4444:
+		return StencilConstant4444(ptr8, numPixels, value);
+	case GE_FORMAT_8888:
+		return StencilConstant8888(ptr8, numPixels, value);
+	default:
+		// 565 has no stencil to begin with.
+		return false;
+	}
+}
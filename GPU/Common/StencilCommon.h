@@ -1,7 +1,15 @@
 #pragma once
 
 #include "Common/CommonTypes.h"
+#include "GPU/ge_constants.h"
 
 u8 StencilBits8888(const u8 *ptr8, u32 numPixels);
 u8 StencilBits4444(const u8 *ptr8, u32 numPixels);
 u8 StencilBits5551(const u8 *ptr8, u32 numPixels);
+
+// Returns true if every pixel carries the same stencil value, with the 8-bit
+// stencil value in *value. Games commonly clear stencil with memset-style VRAM
+// writes, and the backends can handle those with a single clear instead of the
+// per-bit reconstruction loop. Bails on the first mismatch, so genuinely mixed
+// data costs little to reject.
+bool StencilConstantValue(const u8 *ptr8, GEBufferFormat format, u32 numPixels, u8 *value);
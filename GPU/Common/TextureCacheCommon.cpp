@@ -16,9 +16,12 @@
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
 #include <algorithm>
+#include <snappy-c.h>
+#include "base/timeutil.h"
 #include "profiler/profiler.h"
 #include "Common/ColorConv.h"
 #include "Common/MemoryUtil.h"
+#include "Common/ThreadPools.h"
 #include "Core/Config.h"
 #include "Core/Reporting.h"
 #include "Core/System.h"
@@ -57,6 +60,13 @@
 #define TEXCACHE_MIN_PRESSURE 16 * 1024 * 1024  // Total in VRAM
 #define TEXCACHE_SECOND_MIN_PRESSURE 4 * 1024 * 1024
 
+// Cold storage of decoded levels (compressed, host RAM.) Smaller levels are
+// cheap enough to just re-decode.
+#define TEXCACHE_COLD_MIN_SIZE (16 * 1024)
+#define TEXCACHE_COLD_MAX_SIZE (48 * 1024 * 1024)
+// If a cold level hasn't been restored for this many flips, drop it.
+#define TEXCACHE_COLD_KILL_AGE 1800
+
 // Just for reference
 
 // PSP Color formats:
@@ -87,6 +97,7 @@ TextureCacheCommon::TextureCacheCommon(Draw::DrawContext *draw)
 		clearCacheNextFrame_(false),
 		lowMemoryMode_(false),
 		texelsScaledThisFrame_(0),
+		texelsBuiltThisFrame_(0),
 		cacheSizeEstimate_(0),
 		secondCacheSizeEstimate_(0),
 		nextTexture_(nullptr),
@@ -207,9 +218,13 @@ void TextureCacheCommon::UpdateSamplingParams(TexCacheEntry &entry, SamplerCache
 	bool sClamp;
 	bool tClamp;
 	float lodBias;
-	int maxLevel = (entry.status & TexCacheEntry::STATUS_BAD_MIPS) ? 0 : entry.maxLevel;
+	int maxLevel = entry.MipLevels();
 	GETexLevelMode mode;
 	GetSamplingParams(minFilt, magFilt, sClamp, tClamp, lodBias, maxLevel, entry.addr, mode);
+	if (entry.status & TexCacheEntry::STATUS_AUTOGEN_MIPS) {
+		// The game supplied no mips, so it won't have asked for mip filtering either.
+		minFilt |= 6;
+	}
 	key.minFilt = minFilt & 1;
 	key.mipEnable = (minFilt >> 2) & 1;
 	key.mipFilt = (minFilt >> 1) & 1;
@@ -225,7 +240,7 @@ void TextureCacheCommon::UpdateSamplingParams(TexCacheEntry &entry, SamplerCache
 	} else {
 		switch (mode) {
 		case GE_TEXLEVEL_MODE_AUTO:
-			key.maxLevel = entry.maxLevel * 256;
+			key.maxLevel = maxLevel * 256;
 			key.minLevel = 0;
 			key.lodBias = (int)(lodBias * 256.0f);
 			if (gstate_c.Supports(GPU_SUPPORTS_ANISOTROPY) && g_Config.iAnisotropyLevel > 0) {
@@ -242,7 +257,7 @@ void TextureCacheCommon::UpdateSamplingParams(TexCacheEntry &entry, SamplerCache
 			// It's incorrect to use the slope as a bias. Instead it should be passed
 			// into the shader directly as an explicit lod level, with the bias on top. For now, we just kill the
 			// lodBias in this mode, working around #9772.
-			key.maxLevel = entry.maxLevel * 256;
+			key.maxLevel = maxLevel * 256;
 			key.minLevel = 0;
 			key.lodBias = 0;
 			break;
@@ -354,6 +369,13 @@ void TextureCacheCommon::SetTexture(bool force) {
 
 	u32 texhash = MiniHash((const u32 *)Memory::GetPointerUnchecked(texaddr));
 
+	// One video lookup up front - used both for the FMV fast path below and
+	// to stamp rebuilt entries with the current upload generation.
+	const auto videoIter = videos_.find(texaddr & 0x3FFFFFFF);
+	const bool isVideoAddr = videoIter != videos_.end();
+	const u32 videoGen = isVideoAddr ? videoIter->second.generation : 0;
+	bool videoRebuild = false;
+
 	TexCache::iterator iter = cache_.find(cachekey);
 	TexCacheEntry *entry = nullptr;
 
@@ -433,6 +455,23 @@ void TextureCacheCommon::SetTexture(bool force) {
 			}
 		}
 
+		// FMV fast path. The video decoder notifies us of every frame upload
+		// (NotifyVideoUpload), so for these addresses the upload generation
+		// says exactly whether the pixels changed - hashing them is pure
+		// waste. A new frame forces a rebuild without rehashing; no new frame
+		// means the entry is current and the scheduled rehash can be skipped
+		// too. The MiniHash check above still acts as a safety net in case
+		// the buffer gets reused without a notification.
+		if (isVideoAddr) {
+			if (entry->vidGeneration != videoGen) {
+				match = false;
+				reason = "video upload";
+				videoRebuild = true;
+			} else {
+				rehash = false;
+			}
+		}
+
 		if (match && (entry->status & TexCacheEntry::STATUS_TO_SCALE) && standardScaleFactor_ != 1 && texelsScaledThisFrame_ < TEXCACHE_MAX_TEXELS_SCALED) {
 			if ((entry->status & TexCacheEntry::STATUS_CHANGE_FREQUENT) == 0) {
 				// INFO_LOG(G3D, "Reloading texture to do the scaling we skipped..");
@@ -441,6 +480,15 @@ void TextureCacheCommon::SetTexture(bool force) {
 			}
 		}
 
+		if (match && (entry->status & TexCacheEntry::STATUS_TO_REPLACE) != 0) {
+			// The background decode may have finished - if so, rebuild to swap the replacement in.
+			ReplacedTexture &replaced = replacer_.FindReplacement(entry->CacheKey(), entry->fullhash, w, h);
+			if (replaced.Valid()) {
+				match = false;
+				reason = "replacing";
+			}
+		}
+
 		if (match) {
 			// TODO: Mark the entry reliable if it's been safe for long enough?
 			//got one!
@@ -457,7 +505,8 @@ void TextureCacheCommon::SetTexture(bool force) {
 			nextNeedsRehash_ = rehash;
 			nextNeedsChange_ = false;
 			// Might need a rebuild if the hash fails, but that will be set later.
-			nextNeedsRebuild_ = false;
+			// If the build got deferred to stay within the frame budget, finish it now.
+			nextNeedsRebuild_ = (entry->status & TexCacheEntry::STATUS_PENDING_BUILD) != 0;
 			VERBOSE_LOG(G3D, "Texture at %08x Found in Cache, applying", texaddr);
 			return; //Done!
 		} else {
@@ -515,6 +564,7 @@ void TextureCacheCommon::SetTexture(bool force) {
 	entry->bufw = bufw;
 
 	entry->cluthash = cluthash;
+	entry->vidGeneration = videoGen;
 
 	gstate_c.curTextureWidth = w;
 	gstate_c.curTextureHeight = h;
@@ -533,7 +583,9 @@ void TextureCacheCommon::SetTexture(bool force) {
 	}
 
 	nextTexture_ = entry;
-	nextNeedsRehash_ = entry->framebuffer == nullptr;
+	// Video rebuilds skip the full hash - the upload generation already told
+	// us the content changed, and nothing will hash-check these entries.
+	nextNeedsRehash_ = entry->framebuffer == nullptr && !videoRebuild;
 	// We still need to rebuild, to allocate a texture.  But we'll bail early.
 	nextNeedsRebuild_ = true;
 }
@@ -546,6 +598,13 @@ void TextureCacheCommon::Decimate(bool forcePressure) {
 		return;
 	}
 
+	// Publish our occupancy to the shared budget, and pick up combined pressure.
+	// If the framebuffers and we together are over budget and we're above our
+	// floor, decimate even if we'd be comfortable on our own.
+	gpuMemoryBudget.textureBytes = (u64)cacheSizeEstimate_ + secondCacheSizeEstimate_;
+	if (gpuMemoryBudget.TexturePressure())
+		forcePressure = true;
+
 	if (forcePressure || cacheSizeEstimate_ >= TEXCACHE_MIN_PRESSURE) {
 		const u32 had = cacheSizeEstimate_;
 
@@ -582,13 +641,18 @@ void TextureCacheCommon::Decimate(bool forcePressure) {
 		VERBOSE_LOG(G3D, "Decimated second texture cache, saved %d estimated bytes - now %d bytes", had - secondCacheSizeEstimate_, secondCacheSizeEstimate_);
 	}
 
+	gpuMemoryBudget.textureBytes = (u64)cacheSizeEstimate_ + secondCacheSizeEstimate_;
+	gpuStats.textureCacheBytes = gpuMemoryBudget.textureBytes;
+	gpuStats.gpuMemoryBudgetBytes = gpuMemoryBudget.budgetBytes;
+
+	DecimateColdCache();
 	DecimateVideos();
 }
 
 void TextureCacheCommon::DecimateVideos() {
 	if (!videos_.empty()) {
 		for (auto iter = videos_.begin(); iter != videos_.end(); ) {
-			if (iter->second + VIDEO_DECIMATE_AGE < gpuStats.numFlips) {
+			if (iter->second.lastFlip + VIDEO_DECIMATE_AGE < gpuStats.numFlips) {
 				videos_.erase(iter++);
 			} else {
 				++iter;
@@ -977,12 +1041,16 @@ void TextureCacheCommon::NotifyConfigChanged() {
 
 void TextureCacheCommon::NotifyVideoUpload(u32 addr, int size, int width, GEBufferFormat fmt) {
 	addr &= 0x3FFFFFFF;
-	videos_[addr] = gpuStats.numFlips;
+	VideoInfo &info = videos_[addr];
+	info.lastFlip = gpuStats.numFlips;
+	info.generation = ++videoGeneration_;
 }
 
 void TextureCacheCommon::LoadClut(u32 clutAddr, u32 loadBytes) {
 	clutTotalBytes_ = loadBytes;
+	clutLoadAddr_ = clutAddr;
 	clutRenderAddress_ = 0xFFFFFFFF;
+	clutRenderPending_ = false;
 
 	if (Memory::IsValidAddress(clutAddr)) {
 		if (Memory::IsVRAMAddress(clutAddr)) {
@@ -1017,7 +1085,14 @@ void TextureCacheCommon::LoadClut(u32 clutAddr, u32 loadBytes) {
 		// It's possible for a game to (successfully) access outside valid memory.
 		u32 bytes = Memory::ValidSize(clutAddr, loadBytes);
 		if (clutRenderAddress_ != 0xFFFFFFFF && !g_Config.bDisableSlowFramebufEffects) {
-			framebufferManager_->DownloadFramebufferForClut(clutRenderAddress_, clutRenderOffset_ + bytes);
+			if (supportsReadbackFreeClut_) {
+				// Leave the palette on the GPU - the depal path copies it straight out of
+				// the framebuffer. If the CPU turns out to need the bytes after all,
+				// EnsureClutReadback() does the download then.
+				clutRenderPending_ = true;
+			} else {
+				framebufferManager_->DownloadFramebufferForClut(clutRenderAddress_, clutRenderOffset_ + bytes);
+			}
 			Memory::MemcpyUnchecked(clutBufRaw_, clutAddr, bytes);
 			if (bytes < loadBytes) {
 				memset((u8 *)clutBufRaw_ + bytes, 0x00, loadBytes - bytes);
@@ -1072,6 +1147,71 @@ void TextureCacheCommon::LoadClut(u32 clutAddr, u32 loadBytes) {
 	clutMaxBytes_ = std::max(clutMaxBytes_, loadBytes);
 }
 
+void TextureCacheCommon::EnsureClutReadback() {
+	if (!clutRenderPending_)
+		return;
+	clutRenderPending_ = false;
+	if (clutRenderAddress_ == 0xFFFFFFFF)
+		return;
+
+	u32 bytes = Memory::ValidSize(clutLoadAddr_, clutTotalBytes_);
+	framebufferManager_->DownloadFramebufferForClut(clutRenderAddress_, clutRenderOffset_ + bytes);
+	Memory::MemcpyUnchecked(clutBufRaw_, clutLoadAddr_, bytes);
+	// Redo the conversion and hash now that the real palette bytes are in place.
+	UpdateCurrentClut(gstate.getClutPaletteFormat(), gstate.getClutIndexStartPos(), gstate.isClutIndexSimple());
+}
+
+Draw::Framebuffer *TextureCacheCommon::GetDynamicClutFbo(GEPaletteFormat clutFormat) {
+	if (!clutRenderPending_ || clutRenderAddress_ == 0xFFFFFFFF)
+		return nullptr;
+
+	VirtualFramebuffer *vfb = nullptr;
+	for (size_t i = 0, n = fbCache_.size(); i < n; ++i) {
+		if (fbCache_[i]->fb_address == clutRenderAddress_) {
+			vfb = fbCache_[i];
+			break;
+		}
+	}
+	if (!vfb || !vfb->fbo)
+		return nullptr;
+
+	// The raw palette bits only mean the same thing when the CLUT format matches what
+	// the game rendered. Mismatches (bit reinterpretation tricks) go through the readback.
+	bool formatMatch;
+	switch (clutFormat) {
+	case GE_CMODE_16BIT_BGR5650: formatMatch = vfb->drawnFormat == GE_FORMAT_565; break;
+	case GE_CMODE_16BIT_ABGR5551: formatMatch = vfb->drawnFormat == GE_FORMAT_5551; break;
+	case GE_CMODE_16BIT_ABGR4444: formatMatch = vfb->drawnFormat == GE_FORMAT_4444; break;
+	case GE_CMODE_32BIT_ABGR8888: formatMatch = vfb->drawnFormat == GE_FORMAT_8888; break;
+	default: formatMatch = false; break;
+	}
+	if (!formatMatch)
+		return nullptr;
+
+	const u32 bpp = vfb->drawnFormat == GE_FORMAT_8888 ? 4 : 2;
+	const u32 pixels = clutTotalBytes_ / bpp;
+	const u32 x = (clutRenderOffset_ / bpp) % vfb->fb_stride;
+	const u32 y = (clutRenderOffset_ / bpp) / vfb->fb_stride;
+	// Palettes that wrap around the stride would need a gather, not a blit.
+	if (x + pixels > (u32)vfb->fb_stride)
+		return nullptr;
+
+	// Match the layout the depal shaders expect from GetClutTexture.
+	const u32 clutWidth = clutFormat == GE_CMODE_32BIT_ABGR8888 ? 256 : 512;
+	Draw::Framebuffer *fbo = framebufferManager_->GetTempFBO(TempFBO::CLUT, clutWidth, 1, Draw::FBO_8888);
+	if (!fbo)
+		return nullptr;
+
+	const int scaleX = vfb->renderWidth / vfb->width;
+	const int scaleY = vfb->renderHeight / vfb->height;
+	if (!draw_->BlitFramebuffer(vfb->fbo, x * scaleX, y * scaleY, (x + pixels) * scaleX, (y + 1) * scaleY,
+		fbo, 0, 0, pixels, 1, Draw::FB_COLOR_BIT, Draw::FB_BLIT_NEAREST))
+		return nullptr;
+
+	vfb->last_frame_clut = gpuStats.numFlips;
+	return fbo;
+}
+
 void TextureCacheCommon::UnswizzleFromMem(u32 *dest, u32 destPitch, const u8 *texptr, u32 bufw, u32 height, u32 bytesPerPixel) {
 	// Note: bufw is always aligned to 16 bytes, so rowWidth is always >= 16.
 	const u32 rowWidth = (bytesPerPixel > 0) ? (bufw * bytesPerPixel) : (bufw / 2);
@@ -1089,10 +1229,21 @@ void TextureCacheCommon::UnswizzleFromMem(u32 *dest, u32 destPitch, const u8 *te
 	// The height is not always aligned to 8, but rounds up.
 	int byc = (height + 7) / 8;
 
-	DoUnswizzleTex16(texptr, dest, bxc, byc, destPitch);
+	// Each 8-row strip of blocks is independent, so for large textures we split the
+	// strips across the thread pool. First uploads of multi-megabyte textures are
+	// otherwise a noticeable hitch, especially on slow ARM cores.
+	if (rowWidth * height >= 256 * 1024 && byc >= 8) {
+		const u32 destPitchBy32 = destPitch / sizeof(u32);
+		GlobalThreadPool::Loop([&](int low, int high) {
+			DoUnswizzleTex16(texptr + (u32)low * rowWidth * 8, dest + (u32)low * destPitchBy32 * 8, bxc, high - low, destPitch);
+		}, 0, byc);
+	} else {
+		DoUnswizzleTex16(texptr, dest, bxc, byc, destPitch);
+	}
 }
 
 bool TextureCacheCommon::GetCurrentClutBuffer(GPUDebugBuffer &buffer) {
+	EnsureClutReadback();
 	const u32 bpp = gstate.getClutPaletteFormat() == GE_CMODE_32BIT_ABGR8888 ? 4 : 2;
 	const u32 pixels = 1024 / bpp;
 
@@ -1182,6 +1333,12 @@ static inline void ConvertFormatToRGBA8888(GEPaletteFormat format, u32 *dst, con
 }
 
 void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureFormat format, GEPaletteFormat clutformat, uint32_t texaddr, int level, int bufw, bool reverseColors, bool useBGRA, bool expandTo32bit) {
+	// The error paths below bail without accounting their time - they're rare enough not to matter.
+	double decodeStart = 0.0;
+	if (coreCollectDebugStats) {
+		decodeStart = time_now_d();
+	}
+
 	bool swizzled = gstate.isTextureSwizzled();
 	if ((texaddr & 0x00600000) != 0 && Memory::IsVRAMAddress(texaddr)) {
 		// This means it's in a mirror, possibly a swizzled mirror.  Let's report.
@@ -1197,6 +1354,40 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 	int h = gstate.getTextureHeight(level);
 	const u8 *texptr = Memory::GetPointer(texaddr);
 
+	// CPU decode of an indexed texture - if the palette was rendered and its readback
+	// got deferred, we need the real bytes now.
+	if (format >= GE_TFMT_CLUT4 && format <= GE_TFMT_CLUT32)
+		EnsureClutReadback();
+
+	// Cold cache: if we've decoded exactly these bytes with these parameters
+	// before, restoring the compressed copy is much cheaper than another
+	// deindex/unswizzle/DXT decode. Keyed on a hash of the source bytes (and
+	// CLUT) plus everything that affects the output layout.
+	u64 coldKey = 0;
+	if (g_Config.bTextureColdCache && !lowMemoryMode_ && (u32)(outPitch * h) >= TEXCACHE_COLD_MIN_SIZE && texptr) {
+		u32 sizeInRAM = Memory::ValidSize(texaddr, (textureBitsPerPixel[format] * bufw * h) / 8);
+		if (sizeInRAM != 0) {
+			coldKey = ((u64)StableQuickTexHash(texptr, sizeInRAM) << 32) | sizeInRAM;
+			if (format >= GE_TFMT_CLUT4 && format <= GE_TFMT_CLUT32)
+				coldKey ^= (u64)clutHash_ * 0x9E3779B97F4A7C15ULL;
+			u64 params = texaddr;
+			params = params * 31 + format;
+			params = params * 31 + clutformat;
+			params = params * 31 + level;
+			params = params * 31 + bufw;
+			params = params * 31 + ((swizzled ? 1 : 0) | (reverseColors ? 2 : 0) | (useBGRA ? 4 : 0) | (expandTo32bit ? 8 : 0) | (gstate.isClutSharedForMipmaps() ? 16 : 0));
+			coldKey ^= params * 0xC2B2AE3D27D4EB4FULL;
+			if (coldKey == 0)
+				coldKey = 1;
+			if (RestoreFromColdCache(coldKey, out, outPitch, h)) {
+				if (coreCollectDebugStats) {
+					gpuStats.msTextureDecode += time_now_d() - decodeStart;
+				}
+				return;
+			}
+		}
+	}
+
 	switch (format) {
 	case GE_TFMT_CLUT4:
 	{
@@ -1420,6 +1611,79 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 		ERROR_LOG_REPORT(G3D, "Unknown Texture Format %d!!!", format);
 		break;
 	}
+
+	if (coldKey != 0)
+		InsertIntoColdCache(coldKey, out, outPitch, h);
+
+	if (coreCollectDebugStats) {
+		gpuStats.msTextureDecode += time_now_d() - decodeStart;
+	}
+}
+
+bool TextureCacheCommon::RestoreFromColdCache(u64 key, u8 *out, int outPitch, int h) {
+	auto it = coldCache_.find(key);
+	if (it == coldCache_.end())
+		return false;
+	ColdTexLevel &cold = it->second;
+	// The same source can be decoded at different pitches by different callers.
+	if (cold.pitch != outPitch || cold.h != h)
+		return false;
+	size_t size = cold.uncompressedSize;
+	if (snappy_uncompress((const char *)cold.compressed.data(), cold.compressed.size(), (char *)out, &size) != SNAPPY_OK) {
+		coldCacheSizeEstimate_ -= (u32)cold.compressed.size();
+		coldCache_.erase(it);
+		return false;
+	}
+	cold.lastFlip = gpuStats.numFlips;
+	return true;
+}
+
+void TextureCacheCommon::InsertIntoColdCache(u64 key, const u8 *data, int outPitch, int h) {
+	const u32 size = outPitch * h;
+	ColdTexLevel &cold = coldCache_[key];
+	if (!cold.compressed.empty())
+		coldCacheSizeEstimate_ -= (u32)cold.compressed.size();
+	size_t compressedSize = snappy_max_compressed_length(size);
+	cold.compressed.resize(compressedSize);
+	snappy_compress((const char *)data, size, (char *)cold.compressed.data(), &compressedSize);
+	cold.compressed.resize(compressedSize);
+	cold.compressed.shrink_to_fit();
+	cold.uncompressedSize = size;
+	cold.pitch = outPitch;
+	cold.h = h;
+	cold.lastFlip = gpuStats.numFlips;
+	coldCacheSizeEstimate_ += (u32)compressedSize;
+
+	// Over budget? Evict the least recently restored until we fit. The pool
+	// rarely goes over by more than one entry per insert.
+	while (coldCacheSizeEstimate_ > TEXCACHE_COLD_MAX_SIZE && coldCache_.size() > 1) {
+		auto oldest = coldCache_.end();
+		for (auto i = coldCache_.begin(); i != coldCache_.end(); ++i) {
+			if (i->first != key && (oldest == coldCache_.end() || i->second.lastFlip < oldest->second.lastFlip))
+				oldest = i;
+		}
+		if (oldest == coldCache_.end())
+			break;
+		coldCacheSizeEstimate_ -= (u32)oldest->second.compressed.size();
+		coldCache_.erase(oldest);
+	}
+}
+
+void TextureCacheCommon::DecimateColdCache() {
+	// In low memory mode (or if turned off), give the whole pool back.
+	if (lowMemoryMode_ || !g_Config.bTextureColdCache) {
+		coldCache_.clear();
+		coldCacheSizeEstimate_ = 0;
+		return;
+	}
+	for (auto iter = coldCache_.begin(); iter != coldCache_.end(); ) {
+		if (iter->second.lastFlip + TEXCACHE_COLD_KILL_AGE < gpuStats.numFlips) {
+			coldCacheSizeEstimate_ -= (u32)iter->second.compressed.size();
+			coldCache_.erase(iter++);
+		} else {
+			++iter;
+		}
+	}
 }
 
 void TextureCacheCommon::ReadIndexedTex(u8 *out, int outPitch, int level, const u8 *texptr, int bytesPerIndex, int bufw, bool expandTo32Bit) {
@@ -1501,6 +1765,7 @@ void TextureCacheCommon::ReadIndexedTex(u8 *out, int outPitch, int level, const
 }
 
 void TextureCacheCommon::ApplyTexture() {
+	PROFILE_THIS_SCOPE("applytex");
 	TexCacheEntry *entry = nextTexture_;
 	if (entry == nullptr) {
 		return;
@@ -1550,7 +1815,21 @@ void TextureCacheCommon::ApplyTexture() {
 	// Okay, now actually rebuild the texture if needed.
 	if (nextNeedsRebuild_) {
 		_assert_(!entry->texturePtr);
+		const int texels = gstate.getTextureWidth(0) * gstate.getTextureHeight(0);
+		const bool neverBuilt = entry->numFrames == 0 || (entry->status & TexCacheEntry::STATUS_PENDING_BUILD) != 0;
+		if (g_Config.bDeferTextureLoads && neverBuilt && !entry->framebuffer && texelsBuiltThisFrame_ >= TEXCACHE_MAX_TEXELS_BUILT) {
+			// Over this frame's build budget. Leave the entry pending and draw this one
+			// untextured - it gets built within the budget on a later frame. A frame or
+			// two of staleness in exchange for spreading streaming spikes across frames.
+			entry->status |= TexCacheEntry::STATUS_PENDING_BUILD;
+			entry->lastFrame = gpuStats.numFlips;
+			gstate_c.SetTextureFullAlpha(false);
+			Unbind();
+			return;
+		}
+		entry->status &= ~TexCacheEntry::STATUS_PENDING_BUILD;
 		BuildTexture(entry);
+		texelsBuiltThisFrame_ += texels;
 	}
 
 	entry->lastFrame = gpuStats.numFlips;
@@ -1579,7 +1858,10 @@ void TextureCacheCommon::Clear(bool delete_them) {
 		secondCacheSizeEstimate_ = 0;
 	}
 	fbTexInfo_.clear();
+	slabHashes_.clear();
 	videos_.clear();
+	coldCache_.clear();
+	coldCacheSizeEstimate_ = 0;
 }
 
 void TextureCacheCommon::DeleteTexture(TexCache::iterator it) {
@@ -1588,10 +1870,47 @@ void TextureCacheCommon::DeleteTexture(TexCache::iterator it) {
 	if (fbInfo != fbTexInfo_.end()) {
 		fbTexInfo_.erase(fbInfo);
 	}
+	auto slabInfo = slabHashes_.find(it->first);
+	if (slabInfo != slabHashes_.end()) {
+		slabHashes_.erase(slabInfo);
+	}
 	cacheSizeEstimate_ -= EstimateTexMemoryUsage(it->second.get());
 	cache_.erase(it);
 }
 
+// Hashes a texture one 4K slab at a time, caching the per-slab hashes so that when an
+// explicit invalidate told us exactly which bytes changed, only the touched slabs need
+// rehashing. Dynamic textures (scoreboards, video overlays) get a small invalidate every
+// frame but were paying a full rehash on every use.
+u32 TextureCacheCommon::SlabTexHash(TexCacheEntry *entry, const u8 *p, u32 sizeInRAM) {
+	std::vector<u32> &slabs = slabHashes_[entry->CacheKey()];
+	const u32 numSlabs = (sizeInRAM + TEXCACHE_HASH_SLAB_SIZE - 1) / TEXCACHE_HASH_SLAB_SIZE;
+
+	u32 firstSlab = 0;
+	u32 endSlab = numSlabs;
+	if (slabs.size() == numSlabs && entry->dirtyMax > entry->dirtyMin) {
+		// We know exactly what got written since the last rehash.
+		firstSlab = entry->dirtyMin / TEXCACHE_HASH_SLAB_SIZE;
+		endSlab = std::min(numSlabs, (entry->dirtyMax + TEXCACHE_HASH_SLAB_SIZE - 1) / TEXCACHE_HASH_SLAB_SIZE);
+	} else {
+		// First time, or the hashed size changed - refresh every slab.
+		slabs.resize(numSlabs);
+	}
+	for (u32 i = firstSlab; i < endSlab; i++) {
+		const u32 offset = i * TEXCACHE_HASH_SLAB_SIZE;
+		slabs[i] = DoQuickTexHash(p + offset, std::min((u32)TEXCACHE_HASH_SLAB_SIZE, sizeInRAM - offset));
+	}
+	entry->dirtyMin = 0;
+	entry->dirtyMax = 0;
+
+	// Combine, mixing in the position so identical slabs don't cancel out.
+	u32 fullhash = 0;
+	for (u32 i = 0; i < numSlabs; i++) {
+		fullhash = ((fullhash << 13) | (fullhash >> 19)) ^ slabs[i];
+	}
+	return fullhash;
+}
+
 bool TextureCacheCommon::CheckFullHash(TexCacheEntry *entry, bool &doDelete) {
 	int w = gstate.getTextureWidth(0);
 	int h = gstate.getTextureHeight(0);
@@ -1701,6 +2020,16 @@ void TextureCacheCommon::Invalidate(u32 addr, int size, GPUInvalidationType type
 		u32 texEnd = iter->second->addr + iter->second->sizeInRAM;
 
 		if (texAddr < addr_end && addr < texEnd) {
+			// Remember which part of the texture got touched, for slab rehashing.
+			const u32 dirtyMin = std::max(texAddr, addr) - texAddr;
+			const u32 dirtyMax = std::min(texEnd, addr_end) - texAddr;
+			if (iter->second->dirtyMax <= iter->second->dirtyMin) {
+				iter->second->dirtyMin = dirtyMin;
+				iter->second->dirtyMax = dirtyMax;
+			} else {
+				iter->second->dirtyMin = std::min(iter->second->dirtyMin, dirtyMin);
+				iter->second->dirtyMax = std::max(iter->second->dirtyMax, dirtyMax);
+			}
 			if (iter->second->GetHashStatus() == TexCacheEntry::STATUS_RELIABLE) {
 				iter->second->SetHashStatus(TexCacheEntry::STATUS_HASHING);
 			}
@@ -48,10 +48,17 @@ enum FramebufferNotification {
 
 #define TEXCACHE_MAX_TEXELS_SCALED (256*256)  // Per frame
 
+// Per frame, when DeferTextureLoads is on. Builds past this are pushed to a later frame.
+#define TEXCACHE_MAX_TEXELS_BUILT (512*512)
+
+// Granularity of cached per-slab hashes, used to rehash only invalidated parts of a texture.
+#define TEXCACHE_HASH_SLAB_SIZE 4096
+
 struct VirtualFramebuffer;
 
 namespace Draw {
 class DrawContext;
+class Framebuffer;
 }
 
 // Used by D3D11 and Vulkan, could be used by modern GL
@@ -119,6 +126,12 @@ struct TexCacheEntry {
 		STATUS_FREE_CHANGE = 0x200,    // Allow one change before marking "frequent".
 
 		STATUS_BAD_MIPS = 0x400,       // Has bad or unusable mipmap levels.
+
+		STATUS_PENDING_BUILD = 0x800,  // Build deferred to a later frame (over the per-frame budget.)
+
+		STATUS_TO_REPLACE = 0x1000,    // Replacement decode pending on the background loader.
+
+		STATUS_AUTOGEN_MIPS = 0x2000,  // Mips generated on the GPU from level 0 (survive rehash-only rebuilds.)
 	};
 
 	// Status, but int so we can zero initialize.
@@ -140,12 +153,17 @@ struct TexCacheEntry {
 	void *textureView;  // Used by D3D11 only for the shader resource view.
 #endif
 	int invalidHint;
+	// Range relative to addr that invalidates have touched since the last rehash. Empty when max <= min.
+	u32 dirtyMin;
+	u32 dirtyMax;
 	int lastFrame;
 	int numFrames;
 	int numInvalidated;
 	u32 framesUntilNextFullHash;
 	u32 fullhash;
 	u32 cluthash;
+	// The video upload generation this entry was last built from (see videos_.)
+	u32 vidGeneration;
 	u16 maxSeenV;
 
 	TexStatus GetHashStatus() {
@@ -167,6 +185,19 @@ struct TexCacheEntry {
 		}
 	}
 
+	// Mip levels actually present on the GPU texture - differs from maxLevel
+	// when the chain was autogenerated or the game's levels were unusable.
+	int MipLevels() const {
+		if (status & STATUS_AUTOGEN_MIPS) {
+			int wExp = dim & 0xF;
+			int hExp = (dim >> 8) & 0xF;
+			return wExp < hExp ? wExp : hExp;
+		}
+		if (status & STATUS_BAD_MIPS)
+			return 0;
+		return maxLevel;
+	}
+
 	bool Matches(u16 dim2, u8 format2, u8 maxLevel2) const;
 	u64 CacheKey() const;
 	static u64 CacheKey(u32 addr, u8 format, u16 dim, u32 cluthash);
@@ -235,6 +266,9 @@ protected:
 	};
 
 	void DecodeTextureLevel(u8 *out, int outPitch, GETextureFormat format, GEPaletteFormat clutformat, uint32_t texaddr, int level, int bufw, bool reverseColors, bool useBGRA, bool expandTo32Bit);
+	bool RestoreFromColdCache(u64 key, u8 *out, int outPitch, int h);
+	void InsertIntoColdCache(u64 key, const u8 *data, int outPitch, int h);
+	void DecimateColdCache();
 	void UnswizzleFromMem(u32 *dest, u32 destPitch, const u8 *texptr, u32 bufw, u32 height, u32 bytesPerPixel);
 	void ReadIndexedTex(u8 *out, int outPitch, int level, const u8 *texptr, int bytesPerIndex, int bufw, bool expandTo32Bit);
 
@@ -255,9 +289,18 @@ protected:
 
 	void SetTextureFramebuffer(TexCacheEntry *entry, VirtualFramebuffer *framebuffer);
 
+	// For CLUTs rendered into a framebuffer. When the backend keeps the palette on the
+	// GPU (supportsReadbackFreeClut_), LoadClut defers the readback; the depal path gets
+	// the palette via GetDynamicClutFbo, and anything that needs the bytes on the CPU
+	// after all must call EnsureClutReadback first.
+	void EnsureClutReadback();
+	Draw::Framebuffer *GetDynamicClutFbo(GEPaletteFormat clutFormat);
+
 	void DecimateVideos();
 
-	inline u32 QuickTexHash(TextureReplacer &replacer, u32 addr, int bufw, int w, int h, GETextureFormat format, TexCacheEntry *entry) const {
+	u32 SlabTexHash(TexCacheEntry *entry, const u8 *p, u32 sizeInRAM);
+
+	inline u32 QuickTexHash(TextureReplacer &replacer, u32 addr, int bufw, int w, int h, GETextureFormat format, TexCacheEntry *entry) {
 		if (replacer.Enabled()) {
 			return replacer.ComputeHash(addr, bufw, w, h, format, entry->maxSeenV);
 		}
@@ -270,6 +313,11 @@ protected:
 		const u32 *checkp = (const u32 *)Memory::GetPointer(addr);
 
 		if (Memory::IsValidAddress(addr + sizeInRAM)) {
+			// Once a texture has seen an explicit invalidate, hash it slab by slab so
+			// that later partial invalidates only need to rehash the touched slabs.
+			if (entry->dirtyMax > entry->dirtyMin || slabHashes_.find(entry->CacheKey()) != slabHashes_.end()) {
+				return SlabTexHash(entry, (const u8 *)checkp, sizeInRAM);
+			}
 			return DoQuickTexHash(checkp, sizeInRAM);
 		} else {
 			return 0;
@@ -289,6 +337,7 @@ protected:
 
 	int decimationCounter_;
 	int texelsScaledThisFrame_;
+	int texelsBuiltThisFrame_;
 	int timesInvalidatedAllThisFrame_;
 
 	TexCache cache_;
@@ -297,10 +346,35 @@ protected:
 	TexCache secondCache_;
 	u32 secondCacheSizeEstimate_;
 
+	// Cold storage: decoded levels we've already paid for once, kept
+	// snappy-compressed in host RAM. On a cache miss whose source bytes and
+	// decode parameters match, DecodeTextureLevel restores from here instead
+	// of re-running the deindex/unswizzle/DXT work. Bounded, LRU-trimmed.
+	struct ColdTexLevel {
+		std::vector<u8> compressed;
+		u32 uncompressedSize;
+		int pitch;
+		int h;
+		int lastFlip;
+	};
+	std::map<u64, ColdTexLevel> coldCache_;
+	u32 coldCacheSizeEstimate_ = 0;
+
 	std::vector<VirtualFramebuffer *> fbCache_;
 	std::map<u64, AttachedFramebufferInfo> fbTexInfo_;
 
-	std::map<u32, int> videos_;
+	// Cached per-slab hashes, also kept separate from the main cache entries.
+	std::map<u64, std::vector<u32>> slabHashes_;
+
+	// Video upload targets, notified by the video decoder (NotifyVideoUpload.)
+	// The generation bumps on every upload, so the FMV fast path in SetTexture
+	// can tell "new frame" from "same frame" without hashing the pixels.
+	struct VideoInfo {
+		int lastFlip;
+		u32 generation;
+	};
+	std::map<u32, VideoInfo> videos_;
+	u32 videoGeneration_ = 0;
 
 	SimpleBuf<u32> tmpTexBuf32_;
 	SimpleBuf<u16> tmpTexBuf16_;
@@ -320,6 +394,11 @@ protected:
 	u32 clutMaxBytes_;
 	u32 clutRenderAddress_;
 	u32 clutRenderOffset_;
+	u32 clutLoadAddr_ = 0;
+	// Set when LoadClut skipped the readback of a rendered CLUT, cleared once read back.
+	bool clutRenderPending_ = false;
+	// Backends that consume GetDynamicClutFbo in their depal path set this.
+	bool supportsReadbackFreeClut_ = false;
 	// True if the clut is just alpha values in the same order (RGBA4444-bit only.)
 	bool clutAlphaLinear_;
 	u16 clutAlphaLinearColor_;
@@ -29,6 +29,9 @@
 
 #ifdef _M_SSE
 #include <emmintrin.h>
+#if _M_SSE >= 0x301
+#include <tmmintrin.h>
+#endif
 #if _M_SSE >= 0x401
 #include <smmintrin.h>
 #endif
@@ -415,7 +418,35 @@ void DXTDecoder::DecodeAlphaDXT5(const DXT5Block *src) {
 	}
 }
 
+#if _M_SSE >= 0x301
+// Expands a row of four 2-bit color indices into byte offsets into the 16-byte color table.
+static inline __m128i DXTColorSelSSSE3(u32 colordata) {
+	return _mm_set_epi32(
+		((colordata >> 6) & 3) * 0x04040404 + 0x03020100,
+		((colordata >> 4) & 3) * 0x04040404 + 0x03020100,
+		((colordata >> 2) & 3) * 0x04040404 + 0x03020100,
+		((colordata >> 0) & 3) * 0x04040404 + 0x03020100);
+}
+#endif
+
 void DXTDecoder::WriteColorsDXT1(u32 *dst, const DXT1Block *src, int pitch, int height) {
+#if _M_SSE >= 0x301
+	if (cpu_info.bSSSE3) {
+		// The color table is exactly 16 bytes, so each row is a single shuffle and store.
+		const __m128i table = _mm_loadu_si128((const __m128i *)colors_);
+		for (int y = 0; y < height; y++) {
+			__m128i row = _mm_shuffle_epi8(table, DXTColorSelSSSE3(src->lines[y]));
+			_mm_storeu_si128((__m128i *)dst, row);
+			dst += pitch;
+		}
+		return;
+	}
+#elif PPSSPP_ARCH(ARM_NEON)
+	if (cpu_info.bNEON) {
+		WriteColorsDXT1NEON(dst, src, colors_, pitch, height);
+		return;
+	}
+#endif
 	for (int y = 0; y < height; y++) {
 		int colordata = src->lines[y];
 		for (int x = 0; x < 4; x++) {
@@ -427,6 +458,28 @@ void DXTDecoder::WriteColorsDXT1(u32 *dst, const DXT1Block *src, int pitch, int
 }
 
 void DXTDecoder::WriteColorsDXT3(u32 *dst, const DXT3Block *src, int pitch, int height) {
+#if _M_SSE >= 0x301
+	if (cpu_info.bSSSE3) {
+		const __m128i table = _mm_loadu_si128((const __m128i *)colors_);
+		for (int y = 0; y < height; y++) {
+			const u32 alphadata = src->alphaLines[y];
+			const __m128i alpha = _mm_set_epi32(
+				(alphadata & 0xF000) << 16,
+				(alphadata & 0x0F00) << 20,
+				(alphadata & 0x00F0) << 24,
+				(alphadata & 0x000F) << 28);
+			__m128i row = _mm_shuffle_epi8(table, DXTColorSelSSSE3(src->color.lines[y]));
+			_mm_storeu_si128((__m128i *)dst, _mm_or_si128(row, alpha));
+			dst += pitch;
+		}
+		return;
+	}
+#elif PPSSPP_ARCH(ARM_NEON)
+	if (cpu_info.bNEON) {
+		WriteColorsDXT3NEON(dst, src, colors_, pitch, height);
+		return;
+	}
+#endif
 	for (int y = 0; y < height; y++) {
 		int colordata = src->color.lines[y];
 		u32 alphadata = src->alphaLines[y];
@@ -443,6 +496,32 @@ void DXTDecoder::WriteColorsDXT5(u32 *dst, const DXT5Block *src, int pitch, int
 	// 48 bits, 3 bit index per pixel, 12 bits per line.
 	u64 alphadata = ((u64)(u16)src->alphadata1 << 32) | (u32)src->alphadata2;
 
+#if _M_SSE >= 0x301
+	if (cpu_info.bSSSE3) {
+		const __m128i table = _mm_loadu_si128((const __m128i *)colors_);
+		// alpha_ is only 8 bytes, the high lanes shuffle in zero via the 0x80 bit.
+		const __m128i alphaTable = _mm_loadl_epi64((const __m128i *)alpha_);
+		for (int y = 0; y < height; y++) {
+			const u32 a = (u32)(alphadata & 0xFFF);
+			const __m128i alphaSel = _mm_set_epi32(
+				(((a >> 9) & 7) << 24) | 0x00808080,
+				(((a >> 6) & 7) << 24) | 0x00808080,
+				(((a >> 3) & 7) << 24) | 0x00808080,
+				(((a >> 0) & 7) << 24) | 0x00808080);
+			__m128i row = _mm_shuffle_epi8(table, DXTColorSelSSSE3(src->color.lines[y]));
+			row = _mm_or_si128(row, _mm_shuffle_epi8(alphaTable, alphaSel));
+			_mm_storeu_si128((__m128i *)dst, row);
+			dst += pitch;
+			alphadata >>= 12;
+		}
+		return;
+	}
+#elif PPSSPP_ARCH(ARM_NEON)
+	if (cpu_info.bNEON) {
+		WriteColorsDXT5NEON(dst, src, colors_, alpha_, pitch, height);
+		return;
+	}
+#endif
 	for (int y = 0; y < height; y++) {
 		int colordata = src->color.lines[y];
 		for (int x = 0; x < 4; x++) {
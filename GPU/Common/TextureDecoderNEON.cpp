@@ -158,6 +158,71 @@ void DoUnswizzleTex16NEON(const u8 *texptr, u32 *ydestp, int bxc, int byc, u32 p
 	}
 }
 
+static inline uint8x16_t DXTTableLookupNEON(uint8x16_t table, uint8x16_t sel) {
+#if PPSSPP_ARCH(ARM64)
+	return vqtbl1q_u8(table, sel);
+#else
+	uint8x8x2_t tab;
+	tab.val[0] = vget_low_u8(table);
+	tab.val[1] = vget_high_u8(table);
+	return vcombine_u8(vtbl2_u8(tab, vget_low_u8(sel)), vtbl2_u8(tab, vget_high_u8(sel)));
+#endif
+}
+
+// Expands a row of four 2-bit color indices into byte offsets into the 16-byte color table.
+static inline uint8x16_t DXTColorSelNEON(u32 colordata) {
+	alignas(16) u32 sel[4];
+	for (int x = 0; x < 4; x++) {
+		sel[x] = ((colordata >> (x * 2)) & 3) * 0x04040404 + 0x03020100;
+	}
+	return vld1q_u8((const u8 *)sel);
+}
+
+void WriteColorsDXT1NEON(u32 *dst, const DXT1Block *src, const u32 *colors, int pitch, int height) {
+	const uint8x16_t table = vld1q_u8((const u8 *)colors);
+	for (int y = 0; y < height; y++) {
+		uint8x16_t row = DXTTableLookupNEON(table, DXTColorSelNEON(src->lines[y]));
+		vst1q_u32(dst, vreinterpretq_u32_u8(row));
+		dst += pitch;
+	}
+}
+
+void WriteColorsDXT3NEON(u32 *dst, const DXT3Block *src, const u32 *colors, int pitch, int height) {
+	const uint8x16_t table = vld1q_u8((const u8 *)colors);
+	for (int y = 0; y < height; y++) {
+		u32 alphadata = src->alphaLines[y];
+		alignas(16) u32 alpha[4];
+		for (int x = 0; x < 4; x++) {
+			alpha[x] = ((alphadata >> (x * 4)) & 0xF) << 28;
+		}
+		uint32x4_t row = vreinterpretq_u32_u8(DXTTableLookupNEON(table, DXTColorSelNEON(src->color.lines[y])));
+		vst1q_u32(dst, vorrq_u32(row, vld1q_u32(alpha)));
+		dst += pitch;
+	}
+}
+
+void WriteColorsDXT5NEON(u32 *dst, const DXT5Block *src, const u32 *colors, const u8 *alpha, int pitch, int height) {
+	const uint8x16_t table = vld1q_u8((const u8 *)colors);
+	// Pad the 8-entry alpha table out to 16 - out of range lanes look up zero.
+	const uint8x16_t alphaTable = vcombine_u8(vld1_u8(alpha), vdup_n_u8(0));
+	// 48 bits, 3 bit index per pixel, 12 bits per line.
+	u64 alphadata = ((u64)(u16)src->alphadata1 << 32) | (u32)src->alphadata2;
+
+	for (int y = 0; y < height; y++) {
+		const u32 a = (u32)(alphadata & 0xFFF);
+		alignas(16) u32 alphaSel[4];
+		for (int x = 0; x < 4; x++) {
+			// The index goes in the alpha byte, the color bytes select zero.
+			alphaSel[x] = (((a >> (x * 3)) & 7) << 24) | 0x00FFFFFF;
+		}
+		uint8x16_t row = DXTTableLookupNEON(table, DXTColorSelNEON(src->color.lines[y]));
+		row = vorrq_u8(row, DXTTableLookupNEON(alphaTable, vld1q_u8((const u8 *)alphaSel)));
+		vst1q_u32(dst, vreinterpretq_u32_u8(row));
+		dst += pitch;
+		alphadata >>= 12;
+	}
+}
+
 // NOTE: This is just a NEON version of xxhash.
 // GCC sucks at making things NEON and can't seem to handle it.
 
@@ -17,10 +17,18 @@
 
 #include "GPU/Common/TextureDecoder.h"
 
+struct DXT1Block;
+struct DXT3Block;
+struct DXT5Block;
+
 u32 QuickTexHashNEON(const void *checkp, u32 size);
 void DoUnswizzleTex16NEON(const u8 *texptr, u32 *ydestp, int bxc, int byc, u32 pitch);
 u32 ReliableHash32NEON(const void *input, size_t len, u32 seed);
 
+void WriteColorsDXT1NEON(u32 *dst, const DXT1Block *src, const u32 *colors, int pitch, int height);
+void WriteColorsDXT3NEON(u32 *dst, const DXT3Block *src, const u32 *colors, int pitch, int height);
+void WriteColorsDXT5NEON(u32 *dst, const DXT5Block *src, const u32 *colors, const u8 *alpha, int pitch, int height);
+
 CheckAlphaResult CheckAlphaRGBA8888NEON(const u32 *pixelData, int stride, int w, int h);
 CheckAlphaResult CheckAlphaABGR4444NEON(const u32 *pixelData, int stride, int w, int h);
 CheckAlphaResult CheckAlphaABGR1555NEON(const u32 *pixelData, int stride, int w, int h);
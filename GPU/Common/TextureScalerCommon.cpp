@@ -26,16 +26,30 @@
 #include <cstring>
 #include <cmath>
 
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "base/stringutil.h"
+#include "base/timeutil.h"
+#include "file/file_util.h"
+
 #include "GPU/Common/TextureScalerCommon.h"
 
 #include "Core/Config.h"
+#include "Core/ELF/ParamSFO.h"
+#include "Core/System.h"
 #include "Common/Common.h"
+#include "Common/FileUtil.h"
 #include "Common/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/CommonFuncs.h"
 #include "Common/ThreadPools.h"
 #include "Common/CPUDetect.h"
 #include "ext/xbrz/xbrz.h"
+#include "ext/xxhash.h"
 
 #if _M_SSE >= 0x401
 #include <smmintrin.h>
@@ -492,6 +506,213 @@ TextureScalerCommon::TextureScalerCommon() {
 }
 
 TextureScalerCommon::~TextureScalerCommon() {
+	CloseScaleCache();
+}
+
+// A simple append-only record file: u64 key, u32 pixel count, then the scaled 8888 pixels.
+// Records whose input shows up again (level replays, game restarts) are read back instead
+// of rescaled - at 4x xBRZ a disk read is far cheaper than the scaling work.
+#define SCALE_CACHE_MAGIC 0x43535450  // 'PTSC'
+#define SCALE_CACHE_VERSION 1
+// Don't grow a cache file endlessly; stop appending past this (lookups still work.)
+#define SCALE_CACHE_MAX_SIZE (256 * 1024 * 1024)
+// Reject obviously bogus records when scanning a (possibly truncated) file.
+#define SCALE_CACHE_MAX_PIXELS (1024 * 1024 * 32)
+
+// Read records from a cache file starting at source.scannedTo, adding them to the
+// index. Stops at the first record that doesn't add up - either a truncated tail
+// from a crash, or a record another instance is still in the middle of writing;
+// the next scan picks up from the same spot.
+void TextureScalerCommon::ScanScaleCacheRecords(ScaleCacheSource &source) {
+	fseek(source.file, 0, SEEK_END);
+	const s64 fileSize = ftell(source.file);
+	if (fseek(source.file, (long)source.scannedTo, SEEK_SET) != 0)
+		return;
+	while (true) {
+		u64 key;
+		u32 numPixels;
+		if (fread(&key, sizeof(key), 1, source.file) != 1)
+			break;
+		if (fread(&numPixels, sizeof(numPixels), 1, source.file) != 1)
+			break;
+		if (numPixels == 0 || numPixels > SCALE_CACHE_MAX_PIXELS)
+			break;
+		ScaleCacheRecord record;
+		record.file = source.file;
+		record.offset = source.scannedTo + sizeof(key) + sizeof(numPixels);
+		record.numPixels = numPixels;
+		const s64 payloadEnd = record.offset + (s64)numPixels * sizeof(u32);
+		if (payloadEnd > fileSize)
+			break;
+		fseek(source.file, (long)payloadEnd, SEEK_SET);
+		// First publisher wins if several instances scaled the same input.
+		if (scaleCacheIndex_.find(key) == scaleCacheIndex_.end())
+			scaleCacheIndex_[key] = record;
+		source.scannedTo = payloadEnd;
+	}
+	clearerr(source.file);
+}
+
+// Pick up cache files published by other instances of the same game, and any new
+// records they've appended since we last looked.
+void TextureScalerCommon::RefreshSharedScaleCaches() {
+	scaleCacheLastScan_ = real_time_now();
+	std::string discID = g_paramSFO.GetDiscID();
+	if (discID.empty())
+		return;
+
+	static const char *const SCALE_CACHE_EXT = ".texscale";
+	std::vector<FileInfo> files;
+	getFilesInDir(GetSysDirectory(DIRECTORY_APP_CACHE).c_str(), &files);
+	for (const auto &info : files) {
+		if (info.isDirectory)
+			continue;
+		if (info.name.compare(0, discID.size() + 1, discID + ".") != 0)
+			continue;
+		if (info.name.size() < strlen(SCALE_CACHE_EXT) || info.name.compare(info.name.size() - strlen(SCALE_CACHE_EXT), strlen(SCALE_CACHE_EXT), SCALE_CACHE_EXT) != 0)
+			continue;
+		if (info.fullName == scaleCacheOwnFilename_)
+			continue;
+		bool known = false;
+		for (const auto &source : scaleCacheShared_) {
+			if (source.name == info.fullName) {
+				known = true;
+				break;
+			}
+		}
+		if (known)
+			continue;
+		FILE *f = File::OpenCFile(info.fullName, "rb");
+		if (!f)
+			continue;
+		u32 header[2]{};
+		if (fread(header, sizeof(header), 1, f) != 1 ||
+			header[0] != SCALE_CACHE_MAGIC || header[1] != SCALE_CACHE_VERSION) {
+			fclose(f);
+			continue;
+		}
+		ScaleCacheSource source;
+		source.file = f;
+		source.name = info.fullName;
+		source.scannedTo = sizeof(header);
+		scaleCacheShared_.push_back(source);
+	}
+
+	size_t before = scaleCacheIndex_.size();
+	for (auto &source : scaleCacheShared_)
+		ScanScaleCacheRecords(source);
+	if (scaleCacheIndex_.size() != before) {
+		INFO_LOG(G3D, "Texture scale cache: %d entries published by %d other instances", (int)(scaleCacheIndex_.size() - before), (int)scaleCacheShared_.size());
+	}
+}
+
+bool TextureScalerCommon::ScaleCacheEnabled() {
+	if (!g_Config.bTexScalingCache)
+		return false;
+	if (!scaleCacheTried_) {
+		scaleCacheTried_ = true;
+		std::string discID = g_paramSFO.GetDiscID();
+		if (discID.size()) {
+			File::CreateFullPath(GetSysDirectory(DIRECTORY_APP_CACHE));
+			// Each instance appends to its own file, named by pid, so several
+			// instances of the same game can run at once without trampling each
+			// other's appends. Everyone else's files are indexed read-only below.
+			std::string filename = StringFromFormat("%s/%s.%d.texscale", GetSysDirectory(DIRECTORY_APP_CACHE).c_str(), discID.c_str(),
+#ifdef _WIN32
+				(int)_getpid());
+#else
+				(int)getpid());
+#endif
+			scaleCacheOwnFilename_ = filename;
+			scaleCacheFile_ = File::OpenCFile(filename, "rb+");
+			if (!scaleCacheFile_) {
+				scaleCacheFile_ = File::OpenCFile(filename, "wb+");
+				if (scaleCacheFile_) {
+					u32 header[2] = { SCALE_CACHE_MAGIC, SCALE_CACHE_VERSION };
+					fwrite(header, sizeof(header), 1, scaleCacheFile_);
+					scaleCacheAppendPos_ = sizeof(header);
+				}
+			} else {
+				// Reusing a file from an earlier run with the same pid. Scan it,
+				// and append after the last record that adds up.
+				u32 header[2]{};
+				bool valid = fread(header, sizeof(header), 1, scaleCacheFile_) == 1 &&
+					header[0] == SCALE_CACHE_MAGIC && header[1] == SCALE_CACHE_VERSION;
+				if (!valid) {
+					WARN_LOG(G3D, "Texture scale cache %s unusable, starting over", filename.c_str());
+					fseek(scaleCacheFile_, 0, SEEK_SET);
+					u32 newHeader[2] = { SCALE_CACHE_MAGIC, SCALE_CACHE_VERSION };
+					fwrite(newHeader, sizeof(newHeader), 1, scaleCacheFile_);
+					scaleCacheAppendPos_ = sizeof(newHeader);
+				} else {
+					ScaleCacheSource ownSource;
+					ownSource.file = scaleCacheFile_;
+					ownSource.name = filename;
+					ownSource.scannedTo = sizeof(header);
+					ScanScaleCacheRecords(ownSource);
+					scaleCacheAppendPos_ = ownSource.scannedTo;
+					INFO_LOG(G3D, "Texture scale cache: %d entries from %s", (int)scaleCacheIndex_.size(), filename.c_str());
+				}
+			}
+			if (scaleCacheFile_) {
+				RefreshSharedScaleCaches();
+			}
+		}
+	}
+	return scaleCacheFile_ != nullptr;
+}
+
+bool TextureScalerCommon::LoadFromScaleCache(u64 key, u32 *out, int numPixels) {
+	auto iter = scaleCacheIndex_.find(key);
+	if (iter == scaleCacheIndex_.end()) {
+		// Maybe another instance has scaled this texture since we last looked.
+		// Keep this cheap on repeated misses, a directory scan isn't free.
+		if (real_time_now() > scaleCacheLastScan_ + 5.0) {
+			RefreshSharedScaleCaches();
+			iter = scaleCacheIndex_.find(key);
+		}
+	}
+	if (iter == scaleCacheIndex_.end() || iter->second.numPixels != (u32)numPixels)
+		return false;
+	if (fseek(iter->second.file, (long)iter->second.offset, SEEK_SET) != 0)
+		return false;
+	if (fread(out, sizeof(u32), numPixels, iter->second.file) != (size_t)numPixels)
+		return false;
+	return true;
+}
+
+void TextureScalerCommon::SaveToScaleCache(u64 key, const u32 *data, int numPixels) {
+	if (scaleCacheAppendPos_ > SCALE_CACHE_MAX_SIZE)
+		return;
+	if (fseek(scaleCacheFile_, (long)scaleCacheAppendPos_, SEEK_SET) != 0)
+		return;
+	fwrite(&key, sizeof(key), 1, scaleCacheFile_);
+	u32 pixels = (u32)numPixels;
+	fwrite(&pixels, sizeof(pixels), 1, scaleCacheFile_);
+	if (fwrite(data, sizeof(u32), numPixels, scaleCacheFile_) != (size_t)numPixels)
+		return;
+	fflush(scaleCacheFile_);
+	ScaleCacheRecord record;
+	record.file = scaleCacheFile_;
+	record.offset = scaleCacheAppendPos_ + sizeof(key) + sizeof(pixels);
+	record.numPixels = pixels;
+	scaleCacheIndex_[key] = record;
+	scaleCacheAppendPos_ = record.offset + (s64)pixels * sizeof(u32);
+}
+
+void TextureScalerCommon::CloseScaleCache() {
+	if (scaleCacheFile_) {
+		fclose(scaleCacheFile_);
+		scaleCacheFile_ = nullptr;
+	}
+	for (auto &source : scaleCacheShared_)
+		fclose(source.file);
+	scaleCacheShared_.clear();
+	scaleCacheIndex_.clear();
+	scaleCacheOwnFilename_.clear();
+	scaleCacheAppendPos_ = 0;
+	scaleCacheTried_ = false;
+	scaleCacheLastScan_ = 0.0;
 }
 
 bool TextureScalerCommon::IsEmptyOrFlat(u32* data, int pixels, int fmt) {
@@ -540,6 +761,20 @@ bool TextureScalerCommon::ScaleInto(u32 *outputBuf, u32 *src, u32 &dstFmt, int &
 	double t_start = real_time_now();
 #endif
 
+	// Check the on-disk result cache first, keyed on the raw input plus everything
+	// that affects the output.
+	u64 cacheKey = 0;
+	if (ScaleCacheEnabled()) {
+		const u64 seed = (u64)factor | ((u64)g_Config.iTexScalingType << 8) | ((u64)g_Config.bTexDeposterize << 16);
+		cacheKey = XXH64(src, width * height * BytesPerPixel(dstFmt), seed);
+		if (LoadFromScaleCache(cacheKey, outputBuf, width * factor * height * factor)) {
+			dstFmt = Get8888Format();
+			width *= factor;
+			height *= factor;
+			return true;
+		}
+	}
+
 	bufInput.resize(width*height); // used to store the input image image if it needs to be reformatted
 	u32 *inputBuf = bufInput.data();
 
@@ -576,6 +811,10 @@ bool TextureScalerCommon::ScaleInto(u32 *outputBuf, u32 *src, u32 &dstFmt, int &
 	width *= factor;
 	height *= factor;
 
+	if (cacheKey != 0) {
+		SaveToScaleCache(cacheKey, outputBuf, width * height);
+	}
+
 #ifdef SCALING_MEASURE_TIME
 	if (width*height > 64 * 64 * factor*factor) {
 		double t = real_time_now() - t_start;
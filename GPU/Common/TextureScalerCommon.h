@@ -20,6 +20,9 @@
 #include "Common/CommonTypes.h"
 #include "Common/MemoryUtil.h"
 
+#include <cstdio>
+#include <map>
+#include <string>
 #include <vector>
 
 class TextureScalerCommon {
@@ -48,8 +51,39 @@ protected:
 
 	bool IsEmptyOrFlat(u32* data, int pixels, int fmt);
 
-	// depending on the factor and texture sizes, these can get pretty large 
+	// Per-game on-disk cache of scaled output, keyed by a hash of the unscaled input.
+	// Scaling the same content twice (level replays, restarts) just reads the file.
+	// Each instance appends to its own file and reads everyone's, so several
+	// instances of the same game on one machine share the scaling work.
+	bool ScaleCacheEnabled();
+	bool LoadFromScaleCache(u64 key, u32 *out, int numPixels);
+	void SaveToScaleCache(u64 key, const u32 *data, int numPixels);
+	void CloseScaleCache();
+
+	// depending on the factor and texture sizes, these can get pretty large
 	// maximum is (100 MB total for a 512 by 512 texture with scaling factor 5 and hybrid scaling)
 	// of course, scaling factor 5 is totally silly anyway
 	SimpleBuf<u32> bufInput, bufDeposter, bufOutput, bufTmp1, bufTmp2, bufTmp3;
+
+	struct ScaleCacheRecord {
+		FILE *file;
+		s64 offset;
+		u32 numPixels;
+	};
+	// A cache file we read but don't write - usually another instance's.
+	struct ScaleCacheSource {
+		FILE *file;
+		std::string name;
+		s64 scannedTo;
+	};
+	void ScanScaleCacheRecords(ScaleCacheSource &source);
+	void RefreshSharedScaleCaches();
+
+	std::map<u64, ScaleCacheRecord> scaleCacheIndex_;
+	std::vector<ScaleCacheSource> scaleCacheShared_;
+	FILE *scaleCacheFile_ = nullptr;
+	std::string scaleCacheOwnFilename_;
+	s64 scaleCacheAppendPos_ = 0;
+	bool scaleCacheTried_ = false;
+	double scaleCacheLastScan_ = 0.0;
 };
@@ -1180,6 +1180,7 @@ void VertexDecoder::SetVertexType(u32 fmt, const VertexDecoderOptions &options,
 	}
 
 	if (nrm) {
+		const int stepsBeforeNrm = numSteps_;
 		size = align(size, nrmalign[nrm]);
 		nrmoff = size;
 		size += nrmsize[nrm];
@@ -1217,6 +1218,11 @@ void VertexDecoder::SetVertexType(u32 fmt, const VertexDecoderOptions &options,
 				steps_[numSteps_++] = nrmstep_morph[nrm];
 			}
 		}
+		// The draw path told us nothing reads normal contents with the current state,
+		// so drop the decode steps again. The output layout stays the same - the
+		// bytes at nrmoff are simply never written.
+		if (fmt & VERTTYPE_ID_NRM_UNUSED)
+			numSteps_ = stepsBeforeNrm;
 		decFmt.nrmoff = decOff;
 		decOff += DecFmtSize(decFmt.nrmfmt);
 	}
@@ -1305,6 +1311,20 @@ void VertexDecoder::DecodeVerts(u8 *decodedptr, const void *verts, int indexLowe
 	}
 }
 
+void VertexDecoder::DecodeVertsJitted(u8 *decodedptr, const void *verts, int indexLowerBound, int indexUpperBound) const {
+	const u8 *ptr = (const u8 *)verts + indexLowerBound * size;
+	int count = indexUpperBound - indexLowerBound + 1;
+
+	// Check alignment before running the decoder, as we may crash if it's bad (as should the real PSP but doesn't always)
+	if (((uintptr_t)verts & (biggest - 1)) != 0) {
+		// Bad alignment. Not really sure what to do here... zero the verts to be safe?
+		memset(decodedptr, 0, count * decFmt.stride);
+		return;
+	}
+
+	jitted_(ptr, decodedptr, count);
+}
+
 static const char *posnames[4] = { "?", "s8", "s16", "f" };
 static const char *nrmnames[4] = { "", "s8", "s16", "f" };
 static const char *tcnames[4] = { "", "u8", "u16", "f" };
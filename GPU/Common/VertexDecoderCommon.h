@@ -442,6 +442,14 @@ struct VertexDecoderOptions {
 	bool expand8BitNormalsToFloat;
 };
 
+// Mashed into the vert type ID above the UV gen mode (see GetVertTypeID) when
+// nothing in the current pipeline state reads normal contents. The decoder keeps
+// the output layout but skips the normal decode steps, leaving the bytes stale.
+// Must not be set on debug readback or tessellation paths - those want full decodes.
+enum : u32 {
+	VERTTYPE_ID_NRM_UNUSED = 1u << 26,
+};
+
 class VertexDecoder {
 public:
 	VertexDecoder();
@@ -455,6 +463,11 @@ public:
 
 	void DecodeVerts(u8 *decoded, const void *verts, int indexLowerBound, int indexUpperBound) const;
 
+	// Thread-safe variant for parallel decoding - doesn't go through the mutable
+	// cursor members, so it's only usable when the decoder is jitted (the
+	// interpreted steps walk this->ptr_/decoded_.)
+	void DecodeVertsJitted(u8 *decoded, const void *verts, int indexLowerBound, int indexUpperBound) const;
+
 	bool hasColor() const { return col != 0; }
 	bool hasTexcoord() const { return tc != 0; }
 	int VertexSize() const { return size; }  // PSP format size
@@ -19,6 +19,7 @@
 
 #include "base/logging.h"
 #include "base/timeutil.h"
+#include "profiler/profiler.h"
 
 #include "Common/MemoryUtil.h"
 #include "Core/MemMap.h"
@@ -322,7 +323,9 @@ static uint32_t SwapRB(uint32_t c) {
 
 // The inline wrapper in the header checks for numDrawCalls == 0
 void DrawEngineD3D11::DoFlush() {
+	PROFILE_THIS_SCOPE("flush");
 	gpuStats.numFlushes++;
+	AccountFlushReason();
 	gpuStats.numTrackedVertexArrays = (int)vai_.size();
 
 	// This is not done on every drawcall, we collect vertex data
@@ -350,7 +353,9 @@ void DrawEngineD3D11::DoFlush() {
 			useCache = false;
 
 		if (useCache) {
-			u32 id = dcid_ ^ gstate.getUVGenMode();  // This can have an effect on which UV decoder we need to use! And hence what the decoded data will look like. See #9263
+			// Any state mashed into the decoder ID affects what the decoded data will
+			// look like (UV gen mode, dead attributes...), so key on all of it. See #9263.
+			u32 id = dcid_ ^ dec_->VertexType();
 
 			VertexArrayInfoD3D11 *vai = vai_.Get(id);
 			if (!vai) {
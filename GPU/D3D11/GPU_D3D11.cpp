@@ -289,6 +289,7 @@ inline void GPU_D3D11::CheckFlushOp(int cmd, u32 diff) {
 		if (dumpThisFrame_) {
 			NOTICE_LOG(G3D, "================ FLUSH ================");
 		}
+		drawEngine_.SetFlushReason(FlushReasonFromCommand(cmd));
 		drawEngine_.Flush();
 	}
 }
@@ -314,6 +315,9 @@ void GPU_D3D11::GetStats(char *buffer, size_t bufsize) {
 	float vertexAverageCycles = gpuStats.numVertsSubmitted > 0 ? (float)gpuStats.vertexGPUCycles / (float)gpuStats.numVertsSubmitted : 0.0f;
 	snprintf(buffer, bufsize - 1,
 		"DL processing time: %0.2f ms\n"
+		"Vertex, Texture decode: %0.2f ms, %0.2f ms\n"
+		"Readback time: %0.2f ms\n"
+		"Shader compiles: %i\n"
 		"Draw calls: %i, flushes %i, clears %i\n"
 		"Cached Draw calls: %i\n"
 		"Num Tracked Vertex Arrays: %i\n"
@@ -326,6 +330,10 @@ void GPU_D3D11::GetStats(char *buffer, size_t bufsize) {
 		"Readbacks: %d, uploads: %d\n"
 		"Vertex, Fragment shaders loaded: %i, %i\n",
 		gpuStats.msProcessingDisplayLists * 1000.0f,
+		gpuStats.msVertexDecode * 1000.0f,
+		gpuStats.msTextureDecode * 1000.0f,
+		gpuStats.msReadbacks * 1000.0f,
+		gpuStats.numShaderCompiles,
 		gpuStats.numDrawCalls,
 		gpuStats.numFlushes,
 		gpuStats.numClears,
@@ -113,6 +113,8 @@ TextureCacheD3D11::TextureCacheD3D11(Draw::DrawContext *draw)
 
 	isBgraBackend_ = true;
 	lastBoundTexture = INVALID_TEX;
+	// Rendered CLUTs can stay on the GPU, the depal path blits them from the framebuffer.
+	supportsReadbackFreeClut_ = true;
 
 	HRESULT result = 0;
 
@@ -190,6 +192,7 @@ void TextureCacheD3D11::StartFrame() {
 		// INFO_LOG(G3D, "Scaled %i texels", texelsScaledThisFrame_);
 	}
 	texelsScaledThisFrame_ = 0;
+	texelsBuiltThisFrame_ = 0;
 	if (clearCacheNextFrame_) {
 		Clear(true);
 		clearCacheNextFrame_ = false;
@@ -386,7 +389,14 @@ void TextureCacheD3D11::ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFra
 	if (pshader) {
 		bool expand32 = !gstate_c.Supports(GPU_SUPPORTS_16BIT_FORMATS);
 		const GEPaletteFormat clutFormat = gstate.getClutPaletteFormat();
-		ID3D11ShaderResourceView *clutTexture = depalShaderCache_->GetClutTexture(clutFormat, clutHash_, clutBuf_, expand32);
+		// If the CLUT was rendered, blit it into a small FBO instead of reading it back.
+		// Has to happen before we switch render targets below.
+		Draw::Framebuffer *dynamicClutFbo = GetDynamicClutFbo(clutFormat);
+		ID3D11ShaderResourceView *clutTexture = nullptr;
+		if (!dynamicClutFbo) {
+			EnsureClutReadback();
+			clutTexture = depalShaderCache_->GetClutTexture(clutFormat, clutHash_, clutBuf_, expand32);
+		}
 
 		Draw::Framebuffer *depalFBO = framebufferManagerD3D11_->GetTempFBO(TempFBO::DEPAL, framebuffer->renderWidth, framebuffer->renderHeight, Draw::FBO_8888);
 		shaderManager_->DirtyLastShader();
@@ -400,7 +410,11 @@ void TextureCacheD3D11::ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFra
 		shaderApply.Use(depalShaderCache_->GetDepalettizeVertexShader(), depalShaderCache_->GetInputLayout());
 
 		draw_->BindFramebufferAsRenderTarget(depalFBO, { Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE });
-		context_->PSSetShaderResources(3, 1, &clutTexture);
+		if (dynamicClutFbo) {
+			draw_->BindFramebufferAsTexture(dynamicClutFbo, 3, Draw::FB_COLOR_BIT, 0);
+		} else {
+			context_->PSSetShaderResources(3, 1, &clutTexture);
+		}
 		context_->PSSetSamplers(3, 1, &stockD3D11.samplerPoint2DWrap);
 		framebufferManagerD3D11_->BindFramebufferAsColorTexture(0, framebuffer, BINDFBCOLOR_SKIP_COPY | BINDFBCOLOR_FORCE_SELF);
 		context_->PSSetSamplers(0, 1, &stockD3D11.samplerPoint2DWrap);
@@ -409,11 +423,16 @@ void TextureCacheD3D11::ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFra
 		framebufferManagerD3D11_->RebindFramebuffer();
 		draw_->BindFramebufferAsTexture(depalFBO, 0, Draw::FB_COLOR_BIT, 0);
 
-		const u32 bytesPerColor = clutFormat == GE_CMODE_32BIT_ABGR8888 ? sizeof(u32) : sizeof(u16);
-		const u32 clutTotalColors = clutMaxBytes_ / bytesPerColor;
+		if (dynamicClutFbo) {
+			// The palette bytes never hit the CPU, so we can't check - assume the worst.
+			gstate_c.SetTextureFullAlpha(false);
+		} else {
+			const u32 bytesPerColor = clutFormat == GE_CMODE_32BIT_ABGR8888 ? sizeof(u32) : sizeof(u16);
+			const u32 clutTotalColors = clutMaxBytes_ / bytesPerColor;
 
-		TexCacheEntry::TexStatus alphaStatus = CheckAlpha(clutBuf_, GetClutDestFormatD3D11(clutFormat), clutTotalColors, clutTotalColors, 1);
-		gstate_c.SetTextureFullAlpha(alphaStatus == TexCacheEntry::STATUS_ALPHA_FULL);
+			TexCacheEntry::TexStatus alphaStatus = CheckAlpha(clutBuf_, GetClutDestFormatD3D11(clutFormat), clutTotalColors, clutTotalColors, 1);
+			gstate_c.SetTextureFullAlpha(alphaStatus == TexCacheEntry::STATUS_ALPHA_FULL);
+		}
 	} else {
 		entry->status &= ~TexCacheEntry::STATUS_DEPALETTIZE;
 
@@ -491,6 +510,13 @@ void TextureCacheD3D11::BuildTexture(TexCacheEntry *const entry) {
 	int w = gstate.getTextureWidth(0);
 	int h = gstate.getTextureHeight(0);
 	ReplacedTexture &replaced = replacer_.FindReplacement(cachekey, entry->fullhash, w, h);
+	if (replaced.IsPending()) {
+		// Decode is in flight on the background loader - build the original texture now
+		// and swap the replacement in on a later frame, like deferred scaling.
+		entry->status |= TexCacheEntry::STATUS_TO_REPLACE;
+	} else {
+		entry->status &= ~TexCacheEntry::STATUS_TO_REPLACE;
+	}
 	if (replaced.GetSize(0, w, h)) {
 		// We're replacing, so we won't scale.
 		scaleFactor = 1;
@@ -509,7 +535,10 @@ void TextureCacheD3D11::BuildTexture(TexCacheEntry *const entry) {
 	}
 
 	if (scaleFactor != 1) {
-		if (texelsScaledThisFrame_ >= TEXCACHE_MAX_TEXELS_SCALED) {
+		// With deferred loads on, never scale on the very first build - upload the
+		// unscaled texture right away and swap in the scaled one on a later frame.
+		const bool deferScale = g_Config.bDeferTextureLoads && entry->numFrames == 0;
+		if (deferScale || texelsScaledThisFrame_ >= TEXCACHE_MAX_TEXELS_SCALED) {
 			entry->status |= TexCacheEntry::STATUS_TO_SCALE;
 			scaleFactor = 1;
 		} else {
@@ -530,19 +559,39 @@ void TextureCacheD3D11::BuildTexture(TexCacheEntry *const entry) {
 		// NOTE: Since the level is not part of the cache key, we assume it never changes.
 		u8 level = std::max(0, gstate.getTexLevelOffset16() / 16);
 		LoadTextureLevel(*entry, replaced, level, maxLevel, scaleFactor, dstFmt);
+		if (!DxView(entry)) {
+			return;
+		}
 	} else {
-		LoadTextureLevel(*entry, replaced, 0, maxLevel, scaleFactor, dstFmt);
-	}
-
-	ID3D11ShaderResourceView *textureView = DxView(entry);
-	if (!textureView) {
-		return;
-	}
-
-	// Mipmapping is only enabled when texture scaling is disabled.
-	if (maxLevel > 0 && scaleFactor == 1) {
-		for (int i = 1; i <= maxLevel; i++) {
-			LoadTextureLevel(*entry, replaced, i, maxLevel, scaleFactor, dstFmt);
+		// Mipmapping is only enabled when texture scaling is disabled.
+		int levels = scaleFactor == 1 ? maxLevel + 1 : 1;
+		if (levels > 16)
+			levels = 16;  // Paranoia, in case of crazy replacement textures.
+
+		// Decode all the levels to RAM first, then create the texture with the complete
+		// initial data in a single device call. Device methods are free-threaded in D3D11,
+		// unlike the immediate context, so fresh texture uploads stay off the context
+		// entirely and the driver can stage the copies on its own threads.
+		D3D11_SUBRESOURCE_DATA subData[16]{};
+		u32 *levelData[16]{};
+		for (int i = 0; i < levels; i++) {
+			int rowPitch = 0;
+			levelData[i] = DecodeLevelToRAM(*entry, replaced, i, scaleFactor, dstFmt, &rowPitch);
+			if (!levelData[i]) {
+				levels = i;
+				break;
+			}
+			subData[i].pSysMem = levelData[i];
+			subData[i].SysMemPitch = rowPitch;
+		}
+		if (levels > 0) {
+			CreateTextureObject(*entry, replaced, levels, scaleFactor, dstFmt, subData);
+		}
+		for (int i = 0; i < levels; i++) {
+			FreeAlignedMemory(levelData[i]);
+		}
+		if (!DxView(entry)) {
+			return;
 		}
 	}
 
@@ -636,15 +685,48 @@ DXGI_FORMAT ToDXGIFormat(ReplacedTextureFormat fmt) {
 	}
 }
 
-void TextureCacheD3D11::LoadTextureLevel(TexCacheEntry &entry, ReplacedTexture &replaced, int level, int maxLevel, int scaleFactor, DXGI_FORMAT dstFmt) {
-	int w = gstate.getTextureWidth(level);
-	int h = gstate.getTextureHeight(level);
+void TextureCacheD3D11::CreateTextureObject(TexCacheEntry &entry, ReplacedTexture &replaced, int levels, int scaleFactor, DXGI_FORMAT dstFmt, const D3D11_SUBRESOURCE_DATA *initData) {
+	int tw = gstate.getTextureWidth(0);
+	int th = gstate.getTextureHeight(0);
+	DXGI_FORMAT tfmt = dstFmt;
+	if (replaced.GetSize(0, tw, th)) {
+		tfmt = ToDXGIFormat(replaced.Format(0));
+	} else {
+		tw *= scaleFactor;
+		th *= scaleFactor;
+		if (scaleFactor > 1) {
+			tfmt = DXGI_FORMAT_B8G8R8A8_UNORM;
+		}
+	}
 
+	D3D11_TEXTURE2D_DESC desc{};
+	desc.CPUAccessFlags = 0;
+	// All the levels are supplied up front, so the texture never needs touching on the
+	// immediate context again - IMMUTABLE makes that explicit to the driver.
+	desc.Usage = D3D11_USAGE_IMMUTABLE;
+	desc.ArraySize = 1;
+	desc.SampleDesc.Count = 1;
+	desc.Width = tw;
+	desc.Height = th;
+	desc.Format = tfmt;
+	desc.MipLevels = levels;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	ID3D11Texture2D *texture = nullptr;
+	ASSERT_SUCCESS(device_->CreateTexture2D(&desc, initData, &texture));
+	ID3D11ShaderResourceView *view;
+	ASSERT_SUCCESS(device_->CreateShaderResourceView(texture, nullptr, &view));
+	entry.texturePtr = texture;
+	entry.textureView = view;
+}
+
+void TextureCacheD3D11::LoadTextureLevel(TexCacheEntry &entry, ReplacedTexture &replaced, int level, int maxLevel, int scaleFactor, DXGI_FORMAT dstFmt) {
+	// Only used for the fake mipmap change case now - the level in use is swapped into a
+	// single-level texture as the CLUT changes, so it can't be IMMUTABLE like the normal path.
 	ID3D11Texture2D *texture = DxTex(&entry);
-	if ((level == 0 || IsFakeMipmapChange()) && texture == nullptr) {
-		// Create texture
-		int levels = scaleFactor == 1 ? maxLevel + 1 : 1;
-		int tw = w, th = h;
+	if (texture == nullptr) {
+		int tw = gstate.getTextureWidth(level);
+		int th = gstate.getTextureHeight(level);
 		DXGI_FORMAT tfmt = dstFmt;
 		if (replaced.GetSize(level, tw, th)) {
 			tfmt = ToDXGIFormat(replaced.Format(level));
@@ -657,7 +739,6 @@ void TextureCacheD3D11::LoadTextureLevel(TexCacheEntry &entry, ReplacedTexture &
 		}
 
 		D3D11_TEXTURE2D_DESC desc{};
-		// TODO: Make it DEFAULT or immutable, required for multiple mip levels. Will require some code restructuring though.
 		desc.CPUAccessFlags = 0;
 		desc.Usage = D3D11_USAGE_DEFAULT;
 		desc.ArraySize = 1;
@@ -665,7 +746,7 @@ void TextureCacheD3D11::LoadTextureLevel(TexCacheEntry &entry, ReplacedTexture &
 		desc.Width = tw;
 		desc.Height = th;
 		desc.Format = tfmt;
-		desc.MipLevels = IsFakeMipmapChange() ? 1 : levels;
+		desc.MipLevels = 1;
 		desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
 
 		ASSERT_SUCCESS(device_->CreateTexture2D(&desc, nullptr, &texture));
@@ -675,15 +756,27 @@ void TextureCacheD3D11::LoadTextureLevel(TexCacheEntry &entry, ReplacedTexture &
 		entry.textureView = view;
 	}
 
+	int rowPitch = 0;
+	u32 *data = DecodeLevelToRAM(entry, replaced, level, scaleFactor, dstFmt, &rowPitch);
+	if (!data) {
+		return;
+	}
+	context_->UpdateSubresource(texture, 0, nullptr, data, rowPitch, 0);
+	FreeAlignedMemory(data);
+}
+
+u32 *TextureCacheD3D11::DecodeLevelToRAM(TexCacheEntry &entry, ReplacedTexture &replaced, int level, int scaleFactor, DXGI_FORMAT dstFmt, int *rowPitch) {
+	int w = gstate.getTextureWidth(level);
+	int h = gstate.getTextureHeight(level);
+
 	gpuStats.numTexturesDecoded++;
-	// For UpdateSubresource, we can't decode directly into the texture so we allocate a buffer :(
+	// We can't decode directly into the texture so we allocate a buffer :(
 	u32 *mapData = nullptr;
 	int mapRowPitch = 0;
 	if (replaced.GetSize(level, w, h)) {
 		mapData = (u32 *)AllocateAlignedMemory(w * h * sizeof(u32), 16);
 		mapRowPitch = w * 4;
 		replaced.Load(level, mapData, mapRowPitch);
-		dstFmt = ToDXGIFormat(replaced.Format(level));
 	} else {
 		GETextureFormat tfmt = (GETextureFormat)entry.format;
 		GEPaletteFormat clutformat = gstate.getClutPaletteFormat();
@@ -705,7 +798,7 @@ void TextureCacheD3D11::LoadTextureLevel(TexCacheEntry &entry, ReplacedTexture &
 			mapData = (u32 *)AllocateAlignedMemory(bufSize, 16);
 			if (!mapData) {
 				ERROR_LOG(G3D, "Ran out of RAM trying to allocate a temporary texture upload buffer (alloc size: %d, %dx%d)", bufSize, mapRowPitch / sizeof(u32), h);
-				return;
+				return nullptr;
 			}
 			pixelData = (u32 *)mapData;
 			decPitch = mapRowPitch;
@@ -733,9 +826,8 @@ void TextureCacheD3D11::LoadTextureLevel(TexCacheEntry &entry, ReplacedTexture &
 			decPitch = w * bpp;
 
 			if (decPitch != mapRowPitch) {
-				// Rearrange in place to match the requested pitch.
-				// (it can only be larger than w * bpp, and a match is likely.)
-				// Note! This is bad because it reads the mapped memory! TODO: Look into if DX9 does this right.
+				// Rearrange in place to match the requested pitch. Harmless since this is
+				// a plain RAM buffer. (it can only be larger than w * bpp, and a match is likely.)
 				for (int y = h - 1; y >= 0; --y) {
 					memcpy((u8 *)mapData + mapRowPitch * y, (u8 *)mapData + decPitch * y, w * bpp);
 				}
@@ -757,11 +849,8 @@ void TextureCacheD3D11::LoadTextureLevel(TexCacheEntry &entry, ReplacedTexture &
 		}
 	}
 
-	if (IsFakeMipmapChange())
-		context_->UpdateSubresource(texture, 0, nullptr, mapData, mapRowPitch, 0);
-	else
-		context_->UpdateSubresource(texture, level, nullptr, mapData, mapRowPitch, 0);
-	FreeAlignedMemory(mapData);
+	*rowPitch = mapRowPitch;
+	return mapData;
 }
 
 bool TextureCacheD3D11::GetCurrentTextureDebug(GPUDebugBuffer &buffer, int level) {
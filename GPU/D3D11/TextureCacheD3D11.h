@@ -69,6 +69,11 @@ protected:
 	void ReleaseTexture(TexCacheEntry *entry, bool delete_them) override;
 
 private:
+	// Decodes (and possibly scales) one level into a freshly allocated buffer, returning it
+	// and the row pitch. The caller owns the buffer (FreeAlignedMemory). Returns nullptr on failure.
+	u32 *DecodeLevelToRAM(TexCacheEntry &entry, ReplacedTexture &replaced, int level, int scaleFactor, DXGI_FORMAT dstFmt, int *rowPitch);
+	void CreateTextureObject(TexCacheEntry &entry, ReplacedTexture &replaced, int levels, int scaleFactor, DXGI_FORMAT dstFmt, const D3D11_SUBRESOURCE_DATA *initData);
+	// Only used for the fake mipmap change path, which updates the texture in place.
 	void LoadTextureLevel(TexCacheEntry &entry, ReplacedTexture &replaced, int level, int maxLevel, int scaleFactor, DXGI_FORMAT dstFmt);
 	DXGI_FORMAT GetDestFormat(GETextureFormat format, GEPaletteFormat clutFormat) const;
 	TexCacheEntry::TexStatus CheckAlpha(const u32 *pixelData, u32 dstFmt, int stride, int w, int h);
@@ -0,0 +1,113 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "Core/Debugger/SymbolMap.h"
+#include "GPU/Debugger/GeProfiler.h"
+#include "GPU/GPUInterface.h"
+
+namespace GeProfiler {
+
+static std::atomic<bool> g_enabled(false);
+
+struct Breadcrumb {
+	u32 pc;
+	u32 ra;
+};
+
+struct SiteStat {
+	u64 lists;
+	double totalS;
+};
+
+static std::mutex sitesLock;
+// Indexed by display list slot - one breadcrumb per in-flight list.
+static Breadcrumb breadcrumbs[GPUInterface::DisplayListMaxCount];
+// Keyed by the call site (ra at enqueue time.)
+static std::unordered_map<u32, SiteStat> sites;
+static double totalTimeS = 0.0;
+
+void SetEnabled(bool enabled) {
+	g_enabled = enabled;
+}
+
+bool IsEnabled() {
+	return g_enabled;
+}
+
+void NotifyEnqueue(int listID, u32 pc, u32 ra) {
+	if (listID < 0 || listID >= GPUInterface::DisplayListMaxCount)
+		return;
+
+	std::lock_guard<std::mutex> guard(sitesLock);
+	breadcrumbs[listID].pc = pc;
+	breadcrumbs[listID].ra = ra;
+}
+
+void AddListTime(int listID, double seconds) {
+	if (listID < 0 || listID >= GPUInterface::DisplayListMaxCount)
+		return;
+
+	std::lock_guard<std::mutex> guard(sitesLock);
+	// A list can be interpreted in several chunks (stall updates), which all
+	// accumulate on the same breadcrumb.
+	SiteStat &stat = sites[breadcrumbs[listID].ra];
+	stat.lists++;
+	stat.totalS += seconds;
+	totalTimeS += seconds;
+}
+
+void Reset() {
+	std::lock_guard<std::mutex> guard(sitesLock);
+	sites.clear();
+	totalTimeS = 0.0;
+}
+
+std::vector<CallsiteSample> GetTopCallsites(size_t count) {
+	std::vector<std::pair<u32, SiteStat>> sorted;
+	double total;
+	{
+		std::lock_guard<std::mutex> guard(sitesLock);
+		sorted.assign(sites.begin(), sites.end());
+		total = totalTimeS;
+	}
+
+	std::sort(sorted.begin(), sorted.end(), [](const std::pair<u32, SiteStat> &a, const std::pair<u32, SiteStat> &b) {
+		return a.second.totalS > b.second.totalS;
+	});
+	if (sorted.size() > count)
+		sorted.resize(count);
+
+	std::vector<CallsiteSample> result;
+	result.reserve(sorted.size());
+	for (const auto &entry : sorted) {
+		CallsiteSample sample;
+		sample.address = entry.first;
+		sample.name = g_symbolMap ? g_symbolMap->GetLabelString(entry.first) : "";
+		sample.lists = entry.second.lists;
+		sample.totalMs = entry.second.totalS * 1000.0;
+		sample.percent = total > 0.0 ? 100.0 * entry.second.totalS / total : 0.0;
+		result.push_back(sample);
+	}
+	return result;
+}
+
+}  // namespace GeProfiler
@@ -0,0 +1,55 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Correlates GE display list execution time back to the game code that
+// enqueued each list. At sceGeListEnQueue time we remember the CPU pc/ra as a
+// breadcrumb for the list slot; when the list is interpreted, its time is
+// attributed to that call site (named via SymbolMap). That answers "which game
+// subroutine issued the expensive draws" without a GE dump.
+
+namespace GeProfiler {
+
+struct CallsiteSample {
+	u32 address;       // The game-side call site (ra at enqueue time).
+	std::string name;
+	u64 lists;         // How many lists this site enqueued.
+	double totalMs;
+	double percent;
+};
+
+// Cheap to check; tracking costs nothing while disabled.
+void SetEnabled(bool enabled);
+bool IsEnabled();
+
+// Called at sceGeListEnQueue time with the chosen list slot.
+void NotifyEnqueue(int listID, u32 pc, u32 ra);
+// Called after a list has been interpreted, with the time it took.
+void AddListTime(int listID, double seconds);
+
+void Reset();
+
+// Ranked by total list time, descending. Safe to call from the UI thread.
+std::vector<CallsiteSample> GetTopCallsites(size_t count);
+
+}  // namespace GeProfiler
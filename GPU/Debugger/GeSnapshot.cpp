@@ -0,0 +1,89 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#include <atomic>
+#include <cstring>
+
+#include "base/timeutil.h"
+#include "GPU/Debugger/GeSnapshot.h"
+#include "GPU/GPUState.h"
+
+namespace GeSnapshot {
+
+static std::atomic<bool> g_enabled(false);
+
+// Seqlock ring: the GE thread is the only writer, so a slot's sequence number
+// is bumped to odd before filling and back to even after. A reader that sees
+// an odd or changed sequence steps back to an older slot instead of waiting.
+// The snapshot copy itself is racy by design - the sequence check discards
+// any torn result.
+enum { RING_SIZE = 8 };
+
+struct Slot {
+	std::atomic<u32> seq;
+	Snapshot snap;
+};
+
+static Slot ring[RING_SIZE];
+static std::atomic<u32> writeCursor(0);
+
+void SetEnabled(bool enabled) {
+	g_enabled = enabled;
+}
+
+bool IsEnabled() {
+	return g_enabled;
+}
+
+void CaptureAtFlush(int listID, int listState, u32 startPC, u32 pc, u32 stall) {
+	u32 idx = writeCursor.load(std::memory_order_relaxed);
+	Slot &slot = ring[idx % RING_SIZE];
+
+	u32 seq = slot.seq.load(std::memory_order_relaxed);
+	slot.seq.store(seq + 1, std::memory_order_release);
+
+	slot.snap.time = time_now_d();
+	slot.snap.listID = listID;
+	slot.snap.listState = listState;
+	slot.snap.listStartPC = startPC;
+	slot.snap.listPC = pc;
+	slot.snap.listStall = stall;
+	memcpy(slot.snap.cmdmem, gstate.cmdmem, sizeof(slot.snap.cmdmem));
+
+	slot.seq.store(seq + 2, std::memory_order_release);
+	writeCursor.store(idx + 1, std::memory_order_release);
+}
+
+bool GetLatest(Snapshot *out) {
+	u32 idx = writeCursor.load(std::memory_order_acquire);
+	// Walk backward past any slot that's mid-write or got overwritten while
+	// we copied. With 8 slots and one writer this terminates long before the
+	// ring wraps under us.
+	for (int attempt = 0; attempt < RING_SIZE && idx > (u32)attempt; ++attempt) {
+		Slot &slot = ring[(idx - 1 - attempt) % RING_SIZE];
+		const u32 seqBefore = slot.seq.load(std::memory_order_acquire);
+		if (seqBefore & 1)
+			continue;
+		*out = slot.snap;
+		const u32 seqAfter = slot.seq.load(std::memory_order_acquire);
+		if (seqBefore == seqAfter)
+			return true;
+	}
+	return false;
+}
+
+}  // namespace GeSnapshot
@@ -0,0 +1,54 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Pause-free GE state sampling. Unlike the stepping debugger, which stops the
+// GE to inspect state, this snapshots the raw command state and the current
+// display list progress at draw-flush boundaries into a small seqlock ring.
+// A remote client (the WebSocket debugger) can then read a consistent "what
+// is it drawing right now" picture from another thread at any time, without
+// ever pausing the session.
+
+namespace GeSnapshot {
+
+struct Snapshot {
+	double time;       // time_now_d() at capture.
+	int listID;        // -1 if no list was active.
+	int listState;     // DisplayListState.
+	u32 listStartPC;
+	u32 listPC;
+	u32 listStall;
+	// Raw GE command state (gstate.cmdmem.)
+	u32 cmdmem[256];
+};
+
+// Cheap to check; capturing costs nothing while disabled.
+void SetEnabled(bool enabled);
+bool IsEnabled();
+
+// Called on the GE thread at flush boundaries.
+void CaptureAtFlush(int listID, int listState, u32 startPC, u32 pc, u32 stall);
+
+// Copies out the most recent consistent snapshot without blocking the GE
+// thread. Safe to call from any thread; returns false if nothing has been
+// captured yet.
+bool GetLatest(Snapshot *out);
+
+}  // namespace GeSnapshot
@@ -47,7 +47,8 @@ static const char *HEADER = "PPSSPPGE";
 // Version 1: Uncompressed
 // Version 2: Uses snappy
 // Version 3: Adds FRAMEBUF0-FRAMEBUF9
-static const int VERSION = 3;
+// Version 4: Pushbuf stored as a series of compressed chunks
+static const int VERSION = 4;
 static const int MIN_VERSION = 2;
 
 static bool active = false;
@@ -102,6 +103,15 @@ static std::vector<u32> lastRegisters;
 static std::vector<u32> lastTextures;
 static std::set<u32> lastRenderTargets;
 
+// A frame with all its textures can easily stage hundreds of MB.  To keep the
+// recording footprint bounded, the pushbuf is spilled to a temp file in
+// compressed chunks once it grows past this.  Command ptrs are offsets into
+// the full logical pushbuf - pushbufSpilled is how much has left RAM already.
+static const size_t PUSHBUF_SPILL_THRESHOLD = 16 * 1024 * 1024;
+static u32 pushbufSpilled = 0;
+static FILE *spillFile = nullptr;
+static std::string spillFilename;
+
 // TODO: Maybe move execute to another file?
 class DumpExecute {
 public:
@@ -359,16 +369,68 @@ bool BufMapping::SlabInfo::Setup(u32 bufpos) {
 
 int BufMapping::slabGeneration_ = 0;
 
+static void WriteCompressedChunk(FILE *fp, const void *p, size_t sz) {
+	size_t compressed_size = snappy_max_compressed_length(sz);
+	u8 *compressed = new u8[compressed_size];
+	snappy_compress((const char *)p, sz, (char *)compressed, &compressed_size);
+
+	u32 write_size = (u32)compressed_size;
+	u32 raw_size = (u32)sz;
+	fwrite(&write_size, sizeof(write_size), 1, fp);
+	fwrite(&raw_size, sizeof(raw_size), 1, fp);
+	fwrite(compressed, compressed_size, 1, fp);
+
+	delete [] compressed;
+}
+
+static void DiscardSpill() {
+	if (spillFile) {
+		fclose(spillFile);
+		spillFile = nullptr;
+	}
+	if (!spillFilename.empty()) {
+		File::Delete(spillFilename);
+		spillFilename.clear();
+	}
+	pushbufSpilled = 0;
+}
+
+static void SpillPushbuf() {
+	if (pushbuf.size() < PUSHBUF_SPILL_THRESHOLD) {
+		return;
+	}
+
+	if (!spillFile) {
+		const std::string dumpDir = GetSysDirectory(DIRECTORY_DUMP);
+		File::CreateFullPath(dumpDir);
+		spillFilename = dumpDir + ".recording.spill.tmp";
+		spillFile = File::OpenCFile(spillFilename, "wb");
+		if (!spillFile) {
+			// Couldn't open - keep staging in RAM like before.
+			spillFilename.clear();
+			return;
+		}
+	}
+
+	WriteCompressedChunk(spillFile, pushbuf.data(), pushbuf.size());
+	pushbufSpilled += (u32)pushbuf.size();
+	pushbuf.clear();
+	// These pointed into the spilled portion, which we can no longer compare against.
+	lastTextures.clear();
+}
+
 static void FlushRegisters() {
 	if (!lastRegisters.empty()) {
 		Command last{CommandType::REGISTERS};
-		last.ptr = (u32)pushbuf.size();
+		u32 writePtr = (u32)pushbuf.size();
+		last.ptr = pushbufSpilled + writePtr;
 		last.sz = (u32)(lastRegisters.size() * sizeof(u32));
 		pushbuf.resize(pushbuf.size() + last.sz);
-		memcpy(pushbuf.data() + last.ptr, lastRegisters.data(), last.sz);
+		memcpy(pushbuf.data() + writePtr, lastRegisters.data(), last.sz);
 		lastRegisters.clear();
 
 		commands.push_back(last);
+		SpillPushbuf();
 	}
 }
 
@@ -394,6 +456,7 @@ static void BeginRecording() {
 	lastTextures.clear();
 	lastRenderTargets.clear();
 	flipLastAction = gpuStats.numFlips;
+	DiscardSpill();
 
 	u32 ptr = (u32)pushbuf.size();
 	u32 sz = 512 * 4;
@@ -428,13 +491,32 @@ static std::string WriteRecording() {
 
 	u32 sz = (u32)commands.size();
 	fwrite(&sz, sizeof(sz), 1, fp);
-	u32 bufsz = (u32)pushbuf.size();
+	u32 bufsz = pushbufSpilled + (u32)pushbuf.size();
 	fwrite(&bufsz, sizeof(bufsz), 1, fp);
 
 	WriteCompressed(fp, commands.data(), commands.size() * sizeof(Command));
-	WriteCompressed(fp, pushbuf.data(), bufsz);
+
+	// The pushbuf is a series of chunks - first anything already spilled, then the tail.
+	if (spillFile) {
+		fclose(spillFile);
+		spillFile = nullptr;
+
+		FILE *spill = File::OpenCFile(spillFilename, "rb");
+		if (spill) {
+			u8 copybuf[65536];
+			size_t n;
+			while ((n = fread(copybuf, 1, sizeof(copybuf), spill)) > 0) {
+				fwrite(copybuf, 1, n, fp);
+			}
+			fclose(spill);
+		}
+	}
+	if (!pushbuf.empty()) {
+		WriteCompressedChunk(fp, pushbuf.data(), pushbuf.size());
+	}
 
 	fclose(fp);
+	DiscardSpill();
 
 	return filename;
 }
@@ -504,23 +586,25 @@ static Command EmitCommandWithRAM(CommandType t, const void *p, u32 sz) {
 		}
 
 		if (prev) {
-			cmd.ptr = (u32)(prev - pushbuf.data());
+			cmd.ptr = pushbufSpilled + (u32)(prev - pushbuf.data());
 		} else {
-			cmd.ptr = (u32)pushbuf.size();
+			u32 writePtr = (u32)pushbuf.size();
 			int pad = 0;
-			if (cmd.ptr & 0xF) {
-				pad = 0x10 - (cmd.ptr & 0xF);
-				cmd.ptr += pad;
+			if ((pushbufSpilled + writePtr) & 0xF) {
+				pad = 0x10 - ((pushbufSpilled + writePtr) & 0xF);
+				writePtr += pad;
 			}
+			cmd.ptr = pushbufSpilled + writePtr;
 			pushbuf.resize(pushbuf.size() + sz + pad);
 			if (pad) {
-				memset(pushbuf.data() + cmd.ptr - pad, 0, pad);
+				memset(pushbuf.data() + writePtr - pad, 0, pad);
 			}
-			memcpy(pushbuf.data() + cmd.ptr, p, sz);
+			memcpy(pushbuf.data() + writePtr, p, sz);
 		}
 	}
 
 	commands.push_back(cmd);
+	SpillPushbuf();
 
 	return cmd;
 }
@@ -565,11 +649,15 @@ static void EmitTextureData(int level, u32 texaddr) {
 
 		// Dumps are huge - let's try to find this already emitted.
 		for (u32 prevptr : lastTextures) {
-			if (pushbuf.size() < prevptr + bytes) {
+			if (prevptr < pushbufSpilled) {
+				continue;
+			}
+			const u32 localptr = prevptr - pushbufSpilled;
+			if (pushbuf.size() < localptr + bytes) {
 				continue;
 			}
 
-			if (memcmp(pushbuf.data() + prevptr, p, bytes) == 0) {
+			if (memcmp(pushbuf.data() + localptr, p, bytes) == 0) {
 				commands.push_back({type, bytes, prevptr});
 				// Okay, that was easy.  Bail out.
 				return;
@@ -1211,6 +1299,42 @@ static bool ReadCompressed(u32 fp, void *dest, size_t sz) {
 	return real_size == sz;
 }
 
+// Version 4 and up store the pushbuf as a series of chunks, each prefixed
+// with its compressed and raw sizes, so recording doesn't need it all in RAM.
+static bool ReadCompressedChunks(u32 fp, u8 *dest, size_t sz) {
+	size_t offset = 0;
+	while (offset < sz) {
+		u32 compressed_size = 0;
+		if (pspFileSystem.ReadFile(fp, (u8 *)&compressed_size, sizeof(compressed_size)) != sizeof(compressed_size)) {
+			return false;
+		}
+		u32 raw_size = 0;
+		if (pspFileSystem.ReadFile(fp, (u8 *)&raw_size, sizeof(raw_size)) != sizeof(raw_size)) {
+			return false;
+		}
+		if (offset + raw_size > sz) {
+			return false;
+		}
+
+		u8 *compressed = new u8[compressed_size];
+		if (pspFileSystem.ReadFile(fp, compressed, compressed_size) != compressed_size) {
+			delete [] compressed;
+			return false;
+		}
+
+		size_t real_size = raw_size;
+		snappy_uncompress((const char *)compressed, compressed_size, (char *)(dest + offset), &real_size);
+		delete [] compressed;
+
+		if (real_size != raw_size) {
+			return false;
+		}
+		offset += raw_size;
+	}
+
+	return true;
+}
+
 bool RunMountedReplay(const std::string &filename) {
 	_assert_msg_(SYSTEM, !active && !nextFrame, "Cannot run replay while recording.");
 
@@ -1236,7 +1360,11 @@ bool RunMountedReplay(const std::string &filename) {
 
 	bool truncated = false;
 	truncated = truncated || !ReadCompressed(fp, commands.data(), sizeof(Command) * sz);
-	truncated = truncated || !ReadCompressed(fp, pushbuf.data(), bufsz);
+	if (version >= 4) {
+		truncated = truncated || !ReadCompressedChunks(fp, pushbuf.data(), bufsz);
+	} else {
+		truncated = truncated || !ReadCompressed(fp, pushbuf.data(), bufsz);
+	}
 
 	pspFileSystem.CloseFile(fp);
 
@@ -17,6 +17,7 @@
 
 #include "base/logging.h"
 #include "base/timeutil.h"
+#include "profiler/profiler.h"
 
 #include "Common/MemoryUtil.h"
 #include "Core/MemMap.h"
@@ -123,12 +124,89 @@ DrawEngineDX9::~DrawEngineDX9() {
 	delete tessDataTransferDX9;
 }
 
-void DrawEngineDX9::InitDeviceObjects() {
+enum {
+	VERTEX_RING_SIZE = 4 * 1024 * 1024,
+	INDEX_RING_SIZE = 1 * 1024 * 1024,
+};
 
+void DrawEngineDX9::InitDeviceObjects() {
+	// The ring buffers themselves are created lazily on first use. Here we just
+	// check for stream offset support, which the ring draw path depends on.
+	D3DCAPS9 caps{};
+	if (SUCCEEDED(device_->GetDeviceCaps(&caps))) {
+		supportsStreamOffset_ = (caps.DevCaps2 & D3DDEVCAPS2_STREAMOFFSET) != 0;
+	} else {
+		supportsStreamOffset_ = false;
+	}
 }
 
 void DrawEngineDX9::DestroyDeviceObjects() {
 	ClearTrackedVertexArrays();
+	if (ringVB_) {
+		ringVB_->Release();
+		ringVB_ = nullptr;
+	}
+	if (ringIB_) {
+		ringIB_->Release();
+		ringIB_ = nullptr;
+	}
+	ringVBOffset_ = 0;
+	ringIBOffset_ = 0;
+}
+
+// Copies a draw's vertices into the dynamic ring, returning the byte offset to
+// bind with SetStreamSource. NOOVERWRITE appends behind draws still in flight;
+// when the ring wraps we DISCARD, which hands us a fresh buffer alias without
+// stalling on the GPU. Returns false if the ring path can't be used, in which
+// case the caller falls back to DrawPrimitiveUP.
+bool DrawEngineDX9::UploadVertices(const void *vdata, u32 size, u32 *byteOffset) {
+	if (!supportsStreamOffset_ || size > VERTEX_RING_SIZE)
+		return false;
+	if (!ringVB_) {
+		if (FAILED(device_->CreateVertexBuffer(VERTEX_RING_SIZE, D3DUSAGE_DYNAMIC | D3DUSAGE_WRITEONLY, 0, D3DPOOL_DEFAULT, &ringVB_, nullptr))) {
+			ringVB_ = nullptr;
+			return false;
+		}
+	}
+	DWORD flags = D3DLOCK_NOOVERWRITE;
+	if (ringVBOffset_ + size > VERTEX_RING_SIZE) {
+		flags = D3DLOCK_DISCARD;
+		ringVBOffset_ = 0;
+	}
+	void *dest;
+	if (FAILED(ringVB_->Lock(ringVBOffset_, size, &dest, flags)))
+		return false;
+	memcpy(dest, vdata, size);
+	ringVB_->Unlock();
+	*byteOffset = ringVBOffset_;
+	// Keep the next draw's start nicely aligned.
+	ringVBOffset_ += (size + 15) & ~15;
+	return true;
+}
+
+bool DrawEngineDX9::UploadIndices(const u16 *inds, u32 count, u32 *startIndex) {
+	u32 size = count * sizeof(u16);
+	if (!supportsStreamOffset_ || size > INDEX_RING_SIZE)
+		return false;
+	if (!ringIB_) {
+		if (FAILED(device_->CreateIndexBuffer(INDEX_RING_SIZE, D3DUSAGE_DYNAMIC | D3DUSAGE_WRITEONLY, D3DFMT_INDEX16, D3DPOOL_DEFAULT, &ringIB_, nullptr))) {
+			ringIB_ = nullptr;
+			return false;
+		}
+	}
+	DWORD flags = D3DLOCK_NOOVERWRITE;
+	if (ringIBOffset_ + size > INDEX_RING_SIZE) {
+		flags = D3DLOCK_DISCARD;
+		ringIBOffset_ = 0;
+	}
+	void *dest;
+	if (FAILED(ringIB_->Lock(ringIBOffset_, size, &dest, flags)))
+		return false;
+	memcpy(dest, inds, size);
+	ringIB_->Unlock();
+	*startIndex = ringIBOffset_ / sizeof(u16);
+	ringIBOffset_ += (size + 15) & ~15;
+	return true;
 }
 
 struct DeclTypeInfo {
@@ -302,7 +380,9 @@ static uint32_t SwapRB(uint32_t c) {
 
 // The inline wrapper in the header checks for numDrawCalls == 0
 void DrawEngineDX9::DoFlush() {
+	PROFILE_THIS_SCOPE("flush");
 	gpuStats.numFlushes++;
+	AccountFlushReason();
 	gpuStats.numTrackedVertexArrays = (int)vai_.size();
 
 	// This is not done on every drawcall, we should collect vertex data
@@ -328,7 +408,9 @@ void DrawEngineDX9::DoFlush() {
 			useCache = false;
 
 		if (useCache) {
-			u32 id = dcid_ ^ gstate.getUVGenMode();  // This can have an effect on which UV decoder we need to use! And hence what the decoded data will look like. See #9263
+			// Any state mashed into the decoder ID affects what the decoded data will
+			// look like (UV gen mode, dead attributes...), so key on all of it. See #9263.
+			u32 id = dcid_ ^ dec_->VertexType();
 			VertexArrayInfoDX9 *vai = vai_.Get(id);
 			if (!vai) {
 				vai = new VertexArrayInfoDX9();
@@ -498,10 +580,23 @@ rotateVBO:
 		if (pHardwareVertexDecl) {
 			device_->SetVertexDeclaration(pHardwareVertexDecl);
 			if (vb_ == NULL) {
+				const u32 stride = dec_->GetDecVtxFmt().stride;
+				u32 vbOffset, ibStart;
 				if (useElements) {
-					device_->DrawIndexedPrimitiveUP(glprim[prim], 0, maxIndex + 1, D3DPrimCount(glprim[prim], vertexCount), decIndex, D3DFMT_INDEX16, decoded, dec_->GetDecVtxFmt().stride);
+					if (UploadVertices(decoded, stride * (maxIndex + 1), &vbOffset) && UploadIndices(decIndex, vertexCount, &ibStart)) {
+						device_->SetStreamSource(0, ringVB_, vbOffset, stride);
+						device_->SetIndices(ringIB_);
+						device_->DrawIndexedPrimitive(glprim[prim], 0, 0, maxIndex + 1, ibStart, D3DPrimCount(glprim[prim], vertexCount));
+					} else {
+						device_->DrawIndexedPrimitiveUP(glprim[prim], 0, maxIndex + 1, D3DPrimCount(glprim[prim], vertexCount), decIndex, D3DFMT_INDEX16, decoded, stride);
+					}
 				} else {
-					device_->DrawPrimitiveUP(glprim[prim], D3DPrimCount(glprim[prim], vertexCount), decoded, dec_->GetDecVtxFmt().stride);
+					if (UploadVertices(decoded, stride * vertexCount, &vbOffset)) {
+						device_->SetStreamSource(0, ringVB_, vbOffset, stride);
+						device_->DrawPrimitive(glprim[prim], 0, D3DPrimCount(glprim[prim], vertexCount));
+					} else {
+						device_->DrawPrimitiveUP(glprim[prim], D3DPrimCount(glprim[prim], vertexCount), decoded, stride);
+					}
 				}
 			} else {
 				device_->SetStreamSource(0, vb_, 0, dec_->GetDecVtxFmt().stride);
@@ -567,10 +662,22 @@ rotateVBO:
 			const int vertexSize = sizeof(transformed[0]);
 
 			device_->SetVertexDeclaration(transformedVertexDecl_);
+			u32 vbOffset, ibStart;
 			if (drawIndexed) {
-				device_->DrawIndexedPrimitiveUP(glprim[prim], 0, maxIndex, D3DPrimCount(glprim[prim], numTrans), inds, D3DFMT_INDEX16, drawBuffer, sizeof(TransformedVertex));
+				if (UploadVertices(drawBuffer, sizeof(TransformedVertex) * maxIndex, &vbOffset) && UploadIndices(inds, numTrans, &ibStart)) {
+					device_->SetStreamSource(0, ringVB_, vbOffset, sizeof(TransformedVertex));
+					device_->SetIndices(ringIB_);
+					device_->DrawIndexedPrimitive(glprim[prim], 0, 0, maxIndex, ibStart, D3DPrimCount(glprim[prim], numTrans));
+				} else {
+					device_->DrawIndexedPrimitiveUP(glprim[prim], 0, maxIndex, D3DPrimCount(glprim[prim], numTrans), inds, D3DFMT_INDEX16, drawBuffer, sizeof(TransformedVertex));
+				}
 			} else {
-				device_->DrawPrimitiveUP(glprim[prim], D3DPrimCount(glprim[prim], numTrans), drawBuffer, sizeof(TransformedVertex));
+				if (UploadVertices(drawBuffer, sizeof(TransformedVertex) * numTrans, &vbOffset)) {
+					device_->SetStreamSource(0, ringVB_, vbOffset, sizeof(TransformedVertex));
+					device_->DrawPrimitive(glprim[prim], 0, D3DPrimCount(glprim[prim], numTrans));
+				} else {
+					device_->DrawPrimitiveUP(glprim[prim], D3DPrimCount(glprim[prim], numTrans), drawBuffer, sizeof(TransformedVertex));
+				}
 			}
 		} else if (result.action == SW_CLEAR) {
 			u32 clearColor = result.color;
@@ -151,8 +151,19 @@ private:
 
 	void MarkUnreliable(VertexArrayInfoDX9 *vai);
 
+	// Dynamic ring buffer uploads, so uncached draws don't have to go through
+	// DrawPrimitiveUP (which makes the runtime copy the data on every draw.)
+	bool UploadVertices(const void *vdata, u32 size, u32 *byteOffset);
+	bool UploadIndices(const u16 *inds, u32 count, u32 *startIndex);
+
 	LPDIRECT3DDEVICE9 device_ = nullptr;
 
+	LPDIRECT3DVERTEXBUFFER9 ringVB_ = nullptr;
+	LPDIRECT3DINDEXBUFFER9 ringIB_ = nullptr;
+	u32 ringVBOffset_ = 0;
+	u32 ringIBOffset_ = 0;
+	bool supportsStreamOffset_ = false;
+
 	PrehashMap<VertexArrayInfoDX9 *, nullptr> vai_;
 	DenseHashMap<u32, IDirect3DVertexDeclaration9 *, nullptr> vertexDeclMap_;
 
@@ -251,10 +251,13 @@ void GPU_DX9::DeviceLost() {
 	shaderManagerDX9_->ClearCache(false);
 	textureCacheDX9_->Clear(false);
 	framebufferManagerDX9_->DeviceLost();
+	// Releases the POOL_DEFAULT ring buffers and cached vertex arrays, required
+	// before the device can be reset.
+	drawEngine_.DestroyDeviceObjects();
 }
 
 void GPU_DX9::DeviceRestore() {
-	// Nothing needed.
+	drawEngine_.InitDeviceObjects();
 }
 
 void GPU_DX9::InitClear() {
@@ -336,6 +339,7 @@ inline void GPU_DX9::CheckFlushOp(int cmd, u32 diff) {
 		if (dumpThisFrame_) {
 			NOTICE_LOG(G3D, "================ FLUSH ================");
 		}
+		drawEngine_.SetFlushReason(FlushReasonFromCommand(cmd));
 		drawEngine_.Flush();
 	}
 }
@@ -361,6 +365,9 @@ void GPU_DX9::GetStats(char *buffer, size_t bufsize) {
 	float vertexAverageCycles = gpuStats.numVertsSubmitted > 0 ? (float)gpuStats.vertexGPUCycles / (float)gpuStats.numVertsSubmitted : 0.0f;
 	snprintf(buffer, bufsize - 1,
 		"DL processing time: %0.2f ms\n"
+		"Vertex, Texture decode: %0.2f ms, %0.2f ms\n"
+		"Readback time: %0.2f ms\n"
+		"Shader compiles: %i\n"
 		"Draw calls: %i, flushes %i, clears %i\n"
 		"Cached Draw calls: %i\n"
 		"Num Tracked Vertex Arrays: %i\n"
@@ -373,6 +380,10 @@ void GPU_DX9::GetStats(char *buffer, size_t bufsize) {
 		"Readbacks: %d, uploads: %d\n"
 		"Vertex, Fragment shaders loaded: %i, %i\n",
 		gpuStats.msProcessingDisplayLists * 1000.0f,
+		gpuStats.msVertexDecode * 1000.0f,
+		gpuStats.msTextureDecode * 1000.0f,
+		gpuStats.msReadbacks * 1000.0f,
+		gpuStats.numShaderCompiles,
 		gpuStats.numDrawCalls,
 		gpuStats.numFlushes,
 		gpuStats.numClears,
@@ -580,6 +580,7 @@ VSShader *ShaderManagerDX9::ApplyShader(int prim, u32 vertType) {
 		// Vertex shader not in cache. Let's compile it.
 		GenerateVertexShaderHLSL(VSID, codeBuffer_);
 		vs = new VSShader(device_, VSID, codeBuffer_, useHWTransform);
+		gpuStats.numShaderCompiles++;
 
 		if (vs->Failed()) {
 			I18NCategory *gr = GetI18NCategory("Graphics");
@@ -598,6 +599,7 @@ VSShader *ShaderManagerDX9::ApplyShader(int prim, u32 vertType) {
 			// Can still work with software transform.
 			GenerateVertexShaderHLSL(VSID, codeBuffer_);
 			vs = new VSShader(device_, VSID, codeBuffer_, false);
+			gpuStats.numShaderCompiles++;
 		}
 
 		vsCache_[VSID] = vs;
@@ -613,6 +615,7 @@ VSShader *ShaderManagerDX9::ApplyShader(int prim, u32 vertType) {
 		GenerateFragmentShaderHLSL(FSID, codeBuffer_);
 		fs = new PSShader(device_, FSID, codeBuffer_);
 		fsCache_[FSID] = fs;
+		gpuStats.numShaderCompiles++;
 	} else {
 		fs = fsIter->second;
 	}
@@ -226,6 +226,7 @@ void TextureCacheDX9::StartFrame() {
 		// INFO_LOG(G3D, "Scaled %i texels", texelsScaledThisFrame_);
 	}
 	texelsScaledThisFrame_ = 0;
+	texelsBuiltThisFrame_ = 0;
 	if (clearCacheNextFrame_) {
 		Clear(true);
 		clearCacheNextFrame_ = false;
@@ -534,6 +535,13 @@ void TextureCacheDX9::BuildTexture(TexCacheEntry *const entry) {
 	int w = gstate.getTextureWidth(0);
 	int h = gstate.getTextureHeight(0);
 	ReplacedTexture &replaced = replacer_.FindReplacement(cachekey, entry->fullhash, w, h);
+	if (replaced.IsPending()) {
+		// Decode is in flight on the background loader - build the original texture now
+		// and swap the replacement in on a later frame, like deferred scaling.
+		entry->status |= TexCacheEntry::STATUS_TO_REPLACE;
+	} else {
+		entry->status &= ~TexCacheEntry::STATUS_TO_REPLACE;
+	}
 	if (replaced.GetSize(0, w, h)) {
 		// We're replacing, so we won't scale.
 		scaleFactor = 1;
@@ -552,7 +560,10 @@ void TextureCacheDX9::BuildTexture(TexCacheEntry *const entry) {
 	}
 
 	if (scaleFactor != 1) {
-		if (texelsScaledThisFrame_ >= TEXCACHE_MAX_TEXELS_SCALED) {
+		// With deferred loads on, never scale on the very first build - upload the
+		// unscaled texture right away and swap in the scaled one on a later frame.
+		const bool deferScale = g_Config.bDeferTextureLoads && entry->numFrames == 0;
+		if (deferScale || texelsScaledThisFrame_ >= TEXCACHE_MAX_TEXELS_SCALED) {
 			entry->status |= TexCacheEntry::STATUS_TO_SCALE;
 			scaleFactor = 1;
 		} else {
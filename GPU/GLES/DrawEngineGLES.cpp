@@ -303,6 +303,7 @@ void DrawEngineGLES::DoFlush() {
 	FrameData &frameData = frameData_[render_->GetCurFrame()];
 	
 	gpuStats.numFlushes++;
+	AccountFlushReason();
 	gpuStats.numTrackedVertexArrays = (int)vai_.size();
 
 	bool textureNeedsApply = false;
@@ -339,7 +340,9 @@ void DrawEngineGLES::DoFlush() {
 		useCache = false;
 
 		if (useCache) {
-			u32 id = dcid_ ^ gstate.getUVGenMode();  // This can have an effect on which UV decoder we need to use! And hence what the decoded data will look like. See #9263
+			// Any state mashed into the decoder ID affects what the decoded data will
+			// look like (UV gen mode, dead attributes...), so key on all of it. See #9263.
+			u32 id = dcid_ ^ dec_->VertexType();
 			VertexArrayInfo *vai = vai_.Get(id);
 			if (!vai) {
 				vai = new VertexArrayInfo();
@@ -387,14 +390,16 @@ void DrawEngineGLES::DoFlush() {
 						if (vai->numVerts > 64) {
 							// exponential backoff up to 16 draws, then every 32
 							vai->drawsUntilNextFullHash = std::min(32, vai->numFrames);
+							// Once it's been stable this long, stop full-hashing. The sampled
+							// hash keeps running in VAI_RELIABLE as a safety net.
+							if (vai->numFrames > VAI_RELIABLE_AFTER_FRAMES) {
+								vai->status = VertexArrayInfo::VAI_RELIABLE;
+								vai->drawsUntilNextFullHash = VAI_RELIABLE_MINIHASH_INTERVAL;
+							}
 						} else {
 							// Lower numbers seem much more likely to change.
 							vai->drawsUntilNextFullHash = 0;
 						}
-						// TODO: tweak
-						//if (vai->numFrames > 1000) {
-						//	vai->status = VertexArrayInfo::VAI_RELIABLE;
-						//}
 					} else {
 						vai->drawsUntilNextFullHash--;
 						u32 newMiniHash = ComputeMiniHash();
@@ -445,13 +450,23 @@ void DrawEngineGLES::DoFlush() {
 					break;
 				}
 
-				// Reliable - we don't even bother hashing anymore. Right now we don't go here until after a very long time.
+				// Reliable - we've stopped full hashing, but the cheap sampled hash still
+				// runs every now and then so a mesh that changes after a long static period
+				// gets kicked out instead of staying wrong forever.
 			case VertexArrayInfo::VAI_RELIABLE:
 				{
 					vai->numDraws++;
 					if (vai->lastFrame != gpuStats.numFlips) {
 						vai->numFrames++;
 					}
+					if (--vai->drawsUntilNextFullHash == 0) {
+						vai->drawsUntilNextFullHash = VAI_RELIABLE_MINIHASH_INTERVAL;
+						if (ComputeMiniHash() != vai->minihash) {
+							MarkUnreliable(vai);
+							DecodeVerts(decoded);
+							goto rotateVBO;
+						}
+					}
 					gpuStats.numCachedDrawCalls++;
 					gpuStats.numCachedVertsDrawn += vai->numVerts;
 					vertexBuffer = vai->vbo;
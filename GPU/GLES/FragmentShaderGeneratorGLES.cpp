@@ -159,6 +159,7 @@ bool GenerateFragmentShader(const FShaderID &id, char *buffer, uint64_t *uniform
 	bool doTextureAlpha = id.Bit(FS_BIT_TEXALPHA);
 	bool doFlatShading = id.Bit(FS_BIT_FLATSHADE);
 	bool shaderDepal = id.Bit(FS_BIT_SHADER_DEPAL);
+	bool uberAlphaTest = id.Bit(FS_BIT_UBER_ALPHA_TEST);
 
 	GEComparison alphaTestFunc = (GEComparison)id.Bits(FS_BIT_ALPHA_TEST_FUNC, 3);
 	GEComparison colorTestFunc = (GEComparison)id.Bits(FS_BIT_COLOR_TEST_FUNC, 2);
@@ -216,6 +217,9 @@ bool GenerateFragmentShader(const FShaderID &id, char *buffer, uint64_t *uniform
 		} else {
 			*uniformMask |= DIRTY_ALPHACOLORREF;
 			WRITE(p, "uniform vec4 u_alphacolorref;\n");
+			if (uberAlphaTest) {
+				WRITE(p, "uniform int u_alphaTestFunc;\n");
+			}
 			if (bitwiseOps && ((enableColorTest && !colorTestAgainstZero) || (enableAlphaTest && !alphaTestAgainstZero))) {
 				*uniformMask |= DIRTY_ALPHACOLORMASK;
 				WRITE(p, "uniform ivec4 u_alphacolormask;\n");
@@ -554,6 +558,30 @@ bool GenerateFragmentShader(const FShaderID &id, char *buffer, uint64_t *uniform
 			} else if (g_Config.bFragmentTestCache) {
 				WRITE(p, "  float aResult = %s(testtex, vec2(%s, 0)).a;\n", texture, alphaTestXCoord.c_str());
 				WRITE(p, "  if (aResult < 0.5) %s\n", discardStatement);
+			} else if (uberAlphaTest) {
+				// The test function comes from a uniform, so one shader covers all of them.
+				// Same comparisons as the specialized variants below, expressed through the
+				// sign of (value - ref). GE_COMP_ALWAYS (1) falls through without failing.
+				if (bitwiseOps) {
+					WRITE(p, "  int aDiff = (roundAndScaleTo255i(v.a) & u_alphacolormask.a) - int(u_alphacolorref.a);\n");
+					WRITE(p, "  bool aFail = u_alphaTestFunc == 0;\n");  // GE_COMP_NEVER
+					WRITE(p, "  if (u_alphaTestFunc == 2) aFail = aDiff != 0;\n");
+					WRITE(p, "  else if (u_alphaTestFunc == 3) aFail = aDiff == 0;\n");
+					WRITE(p, "  else if (u_alphaTestFunc == 4) aFail = aDiff >= 0;\n");
+					WRITE(p, "  else if (u_alphaTestFunc == 5) aFail = aDiff > 0;\n");
+					WRITE(p, "  else if (u_alphaTestFunc == 6) aFail = aDiff <= 0;\n");
+					WRITE(p, "  else if (u_alphaTestFunc == 7) aFail = aDiff < 0;\n");
+				} else {
+					WRITE(p, "  float aDiff = roundAndScaleTo255f(v.a) - u_alphacolorref.a;\n");
+					WRITE(p, "  bool aFail = u_alphaTestFunc == 0;\n");  // GE_COMP_NEVER
+					WRITE(p, "  if (u_alphaTestFunc == 2) aFail = aDiff != 0.0;\n");
+					WRITE(p, "  else if (u_alphaTestFunc == 3) aFail = aDiff == 0.0;\n");
+					WRITE(p, "  else if (u_alphaTestFunc == 4) aFail = aDiff >= 0.0;\n");
+					WRITE(p, "  else if (u_alphaTestFunc == 5) aFail = aDiff > 0.0;\n");
+					WRITE(p, "  else if (u_alphaTestFunc == 6) aFail = aDiff <= 0.0;\n");
+					WRITE(p, "  else if (u_alphaTestFunc == 7) aFail = aDiff < 0.0;\n");
+				}
+				WRITE(p, "  if (aFail) %s\n", discardStatement);
 			} else {
 				const char *alphaTestFuncs[] = { "#", "#", " != ", " == ", " >= ", " > ", " <= ", " < " };
 				if (alphaTestFuncs[alphaTestFunc][0] != '#') {
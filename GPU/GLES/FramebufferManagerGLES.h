@@ -83,7 +83,7 @@ private:
 	void CompileDraw2DProgram();
 	void CompilePostShader();
 
-	void PackDepthbuffer(VirtualFramebuffer *vfb, int x, int y, int w, int h);
+	void PackDepthbuffer(VirtualFramebuffer *vfb, int x, int y, int w, int h) override;
 
 	GLRenderManager *render_;
 
@@ -104,6 +104,10 @@ GPU_GLES::GPU_GLES(GraphicsContext *gfxCtx, Draw::DrawContext *draw)
 		shaderCachePath_ = GetSysDirectory(DIRECTORY_APP_CACHE) + "/" + discID + ".glshadercache";
 		// Actually precompiled by IsReady() since we're single-threaded.
 		shaderManagerGL_->Load(shaderCachePath_);
+		// Unlike the ID cache above, the program binary cache (where the driver supports
+		// it) also skips the actual compile/link work on later runs, both during the
+		// precompile and when a game runs into a new shader combination mid-play.
+		render->SetProgramBinaryCacheFile(GetSysDirectory(DIRECTORY_APP_CACHE) + "/" + discID + ".glprogbin");
 	}
 
 	if (g_Config.bHardwareTessellation) {
@@ -418,6 +422,7 @@ void GPU_GLES::BeginFrame() {
 	}
 
 	shaderManagerGL_->DirtyShader();
+	shaderManagerGL_->CompileDeferredShaders();
 
 	// Not sure if this is really needed.
 	gstate_c.Dirty(DIRTY_ALL_UNIFORMS);
@@ -462,6 +467,7 @@ inline void GPU_GLES::CheckFlushOp(int cmd, u32 diff) {
 		if (dumpThisFrame_) {
 			NOTICE_LOG(G3D, "================ FLUSH ================");
 		}
+		drawEngine_.SetFlushReason(FlushReasonFromCommand(cmd));
 		drawEngine_.Flush();
 	}
 }
@@ -487,6 +493,9 @@ void GPU_GLES::GetStats(char *buffer, size_t bufsize) {
 	float vertexAverageCycles = gpuStats.numVertsSubmitted > 0 ? (float)gpuStats.vertexGPUCycles / (float)gpuStats.numVertsSubmitted : 0.0f;
 	snprintf(buffer, bufsize - 1,
 		"DL processing time: %0.2f ms\n"
+		"Vertex, Texture decode: %0.2f ms, %0.2f ms\n"
+		"Readback time: %0.2f ms\n"
+		"Shader compiles: %i\n"
 		"Draw calls: %i, flushes %i, clears %i\n"
 		"Cached Draw calls: %i\n"
 		"Num Tracked Vertex Arrays: %i\n"
@@ -497,8 +506,13 @@ void GPU_GLES::GetStats(char *buffer, size_t bufsize) {
 		"FBOs active: %i\n"
 		"Textures active: %i, decoded: %i  invalidated: %i\n"
 		"Readbacks: %d, uploads: %d\n"
+		"Cache memory: tex %d MB, fb %d MB (of %d MB)\n"
 		"Vertex, Fragment, Programs loaded: %i, %i, %i\n",
 		gpuStats.msProcessingDisplayLists * 1000.0f,
+		gpuStats.msVertexDecode * 1000.0f,
+		gpuStats.msTextureDecode * 1000.0f,
+		gpuStats.msReadbacks * 1000.0f,
+		gpuStats.numShaderCompiles,
 		gpuStats.numDrawCalls,
 		gpuStats.numFlushes,
 		gpuStats.numClears,
@@ -516,6 +530,9 @@ void GPU_GLES::GetStats(char *buffer, size_t bufsize) {
 		gpuStats.numTextureInvalidations,
 		gpuStats.numReadbacks,
 		gpuStats.numUploads,
+		(int)(gpuMemoryBudget.textureBytes >> 20),
+		(int)(gpuMemoryBudget.framebufferBytes >> 20),
+		(int)(gpuMemoryBudget.budgetBytes >> 20),
 		shaderManagerGL_->GetNumVertexShaders(),
 		shaderManagerGL_->GetNumFragmentShaders(),
 		shaderManagerGL_->GetNumPrograms());
@@ -19,6 +19,7 @@
 #include "Common/CommonWindows.h"
 #endif
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <map>
@@ -45,6 +46,7 @@
 #include "GPU/ge_constants.h"
 #include "GPU/Common/ShaderUniforms.h"
 #include "GPU/GLES/ShaderManagerGLES.h"
+#include "GPU/GLES/VertexShaderGeneratorGLES.h"
 #include "GPU/GLES/DrawEngineGLES.h"
 #include "GPU/GLES/FramebufferManagerGLES.h"
 
@@ -99,6 +101,7 @@ LinkedShader::LinkedShader(GLRenderManager *render, VShaderID VSID, Shader *vs,
 	queries.push_back({ &u_fogcoef, "u_fogcoef" });
 	queries.push_back({ &u_alphacolorref, "u_alphacolorref" });
 	queries.push_back({ &u_alphacolormask, "u_alphacolormask" });
+	queries.push_back({ &u_alphaTestFunc, "u_alphaTestFunc" });
 	queries.push_back({ &u_stencilReplaceValue, "u_stencilReplaceValue" });
 	queries.push_back({ &u_testtex, "testtex" });
 
@@ -121,14 +124,14 @@ LinkedShader::LinkedShader(GLRenderManager *render, VShaderID VSID, Shader *vs,
 	queries.push_back({ &u_cullRangeMin, "u_cullRangeMin" });
 	queries.push_back({ &u_cullRangeMax, "u_cullRangeMax" });
 
-#ifdef USE_BONE_ARRAY
-	queries.push_back({ &u_bone, "u_bone" });
-#else
-	static const char * const boneNames[8] = { "u_bone0", "u_bone1", "u_bone2", "u_bone3", "u_bone4", "u_bone5", "u_bone6", "u_bone7", };
-	for (int i = 0; i < 8; i++) {
-		queries.push_back({ &u_bone[i], boneNames[i] });
+	if (UseBoneArrayUniform()) {
+		queries.push_back({ &u_boneArray, "u_bone" });
+	} else {
+		static const char * const boneNames[8] = { "u_bone0", "u_bone1", "u_bone2", "u_bone3", "u_bone4", "u_bone5", "u_bone6", "u_bone7", };
+		for (int i = 0; i < 8; i++) {
+			queries.push_back({ &u_bone[i], boneNames[i] });
+		}
 	}
-#endif
 
 	// Lighting, texturing
 	queries.push_back({ &u_ambient, "u_ambient" });
@@ -282,222 +285,259 @@ void LinkedShader::use(const ShaderID &VSID) {
 	// Note that we no longer track attr masks here - we do it for the input layouts instead.
 }
 
+// Coarse groups of uniform dirty bits, so the typical flush skips whole
+// blocks below with one test instead of walking every DIRTY_ bit. A bit
+// handled inside a group's block must be part of that group's mask.
+static const u64 texStateUniforms = DIRTY_DEPAL | DIRTY_PROJMATRIX | DIRTY_PROJTHROUGHMATRIX |
+	DIRTY_TEXENV | DIRTY_ALPHACOLORREF | DIRTY_ALPHACOLORMASK | DIRTY_FOGCOLOR | DIRTY_FOGCOEF |
+	DIRTY_UVSCALEOFFSET | DIRTY_TEXCLAMP;
+static const u64 xformUniforms = DIRTY_WORLDMATRIX | DIRTY_VIEWMATRIX | DIRTY_TEXMATRIX |
+	DIRTY_DEPTHRANGE | DIRTY_CULLRANGE | DIRTY_STENCILREPLACEVALUE;
+static const u64 lightUniforms = DIRTY_ALL_LIGHTS | DIRTY_AMBIENT | DIRTY_MATAMBIENTALPHA |
+	DIRTY_MATDIFFUSE | DIRTY_MATEMISSIVE | DIRTY_MATSPECULAR;
+
 void LinkedShader::UpdateUniforms(u32 vertType, const ShaderID &vsid) {
 	u64 dirty = dirtyUniforms & availableUniforms;
 	dirtyUniforms = 0;
 	if (!dirty)
 		return;
 
-	if (dirty & DIRTY_DEPAL) {
-		int indexMask = gstate.getClutIndexMask();
-		int indexShift = gstate.getClutIndexShift();
-		int indexOffset = gstate.getClutIndexStartPos() >> 4;
-		int format = gstate_c.depalFramebufferFormat;
-		uint32_t val = BytesToUint32(indexMask, indexShift, indexOffset, format);
-		// Poke in a bilinear filter flag in the top bit.
-		val |= gstate.isMagnifyFilteringEnabled() << 31;
-		render_->SetUniformI1(&u_depal, val);
-	}
+	if (dirty & texStateUniforms) {
+		if (dirty & DIRTY_DEPAL) {
+			int indexMask = gstate.getClutIndexMask();
+			int indexShift = gstate.getClutIndexShift();
+			int indexOffset = gstate.getClutIndexStartPos() >> 4;
+			int format = gstate_c.depalFramebufferFormat;
+			uint32_t val = BytesToUint32(indexMask, indexShift, indexOffset, format);
+			// Poke in a bilinear filter flag in the top bit.
+			val |= gstate.isMagnifyFilteringEnabled() << 31;
+			render_->SetUniformI1(&u_depal, val);
+		}
 
-	// Update any dirty uniforms before we draw
-	if (dirty & DIRTY_PROJMATRIX) {
-		Matrix4x4 flippedMatrix;
-		memcpy(&flippedMatrix, gstate.projMatrix, 16 * sizeof(float));
+		// Update any dirty uniforms before we draw
+		if (dirty & DIRTY_PROJMATRIX) {
+			Matrix4x4 flippedMatrix;
+			memcpy(&flippedMatrix, gstate.projMatrix, 16 * sizeof(float));
 
-		bool useBufferedRendering = g_Config.iRenderingMode != FB_NON_BUFFERED_MODE;
+			bool useBufferedRendering = g_Config.iRenderingMode != FB_NON_BUFFERED_MODE;
 
-		const bool invertedY = useBufferedRendering ? (gstate_c.vpHeight < 0) : (gstate_c.vpHeight > 0);
-		if (invertedY) {
-			flippedMatrix[1] = -flippedMatrix[1];
-			flippedMatrix[5] = -flippedMatrix[5];
-			flippedMatrix[9] = -flippedMatrix[9];
-			flippedMatrix[13] = -flippedMatrix[13];
-		}
-		const bool invertedX = gstate_c.vpWidth < 0;
-		if (invertedX) {
-			flippedMatrix[0] = -flippedMatrix[0];
-			flippedMatrix[4] = -flippedMatrix[4];
-			flippedMatrix[8] = -flippedMatrix[8];
-			flippedMatrix[12] = -flippedMatrix[12];
-		}
+			const bool invertedY = useBufferedRendering ? (gstate_c.vpHeight < 0) : (gstate_c.vpHeight > 0);
+			if (invertedY) {
+				flippedMatrix[1] = -flippedMatrix[1];
+				flippedMatrix[5] = -flippedMatrix[5];
+				flippedMatrix[9] = -flippedMatrix[9];
+				flippedMatrix[13] = -flippedMatrix[13];
+			}
+			const bool invertedX = gstate_c.vpWidth < 0;
+			if (invertedX) {
+				flippedMatrix[0] = -flippedMatrix[0];
+				flippedMatrix[4] = -flippedMatrix[4];
+				flippedMatrix[8] = -flippedMatrix[8];
+				flippedMatrix[12] = -flippedMatrix[12];
+			}
 
-		// In Phantasy Star Portable 2, depth range sometimes goes negative and is clamped by glDepthRange to 0,
-		// causing graphics clipping glitch (issue #1788). This hack modifies the projection matrix to work around it.
-		if (gstate_c.Supports(GPU_USE_DEPTH_RANGE_HACK)) {
-			float zScale = gstate.getViewportZScale() / 65535.0f;
-			float zCenter = gstate.getViewportZCenter() / 65535.0f;
+			// In Phantasy Star Portable 2, depth range sometimes goes negative and is clamped by glDepthRange to 0,
+			// causing graphics clipping glitch (issue #1788). This hack modifies the projection matrix to work around it.
+			if (gstate_c.Supports(GPU_USE_DEPTH_RANGE_HACK)) {
+				float zScale = gstate.getViewportZScale() / 65535.0f;
+				float zCenter = gstate.getViewportZCenter() / 65535.0f;
 
-			// if far depth range < 0
-			if (zCenter + zScale < 0.0f) {
-				// if perspective projection
-				if (flippedMatrix[11] < 0.0f) {
-					float depthMax = gstate.getDepthRangeMax() / 65535.0f;
-					float depthMin = gstate.getDepthRangeMin() / 65535.0f;
+				// if far depth range < 0
+				if (zCenter + zScale < 0.0f) {
+					// if perspective projection
+					if (flippedMatrix[11] < 0.0f) {
+						float depthMax = gstate.getDepthRangeMax() / 65535.0f;
+						float depthMin = gstate.getDepthRangeMin() / 65535.0f;
 
-					float a = flippedMatrix[10];
-					float b = flippedMatrix[14];
+						float a = flippedMatrix[10];
+						float b = flippedMatrix[14];
 
-					float n = b / (a - 1.0f);
-					float f = b / (a + 1.0f);
+						float n = b / (a - 1.0f);
+						float f = b / (a + 1.0f);
 
-					f = (n * f) / (n + ((zCenter + zScale) * (n - f) / (depthMax - depthMin)));
+						f = (n * f) / (n + ((zCenter + zScale) * (n - f) / (depthMax - depthMin)));
 
-					a = (n + f) / (n - f);
-					b = (2.0f * n * f) / (n - f);
+						a = (n + f) / (n - f);
+						b = (2.0f * n * f) / (n - f);
 
-					if (!my_isnan(a) && !my_isnan(b)) {
-						flippedMatrix[10] = a;
-						flippedMatrix[14] = b;
+						if (!my_isnan(a) && !my_isnan(b)) {
+							flippedMatrix[10] = a;
+							flippedMatrix[14] = b;
+						}
 					}
 				}
 			}
-		}
 
-		ScaleProjMatrix(flippedMatrix);
+			ScaleProjMatrix(flippedMatrix);
 
-		render_->SetUniformM4x4(&u_proj, flippedMatrix.m);
-	}
-	if (dirty & DIRTY_PROJTHROUGHMATRIX)
-	{
-		Matrix4x4 proj_through;
-		bool useBufferedRendering = g_Config.iRenderingMode != FB_NON_BUFFERED_MODE;
-		if (useBufferedRendering) {
-			proj_through.setOrtho(0.0f, gstate_c.curRTWidth, 0.0f, gstate_c.curRTHeight, 0.0f, 1.0f);
-		} else {
-			proj_through.setOrtho(0.0f, gstate_c.curRTWidth, gstate_c.curRTHeight, 0.0f, 0.0f, 1.0f);
+			render_->SetUniformM4x4(&u_proj, flippedMatrix.m);
 		}
-		render_->SetUniformM4x4(&u_proj_through, proj_through.getReadPtr());
-	}
-	if (dirty & DIRTY_TEXENV) {
-		SetColorUniform3(render_, &u_texenv, gstate.texenvcolor);
-	}
-	if (dirty & DIRTY_ALPHACOLORREF) {
-		SetColorUniform3Alpha255(render_, &u_alphacolorref, gstate.getColorTestRef(), gstate.getAlphaTestRef() & gstate.getAlphaTestMask());
-	}
-	if (dirty & DIRTY_ALPHACOLORMASK) {
-		SetColorUniform3iAlpha(render_, &u_alphacolormask, gstate.colortestmask, gstate.getAlphaTestMask());
-	}
-	if (dirty & DIRTY_FOGCOLOR) {
-		SetColorUniform3(render_, &u_fogcolor, gstate.fogcolor);
-	}
-	if (dirty & DIRTY_FOGCOEF) {
-		float fogcoef[2] = {
-			getFloat24(gstate.fog1),
-			getFloat24(gstate.fog2),
-		};
-		// The PSP just ignores infnan here (ignoring IEEE), so take it down to a valid float.
-		// Workaround for https://github.com/hrydgard/ppsspp/issues/5384#issuecomment-38365988
-		if (my_isnanorinf(fogcoef[0])) {
-			// Not really sure what a sensible value might be, but let's try 64k.
-			fogcoef[0] = std::signbit(fogcoef[0]) ? -65535.0f : 65535.0f;
+		if (dirty & DIRTY_PROJTHROUGHMATRIX)
+		{
+			Matrix4x4 proj_through;
+			bool useBufferedRendering = g_Config.iRenderingMode != FB_NON_BUFFERED_MODE;
+			if (useBufferedRendering) {
+				proj_through.setOrtho(0.0f, gstate_c.curRTWidth, 0.0f, gstate_c.curRTHeight, 0.0f, 1.0f);
+			} else {
+				proj_through.setOrtho(0.0f, gstate_c.curRTWidth, gstate_c.curRTHeight, 0.0f, 0.0f, 1.0f);
+			}
+			render_->SetUniformM4x4(&u_proj_through, proj_through.getReadPtr());
 		}
-		if (my_isnanorinf(fogcoef[1])) {
-			fogcoef[1] = std::signbit(fogcoef[1]) ? -65535.0f : 65535.0f;
+		if (dirty & DIRTY_TEXENV) {
+			SetColorUniform3(render_, &u_texenv, gstate.texenvcolor);
+		}
+		if (dirty & DIRTY_ALPHACOLORREF) {
+			SetColorUniform3Alpha255(render_, &u_alphacolorref, gstate.getColorTestRef(), gstate.getAlphaTestRef() & gstate.getAlphaTestMask());
+			if (u_alphaTestFunc != -1) {
+				// Uber shaders branch on the test function instead of baking it in.
+				render_->SetUniformI1(&u_alphaTestFunc, (int)gstate.getAlphaTestFunction());
+			}
+		}
+		if (dirty & DIRTY_ALPHACOLORMASK) {
+			SetColorUniform3iAlpha(render_, &u_alphacolormask, gstate.colortestmask, gstate.getAlphaTestMask());
+		}
+		if (dirty & DIRTY_FOGCOLOR) {
+			SetColorUniform3(render_, &u_fogcolor, gstate.fogcolor);
+		}
+		if (dirty & DIRTY_FOGCOEF) {
+			float fogcoef[2] = {
+				getFloat24(gstate.fog1),
+				getFloat24(gstate.fog2),
+			};
+			// The PSP just ignores infnan here (ignoring IEEE), so take it down to a valid float.
+			// Workaround for https://github.com/hrydgard/ppsspp/issues/5384#issuecomment-38365988
+			if (my_isnanorinf(fogcoef[0])) {
+				// Not really sure what a sensible value might be, but let's try 64k.
+				fogcoef[0] = std::signbit(fogcoef[0]) ? -65535.0f : 65535.0f;
+			}
+			if (my_isnanorinf(fogcoef[1])) {
+				fogcoef[1] = std::signbit(fogcoef[1]) ? -65535.0f : 65535.0f;
+			}
+			render_->SetUniformF(&u_fogcoef, 2, fogcoef);
 		}
-		render_->SetUniformF(&u_fogcoef, 2, fogcoef);
-	}
 
-	if (dirty & DIRTY_UVSCALEOFFSET) {
-		const float invW = 1.0f / (float)gstate_c.curTextureWidth;
-		const float invH = 1.0f / (float)gstate_c.curTextureHeight;
-		const int w = gstate.getTextureWidth(0);
-		const int h = gstate.getTextureHeight(0);
-		const float widthFactor = (float)w * invW;
-		const float heightFactor = (float)h * invH;
-		float uvscaleoff[4];
-		if (gstate_c.bezier || gstate_c.spline) {
-			// When we are generating UV coordinates through the bezier/spline, we need to apply the scaling.
-			// However, this is missing a check that we're not getting our UV:s supplied for us in the vertices.
-			uvscaleoff[0] = gstate_c.uv.uScale * widthFactor;
-			uvscaleoff[1] = gstate_c.uv.vScale * heightFactor;
-			uvscaleoff[2] = gstate_c.uv.uOff * widthFactor;
-			uvscaleoff[3] = gstate_c.uv.vOff * heightFactor;
-		} else {
-			uvscaleoff[0] = widthFactor;
-			uvscaleoff[1] = heightFactor;
-			uvscaleoff[2] = 0.0f;
-			uvscaleoff[3] = 0.0f;
+		if (dirty & DIRTY_UVSCALEOFFSET) {
+			const float invW = 1.0f / (float)gstate_c.curTextureWidth;
+			const float invH = 1.0f / (float)gstate_c.curTextureHeight;
+			const int w = gstate.getTextureWidth(0);
+			const int h = gstate.getTextureHeight(0);
+			const float widthFactor = (float)w * invW;
+			const float heightFactor = (float)h * invH;
+			float uvscaleoff[4];
+			if (gstate_c.bezier || gstate_c.spline) {
+				// When we are generating UV coordinates through the bezier/spline, we need to apply the scaling.
+				// However, this is missing a check that we're not getting our UV:s supplied for us in the vertices.
+				uvscaleoff[0] = gstate_c.uv.uScale * widthFactor;
+				uvscaleoff[1] = gstate_c.uv.vScale * heightFactor;
+				uvscaleoff[2] = gstate_c.uv.uOff * widthFactor;
+				uvscaleoff[3] = gstate_c.uv.vOff * heightFactor;
+			} else {
+				uvscaleoff[0] = widthFactor;
+				uvscaleoff[1] = heightFactor;
+				uvscaleoff[2] = 0.0f;
+				uvscaleoff[3] = 0.0f;
+			}
+			render_->SetUniformF(&u_uvscaleoffset, 4, uvscaleoff);
 		}
-		render_->SetUniformF(&u_uvscaleoffset, 4, uvscaleoff);
-	}
 
-	if ((dirty & DIRTY_TEXCLAMP) && u_texclamp != -1) {
-		const float invW = 1.0f / (float)gstate_c.curTextureWidth;
-		const float invH = 1.0f / (float)gstate_c.curTextureHeight;
-		const int w = gstate.getTextureWidth(0);
-		const int h = gstate.getTextureHeight(0);
-		const float widthFactor = (float)w * invW;
-		const float heightFactor = (float)h * invH;
-
-		// First wrap xy, then half texel xy (for clamp.)
-		const float texclamp[4] = {
-			widthFactor,
-			heightFactor,
-			invW * 0.5f,
-			invH * 0.5f,
-		};
-		const float texclampoff[2] = {
-			gstate_c.curTextureXOffset * invW,
-			gstate_c.curTextureYOffset * invH,
-		};
-		render_->SetUniformF(&u_texclamp, 4, texclamp);
-		if (u_texclampoff != -1) {
-			render_->SetUniformF(&u_texclampoff, 2, texclampoff);
+		if ((dirty & DIRTY_TEXCLAMP) && u_texclamp != -1) {
+			const float invW = 1.0f / (float)gstate_c.curTextureWidth;
+			const float invH = 1.0f / (float)gstate_c.curTextureHeight;
+			const int w = gstate.getTextureWidth(0);
+			const int h = gstate.getTextureHeight(0);
+			const float widthFactor = (float)w * invW;
+			const float heightFactor = (float)h * invH;
+
+			// First wrap xy, then half texel xy (for clamp.)
+			const float texclamp[4] = {
+				widthFactor,
+				heightFactor,
+				invW * 0.5f,
+				invH * 0.5f,
+			};
+			const float texclampoff[2] = {
+				gstate_c.curTextureXOffset * invW,
+				gstate_c.curTextureYOffset * invH,
+			};
+			render_->SetUniformF(&u_texclamp, 4, texclamp);
+			if (u_texclampoff != -1) {
+				render_->SetUniformF(&u_texclampoff, 2, texclampoff);
+			}
 		}
 	}
 
 	// Transform
-	if (dirty & DIRTY_WORLDMATRIX) {
-		SetMatrix4x3(render_, &u_world, gstate.worldMatrix);
-	}
-	if (dirty & DIRTY_VIEWMATRIX) {
-		SetMatrix4x3(render_, &u_view, gstate.viewMatrix);
-	}
-	if (dirty & DIRTY_TEXMATRIX) {
-		SetMatrix4x3(render_, &u_texmtx, gstate.tgenMatrix);
-	}
-	if (dirty & DIRTY_DEPTHRANGE) {
-		// Since depth is [-1, 1] mapping to [minz, maxz], this is easyish.
-		float vpZScale = gstate.getViewportZScale();
-		float vpZCenter = gstate.getViewportZCenter();
-
-		// These are just the reverse of the formulas in GPUStateUtils.
-		float halfActualZRange = vpZScale / gstate_c.vpDepthScale;
-		float minz = -((gstate_c.vpZOffset * halfActualZRange) - vpZCenter) - halfActualZRange;
-		float viewZScale = halfActualZRange;
-		float viewZCenter = minz + halfActualZRange;
-
-		if (!gstate_c.Supports(GPU_SUPPORTS_ACCURATE_DEPTH)) {
-			viewZScale = vpZScale;
-			viewZCenter = vpZCenter;
+	if (dirty & xformUniforms) {
+		if (dirty & DIRTY_WORLDMATRIX) {
+			SetMatrix4x3(render_, &u_world, gstate.worldMatrix);
 		}
-
-		float viewZInvScale;
-		if (viewZScale != 0.0) {
-			viewZInvScale = 1.0f / viewZScale;
-		} else {
-			viewZInvScale = 0.0;
+		if (dirty & DIRTY_VIEWMATRIX) {
+			SetMatrix4x3(render_, &u_view, gstate.viewMatrix);
+		}
+		if (dirty & DIRTY_TEXMATRIX) {
+			SetMatrix4x3(render_, &u_texmtx, gstate.tgenMatrix);
 		}
+		if (dirty & DIRTY_DEPTHRANGE) {
+			// Since depth is [-1, 1] mapping to [minz, maxz], this is easyish.
+			float vpZScale = gstate.getViewportZScale();
+			float vpZCenter = gstate.getViewportZCenter();
+
+			// These are just the reverse of the formulas in GPUStateUtils.
+			float halfActualZRange = vpZScale / gstate_c.vpDepthScale;
+			float minz = -((gstate_c.vpZOffset * halfActualZRange) - vpZCenter) - halfActualZRange;
+			float viewZScale = halfActualZRange;
+			float viewZCenter = minz + halfActualZRange;
+
+			if (!gstate_c.Supports(GPU_SUPPORTS_ACCURATE_DEPTH)) {
+				viewZScale = vpZScale;
+				viewZCenter = vpZCenter;
+			}
 
-		float data[4] = { viewZScale, viewZCenter, viewZCenter, viewZInvScale };
-		SetFloatUniform4(render_, &u_depthRange, data);
-	}
-	if (dirty & DIRTY_CULLRANGE) {
-		float minValues[4], maxValues[4];
-		CalcCullRange(minValues, maxValues, g_Config.iRenderingMode == FB_NON_BUFFERED_MODE, true);
-		SetFloatUniform4(render_, &u_cullRangeMin, minValues);
-		SetFloatUniform4(render_, &u_cullRangeMax, maxValues);
-	}
+			float viewZInvScale;
+			if (viewZScale != 0.0) {
+				viewZInvScale = 1.0f / viewZScale;
+			} else {
+				viewZInvScale = 0.0;
+			}
 
-	if (dirty & DIRTY_STENCILREPLACEVALUE) {
-		float f = (float)gstate.getStencilTestRef() * (1.0f / 255.0f);
-		render_->SetUniformF(&u_stencilReplaceValue, 1, &f);
+			float data[4] = { viewZScale, viewZCenter, viewZCenter, viewZInvScale };
+			SetFloatUniform4(render_, &u_depthRange, data);
+		}
+		if (dirty & DIRTY_CULLRANGE) {
+			float minValues[4], maxValues[4];
+			CalcCullRange(minValues, maxValues, g_Config.iRenderingMode == FB_NON_BUFFERED_MODE, true);
+			SetFloatUniform4(render_, &u_cullRangeMin, minValues);
+			SetFloatUniform4(render_, &u_cullRangeMax, maxValues);
+		}
+
+		if (dirty & DIRTY_STENCILREPLACEVALUE) {
+			float f = (float)gstate.getStencilTestRef() * (1.0f / 255.0f);
+			render_->SetUniformF(&u_stencilReplaceValue, 1, &f);
+		}
 	}
-	float bonetemp[16];
-	for (int i = 0; i < numBones; i++) {
-		if (dirty & (DIRTY_BONEMATRIX0 << i)) {
-			ConvertMatrix4x3To4x4(bonetemp, gstate.boneMatrix + 12 * i);
-			render_->SetUniformM4x4(&u_bone[i], bonetemp);
+	if (UseBoneArrayUniform()) {
+		// We can only upload a contiguous prefix of the array with one call, so find the
+		// last dirty matrix and upload everything up to it. The extra conversions are cheap
+		// compared to the driver overhead of up to eight separate glUniformMatrix4fv calls.
+		int count = 0;
+		for (int i = 0; i < numBones; i++) {
+			if (dirty & (DIRTY_BONEMATRIX0 << i))
+				count = i + 1;
+		}
+		if (count != 0) {
+			float bonetemp[8 * 16];
+			for (int i = 0; i < count; i++) {
+				ConvertMatrix4x3To4x4(bonetemp + 16 * i, gstate.boneMatrix + 12 * i);
+			}
+			render_->SetUniformM4x4Array(&u_boneArray, count, bonetemp);
+		}
+	} else {
+		float bonetemp[16];
+		for (int i = 0; i < numBones; i++) {
+			if (dirty & (DIRTY_BONEMATRIX0 << i)) {
+				ConvertMatrix4x3To4x4(bonetemp, gstate.boneMatrix + 12 * i);
+				render_->SetUniformM4x4(&u_bone[i], bonetemp);
+			}
 		}
 	}
 
@@ -519,48 +559,50 @@ void LinkedShader::UpdateUniforms(u32 vertType, const ShaderID &vsid) {
 	}
 
 	// Lighting
-	if (dirty & DIRTY_AMBIENT) {
-		SetColorUniform3Alpha(render_, &u_ambient, gstate.ambientcolor, gstate.getAmbientA());
-	}
-	if (dirty & DIRTY_MATAMBIENTALPHA) {
-		SetColorUniform3Alpha(render_, &u_matambientalpha, gstate.materialambient, gstate.getMaterialAmbientA());
-	}
-	if (dirty & DIRTY_MATDIFFUSE) {
-		SetColorUniform3(render_, &u_matdiffuse, gstate.materialdiffuse);
-	}
-	if (dirty & DIRTY_MATEMISSIVE) {
-		SetColorUniform3(render_, &u_matemissive, gstate.materialemissive);
-	}
-	if (dirty & DIRTY_MATSPECULAR) {
-		SetColorUniform3ExtraFloat(render_, &u_matspecular, gstate.materialspecular, getFloat24(gstate.materialspecularcoef));
-	}
+	if (dirty & lightUniforms) {
+		if (dirty & DIRTY_AMBIENT) {
+			SetColorUniform3Alpha(render_, &u_ambient, gstate.ambientcolor, gstate.getAmbientA());
+		}
+		if (dirty & DIRTY_MATAMBIENTALPHA) {
+			SetColorUniform3Alpha(render_, &u_matambientalpha, gstate.materialambient, gstate.getMaterialAmbientA());
+		}
+		if (dirty & DIRTY_MATDIFFUSE) {
+			SetColorUniform3(render_, &u_matdiffuse, gstate.materialdiffuse);
+		}
+		if (dirty & DIRTY_MATEMISSIVE) {
+			SetColorUniform3(render_, &u_matemissive, gstate.materialemissive);
+		}
+		if (dirty & DIRTY_MATSPECULAR) {
+			SetColorUniform3ExtraFloat(render_, &u_matspecular, gstate.materialspecular, getFloat24(gstate.materialspecularcoef));
+		}
 
-	for (int i = 0; i < 4; i++) {
-		if (dirty & (DIRTY_LIGHT0 << i)) {
-			if (gstate.isDirectionalLight(i)) {
-				// Prenormalize
-				float x = getFloat24(gstate.lpos[i * 3 + 0]);
-				float y = getFloat24(gstate.lpos[i * 3 + 1]);
-				float z = getFloat24(gstate.lpos[i * 3 + 2]);
-				float len = sqrtf(x*x + y*y + z*z);
-				if (len == 0.0f)
-					len = 1.0f;
-				else
-					len = 1.0f / len;
-				float vec[3] = { x * len, y * len, z * len };
-				render_->SetUniformF(&u_lightpos[i], 3, vec);
-			} else {
-				SetFloat24Uniform3(render_, &u_lightpos[i], &gstate.lpos[i * 3]);
-			}
-			if (u_lightdir[i] != -1) SetFloat24Uniform3(render_, &u_lightdir[i], &gstate.ldir[i * 3]);
-			if (u_lightatt[i] != -1) SetFloat24Uniform3(render_, &u_lightatt[i], &gstate.latt[i * 3]);
-			if (u_lightangle_spotCoef[i] != -1) {
-				float lightangle_spotCoef[2] = { getFloat24(gstate.lcutoff[i]), getFloat24(gstate.lconv[i]) };
-				SetFloatUniform2(render_, &u_lightangle_spotCoef[i], lightangle_spotCoef);
+		for (int i = 0; i < 4; i++) {
+			if (dirty & (DIRTY_LIGHT0 << i)) {
+				if (gstate.isDirectionalLight(i)) {
+					// Prenormalize
+					float x = getFloat24(gstate.lpos[i * 3 + 0]);
+					float y = getFloat24(gstate.lpos[i * 3 + 1]);
+					float z = getFloat24(gstate.lpos[i * 3 + 2]);
+					float len = sqrtf(x*x + y*y + z*z);
+					if (len == 0.0f)
+						len = 1.0f;
+					else
+						len = 1.0f / len;
+					float vec[3] = { x * len, y * len, z * len };
+					render_->SetUniformF(&u_lightpos[i], 3, vec);
+				} else {
+					SetFloat24Uniform3(render_, &u_lightpos[i], &gstate.lpos[i * 3]);
+				}
+				if (u_lightdir[i] != -1) SetFloat24Uniform3(render_, &u_lightdir[i], &gstate.ldir[i * 3]);
+				if (u_lightatt[i] != -1) SetFloat24Uniform3(render_, &u_lightatt[i], &gstate.latt[i * 3]);
+				if (u_lightangle_spotCoef[i] != -1) {
+					float lightangle_spotCoef[2] = { getFloat24(gstate.lcutoff[i]), getFloat24(gstate.lconv[i]) };
+					SetFloatUniform2(render_, &u_lightangle_spotCoef[i], lightangle_spotCoef);
+				}
+				if (u_lightambient[i] != -1) SetColorUniform3(render_, &u_lightambient[i], gstate.lcolor[i * 3]);
+				if (u_lightdiffuse[i] != -1) SetColorUniform3(render_, &u_lightdiffuse[i], gstate.lcolor[i * 3 + 1]);
+				if (u_lightspecular[i] != -1) SetColorUniform3(render_, &u_lightspecular[i], gstate.lcolor[i * 3 + 2]);
 			}
-			if (u_lightambient[i] != -1) SetColorUniform3(render_, &u_lightambient[i], gstate.lcolor[i * 3]);
-			if (u_lightdiffuse[i] != -1) SetColorUniform3(render_, &u_lightdiffuse[i], gstate.lcolor[i * 3 + 1]);
-			if (u_lightspecular[i] != -1) SetColorUniform3(render_, &u_lightspecular[i], gstate.lcolor[i * 3 + 2]);
 		}
 	}
 
@@ -597,6 +639,7 @@ void ShaderManagerGLES::Clear() {
 	linkedShaderCache_.clear();
 	fsCache_.Clear();
 	vsCache_.Clear();
+	deferredFragmentShaders_.clear();
 	DirtyShader();
 }
 
@@ -634,6 +677,7 @@ Shader *ShaderManagerGLES::CompileFragmentShader(FShaderID FSID) {
 		return nullptr;
 	}
 	std::string desc = FragmentShaderDesc(FSID);
+	gpuStats.numShaderCompiles++;
 	return new Shader(render_, codeBuffer_, desc, GL_FRAGMENT_SHADER, false, 0, uniformMask);
 }
 
@@ -643,6 +687,7 @@ Shader *ShaderManagerGLES::CompileVertexShader(VShaderID VSID) {
 	uint64_t uniformMask;
 	GenerateVertexShader(VSID, codeBuffer_, &attrMask, &uniformMask);
 	std::string desc = VertexShaderDesc(VSID);
+	gpuStats.numShaderCompiles++;
 	return new Shader(render_, codeBuffer_, desc, GL_VERTEX_SHADER, useHWTransform, attrMask, uniformMask);
 }
 
@@ -717,10 +762,24 @@ LinkedShader *ShaderManagerGLES::ApplyFragmentShader(VShaderID VSID, Shader *vs,
 
 	Shader *fs = fsCache_.Get(FSID);
 	if (!fs)	{
-		// Fragment shader not in cache. Let's compile it.
-		fs = CompileFragmentShader(FSID);
-		fsCache_.Insert(FSID, fs);
-		diskCacheDirty_ = true;
+		// Fragment shader not in cache. If an uber variant can stand in for it, use
+		// that right away and defer the specialized compile to a later frame, so a
+		// burst of new state combinations doesn't turn into a burst of compile hitches.
+		FShaderID uberFSID;
+		if (CanUseUberShader(FSID, &uberFSID)) {
+			fs = fsCache_.Get(uberFSID);
+			if (!fs) {
+				fs = CompileFragmentShader(uberFSID);
+				fsCache_.Insert(uberFSID, fs);
+				diskCacheDirty_ = true;
+			}
+			if (std::find(deferredFragmentShaders_.begin(), deferredFragmentShaders_.end(), FSID) == deferredFragmentShaders_.end())
+				deferredFragmentShaders_.push_back(FSID);
+		} else {
+			fs = CompileFragmentShader(FSID);
+			fsCache_.Insert(FSID, fs);
+			diskCacheDirty_ = true;
+		}
 	}
 
 	// Okay, we have both shaders. Let's see if there's a linked one.
@@ -757,6 +816,36 @@ LinkedShader *ShaderManagerGLES::ApplyFragmentShader(VShaderID VSID, Shader *vs,
 	return ls;
 }
 
+// Whether an uber shader can stand in for this exact variant while it compiles.
+// Currently only the alpha test function dimension is collapsed - it's the state
+// games toggle the most at runtime. The fragment test cache and the PVR driver
+// workaround have their own alpha test code paths, so they keep the old behavior.
+bool ShaderManagerGLES::CanUseUberShader(const FShaderID &FSID, FShaderID *uberID) const {
+	if (!FSID.Bit(FS_BIT_ALPHA_TEST) || FSID.Bit(FS_BIT_ALPHA_AGAINST_ZERO))
+		return false;
+	if (g_Config.bFragmentTestCache || gl_extensions.gpuVendor == GPU_VENDOR_IMGTEC)
+		return false;
+	*uberID = FSID;
+	// SetBits only ORs, so clear the baked function bits by hand before branding.
+	uberID->d[FS_BIT_ALPHA_TEST_FUNC >> 5] &= ~(7 << (FS_BIT_ALPHA_TEST_FUNC & 31));
+	uberID->SetBit(FS_BIT_UBER_ALPHA_TEST);
+	return true;
+}
+
+void ShaderManagerGLES::CompileDeferredShaders() {
+	// One per frame keeps the cost invisible. There's no hurry - draws that need a
+	// pending shader keep rendering correctly through the uber variant, and the
+	// specialized shader takes over via the normal cache lookup once it exists.
+	if (deferredFragmentShaders_.empty())
+		return;
+	FShaderID id = deferredFragmentShaders_.front();
+	deferredFragmentShaders_.erase(deferredFragmentShaders_.begin());
+	if (!fsCache_.Get(id)) {
+		fsCache_.Insert(id, CompileFragmentShader(id));
+		diskCacheDirty_ = true;
+	}
+}
+
 std::string Shader::GetShaderString(DebugShaderStringType type, ShaderID id) const {
 	switch (type) {
 	case SHADER_STRING_SOURCE_CODE:
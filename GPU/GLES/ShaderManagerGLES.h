@@ -74,11 +74,8 @@ public:
 	int u_cullRangeMin;
 	int u_cullRangeMax;
 
-#ifdef USE_BONE_ARRAY
-	int u_bone;  // array, size is numBones
-#else
-	int u_bone[8];
-#endif
+	int u_boneArray;  // the array uniform, when UseBoneArrayUniform() - see VertexShaderGeneratorGLES.h
+	int u_bone[8];    // separate u_bone0..u_bone7 uniforms otherwise
 	int numBones;
 
 	// Shader blending.
@@ -94,6 +91,7 @@ public:
 	// Fragment processing inputs
 	int u_alphacolorref;
 	int u_alphacolormask;
+	int u_alphaTestFunc;  // Only present in uber shaders.
 	int u_testtex;
 	int u_fogcolor;
 	int u_fogcoef;
@@ -168,6 +166,10 @@ public:
 	void DirtyShader();
 	void DirtyLastShader() override;
 
+	// Compiles at most one deferred specialized fragment shader. Call once per frame -
+	// draws needing a pending shader are served by an uber variant in the meantime.
+	void CompileDeferredShaders();
+
 	int GetNumVertexShaders() const { return (int)vsCache_.size(); }
 	int GetNumFragmentShaders() const { return (int)fsCache_.size(); }
 	int GetNumPrograms() const { return (int)linkedShaderCache_.size(); }
@@ -184,6 +186,7 @@ private:
 	void Clear();
 	Shader *CompileFragmentShader(FShaderID id);
 	Shader *CompileVertexShader(VShaderID id);
+	bool CanUseUberShader(const FShaderID &FSID, FShaderID *uberID) const;
 
 	struct LinkedShaderCacheEntry {
 		LinkedShaderCacheEntry(Shader *vs_, Shader *fs_, LinkedShader *ls_)
@@ -210,6 +213,9 @@ private:
 	typedef DenseHashMap<FShaderID, Shader *, nullptr> FSCache;
 	FSCache fsCache_;
 
+	// Specialized variants we've postponed compiling while an uber shader stands in.
+	std::vector<FShaderID> deferredFragmentShaders_;
+
 	typedef DenseHashMap<VShaderID, Shader *, nullptr> VSCache;
 	VSCache vsCache_;
 
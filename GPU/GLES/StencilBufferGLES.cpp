@@ -129,6 +129,21 @@ bool FramebufferManagerGLES::NotifyStencilUpload(u32 addr, int size, bool skipZe
 		return true;
 	}
 
+	// Most non-zero uploads are constant fills too (games clearing stencil with
+	// memset-style VRAM writes), which a single clear handles just as well as the
+	// per-bit loop below.
+	u8 clearValue = 0;
+	if (StencilConstantValue(src, dstBuffer->format, dstBuffer->fb_stride * dstBuffer->bufferHeight, &clearValue)) {
+		shaderManagerGL_->DirtyLastShader();
+		if (dstBuffer->fbo) {
+			draw_->BindFramebufferAsRenderTarget(dstBuffer->fbo, { Draw::RPAction::KEEP, Draw::RPAction::KEEP, Draw::RPAction::CLEAR });
+		}
+		// Stencil mirrors the alpha channel, so clear that to the same value.
+		render_->Clear(clearValue << 24, 0, clearValue, GL_STENCIL_BUFFER_BIT | GL_COLOR_BUFFER_BIT, 0x8, 0, 0, 0, 0);
+		gstate_c.Dirty(DIRTY_BLEND_STATE | DIRTY_VIEWPORTSCISSOR_STATE);
+		return true;
+	}
+
 	if (!stencilUploadProgram_) {
 		std::string errorString;
 		static std::string vs_code, fs_code;
@@ -123,9 +123,13 @@ void TextureCacheGLES::UpdateSamplingParams(TexCacheEntry &entry, bool force) {
 	bool sClamp;
 	bool tClamp;
 	float lodBias;
-	u8 maxLevel = (entry.status & TexCacheEntry::STATUS_BAD_MIPS) ? 0 : entry.maxLevel;
+	int maxLevel = entry.MipLevels();
 	GETexLevelMode mode;
 	GetSamplingParams(minFilt, magFilt, sClamp, tClamp, lodBias, maxLevel, entry.addr, mode);
+	if (entry.status & TexCacheEntry::STATUS_AUTOGEN_MIPS) {
+		// The game supplied no mips, so it won't have asked for mip filtering either.
+		minFilt |= 6;
+	}
 
 	if (gstate_c.Supports(GPU_SUPPORTS_TEXTURE_LOD_CONTROL)) {
 		float minLod = 0.0f;
@@ -231,6 +235,7 @@ void TextureCacheGLES::StartFrame() {
 		// INFO_LOG(G3D, "Scaled %i texels", texelsScaledThisFrame_);
 	}
 	texelsScaledThisFrame_ = 0;
+	texelsBuiltThisFrame_ = 0;
 	if (clearCacheNextFrame_) {
 		Clear(true);
 		clearCacheNextFrame_ = false;
@@ -471,24 +476,47 @@ void TextureCacheGLES::ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFram
 		depal = depalShaderCache_->GetDepalettizeShader(clutMode, framebuffer->drawnFormat);
 	}
 	if (depal) {
-		shaderManager_->DirtyLastShader();
-
 		const GEPaletteFormat clutFormat = gstate.getClutPaletteFormat();
-		GLRTexture *clutTexture = depalShaderCache_->GetClutTexture(clutFormat, clutHash_, clutBuf_);
 		Draw::Framebuffer *depalFBO = framebufferManagerGL_->GetTempFBO(TempFBO::DEPAL, framebuffer->renderWidth, framebuffer->renderHeight, Draw::FBO_8888);
-		draw_->BindFramebufferAsRenderTarget(depalFBO, { Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE });
 
-		render_->SetScissor(GLRect2D{ 0, 0, (int)framebuffer->renderWidth, (int)framebuffer->renderHeight });
-		render_->SetViewport(GLRViewport{ 0.0f, 0.0f, (float)framebuffer->renderWidth, (float)framebuffer->renderHeight, 0.0f, 1.0f });
-		TextureShaderApplier shaderApply(depal, framebuffer->bufferWidth, framebuffer->bufferHeight, framebuffer->renderWidth, framebuffer->renderHeight);
-		shaderApply.ApplyBounds(gstate_c.vertBounds, gstate_c.curTextureXOffset, gstate_c.curTextureYOffset);
-		shaderApply.Use(render_, drawEngine_, shadeInputLayout_);
+		// Compute the region the depal draw would cover, same math as ApplyBounds.
+		int u1 = 0, v1 = 0, u2 = framebuffer->bufferWidth, v2 = framebuffer->bufferHeight;
+		if (gstate_c.vertBounds.minV < gstate_c.vertBounds.maxV) {
+			u1 = gstate_c.vertBounds.minU + gstate_c.curTextureXOffset;
+			v1 = gstate_c.vertBounds.minV + gstate_c.curTextureYOffset;
+			u2 = gstate_c.vertBounds.maxU + gstate_c.curTextureXOffset;
+			v2 = gstate_c.vertBounds.maxV + gstate_c.curTextureYOffset;
+		}
+
+		// If neither the CLUT nor the source framebuffer changed since the last depal into
+		// this temp buffer, and the region we need is covered, the old result is still good.
+		bool cacheHit = depalCache_.framebuffer == framebuffer && depalCache_.fbo == depalFBO &&
+			depalCache_.clutHash == clutHash_ && depalCache_.clutMode == clutMode &&
+			depalCache_.writeSeq == framebuffer->colorWriteSeq &&
+			u1 >= depalCache_.u1 && v1 >= depalCache_.v1 && u2 <= depalCache_.u2 && v2 <= depalCache_.v2;
+
+		if (!cacheHit) {
+			shaderManager_->DirtyLastShader();
+
+			GLRTexture *clutTexture = depalShaderCache_->GetClutTexture(clutFormat, clutHash_, clutBuf_);
+			draw_->BindFramebufferAsRenderTarget(depalFBO, { Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE });
+
+			render_->SetScissor(GLRect2D{ 0, 0, (int)framebuffer->renderWidth, (int)framebuffer->renderHeight });
+			render_->SetViewport(GLRViewport{ 0.0f, 0.0f, (float)framebuffer->renderWidth, (float)framebuffer->renderHeight, 0.0f, 1.0f });
+			TextureShaderApplier shaderApply(depal, framebuffer->bufferWidth, framebuffer->bufferHeight, framebuffer->renderWidth, framebuffer->renderHeight);
+			shaderApply.ApplyBounds(gstate_c.vertBounds, gstate_c.curTextureXOffset, gstate_c.curTextureYOffset);
+			shaderApply.Use(render_, drawEngine_, shadeInputLayout_);
 
-		framebufferManagerGL_->BindFramebufferAsColorTexture(0, framebuffer, BINDFBCOLOR_SKIP_COPY | BINDFBCOLOR_FORCE_SELF);
-		render_->BindTexture(TEX_SLOT_CLUT, clutTexture);
-		render_->SetTextureSampler(TEX_SLOT_CLUT, GL_REPEAT, GL_CLAMP_TO_EDGE, GL_NEAREST, GL_NEAREST, 0.0f);
+			framebufferManagerGL_->BindFramebufferAsColorTexture(0, framebuffer, BINDFBCOLOR_SKIP_COPY | BINDFBCOLOR_FORCE_SELF);
+			render_->BindTexture(TEX_SLOT_CLUT, clutTexture);
+			render_->SetTextureSampler(TEX_SLOT_CLUT, GL_REPEAT, GL_CLAMP_TO_EDGE, GL_NEAREST, GL_NEAREST, 0.0f);
 
-		shaderApply.Shade(render_);
+			shaderApply.Shade(render_);
+
+			// The render pass load action is DONT_CARE, so only the freshly drawn region is
+			// defined in the temp buffer - don't union rects from earlier draws.
+			depalCache_ = DepalCache{ framebuffer, depalFBO, clutHash_, clutMode, framebuffer->colorWriteSeq, u1, v1, u2, v2 };
+		}
 
 		draw_->BindFramebufferAsTexture(depalFBO, 0, Draw::FB_COLOR_BIT, 0);
 
@@ -606,6 +634,13 @@ void TextureCacheGLES::BuildTexture(TexCacheEntry *const entry) {
 	int w = gstate.getTextureWidth(0);
 	int h = gstate.getTextureHeight(0);
 	ReplacedTexture &replaced = replacer_.FindReplacement(cachekey, entry->fullhash, w, h);
+	if (replaced.IsPending()) {
+		// Decode is in flight on the background loader - build the original texture now
+		// and swap the replacement in on a later frame, like deferred scaling.
+		entry->status |= TexCacheEntry::STATUS_TO_REPLACE;
+	} else {
+		entry->status &= ~TexCacheEntry::STATUS_TO_REPLACE;
+	}
 	if (replaced.GetSize(0, w, h)) {
 		// We're replacing, so we won't scale.
 		scaleFactor = 1;
@@ -625,7 +660,10 @@ void TextureCacheGLES::BuildTexture(TexCacheEntry *const entry) {
 	}
 
 	if (scaleFactor != 1) {
-		if (texelsScaledThisFrame_ >= TEXCACHE_MAX_TEXELS_SCALED) {
+		// With deferred loads on, never scale on the very first build - upload the
+		// unscaled texture right away and swap in the scaled one on a later frame.
+		const bool deferScale = g_Config.bDeferTextureLoads && entry->numFrames == 0;
+		if (deferScale || texelsScaledThisFrame_ >= TEXCACHE_MAX_TEXELS_SCALED) {
 			entry->status |= TexCacheEntry::STATUS_TO_SCALE;
 			scaleFactor = 1;
 		} else {
@@ -688,6 +726,19 @@ void TextureCacheGLES::BuildTexture(TexCacheEntry *const entry) {
 	} else {
 		entry->status &= ~TexCacheEntry::STATUS_BAD_MIPS;
 	}
+
+	// If the game only supplied mip 0, optionally generate the rest on the GPU -
+	// sampling without mips shimmers badly at high render scales. The entry flag
+	// makes sampling (and rehash-only revalidation) keep using the generated chain.
+	entry->status &= ~TexCacheEntry::STATUS_AUTOGEN_MIPS;
+	if (g_Config.bGenerateMipmaps && maxLevel == 0 && scaleFactor == 1 && w > 1 && h > 1 &&
+		!IsFakeMipmapChange() && !Memory::IsVRAMAddress(entry->addr) &&
+		videos_.find(entry->addr & 0x3FFFFFFF) == videos_.end() &&
+		!(h > w && draw_->GetBugs().Has(Draw::Bugs::PVR_GENMIPMAP_HEIGHT_GREATER))) {
+		genMips = true;
+		entry->status |= TexCacheEntry::STATUS_AUTOGEN_MIPS;
+		texMaxLevel = entry->MipLevels();
+	}
 	if (replaced.Valid()) {
 		entry->SetAlphaStatus(TexCacheEntry::TexStatus(replaced.AlphaStatus()));
 	}
@@ -98,6 +98,18 @@ private:
 
 	GLRInputLayout *shadeInputLayout_ = nullptr;
 
+	// Remembers the last depalettize result so scenes that don't cycle the palette pay
+	// the depal draw once instead of per-draw. See ApplyTextureFramebuffer().
+	struct DepalCache {
+		VirtualFramebuffer *framebuffer;
+		Draw::Framebuffer *fbo;
+		u32 clutHash;
+		u32 clutMode;
+		int writeSeq;
+		int u1, v1, u2, v2;
+	};
+	DepalCache depalCache_{};
+
 	enum { INVALID_TEX = -1 };
 };
 
@@ -68,6 +68,13 @@ enum DoLightComputation {
 	LIGHT_FULL,
 };
 
+bool UseBoneArrayUniform() {
+	// Arrays of matrices have historically been flaky on old GLES2 drivers (which is why
+	// the old USE_BONE_ARRAY define never became the default), so only use them where
+	// GLES3 or desktop GL 3 is available.
+	return gl_extensions.GLES3 || (!gl_extensions.IsGLES && gl_extensions.VersionGEThan(3, 0, 0));
+}
+
 
 // Depth range and viewport
 //
@@ -273,15 +280,15 @@ void GenerateVertexShader(const VShaderID &id, char *buffer, uint32_t *attrMask,
 			*uniformMask |= DIRTY_TEXMATRIX;
 		}
 		if (enableBones) {
-#ifdef USE_BONE_ARRAY
-			WRITE(p, "uniform mediump mat4 u_bone[%i];\n", numBoneWeights);
-			*uniformMask |= DIRTY_BONE_UNIFORMS;
-#else
-			for (int i = 0; i < numBoneWeights; i++) {
-				WRITE(p, "uniform mat4 u_bone%i;\n", i);
-				*uniformMask |= DIRTY_BONEMATRIX0 << i;
+			if (UseBoneArrayUniform()) {
+				WRITE(p, "uniform mediump mat4 u_bone[%i];\n", numBoneWeights);
+				*uniformMask |= DIRTY_BONE_UNIFORMS;
+			} else {
+				for (int i = 0; i < numBoneWeights; i++) {
+					WRITE(p, "uniform mat4 u_bone%i;\n", i);
+					*uniformMask |= DIRTY_BONEMATRIX0 << i;
+				}
 			}
-#endif
 		}
 		if (doTexture) {
 			WRITE(p, "uniform vec4 u_uvscaleoffset;\n");
@@ -528,59 +535,33 @@ void GenerateVertexShader(const VShaderID &id, char *buffer, uint32_t *attrMask,
 				"w2.x", "w2.y", "w2.z", "w2.w",
 			};
 
-#if defined(USE_FOR_LOOP) && defined(USE_BONE_ARRAY)
-
-			// To loop through the weights, we unfortunately need to put them in a float array.
-			// GLSL ES sucks - no way to directly initialize an array!
-			switch (numBoneWeights) {
-			case 1: WRITE(p, "  float w[1]; w[0] = w1;\n"); break;
-			case 2: WRITE(p, "  float w[2]; w[0] = w1.x; w[1] = w1.y;\n"); break;
-			case 3: WRITE(p, "  float w[3]; w[0] = w1.x; w[1] = w1.y; w[2] = w1.z;\n"); break;
-			case 4: WRITE(p, "  float w[4]; w[0] = w1.x; w[1] = w1.y; w[2] = w1.z; w[3] = w1.w;\n"); break;
-			case 5: WRITE(p, "  float w[5]; w[0] = w1.x; w[1] = w1.y; w[2] = w1.z; w[3] = w1.w; w[4] = w2;\n"); break;
-			case 6: WRITE(p, "  float w[6]; w[0] = w1.x; w[1] = w1.y; w[2] = w1.z; w[3] = w1.w; w[4] = w2.x; w[5] = w2.y;\n"); break;
-			case 7: WRITE(p, "  float w[7]; w[0] = w1.x; w[1] = w1.y; w[2] = w1.z; w[3] = w1.w; w[4] = w2.x; w[5] = w2.y; w[6] = w2.z;\n"); break;
-			case 8: WRITE(p, "  float w[8]; w[0] = w1.x; w[1] = w1.y; w[2] = w1.z; w[3] = w1.w; w[4] = w2.x; w[5] = w2.y; w[6] = w2.z; w[7] = w2.w;\n"); break;
-			}
-
-			WRITE(p, "  mat4 skinMatrix = w[0] * u_bone[0];\n");
-			if (numBoneWeights > 1) {
-				WRITE(p, "  for (int i = 1; i < %i; i++) {\n", numBoneWeights);
-				WRITE(p, "    skinMatrix += w[i] * u_bone[i];\n");
-				WRITE(p, "  }\n");
-			}
-
-#else
-
-#ifdef USE_BONE_ARRAY
-			if (numBoneWeights == 1)
-				WRITE(p, "  mat4 skinMatrix = w1 * u_bone[0]");
-			else
-				WRITE(p, "  mat4 skinMatrix = w1.x * u_bone[0]");
-			for (int i = 1; i < numBoneWeights; i++) {
-				const char *weightAttr = boneWeightAttr[i];
-				// workaround for "cant do .x of scalar" issue
-				if (numBoneWeights == 1 && i == 0) weightAttr = "w1";
-				if (numBoneWeights == 5 && i == 4) weightAttr = "w2";
-				WRITE(p, " + %s * u_bone[%i]", weightAttr, i);
-			}
-#else
-			// Uncomment this to screw up bone shaders to check the vertex shader software fallback
-			// WRITE(p, "THIS SHOULD ERROR! #error");
-			if (numBoneWeights == 1)
-				WRITE(p, "  mat4 skinMatrix = w1 * u_bone0");
-			else
-				WRITE(p, "  mat4 skinMatrix = w1.x * u_bone0");
-			for (int i = 1; i < numBoneWeights; i++) {
-				const char *weightAttr = boneWeightAttr[i];
-				// workaround for "cant do .x of scalar" issue
-				if (numBoneWeights == 1 && i == 0) weightAttr = "w1";
-				if (numBoneWeights == 5 && i == 4) weightAttr = "w2";
-				WRITE(p, " + %s * u_bone%i", weightAttr, i);
+			if (UseBoneArrayUniform()) {
+				if (numBoneWeights == 1)
+					WRITE(p, "  mat4 skinMatrix = w1 * u_bone[0]");
+				else
+					WRITE(p, "  mat4 skinMatrix = w1.x * u_bone[0]");
+				for (int i = 1; i < numBoneWeights; i++) {
+					const char *weightAttr = boneWeightAttr[i];
+					// workaround for "cant do .x of scalar" issue
+					if (numBoneWeights == 1 && i == 0) weightAttr = "w1";
+					if (numBoneWeights == 5 && i == 4) weightAttr = "w2";
+					WRITE(p, " + %s * u_bone[%i]", weightAttr, i);
+				}
+			} else {
+				// Uncomment this to screw up bone shaders to check the vertex shader software fallback
+				// WRITE(p, "THIS SHOULD ERROR! #error");
+				if (numBoneWeights == 1)
+					WRITE(p, "  mat4 skinMatrix = w1 * u_bone0");
+				else
+					WRITE(p, "  mat4 skinMatrix = w1.x * u_bone0");
+				for (int i = 1; i < numBoneWeights; i++) {
+					const char *weightAttr = boneWeightAttr[i];
+					// workaround for "cant do .x of scalar" issue
+					if (numBoneWeights == 1 && i == 0) weightAttr = "w1";
+					if (numBoneWeights == 5 && i == 4) weightAttr = "w2";
+					WRITE(p, " + %s * u_bone%i", weightAttr, i);
+				}
 			}
-#endif
-
-#endif
 
 			WRITE(p, ";\n");
 
@@ -19,8 +19,11 @@
 
 #include "Common/CommonTypes.h"
 
-// #define USE_BONE_ARRAY
-
 struct VShaderID;
 
+// True if the generated shader declares the bone matrices as a single mat4 array instead
+// of separate u_bone0..u_boneN uniforms. The array form lets a contiguous run of dirty
+// matrices be uploaded with one glUniformMatrix4fv - see ShaderManagerGLES::UpdateUniforms().
+bool UseBoneArrayUniform();
+
 void GenerateVertexShader(const VShaderID &id, char *buffer, uint32_t *attrMask, uint64_t *uniformMask);
@@ -41,6 +41,8 @@
 #endif
 
 GPUStatistics gpuStats;
+GPUStatistics gpuStatsLastFrame;
+GPUMemoryBudget gpuMemoryBudget;
 GPUInterface *gpu;
 GPUDebugInterface *gpuDebug;
 
@@ -29,6 +29,7 @@ enum SkipDrawReasonFlags {
 	SKIPDRAW_NON_DISPLAYED_FB = 2,   // Skip drawing to FBO:s that have not been displayed.
 	SKIPDRAW_BAD_FB_TEXTURE = 4,
 	SKIPDRAW_WINDOW_MINIMIZED = 8, // Don't draw when the host window is minimized.
+	SKIPDRAW_STATIC_FRAME = 16,    // The scene was identical for several frames - the framebuffer already holds it.
 };
 
 // Global GPU-related utility functions. 
@@ -50,12 +51,39 @@ inline unsigned int toFloat24(float f) {
 	return i >> 8;
 }
 
+// Why a pending draw batch had to be flushed. Used for the per-frame flush
+// histogram in GPUStatistics and the flush analysis screen in DevScreens.
+enum FlushReason {
+	FLUSH_REASON_OTHER = 0,  // Frame ends, syncs, readbacks, block transfers etc.
+	FLUSH_REASON_TEXTURE_CHANGE,
+	FLUSH_REASON_CLUT_CHANGE,
+	FLUSH_REASON_FRAMEBUF_CHANGE,
+	FLUSH_REASON_VERTEX_FORMAT_CHANGE,
+	FLUSH_REASON_MATRIX_CHANGE,
+	FLUSH_REASON_LIGHT_CHANGE,
+	FLUSH_REASON_BLEND_STATE_CHANGE,
+	FLUSH_REASON_DEPTH_STENCIL_CHANGE,
+	FLUSH_REASON_VIEWPORT_SCISSOR_CHANGE,
+	FLUSH_REASON_OTHER_STATE_CHANGE,
+	FLUSH_REASON_PRIM_TYPE_CHANGE,
+	FLUSH_REASON_BUFFER_FULL,
+	NUM_FLUSH_REASONS,
+};
+
+const char *FlushReasonToString(FlushReason reason);
+
 struct GPUStatistics {
 	void Reset() {
 		// Never add a vtable :)
 		memset(this, 0, sizeof(*this));
 	}
 	void ResetFrame() {
+		// Roll the flush histogram into the cross-frame totals before wiping it,
+		// so the flush analysis screen can average over many frames.
+		for (int i = 0; i < NUM_FLUSH_REASONS; i++)
+			numFlushesByReasonHistory[i] += numFlushesByReason[i];
+		numFlushHistoryFrames++;
+
 		numDrawCalls = 0;
 		numCachedDrawCalls = 0;
 		numVertsSubmitted = 0;
@@ -67,13 +95,24 @@ struct GPUStatistics {
 		numShaderSwitches = 0;
 		numFlushes = 0;
 		numTexturesDecoded = 0;
+		numTextureDataBytesUploaded = 0;
 		numReadbacks = 0;
 		numUploads = 0;
 		numClears = 0;
+		numShaderCompiles = 0;
+		numPipelineCompiles = 0;
 		msProcessingDisplayLists = 0;
+		msVertexDecode = 0;
+		msTextureDecode = 0;
+		msReadbacks = 0;
 		vertexGPUCycles = 0;
 		otherGPUCycles = 0;
 		memset(gpuCommandsAtCallLevel, 0, sizeof(gpuCommandsAtCallLevel));
+		memset(numFlushesByReason, 0, sizeof(numFlushesByReason));
+	}
+	void ResetFlushHistory() {
+		memset(numFlushesByReasonHistory, 0, sizeof(numFlushesByReasonHistory));
+		numFlushHistoryFrames = 0;
 	}
 
 	// Per frame statistics
@@ -88,19 +127,74 @@ struct GPUStatistics {
 	int numTextureSwitches;
 	int numShaderSwitches;
 	int numTexturesDecoded;
+	int numTextureDataBytesUploaded;
 	int numReadbacks;
 	int numUploads;
 	int numClears;
+	// Render passes the backend recorded for the last submitted frame, after merging.
+	// Only filled in by backends that queue up passes (Vulkan).
+	int numRenderPasses;
+	int numShaderCompiles;
+	int numPipelineCompiles;
+	// These are all in seconds, despite the name - multiply by 1000 for display.
 	double msProcessingDisplayLists;
+	double msVertexDecode;
+	double msTextureDecode;
+	double msReadbacks;
 	int vertexGPUCycles;
 	int otherGPUCycles;
 	int gpuCommandsAtCallLevel[4];
+	int numFlushesByReason[NUM_FLUSH_REASONS];
+
+	// Cross-frame flush totals, only reset by ResetFlushHistory (or a full Reset).
+	u64 numFlushesByReasonHistory[NUM_FLUSH_REASONS];
+	int numFlushHistoryFrames;
+
+	// Memory held by the GPU caches. These are levels, not per-frame counters -
+	// mirrored from gpuMemoryBudget during the decimation passes so they get
+	// exported along with everything else.
+	u64 textureCacheBytes;
+	u64 framebufferBytes;
+	u64 gpuMemoryBudgetBytes;
 
 	// Flip count. Doesn't really belong here.
 	int numFlips;
 };
 
+// Shared bookkeeping of the device memory held by the individual GPU caches, so
+// their decimation passes can react to combined pressure instead of each only
+// seeing its own occupancy. Each cache still evicts by its own policy - the
+// shared budget just turns eviction aggressive once the total crosses the budget
+// AND the cache in question is above its floor. The floors are what keep a
+// texture flood from pushing out the framebuffers needed next frame.
+struct GPUMemoryBudget {
+	// Rough combined budget for the caches. Could be sized per device some day.
+	u64 budgetBytes = 512 * 1024 * 1024;
+
+	// Occupancy, updated by the owning caches during their decimation passes.
+	u64 textureBytes = 0;
+	u64 framebufferBytes = 0;
+
+	// A cache below its floor is never evicted aggressively on the others' behalf.
+	static const u64 TEXTURE_FLOOR = 64 * 1024 * 1024;
+	static const u64 FRAMEBUFFER_FLOOR = 64 * 1024 * 1024;
+
+	bool OverBudget() const {
+		return textureBytes + framebufferBytes > budgetBytes;
+	}
+	bool TexturePressure() const {
+		return OverBudget() && textureBytes > TEXTURE_FLOOR;
+	}
+	bool FramebufferPressure() const {
+		return OverBudget() && framebufferBytes > FRAMEBUFFER_FLOOR;
+	}
+};
+
 extern GPUStatistics gpuStats;
+// Snapshot of the previous frame's stats, so they can be exported (e.g. over the web server)
+// without tearing mid-frame.
+extern GPUStatistics gpuStatsLastFrame;
+extern GPUMemoryBudget gpuMemoryBudget;
 extern GPUInterface *gpu;
 extern GPUDebugInterface *gpuDebug;
 
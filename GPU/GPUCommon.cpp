@@ -1,7 +1,16 @@
+#include "ppsspp_config.h"
+
 #include <algorithm>
 #include <type_traits>
 #include <mutex>
 
+#ifdef _M_SSE
+#include <emmintrin.h>
+#endif
+#if PPSSPP_ARCH(ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "base/timeutil.h"
 #include "profiler/profiler.h"
 
@@ -24,11 +33,14 @@
 #include "Core/HLE/sceGe.h"
 #include "Core/Debugger/Breakpoints.h"
 #include "Core/MemMapHelpers.h"
+#include "Core/MIPS/MIPS.h"
 #include "GPU/Common/DrawEngineCommon.h"
 #include "GPU/Common/FramebufferCommon.h"
 #include "GPU/Common/SplineCommon.h"
 #include "GPU/Common/TextureCacheCommon.h"
 #include "GPU/Debugger/Debugger.h"
+#include "GPU/Debugger/GeProfiler.h"
+#include "GPU/Debugger/GeSnapshot.h"
 #include "GPU/Debugger/Record.h"
 
 const CommonCommandTableEntry commonCommandTable[] = {
@@ -357,9 +369,140 @@ size_t commonCommandTableSize = ARRAY_SIZE(commonCommandTable);
 
 // TODO: Make class member?
 GPUCommon::CommandInfo GPUCommon::cmdInfo_[256];
+GPUCommon::CommandInfo GPUCommon::cmdInfoThrough_[256];
+uint64_t GPUCommon::throughDeferredDirty_;
+
+// Classifies the GE command that forced a flush, for gpuStats.numFlushesByReason.
+// Only commands with FLAG_FLUSHBEFOREONCHANGE ever get here.
+FlushReason FlushReasonFromCommand(u32 cmd) {
+	switch (cmd) {
+	case GE_CMD_VERTEXTYPE:
+	case GE_CMD_REVERSENORMAL:
+	case GE_CMD_PATCHDIVISION:
+	case GE_CMD_PATCHPRIMITIVE:
+	case GE_CMD_PATCHFACING:
+	case GE_CMD_PATCHCULLENABLE:
+		return FLUSH_REASON_VERTEX_FORMAT_CHANGE;
+
+	case GE_CMD_TEXTUREMAPENABLE:
+	case GE_CMD_TEXMODE:
+	case GE_CMD_TEXFORMAT:
+	case GE_CMD_TEXFILTER:
+	case GE_CMD_TEXWRAP:
+	case GE_CMD_TEXMAPMODE:
+	case GE_CMD_TEXSHADELS:
+	case GE_CMD_TEXFUNC:
+	case GE_CMD_TEXENVCOLOR:
+	case GE_CMD_TEXLODSLOPE:
+	case GE_CMD_CLUTFORMAT:
+		return FLUSH_REASON_TEXTURE_CHANGE;
+
+	case GE_CMD_CLUTADDR:
+	case GE_CMD_CLUTADDRUPPER:
+	case GE_CMD_LOADCLUT:
+		return FLUSH_REASON_CLUT_CHANGE;
+
+	case GE_CMD_FRAMEBUFPTR:
+	case GE_CMD_FRAMEBUFWIDTH:
+	case GE_CMD_FRAMEBUFPIXFORMAT:
+	case GE_CMD_ZBUFPTR:
+	case GE_CMD_ZBUFWIDTH:
+		return FLUSH_REASON_FRAMEBUF_CHANGE;
+
+	case GE_CMD_ALPHABLENDENABLE:
+	case GE_CMD_BLENDMODE:
+	case GE_CMD_BLENDFIXEDA:
+	case GE_CMD_BLENDFIXEDB:
+	case GE_CMD_MASKRGB:
+	case GE_CMD_MASKALPHA:
+	case GE_CMD_LOGICOP:
+	case GE_CMD_LOGICOPENABLE:
+	case GE_CMD_ALPHATEST:
+	case GE_CMD_ALPHATESTENABLE:
+	case GE_CMD_COLORTEST:
+	case GE_CMD_COLORTESTENABLE:
+	case GE_CMD_COLORTESTMASK:
+	case GE_CMD_COLORREF:
+	case GE_CMD_DITHERENABLE:
+		return FLUSH_REASON_BLEND_STATE_CHANGE;
+
+	case GE_CMD_ZTEST:
+	case GE_CMD_ZTESTENABLE:
+	case GE_CMD_ZWRITEDISABLE:
+	case GE_CMD_STENCILOP:
+	case GE_CMD_STENCILTEST:
+	case GE_CMD_STENCILTESTENABLE:
+	case GE_CMD_DEPTHCLAMPENABLE:
+	case GE_CMD_MINZ:
+	case GE_CMD_MAXZ:
+		return FLUSH_REASON_DEPTH_STENCIL_CHANGE;
+
+	case GE_CMD_VIEWPORTXSCALE:
+	case GE_CMD_VIEWPORTYSCALE:
+	case GE_CMD_VIEWPORTZSCALE:
+	case GE_CMD_VIEWPORTXCENTER:
+	case GE_CMD_VIEWPORTYCENTER:
+	case GE_CMD_VIEWPORTZCENTER:
+	case GE_CMD_SCISSOR1:
+	case GE_CMD_SCISSOR2:
+	case GE_CMD_REGION1:
+	case GE_CMD_REGION2:
+	case GE_CMD_OFFSETX:
+	case GE_CMD_OFFSETY:
+		return FLUSH_REASON_VIEWPORT_SCISSOR_CHANGE;
+
+	case GE_CMD_LIGHTINGENABLE:
+		return FLUSH_REASON_LIGHT_CHANGE;
 
-void GPUCommon::Flush() {
+	default:
+		// The texture addresses/sizes and the material/lighting block are
+		// contiguous command ranges - cheaper to test than to enumerate.
+		if (cmd >= GE_CMD_TEXADDR0 && cmd <= GE_CMD_TEXBUFWIDTH7)
+			return FLUSH_REASON_TEXTURE_CHANGE;
+		if (cmd >= GE_CMD_TEXSIZE0 && cmd <= GE_CMD_TEXSIZE7)
+			return FLUSH_REASON_TEXTURE_CHANGE;
+		if (cmd >= GE_CMD_LIGHTENABLE0 && cmd <= GE_CMD_LIGHTENABLE3)
+			return FLUSH_REASON_LIGHT_CHANGE;
+		if (cmd >= GE_CMD_MATERIALUPDATE && cmd <= GE_CMD_LSC3)
+			return FLUSH_REASON_LIGHT_CHANGE;
+		if (cmd >= GE_CMD_MORPHWEIGHT0 && cmd <= GE_CMD_MORPHWEIGHT7)
+			return FLUSH_REASON_VERTEX_FORMAT_CHANGE;
+		return FLUSH_REASON_OTHER_STATE_CHANGE;
+	}
+}
+
+const char *FlushReasonToString(FlushReason reason) {
+	switch (reason) {
+	case FLUSH_REASON_OTHER: return "Frame end / sync / other";
+	case FLUSH_REASON_TEXTURE_CHANGE: return "Texture change";
+	case FLUSH_REASON_CLUT_CHANGE: return "CLUT change";
+	case FLUSH_REASON_FRAMEBUF_CHANGE: return "Render target change";
+	case FLUSH_REASON_VERTEX_FORMAT_CHANGE: return "Vertex format change";
+	case FLUSH_REASON_MATRIX_CHANGE: return "Matrix change";
+	case FLUSH_REASON_LIGHT_CHANGE: return "Light/material change";
+	case FLUSH_REASON_BLEND_STATE_CHANGE: return "Blend/mask state change";
+	case FLUSH_REASON_DEPTH_STENCIL_CHANGE: return "Depth/stencil state change";
+	case FLUSH_REASON_VIEWPORT_SCISSOR_CHANGE: return "Viewport/scissor change";
+	case FLUSH_REASON_OTHER_STATE_CHANGE: return "Other state change";
+	case FLUSH_REASON_PRIM_TYPE_CHANGE: return "Primitive type change";
+	case FLUSH_REASON_BUFFER_FULL: return "Draw buffer full";
+	default: return "?";
+	}
+}
+
+void GPUCommon::Flush(FlushReason reason) {
+	drawEngineCommon_->SetFlushReason(reason);
 	drawEngineCommon_->DispatchFlush();
+	SnapshotAtFlush();
+}
+
+void GPUCommon::SnapshotAtFlush() {
+	if (!GeSnapshot::IsEnabled())
+		return;
+	if (currentList)
+		GeSnapshot::CaptureAtFlush(currentList->id, (int)currentList->state, currentList->startpc, currentList->pc, currentList->stall);
+	else
+		GeSnapshot::CaptureAtFlush(-1, 0, 0, 0, 0);
 }
 
 GPUCommon::GPUCommon(GraphicsContext *gfxCtx, Draw::DrawContext *draw) :
@@ -429,6 +572,28 @@ void GPUCommon::UpdateCmdInfo() {
 		cmdInfo_[GE_CMD_JUMP].func = &GPUCommon::Execute_Jump;
 		cmdInfo_[GE_CMD_CALL].func = &GPUCommon::Execute_Call;
 	}
+
+	// Rebuild the through-mode variant of the table. While the vertex type has the through
+	// bit set, queued draws ignore lighting and fog entirely, and any change to the through
+	// bit itself flushes - so plain state writes that only feed lighting/fog don't need to
+	// flush draws or dirty uniforms while this table is active. The skipped dirty bits get
+	// applied in Execute_VertexType when the through bit changes.
+	// Note that MATAMBIENTALPHA stays live: through-mode draws without vertex colors use
+	// the material ambient.
+	const uint64_t throughIgnoredDirty = DIRTY_FOGCOLOR | DIRTY_FOGCOEF | DIRTY_ALL_LIGHTS |
+		DIRTY_AMBIENT | DIRTY_MATDIFFUSE | DIRTY_MATSPECULAR | DIRTY_MATEMISSIVE;
+	memcpy(cmdInfoThrough_, cmdInfo_, sizeof(cmdInfoThrough_));
+	throughDeferredDirty_ = 0;
+	for (int i = 0; i < 256; i++) {
+		CommandInfo &info = cmdInfoThrough_[i];
+		const uint64_t dirty = info.flags >> 8;
+		const bool plainStateWrite = (info.flags & (FLAG_EXECUTE | FLAG_EXECUTEONCHANGE | FLAG_FLUSHBEFORE)) == 0;
+		if (plainStateWrite && dirty != 0 && (dirty & ~throughIgnoredDirty) == 0) {
+			throughDeferredDirty_ |= dirty;
+			// Low byte = flags, the rest = dirty bits. Clear both effects.
+			info.flags = 0;
+		}
+	}
 }
 
 void GPUCommon::BeginHostFrame() {
@@ -671,7 +836,8 @@ u32 GPUCommon::EnqueueList(u32 listpc, u32 stall, int subIntrBase, PSPPointer<Ps
 
 	for (int i = 0; i < DisplayListMaxCount; ++i) {
 		int possibleID = (i + nextListID) % DisplayListMaxCount;
-		auto possibleList = dls[possibleID];
+		// Note: referencing, not copying - the struct carries a 32-entry call stack.
+		const auto &possibleList = dls[possibleID];
 		if (possibleList.pendingInterrupt) {
 			continue;
 		}
@@ -710,6 +876,11 @@ u32 GPUCommon::EnqueueList(u32 listpc, u32 stall, int subIntrBase, PSPPointer<Ps
 	dl.bboxResult = false;
 	dl.stackAddr = stackAddr;
 
+	// Remember who enqueued this list, so list time can be attributed back to
+	// the game code that issued the draws.
+	if (GeProfiler::IsEnabled())
+		GeProfiler::NotifyEnqueue(id, currentMIPS->pc, currentMIPS->r[MIPS_REG_RA]);
+
 	if (args.IsValid() && args->context.IsValid())
 		dl.context = args->context;
 	else
@@ -773,9 +944,23 @@ u32 GPUCommon::UpdateStall(int listid, u32 newstall) {
 	if (dl.state == PSP_GE_DL_STATE_COMPLETED)
 		return SCE_KERNEL_ERROR_ALREADY;
 
-	dl.stall = newstall & 0x0FFFFFFF;
-	
-	ProcessDLQueue();
+	newstall &= 0x0FFFFFFF;
+	if (dl.stall != newstall) {
+		dl.stall = newstall;
+		if (dlQueue.empty() || dlQueue.front() == listid) {
+			ProcessDLQueue();
+		} else {
+			// The list is queued behind another one, so it can't run until the
+			// head completes - and that only happens inside a ProcessDLQueue
+			// run, which will see the new stall value when it gets there. No
+			// point walking the queue just to bounce off the stalled head.
+		}
+	} else {
+		// Nothing moved - the interpreter already ran up to this stall, and
+		// anything else runnable was handled by whoever made it runnable.
+		// Games hammer sceGeListUpdateStallAddr, so skipping the re-entry
+		// into the run loop here is worth it.
+	}
 
 	return 0;
 }
@@ -904,7 +1089,8 @@ void GPUCommon::NotifySteppingExit() {
 bool GPUCommon::InterpretList(DisplayList &list) {
 	// Initialized to avoid a race condition with bShowDebugStats changing.
 	double start = 0.0;
-	if (coreCollectDebugStats) {
+	const bool collectListTime = coreCollectDebugStats || GeProfiler::IsEnabled();
+	if (collectListTime) {
 		time_update();
 		start = time_now_d();
 	}
@@ -969,12 +1155,14 @@ bool GPUCommon::InterpretList(DisplayList &list) {
 
 	list.offsetAddr = gstate_c.offsetAddr;
 
-	if (coreCollectDebugStats) {
+	if (collectListTime) {
 		time_update();
 		double total = time_now_d() - start - timeSpentStepping_;
 		hleSetSteppingTime(timeSpentStepping_);
 		timeSpentStepping_ = 0.0;
 		gpuStats.msProcessingDisplayLists += total;
+		if (GeProfiler::IsEnabled())
+			GeProfiler::AddListTime(list.id, total);
 	}
 	return gpuState == GPUSTATE_DONE || gpuState == GPUSTATE_ERROR;
 }
@@ -982,7 +1170,7 @@ bool GPUCommon::InterpretList(DisplayList &list) {
 // Maybe should write this in ASM...
 void GPUCommon::FastRunLoop(DisplayList &list) {
 	PROFILE_THIS_SCOPE("gpuloop");
-	const CommandInfo *cmdInfo = cmdInfo_;
+	const CommandInfo *cmdInfo = gstate.isModeThrough() ? cmdInfoThrough_ : cmdInfo_;
 	int dc = downcount;
 	for (; dc > 0; --dc) {
 		// We know that display list PCs have the upper nibble == 0 - no need to mask the pointer
@@ -992,15 +1180,21 @@ void GPUCommon::FastRunLoop(DisplayList &list) {
 		const u32 diff = op ^ gstate.cmdmem[cmd];
 		if (diff == 0) {
 			if (info.flags & FLAG_EXECUTE) {
+				if (staticTrack_)
+					RecordStaticOp(op);
 				downcount = dc;
 				(this->*info.func)(op, diff);
 				dc = downcount;
+				cmdInfo = gstate.isModeThrough() ? cmdInfoThrough_ : cmdInfo_;
 			}
 		} else {
 			uint64_t flags = info.flags;
+			if (staticTrack_)
+				RecordStaticOp(op);
 			if (flags & FLAG_FLUSHBEFOREONCHANGE) {
 				if (drawEngineCommon_->GetNumDrawCalls()) {
 					drawEngineCommon_->DispatchFlush();
+					SnapshotAtFlush();
 				}
 			}
 			gstate.cmdmem[cmd] = op;
@@ -1008,6 +1202,8 @@ void GPUCommon::FastRunLoop(DisplayList &list) {
 				downcount = dc;
 				(this->*info.func)(op, diff);
 				dc = downcount;
+				// The handler may have toggled the through bit (GE_CMD_VERTEXTYPE).
+				cmdInfo = gstate.isModeThrough() ? cmdInfoThrough_ : cmdInfo_;
 			} else {
 				uint64_t dirty = flags >> 8;
 				if (dirty)
@@ -1019,8 +1215,42 @@ void GPUCommon::FastRunLoop(DisplayList &list) {
 	downcount = 0;
 }
 
+void GPUCommon::UpdateStaticFrameSkip() {
+	const bool wasSkipped = staticSkipActive_;
+	if (staticSkipActive_) {
+		staticSkipActive_ = false;
+		gstate_c.skipDrawReason &= ~SKIPDRAW_STATIC_FRAME;
+	}
+
+	// Needs an intact framebuffer to stand in for the skipped draws.
+	const bool enabled = g_Config.bStaticFrameSkip && g_Config.iRenderingMode != FB_NON_BUFFERED_MODE && !g_Config.bSoftwareRendering;
+
+	bool identical = false;
+	if (!wasSkipped) {
+		const std::vector<u32> &cur = staticOps_[staticOpsCur_];
+		const std::vector<u32> &prev = staticOps_[staticOpsCur_ ^ 1];
+		identical = staticTrack_ && staticMatched_ && !frameDynamic_ && !cur.empty() && cur.size() == prev.size();
+		staticFrames_ = identical ? staticFrames_ + 1 : 0;
+	}
+
+	if (identical && enabled && staticFrames_ >= 3) {
+		// Skip the coming frame's draws entirely. The reference stream stays
+		// in place so the full render after it revalidates against it.
+		staticSkipActive_ = true;
+		staticTrack_ = false;
+		gstate_c.skipDrawReason |= SKIPDRAW_STATIC_FRAME;
+	} else {
+		staticTrack_ = enabled && !dumpThisFrame_ && !dumpNextFrame_ && !GPUDebug::IsActive() && !GPURecord::IsActive();
+		staticOpsCur_ ^= 1;
+		staticOps_[staticOpsCur_].clear();
+		staticMatched_ = true;
+	}
+	frameDynamic_ = false;
+}
+
 void GPUCommon::BeginFrame() {
 	immCount_ = 0;
+	UpdateStaticFrameSkip();
 	if (dumpNextFrame_) {
 		NOTICE_LOG(G3D, "DUMPING THIS FRAME");
 		dumpThisFrame_ = true;
@@ -1463,7 +1693,7 @@ void GPUCommon::Execute_VertexType(u32 op, u32 diff) {
 	if (diff & (GE_VTYPE_TC_MASK | GE_VTYPE_THROUGH_MASK)) {
 		gstate_c.Dirty(DIRTY_UVSCALEOFFSET);
 		if (diff & GE_VTYPE_THROUGH_MASK)
-			gstate_c.Dirty(DIRTY_RASTER_STATE | DIRTY_VIEWPORTSCISSOR_STATE | DIRTY_FRAGMENTSHADER_STATE | DIRTY_CULLRANGE);
+			gstate_c.Dirty(DIRTY_RASTER_STATE | DIRTY_VIEWPORTSCISSOR_STATE | DIRTY_FRAGMENTSHADER_STATE | DIRTY_CULLRANGE | throughDeferredDirty_);
 	}
 }
 
@@ -1490,7 +1720,7 @@ void GPUCommon::Execute_VertexTypeSkinning(u32 op, u32 diff) {
 		gstate_c.Dirty(DIRTY_VERTEXSHADER_STATE);
 	}
 	if (diff & GE_VTYPE_THROUGH_MASK)
-		gstate_c.Dirty(DIRTY_RASTER_STATE | DIRTY_VIEWPORTSCISSOR_STATE | DIRTY_FRAGMENTSHADER_STATE | DIRTY_CULLRANGE);
+		gstate_c.Dirty(DIRTY_RASTER_STATE | DIRTY_VIEWPORTSCISSOR_STATE | DIRTY_FRAGMENTSHADER_STATE | DIRTY_CULLRANGE | throughDeferredDirty_);
 }
 
 
@@ -1522,7 +1752,7 @@ void GPUCommon::Execute_Prim(u32 op, u32 diff) {
 	// This also makes skipping drawing very effective.
 	framebufferManager_->SetRenderFrameBuffer(gstate_c.IsDirty(DIRTY_FRAMEBUF), gstate_c.skipDrawReason);
 
-	if (gstate_c.skipDrawReason & (SKIPDRAW_SKIPFRAME | SKIPDRAW_NON_DISPLAYED_FB)) {
+	if (gstate_c.skipDrawReason & (SKIPDRAW_SKIPFRAME | SKIPDRAW_NON_DISPLAYED_FB | SKIPDRAW_STATIC_FRAME)) {
 		// Rough estimate, not sure what's correct.
 		cyclesExecuted += EstimatePerVertexCost() * count;
 		if (gstate.isModeClear()) {
@@ -1564,7 +1794,7 @@ void GPUCommon::Execute_Prim(u32 op, u32 diff) {
 	// cull mode
 	int cullMode = gstate.getCullMode();
 
-	uint32_t vertTypeID = GetVertTypeID(vertexType, gstate.getUVGenMode());
+	uint32_t vertTypeID = GetVertTypeIDForDraw(vertexType, gstate.getUVGenMode());
 	drawEngineCommon_->SubmitPrim(verts, inds, prim, count, vertTypeID, cullMode, &bytesRead);
 	// After drawing, we advance the vertexAddr (when non indexed) or indexAddr (when indexed).
 	// Some games rely on this, they don't bother reloading VADDR and IADDR.
@@ -1623,7 +1853,7 @@ void GPUCommon::Execute_Prim(u32 op, u32 diff) {
 				goto bail;
 			} else {
 				vertexType = data;
-				vertTypeID = GetVertTypeID(vertexType, gstate.getUVGenMode());
+				vertTypeID = GetVertTypeIDForDraw(vertexType, gstate.getUVGenMode());
 			}
 			break;
 		}
@@ -1739,7 +1969,7 @@ void GPUCommon::Execute_Bezier(u32 op, u32 diff) {
 
 	// This also make skipping drawing very effective.
 	framebufferManager_->SetRenderFrameBuffer(gstate_c.IsDirty(DIRTY_FRAMEBUF), gstate_c.skipDrawReason);
-	if (gstate_c.skipDrawReason & (SKIPDRAW_SKIPFRAME | SKIPDRAW_NON_DISPLAYED_FB)) {
+	if (gstate_c.skipDrawReason & (SKIPDRAW_SKIPFRAME | SKIPDRAW_NON_DISPLAYED_FB | SKIPDRAW_STATIC_FRAME)) {
 		// TODO: Should this eat some cycles?  Probably yes.  Not sure if important.
 		return;
 	}
@@ -1803,7 +2033,7 @@ void GPUCommon::Execute_Spline(u32 op, u32 diff) {
 
 	// This also make skipping drawing very effective.
 	framebufferManager_->SetRenderFrameBuffer(gstate_c.IsDirty(DIRTY_FRAMEBUF), gstate_c.skipDrawReason);
-	if (gstate_c.skipDrawReason & (SKIPDRAW_SKIPFRAME | SKIPDRAW_NON_DISPLAYED_FB)) {
+	if (gstate_c.skipDrawReason & (SKIPDRAW_SKIPFRAME | SKIPDRAW_NON_DISPLAYED_FB | SKIPDRAW_STATIC_FRAME)) {
 		// TODO: Should this eat some cycles?  Probably yes.  Not sure if important.
 		return;
 	}
@@ -1902,6 +2132,43 @@ void GPUCommon::Execute_BlockTransferStart(u32 op, u32 diff) {
 	DoBlockTransfer(gstate_c.skipDrawReason);
 }
 
+// Copies a run of matrix data commands into gstate, shifting out the command byte.
+static void LoadMatrixWords(u32 *dst, const u32_le *src, int count) {
+	int i = 0;
+#ifdef _M_SSE
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_si128((__m128i *)&dst[i], _mm_slli_epi32(_mm_loadu_si128((const __m128i *)&src[i]), 8));
+	}
+#elif PPSSPP_ARCH(ARM_NEON)
+	for (; i + 4 <= count; i += 4) {
+		vst1q_u32(&dst[i], vshlq_n_u32(vld1q_u32((const u32 *)&src[i]), 8));
+	}
+#endif
+	for (; i < count; i++) {
+		dst[i] = src[i] << 8;
+	}
+}
+
+// Compares a run of matrix data commands against what's already loaded in gstate.
+static bool MatrixWordsEqual(const u32 *dst, const u32_le *src, int count) {
+	int i = 0;
+#ifdef _M_SSE
+	for (; i + 4 <= count; i += 4) {
+		const __m128i newVals = _mm_slli_epi32(_mm_loadu_si128((const __m128i *)&src[i]), 8);
+		const __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)&dst[i]), newVals);
+		if (_mm_movemask_epi8(eq) != 0xFFFF) {
+			return false;
+		}
+	}
+#endif
+	for (; i < count; i++) {
+		if (dst[i] != (src[i] << 8)) {
+			return false;
+		}
+	}
+	return true;
+}
+
 void GPUCommon::Execute_WorldMtxNum(u32 op, u32 diff) {
 	// This is almost always followed by GE_CMD_WORLDMATRIXDATA.
 	const u32_le *src = (const u32_le *)Memory::GetPointerUnchecked(currentList->pc + 4);
@@ -1917,16 +2184,13 @@ void GPUCommon::Execute_WorldMtxNum(u32 op, u32 diff) {
 	}
 
 	if (fastLoad) {
-		while ((src[i] >> 24) == GE_CMD_WORLDMATRIXDATA) {
-			const u32 newVal = src[i] << 8;
-			if (dst[i] != newVal) {
-				Flush();
-				dst[i] = newVal;
-				gstate_c.Dirty(DIRTY_WORLDMATRIX);
-			}
-			if (++i >= end) {
-				break;
-			}
+		while (i < end && (src[i] >> 24) == GE_CMD_WORLDMATRIXDATA) {
+			i++;
+		}
+		if (i != 0 && !MatrixWordsEqual(dst, src, i)) {
+			Flush(FLUSH_REASON_MATRIX_CHANGE);
+			LoadMatrixWords(dst, src, i);
+			gstate_c.Dirty(DIRTY_WORLDMATRIX);
 		}
 	}
 
@@ -1943,7 +2207,7 @@ void GPUCommon::Execute_WorldMtxData(u32 op, u32 diff) {
 	int num = gstate.worldmtxnum & 0xF;
 	u32 newVal = op << 8;
 	if (num < 12 && newVal != ((const u32 *)gstate.worldMatrix)[num]) {
-		Flush();
+		Flush(FLUSH_REASON_MATRIX_CHANGE);
 		((u32 *)gstate.worldMatrix)[num] = newVal;
 		gstate_c.Dirty(DIRTY_WORLDMATRIX);
 	}
@@ -1964,16 +2228,13 @@ void GPUCommon::Execute_ViewMtxNum(u32 op, u32 diff) {
 	}
 
 	if (fastLoad) {
-		while ((src[i] >> 24) == GE_CMD_VIEWMATRIXDATA) {
-			const u32 newVal = src[i] << 8;
-			if (dst[i] != newVal) {
-				Flush();
-				dst[i] = newVal;
-				gstate_c.Dirty(DIRTY_VIEWMATRIX);
-			}
-			if (++i >= end) {
-				break;
-			}
+		while (i < end && (src[i] >> 24) == GE_CMD_VIEWMATRIXDATA) {
+			i++;
+		}
+		if (i != 0 && !MatrixWordsEqual(dst, src, i)) {
+			Flush(FLUSH_REASON_MATRIX_CHANGE);
+			LoadMatrixWords(dst, src, i);
+			gstate_c.Dirty(DIRTY_VIEWMATRIX);
 		}
 	}
 
@@ -1990,7 +2251,7 @@ void GPUCommon::Execute_ViewMtxData(u32 op, u32 diff) {
 	int num = gstate.viewmtxnum & 0xF;
 	u32 newVal = op << 8;
 	if (num < 12 && newVal != ((const u32 *)gstate.viewMatrix)[num]) {
-		Flush();
+		Flush(FLUSH_REASON_MATRIX_CHANGE);
 		((u32 *)gstate.viewMatrix)[num] = newVal;
 		gstate_c.Dirty(DIRTY_VIEWMATRIX);
 	}
@@ -2011,16 +2272,13 @@ void GPUCommon::Execute_ProjMtxNum(u32 op, u32 diff) {
 	}
 
 	if (fastLoad) {
-		while ((src[i] >> 24) == GE_CMD_PROJMATRIXDATA) {
-			const u32 newVal = src[i] << 8;
-			if (dst[i] != newVal) {
-				Flush();
-				dst[i] = newVal;
-				gstate_c.Dirty(DIRTY_PROJMATRIX);
-			}
-			if (++i >= end) {
-				break;
-			}
+		while (i < end && (src[i] >> 24) == GE_CMD_PROJMATRIXDATA) {
+			i++;
+		}
+		if (i != 0 && !MatrixWordsEqual(dst, src, i)) {
+			Flush(FLUSH_REASON_MATRIX_CHANGE);
+			LoadMatrixWords(dst, src, i);
+			gstate_c.Dirty(DIRTY_PROJMATRIX);
 		}
 	}
 
@@ -2037,7 +2295,7 @@ void GPUCommon::Execute_ProjMtxData(u32 op, u32 diff) {
 	int num = gstate.projmtxnum & 0x1F;    // NOTE: Changed from 0xF to catch overflows
 	u32 newVal = op << 8;
 	if (num < 0x10 && newVal != ((const u32 *)gstate.projMatrix)[num]) {
-		Flush();
+		Flush(FLUSH_REASON_MATRIX_CHANGE);
 		((u32 *)gstate.projMatrix)[num] = newVal;
 		gstate_c.Dirty(DIRTY_PROJMATRIX);
 	}
@@ -2059,16 +2317,13 @@ void GPUCommon::Execute_TgenMtxNum(u32 op, u32 diff) {
 	}
 
 	if (fastLoad) {
-		while ((src[i] >> 24) == GE_CMD_TGENMATRIXDATA) {
-			const u32 newVal = src[i] << 8;
-			if (dst[i] != newVal) {
-				Flush();
-				dst[i] = newVal;
-				gstate_c.Dirty(DIRTY_TEXMATRIX);
-			}
-			if (++i >= end) {
-				break;
-			}
+		while (i < end && (src[i] >> 24) == GE_CMD_TGENMATRIXDATA) {
+			i++;
+		}
+		if (i != 0 && !MatrixWordsEqual(dst, src, i)) {
+			Flush(FLUSH_REASON_MATRIX_CHANGE);
+			LoadMatrixWords(dst, src, i);
+			gstate_c.Dirty(DIRTY_TEXMATRIX);
 		}
 	}
 
@@ -2085,7 +2340,7 @@ void GPUCommon::Execute_TgenMtxData(u32 op, u32 diff) {
 	int num = gstate.texmtxnum & 0xF;
 	u32 newVal = op << 8;
 	if (num < 12 && newVal != ((const u32 *)gstate.tgenMatrix)[num]) {
-		Flush();
+		Flush(FLUSH_REASON_MATRIX_CHANGE);
 		((u32 *)gstate.tgenMatrix)[num] = newVal;
 		gstate_c.Dirty(DIRTY_TEXMATRIX | DIRTY_FRAGMENTSHADER_STATE);  // We check the matrix to see if we need projection
 	}
@@ -2106,30 +2361,40 @@ void GPUCommon::Execute_BoneMtxNum(u32 op, u32 diff) {
 	}
 
 	if (fastLoad) {
+		// Find the contiguous run of data commands up front so whole matrices
+		// can be compared and copied at a time.
+		int run = 0;
+		while (run < end && (src[run] >> 24) == GE_CMD_BONEMATRIXDATA) {
+			run++;
+		}
+
 		// If we can't use software skinning, we have to flush and dirty.
 		if (!g_Config.bSoftwareSkinning) {
-			while ((src[i] >> 24) == GE_CMD_BONEMATRIXDATA) {
-				const u32 newVal = src[i] << 8;
-				if (dst[i] != newVal) {
-					Flush();
-					dst[i] = newVal;
-				}
-				if (++i >= end) {
-					break;
+			// Compare per matrix and only flush/dirty the ones that actually changed -
+			// skinned scenes often re-send identical palettes, and an unchanged matrix
+			// shouldn't cost a uniform re-upload.
+			while (i < run) {
+				const int num = (op & 0x7F) + i;
+				if ((num % 12) == 0 && run - i >= 12) {
+					if (!MatrixWordsEqual(dst + i, src + i, 12)) {
+						Flush(FLUSH_REASON_MATRIX_CHANGE);
+						LoadMatrixWords(dst + i, src + i, 12);
+						gstate_c.Dirty(DIRTY_BONEMATRIX0 << (num / 12));
+					}
+					i += 12;
+				} else {
+					const u32 newVal = src[i] << 8;
+					if (dst[i] != newVal) {
+						Flush(FLUSH_REASON_MATRIX_CHANGE);
+						dst[i] = newVal;
+						gstate_c.Dirty(DIRTY_BONEMATRIX0 << (num / 12));
+					}
+					i++;
 				}
 			}
-
-			const unsigned int numPlusCount = (op & 0x7F) + i;
-			for (unsigned int num = op & 0x7F; num < numPlusCount; num += 12) {
-				gstate_c.Dirty(DIRTY_BONEMATRIX0 << (num / 12));
-			}
 		} else {
-			while ((src[i] >> 24) == GE_CMD_BONEMATRIXDATA) {
-				dst[i] = src[i] << 8;
-				if (++i >= end) {
-					break;
-				}
-			}
+			LoadMatrixWords(dst, src, run);
+			i = run;
 
 			const unsigned int numPlusCount = (op & 0x7F) + i;
 			for (unsigned int num = op & 0x7F; num < numPlusCount; num += 12) {
@@ -2153,7 +2418,7 @@ void GPUCommon::Execute_BoneMtxData(u32 op, u32 diff) {
 	if (num < 96 && newVal != ((const u32 *)gstate.boneMatrix)[num]) {
 		// Bone matrices should NOT flush when software skinning is enabled!
 		if (!g_Config.bSoftwareSkinning) {
-			Flush();
+			Flush(FLUSH_REASON_MATRIX_CHANGE);
 			gstate_c.Dirty(DIRTY_BONEMATRIX0 << (num / 12));
 		} else {
 			gstate_c.deferredVertTypeDirty |= DIRTY_BONEMATRIX0 << (num / 12);
@@ -2212,7 +2477,7 @@ void GPUCommon::Execute_ImmVertexAlphaPrim(u32 op, u32 diff) {
 void GPUCommon::FlushImm() {
 	SetDrawType(DRAW_PRIM, immPrim_);
 	framebufferManager_->SetRenderFrameBuffer(gstate_c.IsDirty(DIRTY_FRAMEBUF), gstate_c.skipDrawReason);
-	if (gstate_c.skipDrawReason & (SKIPDRAW_SKIPFRAME | SKIPDRAW_NON_DISPLAYED_FB)) {
+	if (gstate_c.skipDrawReason & (SKIPDRAW_SKIPFRAME | SKIPDRAW_NON_DISPLAYED_FB | SKIPDRAW_STATIC_FRAME)) {
 		// No idea how many cycles to skip, heh.
 		return;
 	}
@@ -2301,6 +2566,15 @@ void GPUCommon::FastLoadBoneMatrix(u32 target) {
 	uint32_t uniformsToDirty = DIRTY_BONEMATRIX0 << mtxNum;
 	if ((num - 12 * mtxNum) != 0) {
 		uniformsToDirty |= DIRTY_BONEMATRIX0 << ((mtxNum + 1) & 7);
+	} else if (mtxNum < 8) {
+		// Aligned load of one full matrix. If it matches what's already loaded we can
+		// skip the flush and the uniform re-upload entirely - games CALL the same
+		// palette over and over across draws.
+		const u32_le *src = (const u32_le *)Memory::GetPointerUnchecked(target);
+		if (MatrixWordsEqual((const u32 *)&gstate.boneMatrix[num], src, 12)) {
+			gstate.boneMatrixNumber = (GE_CMD_BONEMATRIXNUMBER << 24) | ((num + 12) & 0x7F);
+			return;
+		}
 	}
 
 	if (!g_Config.bSoftwareSkinning) {
@@ -2711,6 +2985,10 @@ bool GPUCommon::PerformMemoryUpload(u32 dest, int size) {
 }
 
 void GPUCommon::InvalidateCache(u32 addr, int size, GPUInvalidationType type) {
+	// All GPU-visible memory changes funnel through here (memcpy/memset/video
+	// uploads included) - the scene can't be considered static this frame.
+	NotifyFrameDynamic();
+
 	if (size > 0)
 		textureCache_->Invalidate(addr, size, type);
 	else
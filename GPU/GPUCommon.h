@@ -39,6 +39,10 @@ enum {
 	FLAG_DIRTYONCHANGE = 64,  // NOTE: Either this or FLAG_EXECUTE*, not both!
 };
 
+// Maps a GE command with FLAG_FLUSHBEFOREONCHANGE to the flush histogram bucket
+// it should be accounted under.
+FlushReason FlushReasonFromCommand(u32 cmd);
+
 struct TransformedVertex {
 	union {
 		struct {
@@ -168,7 +172,10 @@ public:
 	int EstimatePerVertexCost();
 
 	// Note: Not virtual!
-	void Flush();
+	void Flush(FlushReason reason = FLUSH_REASON_OTHER);
+
+	// Captures the GE state for the pause-free sampler, if it's enabled.
+	void SnapshotAtFlush();
 
 #ifdef USE_CRT_DBG
 #undef new
@@ -293,6 +300,33 @@ protected:
 	void DoBlockTransfer(u32 skipDrawReason);
 	void DoExecuteCall(u32 target);
 
+	// Static scene detection (StaticFrameSkip): the stream of effectful GE ops
+	// is recorded each rendered frame and compared against the previous one.
+	// After a few identical frames, every other frame's draws are skipped -
+	// the framebuffer already holds the exact scene - and the following full
+	// render revalidates, so any surprise heals within a frame.
+	inline void RecordStaticOp(u32 op) {
+		std::vector<u32> &cur = staticOps_[staticOpsCur_];
+		cur.push_back(op);
+		if (staticMatched_) {
+			const std::vector<u32> &prev = staticOps_[staticOpsCur_ ^ 1];
+			const size_t i = cur.size() - 1;
+			if (i >= prev.size() || prev[i] != op)
+				staticMatched_ = false;
+		}
+	}
+	// Memory changed in a GPU-visible way - don't treat this frame as static,
+	// and stop skipping right now if we were.
+	void NotifyFrameDynamic() {
+		frameDynamic_ = true;
+		staticFrames_ = 0;
+		if (staticSkipActive_) {
+			staticSkipActive_ = false;
+			gstate_c.skipDrawReason &= ~SKIPDRAW_STATIC_FRAME;
+		}
+	}
+	void UpdateStaticFrameSkip();
+
 	void AdvanceVerts(u32 vertType, int count, int bytesRead) {
 		if ((vertType & GE_VTYPE_IDX_MASK) != GE_VTYPE_IDX_NONE) {
 			int indexShift = ((vertType & GE_VTYPE_IDX_MASK) >> GE_VTYPE_IDX_SHIFT) - 1;
@@ -316,6 +350,13 @@ protected:
 	};
 
 	static CommandInfo cmdInfo_[256];
+	// Variant of cmdInfo_ used by FastRunLoop while the vertex type has the through bit
+	// set. Queued draws then ignore lighting and fog entirely, so commands that only feed
+	// that state neither flush nor dirty anything; the skipped dirty bits are applied when
+	// the through bit changes. Built in UpdateCmdInfo().
+	static CommandInfo cmdInfoThrough_[256];
+	// The union of dirty bits the through-mode table skips.
+	static uint64_t throughDeferredDirty_;
 
 	typedef std::list<int> DisplayListQueue;
 
@@ -345,6 +386,15 @@ protected:
 
 	int vertexCost_ = 0;
 
+	// See RecordStaticOp()/UpdateStaticFrameSkip().
+	std::vector<u32> staticOps_[2];
+	int staticOpsCur_ = 0;
+	bool staticTrack_ = false;
+	bool staticMatched_ = true;
+	bool staticSkipActive_ = false;
+	bool frameDynamic_ = false;
+	int staticFrames_ = 0;
+
 	// No idea how big this buffer needs to be.
 	enum {
 		MAX_IMMBUFFER_SIZE = 32,
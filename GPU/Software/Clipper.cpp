@@ -222,11 +222,17 @@ void ProcessRect(const VertexData& v0, const VertexData& v1)
 		if (gstate.isModeClear()) {
 			Rasterizer::ClearRectangle(v0, v1);
 		} else {
-			// Four triangles to do backfaces as well. Two of them will get backface culled.
-			Rasterizer::DrawTriangle(*topleft, *topright, *bottomright);
-			Rasterizer::DrawTriangle(*bottomright, *topright, *topleft);
-			Rasterizer::DrawTriangle(*bottomright, *bottomleft, *topleft);
-			Rasterizer::DrawTriangle(*topleft, *bottomleft, *bottomright);
+			// When the corners were swapped on one axis only, RotateUVThrough() rotated
+			// the texture mapping relative to the screen rect - that (rare) case still
+			// needs the triangle path below.
+			const bool rotatedUV = (v0.screenpos.x < v1.screenpos.x) != (v0.screenpos.y < v1.screenpos.y);
+			if (rotatedUV || !Rasterizer::DrawSprite(*topleft, *bottomright)) {
+				// Four triangles to do backfaces as well. Two of them will get backface culled.
+				Rasterizer::DrawTriangle(*topleft, *topright, *bottomright);
+				Rasterizer::DrawTriangle(*bottomright, *topright, *topleft);
+				Rasterizer::DrawTriangle(*bottomright, *bottomleft, *topleft);
+				Rasterizer::DrawTriangle(*topleft, *bottomleft, *bottomright);
+			}
 		}
 	}
 }
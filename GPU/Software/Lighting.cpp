@@ -36,107 +36,151 @@ static inline float pspLightPow(float v, float e) {
 	return v;
 }
 
-void Process(VertexData& vertex, bool hasColor) {
+void ComputeState(State *state, bool hasColor) {
 	const int materialupdate = gstate.materialupdate & (hasColor ? 7 : 0);
+	state->colorForAmbient = (materialupdate & 1) != 0;
+	state->colorForDiffuse = (materialupdate & 2) != 0;
+	state->colorForSpecular = (materialupdate & 4) != 0;
+
+	state->materialEmissive = Vec3<float>::FromRGB(gstate.getMaterialEmissive());
+	state->materialAmbient = Vec3<float>::FromRGB(gstate.getMaterialAmbientRGBA());
+	state->materialDiffuse = Vec3<float>::FromRGB(gstate.getMaterialDiffuse());
+	state->materialSpecular = Vec3<float>::FromRGB(gstate.getMaterialSpecular());
+	state->baseAmbient = Vec3<float>::FromRGB(gstate.getAmbientRGBA());
+	state->specularCoef = gstate.getMaterialSpecularCoef();
+	state->materialAmbientA = gstate.getMaterialAmbientA();
+	state->ambientA = gstate.getAmbientA();
+
+	state->lightingEnabled = gstate.isLightingEnabled();
+	state->usingSecondaryColor = gstate.isUsingSecondaryColor();
+
+	state->shadeMapping = gstate.getUVGenMode() == GE_TEXMAP_ENVIRONMENT_MAP;
+	if (state->shadeMapping) {
+		const int uvls[2] = { gstate.getUVLS0(), gstate.getUVLS1() };
+		for (int chan = 0; chan < 2; ++chan) {
+			Vec3<float> L = GetLightVec(gstate.lpos, uvls[chan]);
+			// In other words, L.Length2() == 0.0f means Dot({0, 0, 1}, worldnormal).
+			state->shadeUseNormalZ[chan] = L.Length2() == 0.0f;
+			state->shadeDir[chan] = state->shadeUseNormalZ[chan] ? L : L.Normalized();
+		}
+	}
 
-	Vec3<float> vcol0 = vertex.color0.rgb().Cast<float>() * Vec3<float>::AssignToAll(1.0f / 255.0f);
-	Vec3<float> mec = Vec3<float>::FromRGB(gstate.getMaterialEmissive());
+	for (int light = 0; light < 4; ++light) {
+		auto &lstate = state->lights[light];
+		lstate.enabled = state->lightingEnabled && gstate.isLightChanEnabled(light);
+		if (!lstate.enabled)
+			continue;
 
-	Vec3<float> mac = (materialupdate & 1) ? vcol0 : Vec3<float>::FromRGB(gstate.getMaterialAmbientRGBA());
-	Vec3<float> final_color = mec + mac * Vec3<float>::FromRGB(gstate.getAmbientRGBA());
-	Vec3<float> specular_color(0.0f, 0.0f, 0.0f);
+		lstate.directional = gstate.isDirectionalLight(light);
+		lstate.poweredDiffuse = gstate.isUsingPoweredDiffuseLight(light);
+		lstate.specular = gstate.isUsingSpecularLight(light);
 
-	for (unsigned int light = 0; light < 4; ++light) {
-		// Always calculate texture coords from lighting results if environment mapping is active
-		// TODO: Should specular lighting should affect this, too?  Doesn't in GLES.
-		// This should be done even if lighting is disabled altogether.
-		if (gstate.getUVGenMode() == GE_TEXMAP_ENVIRONMENT_MAP) {
-			Vec3<float> L = GetLightVec(gstate.lpos, light);
-			// In other words, L.Length2() == 0.0f means Dot({0, 0, 1}, worldnormal).
-			float diffuse_factor = L.Length2() == 0.0f ? vertex.worldnormal.z : Dot(L.Normalized(), vertex.worldnormal);
+		// TODO: Should transfer the light positions to world/view space for these calculations?
+		lstate.pos = GetLightVec(gstate.lpos, light);
+		if (lstate.directional) {
+			// TODO: Should this normalize (0, 0, 0) to (0, 0, 1)?
+			lstate.pos.Normalize();
+		} else {
+			lstate.att = GetLightVec(gstate.latt, light);
+		}
+
+		lstate.spot = gstate.isSpotLight(light);
+		if (lstate.spot) {
+			Vec3<float> dir = GetLightVec(gstate.ldir, light);
+			lstate.spotZeroDir = dir.Length2() == 0.0f;
+			lstate.spotDir = lstate.spotZeroDir ? dir : dir.Normalized();
+			lstate.spotCutoff = getFloat24(gstate.lcutoff[light]);
+			lstate.spotExp = getFloat24(gstate.lconv[light]);
+		}
 
-			if (gstate.getUVLS0() == (int)light)
-				vertex.texturecoords.s() = (diffuse_factor + 1.f) / 2.f;
+		lstate.ambientColor = Vec3<float>::FromRGB(gstate.getLightAmbientColor(light));
+		lstate.diffuseColor = Vec3<float>::FromRGB(gstate.getDiffuseColor(light));
+		if (lstate.specular)
+			lstate.specularColor = Vec3<float>::FromRGB(gstate.getSpecularColor(light));
+	}
+}
 
-			if (gstate.getUVLS1() == (int)light)
-				vertex.texturecoords.t() = (diffuse_factor + 1.f) / 2.f;
+void Process(VertexData &vertex, const State &state) {
+	// Always calculate texture coords from lighting results if environment mapping is active
+	// TODO: Should specular lighting should affect this, too?  Doesn't in GLES.
+	// This should be done even if lighting is disabled altogether.
+	if (state.shadeMapping) {
+		float ls[2];
+		for (int chan = 0; chan < 2; ++chan) {
+			ls[chan] = state.shadeUseNormalZ[chan] ? vertex.worldnormal.z : Dot(state.shadeDir[chan], vertex.worldnormal);
 		}
+		vertex.texturecoords.s() = (ls[0] + 1.f) / 2.f;
+		vertex.texturecoords.t() = (ls[1] + 1.f) / 2.f;
 	}
 
-	if (!gstate.isLightingEnabled())
+	if (!state.lightingEnabled)
 		return;
 
-	for (unsigned int light = 0; light < 4; ++light) {
-		if (!gstate.isLightChanEnabled(light))
+	Vec3<float> vcol0 = vertex.color0.rgb().Cast<float>() * Vec3<float>::AssignToAll(1.0f / 255.0f);
+
+	Vec3<float> mac = state.colorForAmbient ? vcol0 : state.materialAmbient;
+	Vec3<float> mdc = state.colorForDiffuse ? vcol0 : state.materialDiffuse;
+	Vec3<float> final_color = state.materialEmissive + mac * state.baseAmbient;
+	Vec3<float> specular_color(0.0f, 0.0f, 0.0f);
+
+	for (int light = 0; light < 4; ++light) {
+		const auto &lstate = state.lights[light];
+		if (!lstate.enabled)
 			continue;
 
-		// L =  vector from vertex to light source
-		// TODO: Should transfer the light positions to world/view space for these calculations?
-		Vec3<float> L = GetLightVec(gstate.lpos, light);
-		if (!gstate.isDirectionalLight(light)) {
+		// L = vector from vertex to light source
+		Vec3<float> L = lstate.pos;
+		float att = 1.f;
+		if (!lstate.directional) {
 			L -= vertex.worldpos;
-		}
-		// TODO: Should this normalize (0, 0, 0) to (0, 0, 1)?
-		float d = L.Normalize();
+			float d = L.Normalize();
 
-		float att = 1.f;
-		if (!gstate.isDirectionalLight(light)) {
-			att = 1.f / Dot(GetLightVec(gstate.latt, light), Vec3f(1.0f, d, d * d));
+			att = 1.f / Dot(lstate.att, Vec3f(1.0f, d, d * d));
 			if (att > 1.f) att = 1.f;
 			if (att < 0.f) att = 0.f;
 		}
 
 		float spot = 1.f;
-		if (gstate.isSpotLight(light)) {
-			Vec3<float> dir = GetLightVec(gstate.ldir, light);
-			float rawSpot = dir.Length2() == 0.0f ? 0.0f : Dot(dir.Normalized(), L);
-			float cutoff = getFloat24(gstate.lcutoff[light]);
-			if (rawSpot >= cutoff) {
-				float conv = getFloat24(gstate.lconv[light]);
-				spot = pspLightPow(rawSpot, conv);
+		if (lstate.spot) {
+			float rawSpot = lstate.spotZeroDir ? 0.0f : Dot(lstate.spotDir, L);
+			if (rawSpot >= lstate.spotCutoff) {
+				spot = pspLightPow(rawSpot, lstate.spotExp);
 			} else {
 				spot = 0.f;
 			}
 		}
 
 		// ambient lighting
-		Vec3<float> lac = Vec3<float>::FromRGB(gstate.getLightAmbientColor(light));
-		final_color += lac * mac * att * spot;
+		final_color += lstate.ambientColor * mac * att * spot;
 
 		// diffuse lighting
-		Vec3<float> ldc = Vec3<float>::FromRGB(gstate.getDiffuseColor(light));
-		Vec3<float> mdc = (materialupdate & 2) ? vcol0 : Vec3<float>::FromRGB(gstate.getMaterialDiffuse());
-
 		float diffuse_factor = Dot(L, vertex.worldnormal);
-		if (gstate.isUsingPoweredDiffuseLight(light)) {
-			float k = gstate.getMaterialSpecularCoef();
-			diffuse_factor = pspLightPow(diffuse_factor, k);
+		if (lstate.poweredDiffuse) {
+			diffuse_factor = pspLightPow(diffuse_factor, state.specularCoef);
 		}
 
 		if (diffuse_factor > 0.f) {
-			final_color += ldc * mdc * diffuse_factor * att * spot;
+			final_color += lstate.diffuseColor * mdc * (diffuse_factor * att * spot);
 		}
 
-		if (gstate.isUsingSpecularLight(light) && diffuse_factor >= 0.0f) {
+		if (lstate.specular && diffuse_factor >= 0.0f) {
 			Vec3<float> H = L + Vec3<float>(0.f, 0.f, 1.f);
 
-			Vec3<float> lsc = Vec3<float>::FromRGB(gstate.getSpecularColor(light));
-			Vec3<float> msc = (materialupdate & 4) ? vcol0 : Vec3<float>::FromRGB(gstate.getMaterialSpecular());
+			Vec3<float> msc = state.colorForSpecular ? vcol0 : state.materialSpecular;
 
 			float specular_factor = Dot(H.Normalized(), vertex.worldnormal);
-			float k = gstate.getMaterialSpecularCoef();
-			specular_factor = pspLightPow(specular_factor, k);
+			specular_factor = pspLightPow(specular_factor, state.specularCoef);
 
 			if (specular_factor > 0.f) {
-				specular_color += lsc * msc * specular_factor * att * spot;
+				specular_color += lstate.specularColor * msc * (specular_factor * att * spot);
 			}
 		}
 	}
 
-	int maa = (materialupdate & 1) ? vertex.color0.a() : gstate.getMaterialAmbientA();
-	int final_alpha = (gstate.getAmbientA() * maa) / 255;
+	int maa = state.colorForAmbient ? vertex.color0.a() : state.materialAmbientA;
+	int final_alpha = (state.ambientA * maa) / 255;
 
-	if (gstate.isUsingSecondaryColor()) {
+	if (state.usingSecondaryColor) {
 		Vec3<int> final_color_int = (final_color.Clamp(0.0f, 1.0f) * 255.0f).Cast<int>();
 		vertex.color0 = Vec4<int>(final_color_int, final_alpha);
 		vertex.color1 = (specular_color.Clamp(0.0f, 1.0f) * 255.0f).Cast<int>();
@@ -21,6 +21,54 @@
 
 namespace Lighting {
 
-void Process(VertexData& vertex, bool hasColor);
+// Per-draw lighting state, so the per-vertex path doesn't have to decode
+// float24 light params or renormalize constant vectors for every vertex.
+// Mirrors how the hardware backends specialize their vertex shaders by
+// light configuration - here the configuration is baked into flags instead.
+struct State {
+	struct {
+		bool enabled;
+		bool directional;
+		bool poweredDiffuse;
+		bool specular;
+		bool spot;
+		bool spotZeroDir;
 
-}
\ No newline at end of file
+		// Normalized direction for directional lights, raw position otherwise.
+		Vec3<float> pos;
+		Vec3<float> att;
+		Vec3<float> spotDir;
+		float spotCutoff;
+		float spotExp;
+
+		Vec3<float> ambientColor;
+		Vec3<float> diffuseColor;
+		Vec3<float> specularColor;
+	} lights[4];
+
+	Vec3<float> materialEmissive;
+	Vec3<float> materialAmbient;
+	Vec3<float> materialDiffuse;
+	Vec3<float> materialSpecular;
+	Vec3<float> baseAmbient;
+	float specularCoef;
+
+	bool lightingEnabled;
+	bool usingSecondaryColor;
+	bool colorForAmbient;
+	bool colorForDiffuse;
+	bool colorForSpecular;
+	int materialAmbientA;
+	int ambientA;
+
+	// Shade mapping (environment map UV gen), fed by light directions even
+	// with lighting disabled.  One entry each for the S and T channels.
+	bool shadeMapping;
+	bool shadeUseNormalZ[2];
+	Vec3<float> shadeDir[2];
+};
+
+void ComputeState(State *state, bool hasColor);
+void Process(VertexData &vertex, const State &state);
+
+}
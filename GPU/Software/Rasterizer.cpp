@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "profiler/profiler.h"
@@ -840,20 +841,22 @@ static inline Vec3<int> AlphaBlendingResult(const Vec4<int> &source, const Vec4<
 	}
 }
 
-template <bool clearMode>
-inline void DrawSinglePixel(const DrawingCoords &p, u16 z, u8 fog, const Vec4<int> &color_in) {
+// The enable checks that would otherwise run per pixel are baked in as template
+// arguments; GetSingleFunc() picks the instantiation matching the current state.
+template <bool clearMode, bool alphaTestOn, bool fogOn, bool alphaBlendOn>
+void DrawSinglePixel(const DrawingCoords &p, u16 z, u8 fog, const Vec4<int> &color_in) {
 	Vec4<int> prim_color = color_in.Clamp(0, 255);
 	// Depth range test - applied in clear mode, if not through mode.
 	if (!gstate.isModeThrough())
 		if (z < gstate.getDepthRangeMin() || z > gstate.getDepthRangeMax())
 			return;
 
-	if (gstate.isAlphaTestEnabled() && !clearMode)
+	if (alphaTestOn && !clearMode)
 		if (!AlphaTestPassed(prim_color.a()))
 			return;
 
 	// Fog is applied prior to color test.
-	if (gstate.isFogEnabled() && !gstate.isModeThrough() && !clearMode) {
+	if (fogOn && !gstate.isModeThrough() && !clearMode) {
 		Vec3<int> fogColor = Vec3<int>::FromRGB(gstate.fogcolor);
 		fogColor = (prim_color.rgb() * (int)fog + fogColor * (255 - (int)fog)) / 255;
 		prim_color.r() = fogColor.r();
@@ -895,7 +898,7 @@ inline void DrawSinglePixel(const DrawingCoords &p, u16 z, u8 fog, const Vec4<in
 	const u32 old_color = GetPixelColor(p.x, p.y);
 	u32 new_color;
 
-	if (gstate.isAlphaBlendEnabled() && !clearMode) {
+	if (alphaBlendOn && !clearMode) {
 		const Vec4<int> dst = Vec4<int>::FromRGBA(old_color);
 		// ToRGB() always automatically clamps.
 		new_color = AlphaBlendingResult(prim_color, dst).ToRGB();
@@ -924,6 +927,38 @@ inline void DrawSinglePixel(const DrawingCoords &p, u16 z, u8 fog, const Vec4<in
 	SetPixelColor(p.x, p.y, new_color);
 }
 
+typedef void (*SingleFunc)(const DrawingCoords &p, u16 z, u8 fog, const Vec4<int> &color_in);
+
+// Returns the DrawSinglePixel instantiation for the current state. This is the poor
+// man's version of a jitted pixel pipeline: the ID is the set of enables we specialize
+// on, and the "cache" is the instantiations the compiler already emitted. The remaining
+// per-pixel state reads (tests, stencil ops, logic ops, masks) are comparatively rare.
+template <bool clearMode>
+static SingleFunc GetSingleFunc() {
+	if (clearMode) {
+		// The specialized enables are all ignored in clear mode.
+		return &DrawSinglePixel<true, false, false, false>;
+	}
+	int id = 0;
+	if (gstate.isAlphaTestEnabled())
+		id |= 1;
+	if (gstate.isFogEnabled())
+		id |= 2;
+	if (gstate.isAlphaBlendEnabled())
+		id |= 4;
+	static const SingleFunc funcs[8] = {
+		&DrawSinglePixel<false, false, false, false>,
+		&DrawSinglePixel<false, true, false, false>,
+		&DrawSinglePixel<false, false, true, false>,
+		&DrawSinglePixel<false, true, true, false>,
+		&DrawSinglePixel<false, false, false, true>,
+		&DrawSinglePixel<false, true, false, true>,
+		&DrawSinglePixel<false, false, true, true>,
+		&DrawSinglePixel<false, true, true, true>,
+	};
+	return funcs[id];
+}
+
 static inline void ApplyTexturing(Sampler::Funcs sampler, Vec4<int> &prim_color, float s, float t, int texlevel, int frac_texlevel, bool bilinear, u8 *texptr[], int texbufw[]) {
 	int u[8] = {0}, v[8] = {0};   // 1.23.8 fixed point
 	int frac_u[2], frac_v[2];
@@ -1170,6 +1205,7 @@ void DrawTriangleSlice(
 	const bool flatZ = v0.screenpos.z == v1.screenpos.z && v0.screenpos.z == v2.screenpos.z;
 
 	Sampler::Funcs sampler = Sampler::GetFuncs();
+	SingleFunc drawPixel = GetSingleFunc<clearMode>();
 
 	for (pprime.y = minY; pprime.y < maxY; pprime.y += 32,
 										w0_base = e0.StepY(w0_base),
@@ -1269,13 +1305,85 @@ void DrawTriangleSlice(
 					subp.x = p.x + (i & 1);
 					subp.y = p.y + (i / 2);
 
-					DrawSinglePixel<clearMode>(subp, (u16)z[i], fog[i], prim_color[i]);
+					drawPixel(subp, (u16)z[i], fog[i], prim_color[i]);
 				}
 			}
 		}
 	}
 }
 
+// Triangles too small to be worth slicing individually get collected here and rasterized
+// as a batch at the end of the draw call, in parallel by horizontal bands. All triangles
+// in the bin share the same GPU state - TransformUnit::SubmitPrimitive flushes before
+// returning, and any other draw in Rasterizer flushes before touching the framebuffer.
+struct BinnedTriangle {
+	VertexData v0, v1, v2;
+	int minX, minY, maxX, maxY;
+};
+
+enum {
+	// Band height in screen subpixels. Must be a multiple of 32 (two pixel rows) so that
+	// the 2x2 quads DrawTriangleSlice steps over never straddle a band boundary.
+	TRIANGLE_BIN_BAND_HEIGHT = 64 * 16,
+	TRIANGLE_BIN_FLUSH_COUNT = 1024,
+	// Below this many triangles, threading overhead beats the parallelism.
+	TRIANGLE_BIN_MIN_PARALLEL = 32,
+};
+
+static std::vector<BinnedTriangle> triangleBin;
+static bool triangleBinClearMode;
+
+template <bool clearMode>
+static void DrawBinnedBands(const BinnedTriangle *tris, size_t count, int binMinY, int bandA, int bandB) {
+	const int y0 = binMinY + bandA * TRIANGLE_BIN_BAND_HEIGHT;
+	const int y1 = binMinY + bandB * TRIANGLE_BIN_BAND_HEIGHT;
+	for (size_t i = 0; i < count; i++) {
+		const BinnedTriangle &t = tris[i];
+		const int minY = std::max(t.minY, y0);
+		const int maxY = std::min(t.maxY, y1);
+		if (minY >= maxY)
+			continue;
+		DrawTriangleSlice<clearMode>(t.v0, t.v1, t.v2, t.minX, minY, t.maxX, maxY, true, 0, (maxY - minY) / 32 + 1);
+	}
+}
+
+void FlushBinnedTriangles() {
+	if (triangleBin.empty())
+		return;
+	PROFILE_THIS_SCOPE("draw_tribin");
+
+	int binMinY = triangleBin[0].minY;
+	int binMaxY = triangleBin[0].maxY;
+	for (size_t i = 1; i < triangleBin.size(); i++) {
+		binMinY = std::min(binMinY, triangleBin[i].minY);
+		binMaxY = std::max(binMaxY, triangleBin[i].maxY);
+	}
+	const int numBands = (binMaxY - binMinY + TRIANGLE_BIN_BAND_HEIGHT - 1) / TRIANGLE_BIN_BAND_HEIGHT;
+
+	if (triangleBin.size() < TRIANGLE_BIN_MIN_PARALLEL || numBands <= 1) {
+		for (size_t i = 0; i < triangleBin.size(); i++) {
+			const BinnedTriangle &t = triangleBin[i];
+			const int rangeY = (t.maxY - t.minY) / 32 + 1;
+			if (triangleBinClearMode) {
+				DrawTriangleSlice<true>(t.v0, t.v1, t.v2, t.minX, t.minY, t.maxX, t.maxY, true, 0, rangeY);
+			} else {
+				DrawTriangleSlice<false>(t.v0, t.v1, t.v2, t.minX, t.minY, t.maxX, t.maxY, true, 0, rangeY);
+			}
+		}
+	} else if (triangleBinClearMode) {
+		auto bound = [&](int a, int b) -> void {
+			DrawBinnedBands<true>(triangleBin.data(), triangleBin.size(), binMinY, a, b);
+		};
+		GlobalThreadPool::Loop(bound, 0, numBands);
+	} else {
+		auto bound = [&](int a, int b) -> void {
+			DrawBinnedBands<false>(triangleBin.data(), triangleBin.size(), binMinY, a, b);
+		};
+		GlobalThreadPool::Loop(bound, 0, numBands);
+	}
+	triangleBin.clear();
+}
+
 // Draws triangle, vertices specified in counter-clockwise direction
 void DrawTriangle(const VertexData& v0, const VertexData& v1, const VertexData& v2)
 {
@@ -1296,14 +1404,42 @@ void DrawTriangle(const VertexData& v0, const VertexData& v1, const VertexData&
 
 	DrawingCoords scissorTL(gstate.getScissorX1(), gstate.getScissorY1(), 0);
 	DrawingCoords scissorBR(gstate.getScissorX2(), gstate.getScissorY2(), 0);
+	const int scissorTopY = (int)TransformUnit::DrawingToScreen(scissorTL).y;
 	minX = std::max(minX, (int)TransformUnit::DrawingToScreen(scissorTL).x);
 	maxX = std::min(maxX, (int)TransformUnit::DrawingToScreen(scissorBR).x);
-	minY = std::max(minY, (int)TransformUnit::DrawingToScreen(scissorTL).y);
+	minY = std::max(minY, scissorTopY);
 	maxY = std::min(maxY, (int)TransformUnit::DrawingToScreen(scissorBR).y);
 
 	// 32 because we do two pixels at once, and we don't want overlap.
 	int rangeY = (maxY - minY) / 32 + 1;
 	int rangeX = (maxX - minX) / 32 + 1;
+	if (rangeY < 12 && rangeX < 12) {
+		// Small triangle - bin it, so the whole batch can be rasterized across cores when
+		// the draw call ends. Aligning minY down to the quad grid keeps quads from ever
+		// straddling a band boundary; that only works if the scissor top is on the grid
+		// too, otherwise fall through and draw it serially right away.
+		if ((scissorTopY & 31) == 0) {
+			if (triangleBin.empty())
+				triangleBinClearMode = gstate.isModeClear();
+			BinnedTriangle bt;
+			bt.v0 = v0;
+			bt.v1 = v1;
+			bt.v2 = v2;
+			bt.minX = minX;
+			bt.minY = minY & ~31;
+			bt.maxX = maxX;
+			bt.maxY = maxY;
+			triangleBin.push_back(bt);
+			if (triangleBin.size() >= TRIANGLE_BIN_FLUSH_COUNT)
+				FlushBinnedTriangles();
+			return;
+		}
+		// Couldn't bin - draw it serially below, in order with anything already binned.
+		FlushBinnedTriangles();
+	} else {
+		// This triangle draws immediately, so anything already binned has to land first.
+		FlushBinnedTriangles();
+	}
 	if (rangeY >= 12 && rangeX >= rangeY * 4) {
 		if (gstate.isModeClear()) {
 			auto bound = [&](int a, int b) -> void {
@@ -1339,6 +1475,8 @@ void DrawTriangle(const VertexData& v0, const VertexData& v1, const VertexData&
 
 void DrawPoint(const VertexData &v0)
 {
+	FlushBinnedTriangles();
+
 	ScreenCoords pos = v0.screenpos;
 	Vec4<int> prim_color = v0.color0;
 	Vec3<int> sec_color = v0.color1;
@@ -1407,14 +1545,199 @@ void DrawPoint(const VertexData &v0)
 	}
 
 	if (clearMode) {
-		DrawSinglePixel<true>(p, z, fog, prim_color);
+		GetSingleFunc<true>()(p, z, fog, prim_color);
 	} else {
-		DrawSinglePixel<false>(p, z, fog, prim_color);
+		GetSingleFunc<false>()(p, z, fog, prim_color);
 	}
 }
 
+// Through-mode rectangles (sprites) have constant color and Z, and their texture
+// coordinates are axis-aligned, so instead of expanding them to triangles we can
+// walk the destination in horizontal spans. Simple states - 8888 target, no tests,
+// no blending - additionally get direct store loops that move several pixels per
+// iteration, which is where video frames and most UI end up.
+// Returns false when the state or geometry needs the generic triangle path.
+bool DrawSprite(const VertexData &v0, const VertexData &v1)
+{
+	const ScreenCoords pos0 = v0.screenpos;
+	const ScreenCoords pos1 = v1.screenpos;
+
+	// Only handle the common case: corners on whole pixels, properly ordered.
+	if (((pos0.x | pos0.y | pos1.x | pos1.y) & 0xF) != 0)
+		return false;
+	if (pos0.x >= pos1.x || pos0.y >= pos1.y)
+		return false;
+
+	const bool textureEnabled = gstate.isTextureMapEnabled();
+	const int texwidth = gstate.getTextureWidth(0);
+	const int texheight = gstate.getTextureHeight(0);
+
+	// Texel coordinates across the rect, in 16.16 fixed point.
+	int ustart = 0, vstart = 0, ustep = 0, vstep = 0;
+	u8 *texptr = nullptr;
+	int texbufw = 0;
+	if (textureEnabled) {
+		const int wtotal = (pos1.x - pos0.x) / 16;
+		const int htotal = (pos1.y - pos0.y) / 16;
+		const float ds = (v1.texturecoords.s() - v0.texturecoords.s()) / wtotal;
+		const float dt = (v1.texturecoords.t() - v0.texturecoords.t()) / htotal;
+
+		// Sprites nearly always blit 1:1 or magnify, but let the state decide -
+		// mipmapped or bilinear sampling goes through the triangle path.
+		int texLevel, texLevelFrac;
+		bool bilinear;
+		CalculateSamplingParams(ds / texwidth, dt / texheight, gstate.isMipmapEnabled() ? gstate.getTextureMaxLevel() : 0, texLevel, texLevelFrac, bilinear);
+		if (texLevel != 0 || texLevelFrac != 0 || bilinear)
+			return false;
+
+		const u32 texaddr = gstate.getTextureAddress(0);
+		if (!Memory::IsValidAddress(texaddr))
+			return false;
+		texptr = Memory::GetPointerUnchecked(texaddr);
+		texbufw = GetTextureBufw(0, texaddr, gstate.getTextureFormat());
+
+		// Sample at pixel centers, with the same rounding bias GetTexelCoordinates() applies.
+		ustep = (int)(ds * 65536.0f);
+		vstep = (int)(dt * 65536.0f);
+		ustart = (int)((v0.texturecoords.s() + 0.5f * ds) * 65536.0f) + 96;
+		vstart = (int)((v0.texturecoords.t() + 0.5f * dt) * 65536.0f) + 96;
+	}
+
+	// Pixel coverage matches the triangle path: centers inside the rect, clipped
+	// against the (inclusive) scissor rectangle.
+	DrawingCoords scissorTL(gstate.getScissorX1(), gstate.getScissorY1(), 0);
+	DrawingCoords scissorBR(gstate.getScissorX2(), gstate.getScissorY2(), 0);
+	const int minX = std::max((int)pos0.x, (int)TransformUnit::DrawingToScreen(scissorTL).x);
+	const int minY = std::max((int)pos0.y, (int)TransformUnit::DrawingToScreen(scissorTL).y);
+	const int maxX = std::min((int)pos1.x, (int)TransformUnit::DrawingToScreen(scissorBR).x + 16);
+	const int maxY = std::min((int)pos1.y, (int)TransformUnit::DrawingToScreen(scissorBR).y + 16);
+	if (minX >= maxX || minY >= maxY) {
+		// Fully scissored away, but handled.
+		return true;
+	}
+
+	ustart += ustep * ((minX - pos0.x) / 16);
+	vstart += vstep * ((minY - pos0.y) / 16);
+
+	const int w = (maxX - minX) / 16;
+	const int h = (maxY - minY) / 16;
+
+	// We draw right away, so anything already binned has to land first.
+	FlushBinnedTriangles();
+
+	const Vec4<int> prim_color = v1.color0;
+	const Vec3<int> sec_color = v1.color1;
+	const u16 z = pos1.z;
+	const u8 fog = 255;
+
+	const DrawingCoords pstart = TransformUnit::ScreenToDrawing(ScreenCoords(minX, minY, 0));
+	const int fbStride = gstate.FrameBufStride();
+
+	// With no tests, blending, logic op or masking on an 8888 target, pixels can be
+	// stored directly; destination alpha is kept, which is exactly what the generic
+	// path would have written back as stencil.
+	const bool simpleState = gstate.FrameBufFormat() == GE_FORMAT_8888 &&
+		!gstate.isAlphaTestEnabled() && !gstate.isColorTestEnabled() &&
+		!gstate.isAlphaBlendEnabled() && !gstate.isLogicOpEnabled() &&
+		!gstate.isStencilTestEnabled() && !gstate.isDepthTestEnabled() &&
+		gstate.getColorMask() == 0;
+
+	const bool flatSecColor = (sec_color.r() | sec_color.g() | sec_color.b()) == 0;
+
+	if (simpleState && textureEnabled && flatSecColor &&
+		gstate.getTextureFunction() == GE_TEXFUNC_REPLACE &&
+		gstate.getTextureFormat() == GE_TFMT_8888 && !gstate.isTextureSwizzled() &&
+		ustep == 0x10000 && vstep == 0x10000 &&
+		(ustart >> 16) >= 0 && (ustart >> 16) + w <= texwidth &&
+		(vstart >> 16) >= 0 && (vstart >> 16) + h <= texheight) {
+		// The fully linear 1:1 blit - straight span copies, several pixels at a time.
+		const int u0 = ustart >> 16;
+		const int v0tex = vstart >> 16;
+		for (int y = 0; y < h; ++y) {
+			const u32 *src = (const u32 *)texptr + (v0tex + y) * texbufw + u0;
+			u32 *dst = &fb.as32[pstart.x + (pstart.y + y) * fbStride];
+			int x = 0;
+#if defined(_M_SSE)
+			const __m128i amask = _mm_set1_epi32(0xFF000000);
+			for (; x + 4 <= w; x += 4) {
+				const __m128i tex = _mm_loadu_si128((const __m128i *)&src[x]);
+				const __m128i old = _mm_loadu_si128((const __m128i *)&dst[x]);
+				_mm_storeu_si128((__m128i *)&dst[x], _mm_or_si128(_mm_andnot_si128(amask, tex), _mm_and_si128(amask, old)));
+			}
+#endif
+			for (; x < w; ++x) {
+				dst[x] = (src[x] & 0x00FFFFFF) | (dst[x] & 0xFF000000);
+			}
+		}
+		return true;
+	}
+
+	if (simpleState && !textureEnabled) {
+		// Untextured fill - a single color across every span.
+		const u32 rgb = Vec3<int>(prim_color.r() + sec_color.r(), prim_color.g() + sec_color.g(), prim_color.b() + sec_color.b()).ToRGB();
+		for (int y = 0; y < h; ++y) {
+			u32 *dst = &fb.as32[pstart.x + (pstart.y + y) * fbStride];
+			int x = 0;
+#if defined(_M_SSE)
+			const __m128i amask = _mm_set1_epi32(0xFF000000);
+			const __m128i rgbv = _mm_set1_epi32(rgb);
+			for (; x + 4 <= w; x += 4) {
+				const __m128i old = _mm_loadu_si128((const __m128i *)&dst[x]);
+				_mm_storeu_si128((__m128i *)&dst[x], _mm_or_si128(rgbv, _mm_and_si128(amask, old)));
+			}
+#endif
+			for (; x < w; ++x) {
+				dst[x] = rgb | (dst[x] & 0xFF000000);
+			}
+		}
+		return true;
+	}
+
+	Sampler::Funcs sampler = Sampler::GetFuncs();
+	SingleFunc drawPixel = GetSingleFunc<false>();
+
+	const bool clampS = gstate.isTexCoordClampedS();
+	const bool clampT = gstate.isTexCoordClampedT();
+
+	int vfix = vstart;
+	for (int y = 0; y < h; ++y, vfix += vstep) {
+		int vtex = 0;
+		if (textureEnabled)
+			vtex = clampT ? ClampUV(vfix >> 16, texheight) : WrapUV(vfix >> 16, texheight);
+
+		int ufix = ustart;
+		if (simpleState && textureEnabled) {
+			// No per-pixel state to apply, but the texture still needs sampling
+			// and the texture function - store the result directly.
+			u32 *dst = &fb.as32[pstart.x + (pstart.y + y) * fbStride];
+			for (int x = 0; x < w; ++x, ufix += ustep) {
+				const int utex = clampS ? ClampUV(ufix >> 16, texwidth) : WrapUV(ufix >> 16, texwidth);
+				const Vec4<int> tex_color = Vec4<int>::FromRGBA(sampler.nearest(utex, vtex, texptr, texbufw, 0));
+				const Vec4<int> out = GetTextureFunctionOutput(prim_color, tex_color);
+				dst[x] = Vec3<int>(out.r() + sec_color.r(), out.g() + sec_color.g(), out.b() + sec_color.b()).ToRGB() | (dst[x] & 0xFF000000);
+			}
+		} else {
+			DrawingCoords p = pstart;
+			p.y += y;
+			for (int x = 0; x < w; ++x, ufix += ustep, ++p.x) {
+				Vec4<int> out = prim_color;
+				if (textureEnabled) {
+					const int utex = clampS ? ClampUV(ufix >> 16, texwidth) : WrapUV(ufix >> 16, texwidth);
+					const Vec4<int> tex_color = Vec4<int>::FromRGBA(sampler.nearest(utex, vtex, texptr, texbufw, 0));
+					out = GetTextureFunctionOutput(out, tex_color);
+				}
+				out += Vec4<int>(sec_color, 0);
+				drawPixel(p, z, fog, out);
+			}
+		}
+	}
+	return true;
+}
+
 void ClearRectangle(const VertexData &v0, const VertexData &v1)
 {
+	FlushBinnedTriangles();
+
 	int minX = std::min(v0.screenpos.x, v1.screenpos.x) & ~0xF;
 	int minY = std::min(v0.screenpos.y, v1.screenpos.y) & ~0xF;
 	int maxX = (std::max(v0.screenpos.x, v1.screenpos.x) + 0xF) & ~0xF;
@@ -1543,6 +1866,8 @@ void ClearRectangle(const VertexData &v0, const VertexData &v1)
 
 void DrawLine(const VertexData &v0, const VertexData &v1)
 {
+	FlushBinnedTriangles();
+
 	// TODO: Use a proper line drawing algorithm that handles fractional endpoints correctly.
 	Vec3<int> a(v0.screenpos.x, v0.screenpos.y, v0.screenpos.z);
 	Vec3<int> b(v1.screenpos.x, v1.screenpos.y, v0.screenpos.z);
@@ -1660,9 +1985,9 @@ void DrawLine(const VertexData &v0, const VertexData &v1)
 
 			DrawingCoords p = TransformUnit::ScreenToDrawing(pprime);
 			if (clearMode) {
-				DrawSinglePixel<true>(p, z, fog, prim_color);
+				GetSingleFunc<true>()(p, z, fog, prim_color);
 			} else {
-				DrawSinglePixel<false>(p, z, fog, prim_color);
+				GetSingleFunc<false>()(p, z, fog, prim_color);
 			}
 		}
 
@@ -25,8 +25,14 @@ namespace Rasterizer {
 
 // Draws a triangle if its vertices are specified in counter-clockwise order
 void DrawTriangle(const VertexData& v0, const VertexData& v1, const VertexData& v2);
+// Rasterizes any triangles DrawTriangle has collected for banded parallel drawing.
+// Must be called before anything outside the rasterizer reads or writes the framebuffer.
+void FlushBinnedTriangles();
 void DrawPoint(const VertexData &v0);
 void DrawLine(const VertexData &v0, const VertexData &v1);
+// Span-based fast path for through-mode rectangles with axis-aligned UVs.
+// Returns false when the state needs the generic triangle path instead.
+bool DrawSprite(const VertexData &v0, const VertexData &v1);
 void ClearRectangle(const VertexData &v0, const VertexData &v1);
 
 bool GetCurrentStencilbuffer(GPUDebugBuffer &buffer);
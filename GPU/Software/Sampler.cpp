@@ -215,7 +215,7 @@ NearestFunc SamplerJitCache::GetNearest(const SamplerID &id) {
 	}
 
 	// TODO
-#ifdef _M_X64
+#if defined(_M_X64) || PPSSPP_ARCH(ARM64)
 	addresses_[id] = GetCodePointer();
 	NearestFunc func = Compile(id);
 	cache_[id] = func;
@@ -239,7 +239,7 @@ LinearFunc SamplerJitCache::GetLinear(const SamplerID &id) {
 	}
 
 	// TODO
-#ifdef _M_X64
+#if defined(_M_X64) || PPSSPP_ARCH(ARM64)
 	addresses_[id] = GetCodePointer();
 	LinearFunc func = CompileLinear(id);
 	cache_[id] = (NearestFunc)func;
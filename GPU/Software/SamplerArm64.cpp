@@ -0,0 +1,538 @@
+// Copyright (c) 2017- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#include "ppsspp_config.h"
+#if PPSSPP_ARCH(ARM64)
+
+#include "Common/Arm64Emitter.h"
+#include "Common/CPUDetect.h"
+#include "GPU/GPUState.h"
+#include "GPU/Software/Sampler.h"
+#include "GPU/ge_constants.h"
+
+using namespace Arm64Gen;
+
+extern u32 clut[4096];
+
+namespace Sampler {
+
+// The nearest sampler takes its arguments in the standard AAPCS64 registers.
+static const ARM64Reg uReg = W0;
+static const ARM64Reg vReg = W1;
+static const ARM64Reg srcReg = X2;
+static const ARM64Reg bufwReg = W3;
+static const ARM64Reg levelReg = W4;
+
+// Result is built here, then moved to W0 at the end.
+static const ARM64Reg resultReg = W8;
+static const ARM64Reg tempReg1 = W9;
+static const ARM64Reg tempReg1_64 = X9;
+static const ARM64Reg tempReg2 = W10;
+static const ARM64Reg tempReg3 = W11;
+static const ARM64Reg scratchReg = W12;
+
+NearestFunc SamplerJitCache::Compile(const SamplerID &id) {
+	BeginWrite();
+	const u8 *start = AlignCode16();
+
+	// Early exit on !srcPtr.
+	FixupBranch zeroSrc;
+	if (id.hasInvalidPtr) {
+		zeroSrc = CBZ(srcReg);
+	}
+
+	if (!Jit_ReadTextureFormat(id)) {
+		EndWrite();
+		SetCodePtr(const_cast<u8 *>(start));
+		return nullptr;
+	}
+
+	MOV(W0, resultReg);
+	RET();
+
+	if (id.hasInvalidPtr) {
+		SetJumpTarget(zeroSrc);
+		MOVZ(W0, 0);
+		RET();
+	}
+
+	FlushIcache();
+	EndWrite();
+	return (NearestFunc)start;
+}
+
+LinearFunc SamplerJitCache::CompileLinear(const SamplerID &id) {
+	_assert_msg_(G3D, id.linear, "Linear should be set on sampler id");
+	BeginWrite();
+
+	// We'll first write the nearest sampler, which we will BL.
+	// This may differ slightly based on the "linear" flag.
+	const u8 *nearest = AlignCode16();
+
+	if (!Jit_ReadTextureFormat(id)) {
+		EndWrite();
+		SetCodePtr(const_cast<u8 *>(nearest));
+		return nullptr;
+	}
+
+	MOV(W0, resultReg);
+	RET();
+
+	// Now the actual linear func, which is exposed externally.
+	const u8 *start = AlignCode16();
+
+	// Incoming: X0=uptr, X1=vptr, W2=frac_u, W3=frac_v, X4=src, W5=bufw, W6=level.
+	// We stash the arguments in callee-saved registers across the nearest calls,
+	// and gather the four texel results at SP+80.
+	STP(INDEX_PRE, X29, X30, SP, -96);
+	STP(INDEX_SIGNED, X19, X20, SP, 16);
+	STP(INDEX_SIGNED, X21, X22, SP, 32);
+	STP(INDEX_SIGNED, X23, X24, SP, 48);
+	STR(INDEX_UNSIGNED, X25, SP, 64);
+
+	MOV(X19, X0);
+	MOV(X20, X1);
+	MOV(W21, W2);
+	MOV(W22, W3);
+	MOV(X23, X4);
+	MOV(W24, W5);
+	MOV(W25, W6);
+
+	// Early exit on !srcPtr.
+	FixupBranch zeroSrc;
+	if (id.hasInvalidPtr) {
+		zeroSrc = CBZ(X23);
+	}
+
+	auto doNearestCall = [&](int off) {
+		LDR(INDEX_UNSIGNED, uReg, X19, off);
+		LDR(INDEX_UNSIGNED, vReg, X20, off);
+		MOV(srcReg, X23);
+		MOV(bufwReg, W24);
+		MOV(levelReg, W25);
+		BL(nearest);
+		STR(INDEX_UNSIGNED, W0, SP, 80 + off);
+	};
+
+	doNearestCall(0);
+	doNearestCall(4);
+	doNearestCall(8);
+	doNearestCall(12);
+
+	// Load TL, TR, BL, BR in one go and widen each color to a float vector.
+	fp.LDR(128, INDEX_UNSIGNED, Q0, SP, 80);
+	fp.UXTL(8, Q1, D0);
+	fp.UXTL2(8, Q2, Q0);
+	fp.UXTL(16, Q4, D2);
+	fp.UXTL2(16, Q5, Q1);
+	fp.UXTL(16, Q6, D4);
+	fp.UXTL2(16, Q7, Q2);
+	fp.UCVTF(32, Q4, Q4);
+	fp.UCVTF(32, Q5, Q5);
+	fp.UCVTF(32, Q6, Q6);
+	fp.UCVTF(32, Q7, Q7);
+
+	fp.MOVI2FDUP(Q1, 1.0f / 256.0f, scratchReg);
+	fp.MOVI2FDUP(Q3, 1.0f, scratchReg);
+
+	// Blend the left and right sides by frac_u first...
+	fp.SCVTF(S0, W21);
+	fp.DUP(32, Q0, Q0, 0);
+	fp.FMUL(32, Q0, Q0, Q1);
+	fp.FSUB(32, Q2, Q3, Q0);
+	fp.FMUL(32, Q4, Q4, Q2);
+	fp.FMLA(32, Q4, Q5, Q0);
+	fp.FMUL(32, Q6, Q6, Q2);
+	fp.FMLA(32, Q6, Q7, Q0);
+
+	// ... and then top and bottom by frac_v.
+	fp.SCVTF(S0, W22);
+	fp.DUP(32, Q0, Q0, 0);
+	fp.FMUL(32, Q0, Q0, Q1);
+	fp.FSUB(32, Q2, Q3, Q0);
+	fp.FMUL(32, Q4, Q4, Q2);
+	fp.FMLA(32, Q4, Q6, Q0);
+
+	// Still at the 255 scale, truncate and narrow back to a single 32 bit value.
+	// The channels can't exceed 255, so plain narrowing is safe.
+	fp.FCVTZS(32, Q4, Q4);
+	fp.XTN(16, D4, Q4);
+	fp.XTN(8, D4, Q4);
+	fp.UMOV(32, W0, Q4, 0);
+
+	if (id.hasInvalidPtr) {
+		FixupBranch doneSrc = B();
+		SetJumpTarget(zeroSrc);
+		MOVZ(W0, 0);
+		SetJumpTarget(doneSrc);
+	}
+
+	LDP(INDEX_SIGNED, X19, X20, SP, 16);
+	LDP(INDEX_SIGNED, X21, X22, SP, 32);
+	LDP(INDEX_SIGNED, X23, X24, SP, 48);
+	LDR(INDEX_UNSIGNED, X25, SP, 64);
+	LDP(INDEX_POST, X29, X30, SP, 96);
+
+	RET();
+
+	FlushIcache();
+	EndWrite();
+	return (LinearFunc)start;
+}
+
+bool SamplerJitCache::Jit_ReadTextureFormat(const SamplerID &id) {
+	GETextureFormat fmt = (GETextureFormat)id.texfmt;
+	bool success = true;
+	switch (fmt) {
+	case GE_TFMT_5650:
+		success = Jit_GetTexData(id, 16);
+		if (success)
+			success = Jit_Decode5650();
+		break;
+
+	case GE_TFMT_5551:
+		success = Jit_GetTexData(id, 16);
+		if (success)
+			success = Jit_Decode5551();
+		break;
+
+	case GE_TFMT_4444:
+		success = Jit_GetTexData(id, 16);
+		if (success)
+			success = Jit_Decode4444();
+		break;
+
+	case GE_TFMT_8888:
+		success = Jit_GetTexData(id, 32);
+		break;
+
+	case GE_TFMT_CLUT32:
+		success = Jit_GetTexData(id, 32);
+		if (success)
+			success = Jit_TransformClutIndex(id, 32);
+		if (success)
+			success = Jit_ReadClutColor(id);
+		break;
+
+	case GE_TFMT_CLUT16:
+		success = Jit_GetTexData(id, 16);
+		if (success)
+			success = Jit_TransformClutIndex(id, 16);
+		if (success)
+			success = Jit_ReadClutColor(id);
+		break;
+
+	case GE_TFMT_CLUT8:
+		success = Jit_GetTexData(id, 8);
+		if (success)
+			success = Jit_TransformClutIndex(id, 8);
+		if (success)
+			success = Jit_ReadClutColor(id);
+		break;
+
+	case GE_TFMT_CLUT4:
+		success = Jit_GetTexData(id, 4);
+		if (success)
+			success = Jit_TransformClutIndex(id, 4);
+		if (success)
+			success = Jit_ReadClutColor(id);
+		break;
+
+	// TODO: DXT?
+	default:
+		success = false;
+	}
+
+	return success;
+}
+
+bool SamplerJitCache::Jit_GetTexData(const SamplerID &id, int bitsPerTexel) {
+	if (id.swizzle) {
+		return Jit_GetTexDataSwizzled(id, bitsPerTexel);
+	}
+
+	switch (bitsPerTexel) {
+	case 32:
+		MADD(tempReg1, vReg, bufwReg, uReg);
+		LDR(resultReg, srcReg, ArithOption(tempReg1, true));
+		break;
+
+	case 16:
+		MADD(tempReg1, vReg, bufwReg, uReg);
+		LDRH(resultReg, srcReg, ArithOption(tempReg1, true));
+		break;
+
+	case 8:
+		MADD(tempReg1, vReg, bufwReg, uReg);
+		LDRB(resultReg, srcReg, ArithOption(tempReg1));
+		break;
+
+	case 4:
+		MADD(tempReg1, vReg, bufwReg, uReg);
+		LSR(tempReg2, tempReg1, 1);
+		LDRB(resultReg, srcReg, ArithOption(tempReg2));
+		// Take the upper nibble for odd texels.
+		ANDI2R(tempReg2, tempReg1, 1);
+		LSL(tempReg2, tempReg2, 2);
+		LSRV(resultReg, resultReg, tempReg2);
+		ANDI2R(resultReg, resultReg, 0x0F);
+		break;
+
+	default:
+		return false;
+	}
+
+	return true;
+}
+
+bool SamplerJitCache::Jit_GetTexDataSwizzled4() {
+	// Horizontal tile offset: (u / 32) * 128 bytes.
+	LSL(tempReg1, uReg, 2);
+	ANDI2R(tempReg1, tempReg1, 0xFFFFFF80, scratchReg);
+
+	// Vertical offset inside the tile: (v % 8) * 16 bytes.
+	ANDI2R(tempReg2, vReg, 7);
+	ADD(tempReg1, tempReg1, tempReg2, ArithOption(tempReg2, ST_LSL, 4));
+
+	// Vertical tile offset: (v / 8) * bufw * 4 bytes.
+	LSR(tempReg2, vReg, 3);
+	LSL(tempReg3, bufwReg, 2);
+	MADD(tempReg1, tempReg2, tempReg3, tempReg1);
+
+	// And last, the horizontal offset inside the tile.
+	ANDI2R(tempReg2, uReg, 31);
+	ADD(tempReg1, tempReg1, tempReg2, ArithOption(tempReg2, ST_LSR, 1));
+	LDRB(resultReg, srcReg, ArithOption(tempReg1));
+
+	// If the horizontal offset was odd, take the upper 4.
+	ANDI2R(tempReg2, uReg, 1);
+	LSL(tempReg2, tempReg2, 2);
+	LSRV(resultReg, resultReg, tempReg2);
+	ANDI2R(resultReg, resultReg, 0x0F);
+
+	return true;
+}
+
+bool SamplerJitCache::Jit_GetTexDataSwizzled(const SamplerID &id, int bitsPerTexel) {
+	if (bitsPerTexel == 4) {
+		// Specialized implementation.
+		return Jit_GetTexDataSwizzled4();
+	}
+
+	int uTexelShift;
+	int uTileShift;
+	int vRowShift;
+	switch (bitsPerTexel) {
+	case 32:
+		uTexelShift = 0;
+		uTileShift = 2;
+		vRowShift = 0;
+		break;
+	case 16:
+		uTexelShift = 1;
+		uTileShift = 3;
+		vRowShift = 1;
+		break;
+	case 8:
+		uTexelShift = 2;
+		uTileShift = 4;
+		vRowShift = 2;
+		break;
+	default:
+		return false;
+	}
+
+	// Offset within the tile column, in 32-bit units: (v % 8) * 4 ...
+	ANDI2R(tempReg1, vReg, 7);
+	LSL(tempReg1, tempReg1, 2);
+	// ... plus the horizontal 32-bit unit inside the tile row ...
+	LSR(tempReg2, uReg, uTexelShift);
+	ANDI2R(tempReg2, tempReg2, 3);
+	ADD(tempReg1, tempReg1, tempReg2);
+	// ... plus 32 units per horizontal tile.
+	LSR(tempReg2, uReg, uTileShift);
+	ADD(tempReg1, tempReg1, tempReg2, ArithOption(tempReg2, ST_LSL, 5));
+	ADD(tempReg1_64, srcReg, tempReg1_64, ArithOption(tempReg1_64, ST_LSL, 2));
+
+	// Now the vertical tile byte offset: (v / 8) * bufw * 4 per tile row.
+	ANDI2R(tempReg2, vReg, 0xFFFFFFF8, scratchReg);
+	LSR(tempReg2, tempReg2, vRowShift);
+	LSL(tempReg3, bufwReg, 2);
+	MUL(tempReg2, tempReg2, tempReg3);
+
+	switch (bitsPerTexel) {
+	case 32:
+		LDR(resultReg, tempReg1_64, ArithOption(tempReg2));
+		break;
+	case 16:
+		ANDI2R(tempReg3, uReg, 1);
+		ADD(tempReg2, tempReg2, tempReg3, ArithOption(tempReg3, ST_LSL, 1));
+		LDRH(resultReg, tempReg1_64, ArithOption(tempReg2));
+		break;
+	case 8:
+		ANDI2R(tempReg3, uReg, 3);
+		ADD(tempReg2, tempReg2, tempReg3);
+		LDRB(resultReg, tempReg1_64, ArithOption(tempReg2));
+		break;
+	default:
+		return false;
+	}
+
+	return true;
+}
+
+bool SamplerJitCache::Jit_Decode5650() {
+	// R and B at the same time, they're both 5 bits - gives 00BB00RR.
+	UBFX(tempReg1, resultReg, 0, 5);
+	UBFX(tempReg2, resultReg, 11, 5);
+	ORR(tempReg1, tempReg1, tempReg2, ArithOption(tempReg2, ST_LSL, 16));
+
+	// Expand 5 -> 8.
+	LSL(tempReg2, tempReg1, 3);
+	ORR(tempReg2, tempReg2, tempReg1, ArithOption(tempReg1, ST_LSR, 2));
+	ANDI2R(tempReg2, tempReg2, 0x00FF00FF, scratchReg);
+
+	// Now's as good a time to put in A as any.
+	ORRI2R(tempReg2, tempReg2, 0xFF000000, scratchReg);
+
+	// Last, extract and expand G.
+	UBFX(tempReg1, resultReg, 5, 6);
+	LSL(tempReg3, tempReg1, 2);
+	ORR(tempReg3, tempReg3, tempReg1, ArithOption(tempReg1, ST_LSR, 4));
+	ORR(resultReg, tempReg2, tempReg3, ArithOption(tempReg3, ST_LSL, 8));
+
+	return true;
+}
+
+bool SamplerJitCache::Jit_Decode5551() {
+	// Gather the channels as 5-bit fields at 0, 8, and 16.
+	UBFX(tempReg1, resultReg, 0, 5);
+	UBFX(tempReg2, resultReg, 5, 5);
+	ORR(tempReg1, tempReg1, tempReg2, ArithOption(tempReg2, ST_LSL, 8));
+	UBFX(tempReg2, resultReg, 10, 5);
+	ORR(tempReg1, tempReg1, tempReg2, ArithOption(tempReg2, ST_LSL, 16));
+
+	// Expand 5 -> 8.  After this is just A.
+	LSL(tempReg2, tempReg1, 3);
+	LSR(tempReg3, tempReg1, 2);
+	// Chop off the bits that were shifted out of each field.
+	ANDI2R(tempReg3, tempReg3, 0x00070707, scratchReg);
+	ORR(tempReg2, tempReg2, tempReg3);
+
+	// For A, replicate the single bit into the whole byte.
+	UBFX(tempReg1, resultReg, 15, 1);
+	NEG(tempReg1, tempReg1);
+	ANDI2R(tempReg1, tempReg1, 0xFF000000, scratchReg);
+	ORR(resultReg, tempReg2, tempReg1);
+
+	return true;
+}
+
+bool SamplerJitCache::Jit_Decode4444() {
+	// Expand each nibble to a byte (x * 0x11) and assemble.
+	UBFX(tempReg1, resultReg, 0, 4);
+	ORR(tempReg1, tempReg1, tempReg1, ArithOption(tempReg1, ST_LSL, 4));
+	UBFX(tempReg2, resultReg, 4, 4);
+	ORR(tempReg2, tempReg2, tempReg2, ArithOption(tempReg2, ST_LSL, 4));
+	ORR(tempReg1, tempReg1, tempReg2, ArithOption(tempReg2, ST_LSL, 8));
+	UBFX(tempReg2, resultReg, 8, 4);
+	ORR(tempReg2, tempReg2, tempReg2, ArithOption(tempReg2, ST_LSL, 4));
+	ORR(tempReg1, tempReg1, tempReg2, ArithOption(tempReg2, ST_LSL, 16));
+	UBFX(tempReg2, resultReg, 12, 4);
+	ORR(tempReg2, tempReg2, tempReg2, ArithOption(tempReg2, ST_LSL, 4));
+	ORR(resultReg, tempReg1, tempReg2, ArithOption(tempReg2, ST_LSL, 24));
+
+	return true;
+}
+
+bool SamplerJitCache::Jit_TransformClutIndex(const SamplerID &id, int bitsPerIndex) {
+	GEPaletteFormat fmt = (GEPaletteFormat)id.clutfmt;
+	if (!id.hasClutShift && !id.hasClutMask && !id.hasClutOffset) {
+		// This is simple - just mask if necessary.
+		if (bitsPerIndex > 8) {
+			ANDI2R(resultReg, resultReg, 0x000000FF);
+		}
+		return true;
+	}
+
+	MOVP2R(tempReg1_64, &gstate.clutformat);
+	LDR(INDEX_UNSIGNED, tempReg1, tempReg1_64, 0);
+
+	// Shift = (clutformat >> 2) & 0x1F
+	if (id.hasClutShift) {
+		UBFX(tempReg2, tempReg1, 2, 5);
+		LSRV(resultReg, resultReg, tempReg2);
+	}
+
+	// Mask = (clutformat >> 8) & 0xFF
+	if (id.hasClutMask) {
+		UBFX(tempReg2, tempReg1, 8, 8);
+		AND(resultReg, resultReg, tempReg2);
+	}
+
+	// We need to wrap any entries beyond the first 1024 bytes.
+	u32 offsetMask = fmt == GE_CMODE_32BIT_ABGR8888 ? 0x00FF : 0x01FF;
+
+	// We must mask to 0xFF before ORing 0x100 in 16 bit CMODEs.
+	// But skip if we'll mask 0xFF after offset anyway.
+	if (bitsPerIndex > 8 && (!id.hasClutOffset || offsetMask != 0x00FF)) {
+		ANDI2R(resultReg, resultReg, 0x000000FF);
+	}
+
+	// Offset = (clutformat >> 12) & 0x01F0
+	if (id.hasClutOffset) {
+		LSR(tempReg1, tempReg1, 16);
+		ORR(resultReg, resultReg, tempReg1, ArithOption(tempReg1, ST_LSL, 4));
+		ANDI2R(resultReg, resultReg, offsetMask, scratchReg);
+	}
+	return true;
+}
+
+bool SamplerJitCache::Jit_ReadClutColor(const SamplerID &id) {
+	if (!id.useSharedClut) {
+		// The level is always passed in levelReg, so this is simpler than on x86.
+		// TODO: Need to load from RAM, always.
+		ADD(resultReg, resultReg, levelReg, ArithOption(levelReg, ST_LSL, 4));
+	}
+
+	MOVP2R(tempReg1_64, clut);
+
+	switch ((GEPaletteFormat)id.clutfmt) {
+	case GE_CMODE_16BIT_BGR5650:
+		LDRH(resultReg, tempReg1_64, ArithOption(resultReg, true));
+		return Jit_Decode5650();
+
+	case GE_CMODE_16BIT_ABGR5551:
+		LDRH(resultReg, tempReg1_64, ArithOption(resultReg, true));
+		return Jit_Decode5551();
+
+	case GE_CMODE_16BIT_ABGR4444:
+		LDRH(resultReg, tempReg1_64, ArithOption(resultReg, true));
+		return Jit_Decode4444();
+
+	case GE_CMODE_32BIT_ABGR8888:
+		LDR(resultReg, tempReg1_64, ArithOption(resultReg, true));
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+};
+
+#endif
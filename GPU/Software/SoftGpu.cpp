@@ -15,6 +15,9 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include <algorithm>
+
+#include "ext/xxhash.h"
 #include "GPU/GPUState.h"
 #include "GPU/ge_constants.h"
 #include "GPU/Common/TextureDecoder.h"
@@ -150,78 +153,93 @@ void SoftGPU::SetDisplayFramebuffer(u32 framebuf, u32 stride, GEBufferFormat for
 void SoftGPU::CopyToCurrentFboFromDisplayRam(int srcwidth, int srcheight) {
 	if (!draw_)
 		return;
-	float u0 = 0.0f;
-	float u1;
-
-	if (fbTex) {
-		fbTex->Release();
-		fbTex = nullptr;
-	}
 
 	// For accuracy, try to handle 0 stride - sometimes used.
 	if (displayStride_ == 0) {
 		srcheight = 1;
 	}
 
-	Draw::TextureDesc desc{};
-	desc.type = Draw::TextureType::LINEAR2D;
-	desc.format = Draw::DataFormat::R8G8B8A8_UNORM;
-	desc.depth = 1;
-	desc.mipLevels = 1;
-	desc.tag = "SoftGPU";
-	bool hasImage = true;
 	if (!Memory::IsValidAddress(displayFramebuf_) || srcwidth == 0 || srcheight == 0) {
-		hasImage = false;
-		u1 = 1.0f;
-	} else if (displayFormat_ == GE_FORMAT_8888) {
-		u8 *data = Memory::GetPointer(displayFramebuf_);
-		desc.width = displayStride_ == 0 ? srcwidth : displayStride_;
-		desc.height = srcheight;
-		desc.initData.push_back(data);
+		if (fbTex) {
+			fbTex->Release();
+			fbTex = nullptr;
+		}
+		draw_->BindFramebufferAsRenderTarget(nullptr, { Draw::RPAction::CLEAR, Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE });
+		return;
+	}
+
+	float u0 = 0.0f;
+	float u1 = displayFormat_ == GE_FORMAT_8888 && displayStride_ != 0 ? (float)srcwidth / displayStride_ : 1.0f;
+
+	// Present cache. The format conversion and the texture re-upload are
+	// full-screen work, so skip both when the displayed memory hasn't changed
+	// since the last present (menus, loading screens, games below 60fps).
+	// Hashing the source bytes is far cheaper than redoing the conversion and
+	// upload, and also catches plain CPU writes to VRAM, which no GPU-side
+	// dirty tracking would see.
+	const u32 bpp = displayFormat_ == GE_FORMAT_8888 ? 4 : 2;
+	const u32 displayBytes = Memory::ValidSize(displayFramebuf_, std::max((u32)displayStride_, (u32)srcwidth) * bpp * srcheight);
+	const u64 contentHash = XXH64(Memory::GetPointer(displayFramebuf_), displayBytes, 0);
+	const bool reuse = fbTex && contentHash == presentedHash_ && displayFramebuf_ == presentedFramebuf_ &&
+		displayStride_ == presentedStride_ && displayFormat_ == presentedFormat_;
+
+	if (!reuse) {
+		if (fbTex) {
+			fbTex->Release();
+			fbTex = nullptr;
+		}
+
+		Draw::TextureDesc desc{};
+		desc.type = Draw::TextureType::LINEAR2D;
 		desc.format = Draw::DataFormat::R8G8B8A8_UNORM;
-		if (displayStride_ != 0) {
-			u1 = (float)srcwidth / displayStride_;
+		desc.depth = 1;
+		desc.mipLevels = 1;
+		desc.tag = "SoftGPU";
+		if (displayFormat_ == GE_FORMAT_8888) {
+			u8 *data = Memory::GetPointer(displayFramebuf_);
+			desc.width = displayStride_ == 0 ? srcwidth : displayStride_;
+			desc.height = srcheight;
+			desc.initData.push_back(data);
+			desc.format = Draw::DataFormat::R8G8B8A8_UNORM;
 		} else {
-			u1 = 1.0f;
-		}
-	} else {
-		// TODO: This should probably be converted in a shader instead..
-		fbTexBuffer.resize(srcwidth * srcheight);
-		FormatBuffer displayBuffer;
-		displayBuffer.data = Memory::GetPointer(displayFramebuf_);
-		for (int y = 0; y < srcheight; ++y) {
-			u32 *buf_line = &fbTexBuffer[y * srcwidth];
-			const u16 *fb_line = &displayBuffer.as16[y * displayStride_];
-
-			switch (displayFormat_) {
-			case GE_FORMAT_565:
-				ConvertRGBA565ToRGBA8888(buf_line, fb_line, srcwidth);
-				break;
+			// TODO: This should probably be converted in a shader instead..
+			fbTexBuffer.resize(srcwidth * srcheight);
+			FormatBuffer displayBuffer;
+			displayBuffer.data = Memory::GetPointer(displayFramebuf_);
+			for (int y = 0; y < srcheight; ++y) {
+				u32 *buf_line = &fbTexBuffer[y * srcwidth];
+				const u16 *fb_line = &displayBuffer.as16[y * displayStride_];
+
+				switch (displayFormat_) {
+				case GE_FORMAT_565:
+					ConvertRGBA565ToRGBA8888(buf_line, fb_line, srcwidth);
+					break;
 
-			case GE_FORMAT_5551:
-				ConvertRGBA5551ToRGBA8888(buf_line, fb_line, srcwidth);
-				break;
+				case GE_FORMAT_5551:
+					ConvertRGBA5551ToRGBA8888(buf_line, fb_line, srcwidth);
+					break;
 
-			case GE_FORMAT_4444:
-				ConvertRGBA4444ToRGBA8888(buf_line, fb_line, srcwidth);
-				break;
+				case GE_FORMAT_4444:
+					ConvertRGBA4444ToRGBA8888(buf_line, fb_line, srcwidth);
+					break;
 
-			default:
-				ERROR_LOG_REPORT(G3D, "Software: Unexpected framebuffer format: %d", displayFormat_);
+				default:
+					ERROR_LOG_REPORT(G3D, "Software: Unexpected framebuffer format: %d", displayFormat_);
+				}
 			}
+
+			desc.width = srcwidth;
+			desc.height = srcheight;
+			desc.initData.push_back((uint8_t *)fbTexBuffer.data());
 		}
 
-		desc.width = srcwidth;
-		desc.height = srcheight;
-		desc.initData.push_back((uint8_t *)fbTexBuffer.data());
-		u1 = 1.0f;
-	}
-	if (!hasImage) {
-		draw_->BindFramebufferAsRenderTarget(nullptr, { Draw::RPAction::CLEAR, Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE });
-		return;
-	}
+		fbTex = draw_->CreateTexture(desc);
 
-	fbTex = draw_->CreateTexture(desc);
+		presentedHash_ = contentHash;
+		presentedFramebuf_ = displayFramebuf_;
+		presentedStride_ = displayStride_;
+		presentedFormat_ = displayFormat_;
+	}
 
 	float dstwidth = (float)PSP_CoreParameter().pixelWidth;
 	float dstheight = (float)PSP_CoreParameter().pixelHeight;
@@ -110,6 +110,12 @@ private:
 	Draw::Pipeline *texColor;
 	std::vector<u32> fbTexBuffer;
 
+	// Present cache - see CopyToCurrentFboFromDisplayRam.
+	u64 presentedHash_ = 0;
+	u32 presentedFramebuf_ = 0;
+	u32 presentedStride_ = 0;
+	GEBufferFormat presentedFormat_ = GE_FORMAT_8888;
+
 	Draw::SamplerState *samplerNearest = nullptr;
 	Draw::SamplerState *samplerLinear = nullptr;
 	Draw::Buffer *vdata = nullptr;
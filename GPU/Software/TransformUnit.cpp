@@ -27,6 +27,7 @@
 #include "GPU/Software/TransformUnit.h"
 #include "GPU/Software/Clipper.h"
 #include "GPU/Software/Lighting.h"
+#include "GPU/Software/Rasterizer.h"
 
 #define TRANSFORM_BUF_SIZE (65536 * 48)
 
@@ -151,7 +152,7 @@ ScreenCoords TransformUnit::DrawingToScreen(const DrawingCoords& coords)
 	return ret;
 }
 
-VertexData TransformUnit::ReadVertex(VertexReader& vreader)
+VertexData TransformUnit::ReadVertex(VertexReader &vreader, const Lighting::State &lighting)
 {
 	VertexData vertex;
 
@@ -273,7 +274,7 @@ VertexData TransformUnit::ReadVertex(VertexReader& vreader)
 			vertex.texturecoords = Vec2f(stq.x * z_recip, stq.y * z_recip);
 		}
 
-		Lighting::Process(vertex, vreader.hasColor0());
+		Lighting::Process(vertex, lighting);
 	} else {
 		vertex.screenpos.x = (int)(pos[0] * 16) + gstate.getOffsetX16();
 		vertex.screenpos.y = (int)(pos[1] * 16) + gstate.getOffsetY16();
@@ -341,8 +342,31 @@ void TransformUnit::SubmitPrimitive(void* vertices, void* indices, GEPrimitiveTy
 	default: vtcs_per_prim = 0; break;
 	}
 
-	// TODO: Do this in two passes - first process the vertices (before indexing/stripping),
-	// then resolve the indices. This lets us avoid transforming shared vertices twice.
+	// Two passes: transform the decoded vertices in one linear batch first, then resolve
+	// the indices during primitive assembly. Indexed draws share vertices between prims,
+	// so this way each one is only transformed and lit once, and the transform loop walks
+	// the decoded buffer sequentially instead of hopping around via the index list.
+	static std::vector<VertexData> transformed;
+	static std::vector<u8> transformedOutside;
+
+	// Decode the per-draw lighting setup once - it's constant across the batch.
+	Lighting::State lightingState;
+	if (!gstate.isModeThrough())
+		Lighting::ComputeState(&lightingState, vreader.hasColor0());
+
+	if (vertex_count > 0) {
+		const int vertex_range = index_upper_bound - index_lower_bound + 1;
+		if ((int)transformed.size() < vertex_range) {
+			transformed.resize(vertex_range);
+			transformedOutside.resize(vertex_range);
+		}
+		for (int i = 0; i < vertex_range; ++i) {
+			vreader.Goto(i);
+			transformed[i] = ReadVertex(vreader, lightingState);
+			transformedOutside[i] = outside_range_flag ? 1 : 0;
+			outside_range_flag = false;
+		}
+	}
 
 	switch (prim_type) {
 	case GE_PRIM_POINTS:
@@ -351,13 +375,10 @@ void TransformUnit::SubmitPrimitive(void* vertices, void* indices, GEPrimitiveTy
 	case GE_PRIM_RECTANGLES:
 		{
 			for (int vtx = 0; vtx < vertex_count; ++vtx) {
-				if (indices) {
-					vreader.Goto(ConvertIndex(vtx) - index_lower_bound);
-				} else {
-					vreader.Goto(vtx);
-				}
+				const int src = indices ? ConvertIndex(vtx) - index_lower_bound : vtx;
 
-				data[data_index++] = ReadVertex(vreader);
+				data[data_index++] = transformed[src];
+				outside_range_flag |= transformedOutside[src] != 0;
 				if (data_index < vtcs_per_prim) {
 					// Keep reading.  Note: an incomplete prim will stay read for GE_PRIM_KEEP_PREVIOUS.
 					continue;
@@ -410,17 +431,12 @@ void TransformUnit::SubmitPrimitive(void* vertices, void* indices, GEPrimitiveTy
 			// If data_index is 1 or 2, etc., it means we're continuing a line strip.
 			int skip_count = data_index == 0 ? 1 : 0;
 			for (int vtx = 0; vtx < vertex_count; ++vtx) {
-				if (indices) {
-					vreader.Goto(ConvertIndex(vtx) - index_lower_bound);
-				} else {
-					vreader.Goto(vtx);
-				}
+				const int src = indices ? ConvertIndex(vtx) - index_lower_bound : vtx;
 
-				data[(data_index++) & 1] = ReadVertex(vreader);
-				if (outside_range_flag) {
+				data[(data_index++) & 1] = transformed[src];
+				if (transformedOutside[src]) {
 					// Drop all primitives containing the current vertex
 					skip_count = 2;
-					outside_range_flag = false;
 					continue;
 				}
 
@@ -440,18 +456,13 @@ void TransformUnit::SubmitPrimitive(void* vertices, void* indices, GEPrimitiveTy
 			int skip_count = data_index >= 2 ? 0 : 2 - data_index;
 
 			for (int vtx = 0; vtx < vertex_count; ++vtx) {
-				if (indices) {
-					vreader.Goto(ConvertIndex(vtx) - index_lower_bound);
-				} else {
-					vreader.Goto(vtx);
-				}
+				const int src = indices ? ConvertIndex(vtx) - index_lower_bound : vtx;
 
 				int provoking_index = (data_index++) % 3;
-				data[provoking_index] = ReadVertex(vreader);
-				if (outside_range_flag) {
+				data[provoking_index] = transformed[src];
+				if (transformedOutside[src]) {
 					// Drop all primitives containing the current vertex
 					skip_count = 2;
-					outside_range_flag = false;
 					continue;
 				}
 
@@ -481,31 +492,27 @@ void TransformUnit::SubmitPrimitive(void* vertices, void* indices, GEPrimitiveTy
 			int skip_count = data_index <= 1 ? 1 : 0;
 			int start_vtx = 0;
 
-			// Only read the central vertex if we're not continuing.
+			// Only load the central vertex if we're not continuing.
 			if (data_index == 0) {
-				if (indices) {
-					vreader.Goto(ConvertIndex(0) - index_lower_bound);
-				} else {
-					vreader.Goto(0);
-				}
-				data[0] = ReadVertex(vreader);
+				const int src = indices ? ConvertIndex(0) - index_lower_bound : 0;
+				data[0] = transformed[src];
 				data_index++;
 				start_vtx = 1;
+
+				// If the central vertex is outside, drop the primitives containing it,
+				// same as if the first perimeter vertex had been outside.
+				if (transformedOutside[src])
+					skip_count = 3;
 			}
 
 			for (int vtx = start_vtx; vtx < vertex_count; ++vtx) {
-				if (indices) {
-					vreader.Goto(ConvertIndex(vtx) - index_lower_bound);
-				} else {
-					vreader.Goto(vtx);
-				}
+				const int src = indices ? ConvertIndex(vtx) - index_lower_bound : vtx;
 
 				int provoking_index = 2 - ((data_index++) % 2);
-				data[provoking_index] = ReadVertex(vreader);
-				if (outside_range_flag) {
+				data[provoking_index] = transformed[src];
+				if (transformedOutside[src]) {
 					// Drop all primitives containing the current vertex
 					skip_count = 2;
-					outside_range_flag = false;
 					continue;
 				}
 
@@ -533,6 +540,10 @@ void TransformUnit::SubmitPrimitive(void* vertices, void* indices, GEPrimitiveTy
 		break;
 	}
 
+	// The state we rasterize with has to stay fixed for the lifetime of the bin, and
+	// anything after this draw may read the framebuffer, so drain it here.
+	Rasterizer::FlushBinnedTriangles();
+
 	GPUDebug::NotifyDraw();
 }
 
@@ -116,6 +116,10 @@ class VertexReader;
 
 class SoftwareDrawEngine;
 
+namespace Lighting {
+struct State;
+}
+
 class TransformUnit {
 public:
 	TransformUnit();
@@ -132,7 +136,7 @@ public:
 	void SubmitPrimitive(void* vertices, void* indices, GEPrimitiveType prim_type, int vertex_count, u32 vertex_type, int *bytesRead, SoftwareDrawEngine *drawEngine);
 
 	bool GetCurrentSimpleVertices(int count, std::vector<GPUDebugVertex> &vertices, std::vector<u16> &indices);
-	VertexData ReadVertex(VertexReader& vreader);
+	VertexData ReadVertex(VertexReader &vreader, const Lighting::State &lighting);
 
 	bool outside_range_flag = false;
 	u8 *buf;
@@ -285,8 +285,18 @@ void DrawEngineVulkan::BeginFrame() {
 	vertexCache_->BeginNoReset();
 
 	if (--descDecimationCounter_ <= 0) {
-		if (frame->descPool != VK_NULL_HANDLE)
+		// If the last frame this pool served came close to filling it, grow it now,
+		// while it's empty anyway. Growing mid-frame wipes the descriptor set cache
+		// and forces a round of reallocations right in the heaviest scenes.
+		int newSize = frame->descPoolSize;
+		while (frame->descCount > newSize - newSize / 4)
+			newSize *= 2;
+		if (newSize != frame->descPoolSize && frame->descPool != VK_NULL_HANDLE) {
+			VkResult res = RecreateDescriptorPool(*frame, newSize);
+			_assert_msg_(G3D, res == VK_SUCCESS, "Failed to grow descriptor pool to %d sets. res=%d", newSize, (int)res);
+		} else if (frame->descPool != VK_NULL_HANDLE) {
 			vkResetDescriptorPool(vulkan_->GetDevice(), frame->descPool, 0);
+		}
 		frame->descSets.Clear();
 		frame->descCount = 0;
 		descDecimationCounter_ = DESCRIPTORSET_DECIMATION_INTERVAL;
@@ -571,6 +581,7 @@ void MarkUnreliable(VertexArrayInfoVulkan *vai) {
 void DrawEngineVulkan::DoFlush() {
 	PROFILE_THIS_SCOPE("Flush");
 	gpuStats.numFlushes++;
+	AccountFlushReason();
 	// TODO: Should be enough to update this once per frame?
 	gpuStats.numTrackedVertexArrays = (int)vai_.size();
 
@@ -624,7 +635,9 @@ void DrawEngineVulkan::DoFlush() {
 
 		if (useCache) {
 			PROFILE_THIS_SCOPE("vcache");
-			u32 id = dcid_ ^ gstate.getUVGenMode();  // This can have an effect on which UV decoder we need to use! And hence what the decoded data will look like. See #9263
+			// Any state mashed into the decoder ID affects what the decoded data will
+			// look like (UV gen mode, dead attributes...), so key on all of it. See #9263.
+			u32 id = dcid_ ^ dec_->VertexType();
 			VertexArrayInfoVulkan *vai = vai_.Get(id);
 			if (!vai) {
 				vai = new VertexArrayInfoVulkan();
@@ -672,14 +685,16 @@ void DrawEngineVulkan::DoFlush() {
 					if (vai->numVerts > 64) {
 						// exponential backoff up to 16 draws, then every 24
 						vai->drawsUntilNextFullHash = std::min(24, vai->numFrames);
+						// Once it's been stable this long, stop full-hashing. The sampled
+						// hash keeps running in VAI_RELIABLE as a safety net.
+						if (vai->numFrames > VAI_RELIABLE_AFTER_FRAMES) {
+							vai->status = VertexArrayInfoVulkan::VAI_RELIABLE;
+							vai->drawsUntilNextFullHash = VAI_RELIABLE_MINIHASH_INTERVAL;
+						}
 					} else {
 						// Lower numbers seem much more likely to change.
 						vai->drawsUntilNextFullHash = 0;
 					}
-					// TODO: tweak
-					//if (vai->numFrames > 1000) {
-					//	vai->status = VertexArrayInfo::VAI_RELIABLE;
-					//}
 				} else {
 					vai->drawsUntilNextFullHash--;
 					u32 newMiniHash = ComputeMiniHash();
@@ -726,13 +741,23 @@ void DrawEngineVulkan::DoFlush() {
 				break;
 			}
 
-			// Reliable - we don't even bother hashing anymore. Right now we don't go here until after a very long time.
+			// Reliable - we've stopped full hashing, but the cheap sampled hash still
+			// runs every now and then so a mesh that changes after a long static period
+			// gets kicked out instead of staying wrong forever.
 			case VertexArrayInfoVulkan::VAI_RELIABLE:
 			{
 				vai->numDraws++;
 				if (vai->lastFrame != gpuStats.numFlips) {
 					vai->numFrames++;
 				}
+				if (--vai->drawsUntilNextFullHash == 0) {
+					vai->drawsUntilNextFullHash = VAI_RELIABLE_MINIHASH_INTERVAL;
+					if (ComputeMiniHash() != vai->minihash) {
+						MarkUnreliable(vai);
+						DecodeVertsToPushBuffer(frame->pushVertex, &vbOffset, &vbuf);
+						goto rotateVBO;
+					}
+				}
 				gpuStats.numCachedDrawCalls++;
 				gpuStats.numCachedVertsDrawn += vai->numVerts;
 				vbuf = vai->vb;
@@ -797,7 +822,13 @@ void DrawEngineVulkan::DoFlush() {
 				sampler = nullSampler_;
 		}
 
-		if (!lastPipeline_ || gstate_c.IsDirty(DIRTY_BLEND_STATE | DIRTY_VIEWPORTSCISSOR_STATE | DIRTY_RASTER_STATE | DIRTY_DEPTHSTENCIL_STATE | DIRTY_VERTEXSHADER_STATE | DIRTY_FRAGMENTSHADER_STATE) || prim != lastPrim_) {
+		// The cull mode in the pipeline key depends on whether we're drawing rectangles,
+		// which the dirty flag tracking can't know about - handle it here.
+		if (prim != lastPrim_ && ((prim == GE_PRIM_RECTANGLES) != (lastPrim_ == GE_PRIM_RECTANGLES))) {
+			gstate_c.Dirty(DIRTY_RASTER_STATE);
+		}
+
+		if (!lastPipeline_ || gstate_c.IsDirty(DIRTY_BLEND_STATE | DIRTY_RASTER_STATE | DIRTY_DEPTHSTENCIL_STATE | DIRTY_VERTEXSHADER_STATE | DIRTY_FRAGMENTSHADER_STATE) || prim != lastPrim_) {
 			shaderManager_->GetShaders(prim, lastVType_, &vshader, &fshader, true);  // usehwtransform
 			_dbg_assert_msg_(G3D, vshader->UseHWTransform(), "Bad vshader");
 
@@ -826,6 +857,12 @@ void DrawEngineVulkan::DoFlush() {
 			// Must dirty blend state here so we re-copy next time.  Example: Lunar's spell effects.
 			if (fboTexBound_)
 				gstate_c.Dirty(DIRTY_BLEND_STATE);
+		} else if (gstate_c.IsDirty(DIRTY_VIEWPORTSCISSOR_STATE)) {
+			// Viewport and scissor are dynamic state in Vulkan - when that's all that changed,
+			// keep the current pipeline and just update them.
+			ConvertStateToVulkanKey(*framebufferManager_, shaderManager_, prim, pipelineKey_, dynState_);
+			ApplyDrawStateLate(renderManager, false, 0, lastPipeline_->UsesBlendConstant());
+			gstate_c.Clean(DIRTY_VIEWPORTSCISSOR_STATE);
 		}
 		lastPrim_ = prim;
 
@@ -902,7 +939,11 @@ void DrawEngineVulkan::DoFlush() {
 				if (sampler == VK_NULL_HANDLE)
 					sampler = nullSampler_;
 			}
-			if (!lastPipeline_ || gstate_c.IsDirty(DIRTY_BLEND_STATE | DIRTY_VIEWPORTSCISSOR_STATE | DIRTY_RASTER_STATE | DIRTY_DEPTHSTENCIL_STATE | DIRTY_VERTEXSHADER_STATE | DIRTY_FRAGMENTSHADER_STATE) || prim != lastPrim_) {
+			if (prim != lastPrim_ && ((prim == GE_PRIM_RECTANGLES) != (lastPrim_ == GE_PRIM_RECTANGLES))) {
+				gstate_c.Dirty(DIRTY_RASTER_STATE);
+			}
+
+			if (!lastPipeline_ || gstate_c.IsDirty(DIRTY_BLEND_STATE | DIRTY_RASTER_STATE | DIRTY_DEPTHSTENCIL_STATE | DIRTY_VERTEXSHADER_STATE | DIRTY_FRAGMENTSHADER_STATE) || prim != lastPrim_) {
 				shaderManager_->GetShaders(prim, lastVType_, &vshader, &fshader, false);  // usehwtransform
 				_dbg_assert_msg_(G3D, !vshader->UseHWTransform(), "Bad vshader");
 				if (prim != lastPrim_ || gstate_c.IsDirty(DIRTY_BLEND_STATE | DIRTY_VIEWPORTSCISSOR_STATE | DIRTY_RASTER_STATE | DIRTY_DEPTHSTENCIL_STATE)) {
@@ -930,6 +971,10 @@ void DrawEngineVulkan::DoFlush() {
 				// Must dirty blend state here so we re-copy next time.  Example: Lunar's spell effects.
 				if (fboTexBound_)
 					gstate_c.Dirty(DIRTY_BLEND_STATE);
+			} else if (gstate_c.IsDirty(DIRTY_VIEWPORTSCISSOR_STATE)) {
+				ConvertStateToVulkanKey(*framebufferManager_, shaderManager_, prim, pipelineKey_, dynState_);
+				ApplyDrawStateLate(renderManager, result.setStencil, result.stencilValue, lastPipeline_->UsesBlendConstant());
+				gstate_c.Clean(DIRTY_VIEWPORTSCISSOR_STATE);
 			}
 			lastPrim_ = prim;
 
@@ -1037,13 +1082,22 @@ void TessellationDataTransferVulkan::SendDataToShader(const SimpleVertex *const
 
 	using Spline::Weight;
 
+	// Consecutive patches with the same tessellation parameters share weight arrays
+	// (they come from the weight cache), so only push a new copy when they change.
+
 	// Weights U
-	data = (uint8_t *)push_->PushAligned(weights.size_u * sizeof(Weight), (uint32_t *)&bufInfo_[1].offset, &bufInfo_[1].buffer, ssboAlignment);
-	memcpy(data, weights.u, weights.size_u * sizeof(Weight));
-	bufInfo_[1].range = weights.size_u * sizeof(Weight);
+	if (weights.u != lastWeightsU_) {
+		data = (uint8_t *)push_->PushAligned(weights.size_u * sizeof(Weight), (uint32_t *)&bufInfo_[1].offset, &bufInfo_[1].buffer, ssboAlignment);
+		memcpy(data, weights.u, weights.size_u * sizeof(Weight));
+		bufInfo_[1].range = weights.size_u * sizeof(Weight);
+		lastWeightsU_ = weights.u;
+	}
 
 	// Weights V
-	data = (uint8_t *)push_->PushAligned(weights.size_v * sizeof(Weight), (uint32_t *)&bufInfo_[2].offset, &bufInfo_[2].buffer, ssboAlignment);
-	memcpy(data, weights.v, weights.size_v * sizeof(Weight));
-	bufInfo_[2].range = weights.size_v * sizeof(Weight);
+	if (weights.v != lastWeightsV_) {
+		data = (uint8_t *)push_->PushAligned(weights.size_v * sizeof(Weight), (uint32_t *)&bufInfo_[2].offset, &bufInfo_[2].buffer, ssboAlignment);
+		memcpy(data, weights.v, weights.size_v * sizeof(Weight));
+		bufInfo_[2].range = weights.size_v * sizeof(Weight);
+		lastWeightsV_ = weights.v;
+	}
 }
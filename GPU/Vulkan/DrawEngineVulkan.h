@@ -121,7 +121,12 @@ class TessellationDataTransferVulkan : public TessellationDataTransfer  {
 public:
 	TessellationDataTransferVulkan(VulkanContext *vulkan) : vulkan_(vulkan) {}
 
-	void SetPushBuffer(VulkanPushBuffer *push) { push_ = push; }
+	void SetPushBuffer(VulkanPushBuffer *push) {
+		push_ = push;
+		// New frame, new push buffer - any weights we pushed last frame are gone.
+		lastWeightsU_ = nullptr;
+		lastWeightsV_ = nullptr;
+	}
 	// Send spline/bezier's control points and weights to vertex shader through structured shader buffer.
 	void SendDataToShader(const SimpleVertex *const *points, int size_u, int size_v, u32 vertType, const Spline::Weight2D &weights) override;
 	const VkDescriptorBufferInfo *GetBufferInfo() { return bufInfo_; }
@@ -129,6 +134,10 @@ private:
 	VulkanContext *vulkan_;
 	VulkanPushBuffer *push_;  // Updated each frame.
 	VkDescriptorBufferInfo bufInfo_[3]{};
+	// The weight arrays come from the spline weight cache and are stable for the
+	// lifetime of a frame, so pointer identity is enough to reuse the pushed copy.
+	const Spline::Weight *lastWeightsU_ = nullptr;
+	const Spline::Weight *lastWeightsV_ = nullptr;
 };
 
 // Handles transform, lighting and drawing.
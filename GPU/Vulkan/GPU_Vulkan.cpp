@@ -16,6 +16,7 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include <cstring>
 #include <thread>
 #include "base/logging.h"
 #include "base/timeutil.h"
@@ -308,6 +309,11 @@ void GPU_Vulkan::EndHostFrame() {
 	FrameData &frame = frameData_[curFrame];
 	frame.push_->End();
 
+	// The render thread is a frame behind us, so this is the previous frame's count.
+	// Close enough for the stats display.
+	VulkanRenderManager *rm = (VulkanRenderManager *)draw_->GetNativeObject(Draw::NativeObject::RENDER_MANAGER);
+	gpuStats.numRenderPasses = rm->GetQueueRunner()->GetNumPassesOfLastFrame();
+
 	vulkan2D_.EndFrame();
 
 	drawEngine_.EndFrame();
@@ -437,6 +443,7 @@ inline void GPU_Vulkan::CheckFlushOp(int cmd, u32 diff) {
 		if (dumpThisFrame_) {
 			NOTICE_LOG(G3D, "================ FLUSH ================");
 		}
+		drawEngine_.SetFlushReason(FlushReasonFromCommand(cmd));
 		drawEngine_.Flush();
 	}
 }
@@ -540,7 +547,11 @@ void GPU_Vulkan::GetStats(char *buffer, size_t bufsize) {
 	float vertexAverageCycles = gpuStats.numVertsSubmitted > 0 ? (float)gpuStats.vertexGPUCycles / (float)gpuStats.numVertsSubmitted : 0.0f;
 	snprintf(buffer, bufsize - 1,
 		"DL processing time: %0.2f ms\n"
+		"Vertex, Texture decode: %0.2f ms, %0.2f ms\n"
+		"Readback time: %0.2f ms\n"
+		"Shader, Pipeline compiles: %i, %i\n"
 		"Draw calls: %i, flushes %i, clears %i\n"
+		"Render passes: %i\n"
 		"Cached Draw calls: %i\n"
 		"Num Tracked Vertex Arrays: %i\n"
 		"GPU cycles executed: %d (%f per vertex)\n"
@@ -550,13 +561,21 @@ void GPU_Vulkan::GetStats(char *buffer, size_t bufsize) {
 		"FBOs active: %i\n"
 		"Textures active: %i, decoded: %i  invalidated: %i\n"
 		"Readbacks: %d, uploads: %d\n"
+		"Texture data uploaded: %d bytes\n"
+		"Cache memory: tex %d MB, fb %d MB (of %d MB)\n"
 		"Vertex, Fragment, Pipelines loaded: %i, %i, %i\n"
 		"Pushbuffer space used: UBO %d, Vtx %d, Idx %d\n"
 		"%s\n",
 		gpuStats.msProcessingDisplayLists * 1000.0f,
+		gpuStats.msVertexDecode * 1000.0f,
+		gpuStats.msTextureDecode * 1000.0f,
+		gpuStats.msReadbacks * 1000.0f,
+		gpuStats.numShaderCompiles,
+		gpuStats.numPipelineCompiles,
 		gpuStats.numDrawCalls,
 		gpuStats.numFlushes,
 		gpuStats.numClears,
+		gpuStats.numRenderPasses,
 		gpuStats.numCachedDrawCalls,
 		gpuStats.numTrackedVertexArrays,
 		gpuStats.vertexGPUCycles + gpuStats.otherGPUCycles,
@@ -571,6 +590,10 @@ void GPU_Vulkan::GetStats(char *buffer, size_t bufsize) {
 		gpuStats.numTextureInvalidations,
 		gpuStats.numReadbacks,
 		gpuStats.numUploads,
+		gpuStats.numTextureDataBytesUploaded,
+		(int)(gpuMemoryBudget.textureBytes >> 20),
+		(int)(gpuMemoryBudget.framebufferBytes >> 20),
+		(int)(gpuMemoryBudget.budgetBytes >> 20),
 		shaderManagerVulkan_->GetNumVertexShaders(),
 		shaderManagerVulkan_->GetNumFragmentShaders(),
 		pipelineManager_->GetNumPipelines(),
@@ -579,6 +602,18 @@ void GPU_Vulkan::GetStats(char *buffer, size_t bufsize) {
 		drawStats.pushIndexSpaceUsed,
 		texStats
 	);
+
+	VulkanRenderManager *rm = (VulkanRenderManager *)draw_->GetNativeObject(Draw::NativeObject::RENDER_MANAGER);
+	const VulkanRenderManager::PresentTimingStats &presentStats = rm->GetPresentTimingStats();
+	size_t len = strlen(buffer);
+	snprintf(buffer + len, bufsize - len,
+		"Present: %s, interval %0.2f ms%s, margin %0.2f ms, dropped %d (of %d)\n",
+		PresentModeString(vulkan_->GetPresentMode()),
+		presentStats.presentIntervalMs,
+		presentStats.hasDisplayTiming ? "" : " (CPU estimate)",
+		presentStats.presentMarginMs,
+		presentStats.framesDropped,
+		presentStats.framesPresented);
 }
 
 void GPU_Vulkan::ClearCacheNextFrame() {
@@ -1,12 +1,16 @@
 #include <cstring>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "profiler/profiler.h"
 
+#include "Common/ThreadPools.h"
+
 #include "Common/Log.h"
 #include "Common/StringUtils.h"
 #include "Common/Vulkan/VulkanContext.h"
+#include "GPU/GPU.h"
 #include "GPU/Vulkan/VulkanUtil.h"
 #include "GPU/Vulkan/PipelineManagerVulkan.h"
 #include "GPU/Vulkan/ShaderManagerVulkan.h"
@@ -341,9 +345,12 @@ VulkanPipeline *PipelineManagerVulkan::GetOrCreatePipeline(VkPipelineLayout layo
 		return iter;
 
 	VulkanPipeline *pipeline = CreateVulkanPipeline(
-		vulkan_->GetDevice(), pipelineCache_, layout, renderPass, 
+		vulkan_->GetDevice(), pipelineCache_, layout, renderPass,
 		rasterKey, decFmt, vs, fs, useHwTransform, lineWidth_);
 	pipelines_.Insert(key, pipeline);
+	// Counted here rather than in CreateVulkanPipeline - the cache pre-warm calls
+	// that from the thread pool, and gpuStats isn't atomic.
+	gpuStats.numPipelineCompiles++;
 
 	// Don't return placeholder null pipelines.
 	if (pipeline && pipeline->pipeline) {
@@ -716,6 +723,22 @@ bool PipelineManagerVulkan::LoadCache(FILE *file, bool loadRawPipelineCache, Sha
 	bool failed = fread(&size, sizeof(size), 1, file) != 1;
 
 	NOTICE_LOG(G3D, "Creating %d pipelines...", size);
+
+	// First read and resolve all the keys, then compile the pipelines on the thread pool.
+	// vkCreateGraphicsPipelines against a shared pipeline cache is thread-safe (the cache
+	// is internally synchronized), and driver compile time completely dominates here, so
+	// this turns the pre-warm into a parallel job behind the loading screen. Insertion
+	// into pipelines_ happens on this thread afterwards.
+	struct PendingPipeline {
+		StoredVulkanPipelineKey key;
+		VulkanVertexShader *vs;
+		VulkanFragmentShader *fs;
+		VkRenderPass rp;
+		DecVtxFormat fmt;
+		VulkanPipeline *pipeline;
+	};
+	std::vector<PendingPipeline> pending;
+	pending.reserve(size);
 	for (uint32_t i = 0; i < size; i++) {
 		if (failed || cancelCache_) {
 			break;
@@ -726,27 +749,56 @@ bool PipelineManagerVulkan::LoadCache(FILE *file, bool loadRawPipelineCache, Sha
 			ERROR_LOG(G3D, "Truncated Vulkan pipeline cache file");
 			continue;
 		}
-		VulkanVertexShader *vs = shaderManager->GetVertexShaderFromID(key.vShaderID);
-		VulkanFragmentShader *fs = shaderManager->GetFragmentShaderFromID(key.fShaderID);
-		if (!vs || !fs) {
+		PendingPipeline pp{};
+		pp.key = key;
+		pp.vs = shaderManager->GetVertexShaderFromID(key.vShaderID);
+		pp.fs = shaderManager->GetFragmentShaderFromID(key.fShaderID);
+		if (!pp.vs || !pp.fs) {
 			failed = true;
 			ERROR_LOG(G3D, "Failed to find vs or fs in of pipeline %d in cache", (int)i);
 			continue;
 		}
-
-		VkRenderPass rp;
 		if (key.backbufferPass) {
-			rp = queueRunner->GetBackbufferRenderPass();
+			pp.rp = queueRunner->GetBackbufferRenderPass();
 		} else {
-			rp = queueRunner->GetRenderPass(key.renderPassKey);
+			pp.rp = queueRunner->GetRenderPass(key.renderPassKey);
 		}
+		pp.fmt.InitializeFromID(key.vtxFmtId);
+		pending.push_back(pp);
+	}
 
-		DecVtxFormat fmt;
-		fmt.InitializeFromID(key.vtxFmtId);
-		GetOrCreatePipeline(layout, rp, key.raster,
-			key.useHWTransform ? &fmt : 0,
-			vs, fs, key.useHWTransform);
+	VkDevice device = vulkan_->GetDevice();
+	GlobalThreadPool::Loop([&](int lo, int hi) {
+		for (int i = lo; i < hi; i++) {
+			if (cancelCache_)
+				continue;
+			PendingPipeline &pp = pending[i];
+			pp.pipeline = CreateVulkanPipeline(device, pipelineCache_, layout, pp.rp, pp.key.raster,
+				pp.key.useHWTransform ? &pp.fmt : 0,
+				pp.vs, pp.fs, pp.key.useHWTransform, lineWidth_);
+		}
+	}, 0, (int)pending.size());
+
+	for (auto &pp : pending) {
+		if (!pp.pipeline)
+			continue;
+		VulkanPipelineKey key{};
+		key.raster = pp.key.raster;
+		key.renderPass = pp.rp;
+		key.useHWTransform = pp.key.useHWTransform;
+		key.vShader = pp.vs->GetModule();
+		key.fShader = pp.fs->GetModule();
+		key.vtxFmtId = pp.key.useHWTransform ? pp.fmt.id : 0;
+		if (pipelines_.Get(key)) {
+			// Shouldn't happen since SaveCache de-duplicates, but better not to leak.
+			if (pp.pipeline->pipeline)
+				vulkan_->Delete().QueueDeletePipeline(pp.pipeline->pipeline);
+			delete pp.pipeline;
+			continue;
+		}
+		pipelines_.Insert(key, pp.pipeline);
 	}
+
 	NOTICE_LOG(G3D, "Recreated Vulkan pipeline cache (%d pipelines).", (int)size);
 	return true;
 }
@@ -265,6 +265,7 @@ void ShaderManagerVulkan::GetShaders(int prim, u32 vertType, VulkanVertexShader
 		GenerateVulkanGLSLVertexShader(VSID, codeBuffer_);
 		vs = new VulkanVertexShader(vulkan_, VSID, codeBuffer_, useHWTransform);
 		vsCache_.Insert(VSID, vs);
+		gpuStats.numShaderCompiles++;
 	}
 	lastVSID_ = VSID;
 
@@ -275,6 +276,7 @@ void ShaderManagerVulkan::GetShaders(int prim, u32 vertType, VulkanVertexShader
 		GenerateVulkanGLSLFragmentShader(FSID, codeBuffer_, vendorID);
 		fs = new VulkanFragmentShader(vulkan_, FSID, codeBuffer_);
 		fsCache_.Insert(FSID, fs);
+		gpuStats.numShaderCompiles++;
 	}
 
 	lastFSID_ = FSID;
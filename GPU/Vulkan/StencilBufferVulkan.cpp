@@ -142,6 +142,13 @@ bool FramebufferManagerVulkan::NotifyStencilUpload(u32 addr, int size, bool skip
 		break;
 	}
 
+	// When the upload is a constant fill (the common case - games clearing stencil
+	// with memset-style VRAM writes), a single draw with the full value as write
+	// mask replaces the whole per-bit loop below.
+	u8 constantValue = 0;
+	const bool constantFill = usedBits != 0 &&
+		StencilConstantValue(src, dstBuffer->format, dstBuffer->fb_stride * dstBuffer->bufferHeight, &constantValue);
+
 	std::string error;
 	if (!stencilVs_) {
 		const char *stencil_fs_source = stencil_fs;
@@ -185,31 +192,40 @@ bool FramebufferManagerVulkan::NotifyStencilUpload(u32 addr, int size, bool skip
 	renderManager->SetStencilParams(0xFF, 0xFF, 0x00);
 	renderManager->Draw(vulkan2D_->GetPipelineLayout(), descSet, 0, nullptr, VK_NULL_HANDLE, 0, 3);  // full screen triangle
 
-	for (int i = 1; i < values; i += i) {
-		if (!(usedBits & i)) {
-			// It's already zero, let's skip it.
-			continue;
-		}
-
-		// These are the stencil bits that will be written.  We discard when the bit doesn't match.
-		uint8_t writeMask = 0;
-		// This is the value to test the texture alpha against in the shader.
-		uint32_t value = 0;
-		if (dstBuffer->format == GE_FORMAT_4444) {
-			writeMask = i | (i << 4);
-			value = i * 16;
-		} else if (dstBuffer->format == GE_FORMAT_5551) {
-			writeMask = 0xFF;
-			value = i * 128;
-		} else {
-			writeMask = i;
-			value = i;
-		}
-		renderManager->SetStencilParams(writeMask, 0xFF, 0xFF);
-		// Need to specify both VERTEX and FRAGMENT bits here since that's what we set up in the pipeline layout, and we need
-		// that for the post shaders. There's probably not really a cost to this.
+	if (constantFill) {
+		// The texture alpha equals the constant value everywhere, so one pass with it
+		// as both test value and write mask reconstructs the whole thing.
+		uint32_t value = constantValue;
+		renderManager->SetStencilParams(constantValue, 0xFF, 0xFF);
 		renderManager->PushConstants(vulkan2D_->GetPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT|VK_SHADER_STAGE_FRAGMENT_BIT, 0, 4, &value);
 		renderManager->Draw(vulkan2D_->GetPipelineLayout(), descSet, 0, nullptr, VK_NULL_HANDLE, 0, 3);  // full screen triangle
+	} else {
+		for (int i = 1; i < values; i += i) {
+			if (!(usedBits & i)) {
+				// It's already zero, let's skip it.
+				continue;
+			}
+
+			// These are the stencil bits that will be written.  We discard when the bit doesn't match.
+			uint8_t writeMask = 0;
+			// This is the value to test the texture alpha against in the shader.
+			uint32_t value = 0;
+			if (dstBuffer->format == GE_FORMAT_4444) {
+				writeMask = i | (i << 4);
+				value = i * 16;
+			} else if (dstBuffer->format == GE_FORMAT_5551) {
+				writeMask = 0xFF;
+				value = i * 128;
+			} else {
+				writeMask = i;
+				value = i;
+			}
+			renderManager->SetStencilParams(writeMask, 0xFF, 0xFF);
+			// Need to specify both VERTEX and FRAGMENT bits here since that's what we set up in the pipeline layout, and we need
+			// that for the post shaders. There's probably not really a cost to this.
+			renderManager->PushConstants(vulkan2D_->GetPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT|VK_SHADER_STAGE_FRAGMENT_BIT, 0, 4, &value);
+			renderManager->Draw(vulkan2D_->GetPipelineLayout(), descSet, 0, nullptr, VK_NULL_HANDLE, 0, 3);  // full screen triangle
+		}
 	}
 
 	overrideImageView_ = VK_NULL_HANDLE;
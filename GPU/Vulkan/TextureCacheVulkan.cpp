@@ -66,6 +66,9 @@ static const VkComponentMapping VULKAN_4444_SWIZZLE = { VK_COMPONENT_SWIZZLE_A,
 static const VkComponentMapping VULKAN_1555_SWIZZLE = { VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_A };
 static const VkComponentMapping VULKAN_565_SWIZZLE = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A };
 static const VkComponentMapping VULKAN_8888_SWIZZLE = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A };
+// For R8 index textures. Zeroing the other channels makes the 8888 index reconstruction
+// in the shader depal path yield exactly the stored index.
+static const VkComponentMapping VULKAN_R8_INDEX_SWIZZLE = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_ZERO, VK_COMPONENT_SWIZZLE_ZERO, VK_COMPONENT_SWIZZLE_ZERO };
 
 SamplerCache::~SamplerCache() {
 	DeviceLost();
@@ -143,6 +146,8 @@ TextureCacheVulkan::TextureCacheVulkan(Draw::DrawContext *draw, VulkanContext *v
 		vulkan_(vulkan),
 		samplerCache_(vulkan) {
 	timesInvalidatedAllThisFrame_ = 0;
+	// Rendered CLUTs can stay on the GPU, the depal path blits them from the framebuffer.
+	supportsReadbackFreeClut_ = true;
 	DeviceRestore(vulkan, draw);
 	SetupTextureDecoder();
 }
@@ -162,6 +167,9 @@ void TextureCacheVulkan::SetVulkan2D(Vulkan2D *vk2d) {
 }
 
 void TextureCacheVulkan::DeviceLost() {
+	// These would have been recorded into a command buffer that's gone.
+	pendingUploadBarriers_.clear();
+
 	Clear(true);
 
 	if (allocator_) {
@@ -258,6 +266,7 @@ void TextureCacheVulkan::StartFrame() {
 
 	timesInvalidatedAllThisFrame_ = 0;
 	texelsScaledThisFrame_ = 0;
+	texelsBuiltThisFrame_ = 0;
 
 	if (clearCacheNextFrame_) {
 		Clear(true);
@@ -274,7 +283,18 @@ void TextureCacheVulkan::StartFrame() {
 	allocator_->Begin();
 }
 
+void TextureCacheVulkan::FlushPendingUploadBarriers() {
+	if (pendingUploadBarriers_.empty())
+		return;
+	VkCommandBuffer cmdInit = (VkCommandBuffer)draw_->GetNativeObject(Draw::NativeObject::INIT_COMMANDBUFFER);
+	vkCmdPipelineBarrier(cmdInit, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+		0, nullptr, 0, nullptr,
+		(uint32_t)pendingUploadBarriers_.size(), pendingUploadBarriers_.data());
+	pendingUploadBarriers_.clear();
+}
+
 void TextureCacheVulkan::EndFrame() {
+	FlushPendingUploadBarriers();
 	allocator_->End();
 
 	if (texelsScaledThisFrame_) {
@@ -326,9 +346,26 @@ void TextureCacheVulkan::BindTexture(TexCacheEntry *entry) {
 	imageView_ = entry->vkTex->GetImageView();
 	SamplerCacheKey key{};
 	UpdateSamplingParams(*entry, key);
+	if (entry->status & TexCacheEntry::STATUS_DEPALETTIZE) {
+		// Raw index texture - the fragment shader looks up the current CLUT, like the
+		// shader depal path for framebuffer-sourced textures. Filtering happens in the
+		// shader, so force point sampling here.
+		depalShaderCache_->SetPushBuffer(drawEngine_->GetPushBufferForTextureData());
+		// Plain texture with a rendered CLUT is rare enough that we just read back.
+		EnsureClutReadback();
+		VulkanTexture *clutTexture = depalShaderCache_->GetClutTexture(gstate.getClutPaletteFormat(), clutHash_, clutBuf_);
+		drawEngine_->SetDepalTexture(clutTexture ? clutTexture->GetImageView() : VK_NULL_HANDLE);
+		key.magFilt = false;
+		key.minFilt = false;
+		key.mipFilt = false;
+		gstate_c.Dirty(DIRTY_DEPAL);
+		gstate_c.SetUseShaderDepal(true);
+		gstate_c.depalFramebufferFormat = GE_FORMAT_8888;
+	} else {
+		drawEngine_->SetDepalTexture(VK_NULL_HANDLE);
+		gstate_c.SetUseShaderDepal(false);
+	}
 	curSampler_ = samplerCache_.GetOrCreateSampler(key);
-	drawEngine_->SetDepalTexture(VK_NULL_HANDLE);
-	gstate_c.SetUseShaderDepal(false);
 }
 
 void TextureCacheVulkan::Unbind() {
@@ -350,8 +387,18 @@ void TextureCacheVulkan::ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFr
 		if (useShaderDepal) {
 			depalShaderCache_->SetPushBuffer(drawEngine_->GetPushBufferForTextureData());
 			const GEPaletteFormat clutFormat = gstate.getClutPaletteFormat();
-			VulkanTexture *clutTexture = depalShaderCache_->GetClutTexture(clutFormat, clutHash_, clutBuf_);
-			drawEngine_->SetDepalTexture(clutTexture ? clutTexture->GetImageView() : VK_NULL_HANDLE);
+			// If the CLUT was rendered, grab it straight off the GPU instead of reading it back.
+			Draw::Framebuffer *dynamicClutFbo = GetDynamicClutFbo(clutFormat);
+			VkImageView clutTextureView = VK_NULL_HANDLE;
+			if (dynamicClutFbo) {
+				draw_->BindFramebufferAsTexture(dynamicClutFbo, 0, Draw::FB_COLOR_BIT, 0);
+				clutTextureView = (VkImageView)draw_->GetNativeObject(Draw::NativeObject::BOUND_TEXTURE0_IMAGEVIEW);
+			} else {
+				EnsureClutReadback();
+				VulkanTexture *clutTexture = depalShaderCache_->GetClutTexture(clutFormat, clutHash_, clutBuf_);
+				clutTextureView = clutTexture ? clutTexture->GetImageView() : VK_NULL_HANDLE;
+			}
+			drawEngine_->SetDepalTexture(clutTextureView);
 			// Only point filtering enabled.
 			samplerKey.magFilt = false;
 			samplerKey.minFilt = false;
@@ -360,10 +407,15 @@ void TextureCacheVulkan::ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFr
 			gstate_c.Dirty(DIRTY_DEPAL);
 			gstate_c.SetUseShaderDepal(true);
 			gstate_c.depalFramebufferFormat = framebuffer->drawnFormat;
-			const u32 bytesPerColor = clutFormat == GE_CMODE_32BIT_ABGR8888 ? sizeof(u32) : sizeof(u16);
-			const u32 clutTotalColors = clutMaxBytes_ / bytesPerColor;
-			TexCacheEntry::TexStatus alphaStatus = CheckAlpha(clutBuf_, getClutDestFormatVulkan(clutFormat), clutTotalColors, clutTotalColors, 1);
-			gstate_c.SetTextureFullAlpha(alphaStatus == TexCacheEntry::STATUS_ALPHA_FULL);
+			if (dynamicClutFbo) {
+				// The palette bytes never hit the CPU, so we can't check - assume the worst.
+				gstate_c.SetTextureFullAlpha(false);
+			} else {
+				const u32 bytesPerColor = clutFormat == GE_CMODE_32BIT_ABGR8888 ? sizeof(u32) : sizeof(u16);
+				const u32 clutTotalColors = clutMaxBytes_ / bytesPerColor;
+				TexCacheEntry::TexStatus alphaStatus = CheckAlpha(clutBuf_, getClutDestFormatVulkan(clutFormat), clutTotalColors, clutTotalColors, 1);
+				gstate_c.SetTextureFullAlpha(alphaStatus == TexCacheEntry::STATUS_ALPHA_FULL);
+			}
 			curSampler_ = samplerCache_.GetOrCreateSampler(samplerKey);
 			InvalidateLastTexture(entry);
 			imageView_ = framebufferManagerVulkan_->BindFramebufferAsColorTexture(0, framebuffer, BINDFBCOLOR_MAY_COPY_WITH_UV | BINDFBCOLOR_APPLY_TEX_OFFSET);
@@ -377,7 +429,14 @@ void TextureCacheVulkan::ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFr
 	if (depalShader) {
 		depalShaderCache_->SetPushBuffer(drawEngine_->GetPushBufferForTextureData());
 		const GEPaletteFormat clutFormat = gstate.getClutPaletteFormat();
-		VulkanTexture *clutTexture = depalShaderCache_->GetClutTexture(clutFormat, clutHash_, clutBuf_);
+		// If the CLUT was rendered, blit it into a small FBO instead of reading it back.
+		// Has to happen before we open the depal render pass below.
+		Draw::Framebuffer *dynamicClutFbo = GetDynamicClutFbo(clutFormat);
+		VulkanTexture *clutTexture = nullptr;
+		if (!dynamicClutFbo) {
+			EnsureClutReadback();
+			clutTexture = depalShaderCache_->GetClutTexture(clutFormat, clutHash_, clutBuf_);
+		}
 
 		Draw::Framebuffer *depalFBO = framebufferManager_->GetTempFBO(TempFBO::DEPAL, framebuffer->renderWidth, framebuffer->renderHeight, Draw::FBO_8888);
 		draw_->BindFramebufferAsRenderTarget(depalFBO, { Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE });
@@ -437,10 +496,18 @@ void TextureCacheVulkan::ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFr
 		VkBuffer pushed;
 		uint32_t offset = push_->PushAligned(verts, sizeof(verts), 4, &pushed);
 
+		VkImageView clutView;
+		if (dynamicClutFbo) {
+			draw_->BindFramebufferAsTexture(dynamicClutFbo, 0, Draw::FB_COLOR_BIT, 0);
+			clutView = (VkImageView)draw_->GetNativeObject(Draw::NativeObject::BOUND_TEXTURE0_IMAGEVIEW);
+		} else {
+			clutView = clutTexture->GetImageView();
+		}
+
 		draw_->BindFramebufferAsTexture(framebuffer->fbo, 0, Draw::FB_COLOR_BIT, 0);
 		VkImageView fbo = (VkImageView)draw_->GetNativeObject(Draw::NativeObject::BOUND_TEXTURE0_IMAGEVIEW);
 
-		VkDescriptorSet descSet = vulkan2D_->GetDescriptorSet(fbo, samplerNearest_, clutTexture->GetImageView(), samplerNearest_);
+		VkDescriptorSet descSet = vulkan2D_->GetDescriptorSet(fbo, samplerNearest_, clutView, samplerNearest_);
 		VulkanRenderManager *renderManager = (VulkanRenderManager *)draw_->GetNativeObject(Draw::NativeObject::RENDER_MANAGER);
 		renderManager->BindPipeline(depalShader->pipeline);
 		renderManager->SetScissor(VkRect2D{ {0, 0}, { framebuffer->renderWidth, framebuffer->renderHeight} });
@@ -448,11 +515,15 @@ void TextureCacheVulkan::ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFr
 		renderManager->Draw(vulkan2D_->GetPipelineLayout(), descSet, 0, nullptr, pushed, offset, 4);
 		shaderManagerVulkan_->DirtyLastShader();
 
-		const u32 bytesPerColor = clutFormat == GE_CMODE_32BIT_ABGR8888 ? sizeof(u32) : sizeof(u16);
-		const u32 clutTotalColors = clutMaxBytes_ / bytesPerColor;
+		if (dynamicClutFbo) {
+			gstate_c.SetTextureFullAlpha(false);
+		} else {
+			const u32 bytesPerColor = clutFormat == GE_CMODE_32BIT_ABGR8888 ? sizeof(u32) : sizeof(u16);
+			const u32 clutTotalColors = clutMaxBytes_ / bytesPerColor;
 
-		TexCacheEntry::TexStatus alphaStatus = CheckAlpha(clutBuf_, getClutDestFormatVulkan(clutFormat), clutTotalColors, clutTotalColors, 1);
-		gstate_c.SetTextureFullAlpha(alphaStatus == TexCacheEntry::STATUS_ALPHA_FULL);
+			TexCacheEntry::TexStatus alphaStatus = CheckAlpha(clutBuf_, getClutDestFormatVulkan(clutFormat), clutTotalColors, clutTotalColors, 1);
+			gstate_c.SetTextureFullAlpha(alphaStatus == TexCacheEntry::STATUS_ALPHA_FULL);
+		}
 
 		framebufferManager_->RebindFramebuffer();
 		draw_->BindFramebufferAsTexture(depalFBO, 0, Draw::FB_COLOR_BIT, 0);
@@ -559,6 +630,13 @@ void TextureCacheVulkan::BuildTexture(TexCacheEntry *const entry) {
 	int w = gstate.getTextureWidth(0);
 	int h = gstate.getTextureHeight(0);
 	ReplacedTexture &replaced = replacer_.FindReplacement(cachekey, entry->fullhash, w, h);
+	if (replaced.IsPending()) {
+		// Decode is in flight on the background loader - build the original texture now
+		// and swap the replacement in on a later frame, like deferred scaling.
+		entry->status |= TexCacheEntry::STATUS_TO_REPLACE;
+	} else {
+		entry->status &= ~TexCacheEntry::STATUS_TO_REPLACE;
+	}
 	if (replaced.GetSize(0, w, h)) {
 		// We're replacing, so we won't scale.
 		scaleFactor = 1;
@@ -577,7 +655,10 @@ void TextureCacheVulkan::BuildTexture(TexCacheEntry *const entry) {
 	}
 
 	if (scaleFactor != 1) {
-		if (texelsScaledThisFrame_ >= TEXCACHE_MAX_TEXELS_SCALED) {
+		// With deferred loads on, never scale on the very first build - upload the
+		// unscaled texture right away and swap in the scaled one on a later frame.
+		const bool deferScale = g_Config.bDeferTextureLoads && entry->numFrames == 0;
+		if (deferScale || texelsScaledThisFrame_ >= TEXCACHE_MAX_TEXELS_SCALED) {
 			entry->status |= TexCacheEntry::STATUS_TO_SCALE;
 			scaleFactor = 1;
 		} else {
@@ -597,6 +678,36 @@ void TextureCacheVulkan::BuildTexture(TexCacheEntry *const entry) {
 		actualFmt = ToVulkanFormat(replaced.Format(0));
 	}
 
+	// GPU-side depalettization of plain CLUT4/CLUT8 textures: upload the raw indices as
+	// an R8 texture and let the fragment shader do the palette lookup, reusing the shader
+	// depal path built for framebuffer-sourced textures. Skips the CPU expansion and, for
+	// 32-bit cluts, 4x of the upload bandwidth. Mips, scaling and replacement fall back
+	// to the CPU decode.
+	const bool shaderDepal = (entry->format == GE_TFMT_CLUT4 || entry->format == GE_TFMT_CLUT8) &&
+		maxLevel == 0 && scaleFactor == 1 && standardScaleFactor_ == 1 &&
+		!replacer_.Enabled() && clutRenderAddress_ == 0xFFFFFFFF &&
+		!Memory::IsVRAMAddress(entry->addr) && !IsFakeMipmapChange();
+	if (shaderDepal) {
+		dstFmt = VK_FORMAT_R8_UNORM;
+		actualFmt = dstFmt;
+		entry->status |= TexCacheEntry::STATUS_DEPALETTIZE;
+	} else {
+		entry->status &= ~TexCacheEntry::STATUS_DEPALETTIZE;
+	}
+
+	// If the game only supplied mip 0, optionally generate the rest with a blit
+	// chain - sampling without mips shimmers badly at high render scales. The
+	// entry flag makes sampling (and rehash-only revalidation) keep using the
+	// generated chain.
+	entry->status &= ~TexCacheEntry::STATUS_AUTOGEN_MIPS;
+	int autogenLevels = 0;
+	if (g_Config.bGenerateMipmaps && maxLevel == 0 && scaleFactor == 1 && !shaderDepal &&
+		w > 1 && h > 1 && !IsFakeMipmapChange() && !Memory::IsVRAMAddress(entry->addr) &&
+		videos_.find(entry->addr & 0x3FFFFFFF) == videos_.end() && !replaced.Valid()) {
+		entry->status |= TexCacheEntry::STATUS_AUTOGEN_MIPS;
+		autogenLevels = entry->MipLevels();
+	}
+
 	{
 		delete entry->vkTex;
 		entry->vkTex = new VulkanTexture(vulkan_);
@@ -608,6 +719,10 @@ void TextureCacheVulkan::BuildTexture(TexCacheEntry *const entry) {
 			mapping = &VULKAN_4444_SWIZZLE;
 			break;
 
+		case VK_FORMAT_R8_UNORM:
+			mapping = &VULKAN_R8_INDEX_SWIZZLE;
+			break;
+
 		case VULKAN_1555_FORMAT:
 			mapping = &VULKAN_1555_SWIZZLE;
 			break;
@@ -625,7 +740,13 @@ void TextureCacheVulkan::BuildTexture(TexCacheEntry *const entry) {
 		snprintf(texName, sizeof(texName), "Texture%08x", entry->addr);
 		image->SetTag(texName);
 
-		bool allocSuccess = image->CreateDirect(cmdInit, allocator_, w * scaleFactor, h * scaleFactor, maxLevel + 1, actualFmt, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, mapping);
+		// Autogenerated mips blit between levels, so the image needs transfer-src usage too.
+		int numMips = autogenLevels > 0 ? autogenLevels + 1 : maxLevel + 1;
+		VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+		if (autogenLevels > 0)
+			usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+		bool allocSuccess = image->CreateDirect(cmdInit, allocator_, w * scaleFactor, h * scaleFactor, numMips, actualFmt, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, usage, mapping);
 		if (!allocSuccess && !lowMemoryMode_) {
 			WARN_LOG_REPORT(G3D, "Texture cache ran out of GPU memory; switching to low memory mode");
 			lowMemoryMode_ = true;
@@ -644,7 +765,7 @@ void TextureCacheVulkan::BuildTexture(TexCacheEntry *const entry) {
 			scaleFactor = 1;
 			actualFmt = dstFmt;
 
-			allocSuccess = image->CreateDirect(cmdInit, allocator_, w * scaleFactor, h * scaleFactor, maxLevel + 1, actualFmt, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, mapping);
+			allocSuccess = image->CreateDirect(cmdInit, allocator_, w * scaleFactor, h * scaleFactor, numMips, actualFmt, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, usage, mapping);
 		}
 
 		if (!allocSuccess) {
@@ -670,14 +791,19 @@ void TextureCacheVulkan::BuildTexture(TexCacheEntry *const entry) {
 		// NOTE: Since the level is not part of the cache key, we assume it never changes.
 		u8 level = std::max(0, gstate.getTexLevelOffset16() / 16);
 		bool fakeMipmap = IsFakeMipmapChange() && level > 0;
-		// Upload the texture data.
+		// Upload the texture data. The mips are batched into a single copy command -
+		// scene-change frames decode hundreds of textures, and all the tiny copies
+		// and barriers were a real cost, so we consolidate.
+		VkBufferImageCopy uploadRegions[16]{};
+		int numUploadRegions = 0;
+		VkBuffer uploadBuffer = VK_NULL_HANDLE;
 		for (int i = 0; i <= maxLevel; i++) {
 			int mipWidth = gstate.getTextureWidth(i) * scaleFactor;
 			int mipHeight = gstate.getTextureHeight(i) * scaleFactor;
 			if (replaced.Valid()) {
 				replaced.GetSize(i, mipWidth, mipHeight);
 			}
-			int bpp = actualFmt == VULKAN_8888_FORMAT ? 4 : 2;
+			int bpp = actualFmt == VULKAN_8888_FORMAT ? 4 : (actualFmt == VK_FORMAT_R8_UNORM ? 1 : 2);
 			int stride = (mipWidth * bpp + 15) & ~15;
 			int size = stride * mipHeight;
 			uint32_t bufferOffset;
@@ -685,21 +811,56 @@ void TextureCacheVulkan::BuildTexture(TexCacheEntry *const entry) {
 			// nvidia returns 1 but that can't be healthy... let's align by 16 as a minimum.
 			int pushAlignment = std::max(16, (int)vulkan_->GetPhysicalDeviceProperties().properties.limits.optimalBufferCopyOffsetAlignment);
 			void *data = drawEngine_->GetPushBufferForTextureData()->PushAligned(size, &bufferOffset, &texBuf, pushAlignment);
+			if (texBuf != uploadBuffer && numUploadRegions != 0) {
+				// The push buffer rolled over into a new block mid-texture (rare.)
+				// Flush what we have, the rest sources the new buffer.
+				entry->vkTex->UploadMips(cmdInit, uploadBuffer, numUploadRegions, uploadRegions);
+				numUploadRegions = 0;
+			}
+			uploadBuffer = texBuf;
+
+			bool lastLevel = false;
+			int dstMip = i;
 			if (replaced.Valid()) {
 				replaced.Load(i, data, stride);
 			} else {
 				if (fakeMipmap) {
 					LoadTextureLevel(*entry, (uint8_t *)data, stride, level, scaleFactor, dstFmt);
-					entry->vkTex->UploadMip(cmdInit, 0, mipWidth, mipHeight, texBuf, bufferOffset, stride / bpp);
-					break;
+					dstMip = 0;
+					lastLevel = true;
 				} else {
 					LoadTextureLevel(*entry, (uint8_t *)data, stride, i, scaleFactor, dstFmt);
 				}
-				if (replacer_.Enabled()) {
+				if (!lastLevel && replacer_.Enabled()) {
 					replacer_.NotifyTextureDecoded(replacedInfo, data, stride, i, mipWidth, mipHeight);
 				}
 			}
-			entry->vkTex->UploadMip(cmdInit, i, mipWidth, mipHeight, texBuf, bufferOffset, stride / bpp);
+
+			VkBufferImageCopy &copy = uploadRegions[numUploadRegions++];
+			copy.bufferOffset = bufferOffset;
+			copy.bufferRowLength = (uint32_t)(stride / bpp);
+			copy.bufferImageHeight = 0;  // 2D
+			copy.imageExtent.width = mipWidth;
+			copy.imageExtent.height = mipHeight;
+			copy.imageExtent.depth = 1;
+			copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			copy.imageSubresource.mipLevel = dstMip;
+			copy.imageSubresource.baseArrayLayer = 0;
+			copy.imageSubresource.layerCount = 1;
+			gpuStats.numTextureDataBytesUploaded += size;
+
+			if (lastLevel)
+				break;
+		}
+		if (numUploadRegions != 0) {
+			entry->vkTex->UploadMips(cmdInit, uploadBuffer, numUploadRegions, uploadRegions);
+		}
+
+		// Blit the mip chain down from the uploaded level 0. GenerateMip handles the
+		// per-level transitions and leaves everything in TRANSFER_DST, so the deferred
+		// barrier below covers the generated levels too.
+		for (int i = 1; i <= autogenLevels; i++) {
+			entry->vkTex->GenerateMip(cmdInit, i);
 		}
 
 		if (maxLevel == 0) {
@@ -710,7 +871,24 @@ void TextureCacheVulkan::BuildTexture(TexCacheEntry *const entry) {
 		if (replaced.Valid()) {
 			entry->SetAlphaStatus(TexCacheEntry::TexStatus(replaced.AlphaStatus()));
 		}
-		entry->vkTex->EndCreate(cmdInit);
+
+		// The transition to shader-readable is deferred and batched too, see
+		// FlushPendingUploadBarriers(). It only has to land in the init command
+		// buffer before it's submitted - draws live in the main one.
+		VkImageMemoryBarrier barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+		barrier.image = entry->vkTex->GetImage();
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		barrier.subresourceRange.baseMipLevel = 0;
+		barrier.subresourceRange.levelCount = entry->vkTex->GetNumMips();
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = 1;
+		pendingUploadBarriers_.push_back(barrier);
 	}
 
 	gstate_c.SetTextureFullAlpha(entry->GetAlphaStatus() == TexCacheEntry::STATUS_ALPHA_FULL);
@@ -771,6 +949,44 @@ void TextureCacheVulkan::LoadTextureLevel(TexCacheEntry &entry, uint8_t *writePt
 		GEPaletteFormat clutformat = gstate.getClutPaletteFormat();
 		u32 texaddr = gstate.getTextureAddress(level);
 		int bufw = GetTextureBufw(level, texaddr, tfmt);
+
+		if (dstFmt == VK_FORMAT_R8_UNORM) {
+			// Shader depal: upload the raw indices, the fragment shader does the lookup.
+			const u8 *texptr = Memory::GetPointer(texaddr);
+			if (gstate.isTextureSwizzled()) {
+				tmpTexBuf32_.resize(bufw * ((h + 7) & ~7));
+				if (tfmt == GE_TFMT_CLUT4) {
+					UnswizzleFromMem(tmpTexBuf32_.data(), bufw / 2, texptr, bufw, h, 0);
+				} else {
+					UnswizzleFromMem(tmpTexBuf32_.data(), bufw, texptr, bufw, h, 1);
+				}
+				texptr = (const u8 *)tmpTexBuf32_.data();
+			}
+			if (tfmt == GE_TFMT_CLUT4) {
+				for (int y = 0; y < h; ++y) {
+					const u8 *src = texptr + (bufw * y) / 2;
+					u8 *dst = writePtr + rowPitch * y;
+					for (int x = 0; x < w; x += 2) {
+						const u8 index = src[x / 2];
+						dst[x] = index & 0xF;
+						dst[x + 1] = index >> 4;
+					}
+				}
+			} else {
+				for (int y = 0; y < h; ++y) {
+					memcpy(writePtr + rowPitch * y, texptr + bufw * y, w);
+				}
+			}
+			gpuStats.numTexturesDecoded++;
+
+			// Alpha comes from the palette, which is fixed for this entry (the clut hash
+			// is part of the cache key.)
+			const u32 bytesPerColor = clutformat == GE_CMODE_32BIT_ABGR8888 ? sizeof(u32) : sizeof(u16);
+			const u32 clutTotalColors = clutMaxBytes_ / bytesPerColor;
+			entry.SetAlphaStatus(CheckAlpha(clutBuf_, getClutDestFormatVulkan(clutformat), clutTotalColors, clutTotalColors, 1), level);
+			return;
+		}
+
 		int bpp = dstFmt == VULKAN_8888_FORMAT ? 4 : 2;
 
 		u32 *pixelData = (u32 *)writePtr;
@@ -121,6 +121,7 @@ private:
 
 	void ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFramebuffer *framebuffer) override;
 	void BuildTexture(TexCacheEntry *const entry) override;
+	void FlushPendingUploadBarriers();
 
 	VulkanContext *vulkan_ = nullptr;
 	VulkanDeviceAllocator *allocator_ = nullptr;
@@ -136,6 +137,10 @@ private:
 	int texelsScaledThisFrame_ = 0;
 	int timesInvalidatedAllThisFrame_ = 0;
 
+	// Deferred transfer->shader-read transitions for textures uploaded this
+	// frame, recorded as one consolidated barrier at EndFrame().
+	std::vector<VkImageMemoryBarrier> pendingUploadBarriers_;
+
 	FramebufferManagerVulkan *framebufferManagerVulkan_;
 	DepalShaderCacheVulkan *depalShaderCache_;
 	ShaderManagerVulkan *shaderManagerVulkan_;
@@ -34,10 +34,12 @@
 #include "Core/ConfigValues.h"
 #include "Core/System.h"
 #include "Core/CoreParameter.h"
+#include "Core/MIPS/MIPSSampleProfiler.h"
 #include "Core/MIPS/MIPSTables.h"
 #include "Core/MIPS/JitCommon/JitBlockCache.h"
 #include "Core/MIPS/JitCommon/JitCommon.h"
 #include "Core/MIPS/JitCommon/JitState.h"
+#include "GPU/Debugger/GeProfiler.h"
 #include "GPU/GPUInterface.h"
 #include "GPU/GPUState.h"
 #include "UI/MiscScreens.h"
@@ -78,6 +80,9 @@ void DevMenu::CreatePopupContents(UI::ViewGroup *parent) {
 	items->Add(new Choice(dev->T("Toggle Freeze")))->OnClick.Handle(this, &DevMenu::OnFreezeFrame);
 	items->Add(new Choice(dev->T("Dump Frame GPU Commands")))->OnClick.Handle(this, &DevMenu::OnDumpFrame);
 	items->Add(new Choice(dev->T("Toggle Audio Debug")))->OnClick.Handle(this, &DevMenu::OnToggleAudioDebug);
+	items->Add(new Choice(dev->T("MIPS Function Profiler")))->OnClick.Handle(this, &DevMenu::OnMIPSProfiler);
+	items->Add(new Choice(dev->T("GE List Profiler")))->OnClick.Handle(this, &DevMenu::OnGeProfiler);
+	items->Add(new Choice(dev->T("Flush Analysis")))->OnClick.Handle(this, &DevMenu::OnFlushAnalysis);
 #ifdef USE_PROFILER
 	items->Add(new CheckBox(&g_Config.bShowFrameProfiler, dev->T("Frame Profiler"), ""));
 #endif
@@ -115,6 +120,24 @@ UI::EventReturn DevMenu::OnDeveloperTools(UI::EventParams &e) {
 	return UI::EVENT_DONE;
 }
 
+UI::EventReturn DevMenu::OnMIPSProfiler(UI::EventParams &e) {
+	UpdateUIState(UISTATE_PAUSEMENU);
+	screenManager()->push(new MIPSProfilerScreen());
+	return UI::EVENT_DONE;
+}
+
+UI::EventReturn DevMenu::OnGeProfiler(UI::EventParams &e) {
+	UpdateUIState(UISTATE_PAUSEMENU);
+	screenManager()->push(new GeProfilerScreen());
+	return UI::EVENT_DONE;
+}
+
+UI::EventReturn DevMenu::OnFlushAnalysis(UI::EventParams &e) {
+	UpdateUIState(UISTATE_PAUSEMENU);
+	screenManager()->push(new FlushAnalysisScreen());
+	return UI::EVENT_DONE;
+}
+
 UI::EventReturn DevMenu::OnJitCompare(UI::EventParams &e) {
 	UpdateUIState(UISTATE_PAUSEMENU);
 	screenManager()->push(new JitCompareScreen());
@@ -373,6 +396,196 @@ void JitDebugScreen::CreateViews() {
 	}
 }
 
+void MIPSProfilerScreen::CreateViews() {
+	using namespace UI;
+
+	I18NCategory *di = GetI18NCategory("Dialog");
+	I18NCategory *dev = GetI18NCategory("Developer");
+
+	root_ = new ScrollView(ORIENT_VERTICAL);
+
+	LinearLayout *vert = root_->Add(new LinearLayout(ORIENT_VERTICAL, new LinearLayoutParams(FILL_PARENT, WRAP_CONTENT)));
+	vert->SetSpacing(0);
+
+	LinearLayout *topbar = new LinearLayout(ORIENT_HORIZONTAL);
+	topbar->Add(new Choice(di->T("Back")))->OnClick.Handle<UIScreen>(this, &UIScreen::OnBack);
+	topbar->Add(new Choice(MIPSSampleProfiler::IsEnabled() ? dev->T("Stop profiling") : dev->T("Start profiling")))->OnClick.Handle(this, &MIPSProfilerScreen::OnToggleEnabled);
+	topbar->Add(new Choice(dev->T("Reset")))->OnClick.Handle(this, &MIPSProfilerScreen::OnReset);
+	topbar->Add(new Choice(dev->T("Refresh")))->OnClick.Handle(this, &MIPSProfilerScreen::OnRefresh);
+	vert->Add(topbar);
+
+	vert->Add(new ItemHeader(dev->T("Hottest functions (cycle weighted)")));
+
+	auto top = MIPSSampleProfiler::GetTopFunctions(100);
+	if (top.empty()) {
+		vert->Add(new TextView(dev->T("No samples yet - start profiling and play for a few seconds"), new LayoutParams(FILL_PARENT, WRAP_CONTENT)));
+	}
+	for (const auto &func : top) {
+		char line[256];
+		snprintf(line, sizeof(line), "%5.1f%%  %08x  %s", func.percent, func.address,
+			func.name.empty() ? "(no symbol)" : func.name.c_str());
+		vert->Add(new TextView(line, FLAG_DYNAMIC_ASCII, false, new LayoutParams(FILL_PARENT, WRAP_CONTENT)));
+	}
+}
+
+UI::EventReturn MIPSProfilerScreen::OnToggleEnabled(UI::EventParams &e) {
+	MIPSSampleProfiler::SetEnabled(!MIPSSampleProfiler::IsEnabled());
+	RecreateViews();
+	return UI::EVENT_DONE;
+}
+
+UI::EventReturn MIPSProfilerScreen::OnReset(UI::EventParams &e) {
+	MIPSSampleProfiler::Reset();
+	RecreateViews();
+	return UI::EVENT_DONE;
+}
+
+UI::EventReturn MIPSProfilerScreen::OnRefresh(UI::EventParams &e) {
+	RecreateViews();
+	return UI::EVENT_DONE;
+}
+
+void GeProfilerScreen::CreateViews() {
+	using namespace UI;
+
+	I18NCategory *di = GetI18NCategory("Dialog");
+	I18NCategory *dev = GetI18NCategory("Developer");
+
+	root_ = new ScrollView(ORIENT_VERTICAL);
+
+	LinearLayout *vert = root_->Add(new LinearLayout(ORIENT_VERTICAL, new LinearLayoutParams(FILL_PARENT, WRAP_CONTENT)));
+	vert->SetSpacing(0);
+
+	LinearLayout *topbar = new LinearLayout(ORIENT_HORIZONTAL);
+	topbar->Add(new Choice(di->T("Back")))->OnClick.Handle<UIScreen>(this, &UIScreen::OnBack);
+	topbar->Add(new Choice(GeProfiler::IsEnabled() ? dev->T("Stop profiling") : dev->T("Start profiling")))->OnClick.Handle(this, &GeProfilerScreen::OnToggleEnabled);
+	topbar->Add(new Choice(dev->T("Reset")))->OnClick.Handle(this, &GeProfilerScreen::OnReset);
+	topbar->Add(new Choice(dev->T("Refresh")))->OnClick.Handle(this, &GeProfilerScreen::OnRefresh);
+	vert->Add(topbar);
+
+	vert->Add(new ItemHeader(dev->T("List time by enqueue call site")));
+
+	auto top = GeProfiler::GetTopCallsites(100);
+	if (top.empty()) {
+		vert->Add(new TextView(dev->T("No lists yet - start profiling and play for a few seconds"), new LayoutParams(FILL_PARENT, WRAP_CONTENT)));
+	}
+	for (const auto &site : top) {
+		char line[256];
+		snprintf(line, sizeof(line), "%5.1f%%  %8.1f ms  %6lld lists  %08x  %s", site.percent, site.totalMs,
+			(long long)site.lists, site.address, site.name.empty() ? "(no symbol)" : site.name.c_str());
+		vert->Add(new TextView(line, FLAG_DYNAMIC_ASCII, false, new LayoutParams(FILL_PARENT, WRAP_CONTENT)));
+	}
+}
+
+UI::EventReturn GeProfilerScreen::OnToggleEnabled(UI::EventParams &e) {
+	GeProfiler::SetEnabled(!GeProfiler::IsEnabled());
+	RecreateViews();
+	return UI::EVENT_DONE;
+}
+
+UI::EventReturn GeProfilerScreen::OnReset(UI::EventParams &e) {
+	GeProfiler::Reset();
+	RecreateViews();
+	return UI::EVENT_DONE;
+}
+
+UI::EventReturn GeProfilerScreen::OnRefresh(UI::EventParams &e) {
+	RecreateViews();
+	return UI::EVENT_DONE;
+}
+
+// Which merge optimization would reduce the top flush cause. Not translated, like
+// the jit disable flags - this is developer-facing output.
+static const char *FlushTuningHint(FlushReason reason) {
+	switch (reason) {
+	case FLUSH_REASON_TEXTURE_CHANGE: return "Texture switches fragment batching - texture atlasing or CLUT-variant merging would help this game most.";
+	case FLUSH_REASON_CLUT_CHANGE: return "CLUT uploads fragment batching - CLUT dedup / hash-based reuse would help this game most.";
+	case FLUSH_REASON_FRAMEBUF_CHANGE: return "Render target switches fragment batching - render pass merging/reordering would help this game most.";
+	case FLUSH_REASON_VERTEX_FORMAT_CHANGE: return "Vertex format switches fragment batching - merging compatible vertex declarations would help this game most.";
+	case FLUSH_REASON_MATRIX_CHANGE: return "Matrix uploads fragment batching - software skinning or matrix dedup would help this game most.";
+	case FLUSH_REASON_LIGHT_CHANGE: return "Light/material changes fragment batching - lighting state dedup would help this game most.";
+	case FLUSH_REASON_BLEND_STATE_CHANGE: return "Blend state changes fragment batching - redundant state filtering would help this game most.";
+	case FLUSH_REASON_DEPTH_STENCIL_CHANGE: return "Depth/stencil changes fragment batching - redundant state filtering would help this game most.";
+	case FLUSH_REASON_VIEWPORT_SCISSOR_CHANGE: return "Viewport/scissor changes fragment batching - treating them as dynamic state would help this game most.";
+	case FLUSH_REASON_OTHER_STATE_CHANGE: return "Misc state changes fragment batching - check a GE dump for what this game toggles between draws.";
+	case FLUSH_REASON_PRIM_TYPE_CHANGE: return "Primitive type switches fragment batching - little to merge, batches split on incompatible prims.";
+	case FLUSH_REASON_BUFFER_FULL: return "Batches mostly fill the draw buffers - batching is already working well for this game.";
+	default: return "Flushes are mostly frame ends and syncs - batching is already working well for this game.";
+	}
+}
+
+void FlushAnalysisScreen::CreateViews() {
+	using namespace UI;
+
+	I18NCategory *di = GetI18NCategory("Dialog");
+	I18NCategory *dev = GetI18NCategory("Developer");
+
+	root_ = new ScrollView(ORIENT_VERTICAL);
+
+	LinearLayout *vert = root_->Add(new LinearLayout(ORIENT_VERTICAL, new LinearLayoutParams(FILL_PARENT, WRAP_CONTENT)));
+	vert->SetSpacing(0);
+
+	LinearLayout *topbar = new LinearLayout(ORIENT_HORIZONTAL);
+	topbar->Add(new Choice(di->T("Back")))->OnClick.Handle<UIScreen>(this, &UIScreen::OnBack);
+	topbar->Add(new Choice(dev->T("Reset")))->OnClick.Handle(this, &FlushAnalysisScreen::OnReset);
+	topbar->Add(new Choice(dev->T("Refresh")))->OnClick.Handle(this, &FlushAnalysisScreen::OnRefresh);
+	vert->Add(topbar);
+
+	// Snapshot the totals - the GPU thread keeps appending while we read.
+	u64 counts[NUM_FLUSH_REASONS];
+	memcpy(counts, gpuStats.numFlushesByReasonHistory, sizeof(counts));
+	int frames = gpuStats.numFlushHistoryFrames;
+	u64 total = 0;
+	for (int i = 0; i < NUM_FLUSH_REASONS; i++)
+		total += counts[i];
+
+	char header[128];
+	snprintf(header, sizeof(header), "%s (%d %s)", dev->T("Flushes by cause"), frames, dev->T("frames"));
+	vert->Add(new ItemHeader(header));
+
+	if (total == 0) {
+		vert->Add(new TextView(dev->T("No flushes yet - play for a few seconds"), new LayoutParams(FILL_PARENT, WRAP_CONTENT)));
+		return;
+	}
+
+	int order[NUM_FLUSH_REASONS];
+	for (int i = 0; i < NUM_FLUSH_REASONS; i++)
+		order[i] = i;
+	std::sort(order, order + NUM_FLUSH_REASONS, [&counts](int a, int b) {
+		return counts[a] > counts[b];
+	});
+
+	for (int i = 0; i < NUM_FLUSH_REASONS; i++) {
+		if (counts[order[i]] == 0)
+			continue;
+		char line[256];
+		snprintf(line, sizeof(line), "%5.1f%%  %7.1f/frame  %s",
+			100.0 * counts[order[i]] / total,
+			frames > 0 ? (double)counts[order[i]] / frames : 0.0,
+			FlushReasonToString((FlushReason)order[i]));
+		vert->Add(new TextView(line, FLAG_DYNAMIC_ASCII, false, new LayoutParams(FILL_PARENT, WRAP_CONTENT)));
+	}
+
+	// Rank the hint by the top cause that an optimization could actually merge away,
+	// skipping the unavoidable frame end/sync bucket.
+	FlushReason top = (FlushReason)order[0];
+	if (top == FLUSH_REASON_OTHER && counts[order[1]] > 0)
+		top = (FlushReason)order[1];
+	vert->Add(new ItemHeader(dev->T("Tuning hint")));
+	vert->Add(new TextView(FlushTuningHint(top), new LayoutParams(FILL_PARENT, WRAP_CONTENT)));
+}
+
+UI::EventReturn FlushAnalysisScreen::OnReset(UI::EventParams &e) {
+	gpuStats.ResetFlushHistory();
+	RecreateViews();
+	return UI::EVENT_DONE;
+}
+
+UI::EventReturn FlushAnalysisScreen::OnRefresh(UI::EventParams &e) {
+	RecreateViews();
+	return UI::EVENT_DONE;
+}
+
 UI::EventReturn JitDebugScreen::OnEnableAll(UI::EventParams &e) {
 	g_Config.uJitDisableFlags &= ~(uint32_t)MIPSComp::JitDisable::ALL_FLAGS;
 	return UI::EVENT_DONE;
@@ -45,6 +45,45 @@ protected:
 	UI::EventReturn OnDumpFrame(UI::EventParams &e);
 	UI::EventReturn OnDeveloperTools(UI::EventParams &e);
 	UI::EventReturn OnToggleAudioDebug(UI::EventParams &e);
+	UI::EventReturn OnMIPSProfiler(UI::EventParams &e);
+	UI::EventReturn OnGeProfiler(UI::EventParams &e);
+	UI::EventReturn OnFlushAnalysis(UI::EventParams &e);
+};
+
+// Shows the ranked function profile from MIPSSampleProfiler.
+class MIPSProfilerScreen : public UIDialogScreenWithBackground {
+public:
+	MIPSProfilerScreen() {}
+	void CreateViews() override;
+
+private:
+	UI::EventReturn OnToggleEnabled(UI::EventParams &e);
+	UI::EventReturn OnReset(UI::EventParams &e);
+	UI::EventReturn OnRefresh(UI::EventParams &e);
+};
+
+// Shows GE display list time ranked by the game call site that enqueued the list.
+class GeProfilerScreen : public UIDialogScreenWithBackground {
+public:
+	GeProfilerScreen() {}
+	void CreateViews() override;
+
+private:
+	UI::EventReturn OnToggleEnabled(UI::EventParams &e);
+	UI::EventReturn OnReset(UI::EventParams &e);
+	UI::EventReturn OnRefresh(UI::EventParams &e);
+};
+
+// Ranks what breaks draw call batching in the current game, from the per-flush
+// cause histogram in gpuStats, and suggests which merge optimization would help.
+class FlushAnalysisScreen : public UIDialogScreenWithBackground {
+public:
+	FlushAnalysisScreen() {}
+	void CreateViews() override;
+
+private:
+	UI::EventReturn OnReset(UI::EventParams &e);
+	UI::EventReturn OnRefresh(UI::EventParams &e);
 };
 
 class JitDebugScreen : public UIDialogScreenWithBackground {
@@ -293,6 +293,13 @@ void EmuScreen::bootComplete() {
 	NOTICE_LOG(BOOT, "Loading %s...", PSP_CoreParameter().fileToStart.c_str());
 	autoLoad();
 
+	if (g_Config.bBootSnapshot && !SaveState::HasBootSnapshot(gamePath_)) {
+		// Capture a boot snapshot once gameplay has had a chance to start and the JIT
+		// and shader caches have warmed up, so the next launch can resume instantly.
+		bootSnapshotPending_ = true;
+		bootSnapshotDueTime_ = time_now_d() + 30.0;
+	}
+
 	I18NCategory *sc = GetI18NCategory("Screen");
 
 #ifndef MOBILE_DEVICE
@@ -1056,6 +1063,13 @@ void EmuScreen::update() {
 		screenManager()->push(new GamePauseScreen(gamePath_));
 	}
 
+	if (bootSnapshotPending_ && !bootPending_ && time_now_d() >= bootSnapshotDueTime_) {
+		bootSnapshotPending_ = false;
+		// No callback - this is automatic housekeeping, not a user action.
+		if (!SaveState::HasBootSnapshot(gamePath_))
+			SaveState::SaveBootSnapshot(gamePath_);
+	}
+
 	if (saveStatePreview_ && !bootPending_) {
 		int currentSlot = SaveState::GetCurrentSlot();
 		if (saveStateSlot_ != currentSlot) {
@@ -1120,12 +1134,14 @@ static void DrawAudioDebugStats(DrawBuffer *draw2d) {
 		"Underruns: %d\n"
 		"Overruns: %d\n"
 		"Sample rate: %d\n"
-		"Push size: %d\n",
+		"Push size: %d\n"
+		"Latency: %d ms\n",
 		stats->buffered, stats->bufsize, stats->watermark,
 		stats->underrunCount,
 		stats->overrunCount,
 		stats->instantSampleRate,
-		stats->lastPushSize);
+		stats->lastPushSize,
+		stats->latencyMs);
 	draw2d->SetFontScale(0.7f, 0.7f);
 	draw2d->DrawText(UBUNTU24, statbuf, 11, 31, 0xc0000000, FLAG_DYNAMIC_ASCII);
 	draw2d->DrawText(UBUNTU24, statbuf, 10, 30, 0xFFFFFFFF, FLAG_DYNAMIC_ASCII);
@@ -1343,6 +1359,14 @@ void EmuScreen::renderUI() {
 }
 
 void EmuScreen::autoLoad() {
+	// Instant resume from the boot snapshot, unless a regular auto load is configured
+	// (an explicit slot choice should win over the automatic snapshot.)
+	if (g_Config.bBootSnapshot && g_Config.iAutoLoadSaveState == (int)AutoLoadSaveState::OFF &&
+		SaveState::HasBootSnapshot(gamePath_)) {
+		SaveState::LoadBootSnapshot(gamePath_, &AfterSaveStateAction);
+		return;
+	}
+
 	int autoSlot = -1;
 
 	//check if save state has save, if so, load
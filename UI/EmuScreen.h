@@ -98,6 +98,10 @@ private:
 	AsyncImageFileView *saveStatePreview_;
 	int saveStateSlot_;
 
+	// Automatic boot snapshot capture for instant resume (if enabled.)
+	bool bootSnapshotPending_ = false;
+	double bootSnapshotDueTime_ = 0.0;
+
 	UI::CallbackColorTween *loadingViewColor_ = nullptr;
 	UI::VisibilityTween *loadingViewVisible_ = nullptr;
 	UI::Spinner *loadingSpinner_ = nullptr;
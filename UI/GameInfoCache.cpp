@@ -288,6 +288,11 @@ std::string GameInfo::GetTitle() {
 	return title;
 }
 
+void GameInfo::SetFilePath(const std::string &gamePath) {
+	std::lock_guard<std::mutex> guard(lock);
+	filePath_ = gamePath;
+}
+
 void GameInfo::SetTitle(const std::string &newTitle) {
 	std::lock_guard<std::mutex> guard(lock);
 	title = newTitle;
@@ -332,6 +337,220 @@ static bool ReadVFSToString(const char *filename, std::string *contents, std::mu
 }
 
 
+// On-disk cache of scan results (see DiskCachedGameInfo), so browsing a big
+// collection doesn't re-read PARAM.SFO and ICON0.PNG out of every ISO/PBP.
+// Append-only - when loading, later entries for the same path win.
+static const uint32_t GAME_INFO_CACHE_MAGIC = 0x41434947;  // 'GICA'
+// Version 2: icons are stored as pre-decoded RGBA8888 instead of PNG data.
+static const uint32_t GAME_INFO_CACHE_VERSION = 2;
+// Icons are typically a few tens of KB - anything bigger means a corrupt file.
+static const uint32_t GAME_INFO_CACHE_MAX_BLOB = 4 * 1024 * 1024;
+
+static bool ReadCacheBlob(FILE *f, std::string *str) {
+	uint32_t len;
+	if (fread(&len, sizeof(len), 1, f) != 1 || len > GAME_INFO_CACHE_MAX_BLOB) {
+		return false;
+	}
+	str->resize(len);
+	return len == 0 || fread(&(*str)[0], 1, len, f) == len;
+}
+
+static void WriteCacheBlob(FILE *f, const std::string &str) {
+	uint32_t len = (uint32_t)str.size();
+	fwrite(&len, sizeof(len), 1, f);
+	fwrite(str.data(), 1, len, f);
+}
+
+void GameInfoCache::LoadDiskCache() {
+	diskCacheFile_ = GetSysDirectory(DIRECTORY_APP_CACHE) + "/gameinfo.cache";
+
+	FILE *f = File::OpenCFile(diskCacheFile_, "rb");
+	if (!f) {
+		return;
+	}
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	if (fread(&magic, sizeof(magic), 1, f) != 1 || fread(&version, sizeof(version), 1, f) != 1 ||
+		magic != GAME_INFO_CACHE_MAGIC || version != GAME_INFO_CACHE_VERSION) {
+		fclose(f);
+		// Old or corrupt, start over.
+		File::Delete(diskCacheFile_);
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(diskCacheLock_);
+	while (true) {
+		std::string path;
+		DiskCachedGameInfo entry;
+		if (!ReadCacheBlob(f, &path)) {
+			break;
+		}
+		// A short read here is most likely an interrupted write, just stop.
+		if (fread(&entry.fileSize, sizeof(entry.fileSize), 1, f) != 1 ||
+			fread(&entry.mtime, sizeof(entry.mtime), 1, f) != 1 ||
+			fread(&entry.fileType, sizeof(entry.fileType), 1, f) != 1 ||
+			fread(&entry.region, sizeof(entry.region), 1, f) != 1 ||
+			fread(&entry.disc_total, sizeof(entry.disc_total), 1, f) != 1 ||
+			fread(&entry.disc_number, sizeof(entry.disc_number), 1, f) != 1 ||
+			fread(&entry.iconWidth, sizeof(entry.iconWidth), 1, f) != 1 ||
+			fread(&entry.iconHeight, sizeof(entry.iconHeight), 1, f) != 1) {
+			break;
+		}
+		if (!ReadCacheBlob(f, &entry.id) || !ReadCacheBlob(f, &entry.id_version) ||
+			!ReadCacheBlob(f, &entry.title) || !ReadCacheBlob(f, &entry.iconData)) {
+			break;
+		}
+		if (entry.iconData.size() != (size_t)entry.iconWidth * entry.iconHeight * 4) {
+			// Corrupt pixel data, drop this entry.
+			continue;
+		}
+		diskCache_[path] = std::move(entry);
+	}
+	fclose(f);
+
+	INFO_LOG(SYSTEM, "Game info cache: loaded %d entries", (int)diskCache_.size());
+}
+
+bool GameInfoCache::FillFromDiskCache(const std::string &gamePath, std::shared_ptr<GameInfo> &info) {
+	DiskCachedGameInfo entry;
+	{
+		std::lock_guard<std::mutex> guard(diskCacheLock_);
+		auto iter = diskCache_.find(gamePath);
+		if (iter == diskCache_.end()) {
+			return false;
+		}
+		entry = iter->second;
+	}
+
+	File::FileDetails details;
+	if (!File::GetFileDetails(gamePath, &details) || details.isDirectory ||
+		details.size != entry.fileSize || details.mtime != entry.mtime) {
+		// Changed or gone - drop the entry and rescan through the normal path.
+		std::lock_guard<std::mutex> guard(diskCacheLock_);
+		diskCache_.erase(gamePath);
+		return false;
+	}
+
+	// Note: info is freshly created here and not visible to any other thread yet.
+	info->SetFilePath(gamePath);
+	info->SetTitle(entry.title);
+	info->fileType = (IdentifiedFileType)entry.fileType;
+	info->id = entry.id;
+	info->id_version = entry.id_version;
+	info->region = entry.region;
+	info->disc_total = entry.disc_total;
+	info->disc_number = entry.disc_number;
+	info->paramSFOLoaded = true;
+	info->hasConfig = g_Config.hasGameConfig(info->id);
+	info->icon.rgbaData = std::move(entry.iconData);
+	info->icon.rgbaWidth = entry.iconWidth;
+	info->icon.rgbaHeight = entry.iconHeight;
+	info->icon.dataLoaded = true;
+	info->pending = false;
+	return true;
+}
+
+void GameInfoCache::SaveToDiskCache(const std::string &gamePath, GameInfo *info) {
+	// Only single-file game types are cached - directory mtimes aren't a
+	// reliable change signal, and savestates/archives are cheap to rescan.
+	switch (info->fileType) {
+	case IdentifiedFileType::PSP_ISO:
+	case IdentifiedFileType::PSP_ISO_NP:
+	case IdentifiedFileType::PSP_PBP:
+		break;
+	default:
+		return;
+	}
+	if (info->id.empty() || !info->icon.dataLoaded) {
+		return;
+	}
+	{
+		// Only decoded icons are cached - a failed decode would decode again
+		// (and fail again) every startup anyway.
+		std::lock_guard<std::mutex> guard(info->lock);
+		if (info->icon.rgbaData.empty()) {
+			return;
+		}
+	}
+
+	File::FileDetails details;
+	if (!File::GetFileDetails(gamePath, &details) || details.isDirectory) {
+		return;
+	}
+
+	DiskCachedGameInfo entry;
+	entry.fileSize = details.size;
+	entry.mtime = details.mtime;
+	entry.fileType = (int)info->fileType;
+	{
+		std::lock_guard<std::mutex> guard(info->lock);
+		entry.region = info->region;
+		entry.disc_total = info->disc_total;
+		entry.disc_number = info->disc_number;
+		entry.id = info->id;
+		entry.id_version = info->id_version;
+		entry.iconWidth = info->icon.rgbaWidth;
+		entry.iconHeight = info->icon.rgbaHeight;
+		entry.iconData = info->icon.rgbaData;
+	}
+	entry.title = info->GetTitle();
+
+	std::lock_guard<std::mutex> guard(diskCacheLock_);
+	auto iter = diskCache_.find(gamePath);
+	if (iter != diskCache_.end() && iter->second.fileSize == entry.fileSize && iter->second.mtime == entry.mtime) {
+		// Already up to date, don't grow the file.
+		return;
+	}
+
+	bool writeHeader = !File::Exists(diskCacheFile_);
+	FILE *f = File::OpenCFile(diskCacheFile_, "ab");
+	if (!f) {
+		return;
+	}
+	if (writeHeader) {
+		fwrite(&GAME_INFO_CACHE_MAGIC, sizeof(GAME_INFO_CACHE_MAGIC), 1, f);
+		fwrite(&GAME_INFO_CACHE_VERSION, sizeof(GAME_INFO_CACHE_VERSION), 1, f);
+	}
+	WriteCacheBlob(f, gamePath);
+	fwrite(&entry.fileSize, sizeof(entry.fileSize), 1, f);
+	fwrite(&entry.mtime, sizeof(entry.mtime), 1, f);
+	fwrite(&entry.fileType, sizeof(entry.fileType), 1, f);
+	fwrite(&entry.region, sizeof(entry.region), 1, f);
+	fwrite(&entry.disc_total, sizeof(entry.disc_total), 1, f);
+	fwrite(&entry.disc_number, sizeof(entry.disc_number), 1, f);
+	fwrite(&entry.iconWidth, sizeof(entry.iconWidth), 1, f);
+	fwrite(&entry.iconHeight, sizeof(entry.iconHeight), 1, f);
+	WriteCacheBlob(f, entry.id);
+	WriteCacheBlob(f, entry.id_version);
+	WriteCacheBlob(f, entry.title);
+	WriteCacheBlob(f, entry.iconData);
+	fclose(f);
+
+	diskCache_[gamePath] = std::move(entry);
+}
+
+// Decodes an image that was read by the scan, on the scan thread, so the UI
+// thread only has to upload the pixels.
+static void DecodeTexture(GameInfoTex &tex, std::mutex &mtx) {
+	std::string data;
+	{
+		std::lock_guard<std::mutex> guard(mtx);
+		if (!tex.dataLoaded || tex.data.empty() || !tex.rgbaData.empty()) {
+			return;
+		}
+		data = tex.data;
+	}
+
+	std::string rgba;
+	int width, height;
+	if (DecodeImageDataRGBA8888((const uint8_t *)data.data(), data.size(), &rgba, &width, &height)) {
+		std::lock_guard<std::mutex> guard(mtx);
+		tex.rgbaData = std::move(rgba);
+		tex.rgbaWidth = width;
+		tex.rgbaHeight = height;
+	}
+}
+
 class GameInfoWorkItem : public PrioritizedWorkQueueItem {
 public:
 	GameInfoWorkItem(const std::string &gamePath, std::shared_ptr<GameInfo> &info)
@@ -623,6 +842,16 @@ handleELF:
 
 		info_->hasConfig = g_Config.hasGameConfig(info_->id);
 
+		// Decode images here, where we can afford to block. Icon first - it
+		// shouldn't have to wait for the much larger PIC1 background.
+		DecodeTexture(info_->icon, info_->lock);
+		DecodeTexture(info_->pic0, info_->lock);
+		DecodeTexture(info_->pic1, info_->lock);
+
+		// Cache right after decoding, before the UI thread consumes the pixels.
+		if (g_gameInfoCache)
+			g_gameInfoCache->SaveToDiskCache(gamePath_, info_.get());
+
 		if (info_->wantFlags & GAMEINFO_WANTSIZE) {
 			std::lock_guard<std::mutex> lock(info_->lock);
 			info_->gameSize = info_->GetGameSizeInBytes();
@@ -660,6 +889,7 @@ GameInfoCache::~GameInfoCache() {
 }
 
 void GameInfoCache::Init() {
+	LoadDiskCache();
 	gameInfoWQ_ = new PrioritizedWorkQueue();
 	ProcessWorkQueueOnThreadWhile(gameInfoWQ_);
 }
@@ -758,6 +988,14 @@ std::shared_ptr<GameInfo> GameInfoCache::GetInfo(Draw::DrawContext *draw, const
 
 	if (!info) {
 		info = std::make_shared<GameInfo>();
+
+		// For plain grid-view lookups, known unchanged files can be filled
+		// from the disk cache without queueing a scan of the ISO.
+		if (wantFlags == 0 && FillFromDiskCache(gamePath, info)) {
+			info->lastAccessedTime = time_now_d();
+			info_[gamePath] = info;
+			return info;
+		}
 	}
 
 	if (info->working) {
@@ -784,7 +1022,38 @@ std::shared_ptr<GameInfo> GameInfoCache::GetInfo(Draw::DrawContext *draw, const
 
 void GameInfoCache::SetupTexture(std::shared_ptr<GameInfo> &info, Draw::DrawContext *thin3d, GameInfoTex &tex) {
 	using namespace Draw;
-	if (tex.data.size()) {
+
+	// Prefer pixels that were already decoded on the scan thread (or came from
+	// the disk cache) - then this is just an upload.
+	std::string rgba;
+	int rgbaWidth = 0, rgbaHeight = 0;
+	{
+		std::lock_guard<std::mutex> guard(info->lock);
+		if (!tex.rgbaData.empty()) {
+			rgba = std::move(tex.rgbaData);
+			rgbaWidth = tex.rgbaWidth;
+			rgbaHeight = tex.rgbaHeight;
+			tex.rgbaData.clear();
+		}
+	}
+
+	if (!rgba.empty()) {
+		if (!tex.texture) {
+			tex.texture = CreateTextureFromRGBA8888(thin3d, (const uint8_t *)rgba.data(), rgbaWidth, rgbaHeight);
+			if (tex.texture) {
+				tex.timeLoaded = time_now_d();
+			} else {
+				ERROR_LOG(G3D, "Failed creating texture (%s)", info->GetTitle().c_str());
+			}
+		}
+		if ((info->wantFlags & GAMEINFO_WANTBGDATA) == 0) {
+			tex.data.clear();
+			tex.dataLoaded = false;
+		}
+	} else if (tex.data.size() && !info->pending) {
+		// Fallback for images the scan couldn't decode to plain RGBA (compressed
+		// ZIMs), and for anything loaded before the decode pass existed. While the
+		// scan is still pending we wait for its decode instead of doing it here.
 		if (!tex.texture) {
 			tex.texture = CreateTextureFromFileData(thin3d, (const uint8_t *)tex.data.data(), (int)tex.data.size(), ImageFileType::DETECT);
 			if (tex.texture) {
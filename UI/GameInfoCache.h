@@ -68,6 +68,11 @@ struct GameInfoTex {
 		}
 	}
 	std::string data;
+	// Pre-decoded RGBA8888 pixels, produced on the scan thread (or loaded from
+	// the disk cache) so the UI thread only has to upload them.
+	std::string rgbaData;
+	int rgbaWidth = 0;
+	int rgbaHeight = 0;
 	std::unique_ptr<ManagedTexture> texture;
 	// The time at which the Icon and the BG were loaded.
 	// Can be useful to fade them in smoothly once they appear.
@@ -75,8 +80,11 @@ struct GameInfoTex {
 	std::atomic<bool> dataLoaded{};
 
 	void Clear() {
-		if (!data.empty()) {
+		if (!data.empty() || !rgbaData.empty()) {
 			data.clear();
+			rgbaData.clear();
+			rgbaWidth = 0;
+			rgbaHeight = 0;
 			dataLoaded = false;
 		}
 		texture.reset(nullptr);
@@ -108,6 +116,10 @@ public:
 	std::string GetTitle();
 	void SetTitle(const std::string &newTitle);
 
+	// Sets the path without constructing a file loader, for when the info comes
+	// from the disk cache and no file access is needed.
+	void SetFilePath(const std::string &gamePath);
+
 	// Hold this when reading or writing from the GameInfo.
 	// Don't need to hold it when just passing around the pointer,
 	// and obviously also not when creating it and holding the only pointer
@@ -154,6 +166,24 @@ private:
 	DISALLOW_COPY_AND_ASSIGN(GameInfo);
 };
 
+// A scan result persisted to disk, so known games show up in the grid without
+// re-reading their ISO/PBP. Validated against file size and mtime.
+struct DiskCachedGameInfo {
+	u64 fileSize = 0;
+	u64 mtime = 0;
+	int fileType = 0;
+	int region = -1;
+	int disc_total = 0;
+	int disc_number = 0;
+	std::string id;
+	std::string id_version;
+	std::string title;
+	// Pre-decoded RGBA8888 icon pixels, ready for upload without a PNG decode.
+	int iconWidth = 0;
+	int iconHeight = 0;
+	std::string iconData;
+};
+
 class GameInfoCache {
 public:
 	GameInfoCache();
@@ -175,17 +205,30 @@ public:
 	void CancelAll();
 	void WaitUntilDone(std::shared_ptr<GameInfo> &info);
 
+	// Called from the work queue thread when a scan finishes.
+	void SaveToDiskCache(const std::string &gamePath, GameInfo *info);
+
 private:
 	void Init();
 	void Shutdown();
 	void SetupTexture(std::shared_ptr<GameInfo> &info, Draw::DrawContext *draw, GameInfoTex &tex);
 
-	// Maps ISO path to info. Need to use shared_ptr as we can return these pointers - 
+	void LoadDiskCache();
+	bool FillFromDiskCache(const std::string &gamePath, std::shared_ptr<GameInfo> &info);
+
+	// Maps ISO path to info. Need to use shared_ptr as we can return these pointers -
 	// and if they get destructed while being in use, that's bad.
 	std::map<std::string, std::shared_ptr<GameInfo> > info_;
 
 	// Work queue and management
 	PrioritizedWorkQueue *gameInfoWQ_;
+
+	// Persisted scan results, see DiskCachedGameInfo. The lock covers the map
+	// and appends to the cache file (the work queue thread writes, the main
+	// thread reads).
+	std::mutex diskCacheLock_;
+	std::map<std::string, DiskCachedGameInfo> diskCache_;
+	std::string diskCacheFile_;
 };
 
 // This one can be global, no good reason not to.
@@ -273,6 +273,7 @@ void GameSettingsScreen::CreateViews() {
 	static const char *frameSkipType[] = {"Number of Frames", "Percent of FPS"};
 	graphicsSettings->Add(new PopupMultiChoice(&g_Config.iFrameSkipType, gr->T("Frame Skipping Type"), frameSkipType, 0, ARRAY_SIZE(frameSkipType), gr->GetName(), screenManager()));
 	frameSkipAuto_ = graphicsSettings->Add(new CheckBox(&g_Config.bAutoFrameSkip, gr->T("Auto FrameSkip")));
+	graphicsSettings->Add(new CheckBox(&g_Config.bStaticFrameSkip, gr->T("Skip redrawing static scenes", "Skip redrawing static scenes (battery saver)")));
 	frameSkipAuto_->OnClick.Handle(this, &GameSettingsScreen::OnAutoFrameskip);
 
 	PopupSliderChoice *altSpeed1 = graphicsSettings->Add(new PopupSliderChoice(&iAlternateSpeedPercent1_, 0, 1000, gr->T("Alternative Speed", "Alternative speed"), 5, screenManager(), gr->T("%, 0:unlimited")));
@@ -325,6 +326,9 @@ void GameSettingsScreen::CreateViews() {
 	resolutionEnable_ = !g_Config.bSoftwareRendering && (g_Config.iRenderingMode != FB_NON_BUFFERED_MODE);
 	resolutionChoice_->SetEnabledPtr(&resolutionEnable_);
 
+	CheckBox *dynamicResolution = graphicsSettings->Add(new CheckBox(&g_Config.bDynamicResolution, gr->T("Dynamic Resolution", "Dynamic resolution (reduce to hold speed)")));
+	dynamicResolution->SetEnabledPtr(&resolutionEnable_);
+
 #ifdef __ANDROID__
 	if (System_GetPropertyInt(SYSPROP_DEVICE_TYPE) != DEVICE_TYPE_TV) {
 		static const char *deviceResolutions[] = { "Native device resolution", "Auto (same as Rendering)", "1x PSP", "2x PSP", "3x PSP", "4x PSP", "5x PSP" };
@@ -339,6 +343,12 @@ void GameSettingsScreen::CreateViews() {
 
 #ifdef _WIN32
 	graphicsSettings->Add(new CheckBox(&g_Config.bVSync, gr->T("VSync")));
+#elif PPSSPP_PLATFORM(ANDROID)
+	// On Android, this only has an effect with the Vulkan backend (present mode
+	// selection). Takes effect on restart.
+	if (g_Config.iGPUBackend == (int)GPUBackend::VULKAN) {
+		graphicsSettings->Add(new CheckBox(&g_Config.bVSync, gr->T("VSync")));
+	}
 #endif
 
 	CheckBox *hwTransform = graphicsSettings->Add(new CheckBox(&g_Config.bHardwareTransform, gr->T("Hardware Transform")));
@@ -443,6 +453,13 @@ void GameSettingsScreen::CreateViews() {
 	static const char *texFilters[] = { "Auto", "Nearest", "Linear", "Linear on FMV", };
 	graphicsSettings->Add(new PopupMultiChoice(&g_Config.iTexFiltering, gr->T("Texture Filter"), texFilters, 1, ARRAY_SIZE(texFilters), gr->GetName(), screenManager()));
 
+	CheckBox *genMipmaps = graphicsSettings->Add(new CheckBox(&g_Config.bGenerateMipmaps, gr->T("Auto-generate mipmaps")));
+	genMipmaps->OnClick.Add([=](EventParams &e) {
+		settingInfo_->Show(gr->T("GenerateMipmaps Tip", "Builds missing mipmaps on the GPU, reducing shimmer at high rendering resolutions"), e.v);
+		return UI::EVENT_CONTINUE;
+	});
+	genMipmaps->SetDisabledPtr(&g_Config.bSoftwareRendering);
+
 	static const char *bufFilters[] = { "Linear", "Nearest", };
 	graphicsSettings->Add(new PopupMultiChoice(&g_Config.iBufFilter, gr->T("Screen Scaling Filter"), bufFilters, 1, ARRAY_SIZE(bufFilters), gr->GetName(), screenManager()));
 
@@ -513,6 +530,8 @@ void GameSettingsScreen::CreateViews() {
 		CheckBox *resampling = audioSettings->Add(new CheckBox(&g_Config.bAudioResampler, a->T("Audio sync", "Audio sync (resampling)")));
 		resampling->SetEnabledPtr(&g_Config.bEnableSound);
 	}
+	CheckBox *resamplingHQ = audioSettings->Add(new CheckBox(&g_Config.bAudioResamplerHQ, a->T("High quality resampling", "High quality resampling (FIR)")));
+	resamplingHQ->SetEnabledPtr(&g_Config.bEnableSound);
 
 	audioSettings->Add(new ItemHeader(a->T("Audio hacks")));
 	audioSettings->Add(new CheckBox(&g_Config.bSoundSpeedHack, a->T("Sound speed hack (DOA etc.)")));
@@ -526,6 +545,7 @@ void GameSettingsScreen::CreateViews() {
 	tabHolder->AddTab(ms->T("Controls"), controlsSettingsScroll);
 	controlsSettings->Add(new ItemHeader(ms->T("Controls")));
 	controlsSettings->Add(new Choice(co->T("Control Mapping")))->OnClick.Handle(this, &GameSettingsScreen::OnControlMapping);
+	controlsSettings->Add(new CheckBox(&g_Config.bLowLatencyInput, co->T("Low latency input (reduces input lag)")));
 
 #if defined(USING_WIN_UI)
 	controlsSettings->Add(new CheckBox(&g_Config.bGamepadOnlyFocused, co->T("Ignore gamepads when not focused")));
@@ -693,6 +713,7 @@ void GameSettingsScreen::CreateViews() {
 	systemSettings->Add(new CheckBox(&g_Config.bForceLagSync, sy->T("Force real clock sync (slower, less lag)")));
 	PopupSliderChoice *lockedMhz = systemSettings->Add(new PopupSliderChoice(&g_Config.iLockedCPUSpeed, 0, 1000, sy->T("Change CPU Clock", "Change CPU Clock (unstable)"), screenManager(), sy->T("MHz, 0:default")));
 	lockedMhz->SetZeroLabel(sy->T("Auto"));
+	systemSettings->Add(new CheckBox(&g_Config.bAdaptiveCPUSpeed, sy->T("Adaptive CPU Clock", "Adaptive CPU Clock (underclock while idle)")));
 	PopupSliderChoice *rewindFreq = systemSettings->Add(new PopupSliderChoice(&g_Config.iRewindFlipFrequency, 0, 1800, sy->T("Rewind Snapshot Frequency", "Rewind Snapshot Frequency (mem hog)"), screenManager(), sy->T("frames, 0:off")));
 	rewindFreq->SetZeroLabel(sy->T("Off"));
 
@@ -733,6 +754,7 @@ void GameSettingsScreen::CreateViews() {
 	systemSettings->Add(new CheckBox(&g_Config.bEnableStateUndo, sy->T("Savestate slot backups")));
 	static const char *autoLoadSaveStateChoices[] = { "Off", "Oldest Save", "Newest Save", "Slot 1", "Slot 2", "Slot 3", "Slot 4", "Slot 5" };
 	systemSettings->Add(new PopupMultiChoice(&g_Config.iAutoLoadSaveState, sy->T("Auto Load Savestate"), autoLoadSaveStateChoices, 0, ARRAY_SIZE(autoLoadSaveStateChoices), sy->GetName(), screenManager()));
+	systemSettings->Add(new CheckBox(&g_Config.bBootSnapshot, sy->T("Instant resume", "Instant resume (boot snapshot)")));
 #if defined(USING_WIN_UI)
 	systemSettings->Add(new CheckBox(&g_Config.bBypassOSKWithKeyboard, sy->T("Enable Windows native keyboard", "Enable Windows native keyboard")));
 #endif
@@ -138,6 +138,28 @@ bool ManagedTexture::LoadFromFileData(const uint8_t *data, size_t dataSize, Imag
 	return texture_;
 }
 
+bool ManagedTexture::LoadFromRGBA8888(const uint8_t *data, int width, int height) {
+	using namespace Draw;
+
+	// Free the old texture, if any.
+	if (texture_) {
+		delete texture_;
+		texture_ = nullptr;
+	}
+
+	TextureDesc desc{};
+	desc.type = TextureType::LINEAR2D;
+	desc.format = DataFormat::R8G8B8A8_UNORM;
+	desc.width = width;
+	desc.height = height;
+	desc.depth = 1;
+	desc.mipLevels = 1;
+	desc.tag = "RGBA8888";
+	desc.initData.push_back(const_cast<uint8_t *>(data));
+	texture_ = draw_->CreateTexture(desc);
+	return texture_ != nullptr;
+}
+
 bool ManagedTexture::LoadFromFile(const std::string &filename, ImageFileType type, bool generateMips) {
 	generateMips_ = generateMips;
 	size_t fileSize;
@@ -196,6 +218,44 @@ Draw::Texture *ManagedTexture::GetTexture() {
 	return texture_;
 }
 
+std::unique_ptr<ManagedTexture> CreateTextureFromRGBA8888(Draw::DrawContext *draw, const uint8_t *data, int width, int height) {
+	if (!draw || !data || width <= 0 || height <= 0)
+		return std::unique_ptr<ManagedTexture>();
+	ManagedTexture *mtex = new ManagedTexture(draw);
+	if (mtex->LoadFromRGBA8888(data, width, height)) {
+		return std::unique_ptr<ManagedTexture>(mtex);
+	} else {
+		delete mtex;
+		return std::unique_ptr<ManagedTexture>();
+	}
+}
+
+bool DecodeImageDataRGBA8888(const uint8_t *data, size_t size, std::string *rgba, int *width, int *height) {
+	int widths[16]{}, heights[16]{};
+	uint8_t *image[16]{};
+
+	int num_levels = 0;
+	int zim_flags = 0;
+	Draw::DataFormat fmt;
+	if (!LoadTextureLevels(data, size, ImageFileType::DETECT, widths, heights, &num_levels, &fmt, image, &zim_flags)) {
+		return false;
+	}
+
+	// Compressed ZIMs can't be represented as plain RGBA - let the caller fall
+	// back to creating the texture directly from the file data.
+	bool result = fmt == Draw::DataFormat::R8G8B8A8_UNORM && image[0] != nullptr;
+	if (result) {
+		rgba->assign((const char *)image[0], (size_t)widths[0] * heights[0] * 4);
+		*width = widths[0];
+		*height = heights[0];
+	}
+	for (int i = 0; i < num_levels; i++) {
+		if (image[i])
+			free(image[i]);
+	}
+	return result;
+}
+
 // TODO: Remove the code duplication between this and LoadFromFileData
 std::unique_ptr<ManagedTexture> CreateTextureFromFileData(Draw::DrawContext *draw, const uint8_t *data, int size, ImageFileType type, bool generateMips) {
 	if (!draw)
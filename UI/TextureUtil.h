@@ -23,6 +23,7 @@ public:
 
 	bool LoadFromFile(const std::string &filename, ImageFileType type = ImageFileType::DETECT, bool generateMips = false);
 	bool LoadFromFileData(const uint8_t *data, size_t dataSize, ImageFileType type = ImageFileType::DETECT, bool generateMips = false);
+	bool LoadFromRGBA8888(const uint8_t *data, int width, int height);
 	Draw::Texture *GetTexture();  // For immediate use, don't store.
 	int Width() const { return texture_->Width(); }
 	int Height() const { return texture_->Height(); }
@@ -39,4 +40,9 @@ private:
 };
 
 std::unique_ptr<ManagedTexture> CreateTextureFromFile(Draw::DrawContext *draw, const char *filename, ImageFileType fileType, bool generateMips = false);
-std::unique_ptr<ManagedTexture> CreateTextureFromFileData(Draw::DrawContext *draw, const uint8_t *data, int size, ImageFileType fileType, bool generateMips = false);
\ No newline at end of file
+std::unique_ptr<ManagedTexture> CreateTextureFromFileData(Draw::DrawContext *draw, const uint8_t *data, int size, ImageFileType fileType, bool generateMips = false);
+std::unique_ptr<ManagedTexture> CreateTextureFromRGBA8888(Draw::DrawContext *draw, const uint8_t *data, int width, int height);
+
+// Decodes PNG/JPEG data to a single RGBA8888 level without touching the GPU,
+// so image decoding can happen on a background thread.
+bool DecodeImageDataRGBA8888(const uint8_t *data, size_t size, std::string *rgba, int *width, int *height);
\ No newline at end of file
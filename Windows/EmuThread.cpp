@@ -69,6 +69,7 @@ bool MainThread_Ready() {
 
 static void EmuThreadFunc(GraphicsContext *graphicsContext) {
 	setCurrentThreadName("Emu");
+	setCurrentThreadAffinityClass(THREAD_AFFINITY_PERFORMANCE);
 
 	// There's no real requirement that NativeInit happen on this thread.
 	// We just call the update/render loop here.
@@ -115,6 +116,7 @@ void MainThreadFunc() {
 		// This is both Emu and Render.
 		setCurrentThreadName("Emu");
 	}
+	setCurrentThreadAffinityClass(THREAD_AFFINITY_PERFORMANCE);
 
 	host = new WindowsHost(MainWindow::GetHInstance(), MainWindow::GetHWND(), MainWindow::GetDisplayHWND());
 	host->SetWindowTitle(nullptr);
@@ -98,7 +98,9 @@ bool AndroidVulkanContext::InitAPI() {
 	VulkanContext::CreateInfo info{};
 	info.app_name = "PPSSPP";
 	info.app_ver = gitVer.ToInteger();
-	info.flags = VULKAN_FLAG_PRESENT_MAILBOX | VULKAN_FLAG_PRESENT_FIFO_RELAXED;
+	// With VSync on (the default), FIFO it is. Otherwise ask for mailbox, which
+	// InitSwapchain will only use where actually supported.
+	info.flags = g_Config.bVSync ? 0 : VULKAN_FLAG_PRESENT_MAILBOX;
 	VkResult res = g_Vulkan->CreateInstance(info);
 	if (res != VK_SUCCESS) {
 		ELOG("Failed to create vulkan context: %s", g_Vulkan->InitError().c_str());
@@ -172,6 +172,7 @@ static void EmuThreadFunc() {
 	gJvm->AttachCurrentThread(&env, nullptr);
 
 	setCurrentThreadName("Emu");
+	setCurrentThreadAffinityClass(THREAD_AFFINITY_PERFORMANCE);
 	ILOG("Entering emu thread");
 
 	// Wait for render loop to get started.
@@ -666,6 +667,7 @@ extern "C" void Java_org_ppsspp_ppsspp_NativeRenderer_displayRender(JNIEnv *env,
 	if (!hasSetThreadName) {
 		hasSetThreadName = true;
 		setCurrentThreadName("AndroidRender");
+		setCurrentThreadAffinityClass(THREAD_AFFINITY_PERFORMANCE);
 	}
 	
 	if (useCPUThread) {
@@ -991,6 +993,7 @@ retry:
 		if (!hasSetThreadName) {
 			hasSetThreadName = true;
 			setCurrentThreadName("AndroidRender");
+			setCurrentThreadAffinityClass(THREAD_AFFINITY_PERFORMANCE);
 		}
 	}
 
@@ -148,21 +148,47 @@ static std::string EscapeComments(const std::string &value) {
 	return result;
 }
 
+static std::string LowerKey(const char *key) {
+	std::string lowered = key;
+	for (size_t i = 0; i < lowered.size(); i++) {
+		if (lowered[i] >= 'A' && lowered[i] <= 'Z')
+			lowered[i] += 'a' - 'A';
+	}
+	return lowered;
+}
+
 void IniFile::Section::Clear() {
 	lines.clear();
+	keyIndex_.clear();
+	indexValid_ = false;
 }
 
-std::string* IniFile::Section::GetLine(const char* key, std::string* valueOut, std::string* commentOut)
+void IniFile::Section::BuildIndex() const
 {
-	for (std::vector<std::string>::iterator iter = lines.begin(); iter != lines.end(); ++iter)
+	keyIndex_.clear();
+	for (size_t i = 0; i < lines.size(); i++)
 	{
-		std::string& line = *iter;
-		std::string lineKey;
-		ParseLine(line, &lineKey, valueOut, commentOut);
-		if (!strcasecmp(lineKey.c_str(), key))
-			return &line;
+		std::string key;
+		if (ParseLine(lines[i], &key, NULL, NULL) && !key.empty())
+		{
+			// First occurrence wins, same as the old linear scan.
+			keyIndex_.insert(std::make_pair(LowerKey(key.c_str()), i));
+		}
 	}
-	return 0;
+	indexValid_ = true;
+}
+
+std::string* IniFile::Section::GetLine(const char* key, std::string* valueOut, std::string* commentOut)
+{
+	if (!indexValid_)
+		BuildIndex();
+	std::map<std::string, size_t>::const_iterator iter = keyIndex_.find(LowerKey(key));
+	if (iter == keyIndex_.end())
+		return 0;
+	std::string& line = lines[iter->second];
+	std::string lineKey;
+	ParseLine(line, &lineKey, valueOut, commentOut);
+	return &line;
 }
 
 void IniFile::Section::Set(const char* key, const char* newValue)
@@ -171,13 +197,16 @@ void IniFile::Section::Set(const char* key, const char* newValue)
 	std::string* line = GetLine(key, &value, &commented);
 	if (line)
 	{
-		// Change the value - keep the key and comment
+		// Change the value - keep the key and comment. The line keeps its
+		// position and key, so the index stays valid.
 		*line = StripSpaces(key) + " = " + EscapeComments(newValue) + commented;
 	}
 	else
 	{
 		// The key did not already exist in this section - let's add it.
 		lines.push_back(std::string(key) + " = " + EscapeComments(newValue));
+		if (indexValid_)
+			keyIndex_.insert(std::make_pair(LowerKey(key), lines.size() - 1));
 	}
 }
 
@@ -322,14 +351,9 @@ bool IniFile::Section::Get(const char* key, double* value, double defaultValue)
 
 bool IniFile::Section::Exists(const char *key) const
 {
-	for (std::vector<std::string>::const_iterator iter = lines.begin(); iter != lines.end(); ++iter)
-	{
-		std::string lineKey;
-		ParseLine(*iter, &lineKey, NULL, NULL);
-		if (!strcasecmp(lineKey.c_str(), key))
-			return true;
-	}
-	return false;
+	if (!indexValid_)
+		BuildIndex();
+	return keyIndex_.find(LowerKey(key)) != keyIndex_.end();
 }
 
 std::map<std::string, std::string> IniFile::Section::ToMap() const
@@ -354,6 +378,8 @@ bool IniFile::Section::Delete(const char *key)
 		if (line == &*liter)
 		{
 			lines.erase(liter);
+			// Line indices after the erased one shifted.
+			InvalidateIndex();
 			return true;
 		}
 	}
@@ -416,7 +442,7 @@ bool IniFile::Exists(const char* sectionName, const char* key) const
 void IniFile::SetLines(const char* sectionName, const std::vector<std::string> &lines)
 {
 	Section* section = GetOrCreateSection(sectionName);
-	section->lines.clear();
+	section->Clear();
 	for (std::vector<std::string>::const_iterator iter = lines.begin(); iter != lines.end(); ++iter)
 	{
 		section->lines.push_back(*iter);
@@ -434,6 +460,7 @@ bool IniFile::DeleteKey(const char* sectionName, const char* key)
 		if (line == &(*liter))
 		{
 			section->lines.erase(liter);
+			section->InvalidateIndex();
 			return true;
 		}
 	}
@@ -117,9 +117,19 @@ public:
 		}
 
 	protected:
+		// Key lookups go through a lazily built key -> line index, so repeated
+		// Gets (Config::Load resolves hundreds of settings against the same
+		// sections) don't re-parse every line each time. Mutations that keep
+		// line positions stable update it; anything else just invalidates it.
+		void BuildIndex() const;
+		void InvalidateIndex() { indexValid_ = false; }
+
 		std::vector<std::string> lines;
 		std::string name_;
 		std::string comment;
+
+		mutable std::map<std::string, size_t> keyIndex_;  // lowercased key -> index into lines
+		mutable bool indexValid_ = false;
 	};
 
 	bool Load(const char* filename);
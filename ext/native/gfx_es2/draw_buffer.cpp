@@ -17,6 +17,8 @@
 enum {
 	// Enough?
 	MAX_VERTS = 65536,
+	MAX_QUADS = MAX_VERTS / 4,
+	MAX_INDICES = MAX_QUADS * 6,
 };
 
 DrawBuffer::DrawBuffer() : count_(0), atlas(0) {
@@ -41,8 +43,22 @@ void DrawBuffer::Init(Draw::DrawContext *t3d, Draw::Pipeline *pipeline) {
 
 	if (pipeline->RequiresBuffer()) {
 		vbuf_ = draw_->CreateBuffer(MAX_VERTS * sizeof(Vertex), BufferUsageFlag::DYNAMIC | BufferUsageFlag::VERTEXDATA);
+		// The index pattern that turns quads into triangles never changes, so
+		// fill it once here and reuse it for every flush.
+		ibuf_ = draw_->CreateBuffer(MAX_INDICES * sizeof(uint32_t), BufferUsageFlag::DYNAMIC | BufferUsageFlag::INDEXDATA);
+		std::vector<uint32_t> indices(MAX_INDICES);
+		for (int i = 0; i < MAX_QUADS; i++) {
+			indices[i * 6 + 0] = i * 4 + 0;
+			indices[i * 6 + 1] = i * 4 + 1;
+			indices[i * 6 + 2] = i * 4 + 2;
+			indices[i * 6 + 3] = i * 4 + 0;
+			indices[i * 6 + 4] = i * 4 + 2;
+			indices[i * 6 + 5] = i * 4 + 3;
+		}
+		draw_->UpdateBuffer(ibuf_, (const uint8_t *)indices.data(), 0, MAX_INDICES * sizeof(uint32_t), Draw::UPDATE_DISCARD);
 	} else {
 		vbuf_ = nullptr;
+		ibuf_ = nullptr;
 	}
 }
 
@@ -67,6 +83,10 @@ void DrawBuffer::Shutdown() {
 		vbuf_->Release();
 		vbuf_ = nullptr;
 	}
+	if (ibuf_) {
+		ibuf_->Release();
+		ibuf_ = nullptr;
+	}
 	inited_ = false;
 	alphaStack_.clear();
 	drawMatrixStack_.clear();
@@ -94,13 +114,29 @@ void DrawBuffer::Flush(bool set_blend_state) {
 	VsTexColUB ub{};
 	memcpy(ub.WorldViewProj, drawMatrix_.getReadPtr(), sizeof(Matrix4x4));
 	draw_->UpdateDynamicUniformBuffer(&ub, sizeof(ub));
+	// Vertices are added four per quad, see V().
+	const int numIndices = count_ / 4 * 6;
 	if (vbuf_) {
 		draw_->UpdateBuffer(vbuf_, (const uint8_t *)verts_, 0, sizeof(Vertex) * count_, Draw::UPDATE_DISCARD);
 		draw_->BindVertexBuffers(0, 1, &vbuf_, nullptr);
-		int offset = 0;
-		draw_->Draw(count_, offset);
+		draw_->BindIndexBuffer(ibuf_, 0);
+		draw_->DrawIndexed(numIndices, 0);
 	} else {
-		draw_->DrawUP((const void *)verts_, count_);
+		// No buffer objects here means no index buffer either, so expand the
+		// quads into the plain triangle list DrawUP wants.
+		expanded_.resize(numIndices);
+		Vertex *e = expanded_.data();
+		for (int i = 0; i < count_; i += 4) {
+			const Vertex *q = &verts_[i];
+			e[0] = q[0];
+			e[1] = q[1];
+			e[2] = q[2];
+			e[3] = q[0];
+			e[4] = q[2];
+			e[5] = q[3];
+			e += 6;
+		}
+		draw_->DrawUP((const void *)expanded_.data(), numIndices);
 	}
 	count_ = 0;
 }
@@ -141,8 +177,6 @@ void DrawBuffer::RectVGradient(float x, float y, float w, float h, uint32_t colo
 	V(x,		 y,     0, colorTop,    0, 0);
 	V(x + w, y,		 0, colorTop,    1, 0);
 	V(x + w, y + h, 0, colorBottom, 1, 1);
-	V(x,		 y,     0, colorTop,    0, 0);
-	V(x + w, y + h, 0, colorBottom, 1, 1);
 	V(x,		 y + h, 0, colorBottom, 0, 1);
 }
 
@@ -168,8 +202,6 @@ void DrawBuffer::Rect(float x, float y, float w, float h,
 		V(x,	   y,     0, color, u, v);
 		V(x + w, y,	   0, color, u + uw, v);
 		V(x + w, y + h, 0, color, u + uw, v + uh);
-		V(x,	   y,     0, color, u, v);
-		V(x + w, y + h, 0, color, u + uw, v + uh);
 		V(x,	   y + h, 0, color, u, v + uh);
 }
 
@@ -192,10 +224,8 @@ void DrawBuffer::Line(int atlas_image, float x1, float y1, float x2, float y2, f
 
 	V(x[0],	y[0], color, image.u1, image.v1);
 	V(x[1],	y[1], color, image.u2, image.v1);
-	V(x[2],	y[2], color, image.u1, image.v2);
-	V(x[2],	y[2], color, image.u1, image.v2);
-	V(x[1],	y[1], color, image.u2, image.v1);
 	V(x[3],	y[3], color, image.u2, image.v2);
+	V(x[2],	y[2], color, image.u1, image.v2);
 }
 
 void DrawBuffer::MeasureImage(ImageID atlas_image, float *w, float *h) {
@@ -220,8 +250,6 @@ void DrawBuffer::DrawImageStretch(ImageID atlas_image, float x1, float y1, float
 	V(x1,	y1, color, image.u1, image.v1);
 	V(x2,	y1, color, image.u2, image.v1);
 	V(x2,	y2, color, image.u2, image.v2);
-	V(x1,	y1, color, image.u1, image.v1);
-	V(x2,	y2, color, image.u2, image.v2);
 	V(x1,	y2, color, image.u1, image.v2);
 }
 
@@ -242,12 +270,10 @@ void DrawBuffer::DrawImageRotated(ImageID atlas_image, float x, float y, float s
 	float x2 = x + w / 2;
 	float y1 = y - h / 2;
 	float y2 = y + h / 2;
-	float v[6][2] = {
+	float v[4][2] = {
 		{x1, y1},
 		{x2, y1},
 		{x2, y2},
-		{x1, y1},
-		{x2, y2},
 		{x1, y2},
 	};
 	float u1 = image.u1;
@@ -257,15 +283,13 @@ void DrawBuffer::DrawImageRotated(ImageID atlas_image, float x, float y, float s
 		u1 = u2;
 		u2 = temp;
 	}
-	const float uv[6][2] = {
+	const float uv[4][2] = {
 		{u1, image.v1},
 		{u2, image.v1},
 		{u2, image.v2},
-		{u1, image.v1},
-		{u2, image.v2},
 		{u1, image.v2},
 	};
-	for (int i = 0; i < 6; i++) {
+	for (int i = 0; i < 4; i++) {
 		rot(v[i], angle, x, y);
 		V(v[i][0], v[i][1], 0, color, uv[i][0], uv[i][1]);
 	}
@@ -289,8 +313,6 @@ void DrawBuffer::Circle(float xc, float yc, float radius, float thickness, int s
 		const float y[4] = {s1 * r1 + yc, s2 * r1 + yc, s1 * r2 + yc, s2 * r2 + yc};
 		V(x[0],	y[0], color, u1, 0);
 		V(x[1],	y[1], color, u2, 0);
-		V(x[2],	y[2], color, u1, 1);
-		V(x[1],	y[1], color, u2, 0);
 		V(x[3],	y[3], color, u2, 1);
 		V(x[2],	y[2], color, u1, 1);
 	}
@@ -300,8 +322,6 @@ void DrawBuffer::DrawTexRect(float x1, float y1, float x2, float y2, float u1, f
 	V(x1,	y1, color, u1, v1);
 	V(x2,	y1, color, u2, v1);
 	V(x2,	y2, color, u2, v2);
-	V(x1,	y1, color, u1, v1);
-	V(x2,	y2, color, u2, v2);
 	V(x1,	y2, color, u1, v2);
 }
 
@@ -495,7 +515,7 @@ void DrawBuffer::DrawTextRect(int font, const char *text, float x, float y, floa
 // ROTATE_* doesn't yet work right.
 void DrawBuffer::DrawText(int font, const char *text, float x, float y, Color color, int align) {
 	// rough estimate
-	if (count_ + strlen(text) * 6 > MAX_VERTS) {
+	if (count_ + strlen(text) * 4 > MAX_VERTS) {
 		Flush(true);
 	}
 
@@ -552,8 +572,6 @@ void DrawBuffer::DrawText(int font, const char *text, float x, float y, Color co
 			V(cx1,	cy1, color, c.sx, c.sy);
 			V(cx2,	cy1, color, c.ex, c.sy);
 			V(cx2,	cy2, color, c.ex, c.ey);
-			V(cx1,	cy1, color, c.sx, c.sy);
-			V(cx2,	cy2, color, c.ex, c.ey);
 			V(cx1,	cy2, color, c.sx, c.ey);
 			if (align & ROTATE_90DEG_LEFT)
 				y -= c.wx * fontscalex;
@@ -95,6 +95,10 @@ public:
 	}
 	void Rect(float x, float y, float w, float h, float u, float v, float uw, float uh, uint32_t color);
 
+	// Adds one corner of a quad. All drawing here is quads: every four vertices
+	// (in top-left, top-right, bottom-right, bottom-left order) are expanded to
+	// two triangles at flush time through a persistent index buffer, so emit
+	// them in multiples of four.
 	void V(float x, float y, float z, uint32_t color, float u, float v);
 	void V(float x, float y, uint32_t color, float u, float v) {
 		V(x, y, curZ_, color, u, v);
@@ -185,9 +189,13 @@ private:
 
 	Draw::DrawContext *draw_;
 	Draw::Buffer *vbuf_;
+	Draw::Buffer *ibuf_;
 	Draw::Pipeline *pipeline_;
 
 	Vertex *verts_;
+	// Scratch for expanding quads into a triangle list on backends that draw
+	// from user pointers instead of buffers.
+	std::vector<Vertex> expanded_;
 	int count_;
 	DrawBufferPrimitiveMode mode_;
 	const Atlas *atlas;
@@ -24,8 +24,27 @@ float TextDrawerWordWrapper::MeasureWidth(const char *str, size_t bytes) {
 }
 
 void TextDrawer::WrapString(std::string &out, const char *str, float maxW) {
+	WrapCacheKey key;
+	key.text = str;
+	key.fontHash = fontHash_;
+	key.maxW = (int)(maxW * 10.0f);
+	key.scale = (int)(fontScaleX_ * dpiScale_ * 256.0f);
+
+	auto iter = wrapCache_.find(key);
+	if (iter != wrapCache_.end()) {
+		out = iter->second;
+		return;
+	}
+
 	TextDrawerWordWrapper wrapper(this, str, maxW);
 	out = wrapper.Wrapped();
+
+	// Crude bound - wrapped UI strings are small, so if something generates
+	// lots of unique ones, just start over.
+	if (wrapCache_.size() >= 500) {
+		wrapCache_.clear();
+	}
+	wrapCache_[key] = out;
 }
 
 void TextDrawer::SetFontScale(float xscale, float yscale) {
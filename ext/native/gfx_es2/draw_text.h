@@ -90,6 +90,26 @@ protected:
 	float fontScaleX_;
 	float fontScaleY_;
 	float dpiScale_;
+	uint32_t fontHash_ = 0;
+
+	// Wrapping a paragraph re-measures every word, so memoize the result for
+	// steady-state UI text. See WrapString().
+	struct WrapCacheKey {
+		std::string text;
+		uint32_t fontHash;
+		int maxW;   // tenths of a pixel
+		int scale;  // font scale * dpi scale, fixed point
+		bool operator < (const WrapCacheKey &other) const {
+			if (fontHash != other.fontHash)
+				return fontHash < other.fontHash;
+			if (maxW != other.maxW)
+				return maxW < other.maxW;
+			if (scale != other.scale)
+				return scale < other.scale;
+			return text < other.text;
+		}
+	};
+	std::map<WrapCacheKey, std::string> wrapCache_;
 };
 
 
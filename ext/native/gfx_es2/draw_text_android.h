@@ -40,7 +40,6 @@ private:
 	jmethodID method_measureText;
 	jmethodID method_renderText;
 
-	uint32_t fontHash_;
 
 	std::map<uint32_t, AndroidFontEntry> fontMap_;
 
@@ -24,7 +24,6 @@ public:
 protected:
 	void ClearCache() override;
 
-	uint32_t fontHash_;
 	std::map<uint32_t, QFont *> fontMap_;
 
 	// The key is the CityHash of the string xor the fontHash_.
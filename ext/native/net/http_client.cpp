@@ -273,7 +273,7 @@ int Client::SendRequestWithData(const char *method, const char *resource, const
 		"%s %s HTTP/%s\r\n"
 		"Host: %s\r\n"
 		"User-Agent: %s\r\n"
-		"Connection: close\r\n"
+		"Connection: %s\r\n"
 		"%s"
 		"\r\n";
 
@@ -281,6 +281,7 @@ int Client::SendRequestWithData(const char *method, const char *resource, const
 		method, resource, httpVersion_,
 		host_.c_str(),
 		userAgent_,
+		keepAlive_ ? "keep-alive" : "close",
 		otherHeaders ? otherHeaders : "");
 	buffer.Append(data);
 	bool flushed = buffer.FlushSocket(sock(), dataTimeout_);
@@ -365,7 +366,15 @@ int Client::ReadResponseEntity(Buffer *readbuf, const std::vector<std::string> &
 		*progress = 0.1f;
 	}
 
-	if (!contentLength || !progress) {
+	if (keepAlive_ && !chunked && contentLength > 0) {
+		// The server won't close the connection to end the entity, so we have to
+		// read exactly the advertised length.
+		if ((int)readbuf->size() < contentLength) {
+			int remaining = contentLength - (int)readbuf->size();
+			if (readbuf->Read(sock(), remaining) < remaining)
+				return -1;
+		}
+	} else if (!contentLength || !progress) {
 		// No way to know how far along we are. Let's just not update the progress counter.
 		if (!readbuf->ReadAll(sock(), contentLength))
 			return -1;
@@ -79,10 +79,17 @@ public:
 		dataTimeout_ = t;
 	}
 
+	// When set, requests ask the server to keep the connection open so further
+	// requests can reuse it. Delimited (Content-Length) responses only.
+	void SetKeepAlive(bool keepAlive) {
+		keepAlive_ = keepAlive;
+	}
+
 protected:
 	const char *userAgent_;
 	const char *httpVersion_;
 	double dataTimeout_ = -1.0;
+	bool keepAlive_ = false;
 };
 
 // Not particularly efficient, but hey - it's a background download, that's pretty cool :P
@@ -22,7 +22,8 @@
 #else
 #define MAX_THREADS 4     // Can be any number, represents concurrent threads calling the profiler.
 #endif
-#define HISTORY_SIZE 128 // Must be power of 2
+#define HISTORY_SIZE 1024 // Must be power of 2. ~17 seconds at 60 fps, so a
+                          // stutter is still in the ring when someone exports it.
 
 #ifndef _DEBUG
 // If the compiler can collapse identical strings, we don't even need the strcmp.
@@ -1,3 +1,4 @@
+#include "Common/FileUtil.h"
 #include "Common/MemoryUtil.h"
 #include "Core/Reporting.h"
 #include "GLQueueRunner.h"
@@ -10,6 +11,7 @@
 #include "gfx_es2/gpu_features.h"
 #include "math/dataconv.h"
 #include "math/math_util.h"
+#include "util/hash/hash.h"
 
 #define TEXCACHE_NAME_CACHE_SIZE 16
 
@@ -71,6 +73,12 @@ void GLQueueRunner::DestroyDeviceObjects() {
 	delete[] tempBuffer_;
 	tempBuffer_ = nullptr;
 	tempBufferSize_ = 0;
+	{
+		// The valid binary formats can change with the context, so reload next time.
+		std::lock_guard<std::mutex> guard(programBinaryLock_);
+		programBinaries_.clear();
+		programBinaryCacheLoaded_ = false;
+	}
 	CHECK_GL_ERROR_IF_DEBUG();
 }
 
@@ -92,6 +100,173 @@ static std::string GetInfoLog(GLuint name, Getiv getiv, GetLog getLog) {
 	return infoLog;
 }
 
+// Program binary disk cache.
+//
+// glProgramBinary lets us skip the link step entirely when we've seen the same program
+// in an earlier run. On some mobile drivers (Mali especially) a single link can take
+// 50-200ms, which is a very visible hitch when a game encounters a new shader
+// combination mid-play, even though the compile itself runs on the render thread.
+//
+// Binaries are driver specific, so the cache file header records the GL vendor,
+// renderer and version strings and the whole file is discarded when any of them change
+// (driver updates, moving the memstick folder between devices etc.)
+// Entries are keyed by a hash of the attached shader sources and are appended as
+// programs get linked, so a crash only loses the binaries from the current session.
+
+#define PROGRAM_BINARY_CACHE_MAGIC 0x42504C47  // 'GLPB'
+#define PROGRAM_BINARY_CACHE_VERSION 1
+#define PROGRAM_BINARY_MAX_SIZE (16 * 1024 * 1024)
+
+struct ProgramBinaryCacheHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t reserved0;
+	uint32_t reserved1;
+};
+
+static bool ReadPascalString(FILE *f, std::string *str) {
+	uint32_t len;
+	if (fread(&len, sizeof(len), 1, f) != 1 || len > 0x10000)
+		return false;
+	str->resize(len);
+	return len == 0 || fread(&(*str)[0], 1, len, f) == len;
+}
+
+static void WritePascalString(FILE *f, const std::string &str) {
+	uint32_t len = (uint32_t)str.size();
+	fwrite(&len, sizeof(len), 1, f);
+	fwrite(str.data(), 1, len, f);
+}
+
+static bool ProgramBinarySupported() {
+	if (gl_extensions.IsGLES && !gl_extensions.GLES3)
+		return false;
+#if !defined(USING_GLES2) && !defined(IOS)
+	// On desktop, GLEW leaves the entry points null below GL 4.1 without ARB_get_program_binary.
+	if (!gl_extensions.IsGLES && !glGetProgramBinary)
+		return false;
+#endif
+	GLint numFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+	return numFormats > 0;
+}
+
+void GLQueueRunner::LoadProgramBinaryCache() {
+	programBinaryCacheLoaded_ = true;
+	programBinaries_.clear();
+	programBinarySupported_ = ProgramBinarySupported();
+	if (!programBinarySupported_) {
+		INFO_LOG(G3D, "Program binaries not supported by this driver, not caching them.");
+		return;
+	}
+
+	const std::string vendor = GetGLString(GL_VENDOR);
+	const std::string renderer = GetGLString(GL_RENDERER);
+	const std::string version = GetGLString(GL_VERSION);
+
+	FILE *f = File::OpenCFile(programBinaryCacheFile_, "rb");
+	if (f) {
+		ProgramBinaryCacheHeader header;
+		std::string fileVendor, fileRenderer, fileVersion;
+		bool valid = fread(&header, sizeof(header), 1, f) == 1
+			&& header.magic == PROGRAM_BINARY_CACHE_MAGIC
+			&& header.version == PROGRAM_BINARY_CACHE_VERSION
+			&& ReadPascalString(f, &fileVendor) && fileVendor == vendor
+			&& ReadPascalString(f, &fileRenderer) && fileRenderer == renderer
+			&& ReadPascalString(f, &fileVersion) && fileVersion == version;
+		if (valid) {
+			// Read entries until we hit the end of the file. A truncated tail (say, from
+			// a crash in the middle of an append) just means we stop early.
+			while (true) {
+				uint64_t sourceHash;
+				uint32_t format, size;
+				if (fread(&sourceHash, sizeof(sourceHash), 1, f) != 1)
+					break;
+				if (fread(&format, sizeof(format), 1, f) != 1 || fread(&size, sizeof(size), 1, f) != 1)
+					break;
+				if (size == 0 || size > PROGRAM_BINARY_MAX_SIZE)
+					break;
+				GLProgramBinary binary;
+				binary.format = format;
+				binary.data.resize(size);
+				if (fread(&binary.data[0], 1, size, f) != size)
+					break;
+				// Later entries take precedence, so a binary some driver rejected gets
+				// replaced by the relinked one on the next load.
+				programBinaries_[sourceHash] = std::move(binary);
+			}
+			fclose(f);
+			INFO_LOG(G3D, "Loaded %d program binaries from '%s'", (int)programBinaries_.size(), programBinaryCacheFile_.c_str());
+			return;
+		}
+		fclose(f);
+		INFO_LOG(G3D, "Program binary cache '%s' is stale or invalid, starting over.", programBinaryCacheFile_.c_str());
+	}
+
+	// Write a fresh header so future binaries can simply be appended.
+	f = File::OpenCFile(programBinaryCacheFile_, "wb");
+	if (!f) {
+		WARN_LOG(G3D, "Failed to create program binary cache '%s'", programBinaryCacheFile_.c_str());
+		programBinarySupported_ = false;
+		return;
+	}
+	ProgramBinaryCacheHeader header{};
+	header.magic = PROGRAM_BINARY_CACHE_MAGIC;
+	header.version = PROGRAM_BINARY_CACHE_VERSION;
+	fwrite(&header, sizeof(header), 1, f);
+	WritePascalString(f, vendor);
+	WritePascalString(f, renderer);
+	WritePascalString(f, version);
+	fclose(f);
+}
+
+uint64_t GLQueueRunner::HashProgramSources(const GLRInitStep &step) {
+	// Adler32 per shader, mixed with the source lengths. Not cryptographic, but shader
+	// sources are long enough that collisions are not a practical concern here.
+	uint64_t h = (uint64_t)step.create_program.num_shaders;
+	for (int i = 0; i < step.create_program.num_shaders; i++) {
+		// The source was attached to the shader when its CREATE_SHADER step ran, which
+		// is always before the program that uses it.
+		const std::string &code = step.create_program.shaders[i]->code;
+		h = h * 1099511628211ULL + (uint64_t)code.size();
+		h = h * 1099511628211ULL + hash::Adler32((const uint8_t *)code.data(), code.size());
+	}
+	return h;
+}
+
+void GLQueueRunner::RetrieveProgramBinary(GLRProgram *program, uint64_t sourceHash) {
+	GLint length = 0;
+	glGetProgramiv(program->program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0 || length > PROGRAM_BINARY_MAX_SIZE)
+		return;
+
+	GLProgramBinary binary;
+	binary.data.resize(length);
+	GLsizei written = 0;
+	binary.format = 0;
+	glGetProgramBinary(program->program, length, &written, &binary.format, &binary.data[0]);
+	if (written <= 0) {
+		// Some drivers advertise binary formats but then fail the actual retrieval.
+		glGetError();
+		return;
+	}
+	binary.data.resize(written);
+
+	std::lock_guard<std::mutex> guard(programBinaryLock_);
+	FILE *f = File::OpenCFile(programBinaryCacheFile_, "ab");
+	if (f) {
+		uint32_t format = binary.format;
+		uint32_t size = (uint32_t)binary.data.size();
+		fwrite(&sourceHash, sizeof(sourceHash), 1, f);
+		fwrite(&format, sizeof(format), 1, f);
+		fwrite(&size, sizeof(size), 1, f);
+		fwrite(binary.data.data(), 1, size, f);
+		fclose(f);
+	}
+	programBinaries_[sourceHash] = std::move(binary);
+	CHECK_GL_ERROR_IF_DEBUG();
+}
+
 void GLQueueRunner::RunInitSteps(const std::vector<GLRInitStep> &steps, bool skipGLCalls) {
 	if (skipGLCalls) {
 		// Some bookkeeping still needs to be done.
@@ -177,31 +352,72 @@ void GLQueueRunner::RunInitSteps(const std::vector<GLRInitStep> &steps, bool ski
 			for (int j = 0; j < step.create_program.num_shaders; j++) {
 				_dbg_assert_msg_(G3D, step.create_program.shaders[j]->shader, "Can't create a program with a null shader");
 				anyFailed = anyFailed || step.create_program.shaders[j]->failed;
-				glAttachShader(program->program, step.create_program.shaders[j]->shader);
 			}
 
-			for (auto iter : program->semantics_) {
-				glBindAttribLocation(program->program, iter.location, iter.attrib);
+			// See if we have a cached binary for this program, sidestepping the link.
+			uint64_t sourceHash = 0;
+			bool linkedFromBinary = false;
+			bool saveBinary = false;
+			{
+				std::lock_guard<std::mutex> guard(programBinaryLock_);
+				if (!programBinaryCacheFile_.empty()) {
+					if (!programBinaryCacheLoaded_)
+						LoadProgramBinaryCache();
+					if (programBinarySupported_ && !anyFailed) {
+						sourceHash = HashProgramSources(step);
+						auto binary = programBinaries_.find(sourceHash);
+						if (binary != programBinaries_.end()) {
+							glProgramBinary(program->program, binary->second.format, binary->second.data.data(), (GLsizei)binary->second.data.size());
+							GLint binaryStatus = GL_FALSE;
+							glGetProgramiv(program->program, GL_LINK_STATUS, &binaryStatus);
+							if (binaryStatus == GL_TRUE) {
+								linkedFromBinary = true;
+							} else {
+								// Stale binary the driver no longer accepts. Drop it, link from
+								// source below and append the fresh binary - later entries take
+								// precedence when the file is loaded.
+								programBinaries_.erase(binary);
+								glGetError();
+								saveBinary = true;
+							}
+						} else {
+							saveBinary = true;
+						}
+					}
+				}
 			}
 
+			if (!linkedFromBinary) {
+				for (int j = 0; j < step.create_program.num_shaders; j++) {
+					glAttachShader(program->program, step.create_program.shaders[j]->shader);
+				}
+
+				for (auto iter : program->semantics_) {
+					glBindAttribLocation(program->program, iter.location, iter.attrib);
+				}
+
 #if !defined(USING_GLES2)
-			if (step.create_program.support_dual_source) {
-				// Dual source alpha
-				glBindFragDataLocationIndexed(program->program, 0, 0, "fragColor0");
-				glBindFragDataLocationIndexed(program->program, 0, 1, "fragColor1");
-			} else if (gl_extensions.VersionGEThan(3, 3, 0)) {
-				glBindFragDataLocation(program->program, 0, "fragColor0");
-			}
+				if (step.create_program.support_dual_source) {
+					// Dual source alpha
+					glBindFragDataLocationIndexed(program->program, 0, 0, "fragColor0");
+					glBindFragDataLocationIndexed(program->program, 0, 1, "fragColor1");
+				} else if (gl_extensions.VersionGEThan(3, 3, 0)) {
+					glBindFragDataLocation(program->program, 0, "fragColor0");
+				}
 #elif !defined(IOS)
-			if (gl_extensions.GLES3 && step.create_program.support_dual_source) {
-				glBindFragDataLocationIndexedEXT(program->program, 0, 0, "fragColor0");
-				glBindFragDataLocationIndexedEXT(program->program, 0, 1, "fragColor1");
-			}
+				if (gl_extensions.GLES3 && step.create_program.support_dual_source) {
+					glBindFragDataLocationIndexedEXT(program->program, 0, 0, "fragColor0");
+					glBindFragDataLocationIndexedEXT(program->program, 0, 1, "fragColor1");
+				}
 #endif
-			glLinkProgram(program->program);
+				if (saveBinary)
+					glProgramParameteri(program->program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+				glLinkProgram(program->program);
+			}
 
-			GLint linkStatus = GL_FALSE;
-			glGetProgramiv(program->program, GL_LINK_STATUS, &linkStatus);
+			GLint linkStatus = linkedFromBinary ? GL_TRUE : GL_FALSE;
+			if (!linkedFromBinary)
+				glGetProgramiv(program->program, GL_LINK_STATUS, &linkStatus);
 			if (linkStatus != GL_TRUE) {
 				std::string infoLog = GetInfoLog(program->program, glGetProgramiv, glGetProgramInfoLog);
 
@@ -232,6 +448,9 @@ void GLQueueRunner::RunInitSteps(const std::vector<GLRInitStep> &steps, bool ski
 				break;
 			}
 
+			if (saveBinary)
+				RetrieveProgramBinary(program, sourceHash);
+
 			glUseProgram(program->program);
 
 			// Query all the uniforms.
@@ -564,6 +783,9 @@ void GLQueueRunner::RunSteps(const std::vector<GLRStep *> &steps, bool skipGLCal
 							}
 						}
 						break;
+					case GLRRenderCommand::UNIFORMMATRIXARRAY:
+						delete[] c.uniformMatrix4Array.m;
+						break;
 					}
 				}
 				break;
@@ -924,6 +1146,20 @@ void GLQueueRunner::PerformRenderPass(const GLRStep &step) {
 			CHECK_GL_ERROR_IF_DEBUG();
 			break;
 		}
+		case GLRRenderCommand::UNIFORMMATRIXARRAY:
+		{
+			assert(curProgram);
+			int loc = c.uniformMatrix4Array.loc ? *c.uniformMatrix4Array.loc : -1;
+			if (c.uniformMatrix4Array.name) {
+				loc = curProgram->GetUniformLoc(c.uniformMatrix4Array.name);
+			}
+			if (loc >= 0) {
+				glUniformMatrix4fv(loc, c.uniformMatrix4Array.count, false, c.uniformMatrix4Array.m);
+			}
+			delete[] c.uniformMatrix4Array.m;
+			CHECK_GL_ERROR_IF_DEBUG();
+			break;
+		}
 		case GLRRenderCommand::BINDTEXTURE:
 		{
 			GLint slot = c.texture.slot;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -42,6 +44,7 @@ enum class GLRRenderCommand : uint8_t {
 	UNIFORM4I,
 	UNIFORM4F,
 	UNIFORMMATRIX,
+	UNIFORMMATRIXARRAY,
 	TEXTURESAMPLER,
 	TEXTURELOD,
 	VIEWPORT,
@@ -125,6 +128,12 @@ struct GLRRenderData {
 			GLint *loc;
 			float m[16];
 		} uniformMatrix4;
+		struct {
+			const char *name;  // if null, use loc
+			GLint *loc;
+			GLint count;
+			float *m;  // owned, delete[]-ed after the upload
+		} uniformMatrix4Array;
 		struct {
 			uint32_t clearColor;
 			float clearZ;
@@ -364,9 +373,25 @@ public:
 		return it != glStrings_.end() ? it->second : "";
 	}
 
+	// Enables the glProgramBinary disk cache, where supported by the driver. Safe to call
+	// from any thread - the file itself is only touched from the render thread, lazily
+	// when the next program is created.
+	void SetProgramBinaryCacheFile(const std::string &path) {
+		std::lock_guard<std::mutex> guard(programBinaryLock_);
+		programBinaryCacheFile_ = path;
+		programBinaryCacheLoaded_ = false;
+	}
+
 private:
 	void InitCreateFramebuffer(const GLRInitStep &step);
 
+	// Program binary cache (see the comment block in GLQueueRunner.cpp). All of these
+	// except SetProgramBinaryCacheFile above must only be called on the render thread,
+	// with programBinaryLock_ held where noted.
+	void LoadProgramBinaryCache();  // lock held
+	uint64_t HashProgramSources(const GLRInitStep &step);
+	void RetrieveProgramBinary(GLRProgram *program, uint64_t sourceHash);  // takes the lock itself
+
 	void PerformBindFramebufferAsRenderTarget(const GLRStep &pass);
 	void PerformRenderPass(const GLRStep &pass);
 	void PerformCopy(const GLRStep &pass);
@@ -416,4 +441,14 @@ private:
 	std::unordered_map<int, std::string> glStrings_;
 
 	bool sawOutOfMemory_ = false;
+
+	struct GLProgramBinary {
+		GLenum format;
+		std::string data;
+	};
+	std::mutex programBinaryLock_;
+	std::string programBinaryCacheFile_;
+	bool programBinaryCacheLoaded_ = false;
+	bool programBinarySupported_ = false;
+	std::unordered_map<uint64_t, GLProgramBinary> programBinaries_;
 };
@@ -14,7 +14,24 @@
 #define VLOG(...)
 #endif
 
+// Some GLES2 headers only have the EXT-suffixed versions of these (same values).
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
 static std::thread::id renderThreadId;
+
+// Render thread only.
+static void WaitAndDeleteFence(GLsync fence) {
+	GLenum result;
+	do {
+		result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ULL);
+	} while (result == GL_TIMEOUT_EXPIRED);
+	glDeleteSync(fence);
+}
 #if MAX_LOGLEVEL >= DEBUG_LEVEL
 static bool OnRenderThread() {
 	return std::this_thread::get_id() == renderThreadId;
@@ -127,6 +144,18 @@ void GLRenderManager::ThreadStart(Draw::DrawContext *draw) {
 	} else {
 		bufferStrategy_ = GLBufferStrategy::SUBDATA;
 	}
+
+	// With buffer_storage we can beat all of the above: keep the push buffers persistently
+	// mapped with COHERENT, so there's no per-frame map/unmap churn and no orphaning at all.
+	// Reuse of a frame's buffers is gated on a fence instead, see Run()/Submit(). Orphaned
+	// glBufferData uploads are particularly expensive on Mali, which this avoids entirely.
+	if (hasBufferStorage && gl_extensions.VersionGEThan(3, 0, 0)) {
+		// See the Qualcomm note above - no reason to believe a persistent mapping survives
+		// an Android task switch any better, so stay off this path there too.
+		if (gl_extensions.gpuVendor != GPU_VENDOR_QUALCOMM) {
+			bufferStrategy_ = GLBufferStrategy::PERSISTENT_COHERENT;
+		}
+	}
 }
 
 void GLRenderManager::ThreadEnd() {
@@ -159,8 +188,10 @@ void GLRenderManager::ThreadEnd() {
 
 bool GLRenderManager::ThreadFrame() {
 	std::unique_lock<std::mutex> lock(mutex_);
-	if (!run_)
+	if (!run_) {
+		ReleaseFrameFences();
 		return false;
+	}
 
 	// In case of syncs or other partial completion, we keep going until we complete a frame.
 	do {
@@ -178,6 +209,9 @@ bool GLRenderManager::ThreadFrame() {
 			}
 			if (!frameData.readyForRun && !run_) {
 				// This means we're out of frames to render and run_ is false, so bail.
+				// Any outstanding fences must be dealt with here, while we still have the
+				// context - StopThread() is waiting for readyForFence on the other side.
+				ReleaseFrameFences();
 				return false;
 			}
 			VLOG("PULL: Setting frame[%d].readyForRun = false", threadFrame_);
@@ -415,7 +449,7 @@ void GLRenderManager::BeginFrame() {
 
 	VLOG("PUSH: Fencing %d", curFrame);
 
-	// glFenceSync(&frameData.fence...)
+	// (The fencing for persistently mapped buffers happens on the render thread, in Submit().)
 
 	// Must be after the fence - this performs deletes.
 	VLOG("PUSH: BeginFrame %d", curFrame);
@@ -471,13 +505,24 @@ void GLRenderManager::Submit(int frame, bool triggerFence) {
 	// When !triggerFence, we notify after syncing with Vulkan.
 
 	if (triggerFence) {
-		VLOG("PULL: Frame %d.readyForFence = true", frame);
+		bool fenced = false;
+		if ((bufferStrategy_ & GLBufferStrategy::MASK_PERSISTENT) != 0 && !skipGLCalls_) {
+			// The push buffers stay mapped, so we can't rely on the implicit sync in
+			// map/unmap to keep the GPU from reading buffers the emu thread is overwriting.
+			// Don't mark the frame ready for reuse until the GPU has passed this fence -
+			// see the wait in Run().
+			frameData.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			fenced = frameData.fence != nullptr;
+		}
 
 		std::unique_lock<std::mutex> lock(frameData.push_mutex);
 		assert(frameData.readyForSubmit);
-		frameData.readyForFence = true;
 		frameData.readyForSubmit = false;
-		frameData.push_condVar.notify_all();
+		if (!fenced) {
+			VLOG("PULL: Frame %d.readyForFence = true", frame);
+			frameData.readyForFence = true;
+			frameData.push_condVar.notify_all();
+		}
 	}
 }
 
@@ -509,6 +554,27 @@ void GLRenderManager::Run(int frame) {
 
 	FrameData &frameData = frameData_[frame];
 
+	if ((bufferStrategy_ & GLBufferStrategy::MASK_PERSISTENT) != 0) {
+		// Hand the next frame slot's push buffers back to the emu thread once the GPU has
+		// passed their fence. We do this for the slot the emu thread will need next rather
+		// than the one we just submitted - by then the fence is two frames old and the
+		// wait should normally be a no-op. This is also the last spot we're guaranteed to
+		// reach before the emu thread can block on that slot.
+		int nextFrame = frame + 1;
+		if (nextFrame >= MAX_INFLIGHT_FRAMES)
+			nextFrame = 0;
+		FrameData &nextData = frameData_[nextFrame];
+		if (nextData.fence) {
+			if (!skipGLCalls_)
+				WaitAndDeleteFence(nextData.fence);
+			nextData.fence = nullptr;
+			std::unique_lock<std::mutex> lock(nextData.push_mutex);
+			VLOG("PULL: Frame %d.readyForFence = true (fence passed)", nextFrame);
+			nextData.readyForFence = true;
+			nextData.push_condVar.notify_all();
+		}
+	}
+
 	auto &stepsOnThread = frameData_[frame].steps;
 	auto &initStepsOnThread = frameData_[frame].initSteps;
 	// queueRunner_.LogSteps(stepsOnThread);
@@ -597,6 +663,21 @@ void GLRenderManager::EndSyncFrame(int frame) {
 	}
 }
 
+// Render thread
+void GLRenderManager::ReleaseFrameFences() {
+	for (int i = 0; i < MAX_INFLIGHT_FRAMES; i++) {
+		FrameData &frameData = frameData_[i];
+		if (!frameData.fence)
+			continue;
+		if (!skipGLCalls_)
+			WaitAndDeleteFence(frameData.fence);
+		frameData.fence = nullptr;
+		std::unique_lock<std::mutex> lock(frameData.push_mutex);
+		frameData.readyForFence = true;
+		frameData.push_condVar.notify_all();
+	}
+}
+
 void GLRenderManager::Wipe() {
 	initSteps_.clear();
 	for (auto step : steps_) {
@@ -812,6 +893,10 @@ void GLPushBuffer::UnmapDevice() {
 
 	for (auto &info : buffers_) {
 		if (info.deviceMemory) {
+			if ((strategy_ & GLBufferStrategy::MASK_PERSISTENT) != 0) {
+				// Stays mapped for the lifetime of the buffer.
+				continue;
+			}
 			// TODO: Technically this can return false?
 			info.buffer->Unmap();
 			info.deviceMemory = nullptr;
@@ -823,6 +908,10 @@ void *GLRBuffer::Map(GLBufferStrategy strategy) {
 	assert(buffer_ != 0);
 
 	GLbitfield access = GL_MAP_WRITE_BIT;
+	if ((strategy & GLBufferStrategy::MASK_PERSISTENT) != 0) {
+		// Requires that the storage below is created with the same flags.
+		access |= GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	}
 	if ((strategy & GLBufferStrategy::MASK_FLUSH) != 0) {
 		access |= GL_MAP_FLUSH_EXPLICIT_BIT;
 	}
@@ -144,6 +144,7 @@ enum class GLBufferStrategy {
 
 	MASK_FLUSH = 0x10,
 	MASK_INVALIDATE = 0x20,
+	MASK_PERSISTENT = 0x40,
 
 	// Map/unmap the buffer each frame.
 	FRAME_UNMAP = 1,
@@ -153,6 +154,10 @@ enum class GLBufferStrategy {
 	FLUSH_UNMAP = MASK_FLUSH,
 	// Map/unmap, invalidate on map, and explicit flush.
 	FLUSH_INVALIDATE_UNMAP = MASK_FLUSH | MASK_INVALIDATE,
+	// Keep the buffers mapped for their entire lifetime, coherently, using buffer_storage.
+	// No map/unmap churn and no orphaning, but reuse of a frame's buffers must instead be
+	// gated on a fence - see GLRenderManager::Run()/Submit().
+	PERSISTENT_COHERENT = MASK_PERSISTENT,
 };
 
 static inline int operator &(const GLBufferStrategy &lhs, const GLBufferStrategy &rhs) {
@@ -700,6 +705,20 @@ public:
 		curRenderStep_->commands.push_back(data);
 	}
 
+	// Uploads count matrices to consecutive elements of an array uniform with a single call.
+	void SetUniformM4x4Array(GLint *loc, GLint count, const float *udata) {
+		_dbg_assert_(G3D, curRenderStep_ && curRenderStep_->stepType == GLRStepType::RENDER);
+#ifdef _DEBUG
+		assert(curProgram_);
+#endif
+		GLRRenderData data{ GLRRenderCommand::UNIFORMMATRIXARRAY };
+		data.uniformMatrix4Array.loc = loc;
+		data.uniformMatrix4Array.count = count;
+		data.uniformMatrix4Array.m = new float[count * 16];
+		memcpy(data.uniformMatrix4Array.m, udata, sizeof(float) * 16 * count);
+		curRenderStep_->commands.push_back(data);
+	}
+
 	void SetUniformM4x4(const char *name, const float *udata) {
 		_dbg_assert_(G3D, curRenderStep_ && curRenderStep_->stepType == GLRStepType::RENDER);
 #ifdef _DEBUG
@@ -909,6 +928,12 @@ public:
 		return queueRunner_.GetGLString(name);
 	}
 
+	// Enables the glProgramBinary disk cache on drivers that support it, which skips
+	// the (on some drivers very slow) link step for programs seen in earlier runs.
+	void SetProgramBinaryCacheFile(const std::string &path) {
+		queueRunner_.SetProgramBinaryCacheFile(path);
+	}
+
 	// Used during Android-style ugly shutdown. No need to have a way to set it back because we'll be
 	// destroyed.
 	void SetSkipGLCalls() {
@@ -924,6 +949,11 @@ private:
 	void FlushSync();
 	void EndSyncFrame(int frame);
 
+	// Waits out and deletes any leftover frame fences from the persistently mapped buffer
+	// path. Must run on the render thread, before it pauses, or the emu thread could get
+	// stuck waiting for readyForFence.
+	void ReleaseFrameFences();
+
 	// When using legacy functionality for push buffers (glBufferData), we need to flush them
 	// before actually making the glDraw* calls. It's best if the render manager handles that.
 	void RegisterPushBuffer(int frame, GLPushBuffer *buffer) {
@@ -944,7 +974,9 @@ private:
 		bool skipSwap = false;
 		GLRRunType type = GLRRunType::END;
 
-		// GLuint fence; For future AZDO stuff?
+		// Only used with GLBufferStrategy::PERSISTENT_COHERENT. Inserted after submit, and
+		// waited on before this frame slot's push buffers are handed back to the emu thread.
+		GLsync fence = nullptr;
 		std::vector<GLRStep *> steps;
 		std::vector<GLRInitStep> initSteps;
 
@@ -413,6 +413,8 @@ void VulkanQueueRunner::RunSteps(VkCommandBuffer cmd, std::vector<VKRStep *> &st
 		}
 	}
 
+	MergeRenderSteps(steps);
+
 	// Queue hacks.
 	if (hacksEnabled_) {
 		if (hacksEnabled_ & QUEUE_HACK_MGS2_ACID) {
@@ -424,6 +426,7 @@ void VulkanQueueRunner::RunSteps(VkCommandBuffer cmd, std::vector<VKRStep *> &st
 		}
 	}
 
+	numRenderPassesLastFrame_ = 0;
 	for (size_t i = 0; i < steps.size(); i++) {
 		const VKRStep &step = *steps[i];
 		switch (step.stepType) {
@@ -449,6 +452,85 @@ void VulkanQueueRunner::RunSteps(VkCommandBuffer cmd, std::vector<VKRStep *> &st
 	}
 }
 
+// Merge render passes that target the same framebuffer when nothing in between
+// depends on that framebuffer. Texture cache work and copies between other targets
+// routinely interrupt rendering without actually touching the current target, but
+// every pass split still costs a full tile flush and reload on tiled mobile GPUs.
+// The merged draws run before the steps they used to follow, so we have to make sure
+// they don't sample anything those steps write.
+void VulkanQueueRunner::MergeRenderSteps(std::vector<VKRStep *> &steps) {
+	for (int j = 0; j < (int)steps.size() - 1; j++) {
+		if (steps[j]->stepType != VKRStepType::RENDER || !steps[j]->render.framebuffer)
+			continue;
+		VKRFramebuffer *fb = steps[j]->render.framebuffer;
+		// Framebuffers written by the steps we'd be pulling the merged draws in front of.
+		std::vector<VKRFramebuffer *> written;
+		for (int i = j + 1; i < (int)steps.size(); i++) {
+			VKRStep *later = steps[i];
+			bool stop = false;
+			switch (later->stepType) {
+			case VKRStepType::RENDER:
+				if (later->render.framebuffer == fb) {
+					// Can't pull draws across a clear or discard of the target.
+					if (later->render.color != VKRRenderPassAction::KEEP ||
+						later->render.depth != VKRRenderPassAction::KEEP ||
+						later->render.stencil != VKRRenderPassAction::KEEP) {
+						stop = true;
+						break;
+					}
+					for (const auto &xfer : later->preTransitions) {
+						if (xfer.fb == fb) {
+							// Samples its own target - leave that alone.
+							stop = true;
+							break;
+						}
+						for (VKRFramebuffer *w : written) {
+							if (xfer.fb == w) {
+								stop = true;
+								break;
+							}
+						}
+					}
+					if (stop)
+						break;
+					for (const auto &c : later->commands)
+						steps[j]->commands.push_back(c);
+					for (const auto &xfer : later->preTransitions)
+						steps[j]->preTransitions.push_back(xfer);
+					steps[j]->render.numDraws += later->render.numDraws;
+					steps[j]->render.numReads += later->render.numReads;
+					steps[j]->render.finalColorLayout = later->render.finalColorLayout;
+					later->stepType = VKRStepType::RENDER_SKIP;
+					later->commands.clear();
+				} else {
+					written.push_back(later->render.framebuffer);
+				}
+				break;
+			case VKRStepType::COPY:
+				if (later->copy.src == fb || later->copy.dst == fb)
+					stop = true;
+				else
+					written.push_back(later->copy.dst);
+				break;
+			case VKRStepType::BLIT:
+				if (later->blit.src == fb || later->blit.dst == fb)
+					stop = true;
+				else
+					written.push_back(later->blit.dst);
+				break;
+			case VKRStepType::READBACK:
+				if (later->readback.src == fb)
+					stop = true;
+				break;
+			default:
+				break;
+			}
+			if (stop)
+				break;
+		}
+	}
+}
+
 void VulkanQueueRunner::ApplyMGSHack(std::vector<VKRStep *> &steps) {
 	// We want to turn a sequence of copy,render(1),copy,render(1),copy,render(1) to copy,copy,copy,render(n).
 
@@ -742,6 +824,8 @@ void VulkanQueueRunner::PerformRenderPass(const VKRStep &step, VkCommandBuffer c
 		return;
 	}
 
+	numRenderPassesLastFrame_++;
+
 	// This is supposed to bind a vulkan render pass to the command buffer.
 	PerformBindFramebufferAsRenderTarget(step, cmd);
 
@@ -754,9 +838,33 @@ void VulkanQueueRunner::PerformRenderPass(const VKRStep &step, VkCommandBuffer c
 
 	auto &commands = step.commands;
 
-	// TODO: Dynamic state commands (SetViewport, SetScissor, SetBlendConstants, SetStencil*) are only
-	// valid when a pipeline is bound with those as dynamic state. So we need to add some state tracking here
-	// for this to be correct. This is a bit of a pain but also will let us eliminate redundant calls.
+	// Dynamic state commands (SetViewport, SetScissor, SetBlendConstants, SetStencil*) are only
+	// valid when a pipeline is bound with those as dynamic state, and binding a pipeline that has
+	// one of them as static state leaves the dynamic value undefined. Viewport and scissor are
+	// dynamic in every pipeline we create so those are tracked across the whole pass, while blend
+	// constants and stencil state have to be re-applied after each pipeline change. On drivers
+	// where we're CPU-bound on command recording, skipping the redundant calls is a real win.
+	bool viewportSet = false;
+	bool scissorSet = false;
+	bool blendSet = false;
+	bool stencilSet = false;
+	VkViewport lastViewport{};
+	VkRect2D lastScissor{};
+	float lastBlend[4]{};
+	uint8_t lastStencilWriteMask = 0;
+	uint8_t lastStencilCompareMask = 0;
+	uint8_t lastStencilRef = 0;
+
+	// Descriptor sets survive pipeline binds only while the layout stays compatible, so that
+	// cache is dropped on pipeline changes too. Vertex/index buffer bindings are never disturbed.
+	VkDescriptorSet lastDescSet = VK_NULL_HANDLE;
+	int lastNumUboOffsets = -1;
+	uint32_t lastUboOffsets[3]{};
+	VkBuffer lastIndexBuffer = VK_NULL_HANDLE;
+	VkDeviceSize lastIndexOffset = 0;
+	VkIndexType lastIndexType = VK_INDEX_TYPE_MAX_ENUM;
+	VkBuffer lastVertexBuffer = VK_NULL_HANDLE;
+	VkDeviceSize lastVertexOffset = 0;
 
 	for (const auto &c : commands) {
 		switch (c.cmd) {
@@ -767,19 +875,34 @@ void VulkanQueueRunner::PerformRenderPass(const VKRStep &step, VkCommandBuffer c
 			if (c.pipeline.pipeline != lastPipeline) {
 				vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, c.pipeline.pipeline);
 				lastPipeline = c.pipeline.pipeline;
+				blendSet = false;
+				stencilSet = false;
+				lastDescSet = VK_NULL_HANDLE;
 			}
 			break;
 
 		case VKRRenderCommand::VIEWPORT:
-			vkCmdSetViewport(cmd, 0, 1, &c.viewport.vp);
+			if (!viewportSet || memcmp(&lastViewport, &c.viewport.vp, sizeof(lastViewport)) != 0) {
+				vkCmdSetViewport(cmd, 0, 1, &c.viewport.vp);
+				lastViewport = c.viewport.vp;
+				viewportSet = true;
+			}
 			break;
 
 		case VKRRenderCommand::SCISSOR:
-			vkCmdSetScissor(cmd, 0, 1, &c.scissor.scissor);
+			if (!scissorSet || memcmp(&lastScissor, &c.scissor.scissor, sizeof(lastScissor)) != 0) {
+				vkCmdSetScissor(cmd, 0, 1, &c.scissor.scissor);
+				lastScissor = c.scissor.scissor;
+				scissorSet = true;
+			}
 			break;
 
 		case VKRRenderCommand::BLEND:
-			vkCmdSetBlendConstants(cmd, c.blendColor.color);
+			if (!blendSet || memcmp(lastBlend, c.blendColor.color, sizeof(lastBlend)) != 0) {
+				vkCmdSetBlendConstants(cmd, c.blendColor.color);
+				memcpy(lastBlend, c.blendColor.color, sizeof(lastBlend));
+				blendSet = true;
+			}
 			break;
 
 		case VKRRenderCommand::PUSH_CONSTANTS:
@@ -787,22 +910,54 @@ void VulkanQueueRunner::PerformRenderPass(const VKRStep &step, VkCommandBuffer c
 			break;
 
 		case VKRRenderCommand::STENCIL:
-			vkCmdSetStencilWriteMask(cmd, VK_STENCIL_FRONT_AND_BACK, c.stencil.stencilWriteMask);
-			vkCmdSetStencilCompareMask(cmd, VK_STENCIL_FRONT_AND_BACK, c.stencil.stencilCompareMask);
-			vkCmdSetStencilReference(cmd, VK_STENCIL_FRONT_AND_BACK, c.stencil.stencilRef);
+			if (!stencilSet || lastStencilWriteMask != c.stencil.stencilWriteMask ||
+				lastStencilCompareMask != c.stencil.stencilCompareMask || lastStencilRef != c.stencil.stencilRef) {
+				vkCmdSetStencilWriteMask(cmd, VK_STENCIL_FRONT_AND_BACK, c.stencil.stencilWriteMask);
+				vkCmdSetStencilCompareMask(cmd, VK_STENCIL_FRONT_AND_BACK, c.stencil.stencilCompareMask);
+				vkCmdSetStencilReference(cmd, VK_STENCIL_FRONT_AND_BACK, c.stencil.stencilRef);
+				lastStencilWriteMask = c.stencil.stencilWriteMask;
+				lastStencilCompareMask = c.stencil.stencilCompareMask;
+				lastStencilRef = c.stencil.stencilRef;
+				stencilSet = true;
+			}
 			break;
 
 		case VKRRenderCommand::DRAW_INDEXED:
-			vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, c.drawIndexed.pipelineLayout, 0, 1, &c.drawIndexed.ds, c.drawIndexed.numUboOffsets, c.drawIndexed.uboOffsets);
-			vkCmdBindIndexBuffer(cmd, c.drawIndexed.ibuffer, c.drawIndexed.ioffset, c.drawIndexed.indexType);
-			vkCmdBindVertexBuffers(cmd, 0, 1, &c.drawIndexed.vbuffer, &c.drawIndexed.voffset);
+			if (c.drawIndexed.ds != lastDescSet || c.drawIndexed.numUboOffsets != lastNumUboOffsets ||
+				memcmp(lastUboOffsets, c.drawIndexed.uboOffsets, c.drawIndexed.numUboOffsets * sizeof(uint32_t)) != 0) {
+				vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, c.drawIndexed.pipelineLayout, 0, 1, &c.drawIndexed.ds, c.drawIndexed.numUboOffsets, c.drawIndexed.uboOffsets);
+				lastDescSet = c.drawIndexed.ds;
+				lastNumUboOffsets = c.drawIndexed.numUboOffsets;
+				memcpy(lastUboOffsets, c.drawIndexed.uboOffsets, sizeof(lastUboOffsets));
+			}
+			if (c.drawIndexed.ibuffer != lastIndexBuffer || c.drawIndexed.ioffset != lastIndexOffset || c.drawIndexed.indexType != lastIndexType) {
+				vkCmdBindIndexBuffer(cmd, c.drawIndexed.ibuffer, c.drawIndexed.ioffset, c.drawIndexed.indexType);
+				lastIndexBuffer = c.drawIndexed.ibuffer;
+				lastIndexOffset = c.drawIndexed.ioffset;
+				lastIndexType = c.drawIndexed.indexType;
+			}
+			if (c.drawIndexed.vbuffer != lastVertexBuffer || c.drawIndexed.voffset != lastVertexOffset) {
+				vkCmdBindVertexBuffers(cmd, 0, 1, &c.drawIndexed.vbuffer, &c.drawIndexed.voffset);
+				lastVertexBuffer = c.drawIndexed.vbuffer;
+				lastVertexOffset = c.drawIndexed.voffset;
+			}
 			vkCmdDrawIndexed(cmd, c.drawIndexed.count, c.drawIndexed.instances, 0, 0, 0);
 			break;
 
 		case VKRRenderCommand::DRAW:
-			vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, c.draw.pipelineLayout, 0, 1, &c.draw.ds, c.draw.numUboOffsets, c.draw.uboOffsets);
+			if (c.draw.ds != lastDescSet || c.draw.numUboOffsets != lastNumUboOffsets ||
+				memcmp(lastUboOffsets, c.draw.uboOffsets, c.draw.numUboOffsets * sizeof(uint32_t)) != 0) {
+				vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, c.draw.pipelineLayout, 0, 1, &c.draw.ds, c.draw.numUboOffsets, c.draw.uboOffsets);
+				lastDescSet = c.draw.ds;
+				lastNumUboOffsets = c.draw.numUboOffsets;
+				memcpy(lastUboOffsets, c.draw.uboOffsets, sizeof(lastUboOffsets));
+			}
 			if (c.draw.vbuffer) {
-				vkCmdBindVertexBuffers(cmd, 0, 1, &c.draw.vbuffer, &c.draw.voffset);
+				if (c.draw.vbuffer != lastVertexBuffer || c.draw.voffset != lastVertexOffset) {
+					vkCmdBindVertexBuffers(cmd, 0, 1, &c.draw.vbuffer, &c.draw.voffset);
+					lastVertexBuffer = c.draw.vbuffer;
+					lastVertexOffset = c.draw.voffset;
+				}
 			}
 			vkCmdDraw(cmd, c.draw.count, 1, 0, 0);
 			break;
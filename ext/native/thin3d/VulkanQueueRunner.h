@@ -220,6 +220,12 @@ public:
 		hacksEnabled_ = hacks;
 	}
 
+	// Number of render passes actually recorded last time RunSteps ran, after merging
+	// and skipping empty ones. Written on the render thread, only read for stats display.
+	int GetNumPassesOfLastFrame() const {
+		return numRenderPassesLastFrame_;
+	}
+
 private:
 	void InitBackbufferRenderPass();
 
@@ -238,6 +244,8 @@ private:
 
 	void ResizeReadbackBuffer(VkDeviceSize requiredSize);
 
+	void MergeRenderSteps(std::vector<VKRStep *> &steps);
+
 	void ApplyMGSHack(std::vector<VKRStep *> &steps);
 	void ApplySonicHack(std::vector<VKRStep *> &steps);
 
@@ -264,4 +272,6 @@ private:
 
 	// TODO: Enable based on compat.ini.
 	uint32_t hacksEnabled_ = 0;
+
+	int numRenderPassesLastFrame_ = 0;
 };
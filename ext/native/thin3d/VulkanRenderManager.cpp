@@ -4,6 +4,7 @@
 #include "Common/Log.h"
 #include "base/logging.h"
 
+#include "base/timeutil.h"
 #include "Common/Vulkan/VulkanContext.h"
 #include "thin3d/VulkanRenderManager.h"
 #include "thread/threadutil.h"
@@ -184,6 +185,12 @@ void VulkanRenderManager::CreateBackbuffers() {
 	}
 	delete[] swapchainImages;
 
+	// Recreating the swapchain invalidates any queued present IDs and timing history.
+	presentId_ = 0;
+	lastPresentTime_ = 0.0;
+	lastActualPresentTime_ = 0;
+	refreshCycleNanos_ = 0;
+
 	// Must be before InitBackbufferRenderPass.
 	if (InitDepthStencilBuffer(cmdInit)) {
 		InitBackbufferFramebuffers(vulkan_->GetBackbufferWidth(), vulkan_->GetBackbufferHeight());
@@ -967,18 +974,89 @@ void VulkanRenderManager::EndSubmitFrame(int frame) {
 		present.pWaitSemaphores = &renderingCompleteSemaphore_;
 		present.waitSemaphoreCount = 1;
 
+		// Tag the present with an ID so we can match up VK_GOOGLE_display_timing feedback later.
+		VkPresentTimeGOOGLE presentTime{ ++presentId_, 0 };
+		VkPresentTimesInfoGOOGLE presentTimeInfo{ VK_STRUCTURE_TYPE_PRESENT_TIMES_INFO_GOOGLE };
+		presentTimeInfo.swapchainCount = 1;
+		presentTimeInfo.pTimes = &presentTime;
+		if (vulkan_->DeviceExtensions().GOOGLE_display_timing) {
+			present.pNext = &presentTimeInfo;
+		}
+
 		VkResult res = vkQueuePresentKHR(vulkan_->GetGraphicsQueue(), &present);
 		// TODO: Deal with VK_SUBOPTIMAL_KHR ?
 		if (res == VK_ERROR_OUT_OF_DATE_KHR || res == VK_SUBOPTIMAL_KHR) {
 			// ignore, it'll be fine. this happens sometimes during resizes, and we do make sure to recreate the swap chain.
 		} else {
 			_assert_msg_(G3D, res == VK_SUCCESS, "vkQueuePresentKHR failed! result=%s", VulkanResultToString(res));
+			UpdatePresentTiming();
 		}
 	} else {
 		frameData.skipSwap = false;
 	}
 }
 
+void VulkanRenderManager::UpdatePresentTiming() {
+	presentTiming_.framesPresented++;
+
+	// Always keep a CPU-side estimate of the present interval going, it's all we have
+	// without the extension.
+	double now = time_now_d();
+	if (lastPresentTime_ != 0.0) {
+		double intervalMs = (now - lastPresentTime_) * 1000.0;
+		if (presentTiming_.presentIntervalMs == 0.0) {
+			presentTiming_.presentIntervalMs = intervalMs;
+		} else {
+			presentTiming_.presentIntervalMs += (intervalMs - presentTiming_.presentIntervalMs) * 0.05;
+		}
+	}
+	lastPresentTime_ = now;
+
+	if (!vulkan_->DeviceExtensions().GOOGLE_display_timing)
+		return;
+	presentTiming_.hasDisplayTiming = true;
+
+	VkSwapchainKHR swapchain = vulkan_->GetSwapchain();
+	if (refreshCycleNanos_ == 0) {
+		VkRefreshCycleDurationGOOGLE refreshCycle{};
+		if (vkGetRefreshCycleDurationGOOGLE(vulkan_->GetDevice(), swapchain, &refreshCycle) == VK_SUCCESS) {
+			refreshCycleNanos_ = refreshCycle.refreshDuration;
+		}
+		if (refreshCycleNanos_ == 0)
+			return;
+	}
+
+	uint32_t timingCount = 0;
+	VkResult res = vkGetPastPresentationTimingGOOGLE(vulkan_->GetDevice(), swapchain, &timingCount, nullptr);
+	if ((res != VK_SUCCESS && res != VK_INCOMPLETE) || timingCount == 0)
+		return;
+	std::vector<VkPastPresentationTimingGOOGLE> timings(timingCount);
+	res = vkGetPastPresentationTimingGOOGLE(vulkan_->GetDevice(), swapchain, &timingCount, timings.data());
+	if (res != VK_SUCCESS && res != VK_INCOMPLETE)
+		return;
+
+	for (uint32_t i = 0; i < timingCount; i++) {
+		const VkPastPresentationTimingGOOGLE &timing = timings[i];
+		if (lastActualPresentTime_ != 0 && timing.actualPresentTime > lastActualPresentTime_) {
+			// Count how many refresh periods passed between consecutive presents - anything
+			// beyond one means we missed vsyncs.
+			uint64_t delta = timing.actualPresentTime - lastActualPresentTime_;
+			int periods = (int)((delta + refreshCycleNanos_ / 2) / refreshCycleNanos_);
+			if (periods > 1) {
+				presentTiming_.framesDropped += periods - 1;
+			}
+		}
+		lastActualPresentTime_ = timing.actualPresentTime;
+
+		double marginMs = (double)timing.presentMargin * (1.0 / 1000000.0);
+		if (presentTiming_.presentMarginMs == 0.0) {
+			presentTiming_.presentMarginMs = marginMs;
+		} else {
+			presentTiming_.presentMarginMs += (marginMs - presentTiming_.presentMarginMs) * 0.05;
+		}
+	}
+}
+
 void VulkanRenderManager::Run(int frame) {
 	BeginSubmitFrame(frame);
 
@@ -237,6 +237,19 @@ public:
 		return vulkan_;
 	}
 
+	// Present timing feedback, gathered from VK_GOOGLE_display_timing where available
+	// and from CPU-side timestamps otherwise. For the debug stats overlay.
+	struct PresentTimingStats {
+		double presentIntervalMs = 0.0;
+		double presentMarginMs = 0.0;
+		int framesPresented = 0;
+		int framesDropped = 0;
+		bool hasDisplayTiming = false;
+	};
+	const PresentTimingStats &GetPresentTimingStats() const {
+		return presentTiming_;
+	}
+
 	// Be careful with this. Only meant to be used for fetching render passes for shader cache initialization.
 	VulkanQueueRunner *GetQueueRunner() {
 		return &queueRunner_;
@@ -248,6 +261,7 @@ private:
 	void BeginSubmitFrame(int frame);
 	void EndSubmitFrame(int frame);
 	void Submit(int frame, bool triggerFence);
+	void UpdatePresentTiming();
 
 	// Bad for performance but sometimes necessary for synchronous CPU readbacks (screenshots and whatnot).
 	void FlushSync();
@@ -319,6 +333,13 @@ private:
 	};
 	DepthBufferInfo depth_;
 
+	// Present timing state. Only touched on the submission thread.
+	PresentTimingStats presentTiming_;
+	double lastPresentTime_ = 0.0;
+	uint32_t presentId_ = 0;
+	uint64_t lastActualPresentTime_ = 0;
+	uint64_t refreshCycleNanos_ = 0;
+
 	// This works great - except see issue #10097. WTF?
 	bool useThread_ = true;
 };
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "base/logging.h"
 #include "thread/threadpool.h"
 #include "thread/threadutil.h"
@@ -34,6 +36,7 @@ void WorkerThread::WaitForCompletion() {
 
 void WorkerThread::WorkFunc() {
 	setCurrentThreadName("Worker");
+	setCurrentThreadAffinityClass(THREAD_AFFINITY_PERFORMANCE);
 	std::unique_lock<std::mutex> guard(mutex);
 	started = true;
 	while (active) {
@@ -64,6 +67,8 @@ void LoopWorkerThread::Process(const std::function<void(int, int)> &work, int st
 
 void LoopWorkerThread::WorkFunc() {
 	setCurrentThreadName("LoopWorker");
+	// Parallel loops block their caller, so the workers are latency-critical.
+	setCurrentThreadAffinityClass(THREAD_AFFINITY_PERFORMANCE);
 	std::unique_lock<std::mutex> guard(mutex);
 	started = true;
 	while (active) {
@@ -101,27 +106,76 @@ void ThreadPool::StartWorkers() {
 	}
 }
 
+void ThreadPool::DispatchLocked(const std::function<void(int,int)> &loop, int lower, int upper, bool callerHelps) {
+	// All runners pull chunks from a shared cursor until the range is drained,
+	// so a slow chunk only delays its own runner instead of the whole join.
+	// Several chunks per runner keeps the granularity fine enough to balance.
+	int range = upper - lower;
+	const int chunk = std::max(1, range / (numThreads_ * 4));
+	auto cursor = std::make_shared<std::atomic<int>>(lower);
+	std::function<void(int, int)> runner = [loop, cursor, upper, chunk](int, int) {
+		int s;
+		while ((s = cursor->fetch_add(chunk)) < upper) {
+			loop(s, std::min(s + chunk, upper));
+		}
+	};
+
+	// When the caller participates it takes the place of one worker.
+	dispatched_ = callerHelps ? numThreads_ - 1 : numThreads_;
+	for (int i = 0; i < dispatched_; ++i) {
+		workers[i]->Process(runner, 0, 0);
+	}
+	if (callerHelps) {
+		runner(0, 0);
+	}
+}
+
+void ThreadPool::DrainLocked() {
+	for (int i = 0; i < dispatched_; ++i) {
+		workers[i]->WaitForCompletion();
+	}
+	dispatched_ = 0;
+	pending_ = false;
+}
+
 void ThreadPool::ParallelLoop(const std::function<void(int,int)> &loop, int lower, int upper) {
 	int range = upper - lower;
 	if (range >= numThreads_ * 2) { // don't parallelize tiny loops (this could be better, maybe add optional parameter that estimates work per iteration)
 		std::lock_guard<std::mutex> guard(mutex);
 		StartWorkers();
+		if (pending_)
+			DrainLocked();
 
-		// could do slightly better load balancing for the generic case, 
-		// but doesn't matter since all our loops are power of 2
-		int chunk = range / numThreads_;
-		int s = lower;
-		for (int i = 0; i < numThreads_ - 1; ++i) {
-			workers[i]->Process(loop, s, s+chunk);
-			s+=chunk;
-		}
-		// This is the final chunk.
-		loop(s, upper);
-		for (int i = 0; i < numThreads_ - 1; ++i) {
-			workers[i]->WaitForCompletion();
-		}
+		++generation_;
+		DispatchLocked(loop, lower, upper, true);
+		DrainLocked();
 	} else {
 		loop(lower, upper);
 	}
 }
 
+std::shared_ptr<ThreadPool::LoopToken> ThreadPool::ParallelLoopAsync(const std::function<void(int,int)> &loop, int lower, int upper) {
+	if (upper <= lower) {
+		// Nothing to do - hand back a token that's already done.
+		return std::shared_ptr<LoopToken>(new LoopToken(this, -1));
+	}
+
+	std::lock_guard<std::mutex> guard(mutex);
+	StartWorkers();
+	if (pending_)
+		DrainLocked();
+
+	++generation_;
+	DispatchLocked(loop, lower, upper, false);
+	pending_ = true;
+	return std::shared_ptr<LoopToken>(new LoopToken(this, generation_));
+}
+
+void ThreadPool::LoopToken::Wait() {
+	std::lock_guard<std::mutex> guard(pool_->mutex);
+	// If a later loop has run since, it already drained this one.
+	if (pool_->pending_ && pool_->generation_ == generation_) {
+		pool_->DrainLocked();
+	}
+}
+
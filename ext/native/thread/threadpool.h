@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -61,16 +62,43 @@ public:
 	// don't need a destructor, "workers" is cleared on delete, 
 	// leading to the stopping and joining of all worker threads (RAII and all that)
 
+	// Runs the loop across the workers (and the calling thread), returning when
+	// it's done. Iterations are handed out in small chunks from a shared
+	// counter, so uneven work per iteration no longer leaves cores idle at the
+	// end of the range.
 	void ParallelLoop(const std::function<void(int,int)> &loop, int lower, int upper);
 
+	// Like ParallelLoop but returns immediately; the loop runs on the workers
+	// only. Call Wait() on the returned token before using the results. A later
+	// loop submitted to the pool implicitly waits for this one first.
+	class LoopToken {
+	public:
+		void Wait();
+	private:
+		LoopToken(ThreadPool *pool, int generation) : pool_(pool), generation_(generation) {}
+		ThreadPool *pool_;
+		int generation_;
+		friend class ThreadPool;
+	};
+	std::shared_ptr<LoopToken> ParallelLoopAsync(const std::function<void(int,int)> &loop, int lower, int upper);
+
 private:
+	// Both expect mutex to be held.
+	void DispatchLocked(const std::function<void(int,int)> &loop, int lower, int upper, bool callerHelps);
+	void DrainLocked();
+
 	int numThreads_;
 	std::vector<std::shared_ptr<LoopWorkerThread>> workers;
 	std::mutex mutex; // used to sequentialize loop execution
 
 	bool workersStarted;
 	void StartWorkers();
-	
+
+	// Async loop bookkeeping, guarded by mutex.
+	int generation_ = 0;
+	int dispatched_ = 0;
+	bool pending_ = false;
+
 	ThreadPool(const ThreadPool& other); // prevent copies
 	void operator =(const ThreadPool &other);
 };
@@ -16,6 +16,13 @@
 #include <pthread.h>
 #endif
 
+#if defined(__ANDROID__) || (defined(__linux__) && defined(_GNU_SOURCE))
+#define AFFINITY_SUPPORTED
+#include <cstdio>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
 #ifdef TLS_SUPPORTED
 static __THREAD const char *curThreadName;
 #endif
@@ -119,3 +126,97 @@ void AssertCurrentThreadName(const char *threadName) {
 	}
 #endif
 }
+
+#ifdef AFFINITY_SUPPORTED
+
+// Core classes derived from each core's max frequency: the cores that reach
+// the overall max are "performance", the rest "efficiency". Computed once -
+// racing first callers just redo the same work.
+static cpu_set_t perfCoreSet;
+static cpu_set_t effCoreSet;
+static cpu_set_t allCoreSet;
+static bool coreSetsHeterogeneous = false;
+static bool coreSetsComputed = false;
+
+static void computeCoreSets() {
+	if (coreSetsComputed)
+		return;
+
+	CPU_ZERO(&perfCoreSet);
+	CPU_ZERO(&effCoreSet);
+	CPU_ZERO(&allCoreSet);
+
+	long numCores = sysconf(_SC_NPROCESSORS_CONF);
+	if (numCores > CPU_SETSIZE)
+		numCores = CPU_SETSIZE;
+
+	int maxFreq[CPU_SETSIZE]{};
+	int highestFreq = 0;
+	for (long i = 0; i < numCores; ++i) {
+		char path[256];
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%ld/cpufreq/cpuinfo_max_freq", i);
+		FILE *f = fopen(path, "r");
+		if (f) {
+			if (fscanf(f, "%d", &maxFreq[i]) != 1)
+				maxFreq[i] = 0;
+			fclose(f);
+		}
+		if (maxFreq[i] > highestFreq)
+			highestFreq = maxFreq[i];
+	}
+
+	for (long i = 0; i < numCores; ++i) {
+		CPU_SET(i, &allCoreSet);
+		if (maxFreq[i] == highestFreq)
+			CPU_SET(i, &perfCoreSet);
+		else
+			CPU_SET(i, &effCoreSet);
+	}
+
+	// Only constrain threads when there actually are slow cores to avoid.
+	coreSetsHeterogeneous = highestFreq > 0 && CPU_COUNT(&effCoreSet) > 0;
+	coreSetsComputed = true;
+}
+
+#endif
+
+void setCurrentThreadAffinityClass(ThreadAffinityClass affinityClass) {
+#if defined(_WIN32)
+	// Windows doesn't expose big.LITTLE topology through a usable API, but
+	// priority gets the scheduler to make the same call for us.
+	switch (affinityClass) {
+	case THREAD_AFFINITY_PERFORMANCE:
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL);
+		break;
+	case THREAD_AFFINITY_EFFICIENCY:
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+		break;
+	case THREAD_AFFINITY_ANY:
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_NORMAL);
+		break;
+	}
+#elif defined(AFFINITY_SUPPORTED)
+	computeCoreSets();
+	if (!coreSetsHeterogeneous)
+		return;
+
+	const cpu_set_t *set = &allCoreSet;
+	switch (affinityClass) {
+	case THREAD_AFFINITY_PERFORMANCE:
+		set = &perfCoreSet;
+		break;
+	case THREAD_AFFINITY_EFFICIENCY:
+		set = &effCoreSet;
+		break;
+	case THREAD_AFFINITY_ANY:
+		break;
+	}
+
+	// 0 means the calling thread.
+	if (sched_setaffinity(0, sizeof(*set), set) != 0) {
+		WLOG("sched_setaffinity failed for affinity class %d", (int)affinityClass);
+	}
+#else
+	(void)affinityClass;
+#endif
+}
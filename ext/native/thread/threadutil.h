@@ -3,4 +3,23 @@
 // Note that name must be a global string that lives until the end of the process,
 // for assertThreadName to work.
 void setCurrentThreadName(const char *threadName);
-void AssertCurrentThreadName(const char *threadName);
\ No newline at end of file
+void AssertCurrentThreadName(const char *threadName);
+
+// Hint what kind of core the current thread should run on. On big.LITTLE
+// devices the scheduler will happily migrate a hot thread to a little core
+// mid-session; these hints keep the latency-critical threads on the fast
+// cores. Linux/Android uses sched_setaffinity against core classes derived
+// from each core's max frequency, Windows uses thread priority (there's no
+// usable topology API there). Does nothing on other platforms, and nothing
+// when all cores are the same speed.
+enum ThreadAffinityClass {
+	// Threads that gate the frame: emu/CPU, render, and pool workers that
+	// parallel loops block on.
+	THREAD_AFFINITY_PERFORMANCE,
+	// Background threads that shouldn't steal fast cores: read-ahead, cache
+	// write-back, savestate compression.
+	THREAD_AFFINITY_EFFICIENCY,
+	// No placement preference (resets an earlier hint).
+	THREAD_AFFINITY_ANY,
+};
+void setCurrentThreadAffinityClass(ThreadAffinityClass affinityClass);
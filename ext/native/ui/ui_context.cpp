@@ -43,23 +43,29 @@ void UIContext::BeginFrame() {
 	}
 	uidrawbufferTop_->SetCurZ(0.0f);
 	uidrawbuffer_->SetCurZ(0.0f);
+	// Other code (like the game renderer) may have changed the scissor since
+	// last frame, so don't trust the cached rect.
+	scissorValid_ = false;
 	ActivateTopScissor();
 }
 
 void UIContext::Begin() {
 	draw_->BindSamplerStates(0, 1, &sampler_);
 	draw_->BindTexture(0, uitexture_->GetTexture());
+	scissorValid_ = false;
 	UIBegin(ui_pipeline_);
 }
 
 void UIContext::BeginNoTex() {
 	draw_->BindSamplerStates(0, 1, &sampler_);
+	scissorValid_ = false;
 	UIBegin(ui_pipeline_notex_);
 }
 
 void UIContext::BeginPipeline(Draw::Pipeline *pipeline, Draw::SamplerState *samplerState) {
 	draw_->BindSamplerStates(0, 1, &sampler_);
 	draw_->BindTexture(0, uitexture_->GetTexture());
+	scissorValid_ = false;
 	UIBegin(pipeline);
 }
 
@@ -83,7 +89,6 @@ void UIContext::SetCurZ(float curZ) {
 
 // TODO: Support transformed bounds using stencil instead.
 void UIContext::PushScissor(const Bounds &bounds) {
-	Flush();
 	Bounds clipped = TransformBounds(bounds);
 	if (scissorStack_.size())
 		clipped.Clip(scissorStack_.back());
@@ -94,7 +99,6 @@ void UIContext::PushScissor(const Bounds &bounds) {
 }
 
 void UIContext::PopScissor() {
-	Flush();
 	scissorStack_.pop_back();
 	ActivateTopScissor();
 }
@@ -116,13 +120,27 @@ void UIContext::ActivateTopScissor() {
 		int y = floorf(scale_y * bounds.y);
 		int w = std::max(0.0f, ceilf(scale_x * bounds.w));
 		int h = std::max(0.0f, ceilf(scale_y * bounds.h));
-		draw_->SetScissorRect(x, y, w, h);
+		ApplyScissorRect(x, y, w, h);
 	} else {
 		// Avoid rounding errors
-		draw_->SetScissorRect(0, 0, pixel_xres, pixel_yres);
+		ApplyScissorRect(0, 0, pixel_xres, pixel_yres);
 	}
 }
 
+void UIContext::ApplyScissorRect(int x, int y, int w, int h) {
+	// Items in a list often clip to the same effective rect as their neighbors,
+	// so only break the batch when the rect actually changes.
+	if (scissorValid_ && x == scissorX_ && y == scissorY_ && w == scissorW_ && h == scissorH_)
+		return;
+	Flush();
+	draw_->SetScissorRect(x, y, w, h);
+	scissorValid_ = true;
+	scissorX_ = x;
+	scissorY_ = y;
+	scissorW_ = w;
+	scissorH_ = h;
+}
+
 void UIContext::SetFontScale(float scaleX, float scaleY) {
 	fontScaleX_ = scaleX;
 	fontScaleY_ = scaleY;
@@ -109,6 +109,17 @@ private:
 	DrawBuffer *uidrawbuffer_ = nullptr;
 	DrawBuffer *uidrawbufferTop_ = nullptr;
 
+	void ApplyScissorRect(int x, int y, int w, int h);
+
 	std::vector<Bounds> scissorStack_;
 	std::vector<UITransform> transformStack_;
+
+	// The scissor rect last applied to the draw context. Lets adjacent items
+	// clipped to the same effective rect share one flush instead of breaking
+	// the batch on every push/pop.
+	bool scissorValid_ = false;
+	int scissorX_ = 0;
+	int scissorY_ = 0;
+	int scissorW_ = 0;
+	int scissorH_ = 0;
 };
@@ -382,3 +382,18 @@ double CompareScreenshot(const std::vector<u32> &pixels, u32 stride, u32 w, u32
 
 	return (double) errors / (double) (w * h);
 }
+
+double ComparePixelBuffers(const std::vector<u32> &a, const std::vector<u32> &b, u32 stride, u32 w, u32 h)
+{
+	if (a.size() < stride * h || b.size() < stride * h)
+		return -1.0;
+
+	u32 errors = 0;
+	for (u32 y = 0; y < h; ++y)
+	{
+		for (u32 x = 0; x < w; ++x)
+			errors += ComparePixel(a[y * stride + x], b[y * stride + x]);
+	}
+
+	return (double) errors / (double) (w * h);
+}
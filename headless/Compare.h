@@ -32,4 +32,5 @@ std::string GetTestName(const std::string &bootFilename);
 
 bool CompareOutput(const std::string &bootFilename, const std::string &output, bool verbose);
 std::vector<u32> TranslateDebugBufferToCompare(const GPUDebugBuffer *buffer, u32 stride, u32 h);
-double CompareScreenshot(const std::vector<u32> &pixels, u32 stride, u32 w, u32 h, const std::string& screenshotFilename, std::string &error);
\ No newline at end of file
+double CompareScreenshot(const std::vector<u32> &pixels, u32 stride, u32 w, u32 h, const std::string& screenshotFilename, std::string &error);
+double ComparePixelBuffers(const std::vector<u32> &a, const std::vector<u32> &b, u32 stride, u32 w, u32 h);
\ No newline at end of file
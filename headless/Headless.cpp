@@ -2,9 +2,11 @@
 // See headless.txt.
 // To build on non-windows systems, just run CMake in the SDL directory, it will build both a normal ppsspp and the headless version.
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <limits>
+#include <vector>
 
 #include "file/zip_read.h"
 #include "profiler/profiler.h"
@@ -18,7 +20,9 @@
 #include "Core/HLE/sceUtility.h"
 #include "Core/Host.h"
 #include "Core/SaveState.h"
+#include "GPU/GPU.h"
 #include "GPU/Common/FramebufferCommon.h"
+#include "GPU/Common/GPUDebugInterface.h"
 #include "Log.h"
 #include "LogManager.h"
 #include "base/NativeApp.h"
@@ -102,6 +106,18 @@ int printUsage(const char *progname, const char *reason)
 	}
 #endif
 	fprintf(stderr, "  --timeout=SECONDS     abort test it if takes longer than SECONDS\n");
+	fprintf(stderr, "  --bench=FRAMES        benchmark instead of test: run FRAMES frames and\n");
+	fprintf(stderr, "                        print frame time stats as JSON (use --state= for a\n");
+	fprintf(stderr, "                        reproducible starting point)\n");
+	fprintf(stderr, "                        also takes GE dumps (.ppdmp), which replay the same\n");
+	fprintf(stderr, "                        frame with almost no CPU emulation - good for\n");
+	fprintf(stderr, "                        isolating backend regressions with --graphics=\n");
+	fprintf(stderr, "  --bench-compare=BACKEND\n");
+	fprintf(stderr, "                        with --bench=, run twice (on --graphics= and on\n");
+	fprintf(stderr, "                        BACKEND) and print one JSON report with timing\n");
+	fprintf(stderr, "                        deltas and a pixel diff of the final frame - both\n");
+	fprintf(stderr, "                        backends must run on the same graphics context\n");
+	fprintf(stderr, "                        (e.g. gles vs software)\n");
 
 	fprintf(stderr, "  -v, --verbose         show the full passed/failed result\n");
 	fprintf(stderr, "  -i                    use the interpreter\n");
@@ -113,6 +129,24 @@ int printUsage(const char *progname, const char *reason)
 	return 1;
 }
 
+static bool ParseGPUBackend(const char *gpuName, GPUCore *gpuCore) {
+	if (!strcasecmp(gpuName, "gles"))
+		*gpuCore = GPUCORE_GLES;
+	else if (!strcasecmp(gpuName, "software"))
+		*gpuCore = GPUCORE_SOFTWARE;
+	else if (!strcasecmp(gpuName, "directx9"))
+		*gpuCore = GPUCORE_DIRECTX9;
+	else if (!strcasecmp(gpuName, "directx11"))
+		*gpuCore = GPUCORE_DIRECTX11;
+	else if (!strcasecmp(gpuName, "vulkan"))
+		*gpuCore = GPUCORE_VULKAN;
+	else if (!strcasecmp(gpuName, "null"))
+		*gpuCore = GPUCORE_NULL;
+	else
+		return false;
+	return true;
+}
+
 static HeadlessHost *getHost(GPUCore gpuCore) {
 	switch (gpuCore) {
 	case GPUCORE_NULL:
@@ -205,6 +239,284 @@ bool RunAutoTest(HeadlessHost *headlessHost, CoreParameter &coreParameter, bool
 	return passed;
 }
 
+static double BenchPercentile(const std::vector<double> &sorted, double p) {
+	if (sorted.empty())
+		return 0.0;
+	size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+	return sorted[index];
+}
+
+// Everything RunBenchmark measures, so compare mode can run it twice and
+// print a merged report instead of two disjoint ones.
+struct BenchResult {
+	int frames = 0;
+	double meanMs = 0.0;
+	double minMs = 0.0;
+	double p95Ms = 0.0;
+	double p99Ms = 0.0;
+	double maxMs = 0.0;
+	double fps = 0.0;
+	double drawCalls = 0.0;
+	double flushes = 0.0;
+	double verts = 0.0;
+	double texturesDecoded = 0.0;
+	double uploads = 0.0;
+	double readbacks = 0.0;
+	double msDisplayLists = 0.0;
+	double msVertexDecode = 0.0;
+	double msTextureDecode = 0.0;
+	double msReadbacks = 0.0;
+	// Final frame in BGRA, 512 stride x 272, only when requested.
+	std::vector<u32> framebuffer;
+};
+
+// Runs the game for a fixed number of frames and collects frame time
+// statistics, for perf regression tracking. Headless feeds no controller
+// input, so two runs from the same start point (see --state=) execute the
+// same frames.
+// Let the JIT and shader caches warm up before measuring.
+static const int BENCH_WARMUP_FRAMES = 60;
+
+static bool RunBenchmarkPass(HeadlessHost *headlessHost, CoreParameter &coreParameter, int benchFrames, double timeout, bool captureFramebuffer, BenchResult *result)
+{
+	const int warmupFrames = BENCH_WARMUP_FRAMES;
+
+	std::string error_string;
+	if (!PSP_Init(coreParameter, &error_string)) {
+		fprintf(stderr, "Failed to start %s. Error: %s\n", coreParameter.fileToStart.c_str(), error_string.c_str());
+		return false;
+	}
+
+	host->BootDone();
+
+	time_update();
+	bool passed = true;
+	static double deadline;
+	deadline = time_now() + timeout;
+
+	// Collect gpuStats every frame, not just when the debug overlay would.
+	Core_UpdateDebugStats(true);
+
+	PSP_BeginHostFrame();
+	if (coreParameter.thin3d)
+		coreParameter.thin3d->BeginFrame();
+
+	std::vector<double> frameTimes;
+	frameTimes.reserve(benchFrames);
+	double lastFrameTime = time_now_d();
+	int framesDone = 0;
+	double totalDrawCalls = 0.0;
+	double totalFlushes = 0.0;
+	double totalVerts = 0.0;
+	double totalTexturesDecoded = 0.0;
+	double totalUploads = 0.0;
+	double totalReadbacks = 0.0;
+	double totalMsDisplayLists = 0.0;
+	double totalMsVertexDecode = 0.0;
+	double totalMsTextureDecode = 0.0;
+	double totalMsReadbacks = 0.0;
+
+	coreState = CORE_RUNNING;
+	while (coreState == CORE_RUNNING)
+	{
+		int blockTicks = usToCycles(1000000 / 10);
+		PSP_RunLoopFor(blockTicks);
+
+		if (coreState == CORE_NEXTFRAME) {
+			coreState = CORE_RUNNING;
+			headlessHost->SwapBuffers();
+
+			// Snapshots gpuStats into gpuStatsLastFrame and resets for the next frame.
+			Core_UpdateDebugStats(true);
+
+			time_update();
+			double now = time_now_d();
+			framesDone++;
+			if (framesDone > warmupFrames) {
+				frameTimes.push_back(now - lastFrameTime);
+				totalDrawCalls += gpuStatsLastFrame.numDrawCalls;
+				totalFlushes += gpuStatsLastFrame.numFlushes;
+				totalVerts += gpuStatsLastFrame.numVertsSubmitted;
+				totalTexturesDecoded += gpuStatsLastFrame.numTexturesDecoded;
+				totalUploads += gpuStatsLastFrame.numUploads;
+				totalReadbacks += gpuStatsLastFrame.numReadbacks;
+				// Despite the names, these are in seconds.
+				totalMsDisplayLists += gpuStatsLastFrame.msProcessingDisplayLists;
+				totalMsVertexDecode += gpuStatsLastFrame.msVertexDecode;
+				totalMsTextureDecode += gpuStatsLastFrame.msTextureDecode;
+				totalMsReadbacks += gpuStatsLastFrame.msReadbacks;
+			}
+			lastFrameTime = now;
+
+			if (framesDone >= warmupFrames + benchFrames)
+				Core_Stop();
+		}
+		time_update();
+		if (time_now_d() > deadline) {
+			fprintf(stderr, "Benchmark timeout after %d frames\n", framesDone);
+			passed = false;
+			Core_Stop();
+		}
+	}
+	PSP_EndHostFrame();
+
+	if (coreParameter.thin3d)
+		coreParameter.thin3d->EndFrame();
+
+	if (captureFramebuffer && gpuDebug) {
+		GPUDebugBuffer buffer;
+		if (gpuDebug->GetCurrentFramebuffer(buffer, GPU_DBG_FRAMEBUF_RENDER))
+			result->framebuffer = TranslateDebugBufferToCompare(&buffer, 512, 272);
+	}
+
+	PSP_Shutdown();
+
+	headlessHost->FlushDebugOutput();
+
+	if (frameTimes.empty())
+		return false;
+
+	double totalTime = 0.0;
+	for (double t : frameTimes)
+		totalTime += t;
+
+	std::vector<double> sorted = frameTimes;
+	std::sort(sorted.begin(), sorted.end());
+
+	int measured = (int)frameTimes.size();
+	result->frames = measured;
+	result->meanMs = totalTime * 1000.0 / measured;
+	result->minMs = sorted.front() * 1000.0;
+	result->p95Ms = BenchPercentile(sorted, 0.95) * 1000.0;
+	result->p99Ms = BenchPercentile(sorted, 0.99) * 1000.0;
+	result->maxMs = sorted.back() * 1000.0;
+	result->fps = measured / totalTime;
+	result->drawCalls = totalDrawCalls / measured;
+	result->flushes = totalFlushes / measured;
+	result->verts = totalVerts / measured;
+	result->texturesDecoded = totalTexturesDecoded / measured;
+	result->uploads = totalUploads / measured;
+	result->readbacks = totalReadbacks / measured;
+	result->msDisplayLists = totalMsDisplayLists * 1000.0 / measured;
+	result->msVertexDecode = totalMsVertexDecode * 1000.0 / measured;
+	result->msTextureDecode = totalMsTextureDecode * 1000.0 / measured;
+	result->msReadbacks = totalMsReadbacks * 1000.0 / measured;
+
+	return passed;
+}
+
+// The shared part of the per-run JSON: everything except file/frames, so the
+// single-run report and each entry under "runs" in compare mode stay in sync.
+static void PrintBenchResultBody(const BenchResult &res, const char *indent)
+{
+	printf("%s\"frame_time_ms\": {\n", indent);
+	printf("%s  \"mean\": %0.3f,\n", indent, res.meanMs);
+	printf("%s  \"min\": %0.3f,\n", indent, res.minMs);
+	printf("%s  \"p95\": %0.3f,\n", indent, res.p95Ms);
+	printf("%s  \"p99\": %0.3f,\n", indent, res.p99Ms);
+	printf("%s  \"max\": %0.3f\n", indent, res.maxMs);
+	printf("%s},\n", indent);
+	printf("%s\"fps\": %0.2f,\n", indent, res.fps);
+	printf("%s\"per_frame_avg\": {\n", indent);
+	printf("%s  \"draw_calls\": %0.1f,\n", indent, res.drawCalls);
+	printf("%s  \"flushes\": %0.1f,\n", indent, res.flushes);
+	printf("%s  \"verts_submitted\": %0.1f,\n", indent, res.verts);
+	printf("%s  \"textures_decoded\": %0.1f,\n", indent, res.texturesDecoded);
+	printf("%s  \"uploads\": %0.1f,\n", indent, res.uploads);
+	printf("%s  \"readbacks\": %0.1f\n", indent, res.readbacks);
+	printf("%s},\n", indent);
+	printf("%s\"gpu_ms_avg\": {\n", indent);
+	printf("%s  \"display_lists\": %0.3f,\n", indent, res.msDisplayLists);
+	printf("%s  \"vertex_decode\": %0.3f,\n", indent, res.msVertexDecode);
+	printf("%s  \"texture_decode\": %0.3f,\n", indent, res.msTextureDecode);
+	printf("%s  \"readbacks\": %0.3f\n", indent, res.msReadbacks);
+	printf("%s}", indent);
+}
+
+bool RunBenchmark(HeadlessHost *headlessHost, CoreParameter &coreParameter, int benchFrames, double timeout)
+{
+	BenchResult result;
+	bool passed = RunBenchmarkPass(headlessHost, coreParameter, benchFrames, timeout, false, &result);
+	if (result.frames == 0)
+		return false;
+
+	printf("{\n");
+	printf("  \"file\": \"%s\",\n", coreParameter.fileToStart.c_str());
+	printf("  \"frames\": %d,\n", result.frames);
+	printf("  \"warmup_frames\": %d,\n", BENCH_WARMUP_FRAMES);
+	PrintBenchResultBody(result, "  ");
+	printf("\n}\n");
+
+	return passed;
+}
+
+static const char *GPUBackendName(GPUCore core)
+{
+	switch (core) {
+	case GPUCORE_GLES: return "gles";
+	case GPUCORE_SOFTWARE: return "software";
+	case GPUCORE_DIRECTX9: return "directx9";
+	case GPUCORE_DIRECTX11: return "directx11";
+	case GPUCORE_VULKAN: return "vulkan";
+	case GPUCORE_NULL: return "null";
+	default: return "unknown";
+	}
+}
+
+// Runs the same file on two backends back to back and prints one JSON report
+// with both runs, the timing delta and a pixel diff of the final frame. Meant
+// for GE dumps, where both runs replay the exact same draws - when one backend
+// renders a scene slower, the gpu_ms_avg deltas narrow down which stage
+// diverged without bisecting by hand.
+bool RunBenchmarkCompare(HeadlessHost *headlessHost, CoreParameter &coreParameter, int benchFrames, double timeout, GPUCore baselineCore, GPUCore compareCore)
+{
+	BenchResult baseline, compare;
+
+	coreParameter.gpuCore = baselineCore;
+	bool passed = RunBenchmarkPass(headlessHost, coreParameter, benchFrames, timeout, true, &baseline);
+	coreParameter.gpuCore = compareCore;
+	passed = RunBenchmarkPass(headlessHost, coreParameter, benchFrames, timeout, true, &compare) && passed;
+
+	if (baseline.frames == 0 || compare.frames == 0)
+		return false;
+
+	double pixelDiff = ComparePixelBuffers(baseline.framebuffer, compare.framebuffer, 512, 480, 272);
+
+	printf("{\n");
+	printf("  \"file\": \"%s\",\n", coreParameter.fileToStart.c_str());
+	printf("  \"frames\": %d,\n", benchFrames);
+	printf("  \"warmup_frames\": %d,\n", BENCH_WARMUP_FRAMES);
+	printf("  \"runs\": {\n");
+	printf("    \"baseline\": {\n");
+	printf("      \"backend\": \"%s\",\n", GPUBackendName(baselineCore));
+	PrintBenchResultBody(baseline, "      ");
+	printf("\n    },\n");
+	printf("    \"compare\": {\n");
+	printf("      \"backend\": \"%s\",\n", GPUBackendName(compareCore));
+	PrintBenchResultBody(compare, "      ");
+	printf("\n    }\n");
+	printf("  },\n");
+	printf("  \"delta\": {\n");
+	printf("    \"frame_time_mean_ms\": %+0.3f,\n", compare.meanMs - baseline.meanMs);
+	printf("    \"frame_time_ratio\": %0.3f,\n", baseline.meanMs > 0.0 ? compare.meanMs / baseline.meanMs : 0.0);
+	printf("    \"gpu_ms_avg\": {\n");
+	printf("      \"display_lists\": %+0.3f,\n", compare.msDisplayLists - baseline.msDisplayLists);
+	printf("      \"vertex_decode\": %+0.3f,\n", compare.msVertexDecode - baseline.msVertexDecode);
+	printf("      \"texture_decode\": %+0.3f,\n", compare.msTextureDecode - baseline.msTextureDecode);
+	printf("      \"readbacks\": %+0.3f\n", compare.msReadbacks - baseline.msReadbacks);
+	printf("    }\n");
+	printf("  },\n");
+	printf("  \"output_diff\": {\n");
+	if (pixelDiff >= 0.0)
+		printf("    \"pixels_different\": %0.6f\n", pixelDiff);
+	else
+		printf("    \"pixels_different\": null\n");
+	printf("  }\n");
+	printf("}\n");
+
+	return passed;
+}
+
 int main(int argc, const char* argv[])
 {
 	PROFILE_INIT();
@@ -231,6 +543,9 @@ int main(int argc, const char* argv[])
 	const char *mountRoot = 0;
 	const char *screenshotFilename = 0;
 	float timeout = std::numeric_limits<float>::infinity();
+	int benchFrames = 0;
+	bool benchCompare = false;
+	GPUCore benchCompareCore = GPUCORE_NULL;
 
 	for (int i = 1; i < argc; i++)
 	{
@@ -260,20 +575,7 @@ int main(int argc, const char* argv[])
 			verbose = true;
 		else if (!strncmp(argv[i], "--graphics=", strlen("--graphics=")) && strlen(argv[i]) > strlen("--graphics="))
 		{
-			const char *gpuName = argv[i] + strlen("--graphics=");
-			if (!strcasecmp(gpuName, "gles"))
-				gpuCore = GPUCORE_GLES;
-			else if (!strcasecmp(gpuName, "software"))
-				gpuCore = GPUCORE_SOFTWARE;
-			else if (!strcasecmp(gpuName, "directx9"))
-				gpuCore = GPUCORE_DIRECTX9;
-			else if (!strcasecmp(gpuName, "directx11"))
-				gpuCore = GPUCORE_DIRECTX11;
-			else if (!strcasecmp(gpuName, "vulkan"))
-				gpuCore = GPUCORE_VULKAN;
-			else if (!strcasecmp(gpuName, "null"))
-				gpuCore = GPUCORE_NULL;
-			else
+			if (!ParseGPUBackend(argv[i] + strlen("--graphics="), &gpuCore))
 				return printUsage(argv[0], "Unknown gpu backend specified after --graphics=. Allowed: software, directx9, directx11, vulkan, gles, null.");
 		}
 		// Default to GLES if no value selected.
@@ -283,6 +585,18 @@ int main(int argc, const char* argv[])
 			screenshotFilename = argv[i] + strlen("--screenshot=");
 		else if (!strncmp(argv[i], "--timeout=", strlen("--timeout=")) && strlen(argv[i]) > strlen("--timeout="))
 			timeout = strtod(argv[i] + strlen("--timeout="), NULL);
+		else if (!strncmp(argv[i], "--bench=", strlen("--bench=")) && strlen(argv[i]) > strlen("--bench="))
+		{
+			benchFrames = atoi(argv[i] + strlen("--bench="));
+			if (benchFrames <= 0)
+				return printUsage(argv[0], "--bench= takes a positive frame count");
+		}
+		else if (!strncmp(argv[i], "--bench-compare=", strlen("--bench-compare=")) && strlen(argv[i]) > strlen("--bench-compare="))
+		{
+			if (!ParseGPUBackend(argv[i] + strlen("--bench-compare="), &benchCompareCore))
+				return printUsage(argv[0], "Unknown gpu backend specified after --bench-compare=. Allowed: software, directx9, directx11, vulkan, gles, null.");
+			benchCompare = true;
+		}
 		else if (!strcmp(argv[i], "--teamcity"))
 			teamCityMode = true;
 		else if (!strncmp(argv[i], "--state=", strlen("--state=")) && strlen(argv[i]) > strlen("--state="))
@@ -307,6 +621,9 @@ int main(int argc, const char* argv[])
 	if (testFilenames.empty())
 		return printUsage(argv[0], argc <= 1 ? NULL : "No executables specified");
 
+	if (benchCompare && benchFrames <= 0)
+		return printUsage(argv[0], "--bench-compare= requires --bench=");
+
 	HeadlessHost *headlessHost = getHost(gpuCore);
 	headlessHost->SetGraphicsCore(gpuCore);
 	host = headlessHost;
@@ -415,7 +732,13 @@ int main(int argc, const char* argv[])
 		coreParameter.fileToStart = testFilenames[i];
 		if (autoCompare)
 			printf("%s:\n", coreParameter.fileToStart.c_str());
-		bool passed = RunAutoTest(headlessHost, coreParameter, autoCompare, verbose, timeout);
+		bool passed;
+		if (benchFrames > 0 && benchCompare)
+			passed = RunBenchmarkCompare(headlessHost, coreParameter, benchFrames, timeout, glWorking ? gpuCore : GPUCORE_NULL, benchCompareCore);
+		else if (benchFrames > 0)
+			passed = RunBenchmark(headlessHost, coreParameter, benchFrames, timeout);
+		else
+			passed = RunAutoTest(headlessHost, coreParameter, autoCompare, verbose, timeout);
 		if (autoCompare)
 		{
 			std::string testName = GetTestName(coreParameter.fileToStart);
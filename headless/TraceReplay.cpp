@@ -0,0 +1,196 @@
+// Replays a block device I/O trace (see BlockDevice::StartIOTrace()) against
+// a disc image, optionally through one of the caching file loaders. Useful for
+// benchmarking loader changes against real access patterns without the disc
+// that produced them - only the block numbers matter, not the data.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "base/NativeApp.h"
+#include "base/timeutil.h"
+#include "thread/threadutil.h"
+#include "Common/CommonTypes.h"
+#include "Core/Loaders.h"
+#include "Core/Host.h"
+#include "Core/FileLoaders/CachingFileLoader.h"
+#include "Core/FileLoaders/DiskCachingFileLoader.h"
+#include "Core/FileLoaders/RamCachingFileLoader.h"
+#include "Core/FileSystems/BlockDevices.h"
+#include "Log.h"
+#include "LogManager.h"
+
+#include "StubHost.h"
+
+// Temporary hacks around annoying linking errors, same as Headless.cpp.
+void NativeUpdate() { }
+void NativeRender(GraphicsContext *graphicsContext) { }
+void NativeResized() { }
+
+std::string System_GetProperty(SystemProperty prop) { return ""; }
+int System_GetPropertyInt(SystemProperty prop) {
+	return -1;
+}
+bool System_GetPropertyBool(SystemProperty prop) {
+	return false;
+}
+void System_SendMessage(const char *command, const char *parameter) {}
+bool System_InputBoxGetWString(const wchar_t *title, const std::wstring &defaultvalue, std::wstring &outvalue) { return false; }
+void System_AskForPermission(SystemPermission permission) {}
+PermissionStatus System_GetPermissionStatus(SystemPermission permission) { return PERMISSION_STATUS_GRANTED; }
+
+class PrintfLogger : public LogListener {
+public:
+	void Log(const LogMessage &message) {
+		fprintf(stderr, "%s", message.msg.c_str());
+	}
+};
+
+static int printUsage(const char *progname, const char *reason) {
+	if (reason != NULL)
+		fprintf(stderr, "Error: %s\n\n", reason);
+	fprintf(stderr, "PPSSPP I/O trace replay\n");
+	fprintf(stderr, "Usage: %s [options] trace.bin disc.iso\n\n", progname);
+	fprintf(stderr, "Options:\n");
+	fprintf(stderr, "  --timed               pace reads by the trace timestamps\n");
+	fprintf(stderr, "  --cache               replay through CachingFileLoader\n");
+	fprintf(stderr, "  --ram-cache           replay through RamCachingFileLoader\n");
+	fprintf(stderr, "  --disk-cache=DIR      replay through DiskCachingFileLoader, cache in DIR\n");
+	fprintf(stderr, "  -l, --log             full log output\n");
+	return 1;
+}
+
+static bool LoadTrace(const std::string &path, std::vector<BlockDeviceTraceEntry> &entries) {
+	FILE *f = fopen(path.c_str(), "rb");
+	if (!f)
+		return false;
+
+	char magic[8];
+	if (fread(magic, sizeof(magic), 1, f) != 1 || memcmp(magic, "PPIOTRC1", sizeof(magic)) != 0) {
+		fclose(f);
+		return false;
+	}
+
+	BlockDeviceTraceEntry entry;
+	while (fread(&entry, sizeof(entry), 1, f) == 1)
+		entries.push_back(entry);
+
+	fclose(f);
+	return !entries.empty();
+}
+
+int main(int argc, char *argv[]) {
+	std::string tracePath;
+	std::string discPath;
+	std::string diskCacheDir;
+	bool timed = false;
+	bool useCache = false;
+	bool useRamCache = false;
+	bool useDiskCache = false;
+	bool fullLog = false;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--timed"))
+			timed = true;
+		else if (!strcmp(argv[i], "--cache"))
+			useCache = true;
+		else if (!strcmp(argv[i], "--ram-cache"))
+			useRamCache = true;
+		else if (!strncmp(argv[i], "--disk-cache=", strlen("--disk-cache="))) {
+			useDiskCache = true;
+			diskCacheDir = argv[i] + strlen("--disk-cache=");
+		} else if (!strcmp(argv[i], "-l") || !strcmp(argv[i], "--log"))
+			fullLog = true;
+		else if (tracePath.empty())
+			tracePath = argv[i];
+		else if (discPath.empty())
+			discPath = argv[i];
+		else
+			return printUsage(argv[0], "Too many arguments");
+	}
+
+	if (tracePath.empty() || discPath.empty())
+		return printUsage(argv[0], argc <= 1 ? NULL : "Need both a trace and a disc image");
+	if (useCache + useRamCache + useDiskCache > 1)
+		return printUsage(argv[0], "Only one caching loader at a time");
+
+	host = new HeadlessHost();
+
+	LogManager::Init();
+	LogManager *logman = LogManager::GetInstance();
+	PrintfLogger *printfLogger = new PrintfLogger();
+	for (int i = 0; i < LogTypes::NUMBER_OF_LOGS; i++) {
+		LogTypes::LOG_TYPE type = (LogTypes::LOG_TYPE)i;
+		logman->SetEnabled(type, fullLog);
+		logman->SetLogLevel(type, LogTypes::LDEBUG);
+	}
+	logman->AddListener(printfLogger);
+
+	std::vector<BlockDeviceTraceEntry> trace;
+	if (!LoadTrace(tracePath, trace)) {
+		fprintf(stderr, "Could not read trace file %s\n", tracePath.c_str());
+		return 1;
+	}
+
+	FileLoader *loader = ConstructFileLoader(discPath);
+	if (!loader->Exists()) {
+		fprintf(stderr, "Could not open disc image %s\n", discPath.c_str());
+		delete loader;
+		return 1;
+	}
+	if (useCache) {
+		loader = new CachingFileLoader(loader);
+	} else if (useRamCache) {
+		loader = new RamCachingFileLoader(loader);
+	} else if (useDiskCache) {
+		DiskCachingFileLoaderCache::SetCacheDir(diskCacheDir);
+		loader = new DiskCachingFileLoader(loader);
+	}
+
+	BlockDevice *device = constructBlockDevice(loader);
+	if (!device) {
+		fprintf(stderr, "Could not construct a block device for %s\n", discPath.c_str());
+		delete loader;
+		return 1;
+	}
+
+	u32 maxCount = 1;
+	for (const auto &entry : trace) {
+		if (entry.count > maxCount)
+			maxCount = entry.count;
+	}
+	std::vector<u8> buf(maxCount * 2048);
+
+	u64 totalBlocks = 0;
+	int errors = 0;
+	const double start = real_time_now();
+	for (const auto &entry : trace) {
+		if (timed) {
+			double target = start + entry.timeUs / 1000000.0;
+			double now = real_time_now();
+			if (target > now)
+				sleep_ms((int)((target - now) * 1000.0));
+		}
+		if (!device->ReadBlocks(entry.block, entry.count, buf.data()))
+			++errors;
+		totalBlocks += entry.count;
+	}
+	const double elapsed = real_time_now() - start;
+
+	const double mb = totalBlocks * 2048.0 / (1024.0 * 1024.0);
+	printf("%d reads, %.2f MB in %.3f s (%.2f MB/s)%s\n", (int)trace.size(), mb, elapsed,
+		elapsed > 0.0 ? mb / elapsed : 0.0, errors ? " - with read errors" : "");
+
+	delete device;
+	// The block device doesn't own the loader.
+	delete loader;
+
+	delete host;
+	host = nullptr;
+	logman->RemoveListener(printfLogger);
+	LogManager::Shutdown();
+	delete printfLogger;
+
+	return errors ? 1 : 0;
+}
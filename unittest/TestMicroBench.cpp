@@ -0,0 +1,178 @@
+// Copyright (c) 2015- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+// Microbenchmarks for the hand-written kernels, so SIMD changes can be
+// measured instead of shipped on faith. Run with "unitTest MicroBench".
+//
+// Each result is printed as one pipe-separated line:
+//   BENCH|<name>|<unit>|<ns per unit>|<M units per second>
+// which is easy to parse and diff across commits.
+
+#include <cstdio>
+#include <cstring>
+
+#include "base/timeutil.h"
+#include "Common/Common.h"
+#include "Common/ColorConv.h"
+#include "Common/MemoryUtil.h"
+#include "Common/Swap.h"
+#include "GPU/ge_constants.h"
+#include "GPU/Common/IndexGenerator.h"
+#include "GPU/Common/TextureDecoder.h"
+#include "unittest/TestMicroBench.h"
+
+// Keeps the optimizer from dropping the benchmarked work.
+static volatile u32 benchSink;
+
+// Runs fn repeatedly for about half a second, returns seconds per call.
+template <typename F>
+static double BenchTime(F fn) {
+	double st = real_time_now();
+	int calls = 0;
+	do {
+		for (int i = 0; i < 10; ++i) {
+			fn();
+		}
+		calls += 10;
+	} while (real_time_now() - st < 0.5);
+	return (real_time_now() - st) / calls;
+}
+
+// We report ns per element rather than cycles - there's no portable cycle
+// counter, and ns on a pinned machine tracks the same regressions.
+static void ReportBench(const char *name, double secsPerCall, double unitsPerCall, const char *unit) {
+	double nsPerUnit = secsPerCall * 1000000000.0 / unitsPerCall;
+	double mUnitsPerSec = unitsPerCall / secsPerCall / 1000000.0;
+	printf("BENCH|%s|%s|%0.4f|%0.2f\n", name, unit, nsPerUnit, mUnitsPerSec);
+}
+
+static void FillPattern(u8 *p, size_t sz) {
+	u32 state = 0x12345678;
+	for (size_t i = 0; i < sz; ++i) {
+		// Cheap LCG, just want non-constant data.
+		state = state * 1664525 + 1013904223;
+		p[i] = state >> 24;
+	}
+}
+
+static void BenchTexHashes() {
+	static const u32 SIZE = 512 * 1024;
+	u8 *buf = (u8 *)AllocateAlignedMemory(SIZE, 16);
+	FillPattern(buf, SIZE);
+
+	ReportBench("QuickTexHash", BenchTime([&] {
+		benchSink += DoQuickTexHash(buf, SIZE);
+	}), SIZE, "byte");
+	ReportBench("StableQuickTexHash", BenchTime([&] {
+		benchSink += StableQuickTexHash(buf, SIZE);
+	}), SIZE, "byte");
+	ReportBench("ReliableHash", BenchTime([&] {
+		benchSink += (u32)DoReliableHash(buf, SIZE, 0x12345678);
+	}), SIZE, "byte");
+
+	FreeAlignedMemory(buf);
+}
+
+static void BenchSwizzle() {
+	// A 256x256 32bpp texture: pitch 1024 bytes, 64x32 16-byte blocks.
+	static const u32 PITCH = 1024;
+	static const int BXC = PITCH / 16;
+	static const int BYC = 256 / 8;
+	static const u32 SIZE = PITCH * 256;
+
+	u8 *swizzled = (u8 *)AllocateAlignedMemory(SIZE, 16);
+	u32 *linear = (u32 *)AllocateAlignedMemory(SIZE, 16);
+	FillPattern(swizzled, SIZE);
+	FillPattern((u8 *)linear, SIZE);
+
+	ReportBench("UnswizzleTex16", BenchTime([&] {
+		DoUnswizzleTex16(swizzled, linear, BXC, BYC, PITCH);
+	}), SIZE, "byte");
+	ReportBench("SwizzleTex16", BenchTime([&] {
+		DoSwizzleTex16(linear, swizzled, BXC, BYC, PITCH);
+	}), SIZE, "byte");
+
+	FreeAlignedMemory(swizzled);
+	FreeAlignedMemory(linear);
+}
+
+static void BenchColorConv() {
+	static const u32 PIXELS = 64 * 1024;
+	u16 *buf16 = (u16 *)AllocateAlignedMemory(PIXELS * sizeof(u16), 16);
+	u32 *buf32 = (u32 *)AllocateAlignedMemory(PIXELS * sizeof(u32), 16);
+	FillPattern((u8 *)buf16, PIXELS * sizeof(u16));
+	FillPattern((u8 *)buf32, PIXELS * sizeof(u32));
+
+	ReportBench("ConvertRGBA4444ToRGBA8888", BenchTime([&] {
+		ConvertRGBA4444ToRGBA8888(buf32, buf16, PIXELS);
+	}), PIXELS, "px");
+	ReportBench("ConvertRGBA565ToRGBA8888", BenchTime([&] {
+		ConvertRGBA565ToRGBA8888(buf32, buf16, PIXELS);
+	}), PIXELS, "px");
+	ReportBench("ConvertRGBA5551ToRGBA8888", BenchTime([&] {
+		ConvertRGBA5551ToRGBA8888(buf32, buf16, PIXELS);
+	}), PIXELS, "px");
+	ReportBench("ConvertRGBA8888ToRGB565", BenchTime([&] {
+		ConvertRGBA8888ToRGB565(buf16, buf32, PIXELS);
+	}), PIXELS, "px");
+	ReportBench("ConvertRGBA8888ToRGBA4444", BenchTime([&] {
+		ConvertRGBA8888ToRGBA4444(buf16, buf32, PIXELS);
+	}), PIXELS, "px");
+
+	FreeAlignedMemory(buf16);
+	FreeAlignedMemory(buf32);
+}
+
+static void BenchIndexGenerator() {
+	static const int VERTS = 2048;
+	// Worst case expansion is 3 output indices per input vertex (strips/fans).
+	static u16 indexBuffer[VERTS * 3];
+	static u16_le inds[VERTS];
+	for (int i = 0; i < VERTS; ++i) {
+		inds[i] = (u16)i;
+	}
+
+	IndexGenerator indexGen;
+	ReportBench("IndexGen.AddStrip", BenchTime([&] {
+		indexGen.Setup(indexBuffer);
+		indexGen.AddPrim(GE_PRIM_TRIANGLE_STRIP, VERTS);
+	}), VERTS, "vtx");
+	ReportBench("IndexGen.AddList", BenchTime([&] {
+		indexGen.Setup(indexBuffer);
+		indexGen.AddPrim(GE_PRIM_TRIANGLES, VERTS);
+	}), VERTS, "vtx");
+	ReportBench("IndexGen.TranslateList16", BenchTime([&] {
+		indexGen.Setup(indexBuffer);
+		indexGen.TranslatePrim(GE_PRIM_TRIANGLES, VERTS, inds, 0, true);
+	}), VERTS, "vtx");
+	benchSink += indexBuffer[0];
+}
+
+bool TestMicroBench() {
+	// SasAudio mixing and IR interpreter dispatch need a booted guest (memory,
+	// kernel objects), so they're measured through the Jit test harness and the
+	// headless --bench mode instead of here.
+	SetupTextureDecoder();
+	SetupColorConv();
+
+	BenchTexHashes();
+	BenchSwizzle();
+	BenchColorConv();
+	BenchIndexGenerator();
+
+	return true;
+}
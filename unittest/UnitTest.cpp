@@ -46,6 +46,7 @@
 #include "GPU/Common/TextureDecoder.h"
 
 #include "unittest/JitHarness.h"
+#include "unittest/TestMicroBench.h"
 #include "unittest/TestVertexJit.h"
 #include "unittest/UnitTest.h"
 
@@ -268,7 +269,7 @@ bool TestParsers() {
 	return true;
 }
 
-bool TestVFPUSinCos() {
+static bool TestVFPUSinCosImpl() {
 	float sine, cosine;
 	vfpu_sincos(0.0f, sine, cosine);
 	EXPECT_EQ_FLOAT(sine, 0.0f);
@@ -289,14 +290,37 @@ bool TestVFPUSinCos() {
 	EXPECT_APPROX_EQ_FLOAT(sine, 1.0f);
 	EXPECT_APPROX_EQ_FLOAT(cosine, 0.0f);
 
-	for (float angle = -10.0f; angle < 10.0f; angle++) {
+	for (float angle = -10.0f; angle < 10.0f; angle += 0.1f) {
 		vfpu_sincos(angle, sine, cosine);
 		EXPECT_APPROX_EQ_FLOAT(sine, sinf(angle * M_PI_2));
 		EXPECT_APPROX_EQ_FLOAT(cosine, cosf(angle * M_PI_2));
+
+		EXPECT_APPROX_EQ_FLOAT(vfpu_sin(angle), sinf(angle * M_PI_2));
+		EXPECT_APPROX_EQ_FLOAT(vfpu_cos(angle), cosf(angle * M_PI_2));
+	}
+
+	EXPECT_EQ_FLOAT(vfpu_exp2(0.0f), 1.0f);
+	EXPECT_EQ_FLOAT(vfpu_exp2(1.0f), 2.0f);
+	EXPECT_EQ_FLOAT(vfpu_exp2(-1.0f), 0.5f);
+	for (float x = -10.0f; x < 10.0f; x += 0.1f) {
+		// Compare the ratio so the check is relative, not absolute.
+		EXPECT_APPROX_EQ_FLOAT(vfpu_exp2(x) / powf(2.0f, x), 1.0f);
+		EXPECT_APPROX_EQ_FLOAT(vfpu_rexp2(x) * powf(2.0f, x), 1.0f);
 	}
 	return true;
 }
 
+bool TestVFPUSinCos() {
+	// Check the fast polynomial path as well as the accurate libm one.
+	g_vfpuFastTranscendentals = true;
+	if (!TestVFPUSinCosImpl())
+		return false;
+	g_vfpuFastTranscendentals = false;
+	bool result = TestVFPUSinCosImpl();
+	g_vfpuFastTranscendentals = true;
+	return result;
+}
+
 bool TestMatrixTranspose() {
 	MatrixSize sz = M_4x4;
 	int matrix = 0;  // M000
@@ -491,6 +515,7 @@ TestItem availableTests[] = {
 	TEST_ITEM(MatrixTranspose),
 	TEST_ITEM(ParseLBN),
 	TEST_ITEM(QuickTexHash),
+	TEST_ITEM(MicroBench),
 };
 
 int main(int argc, const char *argv[]) {